@@ -0,0 +1,532 @@
+#include "AnimationClip.h"
+#include "../Debug/Log.h"
+#include "../Utils/JsonStream/JsonStream.h"
+#include <algorithm>
+#include <assert.h>
+#include <fstream>
+#include <string.h>
+
+
+namespace GameDev2D
+{
+    //The names of the easing types, indexed by EasingType
+    static const char* EASING_TYPE_NAMES[EasingType_Count] =
+    {
+        "Linear",
+        "QuadraticIn", "QuadraticOut", "QuadraticInOut",
+        "CubicIn", "CubicOut", "CubicInOut",
+        "QuarticIn", "QuarticOut", "QuarticInOut",
+        "QuinticIn", "QuinticOut", "QuinticInOut",
+        "SinusoidalIn", "SinusoidalOut", "SinusoidalInOut",
+        "ExponentialIn", "ExponentialOut", "ExponentialInOut",
+        "CircularIn", "CircularOut", "CircularInOut",
+        "ElasticIn", "ElasticOut", "ElasticInOut",
+        "BackIn", "BackOut", "BackInOut",
+        "BounceIn", "BounceOut", "BounceInOut"
+    };
+
+    //The number of keyframes a cursor is moved forward before a binary search is used instead
+    const unsigned int ANIMATION_CLIP_CURSOR_STEPS = 4;
+
+    AnimationClip::AnimationClip() :
+        m_Duration(0.0f)
+    {
+
+    }
+
+    unsigned int AnimationClip::GetTrackCount() const
+    {
+        return static_cast<unsigned int>(m_Tracks.size());
+    }
+
+    int AnimationClip::GetTrackIndex(const std::string& aName) const
+    {
+        for (unsigned int i = 0; i < m_Tracks.size(); i++)
+        {
+            if (m_Tracks[i].name == aName)
+            {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    const std::string& AnimationClip::GetTrackName(unsigned int aTrack) const
+    {
+        return m_Tracks[aTrack].name;
+    }
+
+    unsigned int AnimationClip::GetTrackComponents(unsigned int aTrack) const
+    {
+        return m_Tracks[aTrack].components;
+    }
+
+    unsigned int AnimationClip::GetKeyframeCount(unsigned int aTrack) const
+    {
+        return m_Tracks[aTrack].keyframeCount;
+    }
+
+    float AnimationClip::GetKeyframeTime(unsigned int aTrack, unsigned int aKeyframe) const
+    {
+        return m_Times[m_Tracks[aTrack].firstKeyframe + aKeyframe];
+    }
+
+    const float* AnimationClip::GetKeyframeValues(unsigned int aTrack, unsigned int aKeyframe) const
+    {
+        const Track& track = m_Tracks[aTrack];
+        return &m_Values[track.firstValue + aKeyframe * track.components];
+    }
+
+    EasingType AnimationClip::GetKeyframeEasing(unsigned int aTrack, unsigned int aKeyframe) const
+    {
+        return static_cast<EasingType>(m_Easing[m_Tracks[aTrack].firstKeyframe + aKeyframe]);
+    }
+
+    float AnimationClip::GetDuration() const
+    {
+        return m_Duration;
+    }
+
+    unsigned int AnimationClip::GetSize() const
+    {
+        unsigned int size = sizeof(AnimationClip);
+        size += static_cast<unsigned int>(m_Times.size() * sizeof(float) + m_Values.size() * sizeof(float) + m_Easing.size());
+        for (unsigned int i = 0; i < m_Tracks.size(); i++)
+        {
+            size += static_cast<unsigned int>(sizeof(Track) + m_Tracks[i].name.length());
+        }
+        return size;
+    }
+
+    void AnimationClip::Sample(unsigned int aTrack, float aTime, float* aValues) const
+    {
+        unsigned int cursor = 0;
+        const Track& track = m_Tracks[aTrack];
+        if (track.keyframeCount > 1 && aTime > m_Times[track.firstKeyframe] && aTime < m_Times[track.firstKeyframe + track.keyframeCount - 1])
+        {
+            cursor = FindKeyframe(aTrack, aTime);
+        }
+        Sample(aTrack, aTime, cursor, aValues);
+    }
+
+    void AnimationClip::Sample(unsigned int aTrack, float aTime, unsigned int& aCursor, float* aValues) const
+    {
+        const Track& track = m_Tracks[aTrack];
+        if (track.keyframeCount == 0)
+        {
+            memset(aValues, 0, track.components * sizeof(float));
+            return;
+        }
+
+        //Before the first keyframe OR after the last keyframe, the keyframe's values are held
+        const float* times = &m_Times[track.firstKeyframe];
+        const unsigned int last = track.keyframeCount - 1;
+        if (aTime <= times[0] || aTime >= times[last])
+        {
+            aCursor = aTime <= times[0] ? 0 : last;
+            memcpy(aValues, &m_Values[track.firstValue + aCursor * track.components], track.components * sizeof(float));
+            return;
+        }
+
+        //Move the cursor forward a few keyframes, if the time is behind the cursor or too far ahead of it, search for the keyframe
+        unsigned int keyframe = aCursor < last ? aCursor : 0;
+        if (times[keyframe] <= aTime)
+        {
+            for (unsigned int step = 0; step < ANIMATION_CLIP_CURSOR_STEPS && times[keyframe + 1] <= aTime; step++)
+            {
+                keyframe++;
+            }
+        }
+
+        if (times[keyframe] > aTime || times[keyframe + 1] <= aTime)
+        {
+            keyframe = FindKeyframe(aTrack, aTime);
+        }
+
+        aCursor = keyframe;
+        Interpolate(aTrack, keyframe, aTime, aValues);
+    }
+
+    unsigned int AnimationClip::AddTrack(const std::string& aName, unsigned int aComponents)
+    {
+        assert(aComponents == 1 || aComponents == 2 || aComponents == 4);
+
+        Track track;
+        track.name = aName;
+        track.components = aComponents;
+        track.firstKeyframe = static_cast<unsigned int>(m_Times.size());
+        track.keyframeCount = 0;
+        track.firstValue = static_cast<unsigned int>(m_Values.size());
+        m_Tracks.push_back(track);
+
+        return static_cast<unsigned int>(m_Tracks.size() - 1);
+    }
+
+    bool AnimationClip::AddKeyframe(float aTime, const float* aValues, EasingType aEasing)
+    {
+        //There has to be a track, and the keyframes have to be in time order
+        if (m_Tracks.empty() == true || aEasing >= EasingType_Count)
+        {
+            return false;
+        }
+
+        Track& track = m_Tracks.back();
+        if (track.keyframeCount > 0 && aTime < m_Times.back())
+        {
+            return false;
+        }
+
+        m_Times.push_back(aTime);
+        m_Values.insert(m_Values.end(), aValues, aValues + track.components);
+        m_Easing.push_back(static_cast<unsigned char>(aEasing));
+        track.keyframeCount++;
+
+        m_Duration = aTime > m_Duration ? aTime : m_Duration;
+        return true;
+    }
+
+    bool AnimationClip::GetEasingType(const char* aName, unsigned int aLength, EasingType& aEasing)
+    {
+        for (unsigned int i = 0; i < EasingType_Count; i++)
+        {
+            if (JsonStream::KeyEquals(aName, aLength, EASING_TYPE_NAMES[i]) == true)
+            {
+                aEasing = static_cast<EasingType>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    unsigned int AnimationClip::FindKeyframe(unsigned int aTrack, float aTime) const
+    {
+        //The last keyframe at or before the time
+        const Track& track = m_Tracks[aTrack];
+        const float* times = &m_Times[track.firstKeyframe];
+        return static_cast<unsigned int>(std::upper_bound(times, times + track.keyframeCount, aTime) - times) - 1;
+    }
+
+    void AnimationClip::Interpolate(unsigned int aTrack, unsigned int aKeyframe, float aTime, float* aValues) const
+    {
+        const Track& track = m_Tracks[aTrack];
+        const unsigned int index = track.firstKeyframe + aKeyframe;
+
+        //The easing of the next keyframe is used to reach it
+        float percentage = (aTime - m_Times[index]) / (m_Times[index + 1] - m_Times[index]);
+        float eased = GetEasingFunction(static_cast<EasingType>(m_Easing[index + 1]))(percentage);
+
+        const float* start = &m_Values[track.firstValue + aKeyframe * track.components];
+        const float* end = start + track.components;
+        for (unsigned int i = 0; i < track.components; i++)
+        {
+            aValues[i] = start[i] + (end[i] - start[i]) * eased;
+        }
+
+        //Color values are kept in range
+        if (track.components == 4)
+        {
+            for (unsigned int i = 0; i < 4; i++)
+            {
+                aValues[i] = aValues[i] < 0.0f ? 0.0f : (aValues[i] > 1.0f ? 1.0f : aValues[i]);
+            }
+        }
+    }
+
+    //Streams the tracks of an animation clip .json file into an AnimationClip, without building a Json::Value tree
+    class AnimationClipStreamHandler : public JsonStreamHandler
+    {
+    public:
+        AnimationClipStreamHandler(AnimationClip* aClip) :
+            m_Clip(aClip),
+            m_Depth(0),
+            m_Key(Key_Unknown),
+            m_InTracks(false),
+            m_InKeyframes(false),
+            m_InValue(false),
+            m_HasFailed(false),
+            m_Components(0),
+            m_KeyframeTime(0.0f),
+            m_KeyframeValueCount(0),
+            m_KeyframeEasing(EasingType_Linear),
+            m_HasKeyframeTime(false)
+        {
+        }
+
+        bool HasFailed()
+        {
+            return m_HasFailed;
+        }
+
+        void OnObjectBegin()
+        {
+            m_Depth++;
+
+            //A new track in the tracks array
+            if (m_InTracks == true && m_Depth == 3)
+            {
+                m_Name.clear();
+                m_Components = 0;
+                m_Keyframes.clear();
+            }
+            //A new keyframe in the track's keyframes array
+            else if (m_InKeyframes == true && m_Depth == 5)
+            {
+                m_KeyframeTime = 0.0f;
+                m_KeyframeValueCount = 0;
+                m_KeyframeEasing = EasingType_Linear;
+                m_HasKeyframeTime = false;
+            }
+        }
+
+        void OnObjectEnd()
+        {
+            if (m_InKeyframes == true && m_Depth == 5)
+            {
+                EndKeyframe();
+            }
+            else if (m_InTracks == true && m_Depth == 3)
+            {
+                EndTrack();
+            }
+
+            m_Depth--;
+        }
+
+        void OnArrayBegin()
+        {
+            m_Depth++;
+            if (m_Depth == 2 && m_Key == Key_Tracks)
+            {
+                m_InTracks = true;
+            }
+            else if (m_InTracks == true && m_Depth == 4 && m_Key == Key_Keyframes)
+            {
+                m_InKeyframes = true;
+            }
+            else if (m_InKeyframes == true && m_Depth == 6 && m_Key == Key_Value)
+            {
+                m_InValue = true;
+            }
+        }
+
+        void OnArrayEnd()
+        {
+            if (m_Depth == 2)
+            {
+                m_InTracks = false;
+            }
+            else if (m_Depth == 4)
+            {
+                m_InKeyframes = false;
+            }
+            else if (m_Depth == 6)
+            {
+                m_InValue = false;
+            }
+            m_Depth--;
+        }
+
+        void OnKey(const char* aKey, unsigned int aLength)
+        {
+            m_Key = Key_Unknown;
+            if (m_Depth == 1 && JsonStream::KeyEquals(aKey, aLength, "tracks") == true)
+            {
+                m_Key = Key_Tracks;
+            }
+            else if (m_InTracks == true && m_Depth == 3)
+            {
+                if (JsonStream::KeyEquals(aKey, aLength, "name") == true) m_Key = Key_Name;
+                else if (JsonStream::KeyEquals(aKey, aLength, "type") == true) m_Key = Key_Type;
+                else if (JsonStream::KeyEquals(aKey, aLength, "keyframes") == true) m_Key = Key_Keyframes;
+            }
+            else if (m_InKeyframes == true && m_Depth == 5)
+            {
+                if (JsonStream::KeyEquals(aKey, aLength, "time") == true) m_Key = Key_Time;
+                else if (JsonStream::KeyEquals(aKey, aLength, "value") == true) m_Key = Key_Value;
+                else if (JsonStream::KeyEquals(aKey, aLength, "easing") == true) m_Key = Key_Easing;
+            }
+        }
+
+        void OnString(const char* aValue, unsigned int aLength)
+        {
+            if (m_InTracks == true && m_Depth == 3)
+            {
+                if (m_Key == Key_Name)
+                {
+                    m_Name.assign(aValue, aLength);
+                }
+                else if (m_Key == Key_Type)
+                {
+                    if (JsonStream::KeyEquals(aValue, aLength, "float") == true) m_Components = 1;
+                    else if (JsonStream::KeyEquals(aValue, aLength, "Vector2") == true) m_Components = 2;
+                    else if (JsonStream::KeyEquals(aValue, aLength, "Color") == true) m_Components = 4;
+                    else m_HasFailed = true;
+                }
+            }
+            else if (m_InKeyframes == true && m_Depth == 5 && m_Key == Key_Easing)
+            {
+                if (AnimationClip::GetEasingType(aValue, aLength, m_KeyframeEasing) == false)
+                {
+                    m_HasFailed = true;
+                }
+            }
+        }
+
+        void OnNumber(double aValue)
+        {
+            if (m_InKeyframes == true && m_Depth == 5)
+            {
+                if (m_Key == Key_Time)
+                {
+                    m_KeyframeTime = static_cast<float>(aValue);
+                    m_HasKeyframeTime = true;
+                }
+                else if (m_Key == Key_Value)
+                {
+                    AddValue(aValue);
+                }
+            }
+            else if (m_InValue == true && m_Depth == 6)
+            {
+                AddValue(aValue);
+            }
+        }
+
+    private:
+        void AddValue(double aValue)
+        {
+            if (m_KeyframeValueCount < 4)
+            {
+                m_KeyframeValues[m_KeyframeValueCount] = static_cast<float>(aValue);
+            }
+            m_KeyframeValueCount++;
+        }
+
+        void EndKeyframe()
+        {
+            //A keyframe needs a time and 1, 2 or 4 values
+            if (m_HasKeyframeTime == false || (m_KeyframeValueCount != 1 && m_KeyframeValueCount != 2 && m_KeyframeValueCount != 4))
+            {
+                m_HasFailed = true;
+                return;
+            }
+
+            Keyframe keyframe;
+            keyframe.time = m_KeyframeTime;
+            keyframe.valueCount = m_KeyframeValueCount;
+            keyframe.easing = m_KeyframeEasing;
+            memcpy(keyframe.values, m_KeyframeValues, sizeof(keyframe.values));
+            m_Keyframes.push_back(keyframe);
+        }
+
+        void EndTrack()
+        {
+            //A track needs a name and at least one keyframe, if the type is missing the values decide it
+            if (m_Name.empty() == true || m_Keyframes.empty() == true)
+            {
+                m_HasFailed = true;
+                return;
+            }
+
+            unsigned int components = m_Components != 0 ? m_Components : m_Keyframes.front().valueCount;
+
+            //The keyframes don't have to be in time order in the file
+            std::stable_sort(m_Keyframes.begin(), m_Keyframes.end(), [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; });
+
+            m_Clip->AddTrack(m_Name, components);
+            for (unsigned int i = 0; i < m_Keyframes.size(); i++)
+            {
+                if (m_Keyframes[i].valueCount != components || m_Clip->AddKeyframe(m_Keyframes[i].time, m_Keyframes[i].values, m_Keyframes[i].easing) == false)
+                {
+                    m_HasFailed = true;
+                    return;
+                }
+            }
+        }
+
+        enum Key
+        {
+            Key_Unknown = 0,
+            Key_Tracks,
+            Key_Name,
+            Key_Type,
+            Key_Keyframes,
+            Key_Time,
+            Key_Value,
+            Key_Easing
+        };
+
+        struct Keyframe
+        {
+            float time;
+            float values[4];
+            unsigned int valueCount;
+            EasingType easing;
+        };
+
+        AnimationClip* m_Clip;
+        unsigned int m_Depth;
+        Key m_Key;
+        bool m_InTracks;
+        bool m_InKeyframes;
+        bool m_InValue;
+        bool m_HasFailed;
+        std::string m_Name;
+        unsigned int m_Components;
+        std::vector<Keyframe> m_Keyframes;
+        float m_KeyframeTime;
+        float m_KeyframeValues[4];
+        unsigned int m_KeyframeValueCount;
+        EasingType m_KeyframeEasing;
+        bool m_HasKeyframeTime;
+    };
+
+    bool AnimationClip::Unpack(const std::string& aPath, AnimationClip** aClip)
+    {
+        //Does the json file exist, if it doesn't the assert below will be hit. The file is opened instead of asking the
+        //Application, so that clips don't depend on the platform
+        bool doesExist = std::ifstream(aPath.c_str(), std::ios::binary).is_open();
+        assert(doesExist == true);
+
+        //If the json files exists, load the clip's tracks
+        if (doesExist == true)
+        {
+            //Stream the json data straight into the AnimationClip
+            AnimationClip* clip = new AnimationClip();
+            AnimationClipStreamHandler handler(clip);
+            if (JsonStream::ParseFile(aPath, &handler) == true && handler.HasFailed() == false && clip->GetTrackCount() > 0)
+            {
+                *aClip = clip;
+
+                //The unpack was successful
+                return true;
+            }
+
+            //The json data was malformed
+            delete clip;
+            Log::Error(false, Log::Verbosity_Resources, "[AnimationClip] Failed to parse the animation clip: %s", aPath.c_str());
+        }
+
+        //The unpack failed
+        return false;
+    }
+
+    bool AnimationClip::Unpack(const std::string& aPath, const char* aBuffer, unsigned int aLength, AnimationClip** aClip)
+    {
+        //Stream the json data straight into the AnimationClip
+        AnimationClip* clip = new AnimationClip();
+        AnimationClipStreamHandler handler(clip);
+        if (JsonStream::Parse(aBuffer, aLength, &handler) == true && handler.HasFailed() == false && clip->GetTrackCount() > 0)
+        {
+            *aClip = clip;
+
+            //The unpack was successful
+            return true;
+        }
+
+        //The json data was malformed
+        delete clip;
+        Log::Error(false, Log::Verbosity_Resources, "[AnimationClip] Failed to parse the animation clip: %s", aPath.c_str());
+        return false;
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Easing.h"
+#include <string>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //An AnimationClip is an immutable set of named tracks, each track animates a float, Vector2 or Color value (1, 2 or 4
+    //components) with keyframes that are sorted by time. A keyframe's easing is used for the segment that leads up to it.
+    //Clips are loaded from a .json file by the ResourceManager and are shared, an AnimationPlayhead plays a clip back.
+    //
+    //The clip .json file has the following layout, the type is "float", "Vector2" or "Color" and the easing is the name
+    //of an easing function ("Linear", "QuadraticIn", "ElasticOut", ...), the easing is optional and defaults to "Linear"
+    //
+    //{ "tracks": [ { "name": "position", "type": "Vector2", "keyframes": [ { "time": 0.0, "value": [0, 0] },
+    //                                                                      { "time": 1.5, "value": [200, 50], "easing": "QuadraticOut" } ] } ] }
+    class AnimationClip
+    {
+    public:
+        AnimationClip();
+
+        //Returns the number of tracks in the clip
+        unsigned int GetTrackCount() const;
+
+        //Returns the index of the track with the name, or -1 if the clip doesn't have that track
+        int GetTrackIndex(const std::string& name) const;
+
+        //Returns a track's name, the number of components its values have (1, 2 or 4) and its number of keyframes
+        const std::string& GetTrackName(unsigned int track) const;
+        unsigned int GetTrackComponents(unsigned int track) const;
+        unsigned int GetKeyframeCount(unsigned int track) const;
+
+        //Returns a keyframe's time, values and the easing used to reach it
+        float GetKeyframeTime(unsigned int track, unsigned int keyframe) const;
+        const float* GetKeyframeValues(unsigned int track, unsigned int keyframe) const;
+        EasingType GetKeyframeEasing(unsigned int track, unsigned int keyframe) const;
+
+        //Returns the time of the clip's last keyframe, in seconds
+        float GetDuration() const;
+
+        //Returns the size, in bytes, of the clip's keyframes
+        unsigned int GetSize() const;
+
+        //Samples a track at a time (in seconds), the values MUST hold as many floats as the track has components. Before the
+        //first keyframe the first keyframe's values are returned, after the last keyframe the last keyframe's values are returned.
+        //The keyframe is found with a binary search
+        void Sample(unsigned int track, float time, float* values) const;
+
+        //Samples a track using a cursor (the index of the last keyframe that was sampled), when the time only moves forward
+        //by a little each sample, the keyframe is found without a search. The cursor is updated
+        void Sample(unsigned int track, float time, unsigned int& cursor, float* values) const;
+
+        //Adds a track and returns its index, the components MUST be 1, 2 or 4. Used while a clip is being loaded
+        unsigned int AddTrack(const std::string& name, unsigned int components);
+
+        //Adds a keyframe to the last track that was added, the keyframes MUST be added in time order. Used while a clip is being loaded
+        bool AddKeyframe(float time, const float* values, EasingType easing);
+
+        //Unpacks an animation clip .json file
+        static bool Unpack(const std::string& path, AnimationClip** clip);
+
+        //Unpacks the animation clip .json data that was read from the file at the path, the buffer MUST be null terminated at buffer[length]
+        static bool Unpack(const std::string& path, const char* buffer, unsigned int length, AnimationClip** clip);
+
+        //Returns the easing type for an easing function's name, returns false if the name isn't an easing function
+        static bool GetEasingType(const char* name, unsigned int length, EasingType& easing);
+
+    private:
+        //Returns the index of the keyframe at or before the time, the time MUST be within the track's keyframes
+        unsigned int FindKeyframe(unsigned int track, float time) const;
+
+        //Interpolates between a keyframe and the next one
+        void Interpolate(unsigned int track, unsigned int keyframe, float time, float* values) const;
+
+        //A track refers to a range of keyframes, and to the range of values those keyframes have
+        struct Track
+        {
+            std::string name;
+            unsigned int components;
+            unsigned int firstKeyframe;
+            unsigned int keyframeCount;
+            unsigned int firstValue;
+        };
+
+        //Member variables, the keyframes of every track are stored one after the other
+        std::vector<Track> m_Tracks;
+        std::vector<float> m_Times;
+        std::vector<float> m_Values;
+        std::vector<unsigned char> m_Easing;
+        float m_Duration;
+    };
+}
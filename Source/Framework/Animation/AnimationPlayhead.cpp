@@ -0,0 +1,148 @@
+#include "AnimationPlayhead.h"
+#include "AnimationClip.h"
+#include "../Services/Services.h"
+#include <math.h>
+#include <string.h>
+
+
+namespace GameDev2D
+{
+    AnimationPlayhead::AnimationPlayhead(const std::string& aFilename) :
+        m_Clip(),
+        m_Time(0.0),
+        m_IsPlaying(false),
+        m_DoesLoop(false)
+    {
+        //Acquire a handle to the animation clip, the clip is shared by every playhead that plays it
+        m_Clip = Services::GetResourceManager()->AcquireAnimationClip(aFilename);
+
+        //Every track gets a cursor so that playing forward doesn't search for keyframes
+        const AnimationClip* clip = GetClip();
+        if (clip != nullptr)
+        {
+            m_Cursors.resize(clip->GetTrackCount(), 0);
+        }
+    }
+
+    AnimationPlayhead::~AnimationPlayhead()
+    {
+        Services::GetResourceManager()->ReleaseAnimationClip(m_Clip);
+    }
+
+    void AnimationPlayhead::Update(double aDelta)
+    {
+        if (m_IsPlaying == false)
+        {
+            return;
+        }
+
+        m_Time += aDelta;
+
+        //Has the end of the clip been reached?
+        double duration = GetDuration();
+        if (m_Time >= duration)
+        {
+            if (m_DoesLoop == true && duration > 0.0)
+            {
+                m_Time = fmod(m_Time, duration);
+            }
+            else
+            {
+                m_Time = duration;
+                m_IsPlaying = false;
+            }
+        }
+    }
+
+    void AnimationPlayhead::Play()
+    {
+        if (m_DoesLoop == false && m_Time >= GetDuration())
+        {
+            m_Time = 0.0;
+        }
+        m_IsPlaying = true;
+    }
+
+    void AnimationPlayhead::Stop()
+    {
+        m_IsPlaying = false;
+    }
+
+    bool AnimationPlayhead::IsPlaying() const
+    {
+        return m_IsPlaying;
+    }
+
+    void AnimationPlayhead::SetTime(double aTime)
+    {
+        double duration = GetDuration();
+        m_Time = aTime < 0.0 ? 0.0 : (aTime > duration ? duration : aTime);
+    }
+
+    double AnimationPlayhead::GetTime() const
+    {
+        return m_Time;
+    }
+
+    void AnimationPlayhead::SetDoesLoop(bool aDoesLoop)
+    {
+        m_DoesLoop = aDoesLoop;
+    }
+
+    bool AnimationPlayhead::DoesLoop() const
+    {
+        return m_DoesLoop;
+    }
+
+    double AnimationPlayhead::GetDuration() const
+    {
+        const AnimationClip* clip = GetClip();
+        return clip != nullptr ? clip->GetDuration() : 0.0;
+    }
+
+    int AnimationPlayhead::GetTrackIndex(const std::string& aName) const
+    {
+        const AnimationClip* clip = GetClip();
+        return clip != nullptr ? clip->GetTrackIndex(aName) : -1;
+    }
+
+    float AnimationPlayhead::GetFloat(int aTrack)
+    {
+        float values[4];
+        Sample(aTrack, values);
+        return values[0];
+    }
+
+    Vector2 AnimationPlayhead::GetVector2(int aTrack)
+    {
+        float values[4];
+        Sample(aTrack, values);
+        return Vector2(values[0], values[1]);
+    }
+
+    Color AnimationPlayhead::GetColor(int aTrack)
+    {
+        float values[4];
+        Sample(aTrack, values);
+        return Color(values[0], values[1], values[2], values[3]);
+    }
+
+    const AnimationClip* AnimationPlayhead::GetClip() const
+    {
+        return Services::GetResourceManager()->GetAnimationClip(m_Clip);
+    }
+
+    void AnimationPlayhead::Sample(int aTrack, float* aValues)
+    {
+        memset(aValues, 0, sizeof(float) * 4);
+
+        //Safety check the track, the clip could have been reloaded with fewer tracks
+        const AnimationClip* clip = GetClip();
+        if (clip == nullptr || aTrack < 0 || (unsigned int)aTrack >= clip->GetTrackCount() || (unsigned int)aTrack >= m_Cursors.size())
+        {
+            return;
+        }
+
+        clip->Sample(aTrack, static_cast<float>(m_Time), m_Cursors[aTrack], aValues);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../Graphics/Color.h"
+#include "../Math/Vector2.h"
+#include "../Services/ResourceManager/ResourceHandle.h"
+#include <string>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Forward declarations
+    class AnimationClip;
+
+    //An AnimationPlayhead plays back a shared AnimationClip, the clip's keyframes are loaded once by the ResourceManager
+    //and every playhead only holds a handle to the clip, its time and a cursor per track. Unlike an Animator, a playhead
+    //doesn't listen for the Update event, call Update() once a frame then sample the tracks that are needed. Tracks are
+    //sampled by index, get the index of a track once with GetTrackIndex()
+    class AnimationPlayhead
+    {
+    public:
+        //Acquires the AnimationClip for the file (in the Animations directory), loading it if it isn't loaded
+        AnimationPlayhead(const std::string& filename);
+        ~AnimationPlayhead();
+
+        //Advances the playhead's time if it is playing, when the end of the clip is reached the playhead stops OR loops
+        void Update(double delta);
+
+        //Starts and stops playback, starting at the end of a clip that doesn't loop rewinds it first
+        void Play();
+        void Stop();
+
+        //Returns wether the playhead is playing or not
+        bool IsPlaying() const;
+
+        //Sets the playhead's time (in seconds), seeking backwards is supported
+        void SetTime(double time);
+
+        //Returns the playhead's time (in seconds)
+        double GetTime() const;
+
+        //Sets wether the playhead loops back to the start once it reaches the end of the clip
+        void SetDoesLoop(bool doesLoop);
+
+        //Returns wether the playhead loops
+        bool DoesLoop() const;
+
+        //Returns the duration of the clip, in seconds
+        double GetDuration() const;
+
+        //Returns the index of a track in the clip, or -1 if the clip doesn't have that track
+        int GetTrackIndex(const std::string& name) const;
+
+        //Samples a track at the playhead's time, if the track index is invalid zero is returned
+        float GetFloat(int track);
+        Vector2 GetVector2(int track);
+        Color GetColor(int track);
+
+        //Returns the clip being played, nullptr is returned if the clip couldn't be loaded
+        const AnimationClip* GetClip() const;
+
+    private:
+        //Samples a track into the values, which are zeroed first
+        void Sample(int track, float* values);
+
+        //Member variables
+        AnimationClipHandle m_Clip;
+        std::vector<unsigned int> m_Cursors;
+        double m_Time;
+        bool m_IsPlaying;
+        bool m_DoesLoop;
+    };
+}
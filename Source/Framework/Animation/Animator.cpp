@@ -103,8 +103,8 @@ namespace GameDev2D
         //Are we animating?
         if (IsAnimating() == true)
         {
-            //Get the first keyframe
-            Keyframe keyframe = m_Keyframes.front();
+            //Get the first keyframe, it stays in the list until it has finished
+            const Keyframe& keyframe = m_Keyframes.front();
 
             //Increment the animation time
             m_Time += aDelta;
@@ -204,8 +204,8 @@ namespace GameDev2D
         //Are we animating?
         if (IsAnimating() == true)
         {
-            //Get the first keyframe
-            Keyframe keyframe = m_Keyframes.front();
+            //Get the first keyframe, it stays in the list until it has finished
+            const Keyframe& keyframe = m_Keyframes.front();
 
             //Increment the animation time
             m_Time += aDelta;
@@ -307,8 +307,8 @@ namespace GameDev2D
         //Are we animating?
         if (IsAnimating() == true)
         {
-            //Get the first keyframe
-            Keyframe keyframe = m_Keyframes.front();
+            //Get the first keyframe, it stays in the list until it has finished
+            const Keyframe& keyframe = m_Keyframes.front();
 
             //Increment the animation time
             m_Time += aDelta;
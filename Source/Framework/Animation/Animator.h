@@ -24,7 +24,8 @@ namespace GameDev2D
     #define MakeGetterCallback(object, method)  std::bind(&method, object)
     #define MakeCallbacks(object, setter, getter) MakeSetterCallback(object, setter), MakeGetterCallback(object, getter)
 
-    //The Base Animator class for AnimatorFloat and AnimatorVector2, primarily to avoid repeating code 
+    //The Base Animator class for AnimatorFloat and AnimatorVector2, primarily to avoid repeating code. Every Animator listens
+    //for the Update event itself, to animate many values use the TweenManager service instead
     class Animator : public EventHandler
     {
     public:
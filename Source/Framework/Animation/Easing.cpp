@@ -1,9 +1,31 @@
 #include "Easing.h"
+#include "../Math/Simd.h"
 #include <math.h>
 
 
 namespace GameDev2D
 {
+    EasingFunction GetEasingFunction(EasingType aType)
+    {
+        //Indexed by EasingType, the order MUST match the enum
+        static const EasingFunction easingFunctions[EasingType_Count] =
+        {
+            Linear::Interpolation,
+            Quadratic::In, Quadratic::Out, Quadratic::InOut,
+            Cubic::In, Cubic::Out, Cubic::InOut,
+            Quartic::In, Quartic::Out, Quartic::InOut,
+            Quintic::In, Quintic::Out, Quintic::InOut,
+            Sinusoidal::In, Sinusoidal::Out, Sinusoidal::InOut,
+            Exponential::In, Exponential::Out, Exponential::InOut,
+            Circular::In, Circular::Out, Circular::InOut,
+            Elastic::In, Elastic::Out, Elastic::InOut,
+            Back::In, Back::Out, Back::InOut,
+            Bounce::In, Bounce::Out, Bounce::InOut
+        };
+
+        return aType < EasingType_Count ? easingFunctions[aType] : Linear::Interpolation;
+    }
+
     float Linear::Interpolation(float aValue)
     {
         return aValue;
@@ -248,4 +270,267 @@ namespace GameDev2D
             return 0.5f * Bounce::Out(aValue * 2.0f - 1.0f) + 0.5f;
         }
     }
-}
\ No newline at end of file
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Batch easing
+    //
+    //The number of intervals each approximation table is sampled at
+    const unsigned int EASING_TABLE_SIZE = 2048;
+
+    //The number of approximation tables, one for each Sinusoidal, Exponential and Elastic curve
+    const unsigned int EASING_TABLE_COUNT = 9;
+
+    //Returns the approximation table for an easing type, or -1 if the easing type isn't approximated
+    static int GetEasingTable(EasingType aType)
+    {
+        if (aType >= EasingType_SinusoidalIn && aType <= EasingType_ExponentialInOut)
+        {
+            return aType - EasingType_SinusoidalIn;
+        }
+        else if (aType >= EasingType_ElasticIn && aType <= EasingType_ElasticInOut)
+        {
+            return aType - EasingType_ElasticIn + 6;
+        }
+        return -1;
+    }
+
+    //The approximation tables, built the first time they're needed
+    struct EasingTables
+    {
+        EasingTables()
+        {
+            for (unsigned int type = 0; type < EasingType_Count; type++)
+            {
+                int index = GetEasingTable(static_cast<EasingType>(type));
+                if (index < 0)
+                {
+                    continue;
+                }
+
+                //The last sample is repeated, so that a value of 1.0 can be interpolated without a bounds check
+                EasingFunction easingFunction = GetEasingFunction(static_cast<EasingType>(type));
+                float* table = samples[index];
+                for (unsigned int i = 0; i <= EASING_TABLE_SIZE; i++)
+                {
+                    table[i] = easingFunction(static_cast<float>(i) / static_cast<float>(EASING_TABLE_SIZE));
+                }
+                table[EASING_TABLE_SIZE + 1] = table[EASING_TABLE_SIZE];
+            }
+        }
+
+        float samples[EASING_TABLE_COUNT][EASING_TABLE_SIZE + 2];
+    };
+
+    static void EaseTable(int aTable, const float* aValues, float* aResults, unsigned int aCount)
+    {
+        static const EasingTables tables;
+        const float* table = tables.samples[aTable];
+
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            float value = aValues[i] < 0.0f ? 0.0f : (aValues[i] > 1.0f ? 1.0f : aValues[i]);
+            float position = value * static_cast<float>(EASING_TABLE_SIZE);
+            unsigned int index = static_cast<unsigned int>(position);
+            float fraction = position - static_cast<float>(index);
+            aResults[i] = table[index] + (table[index + 1] - table[index]) * fraction;
+        }
+    }
+
+    static void EaseScalar(EasingType aType, const float* aValues, float* aResults, unsigned int aCount)
+    {
+        EasingFunction easingFunction = GetEasingFunction(aType);
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            aResults[i] = easingFunction(aValues[i]);
+        }
+    }
+
+#if SIMD_SSE2
+    //The SSE versions of the easing functions, each one eases 4 values. The operations are done in the same order as the
+    //scalar functions so the results are identical. Both sides of a branch are calculated and the result is selected
+    static inline __m128 Set(float aValue)
+    {
+        return _mm_set1_ps(aValue);
+    }
+
+    static inline __m128 Select(__m128 aMask, __m128 aTrue, __m128 aFalse)
+    {
+        return _mm_or_ps(_mm_and_ps(aMask, aTrue), _mm_andnot_ps(aMask, aFalse));
+    }
+
+    static inline __m128 LinearInterpolation4(__m128 v)
+    {
+        return v;
+    }
+
+    static inline __m128 QuadraticIn4(__m128 v)
+    {
+        return _mm_mul_ps(v, v);
+    }
+
+    static inline __m128 QuadraticOut4(__m128 v)
+    {
+        return _mm_mul_ps(v, _mm_sub_ps(Set(2.0f), v));
+    }
+
+    static inline __m128 QuadraticInOut4(__m128 v)
+    {
+        __m128 in = _mm_mul_ps(_mm_mul_ps(Set(2.0f), v), v);
+        __m128 out = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(Set(-2.0f), v), v), _mm_mul_ps(Set(4.0f), v)), Set(1.0f));
+        return Select(_mm_cmplt_ps(v, Set(0.5f)), in, out);
+    }
+
+    static inline __m128 CubicIn4(__m128 v)
+    {
+        return _mm_mul_ps(_mm_mul_ps(v, v), v);
+    }
+
+    static inline __m128 CubicOut4(__m128 v)
+    {
+        __m128 f = _mm_sub_ps(v, Set(1.0f));
+        return _mm_add_ps(_mm_mul_ps(_mm_mul_ps(f, f), f), Set(1.0f));
+    }
+
+    static inline __m128 CubicInOut4(__m128 v)
+    {
+        __m128 in = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(Set(4.0f), v), v), v);
+        __m128 f = _mm_sub_ps(_mm_mul_ps(Set(2.0f), v), Set(2.0f));
+        __m128 out = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(Set(0.5f), f), f), f), Set(1.0f));
+        return Select(_mm_cmplt_ps(v, Set(0.5f)), in, out);
+    }
+
+    static inline __m128 QuarticIn4(__m128 v)
+    {
+        return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(v, v), v), v);
+    }
+
+    static inline __m128 QuarticOut4(__m128 v)
+    {
+        __m128 f = _mm_sub_ps(v, Set(1.0f));
+        return _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(f, f), f), _mm_sub_ps(Set(1.0f), v)), Set(1.0f));
+    }
+
+    static inline __m128 QuarticInOut4(__m128 v)
+    {
+        __m128 in = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(Set(8.0f), v), v), v), v);
+        __m128 f = _mm_sub_ps(v, Set(1.0f));
+        __m128 out = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(Set(-8.0f), f), f), f), f), Set(1.0f));
+        return Select(_mm_cmplt_ps(v, Set(0.5f)), in, out);
+    }
+
+    static inline __m128 QuinticIn4(__m128 v)
+    {
+        return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(v, v), v), v), v);
+    }
+
+    static inline __m128 QuinticOut4(__m128 v)
+    {
+        __m128 f = _mm_sub_ps(v, Set(1.0f));
+        return _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(f, f), f), f), f), Set(1.0f));
+    }
+
+    static inline __m128 QuinticInOut4(__m128 v)
+    {
+        __m128 in = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(Set(16.0f), v), v), v), v), v);
+        __m128 f = _mm_sub_ps(_mm_mul_ps(Set(2.0f), v), Set(2.0f));
+        __m128 out = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(Set(0.5f), f), f), f), f), f), Set(1.0f));
+        return Select(_mm_cmplt_ps(v, Set(0.5f)), in, out);
+    }
+
+    static inline __m128 CircularIn4(__m128 v)
+    {
+        return _mm_sub_ps(Set(1.0f), _mm_sqrt_ps(_mm_sub_ps(Set(1.0f), _mm_mul_ps(v, v))));
+    }
+
+    static inline __m128 CircularOut4(__m128 v)
+    {
+        return _mm_sqrt_ps(_mm_mul_ps(_mm_sub_ps(Set(2.0f), v), v));
+    }
+
+    static inline __m128 CircularInOut4(__m128 v)
+    {
+        __m128 in = _mm_mul_ps(Set(0.5f), _mm_sub_ps(Set(1.0f), _mm_sqrt_ps(_mm_sub_ps(Set(1.0f), _mm_mul_ps(Set(4.0f), _mm_mul_ps(v, v))))));
+        __m128 twice = _mm_mul_ps(Set(2.0f), v);
+        __m128 negated = _mm_xor_ps(_mm_sub_ps(twice, Set(3.0f)), Set(-0.0f));
+        __m128 out = _mm_mul_ps(Set(0.5f), _mm_add_ps(_mm_sqrt_ps(_mm_mul_ps(negated, _mm_sub_ps(twice, Set(1.0f)))), Set(1.0f)));
+        return Select(_mm_cmplt_ps(v, Set(0.5f)), in, out);
+    }
+
+    static inline __m128 BounceOut4(__m128 v)
+    {
+        __m128 a = _mm_div_ps(_mm_mul_ps(_mm_mul_ps(Set(121.0f), v), v), Set(16.0f));
+        __m128 b = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(Set(363.0f / 40.0f), v), v), _mm_mul_ps(Set(99.0f / 10.0f), v)), Set(17.0f / 5.0f));
+        __m128 c = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(Set(4356.0f / 361.0f), v), v), _mm_mul_ps(Set(35442.0f / 1805.0f), v)), Set(16061.0f / 1805.0f));
+        __m128 d = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(Set(54.0f / 5.0f), v), v), _mm_mul_ps(Set(513.0f / 25.0f), v)), Set(268.0f / 25.0f));
+        __m128 result = Select(_mm_cmplt_ps(v, Set(9.0f / 10.0f)), c, d);
+        result = Select(_mm_cmplt_ps(v, Set(8.0f / 11.0f)), b, result);
+        return Select(_mm_cmplt_ps(v, Set(4.0f / 11.0f)), a, result);
+    }
+
+    static inline __m128 BounceIn4(__m128 v)
+    {
+        return _mm_sub_ps(Set(1.0f), BounceOut4(_mm_sub_ps(Set(1.0f), v)));
+    }
+
+    static inline __m128 BounceInOut4(__m128 v)
+    {
+        __m128 in = _mm_mul_ps(Set(0.5f), BounceIn4(_mm_mul_ps(v, Set(2.0f))));
+        __m128 out = _mm_add_ps(_mm_mul_ps(Set(0.5f), BounceOut4(_mm_sub_ps(_mm_mul_ps(v, Set(2.0f)), Set(1.0f)))), Set(0.5f));
+        return Select(_mm_cmplt_ps(v, Set(0.5f)), in, out);
+    }
+
+    //Eases the values 4 at a time, the remaining values are eased by the scalar function
+    template<__m128(*Ease4)(__m128), float(*Ease1)(float)> static void EaseSSE(const float* aValues, float* aResults, unsigned int aCount)
+    {
+        unsigned int i = 0;
+        for (; i + 4 <= aCount; i += 4)
+        {
+            _mm_storeu_ps(aResults + i, Ease4(_mm_loadu_ps(aValues + i)));
+        }
+
+        for (; i < aCount; i++)
+        {
+            aResults[i] = Ease1(aValues[i]);
+        }
+    }
+#endif
+
+    void Ease(EasingType aType, const float* aValues, float* aResults, unsigned int aCount, bool aApproximate)
+    {
+        //The Sinusoidal, Exponential and Elastic curves can be sampled from a table
+        if (aApproximate == true && GetEasingTable(aType) >= 0)
+        {
+            EaseTable(GetEasingTable(aType), aValues, aResults, aCount);
+            return;
+        }
+
+#if SIMD_SSE2
+        switch (aType)
+        {
+            case EasingType_Linear: EaseSSE<LinearInterpolation4, Linear::Interpolation>(aValues, aResults, aCount); return;
+            case EasingType_QuadraticIn: EaseSSE<QuadraticIn4, Quadratic::In>(aValues, aResults, aCount); return;
+            case EasingType_QuadraticOut: EaseSSE<QuadraticOut4, Quadratic::Out>(aValues, aResults, aCount); return;
+            case EasingType_QuadraticInOut: EaseSSE<QuadraticInOut4, Quadratic::InOut>(aValues, aResults, aCount); return;
+            case EasingType_CubicIn: EaseSSE<CubicIn4, Cubic::In>(aValues, aResults, aCount); return;
+            case EasingType_CubicOut: EaseSSE<CubicOut4, Cubic::Out>(aValues, aResults, aCount); return;
+            case EasingType_CubicInOut: EaseSSE<CubicInOut4, Cubic::InOut>(aValues, aResults, aCount); return;
+            case EasingType_QuarticIn: EaseSSE<QuarticIn4, Quartic::In>(aValues, aResults, aCount); return;
+            case EasingType_QuarticOut: EaseSSE<QuarticOut4, Quartic::Out>(aValues, aResults, aCount); return;
+            case EasingType_QuarticInOut: EaseSSE<QuarticInOut4, Quartic::InOut>(aValues, aResults, aCount); return;
+            case EasingType_QuinticIn: EaseSSE<QuinticIn4, Quintic::In>(aValues, aResults, aCount); return;
+            case EasingType_QuinticOut: EaseSSE<QuinticOut4, Quintic::Out>(aValues, aResults, aCount); return;
+            case EasingType_QuinticInOut: EaseSSE<QuinticInOut4, Quintic::InOut>(aValues, aResults, aCount); return;
+            case EasingType_CircularIn: EaseSSE<CircularIn4, Circular::In>(aValues, aResults, aCount); return;
+            case EasingType_CircularOut: EaseSSE<CircularOut4, Circular::Out>(aValues, aResults, aCount); return;
+            case EasingType_CircularInOut: EaseSSE<CircularInOut4, Circular::InOut>(aValues, aResults, aCount); return;
+            case EasingType_BounceIn: EaseSSE<BounceIn4, Bounce::In>(aValues, aResults, aCount); return;
+            case EasingType_BounceOut: EaseSSE<BounceOut4, Bounce::Out>(aValues, aResults, aCount); return;
+            case EasingType_BounceInOut: EaseSSE<BounceInOut4, Bounce::InOut>(aValues, aResults, aCount); return;
+            default: break;
+        }
+#endif
+
+        //The curves that need sinf or powf, or every curve when SSE isn't available
+        EaseScalar(aType, aValues, aResults, aCount);
+    }
+}
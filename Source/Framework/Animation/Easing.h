@@ -6,6 +6,53 @@ namespace GameDev2D
     //Easing function pointer
     typedef float(*EasingFunction)(float value);
 
+    //Identifies each of the easing functions below, used where a function pointer per value is too costly (the TweenManager)
+    enum EasingType
+    {
+        EasingType_Linear = 0,
+        EasingType_QuadraticIn,
+        EasingType_QuadraticOut,
+        EasingType_QuadraticInOut,
+        EasingType_CubicIn,
+        EasingType_CubicOut,
+        EasingType_CubicInOut,
+        EasingType_QuarticIn,
+        EasingType_QuarticOut,
+        EasingType_QuarticInOut,
+        EasingType_QuinticIn,
+        EasingType_QuinticOut,
+        EasingType_QuinticInOut,
+        EasingType_SinusoidalIn,
+        EasingType_SinusoidalOut,
+        EasingType_SinusoidalInOut,
+        EasingType_ExponentialIn,
+        EasingType_ExponentialOut,
+        EasingType_ExponentialInOut,
+        EasingType_CircularIn,
+        EasingType_CircularOut,
+        EasingType_CircularInOut,
+        EasingType_ElasticIn,
+        EasingType_ElasticOut,
+        EasingType_ElasticInOut,
+        EasingType_BackIn,
+        EasingType_BackOut,
+        EasingType_BackInOut,
+        EasingType_BounceIn,
+        EasingType_BounceOut,
+        EasingType_BounceInOut,
+        EasingType_Count
+    };
+
+    //Returns the easing function for an easing type
+    EasingFunction GetEasingFunction(EasingType type);
+
+    //Evaluates an easing type for an array of values, the results can be written back to the values array. Four values
+    //are eased at a time with SSE where it's available, the results match the easing functions below exactly. When
+    //approximate is true the Sinusoidal, Exponential and Elastic curves are sampled from a table instead of calling sinf
+    //and powf. The values are clamped to the range 0.0 - 1.0 and the results are within 0.00003 of the exact curves, except
+    //right next to the ends of the Exponential curves, which jump by 0.001 there
+    void Ease(EasingType type, const float* values, float* results, unsigned int count, bool approximate = false);
+
     //Linear ease
     class Linear
     {
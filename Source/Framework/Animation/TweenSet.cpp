@@ -0,0 +1,289 @@
+#include "TweenSet.h"
+#include <float.h>
+
+
+namespace GameDev2D
+{
+    //The number of channels (animated floats) the arrays are reserved for
+    const unsigned int TWEEN_SET_CHANNEL_RESERVE = 1024;
+
+    //The shortest duration a tween can have, a tween with no duration finishes on the first update
+    const float TWEEN_SET_MIN_DURATION = 1.0e-6f;
+
+    TweenSet::TweenSet() :
+        m_TweenCount(0),
+        m_UsesApproximateEasing(false)
+    {
+        //Reserve the channel arrays
+        m_Start.reserve(TWEEN_SET_CHANNEL_RESERVE);
+        m_End.reserve(TWEEN_SET_CHANNEL_RESERVE);
+        m_Time.reserve(TWEEN_SET_CHANNEL_RESERVE);
+        m_Duration.reserve(TWEEN_SET_CHANNEL_RESERVE);
+        m_Minimum.reserve(TWEEN_SET_CHANNEL_RESERVE);
+        m_Maximum.reserve(TWEEN_SET_CHANNEL_RESERVE);
+        m_Result.reserve(TWEEN_SET_CHANNEL_RESERVE);
+        m_Values.reserve(TWEEN_SET_CHANNEL_RESERVE);
+        m_Easing.reserve(TWEEN_SET_CHANNEL_RESERVE);
+        m_ChannelSlots.reserve(TWEEN_SET_CHANNEL_RESERVE);
+
+        //Slot zero is never used, so that a default Tween handle is invalid
+        Slot slot = { 0, 0, 0 };
+        m_Slots.push_back(slot);
+    }
+
+    TweenSet::~TweenSet()
+    {
+
+    }
+
+    void TweenSet::Update(double aDelta)
+    {
+        const unsigned int count = static_cast<unsigned int>(m_Time.size());
+        if (count == 0)
+        {
+            return;
+        }
+
+        const float delta = static_cast<float>(aDelta);
+        const float* start = m_Start.data();
+        const float* end = m_End.data();
+        const float* duration = m_Duration.data();
+        const float* minimum = m_Minimum.data();
+        const float* maximum = m_Maximum.data();
+        const unsigned char* easing = m_Easing.data();
+        float* time = m_Time.data();
+        float* result = m_Result.data();
+
+        //Advance the time and calculate how much of each tween is complete, a tween that hasn't started yet has a negative time
+        for (unsigned int i = 0; i < count; i++)
+        {
+            time[i] += delta;
+            float percentage = time[i] / duration[i];
+            percentage = percentage < 0.0f ? 0.0f : percentage;
+            result[i] = percentage > 1.0f ? 1.0f : percentage;
+        }
+
+        //Apply the easing to each run of channels that use the same easing, a tween's channels are always in the same run
+        for (unsigned int i = 0; i < count;)
+        {
+            unsigned int run = i + 1;
+            while (run < count && easing[run] == easing[i])
+            {
+                run++;
+            }
+
+            Ease(static_cast<EasingType>(easing[i]), result + i, result + i, run - i, m_UsesApproximateEasing);
+            i = run;
+        }
+
+        //Interpolate the values and clamp them to their range
+        for (unsigned int i = 0; i < count; i++)
+        {
+            float value = start[i] + (end[i] - start[i]) * result[i];
+            value = value < minimum[i] ? minimum[i] : value;
+            result[i] = value > maximum[i] ? maximum[i] : value;
+        }
+
+        //Write the values of the tweens that have started, and count the tweens that have finished
+        float** values = m_Values.data();
+        unsigned int finished = 0;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            if (time[i] >= 0.0f && values[i] != nullptr)
+            {
+                *values[i] = result[i];
+            }
+
+            finished += time[i] >= duration[i] ? 1 : 0;
+        }
+
+        if (finished > 0)
+        {
+            RemoveFinishedTweens();
+        }
+    }
+
+    Tween TweenSet::Animate(float* aValue, float aFrom, float aTo, double aDuration, EasingType aEasing, double aDelay)
+    {
+        return AddTween(aValue, &aFrom, &aTo, 1, aDuration, aEasing, aDelay, -FLT_MAX, FLT_MAX);
+    }
+
+    Tween TweenSet::Animate(Vector2* aValue, Vector2 aFrom, Vector2 aTo, double aDuration, EasingType aEasing, double aDelay)
+    {
+        float from[] = { aFrom.x, aFrom.y };
+        float to[] = { aTo.x, aTo.y };
+        return AddTween(&aValue->x, from, to, 2, aDuration, aEasing, aDelay, -FLT_MAX, FLT_MAX);
+    }
+
+    Tween TweenSet::Animate(Color* aValue, Color aFrom, Color aTo, double aDuration, EasingType aEasing, double aDelay)
+    {
+        float from[] = { aFrom.r, aFrom.g, aFrom.b, aFrom.a };
+        float to[] = { aTo.r, aTo.g, aTo.b, aTo.a };
+        return AddTween(&aValue->r, from, to, 4, aDuration, aEasing, aDelay, 0.0f, 1.0f);
+    }
+
+    Tween TweenSet::AnimateTo(float* aValue, float aTo, double aDuration, EasingType aEasing, double aDelay)
+    {
+        return Animate(aValue, *aValue, aTo, aDuration, aEasing, aDelay);
+    }
+
+    Tween TweenSet::AnimateTo(Vector2* aValue, Vector2 aTo, double aDuration, EasingType aEasing, double aDelay)
+    {
+        return Animate(aValue, *aValue, aTo, aDuration, aEasing, aDelay);
+    }
+
+    Tween TweenSet::AnimateTo(Color* aValue, Color aTo, double aDuration, EasingType aEasing, double aDelay)
+    {
+        return Animate(aValue, *aValue, aTo, aDuration, aEasing, aDelay);
+    }
+
+    void TweenSet::Stop(Tween& aTween)
+    {
+        if (IsAnimating(aTween) == true)
+        {
+            //Detach the tween's channels from the slot and finish them, they are removed on the next update
+            Slot& slot = m_Slots[aTween.index];
+            for (unsigned int i = slot.channel; i < slot.channel + slot.channels; i++)
+            {
+                m_Values[i] = nullptr;
+                m_ChannelSlots[i] = 0;
+                m_Time[i] = m_Duration[i];
+            }
+
+            //Free the slot, the generation makes any other handle to it stale
+            slot.generation++;
+            m_FreeSlots.push_back(aTween.index);
+            m_TweenCount--;
+        }
+
+        aTween = Tween();
+    }
+
+    bool TweenSet::IsAnimating(const Tween& aTween)
+    {
+        return aTween.index != 0 && aTween.index < m_Slots.size() && m_Slots[aTween.index].generation == aTween.generation;
+    }
+
+    void TweenSet::SetUsesApproximateEasing(bool aUsesApproximateEasing)
+    {
+        m_UsesApproximateEasing = aUsesApproximateEasing;
+    }
+
+    bool TweenSet::UsesApproximateEasing()
+    {
+        return m_UsesApproximateEasing;
+    }
+
+    unsigned int TweenSet::GetTweenCount()
+    {
+        return m_TweenCount;
+    }
+
+    unsigned int TweenSet::GetChannelCount()
+    {
+        return static_cast<unsigned int>(m_Time.size());
+    }
+
+    Tween TweenSet::AddTween(float* aValues, const float* aFrom, const float* aTo, unsigned int aChannels, double aDuration, EasingType aEasing, double aDelay, float aMinimum, float aMaximum)
+    {
+        //Get a free slot, or add one
+        unsigned int index = 0;
+        if (m_FreeSlots.empty() == false)
+        {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            Slot slot = { 0, 0, 0 };
+            index = static_cast<unsigned int>(m_Slots.size());
+            m_Slots.push_back(slot);
+        }
+
+        Slot& slot = m_Slots[index];
+        slot.channel = static_cast<unsigned int>(m_Time.size());
+        slot.channels = aChannels;
+
+        //Add the tween's channels
+        float duration = static_cast<float>(aDuration);
+        duration = duration > TWEEN_SET_MIN_DURATION ? duration : TWEEN_SET_MIN_DURATION;
+        unsigned char easing = static_cast<unsigned char>(aEasing < EasingType_Count ? aEasing : EasingType_Linear);
+
+        for (unsigned int i = 0; i < aChannels; i++)
+        {
+            m_Start.push_back(aFrom[i]);
+            m_End.push_back(aTo[i]);
+            m_Time.push_back(-static_cast<float>(aDelay));
+            m_Duration.push_back(duration);
+            m_Minimum.push_back(aMinimum);
+            m_Maximum.push_back(aMaximum);
+            m_Result.push_back(0.0f);
+            m_Values.push_back(&aValues[i]);
+            m_Easing.push_back(easing);
+            m_ChannelSlots.push_back(index);
+        }
+
+        m_TweenCount++;
+
+        Tween tween;
+        tween.index = index;
+        tween.generation = slot.generation;
+        return tween;
+    }
+
+    void TweenSet::RemoveFinishedTweens()
+    {
+        const unsigned int count = static_cast<unsigned int>(m_Time.size());
+        unsigned int write = 0;
+
+        for (unsigned int read = 0; read < count; read++)
+        {
+            unsigned int index = m_ChannelSlots[read];
+
+            //Has the channel finished? Its tween's slot is freed by its first channel, stopped tweens have already been freed
+            if (m_Time[read] >= m_Duration[read])
+            {
+                if (index != 0 && m_Slots[index].channel == read)
+                {
+                    m_Slots[index].generation++;
+                    m_FreeSlots.push_back(index);
+                    m_TweenCount--;
+                }
+                continue;
+            }
+
+            //Move the channel down, if it's its tween's first channel, the slot has to refer to its new position
+            if (write != read)
+            {
+                m_Start[write] = m_Start[read];
+                m_End[write] = m_End[read];
+                m_Time[write] = m_Time[read];
+                m_Duration[write] = m_Duration[read];
+                m_Minimum[write] = m_Minimum[read];
+                m_Maximum[write] = m_Maximum[read];
+                m_Values[write] = m_Values[read];
+                m_Easing[write] = m_Easing[read];
+                m_ChannelSlots[write] = index;
+
+                if (index != 0 && m_Slots[index].channel == read)
+                {
+                    m_Slots[index].channel = write;
+                }
+            }
+
+            write++;
+        }
+
+        //Shrinking the arrays keeps their capacity
+        m_Start.resize(write);
+        m_End.resize(write);
+        m_Time.resize(write);
+        m_Duration.resize(write);
+        m_Minimum.resize(write);
+        m_Maximum.resize(write);
+        m_Result.resize(write);
+        m_Values.resize(write);
+        m_Easing.resize(write);
+        m_ChannelSlots.resize(write);
+    }
+}
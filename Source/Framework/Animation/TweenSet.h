@@ -0,0 +1,101 @@
+#ifndef __GameDev2D__TweenSet__
+#define __GameDev2D__TweenSet__
+
+#include "Easing.h"
+#include "../Graphics/Color.h"
+#include "../Math/Vector2.h"
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //A generational handle to a TweenSet tween, a handle to a tween that finished (or was stopped) is stale and is ignored
+    struct Tween
+    {
+        Tween() :
+            index(0),
+            generation(0)
+        {
+        }
+
+        unsigned int index;
+        unsigned int generation;
+    };
+
+    //A TweenSet animates float, Vector2 and Color values from one value to another. Unlike the Animators, the tweens don't
+    //listen for the Update event themselves, the TweenSet stores every animated float in contiguous arrays and updates all of
+    //them in one loop when it's updated. A Vector2 tween animates 2 floats and a Color tween animates 4. The TweenManager
+    //game service is the TweenSet that is updated every frame, it has no platform dependencies of its own
+    //
+    // ***
+    // THE TWEEN WRITES STRAIGHT TO THE VALUE'S POINTER, THE VALUE MUST OUTLIVE THE TWEEN OR THE TWEEN MUST BE STOPPED FIRST
+    // ***
+    class TweenSet
+    {
+    public:
+        TweenSet();
+        ~TweenSet();
+
+        //Updates all the tweens, finished tweens are removed
+        void Update(double delta);
+
+        //Animates a value from one value to another over the duration (in seconds). The delay (in seconds) is how long to wait
+        //before the tween starts, the value isn't written to until it does. Color values are clamped to the range 0.0 - 1.0
+        Tween Animate(float* value, float from, float to, double duration, EasingType easing = EasingType_Linear, double delay = 0.0);
+        Tween Animate(Vector2* value, Vector2 from, Vector2 to, double duration, EasingType easing = EasingType_Linear, double delay = 0.0);
+        Tween Animate(Color* value, Color from, Color to, double duration, EasingType easing = EasingType_Linear, double delay = 0.0);
+
+        //Animates a value from its current value to another over the duration (in seconds)
+        Tween AnimateTo(float* value, float to, double duration, EasingType easing = EasingType_Linear, double delay = 0.0);
+        Tween AnimateTo(Vector2* value, Vector2 to, double duration, EasingType easing = EasingType_Linear, double delay = 0.0);
+        Tween AnimateTo(Color* value, Color to, double duration, EasingType easing = EasingType_Linear, double delay = 0.0);
+
+        //Stops a tween, the value keeps whatever it was last set to
+        void Stop(Tween& tween);
+
+        //Returns wether the tween is still animating (or waiting for its delay)
+        bool IsAnimating(const Tween& tween);
+
+        //Sets wether the Sinusoidal, Exponential and Elastic easing curves are sampled from a table, which is faster but
+        //not exact (see Ease() for the error). It's off by default
+        void SetUsesApproximateEasing(bool usesApproximateEasing);
+        bool UsesApproximateEasing();
+
+        //Returns the number of tweens and the number of floats they animate
+        unsigned int GetTweenCount();
+        unsigned int GetChannelCount();
+
+    private:
+        //Adds a tween that animates a number of consecutive floats
+        Tween AddTween(float* values, const float* from, const float* to, unsigned int channels, double duration, EasingType easing, double delay, float minimum, float maximum);
+
+        //Removes the finished and stopped tweens, the order of the remaining tweens is kept
+        void RemoveFinishedTweens();
+
+        //A tween's slot, it refers to the tween's first channel
+        struct Slot
+        {
+            unsigned int channel;
+            unsigned int channels;
+            unsigned int generation;
+        };
+
+        //Member variables, each animated float is a channel and is stored across these arrays. A tween's channels are kept together
+        std::vector<float> m_Start;
+        std::vector<float> m_End;
+        std::vector<float> m_Time;
+        std::vector<float> m_Duration;
+        std::vector<float> m_Minimum;
+        std::vector<float> m_Maximum;
+        std::vector<float> m_Result;
+        std::vector<float*> m_Values;
+        std::vector<unsigned char> m_Easing;
+        std::vector<unsigned int> m_ChannelSlots;
+        std::vector<Slot> m_Slots;
+        std::vector<unsigned int> m_FreeSlots;
+        unsigned int m_TweenCount;
+        bool m_UsesApproximateEasing;
+    };
+}
+
+#endif
@@ -0,0 +1,241 @@
+#include "AdpcmDecoder.h"
+#include <string.h>
+
+
+namespace GameDev2D
+{
+    //Microsoft ADPCM's step size adaptation table
+    static const int MS_ADPCM_ADAPTATION[16] = { 230, 230, 230, 230, 307, 409, 512, 614, 768, 614, 512, 409, 307, 230, 230, 230 };
+
+    //IMA ADPCM's step sizes, and how much each nibble moves the step index
+    static const int IMA_ADPCM_STEPS[89] =
+    {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+        157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552,
+        1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+        12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+    };
+    static const int IMA_ADPCM_INDICES[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+    //Reads little endian values out of the encoded data
+    static inline unsigned short ReadU16(const unsigned char* aData)
+    {
+        return (unsigned short)(aData[0] | (aData[1] << 8));
+    }
+
+    static inline short ReadS16(const unsigned char* aData)
+    {
+        return (short)ReadU16(aData);
+    }
+
+    static inline unsigned int ReadU32(const unsigned char* aData)
+    {
+        return aData[0] | (aData[1] << 8) | (aData[2] << 16) | ((unsigned int)aData[3] << 24);
+    }
+
+    static inline int ClampSample(int aSample)
+    {
+        return aSample < -32768 ? -32768 : (aSample > 32767 ? 32767 : aSample);
+    }
+
+    AdpcmDecoder::AdpcmDecoder() :
+        m_CoefficientCount(0),
+        m_SampleRate(0),
+        m_FramesPerBlock(0),
+        m_FormatTag(0),
+        m_Channels(0),
+        m_BlockAlign(0)
+    {
+        memset(m_Coefficients, 0, sizeof(m_Coefficients));
+    }
+
+    bool AdpcmDecoder::IsAdpcm(unsigned short aFormatTag)
+    {
+        return aFormatTag == FORMAT_MS_ADPCM || aFormatTag == FORMAT_IMA_ADPCM;
+    }
+
+    bool AdpcmDecoder::Init(const unsigned char* aFormatChunk, unsigned int aFormatSize)
+    {
+        //The ADPCM formats extend the WAVEFORMATEX with at least the number of samples per block
+        if (aFormatSize < 20)
+        {
+            return false;
+        }
+
+        m_FormatTag = ReadU16(aFormatChunk);
+        m_Channels = ReadU16(aFormatChunk + 2);
+        m_SampleRate = ReadU32(aFormatChunk + 4);
+        m_BlockAlign = ReadU16(aFormatChunk + 12);
+        m_FramesPerBlock = ReadU16(aFormatChunk + 18);
+
+        if (IsAdpcm(m_FormatTag) == false || ReadU16(aFormatChunk + 14) != 4 || (m_Channels != 1 && m_Channels != 2))
+        {
+            return false;
+        }
+
+        if (m_FormatTag == FORMAT_MS_ADPCM)
+        {
+            //Microsoft ADPCM stores its predictor coefficients in the format
+            if (aFormatSize < 22)
+            {
+                return false;
+            }
+
+            m_CoefficientCount = ReadU16(aFormatChunk + 20);
+            if (m_CoefficientCount == 0 || m_CoefficientCount > MAX_COEFFICIENTS || aFormatSize < 22 + m_CoefficientCount * 4)
+            {
+                return false;
+            }
+
+            for (unsigned int i = 0; i < m_CoefficientCount; i++)
+            {
+                m_Coefficients[i][0] = ReadS16(aFormatChunk + 22 + i * 4);
+                m_Coefficients[i][1] = ReadS16(aFormatChunk + 24 + i * 4);
+            }
+        }
+
+        //The samples per block MUST match the block size
+        return m_FramesPerBlock > 0 && GetFramesInBlock(m_BlockAlign) == m_FramesPerBlock;
+    }
+
+    unsigned short AdpcmDecoder::GetFormatTag() const
+    {
+        return m_FormatTag;
+    }
+
+    unsigned short AdpcmDecoder::GetChannels() const
+    {
+        return m_Channels;
+    }
+
+    unsigned int AdpcmDecoder::GetSampleRate() const
+    {
+        return m_SampleRate;
+    }
+
+    unsigned short AdpcmDecoder::GetBlockAlign() const
+    {
+        return m_BlockAlign;
+    }
+
+    unsigned int AdpcmDecoder::GetFramesPerBlock() const
+    {
+        return m_FramesPerBlock;
+    }
+
+    unsigned int AdpcmDecoder::GetFrameCount(unsigned int aDataSize) const
+    {
+        return (aDataSize / m_BlockAlign) * m_FramesPerBlock + GetFramesInBlock(aDataSize % m_BlockAlign);
+    }
+
+    unsigned int AdpcmDecoder::DecodeBlock(const unsigned char* aBlock, unsigned int aBlockSize, short* aOutput) const
+    {
+        unsigned int frames = GetFramesInBlock(aBlockSize < m_BlockAlign ? aBlockSize : m_BlockAlign);
+        if (frames == 0)
+        {
+            return 0;
+        }
+
+        return m_FormatTag == FORMAT_MS_ADPCM ? DecodeMsAdpcm(aBlock, frames, aOutput) : DecodeImaAdpcm(aBlock, frames, aOutput);
+    }
+
+    unsigned int AdpcmDecoder::GetFramesInBlock(unsigned int aBlockSize) const
+    {
+        if (m_FormatTag == FORMAT_MS_ADPCM)
+        {
+            //A 7 byte header per channel holds the first 2 samples, then every byte holds 2 samples
+            unsigned int header = 7 * m_Channels;
+            return aBlockSize >= header ? 2 + (aBlockSize - header) * 2 / m_Channels : 0;
+        }
+
+        //A 4 byte header per channel holds the first sample, then every 4 bytes per channel hold 8 samples
+        unsigned int header = 4 * m_Channels;
+        return aBlockSize >= header ? 1 + (aBlockSize - header) / (4 * m_Channels) * 8 : 0;
+    }
+
+    unsigned int AdpcmDecoder::DecodeMsAdpcm(const unsigned char* aBlock, unsigned int aFrames, short* aOutput) const
+    {
+        const unsigned int channels = m_Channels;
+        int coefficient1[2];
+        int coefficient2[2];
+        int delta[2];
+        int sample1[2];
+        int sample2[2];
+
+        //The header holds each channel's predictor, then its delta, then its two most recent samples
+        for (unsigned int c = 0; c < channels; c++)
+        {
+            unsigned int predictor = aBlock[c];
+            predictor = predictor < m_CoefficientCount ? predictor : m_CoefficientCount - 1;
+            coefficient1[c] = m_Coefficients[predictor][0];
+            coefficient2[c] = m_Coefficients[predictor][1];
+            delta[c] = ReadS16(aBlock + channels + c * 2);
+            sample1[c] = ReadS16(aBlock + channels * 3 + c * 2);
+            sample2[c] = ReadS16(aBlock + channels * 5 + c * 2);
+
+            //The older sample is played first
+            aOutput[c] = (short)sample2[c];
+            aOutput[channels + c] = (short)sample1[c];
+        }
+
+        //Every nibble is a sample, the high nibble first, channels are interleaved nibble by nibble
+        const unsigned char* data = aBlock + channels * 7;
+        unsigned int samples = (aFrames - 2) * channels;
+        for (unsigned int i = 0; i < samples; i++)
+        {
+            unsigned int c = i % channels;
+            int nibble = (i & 1) == 0 ? data[i / 2] >> 4 : data[i / 2] & 0x0f;
+            int signedNibble = nibble >= 8 ? nibble - 16 : nibble;
+
+            int predicted = (sample1[c] * coefficient1[c] + sample2[c] * coefficient2[c]) >> 8;
+            int sample = ClampSample(predicted + signedNibble * delta[c]);
+
+            sample2[c] = sample1[c];
+            sample1[c] = sample;
+            delta[c] = (MS_ADPCM_ADAPTATION[nibble] * delta[c]) >> 8;
+            delta[c] = delta[c] < 16 ? 16 : delta[c];
+
+            aOutput[channels * 2 + i] = (short)sample;
+        }
+
+        return aFrames;
+    }
+
+    unsigned int AdpcmDecoder::DecodeImaAdpcm(const unsigned char* aBlock, unsigned int aFrames, short* aOutput) const
+    {
+        const unsigned int channels = m_Channels;
+
+        for (unsigned int c = 0; c < channels; c++)
+        {
+            //The header holds the channel's first sample and its step index
+            int sample = ReadS16(aBlock + c * 4);
+            int index = aBlock[c * 4 + 2];
+            index = index > 88 ? 88 : index;
+            aOutput[c] = (short)sample;
+
+            //Each channel's nibbles come in 4 byte groups of 8 samples, the low nibble first
+            const unsigned char* data = aBlock + channels * 4 + c * 4;
+            for (unsigned int frame = 1; frame < aFrames; frame++)
+            {
+                unsigned int i = frame - 1;
+                unsigned char byte = data[(i / 8) * channels * 4 + (i % 8) / 2];
+                int nibble = (i & 1) == 0 ? byte & 0x0f : byte >> 4;
+
+                int step = IMA_ADPCM_STEPS[index];
+                int difference = step >> 3;
+                if ((nibble & 1) != 0) difference += step >> 2;
+                if ((nibble & 2) != 0) difference += step >> 1;
+                if ((nibble & 4) != 0) difference += step;
+                if ((nibble & 8) != 0) difference = -difference;
+
+                sample = ClampSample(sample + difference);
+                index += IMA_ADPCM_INDICES[nibble];
+                index = index < 0 ? 0 : (index > 88 ? 88 : index);
+
+                aOutput[frame * channels + c] = (short)sample;
+            }
+        }
+
+        return aFrames;
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+
+namespace GameDev2D
+{
+    //The AdpcmDecoder decodes Microsoft ADPCM and IMA ADPCM wave data to 16-bit PCM. Both formats store 4 bits per sample
+    //in independent blocks, so any block can be decoded on its own and a block is the smallest unit that can be seeked to
+    class AdpcmDecoder
+    {
+    public:
+        //The wave format tags of the ADPCM formats
+        static const unsigned short FORMAT_MS_ADPCM = 0x0002;
+        static const unsigned short FORMAT_IMA_ADPCM = 0x0011;
+
+        AdpcmDecoder();
+
+        //Returns wether the format tag is an ADPCM format that can be decoded
+        static bool IsAdpcm(unsigned short formatTag);
+
+        //Reads the ADPCM format from the contents of a 'fmt ' chunk, returns false if the format isn't valid
+        bool Init(const unsigned char* formatChunk, unsigned int formatSize);
+
+        //Returns the format of the encoded data
+        unsigned short GetFormatTag() const;
+        unsigned short GetChannels() const;
+        unsigned int GetSampleRate() const;
+        unsigned short GetBlockAlign() const;
+
+        //Returns the number of frames that a whole block decodes to
+        unsigned int GetFramesPerBlock() const;
+
+        //Returns the number of frames that the encoded data decodes to, including a partial last block
+        unsigned int GetFrameCount(unsigned int dataSize) const;
+
+        //Decodes a block to interleaved 16-bit samples. The last block of the data can be partial, the output MUST hold
+        //as many frames as the block decodes to. Returns the number of frames that were decoded
+        unsigned int DecodeBlock(const unsigned char* block, unsigned int blockSize, short* output) const;
+
+    private:
+        //Returns the number of frames in a block of the size
+        unsigned int GetFramesInBlock(unsigned int blockSize) const;
+
+        //Decoders for each format
+        unsigned int DecodeMsAdpcm(const unsigned char* block, unsigned int frames, short* output) const;
+        unsigned int DecodeImaAdpcm(const unsigned char* block, unsigned int frames, short* output) const;
+
+        //Member variables
+        static const unsigned int MAX_COEFFICIENTS = 32;
+        short m_Coefficients[MAX_COEFFICIENTS][2];
+        unsigned int m_CoefficientCount;
+        unsigned int m_SampleRate;
+        unsigned int m_FramesPerBlock;
+        unsigned short m_FormatTag;
+        unsigned short m_Channels;
+        unsigned short m_BlockAlign;
+    };
+}
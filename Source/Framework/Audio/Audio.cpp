@@ -1,5 +1,7 @@
 #include "Audio.h"
+#include "AudioStream.h"
 #include "../Services/Services.h"
+#include "../Events/AudioEvent.h"
 #include "../Events/Event.h"
 #include <algorithm>
 
@@ -7,27 +9,66 @@
 namespace GameDev2D
 {
 	Audio::Audio(const std::string& aFilename) :
-		m_Source(nullptr),
+		m_WaveHandle(),
+		m_Stream(nullptr),
+		m_Voice(),
+		m_AudioBytes(0),
+		m_PlayBegin(0),
 		m_IsPlaying(false),
 		m_SampleOffset(0)
 	{
-		//Get the wave data from the resource manager
-		WaveData* waveData = Services::GetResourceManager()->GetWaveData(aFilename);
+		//Long files are streamed from disk
+		m_Stream = Services::GetResourceManager()->OpenWaveStream(aFilename);
+		if (m_Stream != nullptr)
+		{
+			//Fill in the wave format from the stream's format
+			ZeroMemory(&m_WaveFormat, sizeof(WAVEFORMATEX));
+			m_WaveFormat.wFormatTag = m_Stream->GetFormatTag();
+			m_WaveFormat.nChannels = m_Stream->GetChannels();
+			m_WaveFormat.nSamplesPerSec = m_Stream->GetSampleRate();
+			m_WaveFormat.nBlockAlign = m_Stream->GetBlockAlign();
+			m_WaveFormat.nAvgBytesPerSec = m_WaveFormat.nSamplesPerSec * m_WaveFormat.nBlockAlign;
+			m_WaveFormat.wBitsPerSample = m_Stream->GetBitsPerSample();
+			m_AudioBytes = m_Stream->GetDataSize();
+
+			AudioSource source;
+			m_Stream->GetAudioSource(source);
+			m_Voice = Services::GetAudioEngine()->GetMixer()->CreateVoice(source, this);
+			return;
+		}
 
-		//Copy the wave format and xaudio buffer
-		memcpy(&m_WaveFormat, &waveData->waveFormat, sizeof(WAVEFORMATEX));
-		memcpy(&m_Buffer, &waveData->buffer, sizeof(XAUDIO2_BUFFER));
+		//Acquire the wave data from the resource manager, the handle keeps the wave data loaded while the voice refers to it
+		m_WaveHandle = Services::GetResourceManager()->AcquireWaveData(aFilename);
+		WaveData* waveData = Services::GetResourceManager()->GetWaveData(m_WaveHandle);
 
-		//Set the buffer's context pointer
-		m_Buffer.pContext = this;
+		//Copy the wave format and the size of the wave data
+		memcpy(&m_WaveFormat, &waveData->waveFormat, sizeof(WAVEFORMATEX));
+		m_AudioBytes = waveData->buffer.AudioBytes;
 
-		//Create the audio voice
-		Services::GetAudioEngine()->CreateAudioVoice(&m_Source, &m_WaveFormat);
+		//Create the mixer voice, if the mixer can't play the wave format the voice is silent
+		AudioSource source;
+		if (waveData->GetAudioSource(source) == false)
+		{
+			Log::Error(false, Log::Verbosity_Audio, "[Audio] %s has a wave format (%u) that can't be played", aFilename.c_str(), m_WaveFormat.wFormatTag);
+		}
+		m_Voice = Services::GetAudioEngine()->GetMixer()->CreateVoice(source, this);
 	}
 
 	Audio::~Audio()
 	{
-		Services::GetAudioEngine()->DestroyAudioVoice(m_Source);
+		Services::GetAudioEngine()->GetMixer()->DestroyVoice(m_Voice);
+
+		//Delete the stream or release the wave data, now that the voice no longer uses it
+		if (m_Stream != nullptr)
+		{
+			if (m_Stream->IsCompressed() == true)
+			{
+				Log::Message(Log::Verbosity_Audio, "[Audio] Spent %.2f ms decoding a compressed stream, %u bytes resident", m_Stream->GetDecodeTime() * 1000.0, m_Stream->GetResidentBytes());
+			}
+			delete m_Stream;
+			m_Stream = nullptr;
+		}
+		Services::GetResourceManager()->ReleaseWaveData(m_WaveHandle);
 	}
 
 	void Audio::Play()
@@ -35,18 +76,22 @@ namespace GameDev2D
 		//We can only have one
 		if (IsPlaying() == false)
 		{
-			//Submit the source buffer and start playing the sound
-			m_Source->SubmitSourceBuffer(&m_Buffer);
-			m_Source->Start();
+			//A stream has to read the frames at the position before the voice can play them
+			if (m_Stream != nullptr)
+			{
+				m_Stream->Seek(m_PlayBegin);
+			}
+
+			//Set the position and start playing the sound
+			AudioMixer* mixer = Services::GetAudioEngine()->GetMixer();
+			mixer->SetPosition(m_Voice, m_PlayBegin);
+			mixer->Start(m_Voice);
 
-			//Query the state of the buffer to calculate the sample offset, 
-			//this is needed for accurate playback information
-			XAUDIO2_VOICE_STATE state;
-			m_Source->GetState(&state);
-			m_SampleOffset = state.SamplesPlayed;
+			//Get the number of samples the voice has played, this is needed for accurate playback information
+			m_SampleOffset = mixer->GetFramesPlayed(m_Voice);
 
-			//Reset the buffer
-			m_Buffer.PlayBegin = 0;
+			//Reset the position
+			m_PlayBegin = 0;
 
 			//Set the is playing flag to true
 			m_IsPlaying = true;
@@ -55,9 +100,8 @@ namespace GameDev2D
 
 	void Audio::Stop()
 	{
-		//Stop playing the sound and flush the source buffer
-		m_Source->Stop();
-		m_Source->FlushSourceBuffers();
+		//Stop playing the sound
+		Services::GetAudioEngine()->GetMixer()->Stop(m_Voice);
 
 		//Set the is playing flag to false
 		m_IsPlaying = false;
@@ -70,12 +114,17 @@ namespace GameDev2D
 
 	void Audio::SetDoesLoop(bool aDoesLoop)
 	{
-		m_Buffer.LoopCount = (aDoesLoop == true ? XAUDIO2_LOOP_INFINITE : 0);
+		Services::GetAudioEngine()->GetMixer()->SetLooping(m_Voice, aDoesLoop);
+
+		if (m_Stream != nullptr)
+		{
+			m_Stream->SetLooping(aDoesLoop);
+		}
 	}
 
 	bool Audio::DoesLoop()
 	{
-		return m_Buffer.LoopCount == XAUDIO2_LOOP_INFINITE;
+		return Services::GetAudioEngine()->GetMixer()->IsLooping(m_Voice);
 	}
 
 	unsigned int Audio::GetNumberOfChannels()
@@ -94,26 +143,32 @@ namespace GameDev2D
 		aFrequencyRatio = fmaxf(aFrequencyRatio, 0.0f);
 
 		//Set the frequency ratio
-		m_Source->SetFrequencyRatio(aFrequencyRatio);
+		Services::GetAudioEngine()->GetMixer()->SetFrequencyRatio(m_Voice, aFrequencyRatio);
 	}
 
 	float Audio::GetFrequencyRatio()
 	{
-		float frequencyRatio = 0;
-		m_Source->GetFrequencyRatio(&frequencyRatio);
-		return frequencyRatio;
+		return Services::GetAudioEngine()->GetMixer()->GetFrequencyRatio(m_Voice);
 	}
 
 	void Audio::SetVolume(float aVolume)
 	{
-		m_Source->SetVolume(aVolume);
+		Services::GetAudioEngine()->GetMixer()->SetVolume(m_Voice, aVolume);
 	}
 
 	float Audio::GetVolume()
 	{
-		float volume = 0.0f;
-		m_Source->GetVolume(&volume);
-		return volume;
+		return Services::GetAudioEngine()->GetMixer()->GetVolume(m_Voice);
+	}
+
+	void Audio::SetPan(float aPan)
+	{
+		Services::GetAudioEngine()->GetMixer()->SetPan(m_Voice, aPan);
+	}
+
+	float Audio::GetPan()
+	{
+		return Services::GetAudioEngine()->GetMixer()->GetPan(m_Voice);
 	}
 
 	void Audio::SetSample(unsigned long long aSample)
@@ -122,7 +177,7 @@ namespace GameDev2D
 		aSample = aSample < GetNumberOfSamples() ? aSample : GetNumberOfSamples();
 
 		//Set the sample offset the start playing the sound at
-		m_Buffer.PlayBegin = static_cast<unsigned int>(aSample);
+		m_PlayBegin = static_cast<unsigned int>(aSample);
 
 		//If the sound is playing stop it, then start it at the need sample offset
 		if(IsPlaying() == true)
@@ -146,9 +201,7 @@ namespace GameDev2D
 
 	unsigned long long Audio::GetElapsedSamples()
 	{
-		XAUDIO2_VOICE_STATE state;
-		m_Source->GetState(&state);
-		return state.SamplesPlayed - m_SampleOffset;
+		return Services::GetAudioEngine()->GetMixer()->GetFramesPlayed(m_Voice) - m_SampleOffset;
 	}
 
 	unsigned int Audio::GetElapsedMS()
@@ -192,8 +245,8 @@ namespace GameDev2D
 			case WAVE_FORMAT_ADPCM:
 			{
 				const ADPCMWAVEFORMAT* adpcmFmt = reinterpret_cast<const ADPCMWAVEFORMAT*>(&m_WaveFormat);
-				uint64_t length = uint64_t(m_Buffer.AudioBytes / adpcmFmt->wfx.nBlockAlign) * adpcmFmt->wSamplesPerBlock;
-				int partial = m_Buffer.AudioBytes % adpcmFmt->wfx.nBlockAlign;
+				uint64_t length = uint64_t(m_AudioBytes / adpcmFmt->wfx.nBlockAlign) * adpcmFmt->wSamplesPerBlock;
+				int partial = m_AudioBytes % adpcmFmt->wfx.nBlockAlign;
 				if (partial)
 				{
 					if (partial >= (7 * adpcmFmt->wfx.nChannels))
@@ -211,7 +264,7 @@ namespace GameDev2D
 			{
 				if (m_WaveFormat.wBitsPerSample > 0)
 				{
-					return (uint64_t(m_Buffer.AudioBytes) * 8) / uint64_t(m_WaveFormat.wBitsPerSample * m_WaveFormat.nChannels);
+					return (uint64_t(m_AudioBytes) * 8) / uint64_t(m_WaveFormat.wBitsPerSample * m_WaveFormat.nChannels);
 				}
 			}
 		}
@@ -241,4 +294,22 @@ namespace GameDev2D
 			m_IsPlaying = false;
 		}
 	}
+
+	void Audio::OnVoiceStarted()
+	{
+		AudioEvent audioEvent(this, AUDIO_PLAYBACK_STARTED);
+		DispatchEvent(audioEvent);
+	}
+
+	void Audio::OnVoiceEnded()
+	{
+		AudioEvent audioEvent(this, AUDIO_PLAYBACK_ENDED);
+		DispatchEvent(audioEvent);
+	}
+
+	void Audio::OnVoiceLooped()
+	{
+		AudioEvent audioEvent(this, AUDIO_LOOP_ENDED);
+		DispatchEvent(audioEvent);
+	}
 }
\ No newline at end of file
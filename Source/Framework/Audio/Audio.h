@@ -1,18 +1,20 @@
 #pragma once
 
+#include "AudioMixer.h"
 #include "../Events/EventDispatcher.h"
+#include "../Services/ResourceManager/ResourceHandle.h"
 #include <xaudio2.h>
 #include <string>
 
 
 namespace GameDev2D
 {
-    //Audio class to handle playback of both music and sounds effects in game.
-    class Audio : public EventDispatcher
+    //Audio class to handle playback of both music and sounds effects in game, each Audio object plays on its own AudioMixer voice.
+    class Audio : public EventDispatcher, public AudioVoiceCallback
     {
     public:
-        //Constructor for the Audio class, many extensions are supported, use 'streamed' for longer files such as background music.
-        //Don't stream for short files, such as sound effects. Audio files be looped.
+        //Constructor for the Audio class, wave files larger than AUDIO_STREAMING_THRESHOLD (such as background music) are streamed
+        //from disk, shorter files (such as sound effects) are loaded through the ResourceManager. Audio files be looped.
         Audio(const std::string& filename);
         ~Audio();
 
@@ -47,6 +49,12 @@ namespace GameDev2D
         //Returns the current volume of the audio file
         float GetVolume();
 
+        //Set the pan of the audio file, range -1.0f (left) to 1.0f (right)
+        void SetPan(float pan);
+
+        //Returns the current pan of the audio file
+        float GetPan();
+
         //Sets the current position of the audio file, in samples
 		void SetSample(unsigned long long sample);
 
@@ -83,14 +91,23 @@ namespace GameDev2D
 		//Returns the duration of the audio object, in seconds
 		double GetDuration();
 
-		//
+		//Dispatches the event to the listeners, an AUDIO_PLAYBACK_ENDED event also stops the audio
 		void DispatchEvent(Event& event);
 
+		//AudioVoiceCallback methods, they dispatch the playback events. They are called on the main thread, once per frame,
+		//for the notifications the mixer queued since the last frame
+		void OnVoiceStarted();
+		void OnVoiceEnded();
+		void OnVoiceLooped();
+
     private:
         //Member variables
-		IXAudio2SourceVoice* m_Source;
+		WaveHandle m_WaveHandle;
+		AudioStream* m_Stream;
+		AudioVoice m_Voice;
 		WAVEFORMATEX m_WaveFormat;
-		XAUDIO2_BUFFER m_Buffer;
+		unsigned int m_AudioBytes;
+		unsigned int m_PlayBegin;
 		bool m_IsPlaying;
 		unsigned long long m_SampleOffset;
     };
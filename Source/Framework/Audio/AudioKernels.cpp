@@ -0,0 +1,329 @@
+#include "AudioKernels.h"
+#include "../Math/Simd.h"
+#include <math.h>
+
+
+namespace GameDev2D
+{
+    //Fixed point constants
+    const unsigned long long AUDIO_KERNELS_FRACTION_MASK = 0xffffffffULL;
+    const float AUDIO_KERNELS_FRACTION_SCALE = 1.0f / 4294967296.0f;
+
+    //The cutoff of the sinc filter, relative to the Nyquist frequency, it's below 1.0 because 8 taps can't make a steep transition band
+    const double AUDIO_KERNELS_SINC_CUTOFF = 0.9;
+
+    //The sinc filter's coefficients, there is one row of taps per phase, plus a final row for a fraction that rounds up to the next frame.
+    //The stereo rows repeat each tap twice, so that they can be multiplied directly with interleaved stereo frames
+    struct SincTable
+    {
+        SincTable()
+        {
+            const double pi = 3.14159265358979323846;
+            const double halfWidth = AudioKernels::SINC_TAPS / 2;
+
+            for (unsigned int phase = 0; phase <= AudioKernels::SINC_PHASES; phase++)
+            {
+                double taps[AudioKernels::SINC_TAPS];
+                double sum = 0.0;
+
+                for (unsigned int i = 0; i < AudioKernels::SINC_TAPS; i++)
+                {
+                    //The distance from the tap's frame to the position being sampled
+                    double x = (double)i - (halfWidth - 1.0) - (double)phase / AudioKernels::SINC_PHASES;
+                    double sinc = x != 0.0 ? sin(pi * AUDIO_KERNELS_SINC_CUTOFF * x) / (pi * x) : AUDIO_KERNELS_SINC_CUTOFF;
+                    double window = 0.42 + 0.5 * cos(pi * x / halfWidth) + 0.08 * cos(2.0 * pi * x / halfWidth);
+                    taps[i] = sinc * window;
+                    sum += taps[i];
+                }
+
+                //Normalize the taps, so that every phase has unity gain
+                for (unsigned int i = 0; i < AudioKernels::SINC_TAPS; i++)
+                {
+                    float tap = (float)(taps[i] / sum);
+                    mono[phase][i] = tap;
+                    stereo[phase][i * 2] = tap;
+                    stereo[phase][i * 2 + 1] = tap;
+                }
+            }
+        }
+
+        alignas(16) float mono[AudioKernels::SINC_PHASES + 1][AudioKernels::SINC_TAPS];
+        alignas(16) float stereo[AudioKernels::SINC_PHASES + 1][AudioKernels::SINC_TAPS * 2];
+    };
+
+    //Returns the sinc table, it's built the first time it's needed
+    static const SincTable& GetSincTable()
+    {
+        static SincTable s_SincTable;
+        return s_SincTable;
+    }
+
+    //Returns the sinc table row for the fractional part of a position, rounded to the nearest phase
+    inline unsigned int GetSincPhase(unsigned long long aPosition)
+    {
+        return (unsigned int)(((aPosition & AUDIO_KERNELS_FRACTION_MASK) + (1ULL << 23)) >> 24);
+    }
+
+    void AudioKernels::ConvertU8ToFloat(const unsigned char* aInput, float* aOutput, unsigned int aCount)
+    {
+        unsigned int i = 0;
+
+#if SIMD_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(128);
+        const __m128 scale = _mm_set1_ps(1.0f / 128.0f);
+
+        for (; i + 16 <= aCount; i += 16)
+        {
+            //Widen 16 bytes to two vectors of 8 signed shorts, then to four vectors of 4 ints
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aInput + i));
+            __m128i low = _mm_sub_epi16(_mm_unpacklo_epi8(bytes, zero), bias);
+            __m128i high = _mm_sub_epi16(_mm_unpackhi_epi8(bytes, zero), bias);
+
+            _mm_storeu_ps(aOutput + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(low, low), 16)), scale));
+            _mm_storeu_ps(aOutput + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(low, low), 16)), scale));
+            _mm_storeu_ps(aOutput + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(high, high), 16)), scale));
+            _mm_storeu_ps(aOutput + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(high, high), 16)), scale));
+        }
+#endif
+
+        ConvertU8ToFloatScalar(aInput + i, aOutput + i, aCount - i);
+    }
+
+    void AudioKernels::ConvertS16ToFloat(const short* aInput, float* aOutput, unsigned int aCount)
+    {
+        unsigned int i = 0;
+
+#if SIMD_SSE2
+        const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+
+        for (; i + 8 <= aCount; i += 8)
+        {
+            //Sign extend the shorts to ints by unpacking them into the high half and shifting them back down
+            __m128i shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aInput + i));
+            __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16);
+            __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(shorts, shorts), 16);
+
+            _mm_storeu_ps(aOutput + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+            _mm_storeu_ps(aOutput + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+        }
+#endif
+
+        ConvertS16ToFloatScalar(aInput + i, aOutput + i, aCount - i);
+    }
+
+    void AudioKernels::ResampleLinear(const float* aInput, unsigned int aChannels, unsigned long long aPosition, unsigned long long aStep, float* aOutput, unsigned int aFrameCount)
+    {
+        unsigned int i = 0;
+
+#if SIMD_SSE2
+        //The frames don't sit at a constant stride, so they're loaded individually and interpolated 4 samples at a time
+        if (aChannels == 1)
+        {
+            for (; i + 4 <= aFrameCount; i += 4)
+            {
+                unsigned long long p0 = aPosition;
+                unsigned long long p1 = p0 + aStep;
+                unsigned long long p2 = p1 + aStep;
+                unsigned long long p3 = p2 + aStep;
+                const float* f0 = aInput + (p0 >> 32);
+                const float* f1 = aInput + (p1 >> 32);
+                const float* f2 = aInput + (p2 >> 32);
+                const float* f3 = aInput + (p3 >> 32);
+
+                __m128 a = _mm_setr_ps(f0[0], f1[0], f2[0], f3[0]);
+                __m128 b = _mm_setr_ps(f0[1], f1[1], f2[1], f3[1]);
+                __m128 fraction = _mm_setr_ps((float)(p0 & AUDIO_KERNELS_FRACTION_MASK), (float)(p1 & AUDIO_KERNELS_FRACTION_MASK),
+                                              (float)(p2 & AUDIO_KERNELS_FRACTION_MASK), (float)(p3 & AUDIO_KERNELS_FRACTION_MASK));
+                fraction = _mm_mul_ps(fraction, _mm_set1_ps(AUDIO_KERNELS_FRACTION_SCALE));
+
+                _mm_storeu_ps(aOutput + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), fraction)));
+                aPosition = p3 + aStep;
+            }
+        }
+        else
+        {
+            for (; i + 2 <= aFrameCount; i += 2)
+            {
+                unsigned long long p0 = aPosition;
+                unsigned long long p1 = p0 + aStep;
+                const float* f0 = aInput + (p0 >> 32) * 2;
+                const float* f1 = aInput + (p1 >> 32) * 2;
+
+                __m128 a = _mm_setr_ps(f0[0], f0[1], f1[0], f1[1]);
+                __m128 b = _mm_setr_ps(f0[2], f0[3], f1[2], f1[3]);
+                float t0 = (float)(p0 & AUDIO_KERNELS_FRACTION_MASK) * AUDIO_KERNELS_FRACTION_SCALE;
+                float t1 = (float)(p1 & AUDIO_KERNELS_FRACTION_MASK) * AUDIO_KERNELS_FRACTION_SCALE;
+                __m128 fraction = _mm_setr_ps(t0, t0, t1, t1);
+
+                _mm_storeu_ps(aOutput + i * 2, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), fraction)));
+                aPosition = p1 + aStep;
+            }
+        }
+#endif
+
+        ResampleLinearScalar(aInput, aChannels, aPosition, aStep, aOutput + i * aChannels, aFrameCount - i);
+    }
+
+    void AudioKernels::ResampleSinc(const float* aInput, unsigned int aChannels, unsigned long long aPosition, unsigned long long aStep, float* aOutput, unsigned int aFrameCount)
+    {
+#if SIMD_SSE2
+        const SincTable& table = GetSincTable();
+        const unsigned int before = SINC_TAPS / 2 - 1;
+
+        if (aChannels == 1)
+        {
+            for (unsigned int i = 0; i < aFrameCount; i++)
+            {
+                const float* frames = aInput + (aPosition >> 32) - before;
+                const float* taps = table.mono[GetSincPhase(aPosition)];
+
+                //Multiply the 8 frames by the 8 taps, then add the 4 partial sums together
+                __m128 sum = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(frames), _mm_load_ps(taps)), _mm_mul_ps(_mm_loadu_ps(frames + 4), _mm_load_ps(taps + 4)));
+                sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+                sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+                _mm_store_ss(aOutput + i, sum);
+
+                aPosition += aStep;
+            }
+        }
+        else
+        {
+            for (unsigned int i = 0; i < aFrameCount; i++)
+            {
+                const float* frames = aInput + (aPosition >> 32) * 2 - before * 2;
+                const float* taps = table.stereo[GetSincPhase(aPosition)];
+
+                //Each vector holds 2 interleaved frames, the partial sums are left and right pairs
+                __m128 sum = _mm_mul_ps(_mm_loadu_ps(frames), _mm_load_ps(taps));
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(frames + 4), _mm_load_ps(taps + 4)));
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(frames + 8), _mm_load_ps(taps + 8)));
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(frames + 12), _mm_load_ps(taps + 12)));
+                sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+                _mm_storel_pi(reinterpret_cast<__m64*>(aOutput + i * 2), sum);
+
+                aPosition += aStep;
+            }
+        }
+#else
+        ResampleSincScalar(aInput, aChannels, aPosition, aStep, aOutput, aFrameCount);
+#endif
+    }
+
+    void AudioKernels::AccumulateMono(const float* aInput, float* aOutput, unsigned int aFrameCount, float aLeftGain, float aRightGain)
+    {
+        unsigned int i = 0;
+
+#if SIMD_SSE2
+        const __m128 gain = _mm_setr_ps(aLeftGain, aRightGain, aLeftGain, aRightGain);
+
+        for (; i + 4 <= aFrameCount; i += 4)
+        {
+            //Duplicate each mono sample into a left and right pair
+            __m128 samples = _mm_loadu_ps(aInput + i);
+            __m128 low = _mm_unpacklo_ps(samples, samples);
+            __m128 high = _mm_unpackhi_ps(samples, samples);
+
+            float* output = aOutput + i * 2;
+            _mm_storeu_ps(output, _mm_add_ps(_mm_loadu_ps(output), _mm_mul_ps(low, gain)));
+            _mm_storeu_ps(output + 4, _mm_add_ps(_mm_loadu_ps(output + 4), _mm_mul_ps(high, gain)));
+        }
+#endif
+
+        AccumulateMonoScalar(aInput + i, aOutput + i * 2, aFrameCount - i, aLeftGain, aRightGain);
+    }
+
+    void AudioKernels::AccumulateStereo(const float* aInput, float* aOutput, unsigned int aFrameCount, float aLeftGain, float aRightGain)
+    {
+        unsigned int i = 0;
+
+#if SIMD_SSE2
+        const __m128 gain = _mm_setr_ps(aLeftGain, aRightGain, aLeftGain, aRightGain);
+
+        for (; i + 4 <= aFrameCount; i += 4)
+        {
+            const float* input = aInput + i * 2;
+            float* output = aOutput + i * 2;
+            _mm_storeu_ps(output, _mm_add_ps(_mm_loadu_ps(output), _mm_mul_ps(_mm_loadu_ps(input), gain)));
+            _mm_storeu_ps(output + 4, _mm_add_ps(_mm_loadu_ps(output + 4), _mm_mul_ps(_mm_loadu_ps(input + 4), gain)));
+        }
+#endif
+
+        AccumulateStereoScalar(aInput + i * 2, aOutput + i * 2, aFrameCount - i, aLeftGain, aRightGain);
+    }
+
+    void AudioKernels::ConvertU8ToFloatScalar(const unsigned char* aInput, float* aOutput, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            aOutput[i] = ((int)aInput[i] - 128) * (1.0f / 128.0f);
+        }
+    }
+
+    void AudioKernels::ConvertS16ToFloatScalar(const short* aInput, float* aOutput, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            aOutput[i] = aInput[i] * (1.0f / 32768.0f);
+        }
+    }
+
+    void AudioKernels::ResampleLinearScalar(const float* aInput, unsigned int aChannels, unsigned long long aPosition, unsigned long long aStep, float* aOutput, unsigned int aFrameCount)
+    {
+        for (unsigned int i = 0; i < aFrameCount; i++)
+        {
+            const float* a = aInput + (aPosition >> 32) * aChannels;
+            const float* b = a + aChannels;
+            float fraction = (float)(aPosition & AUDIO_KERNELS_FRACTION_MASK) * AUDIO_KERNELS_FRACTION_SCALE;
+
+            for (unsigned int c = 0; c < aChannels; c++)
+            {
+                aOutput[i * aChannels + c] = a[c] + (b[c] - a[c]) * fraction;
+            }
+
+            aPosition += aStep;
+        }
+    }
+
+    void AudioKernels::ResampleSincScalar(const float* aInput, unsigned int aChannels, unsigned long long aPosition, unsigned long long aStep, float* aOutput, unsigned int aFrameCount)
+    {
+        const SincTable& table = GetSincTable();
+        const unsigned int before = SINC_TAPS / 2 - 1;
+
+        for (unsigned int i = 0; i < aFrameCount; i++)
+        {
+            const float* frames = aInput + (aPosition >> 32) * aChannels - before * aChannels;
+            const float* taps = table.mono[GetSincPhase(aPosition)];
+
+            for (unsigned int c = 0; c < aChannels; c++)
+            {
+                float sum = 0.0f;
+                for (unsigned int t = 0; t < SINC_TAPS; t++)
+                {
+                    sum += frames[t * aChannels + c] * taps[t];
+                }
+                aOutput[i * aChannels + c] = sum;
+            }
+
+            aPosition += aStep;
+        }
+    }
+
+    void AudioKernels::AccumulateMonoScalar(const float* aInput, float* aOutput, unsigned int aFrameCount, float aLeftGain, float aRightGain)
+    {
+        for (unsigned int i = 0; i < aFrameCount; i++)
+        {
+            aOutput[i * 2] += aInput[i] * aLeftGain;
+            aOutput[i * 2 + 1] += aInput[i] * aRightGain;
+        }
+    }
+
+    void AudioKernels::AccumulateStereoScalar(const float* aInput, float* aOutput, unsigned int aFrameCount, float aLeftGain, float aRightGain)
+    {
+        for (unsigned int i = 0; i < aFrameCount; i++)
+        {
+            aOutput[i * 2] += aInput[i * 2] * aLeftGain;
+            aOutput[i * 2 + 1] += aInput[i * 2 + 1] * aRightGain;
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+
+namespace GameDev2D
+{
+    //The AudioKernels are the inner loops of the AudioMixer: sample conversion, resampling and accumulating with gain.
+    //Each kernel has an SSE2 version (used when the target supports it) and a scalar reference version, the scalar
+    //versions define what the kernels compute and are used on targets without SSE2.
+    //
+    //Positions are 32.32 fixed point, in frames. The resamplers read the input relative to the frame at position 0,
+    //the caller MUST make sure that the frames the kernel reads around each position are readable: frames 0 to
+    //last + 1 for the linear resampler, frames -(SINC_TAPS / 2 - 1) to last + SINC_TAPS / 2 for the sinc resampler
+    struct AudioKernels
+    {
+        //The number of taps and the number of fractional phases of the windowed-sinc resampler
+        static const unsigned int SINC_TAPS = 8;
+        static const unsigned int SINC_PHASES = 256;
+
+        //Converts unsigned 8-bit and signed 16-bit samples to floats, in the range -1.0f to 1.0f
+        static void ConvertU8ToFloat(const unsigned char* input, float* output, unsigned int count);
+        static void ConvertS16ToFloat(const short* input, float* output, unsigned int count);
+
+        //Resamples interleaved mono or stereo frames, by linearly interpolating between the two nearest frames
+        static void ResampleLinear(const float* input, unsigned int channels, unsigned long long position, unsigned long long step, float* output, unsigned int frameCount);
+
+        //Resamples interleaved mono or stereo frames, with an 8 tap Blackman windowed-sinc filter
+        static void ResampleSinc(const float* input, unsigned int channels, unsigned long long position, unsigned long long step, float* output, unsigned int frameCount);
+
+        //Adds mono frames to interleaved stereo output, each channel has its own gain
+        static void AccumulateMono(const float* input, float* output, unsigned int frameCount, float leftGain, float rightGain);
+
+        //Adds interleaved stereo frames to interleaved stereo output, each channel has its own gain
+        static void AccumulateStereo(const float* input, float* output, unsigned int frameCount, float leftGain, float rightGain);
+
+        //Scalar reference versions of the kernels
+        static void ConvertU8ToFloatScalar(const unsigned char* input, float* output, unsigned int count);
+        static void ConvertS16ToFloatScalar(const short* input, float* output, unsigned int count);
+        static void ResampleLinearScalar(const float* input, unsigned int channels, unsigned long long position, unsigned long long step, float* output, unsigned int frameCount);
+        static void ResampleSincScalar(const float* input, unsigned int channels, unsigned long long position, unsigned long long step, float* output, unsigned int frameCount);
+        static void AccumulateMonoScalar(const float* input, float* output, unsigned int frameCount, float leftGain, float rightGain);
+        static void AccumulateStereoScalar(const float* input, float* output, unsigned int frameCount, float leftGain, float rightGain);
+    };
+}
@@ -0,0 +1,770 @@
+#include "AudioMixer.h"
+#include "AudioKernels.h"
+#include "AudioStream.h"
+#include <algorithm>
+#include <string.h>
+#include <thread>
+
+
+namespace GameDev2D
+{
+    //Mixer constants
+    const unsigned int AUDIO_MIXER_CHANNELS = 2;
+    const unsigned int AUDIO_MIXER_NOT_PLAYING = 0xffffffff;
+    const double AUDIO_MIXER_FIXED_ONE = 4294967296.0;
+
+    //The number of output frames that a voice is mixed in at a time, and the furthest a voice can step through
+    //its source per output frame, together they bound the size of the mixer's scratch buffers
+    const unsigned int AUDIO_MIXER_BLOCK_FRAMES = 256;
+    const double AUDIO_MIXER_MAX_STEP = 8.0;
+
+    //The number of notifications queued per voice, between two calls to DispatchNotifications() a voice usually queues
+    //one or two, this leaves room for short looping voices and for frames where the game hitches and the mixer runs ahead
+    const unsigned int AUDIO_MIXER_NOTIFICATIONS_PER_VOICE = 8;
+
+    //The number of commands queued per voice, a voice is usually created, positioned, started and stopped between two mixes at most
+    const unsigned int AUDIO_MIXER_COMMANDS_PER_VOICE = 4;
+
+    AudioMixer::Voice::Voice() :
+        callback(nullptr),
+        generation(1),
+        epoch(1),
+        isAllocated(false),
+        isOneShot(false),
+        source(),
+        position(0),
+        framesMixed(0.0),
+        mixEpoch(0),
+        playingIndex(AUDIO_MIXER_NOT_PLAYING),
+        hasCallback(false),
+        hasStarted(false),
+        hasWrapped(false),
+        playEpoch(0),
+        volume(1.0f),
+        pan(0.0f),
+        frequencyRatio(1.0f),
+        isLooping(false),
+        framesPlayed(0),
+        endedEpoch(0)
+    {
+    }
+
+    AudioMixer::Command::Command() :
+        type(Command_Stop),
+        index(0),
+        value(0),
+        source(),
+        hasCallback(false)
+    {
+    }
+
+    AudioMixer::AudioMixer(unsigned int aSampleRate, unsigned int aMaxVoices) :
+        m_Voices(aMaxVoices),
+        m_Commands(aMaxVoices * AUDIO_MIXER_COMMANDS_PER_VOICE),
+        m_Notifications(aMaxVoices * AUDIO_MIXER_NOTIFICATIONS_PER_VOICE),
+        m_DroppedNotifications(0),
+        m_MixCount(0),
+        m_PlayingVoiceCount(0),
+        m_MasterVolume(1.0f),
+        m_Resampler(AudioResampler_Linear),
+        m_SampleRate(aSampleRate)
+    {
+        //Reserve everything up front, so that creating, playing and mixing voices never allocates
+        m_FreeVoices.reserve(aMaxVoices);
+        m_OneShotVoices.reserve(aMaxVoices);
+        m_PendingCommands.reserve(aMaxVoices);
+        m_PlayingVoices.reserve(aMaxVoices);
+
+        //The source frames hold a block's worth of frames at the maximum step, plus the frames the sinc resampler reads around them
+        unsigned int sourceFrames = (unsigned int)(AUDIO_MIXER_BLOCK_FRAMES * AUDIO_MIXER_MAX_STEP) + AudioKernels::SINC_TAPS + 2;
+        m_SourceFrames.resize(sourceFrames * AUDIO_MIXER_CHANNELS);
+        m_ResampledFrames.resize(AUDIO_MIXER_BLOCK_FRAMES * AUDIO_MIXER_CHANNELS);
+
+        for (unsigned int i = aMaxVoices; i > 0; i--)
+        {
+            m_FreeVoices.push_back(i - 1);
+        }
+    }
+
+    AudioMixer::~AudioMixer()
+    {
+    }
+
+    AudioVoice AudioMixer::CreateVoice(const AudioSource& aSource, AudioVoiceCallback* aCallback)
+    {
+        AudioVoice voice;
+        unsigned int index = AllocateVoice(aSource, aCallback);
+        if (index != AUDIO_MIXER_NOT_PLAYING)
+        {
+            voice.index = index;
+            voice.generation = m_Voices[index].generation;
+        }
+        return voice;
+    }
+
+    void AudioMixer::DestroyVoice(AudioVoice& aVoice)
+    {
+        Voice* voice = GetVoice(aVoice);
+        if (voice != nullptr)
+        {
+            //Stop the voice and wait for it to be out of the mix, the source's owner is free to release it once this returns
+            if (voice->playEpoch.load(std::memory_order_relaxed) != 0)
+            {
+                voice->playEpoch.store(0);
+                WaitForMix();
+            }
+
+            Command command;
+            command.type = Command_Stop;
+            command.index = aVoice.index;
+            PushCommand(command);
+
+            FreeVoice(aVoice.index);
+        }
+        aVoice = AudioVoice();
+    }
+
+    AudioVoice AudioMixer::PlayOneShot(const AudioSource& aSource, float aVolume, float aFrequencyRatio)
+    {
+        AudioVoice voice;
+        unsigned int index = AllocateVoice(aSource, nullptr);
+        if (index != AUDIO_MIXER_NOT_PLAYING)
+        {
+            Voice& oneShot = m_Voices[index];
+            oneShot.volume.store(aVolume, std::memory_order_relaxed);
+            oneShot.frequencyRatio.store(aFrequencyRatio > 0.0f ? aFrequencyRatio : 0.0f, std::memory_order_relaxed);
+            oneShot.isOneShot = true;
+            m_OneShotVoices.push_back(index);
+            StartVoice(index);
+
+            voice.index = index;
+            voice.generation = oneShot.generation;
+        }
+        return voice;
+    }
+
+    bool AudioMixer::IsValid(const AudioVoice& aVoice)
+    {
+        return GetVoice(aVoice) != nullptr;
+    }
+
+    void AudioMixer::Start(const AudioVoice& aVoice)
+    {
+        Voice* voice = GetVoice(aVoice);
+        if (voice != nullptr && IsPlaying(*voice) == false)
+        {
+            StartVoice(aVoice.index);
+        }
+    }
+
+    void AudioMixer::Stop(const AudioVoice& aVoice)
+    {
+        Voice* voice = GetVoice(aVoice);
+        if (voice != nullptr && voice->playEpoch.load(std::memory_order_relaxed) != 0)
+        {
+            //The voice is silenced as soon as the mixer sees its play epoch cleared, the command removes it from the playing voices
+            voice->playEpoch.store(0);
+            WaitForMix();
+
+            Command command;
+            command.type = Command_Stop;
+            command.index = aVoice.index;
+            PushCommand(command);
+        }
+    }
+
+    bool AudioMixer::IsPlaying(const AudioVoice& aVoice)
+    {
+        Voice* voice = GetVoice(aVoice);
+        return voice != nullptr && IsPlaying(*voice);
+    }
+
+    void AudioMixer::SetPosition(const AudioVoice& aVoice, unsigned int aFrame)
+    {
+        if (GetVoice(aVoice) != nullptr)
+        {
+            Command command;
+            command.type = Command_SetPosition;
+            command.index = aVoice.index;
+            command.value = aFrame;
+            PushCommand(command);
+        }
+    }
+
+    unsigned long long AudioMixer::GetFramesPlayed(const AudioVoice& aVoice)
+    {
+        Voice* voice = GetVoice(aVoice);
+        return voice != nullptr ? voice->framesPlayed.load(std::memory_order_relaxed) : 0;
+    }
+
+    void AudioMixer::SetLooping(const AudioVoice& aVoice, bool aIsLooping)
+    {
+        Voice* voice = GetVoice(aVoice);
+        if (voice != nullptr)
+        {
+            voice->isLooping.store(aIsLooping, std::memory_order_relaxed);
+        }
+    }
+
+    bool AudioMixer::IsLooping(const AudioVoice& aVoice)
+    {
+        Voice* voice = GetVoice(aVoice);
+        return voice != nullptr && voice->isLooping.load(std::memory_order_relaxed);
+    }
+
+    void AudioMixer::SetVolume(const AudioVoice& aVoice, float aVolume)
+    {
+        Voice* voice = GetVoice(aVoice);
+        if (voice != nullptr)
+        {
+            voice->volume.store(aVolume, std::memory_order_relaxed);
+        }
+    }
+
+    float AudioMixer::GetVolume(const AudioVoice& aVoice)
+    {
+        Voice* voice = GetVoice(aVoice);
+        return voice != nullptr ? voice->volume.load(std::memory_order_relaxed) : 0.0f;
+    }
+
+    void AudioMixer::SetPan(const AudioVoice& aVoice, float aPan)
+    {
+        Voice* voice = GetVoice(aVoice);
+        if (voice != nullptr)
+        {
+            voice->pan.store(aPan < -1.0f ? -1.0f : (aPan > 1.0f ? 1.0f : aPan), std::memory_order_relaxed);
+        }
+    }
+
+    float AudioMixer::GetPan(const AudioVoice& aVoice)
+    {
+        Voice* voice = GetVoice(aVoice);
+        return voice != nullptr ? voice->pan.load(std::memory_order_relaxed) : 0.0f;
+    }
+
+    void AudioMixer::SetFrequencyRatio(const AudioVoice& aVoice, float aFrequencyRatio)
+    {
+        Voice* voice = GetVoice(aVoice);
+        if (voice != nullptr)
+        {
+            voice->frequencyRatio.store(aFrequencyRatio > 0.0f ? aFrequencyRatio : 0.0f, std::memory_order_relaxed);
+        }
+    }
+
+    float AudioMixer::GetFrequencyRatio(const AudioVoice& aVoice)
+    {
+        Voice* voice = GetVoice(aVoice);
+        return voice != nullptr ? voice->frequencyRatio.load(std::memory_order_relaxed) : 0.0f;
+    }
+
+    void AudioMixer::SetMasterVolume(float aVolume)
+    {
+        m_MasterVolume.store(aVolume, std::memory_order_relaxed);
+    }
+
+    float AudioMixer::GetMasterVolume()
+    {
+        return m_MasterVolume.load(std::memory_order_relaxed);
+    }
+
+    void AudioMixer::SetResampler(AudioResampler aResampler)
+    {
+        m_Resampler.store(aResampler, std::memory_order_relaxed);
+    }
+
+    AudioResampler AudioMixer::GetResampler()
+    {
+        return m_Resampler.load(std::memory_order_relaxed);
+    }
+
+    unsigned int AudioMixer::GetSampleRate() const
+    {
+        return m_SampleRate;
+    }
+
+    unsigned int AudioMixer::GetChannels() const
+    {
+        return AUDIO_MIXER_CHANNELS;
+    }
+
+    unsigned int AudioMixer::GetPlayingVoiceCount()
+    {
+        return m_PlayingVoiceCount.load(std::memory_order_relaxed);
+    }
+
+    void AudioMixer::Mix(float* aOutput, unsigned int aFrameCount)
+    {
+        //The mix count is odd while mixing, WaitForMix() waits for it to change
+        m_MixCount.fetch_add(1);
+
+        memset(aOutput, 0, aFrameCount * AUDIO_MIXER_CHANNELS * sizeof(float));
+        ApplyCommands();
+
+        float masterVolume = m_MasterVolume.load(std::memory_order_relaxed);
+        AudioResampler resampler = m_Resampler.load(std::memory_order_relaxed);
+
+        //Cycle through the playing voices, a voice that ends is swapped out of the playing voices, so the index only advances for voices that keep playing
+        unsigned int i = 0;
+        while (i < m_PlayingVoices.size())
+        {
+            unsigned int index = m_PlayingVoices[i];
+            Voice& voice = m_Voices[index];
+
+            //A voice that was stopped (or started again) by the controlling thread isn't mixed, even before its command is applied
+            if (voice.playEpoch.load() != voice.mixEpoch)
+            {
+                i++;
+                continue;
+            }
+
+            if (voice.hasStarted == false)
+            {
+                voice.hasStarted = true;
+                Notify(voice, Notification_Started);
+            }
+
+            bool isPlaying = MixVoice(voice, aOutput, aFrameCount, voice.volume.load(std::memory_order_relaxed) * masterVolume, resampler);
+            voice.framesPlayed.store((unsigned long long)voice.framesMixed, std::memory_order_relaxed);
+            if (isPlaying == true)
+            {
+                i++;
+                continue;
+            }
+
+            //The voice reached its end, rewind it so that it can be played again
+            Notify(voice, Notification_Ended);
+            voice.position = 0;
+            voice.hasWrapped = false;
+            RemovePlaying(index);
+
+            //Once the ended epoch is published the controlling thread knows the voice is out of the mix (a one-shot voice is freed)
+            voice.endedEpoch.store(voice.mixEpoch, std::memory_order_release);
+        }
+
+        m_PlayingVoiceCount.store((unsigned int)m_PlayingVoices.size(), std::memory_order_relaxed);
+        m_MixCount.fetch_add(1, std::memory_order_release);
+    }
+
+    void AudioMixer::DispatchNotifications()
+    {
+        FlushCommands();
+
+        Notification notification;
+        while (m_Notifications.Pop(notification) == true)
+        {
+            //The callback is looked up for every notification, an earlier callback may have destroyed OR started the voice again
+            Voice& voice = m_Voices[notification.index];
+            if (voice.isAllocated == false || voice.epoch != notification.epoch || voice.callback == nullptr)
+            {
+                continue;
+            }
+
+            switch (notification.type)
+            {
+            case Notification_Started:
+                voice.callback->OnVoiceStarted();
+                break;
+
+            case Notification_Ended:
+                voice.callback->OnVoiceEnded();
+                break;
+
+            case Notification_Looped:
+                voice.callback->OnVoiceLooped();
+                break;
+            }
+        }
+
+        //Free the one-shot voices that ended (or were stopped), which makes their handles stale
+        for (unsigned int i = 0; i < m_OneShotVoices.size(); )
+        {
+            if (IsPlaying(m_Voices[m_OneShotVoices[i]]) == false)
+            {
+                FreeVoice(m_OneShotVoices[i]);
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    unsigned int AudioMixer::GetDroppedNotificationCount() const
+    {
+        return m_DroppedNotifications.load(std::memory_order_relaxed);
+    }
+
+    AudioMixer::Voice* AudioMixer::GetVoice(const AudioVoice& aVoice)
+    {
+        if (aVoice.index < m_Voices.size())
+        {
+            Voice& voice = m_Voices[aVoice.index];
+            if (voice.isAllocated == true && voice.generation == aVoice.generation)
+            {
+                return &voice;
+            }
+        }
+        return nullptr;
+    }
+
+    bool AudioMixer::IsPlaying(const Voice& aVoice) const
+    {
+        unsigned int playEpoch = aVoice.playEpoch.load(std::memory_order_relaxed);
+        return playEpoch != 0 && aVoice.endedEpoch.load(std::memory_order_acquire) != playEpoch;
+    }
+
+    unsigned int AudioMixer::AllocateVoice(const AudioSource& aSource, AudioVoiceCallback* aCallback)
+    {
+        if (m_FreeVoices.empty() == true)
+        {
+            return AUDIO_MIXER_NOT_PLAYING;
+        }
+
+        unsigned int index = m_FreeVoices.back();
+        m_FreeVoices.pop_back();
+
+        //Reset the voice, keeping its generation and epoch. A freed voice is out of the mix, so its shared state can be reset here
+        Voice& voice = m_Voices[index];
+        voice.callback = aCallback;
+        voice.isAllocated = true;
+        voice.isOneShot = false;
+        voice.volume.store(1.0f, std::memory_order_relaxed);
+        voice.pan.store(0.0f, std::memory_order_relaxed);
+        voice.frequencyRatio.store(1.0f, std::memory_order_relaxed);
+        voice.isLooping.store(false, std::memory_order_relaxed);
+        voice.framesPlayed.store(0, std::memory_order_relaxed);
+
+        //The mixer resets its own state when the command is applied
+        Command command;
+        command.type = Command_Create;
+        command.index = index;
+        command.source = aSource;
+        command.hasCallback = aCallback != nullptr;
+
+        //A source the mixer can't play is silent, instead of reading invalid samples
+        bool isSupported = (aSource.channels == 1 || aSource.channels == 2) && (aSource.bitsPerSample == 8 || aSource.bitsPerSample == 16 || aSource.bitsPerSample == 32);
+        if (isSupported == false || (aSource.data == nullptr && aSource.stream == nullptr) || aSource.sampleRate == 0)
+        {
+            command.source.frameCount = 0;
+        }
+
+        PushCommand(command);
+        return index;
+    }
+
+    void AudioMixer::FreeVoice(unsigned int aIndex)
+    {
+        Voice& voice = m_Voices[aIndex];
+        if (voice.isOneShot == true)
+        {
+            m_OneShotVoices.erase(std::find(m_OneShotVoices.begin(), m_OneShotVoices.end(), aIndex));
+        }
+
+        //Bump the generation so that any handle to the voice goes stale, and the epoch so that its queued notifications are discarded, 0 is reserved for both
+        voice.isAllocated = false;
+        voice.isOneShot = false;
+        voice.callback = nullptr;
+        voice.generation = voice.generation + 1 != 0 ? voice.generation + 1 : 1;
+        voice.epoch = voice.epoch + 1 != 0 ? voice.epoch + 1 : 1;
+        voice.playEpoch.store(0, std::memory_order_relaxed);
+        m_FreeVoices.push_back(aIndex);
+    }
+
+    void AudioMixer::StartVoice(unsigned int aIndex)
+    {
+        Voice& voice = m_Voices[aIndex];
+        voice.epoch = voice.epoch + 1 != 0 ? voice.epoch + 1 : 1;
+        voice.playEpoch.store(voice.epoch);
+
+        Command command;
+        command.type = Command_Start;
+        command.index = aIndex;
+        command.value = voice.epoch;
+        PushCommand(command);
+    }
+
+    void AudioMixer::PushCommand(const Command& aCommand)
+    {
+        //A command is never dropped, if the mixer isn't draining the queue (the sink is suspended) it's held back, in order
+        FlushCommands();
+        if (m_PendingCommands.empty() == false || m_Commands.Push(aCommand) == false)
+        {
+            m_PendingCommands.push_back(aCommand);
+        }
+    }
+
+    void AudioMixer::FlushCommands()
+    {
+        unsigned int flushed = 0;
+        while (flushed < m_PendingCommands.size() && m_Commands.Push(m_PendingCommands[flushed]) == true)
+        {
+            flushed++;
+        }
+        m_PendingCommands.erase(m_PendingCommands.begin(), m_PendingCommands.begin() + flushed);
+    }
+
+    void AudioMixer::WaitForMix()
+    {
+        //The play epoch was stored before this load, both are sequentially consistent, as is the mixer's increment of the mix
+        //count before it loads the play epochs. So either this sees the mix count odd, OR the mix sees the new play epoch
+        unsigned int mixCount = m_MixCount.load();
+        if ((mixCount & 1) != 0)
+        {
+            while (m_MixCount.load(std::memory_order_acquire) == mixCount)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void AudioMixer::ApplyCommands()
+    {
+        Command command;
+        while (m_Commands.Pop(command) == true)
+        {
+            Voice& voice = m_Voices[command.index];
+            switch (command.type)
+            {
+            case Command_Create:
+                if (voice.playingIndex != AUDIO_MIXER_NOT_PLAYING)
+                {
+                    RemovePlaying(command.index);
+                }
+                voice.source = command.source;
+                voice.position = 0;
+                voice.framesMixed = 0.0;
+                voice.mixEpoch = 0;
+                voice.hasCallback = command.hasCallback;
+                voice.hasStarted = false;
+                voice.hasWrapped = false;
+                break;
+
+            case Command_Start:
+                voice.mixEpoch = command.value;
+                voice.hasStarted = false;
+                if (voice.playingIndex == AUDIO_MIXER_NOT_PLAYING)
+                {
+                    AddPlaying(command.index);
+                }
+                break;
+
+            case Command_Stop:
+                if (voice.playingIndex != AUDIO_MIXER_NOT_PLAYING)
+                {
+                    RemovePlaying(command.index);
+                }
+                break;
+
+            case Command_SetPosition:
+                command.value = command.value < voice.source.frameCount ? command.value : voice.source.frameCount;
+                voice.position = (unsigned long long)command.value << 32;
+                voice.hasWrapped = false;
+                break;
+            }
+        }
+    }
+
+    void AudioMixer::AddPlaying(unsigned int aIndex)
+    {
+        m_Voices[aIndex].playingIndex = (unsigned int)m_PlayingVoices.size();
+        m_PlayingVoices.push_back(aIndex);
+    }
+
+    void AudioMixer::RemovePlaying(unsigned int aIndex)
+    {
+        //Swap the last playing voice into the removed voice's place
+        unsigned int playingIndex = m_Voices[aIndex].playingIndex;
+        unsigned int last = m_PlayingVoices.back();
+        m_PlayingVoices[playingIndex] = last;
+        m_Voices[last].playingIndex = playingIndex;
+        m_PlayingVoices.pop_back();
+        m_Voices[aIndex].playingIndex = AUDIO_MIXER_NOT_PLAYING;
+    }
+
+    bool AudioMixer::MixVoice(Voice& aVoice, float* aOutput, unsigned int aFrameCount, float aGain, AudioResampler aResampler)
+    {
+        const AudioSource& source = aVoice.source;
+        if (source.frameCount == 0)
+        {
+            return false;
+        }
+
+        //The controlling thread can change these at any time, they're read once so that the whole mix uses the same values
+        float frequencyRatio = aVoice.frequencyRatio.load(std::memory_order_relaxed);
+        float pan = aVoice.pan.load(std::memory_order_relaxed);
+        bool isLooping = aVoice.isLooping.load(std::memory_order_relaxed);
+
+        //The step is how far the voice advances through its source for every output frame
+        double step = (double)frequencyRatio * (double)source.sampleRate / (double)m_SampleRate;
+        step = step < AUDIO_MIXER_MAX_STEP ? step : AUDIO_MIXER_MAX_STEP;
+        unsigned long long fixedStep = (unsigned long long)(step * AUDIO_MIXER_FIXED_ONE);
+        const unsigned long long end = (unsigned long long)source.frameCount << 32;
+
+        //A voice that plays at the output's sample rate, from a whole frame, is mixed without resampling
+        bool isResampled = fixedStep != (1ULL << 32) || (aVoice.position & 0xffffffff) != 0;
+        bool isSinc = isResampled == true && aResampler == AudioResampler_Sinc;
+
+        //The frames that the resampler reads before and after the frames it is positioned on
+        unsigned int before = isSinc == true ? AudioKernels::SINC_TAPS / 2 - 1 : 0;
+        unsigned int after = isSinc == true ? AudioKernels::SINC_TAPS / 2 : (isResampled == true ? 1 : 0);
+
+        //Split the voice's volume between the left and right channels
+        float leftGain = aGain * (pan > 0.0f ? 1.0f - pan : 1.0f);
+        float rightGain = aGain * (pan < 0.0f ? 1.0f + pan : 1.0f);
+
+        unsigned int loops = 0;
+        unsigned int mixed = 0;
+        while (mixed < aFrameCount)
+        {
+            //Has the voice reached the end of its source?
+            if (aVoice.position >= end)
+            {
+                if (isLooping == false)
+                {
+                    break;
+                }
+
+                loops += (unsigned int)(aVoice.position / end);
+                aVoice.position %= end;
+                aVoice.hasWrapped = true;
+            }
+
+            //Mix up to a block of frames, a voice that doesn't loop stops at the end of its source
+            unsigned int frames = aFrameCount - mixed < AUDIO_MIXER_BLOCK_FRAMES ? aFrameCount - mixed : AUDIO_MIXER_BLOCK_FRAMES;
+            if (isLooping == false && fixedStep > 0)
+            {
+                unsigned long long remaining = (end - aVoice.position + fixedStep - 1) / fixedStep;
+                frames = remaining < frames ? (unsigned int)remaining : frames;
+            }
+
+            //Convert the source frames the block reads to floats
+            long long first = (long long)(aVoice.position >> 32) - before;
+            long long last = (long long)((aVoice.position + fixedStep * (frames - 1)) >> 32) + after;
+            ConvertFrames(aVoice, isLooping, first, (unsigned int)(last - first + 1), &m_SourceFrames[0]);
+
+            //Resample the frames, the resampler's position is relative to the first frame after the frames it reads before
+            const float* samples = &m_SourceFrames[0];
+            if (isResampled == true)
+            {
+                const float* input = &m_SourceFrames[before * source.channels];
+                unsigned long long position = aVoice.position & 0xffffffff;
+
+                if (isSinc == true)
+                {
+                    AudioKernels::ResampleSinc(input, source.channels, position, fixedStep, &m_ResampledFrames[0], frames);
+                }
+                else
+                {
+                    AudioKernels::ResampleLinear(input, source.channels, position, fixedStep, &m_ResampledFrames[0], frames);
+                }
+                samples = &m_ResampledFrames[0];
+            }
+
+            //Add the frames to the output
+            if (source.channels == 1)
+            {
+                AudioKernels::AccumulateMono(samples, aOutput + mixed * AUDIO_MIXER_CHANNELS, frames, leftGain, rightGain);
+            }
+            else
+            {
+                AudioKernels::AccumulateStereo(samples, aOutput + mixed * AUDIO_MIXER_CHANNELS, frames, leftGain, rightGain);
+            }
+
+            aVoice.position += fixedStep * frames;
+            mixed += frames;
+        }
+
+        //Wrap a looping voice that finished the mix exactly at (or past) its end
+        if (isLooping == true && aVoice.position >= end)
+        {
+            loops += (unsigned int)(aVoice.position / end);
+            aVoice.position %= end;
+            aVoice.hasWrapped = true;
+        }
+
+        aVoice.framesMixed += step * mixed;
+
+        //Only one loop notification is sent per mix, even if a very short source looped more than once
+        if (loops > 0)
+        {
+            Notify(aVoice, Notification_Looped);
+        }
+
+        return mixed == aFrameCount;
+    }
+
+    void AudioMixer::ConvertFrames(const Voice& aVoice, bool aIsLooping, long long aFirst, unsigned int aCount, float* aOutput)
+    {
+        const AudioSource& source = aVoice.source;
+        const long long frameCount = source.frameCount;
+
+        //Convert the frames in runs that are contiguous in the source
+        unsigned int converted = 0;
+        while (converted < aCount)
+        {
+            //The frames before the start of the source wrap around to its end only once the voice has looped
+            long long frame = aFirst + converted;
+            if (aIsLooping == true && (frame >= 0 || aVoice.hasWrapped == true))
+            {
+                frame = ((frame % frameCount) + frameCount) % frameCount;
+            }
+
+            float* output = aOutput + converted * source.channels;
+            unsigned int remaining = aCount - converted;
+
+            //Frames before or after the source are silent
+            if (frame < 0 || frame >= frameCount)
+            {
+                unsigned int run = frame < 0 ? (unsigned int)(-frame < remaining ? -frame : remaining) : remaining;
+                memset(output, 0, run * source.channels * sizeof(float));
+                converted += run;
+                continue;
+            }
+
+            unsigned int run = frameCount - frame < remaining ? (unsigned int)(frameCount - frame) : remaining;
+            unsigned int samples = run * source.channels;
+            unsigned int offset = (unsigned int)frame * source.channels;
+
+            if (source.stream != nullptr)
+            {
+                source.stream->ReadFrames((unsigned int)frame, run, output);
+                converted += run;
+                continue;
+            }
+
+            switch (source.bitsPerSample)
+            {
+            case 8:
+                AudioKernels::ConvertU8ToFloat(static_cast<const unsigned char*>(source.data) + offset, output, samples);
+                break;
+
+            case 16:
+                AudioKernels::ConvertS16ToFloat(static_cast<const short*>(source.data) + offset, output, samples);
+                break;
+
+            case 32:
+                memcpy(output, static_cast<const float*>(source.data) + offset, samples * sizeof(float));
+                break;
+            }
+
+            converted += run;
+        }
+    }
+
+    void AudioMixer::Notify(Voice& aVoice, NotificationType aType)
+    {
+        if (aVoice.hasCallback == true)
+        {
+            Notification notification;
+            notification.index = (unsigned int)(&aVoice - &m_Voices[0]);
+            notification.epoch = aVoice.mixEpoch;
+            notification.type = aType;
+
+            //The mixing thread can't wait for the queue to be drained, if it's full the notification is dropped
+            if (m_Notifications.Push(notification) == false)
+            {
+                m_DroppedNotifications.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#include "../Utils/SpscQueue/SpscQueue.h"
+#include <atomic>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Forward declaration
+    class AudioStream;
+
+    //Describes a block of interleaved PCM samples that an AudioMixer voice plays, the samples
+    //aren't copied, they MUST stay valid for as long as a voice is playing them. A streamed
+    //source has no data, the voice reads its frames from the stream instead
+    struct AudioSource
+    {
+        AudioSource() :
+            data(nullptr),
+            stream(nullptr),
+            frameCount(0),
+            sampleRate(0),
+            channels(0),
+            bitsPerSample(0)
+        {
+        }
+
+        const void* data;
+        AudioStream* stream;
+        unsigned int frameCount;
+        unsigned int sampleRate;
+        unsigned short channels;        //1 (mono) or 2 (stereo)
+        unsigned short bitsPerSample;   //8 (unsigned), 16 (signed) or 32 (float)
+    };
+
+    //The AudioVoiceCallback is an interface to receive notifications about an AudioMixer voice, the methods
+    //are called on the thread that calls AudioMixer::DispatchNotifications(), never on the thread that is mixing
+    class AudioVoiceCallback
+    {
+    public:
+        virtual ~AudioVoiceCallback() {}
+
+        virtual void OnVoiceStarted() {}
+        virtual void OnVoiceEnded() {}
+        virtual void OnVoiceLooped() {}
+    };
+
+    //The resamplers the AudioMixer can use when a voice's frequency ratio (or sample rate) doesn't match the output
+    enum AudioResampler
+    {
+        AudioResampler_Linear = 0,
+        AudioResampler_Sinc
+    };
+
+    //A generational handle to an AudioMixer voice, a handle to a voice that was destroyed (or a one-shot
+    //voice that finished playing) is stale and is ignored by the mixer
+    struct AudioVoice
+    {
+        AudioVoice() :
+            index(0),
+            generation(0)
+        {
+        }
+
+        unsigned int index;
+        unsigned int generation;
+    };
+
+    //The AudioMixer mixes any number of playing voices (up to its voice limit) into an interleaved stereo float bus,
+    //each voice has its own volume, pan, frequency ratio (resampling) and looping. Voices are pooled, creating and playing
+    //a voice never allocates memory. The mixer doesn't output the audio, an AudioSink pulls it by calling Mix().
+    //The voice methods (and DispatchNotifications()) MUST be called from one thread, the controlling thread, Mix() can be called
+    //from another. Mix() never locks OR waits for the controlling thread, the changes to a voice are passed to it through
+    //a lock-free command queue and atomics, so a change is heard from the next call to Mix()
+    class AudioMixer
+    {
+    public:
+        AudioMixer(unsigned int sampleRate, unsigned int maxVoices);
+        ~AudioMixer();
+
+        //Creates a voice for the source, the voice is stopped. Returns a stale handle if every voice is in use
+        AudioVoice CreateVoice(const AudioSource& source, AudioVoiceCallback* callback);
+
+        //Destroys a voice and invalidates the handle, once it returns the mixer no longer reads the voice's source
+        void DestroyVoice(AudioVoice& voice);
+
+        //Plays the source once on a pooled voice that is destroyed automatically, by the DispatchNotifications()
+        //that follows its end. Returns a stale handle if every voice is in use
+        AudioVoice PlayOneShot(const AudioSource& source, float volume, float frequencyRatio);
+
+        //Returns wether the voice handle still refers to a voice
+        bool IsValid(const AudioVoice& voice);
+
+        //Starts and stops playing a voice, stopping a voice keeps its position. Every start is a new play, the notifications
+        //of an earlier play are discarded. Once Stop() returns the mixer no longer reads the voice's source
+        void Start(const AudioVoice& voice);
+        void Stop(const AudioVoice& voice);
+
+        //Returns wether the voice is playing
+        bool IsPlaying(const AudioVoice& voice);
+
+        //Sets the position of the voice, in source frames
+        void SetPosition(const AudioVoice& voice, unsigned int frame);
+
+        //Returns the number of source frames the voice has played since it was created
+        unsigned long long GetFramesPlayed(const AudioVoice& voice);
+
+        //Sets wether the voice loops or not
+        void SetLooping(const AudioVoice& voice, bool isLooping);
+
+        //Returns wether the voice loops or not
+        bool IsLooping(const AudioVoice& voice);
+
+        //Sets the volume of the voice, range 0.0f to 1.0f
+        void SetVolume(const AudioVoice& voice, float volume);
+
+        //Returns the volume of the voice
+        float GetVolume(const AudioVoice& voice);
+
+        //Sets the pan of the voice, range -1.0f (left) to 1.0f (right)
+        void SetPan(const AudioVoice& voice, float pan);
+
+        //Returns the pan of the voice
+        float GetPan(const AudioVoice& voice);
+
+        //Sets the frequency ratio of the voice, 1.0f plays the source at its own sample rate
+        void SetFrequencyRatio(const AudioVoice& voice, float frequencyRatio);
+
+        //Returns the frequency ratio of the voice
+        float GetFrequencyRatio(const AudioVoice& voice);
+
+        //Sets the volume that every voice is mixed at, range 0.0f to 1.0f
+        void SetMasterVolume(float volume);
+
+        //Returns the volume that every voice is mixed at
+        float GetMasterVolume();
+
+        //Sets the resampler used for voices that don't play at the output's sample rate, the sinc resampler
+        //sounds cleaner when pitching sounds, at roughly twice the cost of the linear resampler
+        void SetResampler(AudioResampler resampler);
+
+        //Returns the resampler used for voices that don't play at the output's sample rate
+        AudioResampler GetResampler();
+
+        //Returns the sample rate of the mixed output
+        unsigned int GetSampleRate() const;
+
+        //Returns the number of interleaved channels in the mixed output
+        unsigned int GetChannels() const;
+
+        //Returns the number of voices that were playing at the end of the last call to Mix()
+        unsigned int GetPlayingVoiceCount();
+
+        //Mixes the playing voices into the output, which must hold frameCount * GetChannels() floats
+        void Mix(float* output, unsigned int frameCount);
+
+        //Sends the notifications that were queued while mixing to the voices' callbacks, in the order they were queued.
+        //Notifications for voices that were destroyed OR started again since are discarded. It also frees the one-shot
+        //voices that ended, and passes on the commands that didn't fit in the command queue
+        void DispatchNotifications();
+
+        //Returns the number of notifications that were dropped because the queue was full
+        unsigned int GetDroppedNotificationCount() const;
+
+    private:
+        //Notification types, queued while mixing and sent by DispatchNotifications()
+        enum NotificationType
+        {
+            Notification_Started = 0,
+            Notification_Ended,
+            Notification_Looped
+        };
+
+        //A notification identifies the play it was sent for by its epoch, a voice's epoch is unique to each play
+        struct Notification
+        {
+            unsigned int index;
+            unsigned int epoch;
+            NotificationType type;
+        };
+
+        //Command types, queued by the controlling thread and applied at the start of the next call to Mix()
+        enum CommandType
+        {
+            Command_Create = 0,
+            Command_Start,
+            Command_Stop,
+            Command_SetPosition
+        };
+
+        struct Command
+        {
+            Command();
+
+            CommandType type;
+            unsigned int index;
+            unsigned int value;     //The epoch of the play that starts, or the frame the position is set to
+            AudioSource source;     //The source of a voice that is created
+            bool hasCallback;
+        };
+
+        struct Voice
+        {
+            Voice();
+
+            //Owned by the controlling thread
+            AudioVoiceCallback* callback;
+            unsigned int generation;
+            unsigned int epoch;             //Advanced every time the voice is started or freed, 0 is never used
+            bool isAllocated;
+            bool isOneShot;
+
+            //Owned by the mixing thread, changed by the commands
+            AudioSource source;
+            unsigned long long position;    //32.32 fixed point, in source frames
+            double framesMixed;
+            unsigned int mixEpoch;          //The epoch of the play that is mixed
+            unsigned int playingIndex;
+            bool hasCallback;
+            bool hasStarted;
+            bool hasWrapped;
+
+            //Written by the controlling thread, read while mixing
+            std::atomic<unsigned int> playEpoch;    //The epoch of the play that should be heard, 0 once the voice is stopped
+            std::atomic<float> volume;
+            std::atomic<float> pan;
+            std::atomic<float> frequencyRatio;
+            std::atomic<bool> isLooping;
+
+            //Written while mixing, read by the controlling thread
+            std::atomic<unsigned long long> framesPlayed;
+            std::atomic<unsigned int> endedEpoch;   //The epoch of the last play that reached its end
+        };
+
+        //Returns the voice for the handle, or nullptr if the handle is stale
+        Voice* GetVoice(const AudioVoice& voice);
+
+        //Returns wether the voice's current play has started and hasn't stopped or ended
+        bool IsPlaying(const Voice& voice) const;
+
+        //Allocates a voice from the pool and queues its creation
+        unsigned int AllocateVoice(const AudioSource& source, AudioVoiceCallback* callback);
+
+        //Returns a voice to the pool, the voice MUST not be playing
+        void FreeVoice(unsigned int index);
+
+        //Starts a new play of the voice
+        void StartVoice(unsigned int index);
+
+        //Queues a command for the mixing thread, commands that don't fit in the queue are held back (in order) until they do
+        void PushCommand(const Command& command);
+
+        //Moves the commands that were held back into the queue, for as long as they fit
+        void FlushCommands();
+
+        //Waits for a call to Mix() that is in progress to finish, the calls to Mix() that follow see every change to the voices'
+        //play epochs. It only waits while mixing, so it can't deadlock when the mixer isn't pulled from
+        void WaitForMix();
+
+        //Applies the queued commands, called at the start of Mix()
+        void ApplyCommands();
+
+        //Adds and removes a voice from the playing voices, only called while mixing
+        void AddPlaying(unsigned int index);
+        void RemovePlaying(unsigned int index);
+
+        //Mixes a single voice into the output, returns false if the voice reached its end
+        bool MixVoice(Voice& voice, float* output, unsigned int frameCount, float gain, AudioResampler resampler);
+
+        //Converts a range of the voice's source frames to floats, frames outside the source are silent, unless the voice loops
+        void ConvertFrames(const Voice& voice, bool isLooping, long long first, unsigned int count, float* output);
+
+        //Queues a notification for the voice's current play, it never blocks or allocates. Only called while mixing
+        void Notify(Voice& voice, NotificationType type);
+
+        //Owned by the controlling thread
+        std::vector<Voice> m_Voices;
+        std::vector<unsigned int> m_FreeVoices;
+        std::vector<unsigned int> m_OneShotVoices;
+        std::vector<Command> m_PendingCommands;
+
+        //Owned by the mixing thread
+        std::vector<unsigned int> m_PlayingVoices;
+        std::vector<float> m_SourceFrames;
+        std::vector<float> m_ResampledFrames;
+
+        //Shared by both threads
+        SpscQueue<Command> m_Commands;
+        SpscQueue<Notification> m_Notifications;
+        std::atomic<unsigned int> m_DroppedNotifications;
+        std::atomic<unsigned int> m_MixCount;           //Odd while Mix() is in progress
+        std::atomic<unsigned int> m_PlayingVoiceCount;
+        std::atomic<float> m_MasterVolume;
+        std::atomic<AudioResampler> m_Resampler;
+        unsigned int m_SampleRate;
+    };
+}
@@ -0,0 +1,158 @@
+#include "AudioSink.h"
+#include "AudioMixer.h"
+#include "../Debug/Log.h"
+#include <algorithm>
+
+
+namespace GameDev2D
+{
+    //The number of frames that are mixed per block
+    const unsigned int NULL_AUDIO_SINK_BLOCK_FRAMES = 512;
+
+    //The most time that a single Update() mixes, in seconds, a long stall (such as a breakpoint) skips ahead instead of mixing all of it
+    const double NULL_AUDIO_SINK_MAX_DELTA = 0.25;
+
+    NullAudioSink::NullAudioSink() :
+        m_Mixer(nullptr),
+        m_PendingFrames(0.0),
+        m_FramesMixed(0),
+        m_IsSuspended(false)
+    {
+    }
+
+    NullAudioSink::~NullAudioSink()
+    {
+    }
+
+    bool NullAudioSink::Open(AudioMixer* aMixer)
+    {
+        m_Mixer = aMixer;
+        m_Samples.resize(NULL_AUDIO_SINK_BLOCK_FRAMES * aMixer->GetChannels());
+        m_PendingFrames = 0.0;
+        m_FramesMixed = 0;
+        return true;
+    }
+
+    void NullAudioSink::Close()
+    {
+        m_Mixer = nullptr;
+    }
+
+    void NullAudioSink::Update(double aDelta)
+    {
+        if (m_Mixer == nullptr || m_IsSuspended == true)
+        {
+            return;
+        }
+
+        //Accumulate the frames the delta covers, the fraction of a frame is carried to the next update
+        m_PendingFrames += std::min(aDelta, NULL_AUDIO_SINK_MAX_DELTA) * m_Mixer->GetSampleRate();
+        unsigned int frames = (unsigned int)m_PendingFrames;
+        m_PendingFrames -= frames;
+
+        //Mix the frames in blocks
+        while (frames > 0)
+        {
+            unsigned int block = std::min(frames, NULL_AUDIO_SINK_BLOCK_FRAMES);
+            m_Mixer->Mix(&m_Samples[0], block);
+            OnMixed(&m_Samples[0], block);
+            m_FramesMixed += block;
+            frames -= block;
+        }
+    }
+
+    void NullAudioSink::Suspend()
+    {
+        m_IsSuspended = true;
+    }
+
+    void NullAudioSink::Resume()
+    {
+        m_IsSuspended = false;
+    }
+
+    unsigned long long NullAudioSink::GetFramesMixed()
+    {
+        return m_FramesMixed;
+    }
+
+    WaveFileAudioSink::WaveFileAudioSink(const std::string& aPath) :
+        m_Path(aPath),
+        m_DataSize(0)
+    {
+    }
+
+    WaveFileAudioSink::~WaveFileAudioSink()
+    {
+        Close();
+    }
+
+    bool WaveFileAudioSink::Open(AudioMixer* aMixer)
+    {
+        m_OutputStream.open(m_Path.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+        if (m_OutputStream.is_open() == false)
+        {
+            Log::Error(false, Log::Verbosity_Audio, "[WaveFileAudioSink] Failed to open %s for writing", m_Path.c_str());
+            return false;
+        }
+
+        NullAudioSink::Open(aMixer);
+        m_DataSize = 0;
+        m_Output.resize(NULL_AUDIO_SINK_BLOCK_FRAMES * aMixer->GetChannels());
+        WriteHeader(aMixer->GetSampleRate(), 0);
+        return true;
+    }
+
+    void WaveFileAudioSink::Close()
+    {
+        if (m_OutputStream.is_open() == true)
+        {
+            //Patch the header now that the size of the data is known
+            m_OutputStream.seekp(0, std::ios::beg);
+            WriteHeader(m_Mixer->GetSampleRate(), m_DataSize);
+            m_OutputStream.close();
+
+            Log::Message(Log::Verbosity_Audio, "[WaveFileAudioSink] Wrote %u bytes of audio to %s", m_DataSize, m_Path.c_str());
+        }
+
+        NullAudioSink::Close();
+    }
+
+    void WaveFileAudioSink::OnMixed(const float* aSamples, unsigned int aFrameCount)
+    {
+        //Convert the mixed samples to 16-bit, clamping them to the range of a short
+        unsigned int count = aFrameCount * m_Mixer->GetChannels();
+        for (unsigned int i = 0; i < count; i++)
+        {
+            float sample = std::max(-1.0f, std::min(1.0f, aSamples[i]));
+            m_Output[i] = (short)(sample * 32767.0f);
+        }
+
+        m_OutputStream.write(reinterpret_cast<const char*>(&m_Output[0]), count * sizeof(short));
+        m_DataSize += count * sizeof(short);
+    }
+
+    void WaveFileAudioSink::WriteHeader(unsigned int aSampleRate, unsigned int aDataSize)
+    {
+        const unsigned short channels = (unsigned short)m_Mixer->GetChannels();
+        const unsigned short bitsPerSample = 16;
+        const unsigned short blockAlign = channels * bitsPerSample / 8;
+        const unsigned int bytesPerSecond = aSampleRate * blockAlign;
+        const unsigned int formatSize = 16;
+        const unsigned short formatTag = 1; //PCM
+        const unsigned int riffSize = 36 + aDataSize;
+
+        m_OutputStream.write("RIFF", 4);
+        m_OutputStream.write(reinterpret_cast<const char*>(&riffSize), sizeof(riffSize));
+        m_OutputStream.write("WAVEfmt ", 8);
+        m_OutputStream.write(reinterpret_cast<const char*>(&formatSize), sizeof(formatSize));
+        m_OutputStream.write(reinterpret_cast<const char*>(&formatTag), sizeof(formatTag));
+        m_OutputStream.write(reinterpret_cast<const char*>(&channels), sizeof(channels));
+        m_OutputStream.write(reinterpret_cast<const char*>(&aSampleRate), sizeof(aSampleRate));
+        m_OutputStream.write(reinterpret_cast<const char*>(&bytesPerSecond), sizeof(bytesPerSecond));
+        m_OutputStream.write(reinterpret_cast<const char*>(&blockAlign), sizeof(blockAlign));
+        m_OutputStream.write(reinterpret_cast<const char*>(&bitsPerSample), sizeof(bitsPerSample));
+        m_OutputStream.write("data", 4);
+        m_OutputStream.write(reinterpret_cast<const char*>(&aDataSize), sizeof(aDataSize));
+    }
+}
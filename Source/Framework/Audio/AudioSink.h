@@ -0,0 +1,88 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Forward declaration
+    class AudioMixer;
+
+    //An AudioSink outputs the audio that an AudioMixer mixes. The AudioEngine owns one sink at a time, a device sink
+    //(such as the XAudio2AudioSink) pulls from the mixer on the device's thread, an offline sink pulls from the
+    //mixer in Update(), which the AudioEngine calls once a frame with the frame's delta time
+    class AudioSink
+    {
+    public:
+        virtual ~AudioSink() {}
+
+        //Opens the sink, it pulls from the mixer until it is closed. Returns false if the sink couldn't be opened
+        virtual bool Open(AudioMixer* mixer) = 0;
+
+        //Closes the sink, once Close() returns the sink no longer calls the mixer
+        virtual void Close() = 0;
+
+        //Called once a frame with the frame's delta time, in seconds
+        virtual void Update(double delta) {}
+
+        //Called when the application is suspended and resumed
+        virtual void Suspend() {}
+        virtual void Resume() {}
+    };
+
+    //The NullAudioSink mixes the audio in real time without outputting it, it keeps voices advancing (and their
+    //events dispatching) on machines without an audio device, or in headless builds
+    class NullAudioSink : public AudioSink
+    {
+    public:
+        NullAudioSink();
+        virtual ~NullAudioSink();
+
+        virtual bool Open(AudioMixer* mixer);
+        virtual void Close();
+        virtual void Update(double delta);
+        virtual void Suspend();
+        virtual void Resume();
+
+        //Returns the number of frames that have been mixed since the sink was opened
+        unsigned long long GetFramesMixed();
+
+    protected:
+        //Called after each block of frames is mixed, the samples are interleaved stereo floats
+        virtual void OnMixed(const float* samples, unsigned int frameCount) {}
+
+        //Member variables
+        AudioMixer* m_Mixer;
+        std::vector<float> m_Samples;
+        double m_PendingFrames;
+        unsigned long long m_FramesMixed;
+        bool m_IsSuspended;
+    };
+
+    //The WaveFileAudioSink writes the mixed audio to a 16-bit stereo wave file, it is used to record the audio
+    //of a session, or to compare the mixer's output between builds
+    class WaveFileAudioSink : public NullAudioSink
+    {
+    public:
+        WaveFileAudioSink(const std::string& path);
+        virtual ~WaveFileAudioSink();
+
+        virtual bool Open(AudioMixer* mixer);
+        virtual void Close();
+
+    protected:
+        virtual void OnMixed(const float* samples, unsigned int frameCount);
+
+    private:
+        //Writes the header of the wave file, the sizes are patched in once the sink is closed
+        void WriteHeader(unsigned int sampleRate, unsigned int dataSize);
+
+        //Member variables
+        std::string m_Path;
+        std::ofstream m_OutputStream;
+        std::vector<short> m_Output;
+        unsigned int m_DataSize;
+    };
+}
@@ -0,0 +1,502 @@
+#include "AudioStream.h"
+#include "AudioKernels.h"
+#include "AudioMixer.h"
+#include "../GameDev2D_Settings.h"
+#include "../Utils/Wave/Wave.h"
+#include <chrono>
+#include <string.h>
+
+
+namespace GameDev2D
+{
+    //The number of buffers in the ring, one buffer is being played, the others are read ahead
+    const unsigned int AUDIO_STREAM_BUFFER_COUNT = 3;
+
+    //The wave format tags that can be streamed
+    const unsigned short AUDIO_STREAM_FORMAT_PCM = 1;
+    const unsigned short AUDIO_STREAM_FORMAT_IEEE_FLOAT = 3;
+
+    //The largest format chunk that is read, an ADPCM format with all of its coefficients is well under this
+    const unsigned int AUDIO_STREAM_MAX_FORMAT_SIZE = 1024;
+
+    AudioStream::AudioStream() :
+        m_DataOffset(0),
+        m_DataSize(0),
+        m_EncodedSize(0),
+        m_FrameCount(0),
+        m_BufferFrames(0),
+        m_SampleRate(0),
+        m_FormatTag(0),
+        m_Channels(0),
+        m_BlockAlign(0),
+        m_BitsPerSample(0),
+        m_DecodeTime(0.0),
+        m_NextFrame(0),
+        m_NextSequence(0),
+        m_Epoch(0),
+        m_Underruns(0),
+        m_IsCompressed(false),
+        m_IsLooping(false),
+        m_IsClosing(false)
+    {
+    }
+
+    AudioStream::~AudioStream()
+    {
+        Close();
+    }
+
+    bool AudioStream::Open(const std::string& aPath, unsigned int aMinimumDataSize)
+    {
+        m_File.open(aPath.c_str(), std::ios::binary | std::ios::in);
+        if (m_File.is_open() == false)
+        {
+            return false;
+        }
+
+        //Check the RIFF header
+        char header[12];
+        if (m_File.read(header, sizeof(header)).good() == false || memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0)
+        {
+            m_File.close();
+            return false;
+        }
+
+        //Walk the chunks until both the format and the data chunks are found, only the data chunk's header is read
+        std::vector<unsigned char> format;
+        bool hasFormat = false;
+        bool hasData = false;
+        unsigned long long offset = sizeof(header);
+        while (hasFormat == false || hasData == false)
+        {
+            char chunkId[4];
+            unsigned int chunkSize = 0;
+            m_File.seekg(offset, std::ios::beg);
+            if (m_File.read(chunkId, sizeof(chunkId)).good() == false || m_File.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize)).good() == false)
+            {
+                break;
+            }
+
+            if (memcmp(chunkId, "fmt ", 4) == 0 && chunkSize >= 16 && chunkSize <= AUDIO_STREAM_MAX_FORMAT_SIZE)
+            {
+                //The whole chunk is read, compressed formats store what they need to be decoded after the PCMWAVEFORMAT
+                format.resize(chunkSize);
+                m_File.read(reinterpret_cast<char*>(&format[0]), chunkSize);
+                m_FormatTag = Wave::GetFormatTag(&format[0], chunkSize);
+                memcpy(&m_Channels, &format[2], sizeof(m_Channels));
+                memcpy(&m_SampleRate, &format[4], sizeof(m_SampleRate));
+                memcpy(&m_BlockAlign, &format[12], sizeof(m_BlockAlign));
+                memcpy(&m_BitsPerSample, &format[14], sizeof(m_BitsPerSample));
+                hasFormat = m_File.good();
+            }
+            else if (memcmp(chunkId, "data", 4) == 0)
+            {
+                m_DataOffset = offset + 8;
+                m_DataSize = chunkSize;
+                hasData = true;
+            }
+
+            //Chunks are WORD aligned
+            offset += 8 + ((unsigned long long)chunkSize + 1) / 2 * 2;
+        }
+
+        //ADPCM is decoded to 16-bit PCM as it's read, from then on the stream has the decoded format
+        m_IsCompressed = hasFormat == true && AdpcmDecoder::IsAdpcm(m_FormatTag) == true;
+        if (m_IsCompressed == true)
+        {
+            if (m_Decoder.Init(&format[0], (unsigned int)format.size()) == false)
+            {
+                m_File.close();
+                return false;
+            }
+
+            m_FormatTag = AUDIO_STREAM_FORMAT_PCM;
+            m_BitsPerSample = 16;
+            m_BlockAlign = m_Channels * sizeof(short);
+        }
+
+        //Only the formats the mixer can play are streamed
+        bool isPCM = m_FormatTag == AUDIO_STREAM_FORMAT_PCM && (m_BitsPerSample == 8 || m_BitsPerSample == 16);
+        bool isFloat = m_FormatTag == AUDIO_STREAM_FORMAT_IEEE_FLOAT && m_BitsPerSample == 32;
+        bool isSupported = (isPCM == true || isFloat == true) && (m_Channels == 1 || m_Channels == 2) && m_BlockAlign == m_Channels * m_BitsPerSample / 8;
+        if (hasFormat == false || hasData == false || isSupported == false)
+        {
+            m_File.close();
+            return false;
+        }
+
+        //Size the buffers, the data chunk's size is trusted only as far as the file actually goes
+        m_File.clear();
+        m_File.seekg(0, std::ios::end);
+        unsigned long long fileSize = (unsigned long long)m_File.tellg();
+        if (m_DataOffset + m_DataSize > fileSize)
+        {
+            m_DataSize = fileSize > m_DataOffset ? (unsigned int)(fileSize - m_DataOffset) : 0;
+        }
+
+        m_FrameCount = m_DataSize / m_BlockAlign;
+        m_BufferFrames = AUDIO_STREAM_BUFFER_BYTES / m_BlockAlign;
+
+        //Compressed buffers hold whole blocks, so that a buffer is decoded without the blocks around it
+        if (m_IsCompressed == true)
+        {
+            unsigned int blocks = m_BufferFrames / m_Decoder.GetFramesPerBlock();
+            blocks = blocks > 0 ? blocks : 1;
+            m_EncodedSize = m_DataSize;
+            m_FrameCount = m_Decoder.GetFrameCount(m_EncodedSize);
+            m_DataSize = m_FrameCount * m_BlockAlign;
+            m_BufferFrames = blocks * m_Decoder.GetFramesPerBlock();
+        }
+
+        //Files that are too small to be worth streaming are rejected before any buffers are allocated
+        if (m_DataSize < aMinimumDataSize || m_DataSize < (unsigned long long)GetResidentBytes() * 2)
+        {
+            m_File.close();
+            return false;
+        }
+
+        if (m_IsCompressed == true)
+        {
+            m_Blocks.resize(m_BufferFrames / m_Decoder.GetFramesPerBlock() * m_Decoder.GetBlockAlign());
+        }
+
+        m_Buffers.resize(AUDIO_STREAM_BUFFER_COUNT);
+        for (unsigned int i = 0; i < m_Buffers.size(); i++)
+        {
+            m_Buffers[i].data.resize(m_BufferFrames * m_BlockAlign);
+        }
+
+        return true;
+    }
+
+    void AudioStream::Close()
+    {
+        //Stop the background thread
+        if (m_Thread.joinable() == true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_IsClosing = true;
+            }
+            m_Condition.notify_one();
+            m_Thread.join();
+        }
+
+        if (m_File.is_open() == true)
+        {
+            m_File.close();
+        }
+    }
+
+    void AudioStream::GetAudioSource(AudioSource& aSource)
+    {
+        aSource.data = nullptr;
+        aSource.stream = this;
+        aSource.frameCount = m_FrameCount;
+        aSource.sampleRate = m_SampleRate;
+        aSource.channels = m_Channels;
+        aSource.bitsPerSample = m_BitsPerSample;
+    }
+
+    unsigned short AudioStream::GetFormatTag() const
+    {
+        return m_FormatTag;
+    }
+
+    unsigned short AudioStream::GetChannels() const
+    {
+        return m_Channels;
+    }
+
+    unsigned int AudioStream::GetSampleRate() const
+    {
+        return m_SampleRate;
+    }
+
+    unsigned short AudioStream::GetBlockAlign() const
+    {
+        return m_BlockAlign;
+    }
+
+    unsigned short AudioStream::GetBitsPerSample() const
+    {
+        return m_BitsPerSample;
+    }
+
+    unsigned int AudioStream::GetDataSize() const
+    {
+        return m_DataSize;
+    }
+
+    unsigned int AudioStream::GetFrameCount() const
+    {
+        return m_FrameCount;
+    }
+
+    void AudioStream::Seek(unsigned int aFrame)
+    {
+        if (m_FrameCount == 0)
+        {
+            return;
+        }
+
+        //The background thread is started the first time the stream is played
+        if (m_Thread.joinable() == false)
+        {
+            m_Thread = std::thread(&AudioStream::Run, this);
+        }
+
+        Buffer* first = nullptr;
+        unsigned int epoch = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            //Changing the epoch discards the buffer the background thread is filling, once it's done
+            m_Epoch++;
+            epoch = m_Epoch;
+            for (unsigned int i = 0; i < m_Buffers.size(); i++)
+            {
+                if (m_Buffers[i].state == Buffer_Ready)
+                {
+                    m_Buffers[i].state = Buffer_Free;
+                }
+
+                if (first == nullptr && m_Buffers[i].state == Buffer_Free)
+                {
+                    first = &m_Buffers[i];
+                }
+            }
+
+            //Claim the first buffer, at most one buffer is being filled so there is always a free buffer. The buffer starts
+            //a few frames before the position, the resampler reads frames behind the position it's playing
+            aFrame = aFrame < m_FrameCount ? aFrame : 0;
+            aFrame = aFrame > AudioKernels::SINC_TAPS ? aFrame - AudioKernels::SINC_TAPS : 0;
+            aFrame = m_IsCompressed == true ? aFrame - aFrame % m_Decoder.GetFramesPerBlock() : aFrame;
+            first->state = Buffer_Filling;
+            first->first = aFrame;
+            first->count = m_FrameCount - aFrame < m_BufferFrames ? m_FrameCount - aFrame : m_BufferFrames;
+            first->sequence = m_NextSequence++;
+            m_NextFrame = first->first + first->count;
+        }
+
+        //Read the first buffer without holding the stream's lock, like the background thread does, so that the mixer is
+        //never blocked by the read. The buffer is Filling, the mixer doesn't read from it until it's published
+        {
+            std::lock_guard<std::mutex> fileLock(m_FileMutex);
+            ReadFile(first->first, first->count, &first->data[0]);
+        }
+
+        //Publish the buffer, unless the stream was seeked again in the meantime
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            first->state = epoch == m_Epoch ? Buffer_Ready : Buffer_Free;
+        }
+        m_Condition.notify_one();
+    }
+
+    void AudioStream::SetLooping(bool aIsLooping)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_IsLooping = aIsLooping;
+        }
+        m_Condition.notify_one();
+    }
+
+    void AudioStream::ReadFrames(unsigned int aFrame, unsigned int aCount, float* aOutput)
+    {
+        bool hasFreed = false;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            while (aCount > 0)
+            {
+                //Find the oldest ready buffer that holds the frame
+                Buffer* buffer = nullptr;
+                for (unsigned int i = 0; i < m_Buffers.size(); i++)
+                {
+                    Buffer& candidate = m_Buffers[i];
+                    if (candidate.state == Buffer_Ready && aFrame >= candidate.first && aFrame < candidate.first + candidate.count &&
+                        (buffer == nullptr || candidate.sequence < buffer->sequence))
+                    {
+                        buffer = &candidate;
+                    }
+                }
+
+                //The frame hasn't been read from disk yet, it is silent
+                if (buffer == nullptr)
+                {
+                    memset(aOutput, 0, aCount * m_Channels * sizeof(float));
+                    m_Underruns++;
+                    break;
+                }
+
+                //Once the mixer is far enough into a buffer that it no longer reads frames from the buffers before it (the resampler
+                //reads a few frames behind its position), those buffers are freed for the background thread to refill
+                if (aFrame - buffer->first >= AudioKernels::SINC_TAPS)
+                {
+                    for (unsigned int i = 0; i < m_Buffers.size(); i++)
+                    {
+                        if (m_Buffers[i].state == Buffer_Ready && m_Buffers[i].sequence < buffer->sequence)
+                        {
+                            m_Buffers[i].state = Buffer_Free;
+                            hasFreed = true;
+                        }
+                    }
+                }
+
+                //Convert the frames the buffer holds
+                unsigned int count = buffer->first + buffer->count - aFrame < aCount ? buffer->first + buffer->count - aFrame : aCount;
+                const unsigned char* data = &buffer->data[(aFrame - buffer->first) * m_BlockAlign];
+                unsigned int samples = count * m_Channels;
+
+                if (m_BitsPerSample == 8)
+                {
+                    AudioKernels::ConvertU8ToFloat(data, aOutput, samples);
+                }
+                else if (m_BitsPerSample == 16)
+                {
+                    AudioKernels::ConvertS16ToFloat(reinterpret_cast<const short*>(data), aOutput, samples);
+                }
+                else
+                {
+                    memcpy(aOutput, data, samples * sizeof(float));
+                }
+
+                aFrame += count;
+                aCount -= count;
+                aOutput += samples;
+            }
+        }
+
+        if (hasFreed == true)
+        {
+            m_Condition.notify_one();
+        }
+    }
+
+    unsigned int AudioStream::GetUnderrunCount()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Underruns;
+    }
+
+    unsigned int AudioStream::GetResidentBytes() const
+    {
+        unsigned int blockBytes = m_IsCompressed == true ? m_BufferFrames / m_Decoder.GetFramesPerBlock() * m_Decoder.GetBlockAlign() : 0;
+        return AUDIO_STREAM_BUFFER_COUNT * m_BufferFrames * m_BlockAlign + blockBytes;
+    }
+
+    bool AudioStream::IsCompressed() const
+    {
+        return m_IsCompressed;
+    }
+
+    double AudioStream::GetDecodeTime()
+    {
+        std::lock_guard<std::mutex> fileLock(m_FileMutex);
+        return m_DecodeTime;
+    }
+
+    void AudioStream::Run()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        while (m_IsClosing == false)
+        {
+            //Find a free buffer
+            Buffer* buffer = nullptr;
+            for (unsigned int i = 0; i < m_Buffers.size(); i++)
+            {
+                if (m_Buffers[i].state == Buffer_Free)
+                {
+                    buffer = &m_Buffers[i];
+                    break;
+                }
+            }
+
+            //Continue from the start of the file once the end is reached, if the stream loops
+            if (m_NextFrame >= m_FrameCount && m_IsLooping == true)
+            {
+                m_NextFrame = 0;
+            }
+
+            //Wait until there's a buffer to fill and frames to fill it with
+            if (buffer == nullptr || m_NextFrame >= m_FrameCount)
+            {
+                m_Condition.wait(lock);
+                continue;
+            }
+
+            buffer->state = Buffer_Filling;
+            buffer->first = m_NextFrame;
+            buffer->count = m_FrameCount - m_NextFrame < m_BufferFrames ? m_FrameCount - m_NextFrame : m_BufferFrames;
+            buffer->sequence = m_NextSequence++;
+            m_NextFrame += buffer->count;
+            unsigned int epoch = m_Epoch;
+
+            //Read the file without holding the stream's lock, so that the mixer can keep reading the ready buffers
+            lock.unlock();
+            {
+                std::lock_guard<std::mutex> fileLock(m_FileMutex);
+                ReadFile(buffer->first, buffer->count, &buffer->data[0]);
+            }
+            lock.lock();
+
+            //If the stream was seeked while the buffer was being filled, the buffer is discarded
+            buffer->state = epoch == m_Epoch ? Buffer_Ready : Buffer_Free;
+        }
+    }
+
+    void AudioStream::ReadFile(unsigned int aFrame, unsigned int aCount, unsigned char* aOutput)
+    {
+        if (m_IsCompressed == true)
+        {
+            DecodeFile(aFrame, aCount, aOutput);
+            return;
+        }
+
+        m_File.clear();
+        m_File.seekg(m_DataOffset + (unsigned long long)aFrame * m_BlockAlign, std::ios::beg);
+        m_File.read(reinterpret_cast<char*>(aOutput), (std::streamsize)aCount * m_BlockAlign);
+
+        //Anything that couldn't be read is silent
+        std::streamsize bytesRead = m_File.gcount();
+        if (bytesRead < (std::streamsize)aCount * m_BlockAlign)
+        {
+            memset(aOutput + bytesRead, m_BitsPerSample == 8 ? 128 : 0, (size_t)(aCount * m_BlockAlign - bytesRead));
+        }
+    }
+
+    void AudioStream::DecodeFile(unsigned int aFrame, unsigned int aCount, unsigned char* aOutput)
+    {
+        //Buffers always start on a block, read every block that holds one of the frames
+        unsigned int blockAlign = m_Decoder.GetBlockAlign();
+        unsigned int framesPerBlock = m_Decoder.GetFramesPerBlock();
+        unsigned long long offset = (unsigned long long)(aFrame / framesPerBlock) * blockAlign;
+        unsigned int blocks = (aCount + framesPerBlock - 1) / framesPerBlock;
+        unsigned int size = blocks * blockAlign;
+        size = offset + size > m_EncodedSize ? m_EncodedSize - (unsigned int)offset : size;
+        m_File.clear();
+        m_File.seekg(m_DataOffset + offset, std::ios::beg);
+        m_File.read(reinterpret_cast<char*>(&m_Blocks[0]), size);
+        unsigned int bytesRead = (unsigned int)m_File.gcount();
+
+        //Decode the blocks straight into the buffer
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        short* output = reinterpret_cast<short*>(aOutput);
+        unsigned int decoded = 0;
+        for (unsigned int i = 0; i < blocks && i * blockAlign < bytesRead; i++)
+        {
+            unsigned int blockSize = bytesRead - i * blockAlign < blockAlign ? bytesRead - i * blockAlign : blockAlign;
+            decoded += m_Decoder.DecodeBlock(&m_Blocks[i * blockAlign], blockSize, output + decoded * m_Channels);
+        }
+        m_DecodeTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        //Anything that couldn't be read is silent
+        if (decoded < aCount)
+        {
+            memset(output + decoded * m_Channels, 0, (aCount - decoded) * m_BlockAlign);
+        }
+    }
+}
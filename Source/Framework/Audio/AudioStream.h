@@ -0,0 +1,130 @@
+#pragma once
+
+#include "AdpcmDecoder.h"
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Forward declaration
+    struct AudioSource;
+
+    //An AudioStream plays a wave file from disk instead of loading the whole file, it is used for long files such as music.
+    //A background thread reads the file ahead of playback into a small ring of buffers, the AudioMixer reads the frames it
+    //needs out of the buffers. Only the buffers are resident, no matter how long the file is. ADPCM compressed files are
+    //decoded block by block as they are read, the stream then looks like 16-bit PCM to the mixer
+    class AudioStream
+    {
+    public:
+        AudioStream();
+        ~AudioStream();
+
+        //Opens a wave file and reads its format, returns false if the file can't be streamed. A file whose data (after it's
+        //decoded) is smaller than the minimum size, OR than twice the stream's buffers, is rejected as soon as its header is
+        //read, before the buffers are allocated, a file that small is cheaper to load into memory
+        bool Open(const std::string& path, unsigned int minimumDataSize = 0);
+
+        //Stops the background thread and closes the file
+        void Close();
+
+        //Fills in the AudioSource the mixer needs to play the stream
+        void GetAudioSource(AudioSource& source);
+
+        //Returns the format of the wave file, after it's decoded
+        unsigned short GetFormatTag() const;
+        unsigned short GetChannels() const;
+        unsigned int GetSampleRate() const;
+        unsigned short GetBlockAlign() const;
+        unsigned short GetBitsPerSample() const;
+
+        //Returns the size of the wave file's data after it's decoded, in bytes
+        unsigned int GetDataSize() const;
+
+        //Returns the number of frames in the wave file
+        unsigned int GetFrameCount() const;
+
+        //Restarts the stream at a frame, the first buffer is read before Seek() returns so that playback can start right
+        //away. The buffer is read without holding the lock the mixer reads frames under. This MUST NOT be called while the
+        //stream's voice is playing
+        void Seek(unsigned int frame);
+
+        //Sets wether the stream continues from the start of the file once it reaches the end
+        void SetLooping(bool isLooping);
+
+        //Converts frames to floats, frames that haven't been read from disk yet are silent. Called by the AudioMixer
+        void ReadFrames(unsigned int frame, unsigned int count, float* output);
+
+        //Returns the number of times that the mixer needed frames that hadn't been read from disk yet
+        unsigned int GetUnderrunCount();
+
+        //Returns the size of the stream's buffers, in bytes
+        unsigned int GetResidentBytes() const;
+
+        //Returns wether the wave file is compressed and decoded as it is read
+        bool IsCompressed() const;
+
+        //Returns the time that the background thread has spent decoding the file, in seconds
+        double GetDecodeTime();
+
+    private:
+        enum BufferState
+        {
+            Buffer_Free = 0,
+            Buffer_Filling,
+            Buffer_Ready
+        };
+
+        struct Buffer
+        {
+            Buffer() : first(0), count(0), sequence(0), state(Buffer_Free) {}
+
+            std::vector<unsigned char> data;
+            unsigned int first;
+            unsigned int count;
+            unsigned long long sequence;
+            BufferState state;
+        };
+
+        //The background thread's loop, it fills free buffers until the stream is closed
+        void Run();
+
+        //Reads frames from the file into a buffer, the file MUST be locked
+        void ReadFile(unsigned int frame, unsigned int count, unsigned char* output);
+
+        //Reads the blocks that hold the frames from the file and decodes them into a buffer, the file MUST be locked
+        void DecodeFile(unsigned int frame, unsigned int count, unsigned char* output);
+
+        //Member variables
+        std::ifstream m_File;
+        std::thread m_Thread;
+        std::mutex m_Mutex;
+        std::mutex m_FileMutex;
+        std::condition_variable m_Condition;
+        std::vector<Buffer> m_Buffers;
+        std::vector<unsigned char> m_Blocks;
+        AdpcmDecoder m_Decoder;
+        double m_DecodeTime;
+        unsigned long long m_DataOffset;
+        unsigned int m_DataSize;
+        unsigned int m_EncodedSize;
+        unsigned int m_FrameCount;
+        unsigned int m_BufferFrames;
+        unsigned int m_SampleRate;
+        unsigned short m_FormatTag;
+        unsigned short m_Channels;
+        unsigned short m_BlockAlign;
+        unsigned short m_BitsPerSample;
+        unsigned int m_NextFrame;
+        unsigned long long m_NextSequence;
+        unsigned int m_Epoch;
+        unsigned int m_Underruns;
+        bool m_IsCompressed;
+        bool m_IsLooping;
+        bool m_IsClosing;
+    };
+}
@@ -1,7 +1,7 @@
 #pragma once
 
-#include "Audio.h"
-#include "../Events/AudioEvent.h"
+#include "AudioMixer.h"
+#include "../IO/MappedFile.h"
 #include <xaudio2.h>
 
 
@@ -14,57 +14,45 @@ namespace GameDev2D
 			ZeroMemory(&waveFormat, sizeof(waveFormat));
 			ZeroMemory(&buffer, sizeof(buffer));
 			data = nullptr;
+			mappedFile = nullptr;
 		}
 
 		~WaveData()
 		{
-			delete[] data;
-		}
-
-		WAVEFORMATEX waveFormat;
-		XAUDIO2_BUFFER buffer;
-		void* data;
-	};
-
-	struct AudioCallback : public IXAudio2VoiceCallback
-	{
-		AudioCallback()
-		{
-		}
-
-		virtual ~AudioCallback()
-		{
-		}
-
-		__declspec(nothrow) void __stdcall OnVoiceProcessingPassStart(UINT32 SamplesRequired) {}
-		__declspec(nothrow) void __stdcall OnVoiceProcessingPassEnd() {}
-		__declspec(nothrow) void __stdcall OnStreamEnd() {}
-		__declspec(nothrow) void __stdcall OnBufferStart(void* context)
-		{
-			if (context != nullptr)
+			//Wave data that was loaded from a file points into the file's mapping, otherwise the data was allocated
+			if (mappedFile != nullptr)
 			{
-				Audio* audio = reinterpret_cast<Audio*>(context);
-				audio->DispatchEvent(AudioEvent(audio, AUDIO_PLAYBACK_STARTED));
+				delete mappedFile;
 			}
-		}
-
-		__declspec(nothrow) void __stdcall OnBufferEnd(void* context)
-		{
-			if (context != nullptr)
+			else
 			{
-				Audio* audio = reinterpret_cast<Audio*>(context);
-				audio->DispatchEvent(AudioEvent(audio, AUDIO_PLAYBACK_ENDED));
+				delete[] static_cast<unsigned char*>(data);
 			}
 		}
 
-		__declspec(nothrow) void __stdcall OnLoopEnd(void* context) 
+		//Fills in the AudioSource the mixer needs to play the wave data, returns false if the
+		//wave format is one the mixer can't play (8 and 16-bit PCM and 32-bit float are supported). Extensible formats
+		//were already resolved to the PCM or float format their SubFormat stands for when the wave file was loaded
+		bool GetAudioSource(AudioSource& source) const
 		{
-			if (context != nullptr)
+			bool isPCM = waveFormat.wFormatTag == WAVE_FORMAT_PCM && (waveFormat.wBitsPerSample == 8 || waveFormat.wBitsPerSample == 16);
+			bool isFloat = waveFormat.wFormatTag == WAVE_FORMAT_IEEE_FLOAT && waveFormat.wBitsPerSample == 32;
+			if ((isPCM == false && isFloat == false) || waveFormat.nChannels == 0 || waveFormat.nChannels > 2)
 			{
-				Audio* audio = reinterpret_cast<Audio*>(context);
-				audio->DispatchEvent(AudioEvent(audio, AUDIO_LOOP_ENDED));
+				return false;
 			}
+
+			source.data = buffer.pAudioData;
+			source.frameCount = buffer.AudioBytes / (waveFormat.nChannels * (waveFormat.wBitsPerSample / 8));
+			source.sampleRate = waveFormat.nSamplesPerSec;
+			source.channels = waveFormat.nChannels;
+			source.bitsPerSample = waveFormat.wBitsPerSample;
+			return true;
 		}
-		__declspec(nothrow) void __stdcall OnVoiceError(void* context, HRESULT) {}
+
+		WAVEFORMATEX waveFormat;
+		XAUDIO2_BUFFER buffer;
+		void* data;
+		MappedFile* mappedFile;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "XAudio2AudioSink.h"
+#include "AudioMixer.h"
+#include "../Debug/Log.h"
+#pragma comment(lib, "Xaudio2")
+
+
+namespace GameDev2D
+{
+    //The number of buffers queued on the source voice, and the number of frames in each buffer. At 44100 Hz
+    //three 512 frame buffers are ~35 milliseconds of latency
+    const unsigned int XAUDIO2_SINK_BUFFER_COUNT = 3;
+    const unsigned int XAUDIO2_SINK_BUFFER_FRAMES = 512;
+
+    XAudio2AudioSink::XAudio2AudioSink() :
+        m_Mixer(nullptr),
+        m_Engine(nullptr),
+        m_MasteringVoice(nullptr),
+        m_SourceVoice(nullptr),
+        m_IsOpen(false)
+    {
+    }
+
+    XAudio2AudioSink::~XAudio2AudioSink()
+    {
+        Close();
+    }
+
+    bool XAudio2AudioSink::Open(AudioMixer* aMixer)
+    {
+        m_Mixer = aMixer;
+        m_Samples.resize(XAUDIO2_SINK_BUFFER_COUNT * XAUDIO2_SINK_BUFFER_FRAMES * aMixer->GetChannels());
+
+        //Create the engine and the mastering voice
+        if (FAILED(XAudio2Create(&m_Engine)) || FAILED(m_Engine->CreateMasteringVoice(&m_MasteringVoice)))
+        {
+            Log::Error(false, Log::Verbosity_Audio, "[XAudio2AudioSink] Failed to create the XAudio2 engine");
+            Close();
+            return false;
+        }
+
+        //The source voice plays the mixer's output, interleaved floats
+        WAVEFORMATEX waveFormat;
+        ZeroMemory(&waveFormat, sizeof(waveFormat));
+        waveFormat.wFormatTag = WAVE_FORMAT_IEEE_FLOAT;
+        waveFormat.nChannels = (WORD)aMixer->GetChannels();
+        waveFormat.nSamplesPerSec = aMixer->GetSampleRate();
+        waveFormat.wBitsPerSample = 32;
+        waveFormat.nBlockAlign = waveFormat.nChannels * sizeof(float);
+        waveFormat.nAvgBytesPerSec = waveFormat.nSamplesPerSec * waveFormat.nBlockAlign;
+
+        if (FAILED(m_Engine->CreateSourceVoice(&m_SourceVoice, &waveFormat, XAUDIO2_VOICE_NOPITCH, XAUDIO2_DEFAULT_FREQ_RATIO, this, nullptr, nullptr)))
+        {
+            Log::Error(false, Log::Verbosity_Audio, "[XAudio2AudioSink] Failed to create the source voice");
+            Close();
+            return false;
+        }
+
+        //Queue every buffer, then start the voice
+        m_IsOpen = true;
+        for (unsigned int i = 0; i < XAUDIO2_SINK_BUFFER_COUNT; i++)
+        {
+            SubmitBuffer(i);
+        }
+        m_SourceVoice->Start();
+
+        return true;
+    }
+
+    void XAudio2AudioSink::Close()
+    {
+        //Stop refilling the buffers, destroying the source voice waits for any callback that is in progress
+        m_IsOpen = false;
+
+        if (m_SourceVoice != nullptr)
+        {
+            m_SourceVoice->Stop();
+            m_SourceVoice->DestroyVoice();
+            m_SourceVoice = nullptr;
+        }
+
+        if (m_MasteringVoice != nullptr)
+        {
+            m_MasteringVoice->DestroyVoice();
+            m_MasteringVoice = nullptr;
+        }
+
+        if (m_Engine != nullptr)
+        {
+            m_Engine->Release();
+            m_Engine = nullptr;
+        }
+
+        m_Mixer = nullptr;
+    }
+
+    void XAudio2AudioSink::Suspend()
+    {
+        if (m_Engine != nullptr)
+        {
+            m_Engine->StopEngine();
+        }
+    }
+
+    void XAudio2AudioSink::Resume()
+    {
+        if (m_Engine != nullptr)
+        {
+            m_Engine->StartEngine();
+        }
+    }
+
+    void XAudio2AudioSink::OnBufferEnd(void* aContext)
+    {
+        if (m_IsOpen == true)
+        {
+            SubmitBuffer((unsigned int)reinterpret_cast<uintptr_t>(aContext));
+        }
+    }
+
+    void XAudio2AudioSink::SubmitBuffer(unsigned int aIndex)
+    {
+        unsigned int samplesPerBuffer = XAUDIO2_SINK_BUFFER_FRAMES * m_Mixer->GetChannels();
+        float* samples = &m_Samples[aIndex * samplesPerBuffer];
+        m_Mixer->Mix(samples, XAUDIO2_SINK_BUFFER_FRAMES);
+
+        //The buffer's index is passed as its context, so that OnBufferEnd() knows which buffer to refill
+        XAUDIO2_BUFFER buffer;
+        ZeroMemory(&buffer, sizeof(buffer));
+        buffer.AudioBytes = samplesPerBuffer * sizeof(float);
+        buffer.pAudioData = reinterpret_cast<const BYTE*>(samples);
+        buffer.pContext = reinterpret_cast<void*>((uintptr_t)aIndex);
+        m_SourceVoice->SubmitSourceBuffer(&buffer);
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "AudioSink.h"
+#include <xaudio2.h>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //The XAudio2AudioSink outputs the mixed audio through a single XAudio2 source voice. It keeps a ring of small float
+    //buffers queued on the voice, whenever XAudio2 finishes playing one, it is refilled from the mixer (on XAudio2's
+    //thread) and queued again, so the latency is the length of the queued buffers
+    class XAudio2AudioSink : public AudioSink, public IXAudio2VoiceCallback
+    {
+    public:
+        XAudio2AudioSink();
+        virtual ~XAudio2AudioSink();
+
+        virtual bool Open(AudioMixer* mixer);
+        virtual void Close();
+        virtual void Suspend();
+        virtual void Resume();
+
+        //IXAudio2VoiceCallback methods
+        __declspec(nothrow) void __stdcall OnVoiceProcessingPassStart(UINT32 bytesRequired) {}
+        __declspec(nothrow) void __stdcall OnVoiceProcessingPassEnd() {}
+        __declspec(nothrow) void __stdcall OnStreamEnd() {}
+        __declspec(nothrow) void __stdcall OnBufferStart(void* context) {}
+        __declspec(nothrow) void __stdcall OnBufferEnd(void* context);
+        __declspec(nothrow) void __stdcall OnLoopEnd(void* context) {}
+        __declspec(nothrow) void __stdcall OnVoiceError(void* context, HRESULT error) {}
+
+    private:
+        //Mixes a buffer and queues it on the source voice
+        void SubmitBuffer(unsigned int index);
+
+        //Member variables
+        AudioMixer* m_Mixer;
+        IXAudio2* m_Engine;
+        IXAudio2MasteringVoice* m_MasteringVoice;
+        IXAudio2SourceVoice* m_SourceVoice;
+        std::vector<float> m_Samples;
+        volatile bool m_IsOpen;
+    };
+}
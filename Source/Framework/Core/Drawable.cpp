@@ -1,4 +1,6 @@
 #include "Drawable.h"
+#include "../Math/TransformKernels.h"
+#include "../Services/SpatialIndex/SpatialIndex.h"
 
 
 namespace GameDev2D
@@ -8,7 +10,9 @@ namespace GameDev2D
         m_Color(Color::WhiteColor()),
         m_Anchor(0.0f, 0.0f),
 		m_BlendingMode(BlendingMode()),
-		m_EdgesCalculationDirty(true)
+		m_EdgesCalculationDirty(true),
+		m_SpatialIndex(nullptr),
+		m_SpatialIndexProxy(SPATIAL_INDEX_INVALID_PROXY)
     {
 		for (int i = 0; i < TotalEdges; i++)
 		{
@@ -16,11 +20,48 @@ namespace GameDev2D
 		}
     }
 
+	Drawable::Drawable(const Drawable& aDrawable) : Transformable(aDrawable),
+		m_Shader(aDrawable.m_Shader),
+		m_Color(aDrawable.m_Color),
+		m_Anchor(aDrawable.m_Anchor),
+		m_BlendingMode(aDrawable.m_BlendingMode),
+		m_EdgesCalculationDirty(aDrawable.m_EdgesCalculationDirty),
+		m_SpatialIndex(nullptr),
+		m_SpatialIndexProxy(SPATIAL_INDEX_INVALID_PROXY)
+	{
+		//The copy isn't in the SpatialIndex, even if the original is
+		for (int i = 0; i < TotalEdges; i++)
+		{
+			m_Edges[i] = aDrawable.m_Edges[i];
+		}
+	}
+
     Drawable::~Drawable()
     {
-
+		if (m_SpatialIndex != nullptr)
+		{
+			m_SpatialIndex->Remove(this);
+		}
     }
 
+	Drawable& Drawable::operator=(const Drawable& aDrawable)
+	{
+		if (this != &aDrawable)
+		{
+			Transformable::operator=(aDrawable);
+			m_Shader = aDrawable.m_Shader;
+			m_Color = aDrawable.m_Color;
+			m_Anchor = aDrawable.m_Anchor;
+			m_BlendingMode = aDrawable.m_BlendingMode;
+
+			//The SpatialIndex and proxy aren't assigned, the Drawable keeps its own membership. Its edges are
+			//recalculated, and its proxy is updated, once the derived class has assigned its size as well
+			EdgesAreDirty();
+		}
+
+		return *this;
+	}
+
     Shader* Drawable::GetShader()
     {
         return m_Shader;
@@ -61,22 +102,26 @@ namespace GameDev2D
     void Drawable::SetAnchor(Vector2 aAnchor)
     {
         m_Anchor = aAnchor;
+		EdgesAreDirty();
     }
 
 	void Drawable::SetAnchor(float aAnchorX, float aAnchorY)
 	{
 		m_Anchor.x = aAnchorX;
 		m_Anchor.y = aAnchorY;
+		EdgesAreDirty();
 	}
 
 	void Drawable::SetAnchorX(float aAnchorX)
 	{
 		m_Anchor.x = aAnchorX;
+		EdgesAreDirty();
 	}
 
 	void Drawable::SetAnchorY(float aAnchorY)
 	{
 		m_Anchor.y = aAnchorY;
+		EdgesAreDirty();
 	}
 
 	void Drawable::SetBlendingMode(BlendingFactor aSource, BlendingFactor aDestination)
@@ -137,31 +182,113 @@ namespace GameDev2D
 
 	void Drawable::TransformMatrixIsDirty()
 	{
-		m_EdgesCalculationDirty = true;
+		EdgesAreDirty();
 		Transformable::TransformMatrixIsDirty();
 	}
 
+	void Drawable::EdgesAreDirty()
+	{
+		m_EdgesCalculationDirty = true;
+
+		if (m_SpatialIndex != nullptr)
+		{
+			m_SpatialIndex->Invalidate(m_SpatialIndexProxy);
+		}
+	}
+
+	Vector2 Drawable::GetEdgesAnchor()
+	{
+		return m_Anchor;
+	}
+
+	void Drawable::UpdateEdges(Drawable** aDrawables, unsigned int aCount)
+	{
+		//The Drawables' transforms are gathered into arrays, a chunk at a time, then their edges are calculated in one pass
+		const unsigned int chunkSize = 64;
+		float positionX[chunkSize];
+		float positionY[chunkSize];
+		float radians[chunkSize];
+		float scaleX[chunkSize];
+		float scaleY[chunkSize];
+		float anchorX[chunkSize];
+		float anchorY[chunkSize];
+		float width[chunkSize];
+		float height[chunkSize];
+		float edges[chunkSize * TotalEdges];
+		Drawable* drawables[chunkSize];
+
+		TransformArrays arrays;
+		arrays.positionX = positionX;
+		arrays.positionY = positionY;
+		arrays.radians = radians;
+		arrays.scaleX = scaleX;
+		arrays.scaleY = scaleY;
+		arrays.anchorX = anchorX;
+		arrays.anchorY = anchorY;
+		arrays.width = width;
+		arrays.height = height;
+
+		unsigned int index = 0;
+		while (index < aCount)
+		{
+			//Gather the Drawables whose edges are dirty
+			unsigned int count = 0;
+			for (; index < aCount && count < chunkSize; index++)
+			{
+				Drawable* drawable = aDrawables[index];
+				if (drawable->m_EdgesCalculationDirty == true)
+				{
+					positionX[count] = drawable->m_Position.x;
+					positionY[count] = drawable->m_Position.y;
+					radians[count] = drawable->m_Rotation.GetRadians();
+					scaleX[count] = drawable->m_Scale.x;
+					scaleY[count] = drawable->m_Scale.y;
+					Vector2 anchor = drawable->GetEdgesAnchor();
+					anchorX[count] = anchor.x;
+					anchorY[count] = anchor.y;
+					width[count] = drawable->GetWidth();
+					height[count] = drawable->GetHeight();
+					drawables[count] = drawable;
+					count++;
+				}
+			}
+
+			TransformKernels::CalculateBounds(arrays, edges, count);
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				for (unsigned int j = 0; j < TotalEdges; j++)
+				{
+					drawables[i]->m_Edges[j] = edges[i * TotalEdges + j];
+				}
+				drawables[i]->m_EdgesCalculationDirty = false;
+			}
+		}
+	}
+
 	void Drawable::CalculateEdges()
 	{
+		float positionX = m_Position.x;
+		float positionY = m_Position.y;
 		float radians = GetRadians();
-		float w = GetWidth();
-		float h = GetHeight();
-		float c = cosf(radians);
-		float s = sinf(radians);
-		float cw = c * w;
-		float ch = c * h;
-		float sw = s * w;
-		float sh = s * h;
-		float ex = (fabsf(sh) + fabsf(cw)) * 0.5f;
-		float ey = (fabsf(sw) + fabsf(ch)) * 0.5f;
-		float ax = GetAnchor().x;
-		float ay = GetAnchor().y;
-
-		//Calculate the edge positions
-		m_Edges[LeftEdge] = m_Position.x + sh * (ay - 0.5f) - cw * (ax - 0.5f) - ex;
-		m_Edges[RightEdge] = m_Position.x + sh * (ay - 0.5f) - cw * (ax - 0.5f) + ex;
-		m_Edges[TopEdge] = m_Position.y - sw * (ax - 0.5f) - ch * (ay - 0.5f) + ey;
-		m_Edges[BottomEdge] = m_Position.y - sw * (ax - 0.5f) - ch * (ay - 0.5f) - ey;
+		float width = GetWidth();
+		float height = GetHeight();
+		Vector2 anchor = GetEdgesAnchor();
+
+		TransformArrays arrays;
+		arrays.positionX = &positionX;
+		arrays.positionY = &positionY;
+		arrays.radians = &radians;
+		arrays.scaleX = &m_Scale.x;
+		arrays.scaleY = &m_Scale.y;
+		arrays.anchorX = &anchor.x;
+		arrays.anchorY = &anchor.y;
+		arrays.width = &width;
+		arrays.height = &height;
+
+		//The edges are in the same order as the kernel's bounds. It's the same kernel as UpdateEdges(), so that the edges
+		//don't depend on which one calculated them
+		TransformKernels::CalculateBounds(arrays, m_Edges, 1);
 		m_EdgesCalculationDirty = false;
 	}
 }
\ No newline at end of file
@@ -9,12 +9,19 @@
 
 namespace GameDev2D
 {
+    //Forward declarations
+    class SpatialIndex;
+
     class Drawable : public Transformable
     {
     public:
         Drawable();
+        Drawable(const Drawable& drawable);
         virtual ~Drawable();
 
+        //Assigns the other Drawable's properties, the Drawable stays in its own SpatialIndex (if it's in one)
+        Drawable& operator=(const Drawable& drawable);
+
         //All classes that inherit from Drawable must implement the Draw() method to 
         //ensure consistency across all Drawable objects (hence why its pure virtual)
         virtual void Draw() = 0;
@@ -76,13 +83,28 @@ namespace GameDev2D
 		//Returns the location of the bottom most edge
 		float GetBottomEdge();
 
+		//Calculates the edges of every Drawable whose edges are dirty, in one pass. Use it to prepare the
+		//edges of a large number of Drawables, instead of calculating them one at a time
+		static void UpdateEdges(Drawable** drawables, unsigned int count);
+
     protected:
+		//The SpatialIndex reads the edges and is notified when they change
+		friend class SpatialIndex;
+
 		//Overridden from transformable, used to figure out when to re-calculate the edges
 		void TransformMatrixIsDirty();
 
-		//Calculates the 4 edges
+		//Called when the edges need to be re-calculated, because the transform, anchor or size changed. If the
+		//Drawable is in a SpatialIndex, the index is notified. Classes that inherit from Drawable MUST call it when their size changes
+		void EdgesAreDirty();
+
+		//Calculates the 4 edges, they are the bounds of the Drawable's width and height after it's scaled and rotated
 		void CalculateEdges();
 
+		//Returns the anchor the edges are calculated with, by default the Drawable's anchor. Classes that don't draw
+		//their width and height from the origin (the Polygon) override it, so that the edges bound what they draw
+		virtual Vector2 GetEdgesAnchor();
+
         //Member variables
         Shader* m_Shader;
         Color m_Color;
@@ -100,6 +122,8 @@ namespace GameDev2D
 
 		float m_Edges[TotalEdges];
 		bool m_EdgesCalculationDirty;
+		SpatialIndex* m_SpatialIndex;
+		unsigned int m_SpatialIndexProxy;
     };
 }
 
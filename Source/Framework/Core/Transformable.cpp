@@ -1,4 +1,5 @@
 #include "Transformable.h"
+#include "../Math/TransformKernels.h"
 #include "../Debug/Log.h"
 
 
@@ -33,17 +34,30 @@ namespace GameDev2D
     {
         if (m_IsTransformMatrixDirty == true)
         {
-            Matrix translationMatrix = Matrix::MakeTranslation(m_Position);
-            Matrix rotationMatrix = Matrix::MakeRotation(m_Rotation);
-            Matrix scaleMatrix = Matrix::MakeScale(m_Scale);
-
-            m_Transform = translationMatrix * rotationMatrix * scaleMatrix;
+            //Build the matrix with the same kernel as UpdateTransformMatrices(), so that it doesn't depend on which one rebuilt it
+            float radians = m_Rotation.GetRadians();
+
+            TransformArrays arrays;
+            arrays.positionX = &m_Position.x;
+            arrays.positionY = &m_Position.y;
+            arrays.radians = &radians;
+            arrays.scaleX = &m_Scale.x;
+            arrays.scaleY = &m_Scale.y;
+
+            AffineTransform transform;
+            TransformKernels::CalculateTransforms(arrays, &transform, 1);
+            m_Transform = Matrix(transform);
             m_IsTransformMatrixDirty = false;
         }
 
         return m_Transform;
     }
 
+    AffineTransform Transformable::GetAffineTransform()
+    {
+        return AffineTransform(GetTransformMatrix());
+    }
+
     Vector2 Transformable::GetPosition()
     {
         return m_Position;
@@ -150,6 +164,55 @@ namespace GameDev2D
         Log::Message(Log::Verbosity_Debug, "[Transformable] Position(%f, %f), Rotation(%f), Scale(%f, %f)", m_Position.x, m_Position.y, m_Rotation.GetRadians(), m_Scale.x, m_Scale.y);
     }
 
+    void Transformable::UpdateTransformMatrices(Transformable** aTransformables, unsigned int aCount)
+    {
+        //The transforms are gathered into arrays, a chunk at a time, then the matrices are built in one pass
+        const unsigned int chunkSize = 64;
+        float positionX[chunkSize];
+        float positionY[chunkSize];
+        float radians[chunkSize];
+        float scaleX[chunkSize];
+        float scaleY[chunkSize];
+        AffineTransform transforms[chunkSize];
+        Transformable* transformables[chunkSize];
+
+        TransformArrays arrays;
+        arrays.positionX = positionX;
+        arrays.positionY = positionY;
+        arrays.radians = radians;
+        arrays.scaleX = scaleX;
+        arrays.scaleY = scaleY;
+
+        unsigned int index = 0;
+        while (index < aCount)
+        {
+            //Gather the Transformables whose matrix is dirty
+            unsigned int count = 0;
+            for (; index < aCount && count < chunkSize; index++)
+            {
+                Transformable* transformable = aTransformables[index];
+                if (transformable->m_IsTransformMatrixDirty == true)
+                {
+                    positionX[count] = transformable->m_Position.x;
+                    positionY[count] = transformable->m_Position.y;
+                    radians[count] = transformable->m_Rotation.GetRadians();
+                    scaleX[count] = transformable->m_Scale.x;
+                    scaleY[count] = transformable->m_Scale.y;
+                    transformables[count] = transformable;
+                    count++;
+                }
+            }
+
+            TransformKernels::CalculateTransforms(arrays, transforms, count);
+
+            for (unsigned int i = 0; i < count; i++)
+            {
+                transformables[i]->m_Transform = Matrix(transforms[i]);
+                transformables[i]->m_IsTransformMatrixDirty = false;
+            }
+        }
+    }
+
 	void Transformable::TransformMatrixIsDirty()
 	{
 		m_IsTransformMatrixDirty = true;
@@ -3,6 +3,7 @@
 #include "../Math/Rotation.h"
 #include "../Math/Vector2.h"
 #include "../Math/Matrix.h"
+#include "../Math/AffineTransform.h"
 
 
 namespace GameDev2D
@@ -17,6 +18,9 @@ namespace GameDev2D
         //Returns the Transformation matrix
         Matrix GetTransformMatrix();
 
+        //Returns the Transformation matrix as a 2D AffineTransform
+        AffineTransform GetAffineTransform();
+
         //Returns the Position of the Transformable object
         Vector2 GetPosition();
 
@@ -74,6 +78,10 @@ namespace GameDev2D
         //Logs the position, rotation and scale data to the output window
         void Log();
 
+        //Rebuilds the transform matrix of every Transformable whose matrix is dirty, in one pass. Use it to prepare
+        //the matrices of a large number of Transformables, instead of rebuilding them one at a time
+        static void UpdateTransformMatrices(Transformable** transformables, unsigned int count);
+
     protected:
 		virtual void TransformMatrixIsDirty();
 
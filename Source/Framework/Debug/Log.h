@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../GameDev2D_Settings.h"
 #include <stdarg.h>
 
 
@@ -31,6 +32,19 @@ namespace GameDev2D
         //Calling Init() will ensure that the log file is properly created on the hard drive
         static void Init();
 
+        //Returns wether messages of the verbosity are logged. For a constant verbosity it is a compile time constant, so
+        //a message wrapped in an IsEnabled() check is compiled out (arguments and all) when the LOG_VERBOSITY_MASK excludes it
+        static constexpr bool IsEnabled(Verbosity verbosity)
+        {
+#if (DEBUG || _DEBUG) && LOG_TO_FILE
+            return verbosity != Verbosity_None;
+#elif DEBUG || _DEBUG
+            return (verbosity & (LOG_VERBOSITY_MASK)) != 0;
+#else
+            return false;
+#endif
+        }
+
         //Used to Log a message with a variable amount of arguments, the
         //verbosity level for these logs is debug (VerbosityLevel_Debug).
         //If the LOG_TO_FILE to file preproc is enabled then this method
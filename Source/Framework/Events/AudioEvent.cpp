@@ -18,6 +18,9 @@ namespace GameDev2D
 
 	void AudioEvent::LogEvent()
 	{
-		Log::Message(Log::Verbosity_Audio, "[AudioEvent] %s", EventCodeToString(GetEventCode()).c_str());
+		if (Log::IsEnabled(Log::Verbosity_Audio) == true)
+		{
+			Log::Message(Log::Verbosity_Audio, "[AudioEvent] %s", EventCodeToString(GetEventCode()).c_str());
+		}
 	}
 }
\ No newline at end of file
@@ -110,7 +110,7 @@ namespace GameDev2D
 
     void Event::LogEvent()
     {
-        if (m_EventCode != DRAW_EVENT)
+        if (Log::IsEnabled(Log::Verbosity_Application) == true && m_EventCode != DRAW_EVENT)
         {
             Log::Message(Log::Verbosity_Application, "%s", EventCodeToString(m_EventCode).c_str());
         }
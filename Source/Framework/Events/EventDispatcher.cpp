@@ -1,11 +1,17 @@
 #include "EventDispatcher.h"
 #include "Event.h"
+#include "../Debug/Log.h"
+#include <algorithm>
 #include <assert.h>
 
 
 namespace GameDev2D
 {
-	EventDispatcher::EventDispatcher() : EventHandler()
+	//The fewest empty slots a bucket needs before it's compacted, small buckets aren't worth compacting
+	const unsigned int EVENT_DISPATCHER_MIN_EMPTY_SLOTS = 16;
+
+	EventDispatcher::EventDispatcher() : EventHandler(),
+        m_DispatchDepth(0)
     {
     
 	}
@@ -17,24 +23,50 @@ namespace GameDev2D
     
     void EventDispatcher::RemoveAllHandlers()
     {
-		m_HandlerEntries.clear();
+        //While dispatching the buckets are only emptied, the dispatch loop is still indexing into them
+        if (m_DispatchDepth > 0)
+        {
+            for (unsigned int i = 0; i < m_Buckets.size(); i++)
+            {
+                HandlerBucket& bucket = m_Buckets[i];
+                std::fill(bucket.handlers.begin(), bucket.handlers.end(), nullptr);
+                bucket.emptySlots = (unsigned int)bucket.handlers.size();
+                m_PendingCompactions.push_back(i);
+            }
+        }
+        else
+        {
+            m_Buckets.clear();
+        }
+
+		m_Slots.clear();
+        m_PendingAdds.clear();
+
+        #if VALIDATE_EVENT_HANDLERS
+        ValidateHandlers();
+        #endif
 	}
     
     void EventDispatcher::RemoveAllHandlersForListener(EventHandler* aHandler)
     {
-		std::vector<std::pair<EventHandler*, unsigned int>>::iterator iter = m_HandlerEntries.begin();
-		while (iter != m_HandlerEntries.end())
+        //Cancel the handler's pending adds
+        for (unsigned int i = 0; i < m_PendingAdds.size(); )
         {
-			if((*iter).first == aHandler)
+            if (m_PendingAdds[i].handler == aHandler)
             {
-				iter = m_HandlerEntries.erase(iter);
-			}
+                m_PendingAdds.erase(m_PendingAdds.begin() + i);
+            }
             else
             {
-				++iter;						
-			}
-		}
-		
+                i++;
+            }
+        }
+
+        //Remove the handler from every bucket it's in
+        for (unsigned int i = 0; i < m_Buckets.size(); i++)
+        {
+            RemoveEventListener(aHandler, i);
+        }
 	}
     
     void EventDispatcher::AddEventListener(EventHandler* aHandler, unsigned int aEventCode)
@@ -42,31 +74,59 @@ namespace GameDev2D
         //If you hit this assert, the event handler pointer you passed in was null
         assert(aHandler != nullptr);
         
-        //Cycle through and check to make sure we haven't added the same handler for the event code already
-        #if DEBUG
-        for(unsigned int i = 0; i < m_HandlerEntries.size(); i++)
+        //Safety check the handler pointer
+        if(aHandler == nullptr)
         {
-            bool exists = m_HandlerEntries.at(i).first == aHandler && m_HandlerEntries.at(i).second == aEventCode;
-            assert(exists == false);
+            return;
         }
-        #endif
-        
-        //Safety check the handler pointer, and add it to the handler entries
-        if(aHandler != nullptr)
+
+        //Check to make sure we haven't added the same handler for the event code already
+        HandlerKey key = { aHandler, aEventCode };
+        bool exists = m_Slots.find(key) != m_Slots.end() || std::find(m_PendingAdds.begin(), m_PendingAdds.end(), key) != m_PendingAdds.end();
+        assert(exists == false);
+        if (exists == true)
+        {
+            return;
+        }
+
+        //A handler that is added while dispatching is added once the outermost dispatch is done,
+        //so it doesn't receive the event that is being dispatched
+        if (m_DispatchDepth > 0)
         {
-            m_HandlerEntries.push_back(std::make_pair(aHandler, aEventCode));
+            m_PendingAdds.push_back(key);
+            return;
         }
+
+        AddSlot(key);
+
+        #if VALIDATE_EVENT_HANDLERS
+        ValidateHandlers();
+        #endif
 	}
 
 	void EventDispatcher::RemoveEventListener(EventHandler* aHandler, unsigned int aEventCode)
     {
-		for(unsigned int i = 0; i < m_HandlerEntries.size(); i++)
+        HandlerKey key = { aHandler, aEventCode };
+
+        //A handler that was added while dispatching might not have been added yet
+        std::vector<HandlerKey>::iterator pending = std::find(m_PendingAdds.begin(), m_PendingAdds.end(), key);
+        if (pending != m_PendingAdds.end())
         {
-			if(m_HandlerEntries.at(i).second == aEventCode && m_HandlerEntries.at(i).first == aHandler)
-            {
-				m_HandlerEntries.erase(m_HandlerEntries.begin()+i);
-			}
-		}
+            m_PendingAdds.erase(pending);
+            return;
+        }
+
+        //The handler's slot is emptied right away, even while dispatching, so that a handler
+        //that is removed (and possibly deleted) by an earlier handler is never called
+        std::unordered_map<HandlerKey, unsigned int, HandlerKeyHash>::iterator iter = m_Slots.find(key);
+        if (iter != m_Slots.end())
+        {
+            RemoveSlot(key, iter->second);
+
+            #if VALIDATE_EVENT_HANDLERS
+            ValidateHandlers();
+            #endif
+        }
 	}
 	
     void EventDispatcher::DispatchEvent(Event& aEvent)
@@ -74,17 +134,168 @@ namespace GameDev2D
         //Set the event's dispatcher and event code
         aEvent.SetDispatcher(this);
 
-        //Log the event that is about to be dispatched
-        aEvent.LogEvent();
+        //Log the event that is about to be dispatched, unless no logging is enabled at all
+        if (Log::IsEnabled(Log::Verbosity_All) == true)
+        {
+            aEvent.LogEvent();
+        }
+
+        //Only the handlers listening for the event code are visited
+        unsigned int eventCode = aEvent.GetEventCode();
+        if (eventCode >= m_Buckets.size())
+        {
+            return;
+        }
 
-        //Cycle through the event entries and handle the event's that match the event code
-        for (unsigned int i = 0; i < m_HandlerEntries.size(); i++)
+        //While dispatching, adding handlers is deferred and removing a handler only empties its slot, so the bucket
+        //doesn't change size under the loop. Handlers can dispatch events of their own, only the outermost dispatch
+        //applies the deferred changes
+        m_DispatchDepth++;
+        for (unsigned int i = 0; i < m_Buckets[eventCode].handlers.size(); i++)
         {
-            if (m_HandlerEntries.at(i).second == aEvent.GetEventCode())
+            EventHandler* handler = m_Buckets[eventCode].handlers[i];
+            if (handler != nullptr)
             {
                 //Lastly call the event handler to handle the event
-                m_HandlerEntries.at(i).first->HandleEvent(&aEvent);
+                handler->HandleEvent(&aEvent);
+            }
+        }
+        m_DispatchDepth--;
+
+        if (m_DispatchDepth == 0)
+        {
+            //Only a dispatch that changed the handlers is validated, the handlers can't change otherwise
+            bool hasChanged = ApplyPendingChanges();
+            Compact(eventCode);
+
+            #if VALIDATE_EVENT_HANDLERS
+            if (hasChanged == true)
+            {
+                ValidateHandlers();
             }
+            #else
+            (void)hasChanged;
+            #endif
         }
     }
+
+    bool EventDispatcher::IsDispatching() const
+    {
+        return m_DispatchDepth > 0;
+    }
+
+    void EventDispatcher::ValidateHandlers() const
+    {
+        //Every slot MUST refer to a handler in its bucket, and every handler in a bucket MUST have a slot
+        unsigned int handlerCount = 0;
+        for (unsigned int i = 0; i < m_Buckets.size(); i++)
+        {
+            const HandlerBucket& bucket = m_Buckets[i];
+            unsigned int emptySlots = 0;
+            for (unsigned int j = 0; j < bucket.handlers.size(); j++)
+            {
+                if (bucket.handlers[j] == nullptr)
+                {
+                    emptySlots++;
+                    continue;
+                }
+
+                HandlerKey key = { bucket.handlers[j], i };
+                assert(m_Slots.count(key) == 1 && m_Slots.find(key)->second == j);
+                handlerCount++;
+            }
+
+            assert(emptySlots == bucket.emptySlots);
+        }
+
+        assert(handlerCount == m_Slots.size());
+
+        //Changes are only deferred while dispatching
+        assert(m_DispatchDepth > 0 || (m_PendingAdds.empty() == true && m_PendingCompactions.empty() == true));
+    }
+
+    void EventDispatcher::AddSlot(HandlerKey aKey)
+    {
+        //Add the handler to the end of its event code's bucket
+        if (aKey.eventCode >= m_Buckets.size())
+        {
+            m_Buckets.resize(aKey.eventCode + 1);
+        }
+
+        std::vector<EventHandler*>& handlers = m_Buckets[aKey.eventCode].handlers;
+        m_Slots[aKey] = (unsigned int)handlers.size();
+        handlers.push_back(aKey.handler);
+    }
+
+    void EventDispatcher::RemoveSlot(HandlerKey aKey, unsigned int aSlot)
+    {
+        HandlerBucket& bucket = m_Buckets[aKey.eventCode];
+        bucket.handlers[aSlot] = nullptr;
+        bucket.emptySlots++;
+        m_Slots.erase(aKey);
+
+        if (m_DispatchDepth > 0)
+        {
+            m_PendingCompactions.push_back(aKey.eventCode);
+        }
+        else
+        {
+            Compact(aKey.eventCode);
+        }
+    }
+
+    bool EventDispatcher::ApplyPendingChanges()
+    {
+        bool hasChanges = m_PendingAdds.empty() == false || m_PendingCompactions.empty() == false;
+
+        //Add the handlers that were added while dispatching, in the order they were added. Applying
+        //the changes can't dispatch events, so nothing can be deferred while they're being applied
+        for (unsigned int i = 0; i < m_PendingAdds.size(); i++)
+        {
+            AddSlot(m_PendingAdds[i]);
+        }
+        m_PendingAdds.clear();
+
+        //Compact the buckets that had handlers removed while dispatching
+        for (unsigned int i = 0; i < m_PendingCompactions.size(); i++)
+        {
+            if (m_PendingCompactions[i] < m_Buckets.size())
+            {
+                Compact(m_PendingCompactions[i]);
+            }
+        }
+        m_PendingCompactions.clear();
+
+        return hasChanges;
+    }
+
+    void EventDispatcher::Compact(unsigned int aEventCode)
+    {
+        //The bucket is compacted once at least half of it is empty, so the cost of compacting is spread across the removals
+        HandlerBucket& bucket = m_Buckets[aEventCode];
+        if (m_DispatchDepth > 0 || bucket.emptySlots < EVENT_DISPATCHER_MIN_EMPTY_SLOTS || bucket.emptySlots * 2 < bucket.handlers.size())
+        {
+            return;
+        }
+
+        //Slide the handlers down over the empty slots, keeping their order, and update their slots
+        std::vector<EventHandler*>& handlers = bucket.handlers;
+        unsigned int count = 0;
+        for (unsigned int i = 0; i < handlers.size(); i++)
+        {
+            if (handlers[i] != nullptr)
+            {
+                if (count != i)
+                {
+                    HandlerKey key = { handlers[i], aEventCode };
+                    m_Slots[key] = count;
+                    handlers[count] = handlers[i];
+                }
+                count++;
+            }
+        }
+
+        handlers.resize(count);
+        bucket.emptySlots = 0;
+    }
 }
\ No newline at end of file
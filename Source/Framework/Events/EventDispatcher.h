@@ -2,6 +2,7 @@
 #define __GameDev2D__EventDispatcher__
 
 #include "EventHandler.h"
+#include <unordered_map>
 #include <vector>
 
 
@@ -13,6 +14,10 @@ namespace GameDev2D
     //The EventDispatcher can be inherited from to handle dispatching of events to listeners. It handles
     //the adding and removing of listener for the inheriting class. Simple call the DispatchEvent()
     //method and it will send the Event to any EventHandlers that are listening for the event.
+    //Handlers are kept in a bucket per event code, so dispatching an event only visits the handlers
+    //listening for its event code, in the order they were added. Adding and removing a handler is O(1).
+    //Handlers can safely add and remove handlers while an event is being dispatched: a removed handler
+    //isn't called again, an added handler receives the events dispatched after the outermost dispatch
 	class EventDispatcher : public EventHandler
     {
     public:
@@ -35,10 +40,58 @@ namespace GameDev2D
         
         //Removes all the handlers from the dispatcher.
         void RemoveAllHandlers();
+
+        //Returns wether an event is being dispatched
+        bool IsDispatching() const;
+
+        //Asserts that the handlers and their slots are consistent, it is O(handlers). When VALIDATE_EVENT_HANDLERS is
+        //enabled the handlers are validated after every change, including the changes deferred by a dispatch
+        void ValidateHandlers() const;
         
     protected:
-        //Member variable
-		std::vector<std::pair<EventHandler*, unsigned int>> m_HandlerEntries;
+        //The handlers listening for an event code. A removed handler leaves an empty slot behind, so that removing
+        //a handler doesn't reorder the handlers, the empty slots are compacted away once there are enough of them
+        struct HandlerBucket
+        {
+            HandlerBucket() : emptySlots(0) {}
+
+            std::vector<EventHandler*> handlers;
+            unsigned int emptySlots;
+        };
+
+        //Identifies a handler's slot in a bucket
+        struct HandlerKey
+        {
+            bool operator==(const HandlerKey& other) const { return handler == other.handler && eventCode == other.eventCode; }
+
+            EventHandler* handler;
+            unsigned int eventCode;
+        };
+
+        struct HandlerKeyHash
+        {
+            size_t operator()(const HandlerKey& key) const { return std::hash<EventHandler*>()(key.handler) ^ ((size_t)key.eventCode * 0x9e3779b9); }
+        };
+
+        //Adds a handler to the end of its bucket
+        void AddSlot(HandlerKey key);
+
+        //Empties a handler's slot
+        void RemoveSlot(HandlerKey key, unsigned int slot);
+
+        //Applies the changes that were deferred while dispatching, called once the outermost dispatch is done.
+        //Returns wether there were any changes to apply
+        bool ApplyPendingChanges();
+
+        //Removes a bucket's empty slots once at least half of its slots are empty, does nothing while dispatching
+        void Compact(unsigned int eventCode);
+
+        //Member variables
+        std::vector<HandlerBucket> m_Buckets;                                       //Indexed by event code
+        std::unordered_map<HandlerKey, unsigned int, HandlerKeyHash> m_Slots;       //Each handler's slot in its bucket
+        std::vector<HandlerKey> m_PendingAdds;                                      //Handlers added while dispatching
+        std::vector<unsigned int> m_PendingCompactions;                             //Buckets that had handlers removed while dispatching
+        unsigned int m_DispatchDepth;
 	};
 }
 
@@ -17,6 +17,9 @@ namespace GameDev2D
     
     void FullscreenEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Application, "[FullscreenEvent] Fullscreen: %s", m_IsFullscreen == true ? "true" : "false");
+        if (Log::IsEnabled(Log::Verbosity_Application) == true)
+        {
+            Log::Message(Log::Verbosity_Application, "[FullscreenEvent] Fullscreen: %s", m_IsFullscreen == true ? "true" : "false");
+        }
     }
 }
\ No newline at end of file
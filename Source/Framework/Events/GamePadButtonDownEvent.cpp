@@ -23,6 +23,9 @@ namespace GameDev2D
 
     void GamePadButtonDownEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_GamePad, "[GamePadButtonDownEvent] Controller on port: %u, button: %s pressed", m_GamePad->GetPort() + 1, GamePad::ButtonToString(m_Button).c_str());
+        if (Log::IsEnabled(Log::Verbosity_Input_GamePad) == true)
+        {
+            Log::Message(Log::Verbosity_Input_GamePad, "[GamePadButtonDownEvent] Controller on port: %u, button: %s pressed", m_GamePad->GetPort() + 1, GamePad::ButtonToString(m_Button).c_str());
+        }
     }
 }
\ No newline at end of file
@@ -29,6 +29,9 @@ namespace GameDev2D
 
     void GamePadButtonUpEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_GamePad, "[GamePadButtonUpEvent] Controller on port: %u, button: %s released after %f seconds", m_GamePad->GetPort() + 1, GamePad::ButtonToString(m_Button).c_str(), m_Duration);
+        if (Log::IsEnabled(Log::Verbosity_Input_GamePad) == true)
+        {
+            Log::Message(Log::Verbosity_Input_GamePad, "[GamePadButtonUpEvent] Controller on port: %u, button: %s released after %f seconds", m_GamePad->GetPort() + 1, GamePad::ButtonToString(m_Button).c_str(), m_Duration);
+        }
     }
 }
\ No newline at end of file
@@ -17,6 +17,9 @@ namespace GameDev2D
 
     void GamePadDisconnectedEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_GamePad, "[GamePadDisconnectedEvent] Controller on port: %u disonnected", m_GamePad->GetPort() + 1);
+        if (Log::IsEnabled(Log::Verbosity_Input_GamePad) == true)
+        {
+            Log::Message(Log::Verbosity_Input_GamePad, "[GamePadDisconnectedEvent] Controller on port: %u disonnected", m_GamePad->GetPort() + 1);
+        }
     }
 }
\ No newline at end of file
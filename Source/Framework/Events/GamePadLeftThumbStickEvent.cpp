@@ -23,6 +23,9 @@ namespace GameDev2D
 
     void GamePadLeftThumbStickEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_GamePad, "[GamePadLeftThumbStickEvent] Controller on port: %u, left thumb stick: (%f, %f)", m_GamePad->GetPort() + 1, m_Value.x, m_Value.y);
+        if (Log::IsEnabled(Log::Verbosity_Input_GamePad) == true)
+        {
+            Log::Message(Log::Verbosity_Input_GamePad, "[GamePadLeftThumbStickEvent] Controller on port: %u, left thumb stick: (%f, %f)", m_GamePad->GetPort() + 1, m_Value.x, m_Value.y);
+        }
     }
 }
\ No newline at end of file
@@ -23,6 +23,9 @@ namespace GameDev2D
 
     void GamePadLeftTriggerEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_GamePad, "[GamePadLeftTriggerEvent] Controller on port: %u, left trigger: %f", m_GamePad->GetPort() + 1, m_Value);
+        if (Log::IsEnabled(Log::Verbosity_Input_GamePad) == true)
+        {
+            Log::Message(Log::Verbosity_Input_GamePad, "[GamePadLeftTriggerEvent] Controller on port: %u, left trigger: %f", m_GamePad->GetPort() + 1, m_Value);
+        }
     }
 }
\ No newline at end of file
@@ -23,6 +23,9 @@ namespace GameDev2D
 
     void GamePadRightTriggerEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_GamePad, "[GamePadRightTriggerEvent] Controller on port: %u, right trigger: %f", m_GamePad->GetPort() + 1, m_Value);
+        if (Log::IsEnabled(Log::Verbosity_Input_GamePad) == true)
+        {
+            Log::Message(Log::Verbosity_Input_GamePad, "[GamePadRightTriggerEvent] Controller on port: %u, right trigger: %f", m_GamePad->GetPort() + 1, m_Value);
+        }
     }
 }
\ No newline at end of file
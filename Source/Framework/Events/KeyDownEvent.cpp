@@ -17,6 +17,9 @@ namespace GameDev2D
 
     void KeyDownEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_Keyboard, "[KeyDownEvent] Key down: 0x%02x - %s", m_Key, Keyboard::KeyToString(m_Key).c_str());
+        if (Log::IsEnabled(Log::Verbosity_Input_Keyboard) == true)
+        {
+            Log::Message(Log::Verbosity_Input_Keyboard, "[KeyDownEvent] Key down: 0x%02x - %s", m_Key, Keyboard::KeyToString(m_Key).c_str());
+        }
     }
 }
\ No newline at end of file
@@ -24,6 +24,9 @@ namespace GameDev2D
 
     void KeyRepeatEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_Keyboard, "[KeyRepeatEvent] Key repeat: 0x%02x - %s - Duration: %f seconds", m_Key, Keyboard::KeyToString(m_Key).c_str(), m_Duration);
+        if (Log::IsEnabled(Log::Verbosity_Input_Keyboard) == true)
+        {
+            Log::Message(Log::Verbosity_Input_Keyboard, "[KeyRepeatEvent] Key repeat: 0x%02x - %s - Duration: %f seconds", m_Key, Keyboard::KeyToString(m_Key).c_str(), m_Duration);
+        }
     }
 }
\ No newline at end of file
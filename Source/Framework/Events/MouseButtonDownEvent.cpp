@@ -23,6 +23,9 @@ namespace GameDev2D
     
     void MouseButtonDownEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_Mouse, "[MouseButtonDownEvent] %s mouse button down at position (%f, %f)", Mouse::ButtonToString(m_Button), m_Position.x, m_Position.y);
+        if (Log::IsEnabled(Log::Verbosity_Input_Mouse) == true)
+        {
+            Log::Message(Log::Verbosity_Input_Mouse, "[MouseButtonDownEvent] %s mouse button down at position (%f, %f)", Mouse::ButtonToString(m_Button).c_str(), m_Position.x, m_Position.y);
+        }
     }
 }
\ No newline at end of file
@@ -29,6 +29,9 @@ namespace GameDev2D
 
     void MouseButtonUpEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_Mouse, "[MouseButtonUpEvent] %s mouse button up after being held for %f, at position (%f, %f)", Mouse::ButtonToString(m_Button), m_Duration, m_Position.x, m_Position.y);
+        if (Log::IsEnabled(Log::Verbosity_Input_Mouse) == true)
+        {
+            Log::Message(Log::Verbosity_Input_Mouse, "[MouseButtonUpEvent] %s mouse button up after being held for %f, at position (%f, %f)", Mouse::ButtonToString(m_Button).c_str(), m_Duration, m_Position.x, m_Position.y);
+        }
     }
 }
\ No newline at end of file
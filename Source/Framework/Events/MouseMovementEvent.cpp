@@ -29,6 +29,9 @@ namespace GameDev2D
     
     void MouseMovementEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_Mouse, "[MouseMovementEvent] Mouse moved to position: (%f, %f) - Delta movement: (%f, %f)", m_Position.x, m_Position.y, m_DeltaPosition.x, m_DeltaPosition.y);
+        if (Log::IsEnabled(Log::Verbosity_Input_Mouse) == true)
+        {
+            Log::Message(Log::Verbosity_Input_Mouse, "[MouseMovementEvent] Mouse moved to position: (%f, %f) - Delta movement: (%f, %f)", m_Position.x, m_Position.y, m_DeltaPosition.x, m_DeltaPosition.y);
+        }
     }
 }
\ No newline at end of file
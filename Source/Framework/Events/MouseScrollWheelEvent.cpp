@@ -17,6 +17,9 @@ namespace GameDev2D
     
     void MouseScrollWheelEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Input_Mouse, "[MouseScrollWheelEvent] Delta: %f", m_Delta);
+        if (Log::IsEnabled(Log::Verbosity_Input_Mouse) == true)
+        {
+            Log::Message(Log::Verbosity_Input_Mouse, "[MouseScrollWheelEvent] Delta: %f", m_Delta);
+        }
     }
 }
\ No newline at end of file
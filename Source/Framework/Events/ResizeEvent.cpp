@@ -16,6 +16,9 @@ namespace GameDev2D
     
     void ResizeEvent::LogEvent()
     {
-        Log::Message(Log::Verbosity_Application, "[ResizeEvent] Size: (%f, %f)", m_Size.x, m_Size.y);
+        if (Log::IsEnabled(Log::Verbosity_Application) == true)
+        {
+            Log::Message(Log::Verbosity_Application, "[ResizeEvent] Size: (%f, %f)", m_Size.x, m_Size.y);
+        }
     }
 }
\ No newline at end of file
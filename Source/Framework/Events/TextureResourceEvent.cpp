@@ -18,6 +18,9 @@ namespace GameDev2D
 
 	void TextureResourceEvent::LogEvent()
 	{
-		Log::Message(Log::Verbosity_Resources, "[TextureResourceEvent] %s - %u", EventCodeToString(GetEventCode()).c_str(), m_Texture->GetId());
+		if (Log::IsEnabled(Log::Verbosity_Resources) == true)
+		{
+			Log::Message(Log::Verbosity_Resources, "[TextureResourceEvent] %s - %u", EventCodeToString(GetEventCode()).c_str(), m_Texture->GetId());
+		}
 	}
 }
\ No newline at end of file
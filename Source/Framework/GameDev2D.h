@@ -2,9 +2,13 @@
 
 //Include statements
 #include "GameDev2D_Settings.h"
+#include "Animation/AnimationClip.h"
+#include "Animation/AnimationPlayhead.h"
 #include "Animation/Animator.h"
 #include "Animation/Easing.h"
 #include "Audio/Audio.h"
+#include "Audio/AudioMixer.h"
+#include "Audio/AudioSink.h"
 #include "Audio/AudioTypes.h"
 #include "Core/Drawable.h"
 #include "Core/Transformable.h"
@@ -49,6 +53,9 @@
 #include "Input/Mouse.h"
 #include "IO/File.h"
 #include "Math/Math.h"
+#include "Math/AffineTransform.h"
+#include "Math/TransformKernels.h"
+#include "Math/Vector2Kernels.h"
 #include "Math/Matrix.h"
 #include "Math/Rotation.h"
 #include "Math/Vector2.h"
@@ -57,6 +64,8 @@
 #include "Services/Graphics/Graphics.h"
 #include "Services/InputManager/InputManager.h"
 #include "Services/ResourceManager/ResourceManager.h"
+#include "Services/TweenManager/TweenManager.h"
+#include "Services/SpatialIndex/SpatialIndex.h"
 #include "Utils/Png/Png.h"
 #include "Utils/Text/Text.h"
 #include "Utils/Wave/Wave.h"
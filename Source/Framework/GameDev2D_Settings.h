@@ -15,11 +15,22 @@
 #define DEBUG_DRAW_SPRITE_RECT 0
 #define DEBUG_DRAW_SPRITE_AABB 0
 #define DEBUG_DRAW_MOUSE_POSITION 0
+#define DEBUG_DRAW_CULLED_COUNT 0
+#define DEBUG_DRAW_DRAWN_COUNT 0
 #define OPENGL_MAJOR_VERSION 3
 #define OPENGL_MINOR_VERSION 1
+#define GRAPHICS_CULLING_ENABLED true //Drawables outside the active Camera's view aren't drawn
 #define THROW_EXCEPTION_ON_ERROR 1
 #define LOG_TO_FILE 0
 #define LOG_FILE "/Log.txt"
 #define LOG_VERBOSITY_MASK Log::Verbosity_Debug | Log::Verbosity_Application
 #define CHECK_FOR_MEMORY_LEAKS 0
+#define VALIDATE_EVENT_HANDLERS 0 //Validates an EventDispatcher's handlers after every change to them, O(handlers), for debugging the dispatcher
+#define RESOURCE_MEMORY_BUDGET 67108864 //In bytes, unreferenced resources are purged once they exceed it
+#define AUDIO_SAMPLE_RATE 44100
+#define AUDIO_MAX_VOICES 256
+#define AUDIO_HEADLESS 0 //Mixes the audio without outputting it
+#define AUDIO_OUTPUT_FILE "" //When set, the mixed audio is written to this wave file instead of the audio device
+#define AUDIO_STREAMING_THRESHOLD 1048576 //In bytes, wave files larger than this are streamed from disk
+#define AUDIO_STREAM_BUFFER_BYTES 65536 //In bytes, the size of each of a stream's 3 buffers
 //#define RANDOM_SEED 1729
\ No newline at end of file
@@ -56,9 +56,15 @@ namespace GameDev2D
     }
 
     void AnimatedSprite::AddFrame(const std::string& aAtlasKey)
+    {
+        //Resolve the atlas key once, if it isn't in the atlas the default texture is used for the frame
+        AddFrame(GetAtlasIndex(aAtlasKey));
+    }
+
+    void AnimatedSprite::AddFrame(unsigned int aAtlasIndex)
     {
         //Add the frame
-        m_Frames.push_back(aAtlasKey);
+        m_Frames.push_back(aAtlasIndex);
 
         //If that was the first frame, set the frame index
         if (m_Frames.size() == 1)
@@ -94,8 +100,8 @@ namespace GameDev2D
             //Set the elapsed time
             m_ElapsedTime = (double)m_FrameIndex * (1.0 / m_FrameSpeed);
 
-            //Set the SpriteAtlas's frame to the current frame using the atlas key
-            UseFrame(m_Frames.at(m_FrameIndex));
+            //Set the SpriteAtlas's frame to the current frame using the atlas index
+            UseFrame(m_Frames[m_FrameIndex]);
         }
     }
 
@@ -22,9 +22,13 @@ namespace GameDev2D
         void HandleEvent(Event* event);
             
         //Adds a frame to the back of the animation, the frame must be in
-        //the spriteAtlas that was loaded on creation
+        //the spriteAtlas that was loaded on creation. The atlas key is resolved
+        //to an atlas index once, stepping through the frames doesn't use the key
         void AddFrame(const std::string& atlasKey);
 
+        //Adds a frame to the back of the animation by its atlas index, see GetAtlasIndex()
+        void AddFrame(unsigned int atlasIndex);
+
 		//Removes all the frames in the animation
 		void RemoveAllFrames();
 
@@ -56,8 +60,8 @@ namespace GameDev2D
 		void Resume();
 
     private:
-        //Member variables
-        std::vector<std::string> m_Frames;
+        //Member variables, the frames are atlas indices into the shared AtlasMap
+        std::vector<unsigned int> m_Frames;
         unsigned int m_FrameIndex;
         float m_FrameSpeed;
         double m_ElapsedTime;
@@ -8,8 +8,16 @@
 
 namespace GameDev2D
 {
+    unsigned int Camera::s_ViewMatrixUpdateCount = 0;
+
     Camera::Camera() : Transformable(),
         m_ProjectionMatrix(Matrix::Identity()),
+        m_ViewMatrix(Matrix::Identity()),
+        m_ViewProjectionMatrix(Matrix::Identity()),
+        m_IsViewMatrixDirty(true),
+        m_IsViewProjectionMatrixDirty(true),
+        m_VisibleRect(),
+        m_IsVisibleRectDirty(true),
         m_Viewport(0, 0),
 		m_IsViewportResizeable(true),
         m_ClipNear(-1.0f),
@@ -26,6 +34,12 @@ namespace GameDev2D
 
 	Camera::Camera(const Camera& aCamera) : Transformable(aCamera),
 		m_ProjectionMatrix(aCamera.m_ProjectionMatrix),
+		m_ViewMatrix(aCamera.m_ViewMatrix),
+		m_ViewProjectionMatrix(aCamera.m_ViewProjectionMatrix),
+		m_IsViewMatrixDirty(aCamera.m_IsViewMatrixDirty),
+		m_IsViewProjectionMatrixDirty(aCamera.m_IsViewProjectionMatrixDirty),
+		m_VisibleRect(aCamera.m_VisibleRect),
+		m_IsVisibleRectDirty(aCamera.m_IsVisibleRectDirty),
 		m_Viewport(aCamera.m_Viewport),
 		m_IsViewportResizeable(aCamera.m_IsViewportResizeable),
 		m_ClipNear(aCamera.m_ClipNear),
@@ -42,6 +56,12 @@ namespace GameDev2D
 
 	Camera::Camera(const Viewport& aViewport, bool aIsViewportResizeable) : Transformable(),
 		m_ProjectionMatrix(Matrix::Identity()),
+		m_ViewMatrix(Matrix::Identity()),
+		m_ViewProjectionMatrix(Matrix::Identity()),
+		m_IsViewMatrixDirty(true),
+		m_IsViewProjectionMatrixDirty(true),
+		m_VisibleRect(),
+		m_IsVisibleRectDirty(true),
 		m_Viewport(0, 0),
 		m_IsViewportResizeable(aIsViewportResizeable),
 		m_ClipNear(-1.0f),
@@ -63,16 +83,78 @@ namespace GameDev2D
 		Services::GetApplication()->RemoveEventListener(this, UPDATE_EVENT);
 	}
 
-    Matrix Camera::GetProjectionMatrix()
+    const Matrix& Camera::GetProjectionMatrix()
     {
         return m_ProjectionMatrix;
     }
     
-    Matrix Camera::GetViewMatrix()
+    const Matrix& Camera::GetViewMatrix()
+    {
+        if (m_IsViewMatrixDirty == true)
+        {
+            //The Camera's transform is a 2D affine transform, so its inverse is found analytically instead of with a 4x4 inverse
+            AffineTransform view = GetAffineTransform().GetInverse();
+            m_ViewMatrix = Matrix(view);
+            m_ViewMatrix.SetTranslation(view.GetTranslation() + m_ShakeOffset);
+            m_IsViewMatrixDirty = false;
+            m_IsViewProjectionMatrixDirty = true;
+            s_ViewMatrixUpdateCount++;
+        }
+
+        return m_ViewMatrix;
+    }
+
+    const Matrix& Camera::GetViewProjectionMatrix()
+    {
+        //Getting the view matrix first updates it if it's dirty, which dirties the view-projection matrix
+        const Matrix& viewMatrix = GetViewMatrix();
+        if (m_IsViewProjectionMatrixDirty == true)
+        {
+            m_ViewProjectionMatrix = m_ProjectionMatrix * viewMatrix;
+            m_IsViewProjectionMatrixDirty = false;
+        }
+
+        return m_ViewProjectionMatrix;
+    }
+
+    const Rect& Camera::GetVisibleRect()
     {
-        Matrix viewMatrix = GetTransformMatrix().GetInverse();
-        viewMatrix.SetTranslation(viewMatrix.GetTranslation() + m_ShakeOffset);
-        return viewMatrix;
+        if (m_IsVisibleRectDirty == true)
+        {
+            //The projection's view is centered on the origin, the view's corners (less the shake offset) are
+            //moved into the world by the Camera's transform, which is the inverse of the view matrix
+            AffineTransform transform = GetAffineTransform();
+            float halfWidth = static_cast<float>(m_Viewport.width) * 0.5f;
+            float halfHeight = static_cast<float>(m_Viewport.height) * 0.5f;
+            Vector2 corners[4] =
+            {
+                transform * (Vector2(-halfWidth, -halfHeight) - m_ShakeOffset),
+                transform * (Vector2(halfWidth, -halfHeight) - m_ShakeOffset),
+                transform * (Vector2(halfWidth, halfHeight) - m_ShakeOffset),
+                transform * (Vector2(-halfWidth, halfHeight) - m_ShakeOffset)
+            };
+
+            //The visible rect is the bounding box of the corners
+            Vector2 minimum = corners[0];
+            Vector2 maximum = corners[0];
+            for (unsigned int i = 1; i < 4; i++)
+            {
+                minimum.x = fminf(minimum.x, corners[i].x);
+                minimum.y = fminf(minimum.y, corners[i].y);
+                maximum.x = fmaxf(maximum.x, corners[i].x);
+                maximum.y = fmaxf(maximum.y, corners[i].y);
+            }
+
+            m_VisibleRect = Rect(minimum, maximum - minimum);
+            m_IsVisibleRectDirty = false;
+        }
+
+        return m_VisibleRect;
+    }
+
+    unsigned int Camera::GetViewMatrixUpdateCount()
+    {
+        return s_ViewMatrixUpdateCount;
     }
 
     void Camera::SetViewport(const Viewport& aViewport)
@@ -96,6 +178,9 @@ namespace GameDev2D
     {
         m_ClipNear = aNear;
         m_ClipFar = aFar;
+
+        //The depth clip is part of the projection matrix
+        ResetProjectionMatrix();
     }
 
     float Camera::GetNearClip()
@@ -114,7 +199,7 @@ namespace GameDev2D
         m_ShakeMagnitude = aMagnitude;
         m_ShakeDuration = aDuration;
         m_ShakeTimer = 0.0;
-        m_ShakeOffset = Vector2(0.0f, 0.0f);
+        SetShakeOffset(Vector2(0.0f, 0.0f));
     }
 
 	void Camera::HandleEvent(Event* aEvent)
@@ -143,14 +228,14 @@ namespace GameDev2D
 					m_ShakeEnabled = false;
 					m_ShakeTimer = 0.0;
 					m_ShakeDuration = 0.0;
-					m_ShakeOffset = Vector2(0.0f, 0.0f);
+					SetShakeOffset(Vector2(0.0f, 0.0f));
 				}
 				else
 				{
 					//Calculate the shake offset based on the progress and magnitude
 					float progress = (float)(m_ShakeTimer / m_ShakeDuration);
 					float magnitude = (float)(m_ShakeMagnitude * (1.0 - (progress * progress)));
-					m_ShakeOffset = Vector2(RandomShake(magnitude), RandomShake(magnitude));
+					SetShakeOffset(Vector2(RandomShake(magnitude), RandomShake(magnitude)));
 				}
 			}
 		}
@@ -164,6 +249,25 @@ namespace GameDev2D
 
         //Setup the orthographic projection
         m_ProjectionMatrix = Matrix::Orthographic(-width / 2.0f, width / 2.0f, -height / 2.0f, height / 2.0f, m_ClipNear, m_ClipFar);
+        m_IsViewProjectionMatrixDirty = true;
+        m_IsVisibleRectDirty = true;
+    }
+
+    void Camera::TransformMatrixIsDirty()
+    {
+        Transformable::TransformMatrixIsDirty();
+        m_IsViewMatrixDirty = true;
+        m_IsVisibleRectDirty = true;
+    }
+
+    void Camera::SetShakeOffset(const Vector2& aShakeOffset)
+    {
+        if (m_ShakeOffset != aShakeOffset)
+        {
+            m_ShakeOffset = aShakeOffset;
+            m_IsViewMatrixDirty = true;
+            m_IsVisibleRectDirty = true;
+        }
     }
     
     float Camera::RandomShake(float aMagnitude)
@@ -17,9 +17,19 @@ namespace GameDev2D
 		Camera(const Viewport& aViewport, bool isViewportResizeable = true);
 		~Camera();
 
-        //Getter methods for the projection and view matrices
-        Matrix GetProjectionMatrix();
-        Matrix GetViewMatrix();
+        //Getter methods for the projection, view and view-projection matrices. The matrices are cached, the view matrix
+        //is only recalculated when the Camera's transform or shake offset changes, the projection matrix when the viewport
+        //OR depth clip changes. The references are valid as long as the Camera is
+        const Matrix& GetProjectionMatrix();
+        const Matrix& GetViewMatrix();
+        const Matrix& GetViewProjectionMatrix();
+
+        //Returns the region of the world that is inside the Camera's view, in world space. When the Camera is rotated it's the
+        //bounding box of the rotated view. The region is cached, it's only recalculated when the Camera's view changes
+        const Rect& GetVisibleRect();
+
+        //Returns the number of times a view matrix has been recalculated, by every Camera, since the application started
+        static unsigned int GetViewMatrixUpdateCount();
 
         //Set's the width and height of the camera's view
         void SetViewport(const Viewport& viewport);
@@ -44,11 +54,23 @@ namespace GameDev2D
         //Resets the projection matrix
         void ResetProjectionMatrix();
 
+        //Override from Transformable, invalidates the cached view matrix and visible rect
+        void TransformMatrixIsDirty();
+
+        //Sets the shake offset, invalidating the cached view matrix and visible rect if it changed
+        void SetShakeOffset(const Vector2& shakeOffset);
+
         //Conveniance method to randomize a camera shake
         float RandomShake(float magnitude);
 
         //Member variables
         Matrix m_ProjectionMatrix;
+        Matrix m_ViewMatrix;
+        Matrix m_ViewProjectionMatrix;
+        bool m_IsViewMatrixDirty;
+        bool m_IsViewProjectionMatrixDirty;
+        Rect m_VisibleRect;
+        bool m_IsVisibleRectDirty;
         Viewport m_Viewport;
 		bool m_IsViewportResizeable;
         float m_ClipNear;
@@ -60,6 +82,9 @@ namespace GameDev2D
         double m_ShakeDuration;
         double m_ShakeTimer;
         Vector2 m_ShakeOffset;
+
+        //The number of view matrix updates
+        static unsigned int s_ViewMatrixUpdateCount;
     };
 }
 
@@ -9,10 +9,11 @@ namespace GameDev2D
         m_VertexData(nullptr),
         m_RenderMode(RenderMode_Points),
         m_Size(0.0f, 0.0f),
+        m_Origin(0.0f, 0.0f),
         m_EnableBlending(false)
     {
         //Initialize the Shader
-        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY);
+        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_ID);
 
         //Initialize the Polygon's VertexBuffer VertexDescriptor, it describes
         //how the individual vertices will be stored in the VertexBuffer
@@ -51,6 +52,12 @@ namespace GameDev2D
         //Cache the graphics service
         Graphics* graphics = Services::GetGraphics();
 
+        //Is the Polygon outside the Camera's view?
+        if (graphics->Cull(this) == true)
+        {
+            return;
+        }
+
         //Bind the vertex array object
         m_VertexData->PrepareForDraw();
 
@@ -231,8 +238,28 @@ namespace GameDev2D
             top = fmaxf(top, m_Vertices.at(i).GetPosition().y);
         }
 
-        //Set the width and height
+        //Set the width and height, and the bottom left corner they're measured from
         m_Size.x = right - left;
         m_Size.y = top - bottom;
+        m_Origin = Vector2(left, bottom);
+
+        //The size changed, the edges need to be re-calculated
+        EdgesAreDirty();
+    }
+
+    Vector2 Polygon::GetEdgesAnchor()
+    {
+        //The shader offsets the vertices by the anchor times the size, the bounds of the offset vertices start at
+        //the bottom left corner, less that offset. As an anchor, the corner is a fraction of the size
+        Vector2 anchor = GetAnchor();
+        if (m_Size.x > 0.0f)
+        {
+            anchor.x -= m_Origin.x / m_Size.x;
+        }
+        if (m_Size.y > 0.0f)
+        {
+            anchor.y -= m_Origin.y / m_Size.y;
+        }
+        return anchor;
     }
 }
\ No newline at end of file
@@ -55,6 +55,9 @@ namespace GameDev2D
         //Used to calculate the size of the Polygon
         void CalculateSize();
 
+        //Overridden from Drawable, the vertices can be left of OR below the origin, the edges are offset to bound them
+        Vector2 GetEdgesAnchor();
+
         //Struct to hold Vertex data
         struct Vertex
         {
@@ -81,6 +84,7 @@ namespace GameDev2D
         std::vector<Vertex> m_Vertices;
         RenderMode m_RenderMode;
         Vector2 m_Size;
+        Vector2 m_Origin;
         bool m_EnableBlending;
     };
 }
@@ -1,7 +1,6 @@
 #include "Sprite.h"
 #include "Shader.h"
 #include "../Core/Drawable.h"
-#include "../Events/TextureResourceEvent.h"
 #include "../Services/Services.h"
 #include "../Services/Graphics/Graphics.h"
 #include "../Windows/Application.h"
@@ -13,12 +12,13 @@ namespace GameDev2D
 {
     Sprite::Sprite(Texture* aTexture) : Drawable(),
         m_Texture(aTexture),
+        m_TextureHandle(),
         m_VertexData(nullptr),
         m_Frame(Rect()),
         m_Wrap(Wrap())
     {
         //Initialize the Shader
-        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_TEXTURE_SHADER_KEY);
+        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_TEXTURE_SHADER_ID);
 
         //Initialize the Sprite's vertex DataBufferDescriptor, it describes
         //how the individual 'elements' will be stored in the DataBuffer
@@ -39,18 +39,19 @@ namespace GameDev2D
         //Set the wrap mode
         SetWrap(Wrap(Wrap::ClampToEdge, Wrap::ClampToEdge));
 
-		//Listener for the texture resource event, in case the texture the sprite is drawing is accidently unloaded, IT HAS HAPPENED!
-		Services::GetResourceManager()->AddEventListener(this, TEXTURE_RESOURCE_UNLOADED);
+		//Acquire a handle to the texture (if the ResourceManager owns it), it keeps the texture loaded for as long as the Sprite uses it
+		m_TextureHandle = Services::GetResourceManager()->AcquireTexture(m_Texture);
     }
     
 	Sprite::Sprite(const std::string& aFilename) : Drawable(),
 		m_Texture(nullptr),
+		m_TextureHandle(),
 		m_VertexData(nullptr),
 		m_Frame(Rect()),
 		m_Wrap(Wrap())
 	{
 		//Initialize the Shader
-		m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_TEXTURE_SHADER_KEY);
+		m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_TEXTURE_SHADER_ID);
 
 		//Initialize the Sprite's vertex DataBufferDescriptor, it describes
 		//how the individual 'elements' will be stored in the DataBuffer
@@ -65,14 +66,16 @@ namespace GameDev2D
 		m_VertexData = new VertexData();
 		m_VertexData->CreateBuffer(descriptor);
 
-		//Initialize the texture
-		SetTexture(Services::GetResourceManager()->GetTexture(aFilename));
+		//The texture isn't loaded by the Sprite, if it isn't loaded the default texture is used. If it is loaded, acquire
+		//a handle to it, the handle keeps the texture loaded for as long as the Sprite uses it
+		m_Texture = Services::GetResourceManager()->GetTexture(aFilename);
+		m_TextureHandle = Services::GetResourceManager()->AcquireTexture(m_Texture);
+
+		//Set the Texture's frame
+		SetFrame(Rect(Vector2(0.0f, 0.0f), Vector2((float)m_Texture->GetWidth(), (float)m_Texture->GetHeight())));
 
 		//Set the wrap mode
 		SetWrap(Wrap(Wrap::ClampToEdge, Wrap::ClampToEdge));
-
-		//Listener for the texture resource event, in case the texture the sprite is drawing is accidently unloaded, IT HAS HAPPENED!
-		Services::GetResourceManager()->AddEventListener(this, TEXTURE_RESOURCE_UNLOADED);
 	}
 
     Sprite::~Sprite()
@@ -85,7 +88,8 @@ namespace GameDev2D
 
         m_Texture = nullptr;
 
-		Services::GetResourceManager()->RemoveEventListener(this, TEXTURE_RESOURCE_UNLOADED);
+		//Release the texture handle, the texture will be unloaded once it's no longer used
+		Services::GetResourceManager()->ReleaseTexture(m_TextureHandle);
     }
     
     void Sprite::Draw()
@@ -96,6 +100,12 @@ namespace GameDev2D
             //Cache the Graphics pointer
             Graphics* graphics = Services::GetGraphics();
 
+            //Is the Sprite outside the Camera's view?
+            if (graphics->Cull(this) == true)
+            {
+                return;
+            }
+
             //Bind the vertex array object
             m_VertexData->PrepareForDraw();
  
@@ -213,6 +223,9 @@ namespace GameDev2D
 		m_Frame.origin = aFrame.origin;
 		m_Frame.size = aFrame.size;
 
+		//The size changed, the edges need to be re-calculated
+		EdgesAreDirty();
+
 		if (m_Texture != nullptr && m_VertexData != nullptr)
 		{
 			//Build the UV Coordinates
@@ -239,6 +252,11 @@ namespace GameDev2D
 
     void Sprite::SetTexture(Texture* aTexture)
     {
+		//Acquire the new texture's handle before releasing the old one, in case it's the same texture
+		TextureHandle textureHandle = Services::GetResourceManager()->AcquireTexture(aTexture);
+		Services::GetResourceManager()->ReleaseTexture(m_TextureHandle);
+		m_TextureHandle = textureHandle;
+
 		//Set the Texture's
         m_Texture = aTexture;
 
@@ -250,17 +268,4 @@ namespace GameDev2D
     {
         return m_Texture;
     }
-
-	void Sprite::HandleEvent(Event* aEvent)
-	{
-		if (aEvent->GetEventCode() == TEXTURE_RESOURCE_UNLOADED)
-		{
-			TextureResourceEvent* textureResourceEvent = (TextureResourceEvent*)aEvent;
-			if (textureResourceEvent->GetTexture() == m_Texture)
-			{
-				//The texture the Sprite is using was just unloaded, replace it with the default texture
-				SetTexture(Services::GetResourceManager()->GetDefaultTexture());
-			}
-		}
-	}
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Texture.h"
 #include "VertexData.h"
 #include "../Core/Drawable.h"
+#include "../Services/ResourceManager/ResourceHandle.h"
 
 
 namespace GameDev2D
@@ -20,12 +21,12 @@ namespace GameDev2D
     class Sprite : public Drawable, public EventHandler
     {
     public:
-        //Creates a Sprite using a reference to an already loaded Texture object, 
-        //you are responsible for unloading the Texture
+        //Creates a Sprite using a reference to an already loaded Texture object, the Sprite
+        //holds a handle to the Texture so it won't be purged while the Sprite uses it
         Sprite(Texture* texture);
 
-		//Creates a Sprite using a reference to an already loaded Texture object, 
-		//you are responsible for unloading the Texture
+		//Creates a Sprite for the Texture with the filename, the Texture is NOT loaded by the Sprite, if it isn't loaded
+		//the default Texture is used. The Sprite holds a handle to a loaded Texture so it won't be purged while the Sprite uses it
 		Sprite(const std::string& filename);
 
         //Destructor
@@ -59,13 +60,11 @@ namespace GameDev2D
 
         //Called from the TextureManager
         Texture* GetTexture() const;
-
-		//Handle system events
-		void HandleEvent(Event* event);
         
     protected:
         //Member variables
         Texture* m_Texture;
+        TextureHandle m_TextureHandle;
         VertexData* m_VertexData;
         Rect m_Frame;
         Wrap m_Wrap;
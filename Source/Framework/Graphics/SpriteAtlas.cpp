@@ -1,33 +1,45 @@
 #include "SpriteAtlas.h"
 #include "../Services/Services.h"
 #include "../Windows/Application.h"
-#include <json.h>
-#include <fstream>
+#include "../Debug/Log.h"
+#include "../Utils/JsonStream/JsonStream.h"
 #include <assert.h>
 
 
 namespace GameDev2D
 {
-    SpriteAtlas::SpriteAtlas(const std::string& aFilename) : Sprite(Services::GetResourceManager()->GetTexture(aFilename)),
+    SpriteAtlas::SpriteAtlas(const std::string& aFilename) : Sprite(aFilename),
+        m_AtlasHandle(),
         m_Filename(aFilename)
     {
-        //Load the atlas frames
-        Services::GetResourceManager()->LoadAtlas(m_Filename);
+        //Acquire a handle to the atlas frames, loading them if they aren't loaded
+        m_AtlasHandle = Services::GetResourceManager()->AcquireAtlas(m_Filename);
     }
 
     SpriteAtlas::~SpriteAtlas()
     {
-
+        //Release the atlas frames, they will be unloaded once they're no longer used
+        Services::GetResourceManager()->ReleaseAtlas(m_AtlasHandle);
 	}
 
     void SpriteAtlas::UseFrame(const std::string& aAtlasKey)
     {
-        //Get the atlas frame for the key
-        Rect frame = Services::GetResourceManager()->GetAtlasFrame(m_Filename, aAtlasKey);
+        UseFrame(GetAtlasIndex(aAtlasKey));
+    }
+
+    void SpriteAtlas::UseFrame(unsigned int aAtlasIndex)
+    {
+        //Get the atlas frame for the index
+        Rect frame;
+        AtlasMap* atlasMap = Services::GetResourceManager()->GetAtlas(m_AtlasHandle);
+        if (atlasMap != nullptr && aAtlasIndex < atlasMap->Count())
+        {
+            frame = atlasMap->GetFrame(aAtlasIndex);
+        }
         
 		if (frame.origin == Vector2::Zero && frame.size == Vector2::Zero)
 		{
-			//
+			//The frame doesn't exist, use the default texture so that it's obvious
 			SetTexture(Services::GetResourceManager()->GetDefaultTexture());
 		}
 		else
@@ -37,63 +49,213 @@ namespace GameDev2D
 		}
     }
 
-    bool SpriteAtlas::Unpack(const std::string& aPath, AtlasMap** aAtlasMap)
+    unsigned int SpriteAtlas::GetAtlasIndex(const std::string& aAtlasKey)
     {
-        //Does the json file exist, if it doesn't the assert below will be hit
-        bool doesExist = Services::GetApplication()->DoesFileExistAtPath(aPath);
-        assert(doesExist == true);
+        AtlasMap* atlasMap = Services::GetResourceManager()->GetAtlas(m_AtlasHandle);
+        return atlasMap != nullptr ? atlasMap->GetIndex(aAtlasKey) : ATLAS_MAP_INVALID_INDEX;
+    }
 
-        //If the json files exists, load the atlas frae
-        if (doesExist == true)
+    //Streams the frames of an atlas .json file directly into an AtlasMap, without building a Json::Value tree
+    class AtlasStreamHandler : public JsonStreamHandler
+    {
+    public:
+        AtlasStreamHandler(AtlasMap* aAtlasMap) :
+            m_AtlasMap(aAtlasMap),
+            m_Depth(0),
+            m_InFrames(false),
+            m_InFrameRect(false),
+            m_RootKey(Key_Unknown),
+            m_FrameKey(Key_Unknown),
+            m_RectKey(Key_Unknown),
+            m_HasFilename(false)
+        {
+        }
+
+        void OnObjectBegin()
         {
-            //Open the input stream
-            std::ifstream inputStream;
-            inputStream.open(aPath.c_str(), std::ifstream::in);
-
-            //Parse the json data
-            Json::Value root;
-            Json::Reader reader;
-            if (reader.parse(inputStream, root, false) == true)
+            m_Depth++;
+
+            //A new frame entry in the frames array
+            if (m_InFrames == true && m_Depth == 3)
             {
-				//
-				*aAtlasMap = new AtlasMap();
+                m_Filename.clear();
+                m_HasFilename = false;
+                m_Frame = Rect();
+                m_FrameKey = Key_Unknown;
+            }
+            //The source frame of the frame entry
+            else if (m_InFrames == true && m_Depth == 4 && m_FrameKey == Key_Frame)
+            {
+                m_InFrameRect = true;
+            }
+        }
 
-                //Get the frames
-                const Json::Value frames = root["frames"];
+        void OnObjectEnd()
+        {
+            if (m_InFrames == true && m_Depth == 4)
+            {
+                m_InFrameRect = false;
+            }
+            else if (m_InFrames == true && m_Depth == 3 && m_HasFilename == true)
+            {
+                m_AtlasMap->Create(m_Filename, m_Frame);
+            }
 
-                //Cycle through the frames and parse the frame data
-                for (unsigned int index = 0; index < frames.size(); ++index)
-                {
-                    //Safety check the filename
-                    if (frames[index]["filename"].isString() == true)
-                    {
-                        //Get the atlas key
-                        std::string atlasKey = std::string(frames[index]["filename"].asString());
+            m_Depth--;
+        }
 
-                        //Load the source frame
-                        Json::Value frameValue = frames[index]["frame"];
+        void OnArrayBegin()
+        {
+            m_Depth++;
+            if (m_Depth == 2 && m_RootKey == Key_Frames)
+            {
+                m_InFrames = true;
+            }
+        }
 
-                        //Get the values from the frame
-                        unsigned int x = frameValue["x"].asInt();
-                        unsigned int y = frameValue["y"].asInt();
-                        unsigned int width = frameValue["w"].asInt();
-                        unsigned int height = frameValue["h"].asInt();
+        void OnArrayEnd()
+        {
+            if (m_Depth == 2)
+            {
+                m_InFrames = false;
+            }
+            m_Depth--;
+        }
 
-                        //Return the source frame
-						Rect frame = Rect(Vector2((float)x, (float)y), Vector2((float)width, (float)height));
-						(*aAtlasMap)->Create(atlasKey, frame);
+        void OnKey(const char* aKey, unsigned int aLength)
+        {
+            if (m_Depth == 1)
+            {
+                m_RootKey = JsonStream::KeyEquals(aKey, aLength, "frames") ? Key_Frames : Key_Unknown;
+            }
+            else if (m_InFrames == true && m_Depth == 3)
+            {
+                if (JsonStream::KeyEquals(aKey, aLength, "filename") == true)
+                {
+                    m_FrameKey = Key_Filename;
+                }
+                else if (JsonStream::KeyEquals(aKey, aLength, "frame") == true)
+                {
+                    m_FrameKey = Key_Frame;
+                }
+                else
+                {
+                    m_FrameKey = Key_Unknown;
+                }
+            }
+            else if (m_InFrameRect == true && m_Depth == 4)
+            {
+                m_RectKey = Key_Unknown;
+                if (aLength == 1)
+                {
+                    switch (aKey[0])
+                    {
+                    case 'x': m_RectKey = Key_X; break;
+                    case 'y': m_RectKey = Key_Y; break;
+                    case 'w': m_RectKey = Key_Width; break;
+                    case 'h': m_RectKey = Key_Height; break;
+                    default: break;
                     }
                 }
             }
+        }
+
+        void OnString(const char* aValue, unsigned int aLength)
+        {
+            if (m_InFrames == true && m_Depth == 3 && m_FrameKey == Key_Filename)
+            {
+                m_Filename.assign(aValue, aLength);
+                m_HasFilename = true;
+            }
+        }
+
+        void OnNumber(double aValue)
+        {
+            if (m_InFrameRect == true && m_Depth == 4)
+            {
+                float value = (float)(int)aValue;
+                switch (m_RectKey)
+                {
+                case Key_X: m_Frame.origin.x = value; break;
+                case Key_Y: m_Frame.origin.y = value; break;
+                case Key_Width: m_Frame.size.x = value; break;
+                case Key_Height: m_Frame.size.y = value; break;
+                default: break;
+                }
+            }
+        }
+
+    private:
+        enum Key
+        {
+            Key_Unknown = 0,
+            Key_Frames,
+            Key_Filename,
+            Key_Frame,
+            Key_X,
+            Key_Y,
+            Key_Width,
+            Key_Height
+        };
+
+        //Member variables
+        AtlasMap* m_AtlasMap;
+        std::string m_Filename;
+        Rect m_Frame;
+        unsigned int m_Depth;
+        bool m_InFrames;
+        bool m_InFrameRect;
+        Key m_RootKey;
+        Key m_FrameKey;
+        Key m_RectKey;
+        bool m_HasFilename;
+    };
+
+    bool SpriteAtlas::Unpack(const std::string& aPath, AtlasMap** aAtlasMap)
+    {
+        //Does the json file exist, if it doesn't the assert below will be hit
+        bool doesExist = Services::GetApplication()->DoesFileExistAtPath(aPath);
+        assert(doesExist == true);
+
+        //If the json files exists, load the atlas frames
+        if (doesExist == true)
+        {
+            //Stream the json data straight into the AtlasMap
+            AtlasMap* atlasMap = new AtlasMap();
+            AtlasStreamHandler handler(atlasMap);
+            if (JsonStream::ParseFile(aPath, &handler) == true)
+            {
+                *aAtlasMap = atlasMap;
+
+                //The unpack was successful
+                return true;
+            }
 
-            //Close the input stream
-            inputStream.close();
+            //The json data was malformed
+            delete atlasMap;
+            Log::Error(false, Log::Verbosity_Resources, "[SpriteAtlas] Failed to parse the atlas: %s", aPath.c_str());
+        }
+
+        //The unpack failed
+        return false;
+    }
+
+    bool SpriteAtlas::Unpack(const std::string& aPath, const char* aBuffer, unsigned int aLength, AtlasMap** aAtlasMap)
+    {
+        //Stream the json data straight into the AtlasMap
+        AtlasMap* atlasMap = new AtlasMap();
+        AtlasStreamHandler handler(atlasMap);
+        if (JsonStream::Parse(aBuffer, aLength, &handler) == true)
+        {
+            *aAtlasMap = atlasMap;
 
             //The unpack was successful
             return true;
         }
 
-        //The unpack failed
+        //The json data was malformed
+        delete atlasMap;
+        Log::Error(false, Log::Verbosity_Resources, "[SpriteAtlas] Failed to parse the atlas: %s", aPath.c_str());
         return false;
     }
 }
\ No newline at end of file
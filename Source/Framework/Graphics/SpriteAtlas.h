@@ -2,12 +2,19 @@
 #define __GameDev2D__SpriteAtlas__
 
 #include "Sprite.h"
-#include <unordered_map>
+#include <map>
 #include <string>
+#include <vector>
 
 
 namespace GameDev2D
 {
+	//The index returned for an atlas key that isn't in the AtlasMap
+	const unsigned int ATLAS_MAP_INVALID_INDEX = 0xffffffff;
+
+	//An AtlasMap is the immutable frame table for an atlas .json file, it is owned by the ResourceManager and shared by
+	//every SpriteAtlas that uses the atlas. Frames are stored in an array, an atlas key is resolved to a frame index once
+	//(with GetIndex) and the frame can then be fetched by index without any string work
 	class AtlasMap
 	{
 	public:
@@ -16,18 +23,66 @@ namespace GameDev2D
 
 		}
 
+		//Adds a frame for the atlas key, if the key already has a frame it is replaced. Used while the atlas is being loaded
 		void Create(const std::string& aKey, const Rect& aFrame)
 		{
-			m_AtlasMap[aKey] = aFrame;
+			std::map<std::string, unsigned int>::const_iterator iterator = m_Indices.find(aKey);
+			if (iterator != m_Indices.end())
+			{
+				m_Frames[iterator->second] = aFrame;
+				return;
+			}
+
+			m_Indices[aKey] = (unsigned int)m_Frames.size();
+			m_Keys.push_back(aKey);
+			m_Frames.push_back(aFrame);
+		}
+
+		//Returns the frame for the atlas key, if the key isn't in the atlas an empty Rect is returned
+		Rect Get(const std::string& aKey) const
+		{
+			unsigned int index = GetIndex(aKey);
+			return index != ATLAS_MAP_INVALID_INDEX ? m_Frames[index] : Rect();
+		}
+
+		//Returns the index of the frame for the atlas key, or ATLAS_MAP_INVALID_INDEX if the key isn't in the atlas
+		unsigned int GetIndex(const std::string& aKey) const
+		{
+			std::map<std::string, unsigned int>::const_iterator iterator = m_Indices.find(aKey);
+			return iterator != m_Indices.end() ? iterator->second : ATLAS_MAP_INVALID_INDEX;
+		}
+
+		//Returns the frame and the atlas key at an index, the index MUST be less than Count()
+		const Rect& GetFrame(unsigned int aIndex) const
+		{
+			return m_Frames[aIndex];
+		}
+
+		const std::string& GetKey(unsigned int aIndex) const
+		{
+			return m_Keys[aIndex];
+		}
+
+		unsigned int Count() const
+		{
+			return (unsigned int)m_Frames.size();
 		}
 
-		Rect Get(const std::string& aKey)
+		//Returns the size, in bytes, of the frame table
+		unsigned int GetSize() const
 		{
-			return m_AtlasMap[aKey];
+			unsigned int size = (unsigned int)(m_Frames.size() * (sizeof(Rect) + sizeof(std::string) * 2 + sizeof(unsigned int)));
+			for (unsigned int i = 0; i < m_Keys.size(); i++)
+			{
+				size += (unsigned int)m_Keys[i].length() * 2;
+			}
+			return size;
 		}
 
 	private:
-		std::map<std::string, Rect> m_AtlasMap;
+		std::vector<Rect> m_Frames;
+		std::vector<std::string> m_Keys;
+		std::map<std::string, unsigned int> m_Indices;
 	};
 
     class SpriteAtlas : public Sprite
@@ -39,15 +94,24 @@ namespace GameDev2D
         SpriteAtlas(const std::string& filename);
         ~SpriteAtlas();
 
-        //Sets the specific frame for the atlasKey
+        //Sets the specific frame for the atlasKey, the key is looked up in the atlas every call
         void UseFrame(const std::string& atlasKey);
 
+        //Sets the specific frame for an atlas index, see GetAtlasIndex(), no lookup is needed
+        void UseFrame(unsigned int atlasIndex);
+
+        //Returns the atlas index for the atlasKey, or ATLAS_MAP_INVALID_INDEX if the key isn't in the atlas
+        unsigned int GetAtlasIndex(const std::string& atlasKey);
+
         //Unpacks the Atlas .json file
         static bool Unpack(const std::string& path, AtlasMap** atlasMap);
 
+        //Unpacks the Atlas .json data that was read from the file at the path, the buffer MUST be null terminated at buffer[length]
+        static bool Unpack(const std::string& path, const char* buffer, unsigned int length, AtlasMap** atlasMap);
+
     private:
-        //Member variables
-        std::map<std::string, Rect> m_AtlasMap;
+        //Member variables, the atlas frames are shared through the handle, they aren't copied
+        AtlasHandle m_AtlasHandle;
         std::string m_Filename;
     };
 }
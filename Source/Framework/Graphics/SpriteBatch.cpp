@@ -15,7 +15,7 @@ namespace GameDev2D
         m_Lock(false)
     {
         //Initialize the Shader
-        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEBATCH_SHADER_KEY);
+        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEBATCH_SHADER_ID);
 
         //Create the VertexData object
         m_VertexData = new VertexData();
@@ -171,20 +171,105 @@ namespace GameDev2D
         Vector2 vertexD = aTransformation * offsetD;
 
         //Add the vertices to the vertex buffer
-        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { vertexA.x, vertexA.y, u1, v2, aColor.r, aColor.g, aColor.b, aColor.a });  //x,y+h,u1,v2
-        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { vertexB.x, vertexB.y, u2, v2, aColor.r, aColor.g, aColor.b, aColor.a });  //x+w,y+h,u2,v2
-        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { vertexC.x, vertexC.y, u2, v1, aColor.r, aColor.g, aColor.b, aColor.a });  //x+w,y,u2,v1
-        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { vertexD.x, vertexD.y, u1, v1, aColor.r, aColor.g, aColor.b, aColor.a });  //x,y,u1,v1
+        const float vertices[4][8] =
+        {
+            { vertexA.x, vertexA.y, u1, v2, aColor.r, aColor.g, aColor.b, aColor.a },  //x,y+h,u1,v2
+            { vertexB.x, vertexB.y, u2, v2, aColor.r, aColor.g, aColor.b, aColor.a },  //x+w,y+h,u2,v2
+            { vertexC.x, vertexC.y, u2, v1, aColor.r, aColor.g, aColor.b, aColor.a },  //x+w,y,u2,v1
+            { vertexD.x, vertexD.y, u1, v1, aColor.r, aColor.g, aColor.b, aColor.a }   //x,y,u1,v1
+        };
+
+        for (unsigned int i = 0; i < 4; i++)
+        {
+            m_VertexData->GetVertexBuffer()->AddVertex(vertices[i]);
+        }
     }
 
     void SpriteBatch::Draw(Sprite* aSprite)
     {
-        if (aSprite != nullptr)
+        //Is the Sprite outside the Camera's view?
+        if (aSprite != nullptr && Services::GetGraphics()->Cull(aSprite) == false)
         {
             Draw(aSprite->GetTexture(), aSprite->GetTransformMatrix(), aSprite->GetColor(), aSprite->GetAnchor(), aSprite->GetFrame());
         }
     }
 
+    void SpriteBatch::Draw(Texture* aTexture, const TransformArrays& aTransforms, unsigned int aCount, Color aColor)
+    {
+        //Safety check the texture
+        if (aTexture == nullptr)
+        {
+            return;
+        }
+
+        //If the Texture is different, Flush the vertex data
+        if (m_CurrentTexture != aTexture)
+        {
+            Flush();
+            m_CurrentTexture = aTexture;
+        }
+
+        //The UVs of each corner, in the same order as the corners
+        const float uvs[4][2] = { { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f } };
+
+        VertexBuffer* vertexBuffer = m_VertexData->GetVertexBuffer();
+        Vector2 corners[SPRITE_BATCH_COUNT];
+        unsigned int index = 0;
+
+        //The quads outside the Camera's view are culled before they're added to the vertex buffer
+        Graphics* graphics = Services::GetGraphics();
+        bool isCullingEnabled = graphics->IsCullingEnabled();
+        unsigned int culled = 0;
+
+        while (index < aCount)
+        {
+            //If the SpriteBatch can't hold another quad, flush the data
+            if (vertexBuffer->GetCount() + 4 > SPRITE_BATCH_COUNT)
+            {
+                Flush();
+
+                //The vertex data wasn't flushed, the shader failed to validate
+                if (vertexBuffer->GetCount() + 4 > SPRITE_BATCH_COUNT)
+                {
+                    return;
+                }
+            }
+
+            //Calculate the corners of as many quads as the SpriteBatch can hold
+            unsigned int quads = (SPRITE_BATCH_COUNT - vertexBuffer->GetCount()) / 4;
+            quads = quads < aCount - index ? quads : aCount - index;
+            TransformKernels::CalculateQuads(aTransforms.Offset(index), corners, quads);
+
+            //Add the vertices of the quads that are inside the Camera's view to the vertex buffer
+            for (unsigned int i = 0; i < quads; i++)
+            {
+                const Vector2* quad = &corners[i * 4];
+                if (isCullingEnabled == true)
+                {
+                    float left = fminf(fminf(quad[0].x, quad[1].x), fminf(quad[2].x, quad[3].x));
+                    float right = fmaxf(fmaxf(quad[0].x, quad[1].x), fmaxf(quad[2].x, quad[3].x));
+                    float bottom = fminf(fminf(quad[0].y, quad[1].y), fminf(quad[2].y, quad[3].y));
+                    float top = fmaxf(fmaxf(quad[0].y, quad[1].y), fmaxf(quad[2].y, quad[3].y));
+                    if (graphics->IsVisible(left, right, bottom, top) == false)
+                    {
+                        culled++;
+                        continue;
+                    }
+                }
+
+                for (unsigned int j = 0; j < 4; j++)
+                {
+                    const float vertex[8] = { quad[j].x, quad[j].y, uvs[j][0], uvs[j][1], aColor.r, aColor.g, aColor.b, aColor.a };
+                    vertexBuffer->AddVertex(vertex);
+                }
+            }
+
+            index += quads;
+        }
+
+        graphics->AddCullingStats(culled, aCount - culled);
+    }
+
     void SpriteBatch::Flush()
     {
         //We can't draw anything if there isn't any vertices OR a texture set
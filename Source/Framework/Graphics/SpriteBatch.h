@@ -6,6 +6,7 @@
 #include "VertexData.h"
 #include "../Math/Vector2.h"
 #include "../Math/Matrix.h"
+#include "../Math/TransformKernels.h"
 
 
 namespace GameDev2D
@@ -44,9 +45,14 @@ namespace GameDev2D
         void Draw(Texture* texture, const Matrix& transformation, Color color, Vector2 anchor);
         void Draw(Texture* texture, const Matrix& transformation, Color color, Vector2 anchor, Rect sourceFrame);
 
-        //Draws a Sprite
+        //Draws a Sprite, unless it's culled by the Graphics service
         void Draw(Sprite* sprite);
 
+        //Draws the whole texture once for each of the transforms, the transforms' width and height are the size of each quad.
+        //The quads' corners are calculated in one pass by the TransformKernels, use it to draw a large number of sprites.
+        //When culling is enabled, the quads outside the active Camera's view aren't added to the batch
+        void Draw(Texture* texture, const TransformArrays& transforms, unsigned int count, Color color = Color::WhiteColor());
+
     private:
         //Draws the contents of the SpriteBatch
         void Flush();
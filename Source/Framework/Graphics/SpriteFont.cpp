@@ -3,22 +3,23 @@
 #include "SpriteBatch.h"
 #include "../Services/Services.h"
 #include "../Utils/Text/Text.h"
-#include <json.h>
-#include <fstream>
+#include "../Debug/Log.h"
+#include "../Utils/JsonStream/JsonStream.h"
 
 
 namespace GameDev2D
 {
-	SpriteFont::SpriteFont(const std::string& aFilename) : Sprite(aFilename),
-		m_FontData(Services::GetResourceManager()->GetFontData(aFilename)),
+	SpriteFont::SpriteFont(const std::string& aFilename) : Sprite(Services::GetResourceManager()->GetDefaultTexture()),
+		m_FontHandle(Services::GetResourceManager()->AcquireFont(aFilename)),
+		m_FontData(Services::GetResourceManager()->GetFontData(m_FontHandle)),
 		m_SpriteBatch(nullptr),
 		m_Text(),
 		m_Size(Vector2(0.0f, 0.0f)),
 		m_Justification(JustifyLeft),
 		m_CharacterSpacing(0.0f)
 	{
-		//Set the texture for the Font
-		SetTexture(Services::GetResourceManager()->GetFontData(aFilename)->texture);
+		//Set the texture for the Font, the font handle keeps it loaded
+		SetTexture(m_FontData->texture);
 
 		//Create the SpriteBatch
 		m_SpriteBatch = new SpriteBatch();
@@ -31,6 +32,9 @@ namespace GameDev2D
 			delete m_SpriteBatch;
 			m_SpriteBatch = nullptr;
 		}
+
+		//Release the font, it will be unloaded once it's no longer used
+		Services::GetResourceManager()->ReleaseFont(m_FontHandle);
 	}
 
 	void SpriteFont::Draw()
@@ -41,6 +45,13 @@ namespace GameDev2D
 			return;
 		}
 
+		//Is the label outside the Camera's view? The characters' own angle, scale and anchor aren't part of the
+		//label's edges, characters that are moved outside of the label's edges can be culled with the label
+		if (Services::GetGraphics()->Cull(this) == true)
+		{
+			return;
+		}
+
 		//calculate the baseline and origin for the label
 		unsigned int baseline = m_FontData->lineHeight - m_FontData->baseline;
 		unsigned int numberOfLines = Text::NumberOfLines(m_Text);
@@ -104,12 +115,12 @@ namespace GameDev2D
 			charPosition.x += m_FontData->glyphData[m_Text.at(i)].bearingX;
 			charPosition.y += m_FontData->glyphData[m_Text.at(i)].bearingY - characterRect.size.y;
 
-			//Calculate the Matrix
-			Matrix parent = GetTransformMatrix();
-			Matrix matrix = Matrix::Make(charPosition, m_CharacterData.at(i).angle, m_CharacterData.at(i).scale);
+			//Calculate the Matrix, the character's transform is composed with the parent's as a 2D affine transform
+			AffineTransform parent = GetAffineTransform();
+			AffineTransform transform = AffineTransform::Make(charPosition, m_CharacterData.at(i).angle, m_CharacterData.at(i).scale);
 
 			//Draw each character
-			m_SpriteBatch->Draw(GetTexture(), parent * matrix, m_CharacterData.at(i).color, m_CharacterData.at(i).anchor, characterRect);
+			m_SpriteBatch->Draw(GetTexture(), Matrix(parent * transform), m_CharacterData.at(i).color, m_CharacterData.at(i).anchor, characterRect);
 
 			//Increment the position
 			position.x += m_FontData->glyphData[m_Text.at(i)].advanceX + GetCharacterSpacing();
@@ -243,6 +254,9 @@ namespace GameDev2D
 
 		//Set the size
 		m_Size = maxSize;
+
+		//The size changed, the edges need to be re-calculated
+		EdgesAreDirty();
 	}
 
 	std::vector<SpriteFont::CharacterData>& SpriteFont::GetCharacterData()
@@ -250,72 +264,290 @@ namespace GameDev2D
 		return m_CharacterData;
 	}
 
-	bool SpriteFont::Unpack(const std::string& aPath, FontData** aFontData)
+	//Streams the glyphs of a font .json file directly into a FontData object, without building a Json::Value tree
+	class FontStreamHandler : public JsonStreamHandler
 	{
-		//Does the json file exist, if it doesn't the assert below will be hit
-		bool doesExist = Services::GetApplication()->DoesFileExistAtPath(aPath);
-		assert(doesExist == true);
+	public:
+		FontStreamHandler(FontData* aFontData) :
+			m_FontData(aFontData),
+			m_Depth(0),
+			m_InGlyphs(false),
+			m_InGlyphFrame(false),
+			m_RootKey(Key_Unknown),
+			m_GlyphKey(Key_Unknown),
+			m_FrameKey(Key_Unknown),
+			m_Character(0),
+			m_HasCharacter(false)
+		{
+		}
 
-		//If the json files exists, load the atlas frae
-		if (doesExist == true)
+		void OnObjectBegin()
+		{
+			m_Depth++;
+
+			//A new glyph entry in the glyphs array
+			if (m_InGlyphs == true && m_Depth == 3)
+			{
+				m_Glyph = GlyphData();
+				m_Character = 0;
+				m_HasCharacter = false;
+				m_GlyphKey = Key_Unknown;
+			}
+			//The frame of the glyph entry
+			else if (m_InGlyphs == true && m_Depth == 4 && m_GlyphKey == Key_Frame)
+			{
+				m_InGlyphFrame = true;
+			}
+		}
+
+		void OnObjectEnd()
 		{
-			//Open the input stream
-			std::ifstream inputStream;
-			inputStream.open(aPath.c_str(), std::ifstream::in);
-
-			//Parse the json data
-			Json::Value root;
-			Json::Reader reader;
-			if (reader.parse(inputStream, root, false) == true)
+			if (m_InGlyphs == true && m_Depth == 4)
+			{
+				m_InGlyphFrame = false;
+			}
+			else if (m_InGlyphs == true && m_Depth == 3 && m_HasCharacter == true)
+			{
+				GlyphData& glyphData = m_FontData->glyphData[m_Character];
+				glyphData.advanceX = m_Glyph.advanceX;
+				glyphData.bearingX = m_Glyph.bearingX;
+				glyphData.bearingY = m_Glyph.bearingY;
+				glyphData.frame = m_Glyph.frame;
+			}
+
+			m_Depth--;
+		}
+
+		void OnArrayBegin()
+		{
+			m_Depth++;
+			if (m_Depth == 2 && m_RootKey == Key_Glyphs)
+			{
+				m_InGlyphs = true;
+			}
+		}
+
+		void OnArrayEnd()
+		{
+			if (m_Depth == 2)
+			{
+				m_InGlyphs = false;
+			}
+			m_Depth--;
+		}
+
+		void OnKey(const char* aKey, unsigned int aLength)
+		{
+			if (m_Depth == 1)
+			{
+				if (JsonStream::KeyEquals(aKey, aLength, "file") == true)
+				{
+					m_RootKey = Key_File;
+				}
+				else if (JsonStream::KeyEquals(aKey, aLength, "characterSet") == true)
+				{
+					m_RootKey = Key_CharacterSet;
+				}
+				else if (JsonStream::KeyEquals(aKey, aLength, "size") == true)
+				{
+					m_RootKey = Key_Size;
+				}
+				else if (JsonStream::KeyEquals(aKey, aLength, "baseline") == true)
+				{
+					m_RootKey = Key_Baseline;
+				}
+				else if (JsonStream::KeyEquals(aKey, aLength, "lineHeight") == true)
+				{
+					m_RootKey = Key_LineHeight;
+				}
+				else if (JsonStream::KeyEquals(aKey, aLength, "glyphs") == true)
+				{
+					m_RootKey = Key_Glyphs;
+				}
+				else
+				{
+					m_RootKey = Key_Unknown;
+				}
+			}
+			else if (m_InGlyphs == true && m_Depth == 3)
+			{
+				if (JsonStream::KeyEquals(aKey, aLength, "character") == true)
+				{
+					m_GlyphKey = Key_Character;
+				}
+				else if (JsonStream::KeyEquals(aKey, aLength, "advanceX") == true)
+				{
+					m_GlyphKey = Key_AdvanceX;
+				}
+				else if (JsonStream::KeyEquals(aKey, aLength, "bearingX") == true)
+				{
+					m_GlyphKey = Key_BearingX;
+				}
+				else if (JsonStream::KeyEquals(aKey, aLength, "bearingY") == true)
+				{
+					m_GlyphKey = Key_BearingY;
+				}
+				else if (JsonStream::KeyEquals(aKey, aLength, "frame") == true)
+				{
+					m_GlyphKey = Key_Frame;
+				}
+				else
+				{
+					m_GlyphKey = Key_Unknown;
+				}
+			}
+			else if (m_InGlyphFrame == true && m_Depth == 4)
 			{
-				//Create the FontData object
-				FontData* fontData = new FontData();
-				fontData->name = root["file"].asString();
-				fontData->characterSet = root["characterSet"].asString();
-				fontData->size = root["size"].asUInt();
-				fontData->baseline = root["baseline"].asUInt();
-				fontData->lineHeight = root["lineHeight"].asUInt();
-
-				//Get the glyphs
-				const Json::Value glyphs = root["glyphs"];
-
-				//Cycle through the frames and parse the frame data
-				for (unsigned int index = 0; index < glyphs.size(); ++index)
+				m_FrameKey = Key_Unknown;
+				if (aLength == 1)
 				{
-					//Safety check the filename
-					if (glyphs[index]["character"].isString() == true)
+					switch (aKey[0])
 					{
-						//Get the character
-						std::string characterStr = std::string(glyphs[index]["character"].asString());
-						char character = characterStr.at(0);
-
-						fontData->glyphData[character].advanceX = (unsigned char)glyphs[index]["advanceX"].asInt();
-						fontData->glyphData[character].bearingX = (unsigned char)glyphs[index]["bearingX"].asInt();
-						fontData->glyphData[character].bearingY = (unsigned char)glyphs[index]["bearingY"].asInt();
-
-						//Load the frame
-						Json::Value frameValue = glyphs[index]["frame"];
-						unsigned int x = frameValue["x"].asUInt();
-						unsigned int y = frameValue["y"].asUInt();
-						unsigned int width = frameValue["w"].asUInt();
-						unsigned int height = frameValue["h"].asUInt();
-
-						//Set the frame
-						fontData->glyphData[character].frame = Rect(Vector2((float)x, (float)y), Vector2((float)width, (float)height));
+					case 'x': m_FrameKey = Key_X; break;
+					case 'y': m_FrameKey = Key_Y; break;
+					case 'w': m_FrameKey = Key_Width; break;
+					case 'h': m_FrameKey = Key_Height; break;
+					default: break;
 					}
 				}
+			}
+		}
+
+		void OnString(const char* aValue, unsigned int aLength)
+		{
+			if (m_Depth == 1)
+			{
+				if (m_RootKey == Key_File)
+				{
+					m_FontData->name.assign(aValue, aLength);
+				}
+				else if (m_RootKey == Key_CharacterSet)
+				{
+					m_FontData->characterSet.assign(aValue, aLength);
+				}
+			}
+			else if (m_InGlyphs == true && m_Depth == 3 && m_GlyphKey == Key_Character && aLength > 0)
+			{
+				m_Character = aValue[0];
+				m_HasCharacter = true;
+			}
+		}
 
+		void OnNumber(double aValue)
+		{
+			if (m_Depth == 1)
+			{
+				switch (m_RootKey)
+				{
+				case Key_Size: m_FontData->size = (unsigned int)aValue; break;
+				case Key_Baseline: m_FontData->baseline = (unsigned int)aValue; break;
+				case Key_LineHeight: m_FontData->lineHeight = (unsigned int)aValue; break;
+				default: break;
+				}
+			}
+			else if (m_InGlyphs == true && m_Depth == 3)
+			{
+				switch (m_GlyphKey)
+				{
+				case Key_AdvanceX: m_Glyph.advanceX = (unsigned char)(int)aValue; break;
+				case Key_BearingX: m_Glyph.bearingX = (unsigned char)(int)aValue; break;
+				case Key_BearingY: m_Glyph.bearingY = (unsigned char)(int)aValue; break;
+				default: break;
+				}
+			}
+			else if (m_InGlyphFrame == true && m_Depth == 4)
+			{
+				float value = (float)(unsigned int)aValue;
+				switch (m_FrameKey)
+				{
+				case Key_X: m_Glyph.frame.origin.x = value; break;
+				case Key_Y: m_Glyph.frame.origin.y = value; break;
+				case Key_Width: m_Glyph.frame.size.x = value; break;
+				case Key_Height: m_Glyph.frame.size.y = value; break;
+				default: break;
+				}
+			}
+		}
+
+	private:
+		enum Key
+		{
+			Key_Unknown = 0,
+			Key_File,
+			Key_CharacterSet,
+			Key_Size,
+			Key_Baseline,
+			Key_LineHeight,
+			Key_Glyphs,
+			Key_Character,
+			Key_AdvanceX,
+			Key_BearingX,
+			Key_BearingY,
+			Key_Frame,
+			Key_X,
+			Key_Y,
+			Key_Width,
+			Key_Height
+		};
+
+		//Member variables
+		FontData* m_FontData;
+		GlyphData m_Glyph;
+		unsigned int m_Depth;
+		bool m_InGlyphs;
+		bool m_InGlyphFrame;
+		Key m_RootKey;
+		Key m_GlyphKey;
+		Key m_FrameKey;
+		char m_Character;
+		bool m_HasCharacter;
+	};
+
+	bool SpriteFont::Unpack(const std::string& aPath, FontData** aFontData)
+	{
+		//Does the json file exist, if it doesn't the assert below will be hit
+		bool doesExist = Services::GetApplication()->DoesFileExistAtPath(aPath);
+		assert(doesExist == true);
+
+		//If the json files exists, load the font data
+		if (doesExist == true)
+		{
+			//Stream the json data straight into the FontData object
+			FontData* fontData = new FontData();
+			FontStreamHandler handler(fontData);
+			if (JsonStream::ParseFile(aPath, &handler) == true)
+			{
 				*aFontData = fontData;
+
+				//The unpack was successful
+				return true;
 			}
 
-			//Close the input stream
-			inputStream.close();
+			//The json data was malformed
+			delete fontData;
+			Log::Error(false, Log::Verbosity_Resources, "[SpriteFont] Failed to parse the font: %s", aPath.c_str());
+		}
+
+		//The unpack failed
+		return false;
+	}
+
+	bool SpriteFont::Unpack(const std::string& aPath, const char* aBuffer, unsigned int aLength, FontData** aFontData)
+	{
+		//Stream the json data straight into the FontData object
+		FontData* fontData = new FontData();
+		FontStreamHandler handler(fontData);
+		if (JsonStream::Parse(aBuffer, aLength, &handler) == true)
+		{
+			*aFontData = fontData;
 
 			//The unpack was successful
 			return true;
 		}
 
-		//The unpack failed
+		//The json data was malformed
+		delete fontData;
+		Log::Error(false, Log::Verbosity_Resources, "[SpriteFont] Failed to parse the font: %s", aPath.c_str());
 		return false;
 	}
 }
\ No newline at end of file
@@ -87,11 +87,15 @@ namespace GameDev2D
 		//Unpacks the Atlas .json file
 		static bool Unpack(const std::string& path, FontData** fontData);
 
+		//Unpacks the font .json data that was read from the file at the path, the buffer MUST be null terminated at buffer[length]
+		static bool Unpack(const std::string& path, const char* buffer, unsigned int length, FontData** fontData);
+
 	private:
 		//Conveniance method to calculate the size of the SpriteFont, based on the text
 		void CalculateSize();
 
 		//Member variables
+		FontHandle m_FontHandle;
 		FontData* m_FontData;
 		SpriteBatch* m_SpriteBatch;
 		std::string m_Text;
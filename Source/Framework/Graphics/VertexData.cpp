@@ -260,6 +260,21 @@ namespace GameDev2D
         m_IsDirty = true;
     }
 
+    void VertexBuffer::AddVertex(const float* aVertex)
+    {
+        //
+        assert(m_Count < GetCapacity());
+
+        //Add the vertex to the buffer
+        memcpy(&m_Buffer[GetCount() * GetSize()], aVertex, GetSize() * sizeof(float));
+
+        //Increment the count variable
+        m_Count++;
+
+        //Enable the dirty flag
+        m_IsDirty = true;
+    }
+
     void VertexBuffer::ClearVertices()
     {
         //Set the buffer elements to zero
@@ -83,6 +83,7 @@ namespace GameDev2D
         void UpdateBuffer();
 
         void AddVertex(const std::vector<float>& vertex);
+        void AddVertex(const float* vertex);   //The vertex MUST hold GetSize() floats
         void ClearVertices();
 
     private:
@@ -0,0 +1,108 @@
+#include "MappedFile.h"
+#include <Windows.h>
+
+
+namespace GameDev2D
+{
+    MappedFile::MappedFile() :
+        m_File(INVALID_HANDLE_VALUE),
+        m_Mapping(nullptr),
+        m_Data(nullptr),
+        m_Size(0)
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    bool MappedFile::Open(const std::string& aPath)
+    {
+        Close();
+
+        //Open the file, hinting that it will be read front to back
+        m_File = CreateFileA(aPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_File == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        //An empty file can't be mapped
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(m_File, &size) == FALSE || size.QuadPart == 0)
+        {
+            Close();
+            return false;
+        }
+
+        //Map the whole file, read only
+        m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_Mapping == nullptr)
+        {
+            Close();
+            return false;
+        }
+
+        m_Data = static_cast<const unsigned char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_Data == nullptr)
+        {
+            Close();
+            return false;
+        }
+
+        m_Size = (unsigned long long)size.QuadPart;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data != nullptr)
+        {
+            UnmapViewOfFile(m_Data);
+            m_Data = nullptr;
+        }
+
+        if (m_Mapping != nullptr)
+        {
+            CloseHandle(m_Mapping);
+            m_Mapping = nullptr;
+        }
+
+        if (m_File != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_File);
+            m_File = INVALID_HANDLE_VALUE;
+        }
+
+        m_Size = 0;
+    }
+
+    const unsigned char* MappedFile::GetData() const
+    {
+        return m_Data;
+    }
+
+    unsigned long long MappedFile::GetSize() const
+    {
+        return m_Size;
+    }
+
+    void MappedFile::Prefault() const
+    {
+        if (m_Data == nullptr)
+        {
+            return;
+        }
+
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+
+        //The reads are volatile, so that they aren't optimized away
+        const volatile unsigned char* data = m_Data;
+        for (unsigned long long offset = 0; offset < m_Size; offset += systemInfo.dwPageSize)
+        {
+            (void)data[offset];
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+
+
+namespace GameDev2D
+{
+    //The MappedFile class maps a file into memory, read only. The file's contents are paged in by the
+    //operating system as they are read, rather than copied into a buffer up front. The contents are
+    //unmapped when this MappedFile object is destroyed. A MappedFile owns its mapping, it can't be copied
+    class MappedFile
+    {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        //Maps the file at the path, returns false if the file can't be opened or is empty
+        bool Open(const std::string& path);
+
+        //Unmaps the file
+        void Close();
+
+        //Returns a pointer to the mapped contents of the file, or nullptr if no file is mapped
+        const unsigned char* GetData() const;
+
+        //Returns the size of the file, in bytes
+        unsigned long long GetSize() const;
+
+        //Reads one byte of every page of the file, so that the whole file is paged in now instead of the first time it's
+        //read. Used when the file is read on a thread that can't wait on a page fault, such as the audio thread
+        void Prefault() const;
+
+    private:
+        //Member variables
+        void* m_File;
+        void* m_Mapping;
+        const unsigned char* m_Data;
+        unsigned long long m_Size;
+    };
+}
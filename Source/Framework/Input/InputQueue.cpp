@@ -0,0 +1,61 @@
+#include "InputQueue.h"
+
+
+namespace GameDev2D
+{
+    InputQueue::InputQueue(unsigned int aReserve) :
+        m_Undelivered(0),
+        m_RawEventCount(0),
+        m_DeliveredEventCount(0)
+    {
+        m_Records.reserve(aReserve);
+    }
+
+    void InputQueue::Queue(InputType aType, unsigned int aCode, float aX, float aY, float aDeltaX, float aDeltaY)
+    {
+        m_RawEventCount++;
+
+        //A mouse movement or scroll that directly follows the same kind of mouse event is coalesced into it, the latest
+        //position is kept and the deltas are accumulated. Any other input in between prevents it, so that a key handler
+        //sees the mouse where it was when the key was pressed. An event that was already delivered can't be coalesced into
+        if ((aType == MouseMovedInput || aType == ScrollWheelInput) && m_Records.size() > m_Undelivered && m_Records.back().type == aType)
+        {
+            InputRecord& record = m_Records.back();
+            record.x = aX;
+            record.y = aY;
+            record.deltaX += aDeltaX;
+            record.deltaY += aDeltaY;
+            return;
+        }
+
+        InputRecord record = { aType, aCode, aX, aY, aDeltaX, aDeltaY };
+        m_Records.push_back(record);
+    }
+
+    bool InputQueue::DeliverNext(InputRecord& aRecord)
+    {
+        //Once every event is delivered the queue is cleared, its capacity is kept for the next frame
+        if (m_Undelivered >= m_Records.size())
+        {
+            m_DeliveredEventCount += static_cast<unsigned int>(m_Records.size());
+            m_Records.clear();
+            m_Undelivered = 0;
+            return false;
+        }
+
+        //The record is copied, delivering it can queue more input, which can grow the queue
+        aRecord = m_Records[m_Undelivered];
+        m_Undelivered++;
+        return true;
+    }
+
+    unsigned int InputQueue::GetRawEventCount() const
+    {
+        return m_RawEventCount;
+    }
+
+    unsigned int InputQueue::GetDeliveredEventCount() const
+    {
+        return m_DeliveredEventCount;
+    }
+}
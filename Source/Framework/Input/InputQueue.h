@@ -0,0 +1,62 @@
+#ifndef __GameDev2D__InputQueue__
+#define __GameDev2D__InputQueue__
+
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //The InputQueue holds the keyboard and mouse input that is received between two updates, the InputManager delivers it
+    //in one batch at the start of the next update. Consecutive mouse movements and scroll wheel changes are coalesced into
+    //one event and their deltas are accumulated. Key and button transitions are never coalesced and are delivered in order.
+    //It has no platform dependencies, the InputManager translates the records into Keyboard and Mouse calls
+    class InputQueue
+    {
+    public:
+        //The types of input that can be queued
+        enum InputType
+        {
+            KeyDownInput = 0,
+            KeyUpInput,
+            MouseDownInput,
+            MouseUpInput,
+            MouseMovedInput,
+            ScrollWheelInput
+        };
+
+        //A queued input event, the code is the key or mouse button. A scroll wheel change's delta is in deltaX
+        struct InputRecord
+        {
+            InputType type;
+            unsigned int code;
+            float x;
+            float y;
+            float deltaX;
+            float deltaY;
+        };
+
+        //The queue reserves enough records for a busy frame, so that it doesn't have to grow
+        InputQueue(unsigned int reserve);
+
+        //Adds an input event to the queue, coalescing it with the previous event if they're the same kind of mouse event
+        void Queue(InputType type, unsigned int code, float x, float y, float deltaX, float deltaY);
+
+        //Copies the next queued input event into the record, returns false once every event has been delivered, the queue
+        //is then cleared. Input that is queued while the queue is being delivered is delivered as well, but it is never
+        //coalesced into an event that was already delivered
+        bool DeliverNext(InputRecord& record);
+
+        //Returns the number of input events that have been queued, and the number that were delivered after coalescing
+        unsigned int GetRawEventCount() const;
+        unsigned int GetDeliveredEventCount() const;
+
+    private:
+        //Member variables
+        std::vector<InputRecord> m_Records;
+        unsigned int m_Undelivered;     //The index of the first queued event that hasn't been delivered
+        unsigned int m_RawEventCount;
+        unsigned int m_DeliveredEventCount;
+    };
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "AffineTransform.h"
+#include <math.h>
+
+
+namespace GameDev2D
+{
+    AffineTransform AffineTransform::Identity()
+    {
+        AffineTransform transform;
+        transform.m[0][0] = 1.0f;
+        transform.m[1][1] = 1.0f;
+        return transform;
+    }
+
+    AffineTransform AffineTransform::Make(Vector2 aTranslation, float aRadians, Vector2 aScale)
+    {
+        return Make(aTranslation, Rotation::Radians(aRadians), aScale);
+    }
+
+    AffineTransform AffineTransform::Make(Vector2 aTranslation, Rotation aRotation, Vector2 aScale)
+    {
+        //The axes are the rotated and scaled unit vectors
+        Vector2 direction = aRotation.GetDirection();
+
+        AffineTransform transform;
+        transform.m[0][0] = direction.x * aScale.x;   transform.m[1][0] = -direction.y * aScale.y;  transform.m[2][0] = aTranslation.x;
+        transform.m[0][1] = direction.y * aScale.x;   transform.m[1][1] = direction.x * aScale.y;   transform.m[2][1] = aTranslation.y;
+        return transform;
+    }
+
+    AffineTransform::AffineTransform()
+    {
+        m[0][0] = 0;  m[1][0] = 0;  m[2][0] = 0;
+        m[0][1] = 0;  m[1][1] = 0;  m[2][1] = 0;
+    }
+
+    AffineTransform::AffineTransform(const Matrix& aMatrix)
+    {
+        m[0][0] = aMatrix.m[0][0];  m[1][0] = aMatrix.m[1][0];  m[2][0] = aMatrix.m[3][0];
+        m[0][1] = aMatrix.m[0][1];  m[1][1] = aMatrix.m[1][1];  m[2][1] = aMatrix.m[3][1];
+    }
+
+    Vector2 AffineTransform::GetTranslation() const
+    {
+        return Vector2(m[2][0], m[2][1]);
+    }
+
+    float AffineTransform::GetRadians() const
+    {
+        return atan2f(m[0][1], m[1][1]);
+    }
+
+    Vector2 AffineTransform::GetScale() const
+    {
+        return Vector2(sqrtf(m[0][0] * m[0][0] + m[0][1] * m[0][1]), sqrtf(m[1][0] * m[1][0] + m[1][1] * m[1][1]));
+    }
+
+    AffineTransform AffineTransform::GetInverse() const
+    {
+        //The inverse of the 2x2 part, then the translation is moved back by it
+        float determinant = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+        if (determinant == 0.0f)
+        {
+            return AffineTransform();
+        }
+
+        float inverseDeterminant = 1.0f / determinant;
+
+        AffineTransform inverse;
+        inverse.m[0][0] = m[1][1] * inverseDeterminant;
+        inverse.m[0][1] = -m[0][1] * inverseDeterminant;
+        inverse.m[1][0] = -m[1][0] * inverseDeterminant;
+        inverse.m[1][1] = m[0][0] * inverseDeterminant;
+        inverse.m[2][0] = -(inverse.m[0][0] * m[2][0] + inverse.m[1][0] * m[2][1]);
+        inverse.m[2][1] = -(inverse.m[0][1] * m[2][0] + inverse.m[1][1] * m[2][1]);
+        return inverse;
+    }
+
+    Vector2 AffineTransform::operator *(const Vector2& aVector2) const
+    {
+        return Vector2(m[0][0] * aVector2.x + m[1][0] * aVector2.y + m[2][0], m[0][1] * aVector2.x + m[1][1] * aVector2.y + m[2][1]);
+    }
+
+    AffineTransform AffineTransform::operator *(const AffineTransform& aTransform) const
+    {
+        AffineTransform transform;
+        transform.m[0][0] = m[0][0] * aTransform.m[0][0] + m[1][0] * aTransform.m[0][1];
+        transform.m[0][1] = m[0][1] * aTransform.m[0][0] + m[1][1] * aTransform.m[0][1];
+        transform.m[1][0] = m[0][0] * aTransform.m[1][0] + m[1][0] * aTransform.m[1][1];
+        transform.m[1][1] = m[0][1] * aTransform.m[1][0] + m[1][1] * aTransform.m[1][1];
+        transform.m[2][0] = m[0][0] * aTransform.m[2][0] + m[1][0] * aTransform.m[2][1] + m[2][0];
+        transform.m[2][1] = m[0][1] * aTransform.m[2][0] + m[1][1] * aTransform.m[2][1] + m[2][1];
+        return transform;
+    }
+}
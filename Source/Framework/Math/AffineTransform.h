@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Matrix.h"
+#include "Rotation.h"
+#include "Vector2.h"
+
+
+namespace GameDev2D
+{
+    //An AffineTransform is a compact 2x3 transform for 2D translation, rotation, scale and skew, it is the top two rows of
+    //a 4x4 Matrix that has no z OR perspective component. Like the Matrix it is stored in columns, m[0] is the x axis,
+    //m[1] is the y axis and m[2] is the translation. Composing and applying an AffineTransform is a handful of multiplies,
+    //use it for 2D work and convert it to a Matrix (explicitly) when a 4x4 Matrix is needed, for example for a shader
+    struct AffineTransform
+    {
+        //Returns an identity AffineTransform
+        static AffineTransform Identity();
+
+        //Returns an AffineTransform that scales, then rotates, then translates. The result is the same as
+        //translation * rotation * scale, but it is built directly, without multiplying three transforms
+        static AffineTransform Make(Vector2 translation, float radians, Vector2 scale = Vector2(1.0f, 1.0f));
+        static AffineTransform Make(Vector2 translation, Rotation rotation, Vector2 scale = Vector2(1.0f, 1.0f));
+
+        //Creates an empty AffineTransform, all elements initialized to zero
+        AffineTransform();
+
+        //Converts a Matrix to an AffineTransform, the Matrix's z and perspective components are dropped
+        explicit AffineTransform(const Matrix& matrix);
+
+        //Returns the translation Vector2 value
+        Vector2 GetTranslation() const;
+
+        //Returns the angle value
+        float GetRadians() const;
+
+        //Returns the scale Vector2 value
+        Vector2 GetScale() const;
+
+        //Returns an inversed AffineTransform, if the transform can't be inversed an empty AffineTransform is returned
+        AffineTransform GetInverse() const;
+
+        //Multiplication operator override, transforms a point
+        Vector2 operator *(const Vector2& vector2) const;
+
+        //Multiplication operator override, the right hand transform is applied first
+        AffineTransform operator *(const AffineTransform& transform) const;
+
+        //Member variable
+        float m[3][2];
+    };
+}
@@ -1,5 +1,7 @@
 #include "Matrix.h"
+#include "AffineTransform.h"
 #include "Math.h"
+#include "Simd.h"
 #include <math.h>
 
 
@@ -14,11 +16,7 @@ namespace GameDev2D
 
     Matrix Matrix::Make(Vector2 aTranslation, float aRadians, Vector2 aScale)
     {
-        Matrix translation = Matrix::MakeTranslation(aTranslation);
-        Matrix rotation = Matrix::MakeRotation(aRadians);
-        Matrix scale = Matrix::MakeScale(aScale);
-        Matrix transformation = translation * rotation * scale;
-        return transformation;
+        return Matrix(AffineTransform::Make(aTranslation, aRadians, aScale));
     }
 
     Matrix Matrix::MakeTranslation(Vector2 aTranslation)
@@ -88,6 +86,13 @@ namespace GameDev2D
         }
     }
 
+    Matrix::Matrix(const AffineTransform& aTransform)
+    {
+        SetIdentity();
+        m[0][0] = aTransform.m[0][0];  m[1][0] = aTransform.m[1][0];  m[3][0] = aTransform.m[2][0];
+        m[0][1] = aTransform.m[0][1];  m[1][1] = aTransform.m[1][1];  m[3][1] = aTransform.m[2][1];
+    }
+
     void Matrix::SetIdentity()
     {
         m[0][0] = 1;  m[1][0] = 0;  m[2][0] = 0;  m[3][0] = 0;
@@ -185,6 +190,122 @@ namespace GameDev2D
         return matrix;
     }
 
+#if SIMD_SSE2
+    //The 2x2 sub-matrices used by the SSE inverse are packed in a register as (x0, y0, x1, y1)
+    #define MATRIX_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+    #define MATRIX_SWIZZLE(a, x, y, z, w) MATRIX_SHUFFLE(a, a, x, y, z, w)
+
+    //Returns the 2x2 product a * b
+    static inline __m128 Multiply2x2(__m128 aA, __m128 aB)
+    {
+        return _mm_add_ps(_mm_mul_ps(aA, MATRIX_SWIZZLE(aB, 0, 3, 0, 3)), _mm_mul_ps(MATRIX_SWIZZLE(aA, 1, 0, 3, 2), MATRIX_SWIZZLE(aB, 2, 1, 2, 1)));
+    }
+
+    //Returns the 2x2 product adjugate(a) * b
+    static inline __m128 AdjugateMultiply2x2(__m128 aA, __m128 aB)
+    {
+        return _mm_sub_ps(_mm_mul_ps(MATRIX_SWIZZLE(aA, 3, 3, 0, 0), aB), _mm_mul_ps(MATRIX_SWIZZLE(aA, 1, 1, 2, 2), MATRIX_SWIZZLE(aB, 2, 3, 0, 1)));
+    }
+
+    //Returns the 2x2 product a * adjugate(b)
+    static inline __m128 MultiplyAdjugate2x2(__m128 aA, __m128 aB)
+    {
+        return _mm_sub_ps(_mm_mul_ps(aA, MATRIX_SWIZZLE(aB, 3, 0, 3, 0)), _mm_mul_ps(MATRIX_SWIZZLE(aA, 1, 0, 3, 2), MATRIX_SWIZZLE(aB, 2, 1, 2, 1)));
+    }
+
+    Matrix Matrix::GetInverse()
+    {
+        //The Matrix is split into four 2x2 blocks and inversed blockwise, the inverse of the
+        //transpose is the transpose of the inverse, so it doesn't matter that m is stored in columns
+        __m128 column0 = _mm_loadu_ps(m[0]);
+        __m128 column1 = _mm_loadu_ps(m[1]);
+        __m128 column2 = _mm_loadu_ps(m[2]);
+        __m128 column3 = _mm_loadu_ps(m[3]);
+
+        __m128 a = _mm_movelh_ps(column0, column1);
+        __m128 b = _mm_movehl_ps(column1, column0);
+        __m128 c = _mm_movelh_ps(column2, column3);
+        __m128 d = _mm_movehl_ps(column3, column2);
+
+        //The determinants of the four blocks
+        __m128 determinants = _mm_sub_ps(_mm_mul_ps(MATRIX_SHUFFLE(column0, column2, 0, 2, 0, 2), MATRIX_SHUFFLE(column1, column3, 1, 3, 1, 3)),
+                                         _mm_mul_ps(MATRIX_SHUFFLE(column0, column2, 1, 3, 1, 3), MATRIX_SHUFFLE(column1, column3, 0, 2, 0, 2)));
+        __m128 determinantA = MATRIX_SWIZZLE(determinants, 0, 0, 0, 0);
+        __m128 determinantB = MATRIX_SWIZZLE(determinants, 1, 1, 1, 1);
+        __m128 determinantC = MATRIX_SWIZZLE(determinants, 2, 2, 2, 2);
+        __m128 determinantD = MATRIX_SWIZZLE(determinants, 3, 3, 3, 3);
+
+        __m128 dc = AdjugateMultiply2x2(d, c);
+        __m128 ab = AdjugateMultiply2x2(a, b);
+        __m128 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), Multiply2x2(b, dc));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), Multiply2x2(c, ab));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), MultiplyAdjugate2x2(d, ab));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), MultiplyAdjugate2x2(a, dc));
+
+        //The determinant of the Matrix, the trace is summed across the register
+        __m128 trace = _mm_mul_ps(ab, MATRIX_SWIZZLE(dc, 0, 2, 1, 3));
+        trace = _mm_add_ps(trace, MATRIX_SWIZZLE(trace, 2, 3, 0, 1));
+        trace = _mm_add_ps(trace, MATRIX_SWIZZLE(trace, 1, 0, 3, 2));
+        __m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC)), trace);
+
+        if (_mm_cvtss_f32(determinant) == 0.0f)
+        {
+            return Matrix();
+        }
+
+        __m128 inverseDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+        x = _mm_mul_ps(x, inverseDeterminant);
+        y = _mm_mul_ps(y, inverseDeterminant);
+        z = _mm_mul_ps(z, inverseDeterminant);
+        w = _mm_mul_ps(w, inverseDeterminant);
+
+        //The adjugates of the blocks are put back together
+        Matrix inverse;
+        _mm_storeu_ps(inverse.m[0], MATRIX_SHUFFLE(x, y, 3, 1, 3, 1));
+        _mm_storeu_ps(inverse.m[1], MATRIX_SHUFFLE(x, y, 2, 0, 2, 0));
+        _mm_storeu_ps(inverse.m[2], MATRIX_SHUFFLE(z, w, 3, 1, 3, 1));
+        _mm_storeu_ps(inverse.m[3], MATRIX_SHUFFLE(z, w, 2, 0, 2, 0));
+        return inverse;
+    }
+
+    Vector2 Matrix::operator *(const Vector2 aVector2) const
+    {
+        //The columns are weighted by the vector's components, z is zero and w is one
+        __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m[0]), _mm_set1_ps(aVector2.x)), _mm_mul_ps(_mm_loadu_ps(m[1]), _mm_set1_ps(aVector2.y))), _mm_loadu_ps(m[3]));
+
+        float values[4];
+        _mm_storeu_ps(values, result);
+        if (values[3] == 0.0f)
+        {
+            return Vector2(values[0], values[1]);
+        }
+
+        return Vector2(values[0] / values[3], values[1] / values[3]);
+    }
+
+    Matrix Matrix::operator *(const Matrix aMatrix) const
+    {
+        __m128 column0 = _mm_loadu_ps(m[0]);
+        __m128 column1 = _mm_loadu_ps(m[1]);
+        __m128 column2 = _mm_loadu_ps(m[2]);
+        __m128 column3 = _mm_loadu_ps(m[3]);
+
+        //Each column of the result is this Matrix's columns weighted by the other Matrix's column
+        Matrix matrix;
+        for (unsigned int i = 0; i < MATRIX_NUM_COLUMNS; i++)
+        {
+            __m128 result = _mm_mul_ps(column0, _mm_set1_ps(aMatrix.m[i][0]));
+            result = _mm_add_ps(result, _mm_mul_ps(column1, _mm_set1_ps(aMatrix.m[i][1])));
+            result = _mm_add_ps(result, _mm_mul_ps(column2, _mm_set1_ps(aMatrix.m[i][2])));
+            result = _mm_add_ps(result, _mm_mul_ps(column3, _mm_set1_ps(aMatrix.m[i][3])));
+            _mm_storeu_ps(matrix.m[i], result);
+        }
+        return matrix;
+    }
+
+    #undef MATRIX_SWIZZLE
+    #undef MATRIX_SHUFFLE
+#else
     Matrix Matrix::GetInverse()
     {
         Matrix inverse;
@@ -355,5 +476,5 @@ namespace GameDev2D
 
         return matrix;
     }
+#endif
 }
-
@@ -7,6 +7,9 @@
 
 namespace GameDev2D
 {
+    //Forward declarations
+    struct AffineTransform;
+
     //Local constants
     const unsigned int MATRIX_NUM_ROWS = 4;
     const unsigned int MATRIX_NUM_COLUMNS = 4;
@@ -16,7 +19,7 @@ namespace GameDev2D
         //Returns an Identity Matrix
         static Matrix Identity();
 
-        //Returns a Matrix based on the translation
+        //Returns a Matrix that scales, then rotates, then translates, it is built directly from an AffineTransform
         static Matrix Make(Vector2 translation, float radians, Vector2 scale = Vector2(1.0f, 1.0f));
 
         //Returns a Matrix based on the translation
@@ -40,6 +43,9 @@ namespace GameDev2D
         //Copy a Matrix
         Matrix(const Matrix& matrix);
 
+        //Converts an AffineTransform to a Matrix, with no z OR perspective component
+        explicit Matrix(const AffineTransform& transform);
+
         //Sets the Matrix to an identity Matrix
         void SetIdentity();
 
@@ -69,7 +75,8 @@ namespace GameDev2D
         //Returns a transposed Matrix based on this Matrix
         Matrix GetTransposed();
 
-        //Returns an inversed Matrix based on this Matrix
+        //Returns an inversed Matrix based on this Matrix, if the Matrix can't be inversed an empty Matrix is returned.
+        //For a 2D transform, AffineTransform::GetInverse() is much cheaper
         Matrix GetInverse();
 
         //Multiplication operator override
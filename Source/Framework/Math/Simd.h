@@ -0,0 +1,11 @@
+#pragma once
+
+//SIMD_SSE2 is 1 when the target has SSE2, every x64 target does. An x86 target only does when it's compiled with
+///arch:SSE2 or higher (the default since Visual Studio 2012), /arch:IA32 builds and other architectures use the
+//scalar code paths instead
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#define SIMD_SSE2 0
+#endif
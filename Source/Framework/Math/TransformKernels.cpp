@@ -0,0 +1,334 @@
+#include "TransformKernels.h"
+#include "Simd.h"
+#include <math.h>
+
+
+namespace GameDev2D
+{
+    //Returns an object's value from an optional array
+    static inline float GetValue(const float* aValues, unsigned int aIndex, float aDefault)
+    {
+        return aValues != nullptr ? aValues[aIndex] : aDefault;
+    }
+
+#if SIMD_SSE2
+    //The angle is reduced by multiples of pi / 2, pi / 2 is split in three parts (Cody-Waite) so that the reduction stays exact
+    const float TRANSFORM_KERNELS_TWO_OVER_PI = 0.636619772367581343f;
+    const float TRANSFORM_KERNELS_PI_OVER_TWO_A = 1.5703125f;
+    const float TRANSFORM_KERNELS_PI_OVER_TWO_B = 4.837512969970703125e-4f;
+    const float TRANSFORM_KERNELS_PI_OVER_TWO_C = 7.54978995489188216e-8f;
+
+    //Loads the values of up to 4 objects from an optional array, the lanes past the last object get the default value
+    static inline __m128 LoadValues(const float* aValues, unsigned int aIndex, unsigned int aLanes, float aDefault)
+    {
+        if (aValues == nullptr)
+        {
+            return _mm_set1_ps(aDefault);
+        }
+
+        if (aLanes == 4)
+        {
+            return _mm_loadu_ps(aValues + aIndex);
+        }
+
+        //The lanes are loaded directly, rather than through an array on the stack, a single object (a Transformable's
+        //matrix OR a Drawable's edges) would otherwise stall on the store forwarding of every value it loads
+        const float* values = aValues + aIndex;
+        __m128 defaults = _mm_set1_ps(aDefault);
+        switch (aLanes)
+        {
+        case 1: return _mm_move_ss(defaults, _mm_load_ss(values));
+        case 2: return _mm_loadl_pi(defaults, (const __m64*)values);
+        default: return _mm_movelh_ps(_mm_loadl_pi(defaults, (const __m64*)values), _mm_move_ss(defaults, _mm_load_ss(values + 2)));
+        }
+    }
+
+    //Computes the sine and cosine of 4 angles. The angle is reduced to -pi/4..pi/4, where Cephes' minimax polynomials
+    //are accurate to a float, then the quadrant swaps the sine and cosine and sets their signs
+    static inline void SinCos4(__m128 aRadians, __m128& aSine, __m128& aCosine)
+    {
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i two = _mm_set1_epi32(2);
+
+        __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(aRadians, _mm_set1_ps(TRANSFORM_KERNELS_TWO_OVER_PI)));
+        __m128 k = _mm_cvtepi32_ps(quadrant);
+        __m128 x = _mm_sub_ps(aRadians, _mm_mul_ps(k, _mm_set1_ps(TRANSFORM_KERNELS_PI_OVER_TWO_A)));
+        x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(TRANSFORM_KERNELS_PI_OVER_TWO_B)));
+        x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(TRANSFORM_KERNELS_PI_OVER_TWO_C)));
+        __m128 x2 = _mm_mul_ps(x, x);
+
+        //sin(x) = x + x^3 * (s1 + x^2 * (s2 + x^2 * s3))
+        __m128 sine = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), x2), _mm_set1_ps(8.3321608736e-3f));
+        sine = _mm_add_ps(_mm_mul_ps(sine, x2), _mm_set1_ps(-1.6666654611e-1f));
+        sine = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sine, x2), x), x);
+
+        //cos(x) = 1 - x^2 / 2 + x^4 * (c1 + x^2 * (c2 + x^2 * c3))
+        __m128 cosine = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), x2), _mm_set1_ps(-1.388731625493765e-3f));
+        cosine = _mm_add_ps(_mm_mul_ps(cosine, x2), _mm_set1_ps(4.166664568298827e-2f));
+        cosine = _mm_mul_ps(_mm_mul_ps(cosine, x2), x2);
+        cosine = _mm_add_ps(_mm_sub_ps(cosine, _mm_mul_ps(x2, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+        //Odd quadrants swap the sine and cosine
+        __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+        __m128 s = _mm_or_ps(_mm_and_ps(swap, cosine), _mm_andnot_ps(swap, sine));
+        __m128 c = _mm_or_ps(_mm_and_ps(swap, sine), _mm_andnot_ps(swap, cosine));
+
+        //Quadrants 2 and 3 negate the sine, quadrants 1 and 2 negate the cosine, bit 1 of the quadrant is moved to the sign bit
+        __m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+        __m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+        aSine = _mm_xor_ps(s, sineSign);
+        aCosine = _mm_xor_ps(c, cosineSign);
+    }
+
+    //Computes the rotated and scaled axes of 4 objects
+    static inline void CalculateAxes(const TransformArrays& aArrays, unsigned int aIndex, unsigned int aLanes, __m128& aXAxisX, __m128& aXAxisY, __m128& aYAxisX, __m128& aYAxisY)
+    {
+        __m128 sine;
+        __m128 cosine;
+        SinCos4(LoadValues(aArrays.radians, aIndex, aLanes, 0.0f), sine, cosine);
+
+        __m128 scaleX = LoadValues(aArrays.scaleX, aIndex, aLanes, 1.0f);
+        __m128 scaleY = LoadValues(aArrays.scaleY, aIndex, aLanes, 1.0f);
+        aXAxisX = _mm_mul_ps(cosine, scaleX);
+        aXAxisY = _mm_mul_ps(sine, scaleX);
+        aYAxisX = _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), sine), scaleY);
+        aYAxisY = _mm_mul_ps(cosine, scaleY);
+    }
+#endif
+
+    void TransformKernels::SinCos(const float* aRadians, float* aSines, float* aCosines, unsigned int aCount)
+    {
+#if SIMD_SSE2
+        for (unsigned int i = 0; i < aCount; i += 4)
+        {
+            unsigned int lanes = aCount - i < 4 ? aCount - i : 4;
+
+            __m128 sine;
+            __m128 cosine;
+            SinCos4(LoadValues(aRadians, i, lanes, 0.0f), sine, cosine);
+
+            float sines[4];
+            float cosines[4];
+            _mm_storeu_ps(sines, sine);
+            _mm_storeu_ps(cosines, cosine);
+            for (unsigned int j = 0; j < lanes; j++)
+            {
+                aSines[i + j] = sines[j];
+                aCosines[i + j] = cosines[j];
+            }
+        }
+#else
+        SinCosScalar(aRadians, aSines, aCosines, aCount);
+#endif
+    }
+
+    void TransformKernels::CalculateTransforms(const TransformArrays& aArrays, AffineTransform* aTransforms, unsigned int aCount)
+    {
+#if SIMD_SSE2
+        for (unsigned int i = 0; i < aCount; i += 4)
+        {
+            unsigned int lanes = aCount - i < 4 ? aCount - i : 4;
+
+            __m128 axes[4];
+            CalculateAxes(aArrays, i, lanes, axes[0], axes[1], axes[2], axes[3]);
+
+            //Transposed, each row holds an object's x axis and y axis, in the order the AffineTransform stores them
+            _MM_TRANSPOSE4_PS(axes[0], axes[1], axes[2], axes[3]);
+
+            __m128 positionX = LoadValues(aArrays.positionX, i, lanes, 0.0f);
+            __m128 positionY = LoadValues(aArrays.positionY, i, lanes, 0.0f);
+            __m128 translations[2] = { _mm_unpacklo_ps(positionX, positionY), _mm_unpackhi_ps(positionX, positionY) };
+
+            for (unsigned int j = 0; j < lanes; j++)
+            {
+                _mm_storeu_ps(&aTransforms[i + j].m[0][0], axes[j]);
+                if ((j & 1) == 0)
+                {
+                    _mm_storel_pi((__m64*)aTransforms[i + j].m[2], translations[j / 2]);
+                }
+                else
+                {
+                    _mm_storeh_pi((__m64*)aTransforms[i + j].m[2], translations[j / 2]);
+                }
+            }
+        }
+#else
+        CalculateTransformsScalar(aArrays, aTransforms, aCount);
+#endif
+    }
+
+    void TransformKernels::CalculateBounds(const TransformArrays& aArrays, float* aEdges, unsigned int aCount)
+    {
+#if SIMD_SSE2
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+        for (unsigned int i = 0; i < aCount; i += 4)
+        {
+            unsigned int lanes = aCount - i < 4 ? aCount - i : 4;
+
+            __m128 xAxisX;
+            __m128 xAxisY;
+            __m128 yAxisX;
+            __m128 yAxisY;
+            CalculateAxes(aArrays, i, lanes, xAxisX, xAxisY, yAxisX, yAxisY);
+
+            //The quad's sides, in world space
+            __m128 width = LoadValues(aArrays.width, i, lanes, 0.0f);
+            __m128 height = LoadValues(aArrays.height, i, lanes, 0.0f);
+            __m128 widthX = _mm_mul_ps(xAxisX, width);
+            __m128 widthY = _mm_mul_ps(xAxisY, width);
+            __m128 heightX = _mm_mul_ps(yAxisX, height);
+            __m128 heightY = _mm_mul_ps(yAxisY, height);
+
+            //The half extents of the bounds
+            __m128 extentX = _mm_mul_ps(_mm_add_ps(_mm_and_ps(widthX, absMask), _mm_and_ps(heightX, absMask)), half);
+            __m128 extentY = _mm_mul_ps(_mm_add_ps(_mm_and_ps(widthY, absMask), _mm_and_ps(heightY, absMask)), half);
+
+            //The center of the quad, offset from the position by the anchor
+            __m128 centerX = _mm_sub_ps(half, LoadValues(aArrays.anchorX, i, lanes, 0.0f));
+            __m128 centerY = _mm_sub_ps(half, LoadValues(aArrays.anchorY, i, lanes, 0.0f));
+            __m128 x = _mm_add_ps(LoadValues(aArrays.positionX, i, lanes, 0.0f), _mm_add_ps(_mm_mul_ps(widthX, centerX), _mm_mul_ps(heightX, centerY)));
+            __m128 y = _mm_add_ps(LoadValues(aArrays.positionY, i, lanes, 0.0f), _mm_add_ps(_mm_mul_ps(widthY, centerX), _mm_mul_ps(heightY, centerY)));
+
+            //Transposed, each row holds an object's left, right, top and bottom edges
+            __m128 edges[4] = { _mm_sub_ps(x, extentX), _mm_add_ps(x, extentX), _mm_add_ps(y, extentY), _mm_sub_ps(y, extentY) };
+            _MM_TRANSPOSE4_PS(edges[0], edges[1], edges[2], edges[3]);
+
+            for (unsigned int j = 0; j < lanes; j++)
+            {
+                _mm_storeu_ps(&aEdges[(i + j) * 4], edges[j]);
+            }
+        }
+#else
+        CalculateBoundsScalar(aArrays, aEdges, aCount);
+#endif
+    }
+
+    void TransformKernels::CalculateQuads(const TransformArrays& aArrays, Vector2* aCorners, unsigned int aCount)
+    {
+#if SIMD_SSE2
+        for (unsigned int i = 0; i < aCount; i += 4)
+        {
+            unsigned int lanes = aCount - i < 4 ? aCount - i : 4;
+
+            __m128 xAxisX;
+            __m128 xAxisY;
+            __m128 yAxisX;
+            __m128 yAxisY;
+            CalculateAxes(aArrays, i, lanes, xAxisX, xAxisY, yAxisX, yAxisY);
+
+            //The quad's left, right, bottom and top sides, relative to the anchor
+            __m128 width = LoadValues(aArrays.width, i, lanes, 0.0f);
+            __m128 height = LoadValues(aArrays.height, i, lanes, 0.0f);
+            __m128 left = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(LoadValues(aArrays.anchorX, i, lanes, 0.0f), width));
+            __m128 right = _mm_add_ps(left, width);
+            __m128 bottom = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(LoadValues(aArrays.anchorY, i, lanes, 0.0f), height));
+            __m128 top = _mm_add_ps(bottom, height);
+
+            //The sides along the rotated and scaled axes, offset by the position
+            __m128 positionX = LoadValues(aArrays.positionX, i, lanes, 0.0f);
+            __m128 positionY = LoadValues(aArrays.positionY, i, lanes, 0.0f);
+            __m128 leftX = _mm_add_ps(positionX, _mm_mul_ps(xAxisX, left));
+            __m128 leftY = _mm_add_ps(positionY, _mm_mul_ps(xAxisY, left));
+            __m128 rightX = _mm_add_ps(positionX, _mm_mul_ps(xAxisX, right));
+            __m128 rightY = _mm_add_ps(positionY, _mm_mul_ps(xAxisY, right));
+            __m128 topX = _mm_mul_ps(yAxisX, top);
+            __m128 topY = _mm_mul_ps(yAxisY, top);
+            __m128 bottomX = _mm_mul_ps(yAxisX, bottom);
+            __m128 bottomY = _mm_mul_ps(yAxisY, bottom);
+
+            //Transposed, each row holds two of an object's corners
+            __m128 topCorners[4] = { _mm_add_ps(leftX, topX), _mm_add_ps(leftY, topY), _mm_add_ps(rightX, topX), _mm_add_ps(rightY, topY) };
+            __m128 bottomCorners[4] = { _mm_add_ps(rightX, bottomX), _mm_add_ps(rightY, bottomY), _mm_add_ps(leftX, bottomX), _mm_add_ps(leftY, bottomY) };
+            _MM_TRANSPOSE4_PS(topCorners[0], topCorners[1], topCorners[2], topCorners[3]);
+            _MM_TRANSPOSE4_PS(bottomCorners[0], bottomCorners[1], bottomCorners[2], bottomCorners[3]);
+
+            for (unsigned int j = 0; j < lanes; j++)
+            {
+                _mm_storeu_ps(&aCorners[(i + j) * 4].x, topCorners[j]);
+                _mm_storeu_ps(&aCorners[(i + j) * 4 + 2].x, bottomCorners[j]);
+            }
+        }
+#else
+        CalculateQuadsScalar(aArrays, aCorners, aCount);
+#endif
+    }
+
+    void TransformKernels::SinCosScalar(const float* aRadians, float* aSines, float* aCosines, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            aSines[i] = sinf(aRadians[i]);
+            aCosines[i] = cosf(aRadians[i]);
+        }
+    }
+
+    void TransformKernels::CalculateTransformsScalar(const TransformArrays& aArrays, AffineTransform* aTransforms, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            float radians = GetValue(aArrays.radians, i, 0.0f);
+            float s = sinf(radians);
+            float c = cosf(radians);
+            float scaleX = GetValue(aArrays.scaleX, i, 1.0f);
+            float scaleY = GetValue(aArrays.scaleY, i, 1.0f);
+
+            AffineTransform& transform = aTransforms[i];
+            transform.m[0][0] = c * scaleX;   transform.m[1][0] = -s * scaleY;  transform.m[2][0] = aArrays.positionX[i];
+            transform.m[0][1] = s * scaleX;   transform.m[1][1] = c * scaleY;   transform.m[2][1] = aArrays.positionY[i];
+        }
+    }
+
+    void TransformKernels::CalculateBoundsScalar(const TransformArrays& aArrays, float* aEdges, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            float radians = GetValue(aArrays.radians, i, 0.0f);
+            float s = sinf(radians);
+            float c = cosf(radians);
+            float width = aArrays.width[i];
+            float height = aArrays.height[i];
+            float widthX = c * GetValue(aArrays.scaleX, i, 1.0f) * width;
+            float widthY = s * GetValue(aArrays.scaleX, i, 1.0f) * width;
+            float heightX = -s * GetValue(aArrays.scaleY, i, 1.0f) * height;
+            float heightY = c * GetValue(aArrays.scaleY, i, 1.0f) * height;
+            float extentX = (fabsf(widthX) + fabsf(heightX)) * 0.5f;
+            float extentY = (fabsf(widthY) + fabsf(heightY)) * 0.5f;
+            float centerX = 0.5f - GetValue(aArrays.anchorX, i, 0.0f);
+            float centerY = 0.5f - GetValue(aArrays.anchorY, i, 0.0f);
+            float x = aArrays.positionX[i] + (widthX * centerX + heightX * centerY);
+            float y = aArrays.positionY[i] + (widthY * centerX + heightY * centerY);
+
+            float* edges = &aEdges[i * 4];
+            edges[0] = x - extentX;
+            edges[1] = x + extentX;
+            edges[2] = y + extentY;
+            edges[3] = y - extentY;
+        }
+    }
+
+    void TransformKernels::CalculateQuadsScalar(const TransformArrays& aArrays, Vector2* aCorners, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            float radians = GetValue(aArrays.radians, i, 0.0f);
+            float s = sinf(radians);
+            float c = cosf(radians);
+            Vector2 xAxis = Vector2(c, s) * GetValue(aArrays.scaleX, i, 1.0f);
+            Vector2 yAxis = Vector2(-s, c) * GetValue(aArrays.scaleY, i, 1.0f);
+            Vector2 position = Vector2(aArrays.positionX[i], aArrays.positionY[i]);
+
+            float left = -GetValue(aArrays.anchorX, i, 0.0f) * aArrays.width[i];
+            float right = left + aArrays.width[i];
+            float bottom = -GetValue(aArrays.anchorY, i, 0.0f) * aArrays.height[i];
+            float top = bottom + aArrays.height[i];
+
+            Vector2* corners = &aCorners[i * 4];
+            corners[0] = position + xAxis * left + yAxis * top;
+            corners[1] = position + xAxis * right + yAxis * top;
+            corners[2] = position + xAxis * right + yAxis * bottom;
+            corners[3] = position + xAxis * left + yAxis * bottom;
+        }
+    }
+}
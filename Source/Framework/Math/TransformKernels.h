@@ -0,0 +1,82 @@
+#pragma once
+
+#include "AffineTransform.h"
+#include "Vector2.h"
+
+
+namespace GameDev2D
+{
+    //The transforms of N objects, stored as one array per component. Every array that is set MUST hold at least as many
+    //values as the number of objects passed to a kernel. The rotation, scale and anchor arrays are optional, when one
+    //isn't set every object has a rotation of zero, a scale of one OR an anchor of zero (the Drawable default)
+    struct TransformArrays
+    {
+        TransformArrays() :
+            positionX(nullptr),
+            positionY(nullptr),
+            radians(nullptr),
+            scaleX(nullptr),
+            scaleY(nullptr),
+            anchorX(nullptr),
+            anchorY(nullptr),
+            width(nullptr),
+            height(nullptr)
+        {
+        }
+
+        //Returns the arrays, starting at an object's index
+        TransformArrays Offset(unsigned int index) const
+        {
+            TransformArrays arrays;
+            arrays.positionX = positionX + index;
+            arrays.positionY = positionY + index;
+            arrays.radians = radians != nullptr ? radians + index : nullptr;
+            arrays.scaleX = scaleX != nullptr ? scaleX + index : nullptr;
+            arrays.scaleY = scaleY != nullptr ? scaleY + index : nullptr;
+            arrays.anchorX = anchorX != nullptr ? anchorX + index : nullptr;
+            arrays.anchorY = anchorY != nullptr ? anchorY + index : nullptr;
+            arrays.width = width != nullptr ? width + index : nullptr;
+            arrays.height = height != nullptr ? height + index : nullptr;
+            return arrays;
+        }
+
+        const float* positionX;
+        const float* positionY;
+        const float* radians;
+        const float* scaleX;
+        const float* scaleY;
+        const float* anchorX;
+        const float* anchorY;
+        const float* width;     //Only used for the bounds and quads
+        const float* height;    //Only used for the bounds and quads
+    };
+
+    //The TransformKernels prepare the transforms of many objects in one pass: the world transforms, the axis-aligned bounds
+    //and the four corners of each object's quad, for a quad of width by height that is positioned by its anchor.
+    //Transformable::GetTransformMatrix() and Drawable::CalculateEdges() use them for a single object as well, so that an
+    //object's values are the same whether they were computed in bulk or one at a time.
+    //Each kernel has an SSE2 version (used when the target supports it) that processes four objects at a time with a
+    //polynomial sine and cosine, and a scalar reference version that uses sinf() and cosf()
+    struct TransformKernels
+    {
+        //Computes the sine and cosine of each angle, in radians. The SSE2 version is accurate to within 2e-7 for angles
+        //of up to +/- 8192 radians, larger angles lose precision
+        static void SinCos(const float* radians, float* sines, float* cosines, unsigned int count);
+
+        //Computes the world transform of each object, the transform scales, then rotates, then translates
+        static void CalculateTransforms(const TransformArrays& arrays, AffineTransform* transforms, unsigned int count);
+
+        //Computes the axis-aligned bounds of each object's quad, 4 floats per object in the Drawable's edge order:
+        //left, right, top, bottom
+        static void CalculateBounds(const TransformArrays& arrays, float* edges, unsigned int count);
+
+        //Computes the 4 corners of each object's quad, in the SpriteBatch's vertex order: top left, top right, bottom right, bottom left
+        static void CalculateQuads(const TransformArrays& arrays, Vector2* corners, unsigned int count);
+
+        //Scalar reference versions of the kernels
+        static void SinCosScalar(const float* radians, float* sines, float* cosines, unsigned int count);
+        static void CalculateTransformsScalar(const TransformArrays& arrays, AffineTransform* transforms, unsigned int count);
+        static void CalculateBoundsScalar(const TransformArrays& arrays, float* edges, unsigned int count);
+        static void CalculateQuadsScalar(const TransformArrays& arrays, Vector2* corners, unsigned int count);
+    };
+}
@@ -1,15 +1,33 @@
 #pragma once
 
+#include <math.h>
+
 
 namespace GameDev2D
 {
 	class Rotation;
 
+    //The Vector2's methods are defined inline, so that they can be inlined into hot loops, the methods that don't
+    //need a square root are constexpr. For arrays of vectors, the Vector2Kernels operate on many vectors in one pass
     struct Vector2
     {
-        Vector2(float x, float y);
-        Vector2(const Vector2& vector2);
-        Vector2();
+        constexpr Vector2(float aX, float aY) :
+            x(aX),
+            y(aY)
+        {
+        }
+
+        constexpr Vector2(const Vector2& aVector2) :
+            x(aVector2.x),
+            y(aVector2.y)
+        {
+        }
+
+        constexpr Vector2() :
+            x(0.0f),
+            y(0.0f)
+        {
+        }
 
         //2D zero vector constant (0,0)
         static const Vector2 Zero;
@@ -30,63 +48,170 @@ namespace GameDev2D
 		static const Vector2 Down;
 
         //Calculates the angle of the vector
-        Rotation Angle();
+        Rotation Angle() const;
 
         //Returns the Length (magnitude) of the vector
-        float Length();
+        float Length() const
+        {
+            return sqrtf(LengthSquared());
+        }
 
         //Returns the Length squared of the vector
-        float LengthSquared();
+        constexpr float LengthSquared() const
+        {
+            return x * x + y * y;
+        }
 
         //Normalizes the current vector
-        void Normalize();
+        void Normalize()
+        {
+            float length = LengthSquared();
+            if (length != 0)
+            {
+                length = sqrtf(length);
+                x /= length;
+                y /= length;
+            }
+        }
 
         //Returns a normalized copy of the current vector
-        Vector2 Normalized();
+        Vector2 Normalized() const
+        {
+            Vector2 vector2 = Vector2(x, y);
+            vector2.Normalize();
+            return vector2;
+        }
 
         //Calculates the distance between the current vector and the supplied vector
-        float Distance(const Vector2& vector2);
+        float Distance(const Vector2& aVector2) const
+        {
+            return sqrtf(DistanceSquared(aVector2));
+        }
 
         //Calculates the distance squared between the current vector and the supplied vector
-        float DistanceSquared(const Vector2& vector2);
+        constexpr float DistanceSquared(const Vector2& aVector2) const
+        {
+            return (x - aVector2.x) * (x - aVector2.x) + (y - aVector2.y) * (y - aVector2.y);
+        }
 
         //Calculates the dot product between the current vector and the supplied vector
-        float DotProduct(const Vector2& vector2);
+        constexpr float DotProduct(const Vector2& aVector2) const
+        {
+            return x * aVector2.x + y * aVector2.y;
+        }
 
 		//Returns a vector rotated 90 degrees clockwise
-		Vector2 PerpendicularClockwise();
+		constexpr Vector2 PerpendicularClockwise() const
+		{
+			return Vector2(y, -x);
+		}
 
 		//Returns a vector rotated 90 degrees counterclockwise
-		Vector2 PerpendicularCounterClockwise();
-
-        Vector2 operator+(const Vector2& vector2) const;
-        void operator+=(const Vector2& vector2);
-
-        Vector2 operator-(const Vector2& vector2) const;
-        void operator-=(const Vector2& vector2);
-
-        Vector2 operator*(const Vector2& vector2) const;
-        void operator*=(const Vector2& vector2);
-
-        Vector2 operator*(const float& scale) const;
-        void operator*=(const float& scale);
-
-        Vector2 operator/(const Vector2& vector2) const;
-        void operator/=(const Vector2& vector2);
-
-        Vector2 operator/(const float& scale) const;
-        void operator/=(const float& scale);
-
-        Vector2 operator-() const;
-
-        bool operator==(const Vector2& vector2) const;
-        bool operator!=(const Vector2& vector2) const;
-
-        bool operator<(const Vector2& vector2) const;
-        bool operator<=(const Vector2& vector2) const;
-
-        bool operator>(const Vector2& vector2) const;
-        bool operator>=(const Vector2& vector2) const;
+		constexpr Vector2 PerpendicularCounterClockwise() const
+		{
+			return Vector2(-y, x);
+		}
+
+        constexpr Vector2 operator+(const Vector2& aVector2) const
+        {
+            return Vector2(x + aVector2.x, y + aVector2.y);
+        }
+
+        void operator+=(const Vector2& aVector2)
+        {
+            x += aVector2.x;
+            y += aVector2.y;
+        }
+
+        constexpr Vector2 operator-(const Vector2& aVector2) const
+        {
+            return Vector2(x - aVector2.x, y - aVector2.y);
+        }
+
+        void operator-=(const Vector2& aVector2)
+        {
+            x -= aVector2.x;
+            y -= aVector2.y;
+        }
+
+        constexpr Vector2 operator*(const Vector2& aVector2) const
+        {
+            return Vector2(x * aVector2.x, y * aVector2.y);
+        }
+
+        void operator*=(const Vector2& aVector2)
+        {
+            x *= aVector2.x;
+            y *= aVector2.y;
+        }
+
+        constexpr Vector2 operator*(const float& aScale) const
+        {
+            return Vector2(x * aScale, y * aScale);
+        }
+
+        void operator*=(const float& aScale)
+        {
+            x *= aScale;
+            y *= aScale;
+        }
+
+        constexpr Vector2 operator/(const Vector2& aVector2) const
+        {
+            return Vector2(x / aVector2.x, y / aVector2.y);
+        }
+
+        void operator/=(const Vector2& aVector2)
+        {
+            x /= aVector2.x;
+            y /= aVector2.y;
+        }
+
+        constexpr Vector2 operator/(const float& aScale) const
+        {
+            return Vector2(x / aScale, y / aScale);
+        }
+
+        void operator/=(const float& aScale)
+        {
+            x /= aScale;
+            y /= aScale;
+        }
+
+        constexpr Vector2 operator-() const
+        {
+            return Vector2(-x, -y);
+        }
+
+        constexpr bool operator==(const Vector2& aVector2) const
+        {
+            return x == aVector2.x && y == aVector2.y;
+        }
+
+        constexpr bool operator!=(const Vector2& aVector2) const
+        {
+            return x != aVector2.x || y != aVector2.y;
+        }
+
+        constexpr bool operator<(const Vector2& aVector2) const
+        {
+            return (x == aVector2.x) ? (y < aVector2.y) : (x < aVector2.x);
+        }
+
+        constexpr bool operator<=(const Vector2& aVector2) const
+        {
+            return (x == aVector2.x) ? (y <= aVector2.y) : (x <= aVector2.x);
+        }
+
+        constexpr bool operator>(const Vector2& aVector2) const
+        {
+            return (x == aVector2.x) ? (y > aVector2.y) : (x > aVector2.x);
+        }
+
+        constexpr bool operator>=(const Vector2& aVector2) const
+        {
+            return (x == aVector2.x) ? (y >= aVector2.y) : (x >= aVector2.x);
+        }
 
         //Member variables
         float x;
@@ -94,5 +219,8 @@ namespace GameDev2D
     };
 
 
-	Vector2 operator* (float scale, const Vector2& vector2);
+	constexpr Vector2 operator* (float aScale, const Vector2& aVector2)
+	{
+		return Vector2(aVector2.x * aScale, aVector2.y * aScale);
+	}
 }
@@ -0,0 +1,204 @@
+#include "Vector2Kernels.h"
+#include "TransformKernels.h"
+#include "Simd.h"
+#include <math.h>
+
+
+namespace GameDev2D
+{
+    //The number of angles Rotate() computes the sine and cosine of at a time
+    const unsigned int VECTOR2_KERNELS_ROTATE_CHUNK = 64;
+
+    void Vector2Kernels::Add(const float* aAx, const float* aAy, const float* aBx, const float* aBy, float* aOutX, float* aOutY, unsigned int aCount)
+    {
+        unsigned int i = 0;
+
+#if SIMD_SSE2
+        for (; i + 4 <= aCount; i += 4)
+        {
+            __m128 x = _mm_add_ps(_mm_loadu_ps(aAx + i), _mm_loadu_ps(aBx + i));
+            __m128 y = _mm_add_ps(_mm_loadu_ps(aAy + i), _mm_loadu_ps(aBy + i));
+            _mm_storeu_ps(aOutX + i, x);
+            _mm_storeu_ps(aOutY + i, y);
+        }
+#endif
+
+        AddScalar(aAx + i, aAy + i, aBx + i, aBy + i, aOutX + i, aOutY + i, aCount - i);
+    }
+
+    void Vector2Kernels::Scale(const float* aX, const float* aY, float aScale, float* aOutX, float* aOutY, unsigned int aCount)
+    {
+        unsigned int i = 0;
+
+#if SIMD_SSE2
+        const __m128 scale = _mm_set1_ps(aScale);
+        for (; i + 4 <= aCount; i += 4)
+        {
+            __m128 x = _mm_mul_ps(_mm_loadu_ps(aX + i), scale);
+            __m128 y = _mm_mul_ps(_mm_loadu_ps(aY + i), scale);
+            _mm_storeu_ps(aOutX + i, x);
+            _mm_storeu_ps(aOutY + i, y);
+        }
+#endif
+
+        ScaleScalar(aX + i, aY + i, aScale, aOutX + i, aOutY + i, aCount - i);
+    }
+
+    void Vector2Kernels::Normalize(const float* aX, const float* aY, float* aOutX, float* aOutY, unsigned int aCount)
+    {
+        unsigned int i = 0;
+
+#if SIMD_SSE2
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= aCount; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(aX + i);
+            __m128 y = _mm_loadu_ps(aY + i);
+            __m128 lengthSquared = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+            __m128 length = _mm_sqrt_ps(lengthSquared);
+
+            //A zero vector isn't divided, it stays zero
+            __m128 isNonZero = _mm_cmpneq_ps(lengthSquared, zero);
+            x = _mm_or_ps(_mm_and_ps(isNonZero, _mm_div_ps(x, length)), _mm_andnot_ps(isNonZero, x));
+            y = _mm_or_ps(_mm_and_ps(isNonZero, _mm_div_ps(y, length)), _mm_andnot_ps(isNonZero, y));
+            _mm_storeu_ps(aOutX + i, x);
+            _mm_storeu_ps(aOutY + i, y);
+        }
+#endif
+
+        NormalizeScalar(aX + i, aY + i, aOutX + i, aOutY + i, aCount - i);
+    }
+
+    void Vector2Kernels::Length(const float* aX, const float* aY, float* aLengths, unsigned int aCount)
+    {
+        unsigned int i = 0;
+
+#if SIMD_SSE2
+        for (; i + 4 <= aCount; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(aX + i);
+            __m128 y = _mm_loadu_ps(aY + i);
+            _mm_storeu_ps(aLengths + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y))));
+        }
+#endif
+
+        LengthScalar(aX + i, aY + i, aLengths + i, aCount - i);
+    }
+
+    void Vector2Kernels::DotProduct(const float* aAx, const float* aAy, const float* aBx, const float* aBy, float* aDotProducts, unsigned int aCount)
+    {
+        unsigned int i = 0;
+
+#if SIMD_SSE2
+        for (; i + 4 <= aCount; i += 4)
+        {
+            __m128 x = _mm_mul_ps(_mm_loadu_ps(aAx + i), _mm_loadu_ps(aBx + i));
+            __m128 y = _mm_mul_ps(_mm_loadu_ps(aAy + i), _mm_loadu_ps(aBy + i));
+            _mm_storeu_ps(aDotProducts + i, _mm_add_ps(x, y));
+        }
+#endif
+
+        DotProductScalar(aAx + i, aAy + i, aBx + i, aBy + i, aDotProducts + i, aCount - i);
+    }
+
+    void Vector2Kernels::Rotate(const float* aX, const float* aY, const float* aRadians, float* aOutX, float* aOutY, unsigned int aCount)
+    {
+#if SIMD_SSE2
+        float sines[VECTOR2_KERNELS_ROTATE_CHUNK];
+        float cosines[VECTOR2_KERNELS_ROTATE_CHUNK];
+
+        for (unsigned int i = 0; i < aCount; i += VECTOR2_KERNELS_ROTATE_CHUNK)
+        {
+            unsigned int count = aCount - i < VECTOR2_KERNELS_ROTATE_CHUNK ? aCount - i : VECTOR2_KERNELS_ROTATE_CHUNK;
+            TransformKernels::SinCos(aRadians + i, sines, cosines, count);
+
+            unsigned int j = 0;
+            for (; j + 4 <= count; j += 4)
+            {
+                __m128 x = _mm_loadu_ps(aX + i + j);
+                __m128 y = _mm_loadu_ps(aY + i + j);
+                __m128 s = _mm_loadu_ps(sines + j);
+                __m128 c = _mm_loadu_ps(cosines + j);
+                _mm_storeu_ps(aOutX + i + j, _mm_sub_ps(_mm_mul_ps(x, c), _mm_mul_ps(y, s)));
+                _mm_storeu_ps(aOutY + i + j, _mm_add_ps(_mm_mul_ps(x, s), _mm_mul_ps(y, c)));
+            }
+
+            for (; j < count; j++)
+            {
+                float x = aX[i + j];
+                float y = aY[i + j];
+                aOutX[i + j] = x * cosines[j] - y * sines[j];
+                aOutY[i + j] = x * sines[j] + y * cosines[j];
+            }
+        }
+#else
+        RotateScalar(aX, aY, aRadians, aOutX, aOutY, aCount);
+#endif
+    }
+
+    void Vector2Kernels::AddScalar(const float* aAx, const float* aAy, const float* aBx, const float* aBy, float* aOutX, float* aOutY, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            aOutX[i] = aAx[i] + aBx[i];
+            aOutY[i] = aAy[i] + aBy[i];
+        }
+    }
+
+    void Vector2Kernels::ScaleScalar(const float* aX, const float* aY, float aScale, float* aOutX, float* aOutY, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            aOutX[i] = aX[i] * aScale;
+            aOutY[i] = aY[i] * aScale;
+        }
+    }
+
+    void Vector2Kernels::NormalizeScalar(const float* aX, const float* aY, float* aOutX, float* aOutY, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            float x = aX[i];
+            float y = aY[i];
+            float length = x * x + y * y;
+            if (length != 0)
+            {
+                length = sqrtf(length);
+                x /= length;
+                y /= length;
+            }
+
+            aOutX[i] = x;
+            aOutY[i] = y;
+        }
+    }
+
+    void Vector2Kernels::LengthScalar(const float* aX, const float* aY, float* aLengths, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            aLengths[i] = sqrtf(aX[i] * aX[i] + aY[i] * aY[i]);
+        }
+    }
+
+    void Vector2Kernels::DotProductScalar(const float* aAx, const float* aAy, const float* aBx, const float* aBy, float* aDotProducts, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            aDotProducts[i] = aAx[i] * aBx[i] + aAy[i] * aBy[i];
+        }
+    }
+
+    void Vector2Kernels::RotateScalar(const float* aX, const float* aY, const float* aRadians, float* aOutX, float* aOutY, unsigned int aCount)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            float s = sinf(aRadians[i]);
+            float c = cosf(aRadians[i]);
+            float x = aX[i];
+            float y = aY[i];
+            aOutX[i] = x * c - y * s;
+            aOutY[i] = x * s + y * c;
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+
+namespace GameDev2D
+{
+    //The Vector2Kernels operate on arrays of vectors, stored as an array of x components and an array of y components.
+    //Each kernel has an SSE2 version (used when the target supports it) that processes four vectors at a time, and a
+    //scalar reference version. Apart from Rotate(), the kernels return the exact same results as the matching Vector2
+    //methods. The output arrays can be the same as the input arrays, to operate on the vectors in place
+    struct Vector2Kernels
+    {
+        //Adds two arrays of vectors
+        static void Add(const float* ax, const float* ay, const float* bx, const float* by, float* outX, float* outY, unsigned int count);
+
+        //Multiplies every vector by a scale
+        static void Scale(const float* x, const float* y, float scale, float* outX, float* outY, unsigned int count);
+
+        //Normalizes every vector, like Vector2::Normalize() a zero vector stays zero
+        static void Normalize(const float* x, const float* y, float* outX, float* outY, unsigned int count);
+
+        //Calculates the length (magnitude) of every vector
+        static void Length(const float* x, const float* y, float* lengths, unsigned int count);
+
+        //Calculates the dot product of two arrays of vectors
+        static void DotProduct(const float* ax, const float* ay, const float* bx, const float* by, float* dotProducts, unsigned int count);
+
+        //Rotates every vector counterclockwise by its angle, in radians. The SSE2 version uses the TransformKernels'
+        //sine and cosine, its results differ from the scalar version's by about a float's precision
+        static void Rotate(const float* x, const float* y, const float* radians, float* outX, float* outY, unsigned int count);
+
+        //Scalar reference versions of the kernels
+        static void AddScalar(const float* ax, const float* ay, const float* bx, const float* by, float* outX, float* outY, unsigned int count);
+        static void ScaleScalar(const float* x, const float* y, float scale, float* outX, float* outY, unsigned int count);
+        static void NormalizeScalar(const float* x, const float* y, float* outX, float* outY, unsigned int count);
+        static void LengthScalar(const float* x, const float* y, float* lengths, unsigned int count);
+        static void DotProductScalar(const float* ax, const float* ay, const float* bx, const float* by, float* dotProducts, unsigned int count);
+        static void RotateScalar(const float* x, const float* y, const float* radians, float* outX, float* outY, unsigned int count);
+    };
+}
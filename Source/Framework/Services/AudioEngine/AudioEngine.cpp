@@ -1,77 +1,156 @@
 #include "AudioEngine.h"
 #include "../Services.h"
+#include "../../Audio/XAudio2AudioSink.h"
 #include "../../Events/UpdateEvent.h"
-#include <assert.h>
-#include <xaudio2.h>
-#pragma comment(lib, "Xaudio2")
+#include "../../GameDev2D_Settings.h"
+#include <string.h>
 
 namespace GameDev2D
 {
 	AudioEngine::AudioEngine() :
-		m_Engine(nullptr),
-		m_MasteringVoice(nullptr),
-		m_Callback()
+		m_Mixer(AUDIO_SAMPLE_RATE, AUDIO_MAX_VOICES),
+		m_Sink(nullptr)
 	{
-		//Create the engine
-		HRESULT result = XAudio2Create(&m_Engine);
-		assert(SUCCEEDED(result));
-
-		//Create the mastering voice
-		result = m_Engine->CreateMasteringVoice(&m_MasteringVoice);
-		assert(SUCCEEDED(result));
+		//Select the audio sink
+		if (AUDIO_HEADLESS == 1)
+		{
+			SetSink(new NullAudioSink());
+		}
+		else if (strlen(AUDIO_OUTPUT_FILE) > 0)
+		{
+			SetSink(new WaveFileAudioSink(Services::GetApplication()->GetWorkingDirectory() + AUDIO_OUTPUT_FILE));
+		}
+		else
+		{
+			SetSink(new XAudio2AudioSink());
+		}
 
-		//Add events to listen for suspend and resume events
+		//Add events to listen for update, suspend and resume events
+		Services::GetApplication()->AddEventListener(this, UPDATE_EVENT);
 		Services::GetApplication()->AddEventListener(this, SUSPEND_EVENT);
 		Services::GetApplication()->AddEventListener(this, RESUME_EVENT);
 	}
 
 	AudioEngine::~AudioEngine()
 	{
+		Services::GetApplication()->RemoveEventListener(this, UPDATE_EVENT);
 		Services::GetApplication()->RemoveEventListener(this, SUSPEND_EVENT);
 		Services::GetApplication()->RemoveEventListener(this, RESUME_EVENT);
-		m_MasteringVoice->DestroyVoice();
-		m_Engine->Release();
+
+		//Close the sink first, so that nothing is mixing while the one-shots' wave data is released
+		if (m_Sink != nullptr)
+		{
+			m_Sink->Close();
+			delete m_Sink;
+			m_Sink = nullptr;
+		}
+
+		ReleaseOneShots(true);
 	}
 
 	void AudioEngine::HandleEvent(Event* aEvent)
 	{
 		if (aEvent != nullptr)
 		{
-			if (aEvent->GetEventCode() == SUSPEND_EVENT)
+			if (aEvent->GetEventCode() == UPDATE_EVENT)
 			{
-				m_Engine->StopEngine();
+				UpdateEvent* updateEvent = (UpdateEvent*)aEvent;
+				m_Sink->Update(updateEvent->GetDelta());
+
+				//Send the playback events that were queued while mixing, on the main thread
+				m_Mixer.DispatchNotifications();
+				ReleaseOneShots(false);
+			}
+			else if (aEvent->GetEventCode() == SUSPEND_EVENT)
+			{
+				m_Sink->Suspend();
 			}
 			else if (aEvent->GetEventCode() == RESUME_EVENT)
 			{
-				m_Engine->StartEngine();
+				m_Sink->Resume();
 			}
 		}
 	}
 
-	void AudioEngine::CreateAudioVoice(IXAudio2SourceVoice** aSource, WAVEFORMATEX* aWaveFormat)
+	AudioMixer* AudioEngine::GetMixer()
+	{
+		return &m_Mixer;
+	}
+
+	void AudioEngine::SetSink(AudioSink* aSink)
+	{
+		if (m_Sink != nullptr)
+		{
+			m_Sink->Close();
+			delete m_Sink;
+			m_Sink = nullptr;
+		}
+
+		if (aSink != nullptr && aSink->Open(&m_Mixer) == true)
+		{
+			m_Sink = aSink;
+			return;
+		}
+
+		//Fall back to the null sink, so that the audio still plays (silently) and its events are still dispatched
+		Log::Error(false, Log::Verbosity_Audio, "[AudioEngine] Failed to open the audio sink, audio will not be output");
+		delete aSink;
+		m_Sink = new NullAudioSink();
+		m_Sink->Open(&m_Mixer);
+	}
+
+	AudioSink* AudioEngine::GetSink()
 	{
-		HRESULT result = m_Engine->CreateSourceVoice(aSource, aWaveFormat, 0, XAUDIO2_DEFAULT_FREQ_RATIO, &m_Callback, nullptr, nullptr);
-		assert(SUCCEEDED(result));
+		return m_Sink;
 	}
 
-	void AudioEngine::DestroyAudioVoice(IXAudio2SourceVoice* aSource)
+	void AudioEngine::PlayOneShot(const std::string& aFilename, float aVolume, float aFrequencyRatio)
 	{
-		if (aSource != nullptr)
+		OneShot oneShot;
+		oneShot.waveHandle = Services::GetResourceManager()->AcquireWaveData(aFilename);
+
+		AudioSource source;
+		WaveData* waveData = Services::GetResourceManager()->GetWaveData(oneShot.waveHandle);
+		if (waveData->GetAudioSource(source) == true)
+		{
+			oneShot.voice = m_Mixer.PlayOneShot(source, aVolume, aFrequencyRatio);
+		}
+
+		//If the voice wasn't created, the wave data can be released right away
+		if (m_Mixer.IsValid(oneShot.voice) == false)
 		{
-			aSource->DestroyVoice();
-			aSource = nullptr;
+			Services::GetResourceManager()->ReleaseWaveData(oneShot.waveHandle);
+			return;
 		}
+
+		m_OneShots.push_back(oneShot);
 	}
 
 	void AudioEngine::SetVolume(float aVolume)
 	{
-		m_MasteringVoice->SetVolume(aVolume);
+		m_Mixer.SetMasterVolume(aVolume);
 	}
 
 	float AudioEngine::GetVolume()
 	{
-		float volume = 0.0f;
-		m_MasteringVoice->GetVolume(&volume);
-		return volume;
+		return m_Mixer.GetMasterVolume();
+	}
+
+	void AudioEngine::ReleaseOneShots(bool aReleaseAll)
+	{
+		//A one-shot voice is destroyed by the mixer's DispatchNotifications() once it ends, which makes its handle stale
+		for (unsigned int i = 0; i < m_OneShots.size(); )
+		{
+			if (aReleaseAll == true || m_Mixer.IsValid(m_OneShots[i].voice) == false)
+			{
+				Services::GetResourceManager()->ReleaseWaveData(m_OneShots[i].waveHandle);
+				m_OneShots[i] = m_OneShots.back();
+				m_OneShots.pop_back();
+			}
+			else
+			{
+				i++;
+			}
+		}
 	}
-}
\ No newline at end of file
+}
@@ -1,29 +1,41 @@
 #pragma once
 
-#include "../../Audio/AudioTypes.h"
+#include "../../Audio/AudioMixer.h"
+#include "../../Audio/AudioSink.h"
 #include "../../Events/EventHandler.h"
-#include "../../Debug/Log.h"
-#include <xaudio2.h>
+#include "../ResourceManager/ResourceHandle.h"
+#include <string>
+#include <vector>
 
-struct IXAudio2;
-struct IXAudio2MasteringVoice;
 
 namespace GameDev2D
 {
+	//The AudioEngine owns the AudioMixer that every Audio object plays through, and the AudioSink that outputs the mixed audio.
+	//By default the sink is an XAudio2AudioSink, the AUDIO_HEADLESS and AUDIO_OUTPUT_FILE settings select the NullAudioSink and
+	//WaveFileAudioSink instead. The voice notifications the mixer queues while mixing are dispatched on the main thread, once per
+	//frame, during the UPDATE_EVENT
 	class AudioEngine : public EventHandler
 	{
 	public:
 		AudioEngine();
 		~AudioEngine();
 
-		//
+		//Handles the update, suspend and resume events
 		void HandleEvent(Event* event);
 
-		//
-		void CreateAudioVoice(IXAudio2SourceVoice** source, WAVEFORMATEX* waveFormat);
+		//Returns the mixer that the audio is played through
+		AudioMixer* GetMixer();
 
-		//
-		void DestroyAudioVoice(IXAudio2SourceVoice* source);
+		//Replaces the audio sink, the AudioEngine takes ownership of the sink and opens it. If the sink fails to
+		//open, the audio is mixed through a NullAudioSink instead
+		void SetSink(AudioSink* sink);
+
+		//Returns the audio sink
+		AudioSink* GetSink();
+
+		//Plays a wave file once, on a pooled voice, the wave data is kept loaded until it finishes playing.
+		//Use this for short fire and forget sound effects that don't need an Audio object
+		void PlayOneShot(const std::string& filename, float volume = 1.0f, float frequencyRatio = 1.0f);
 
 		//Set the volume for all the audio files being played, range 0.0f to 1.0f
 		void SetVolume(float volume);
@@ -32,8 +44,19 @@ namespace GameDev2D
 		float GetVolume();
 
 	private:
-		IXAudio2* m_Engine;
-		IXAudio2MasteringVoice* m_MasteringVoice;
-		AudioCallback m_Callback;
+		//Releases the wave data of the one-shots that have finished playing
+		void ReleaseOneShots(bool releaseAll);
+
+		//A one-shot voice and the wave data it plays
+		struct OneShot
+		{
+			AudioVoice voice;
+			WaveHandle waveHandle;
+		};
+
+		//Member variables
+		AudioMixer m_Mixer;
+		AudioSink* m_Sink;
+		std::vector<OneShot> m_OneShots;
 	};
-}
\ No newline at end of file
+}
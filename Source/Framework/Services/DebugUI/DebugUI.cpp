@@ -31,6 +31,14 @@ namespace GameDev2D
 		WatchVector2(std::bind(&Mouse::GetPosition, Services::GetInputManager()->GetMouse()));
 #endif
 
+#if DEBUG_DRAW_CULLED_COUNT
+        WatchUnsignedInt(std::bind(&Graphics::GetCulledCount, Services::GetGraphics()));
+#endif
+
+#if DEBUG_DRAW_DRAWN_COUNT
+        WatchUnsignedInt(std::bind(&Graphics::GetDrawnCount, Services::GetGraphics()));
+#endif
+
 		//WatchUnsignedLongLong(MyMemory_GetNumberOfBytesAllocated, true);
 	//	WatchUnsignedLongLong(MyMemory_GetNumberOfMemoryAllocations, false);
 
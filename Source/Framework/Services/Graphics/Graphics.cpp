@@ -26,7 +26,14 @@ namespace GameDev2D
         m_BoundFrameBufferId(0),
         m_BoundVertexArray(0),
         m_BoundDataBuffer(0),
-        m_Stats(Graphics::Stats())
+        m_Stats(Graphics::Stats()),
+        m_ViewMatrixUpdateCount(0),
+        m_ViewMatrixUpdateStart(0),
+        m_IsCullingEnabled(GRAPHICS_CULLING_ENABLED),
+        m_CulledCount(0),
+        m_DrawnCount(0),
+        m_FrameCulledCount(0),
+        m_FrameDrawnCount(0)
     {
         //Create the Camera object
 		PushCamera(Camera());
@@ -70,6 +77,19 @@ namespace GameDev2D
         return (unsigned int)(100 * version);
     }
     
+    void Graphics::BeginFrame()
+    {
+        //Count the view matrix updates of the previous frame
+        m_ViewMatrixUpdateCount = Camera::GetViewMatrixUpdateCount() - m_ViewMatrixUpdateStart;
+        m_ViewMatrixUpdateStart = Camera::GetViewMatrixUpdateCount();
+
+        //Record the previous frame's culling stats
+        m_CulledCount = m_FrameCulledCount;
+        m_DrawnCount = m_FrameDrawnCount;
+        m_FrameCulledCount = 0;
+        m_FrameDrawnCount = 0;
+    }
+
     void Graphics::Clear()
     {
         glClear(GL_COLOR_BUFFER_BIT);
@@ -78,7 +98,7 @@ namespace GameDev2D
     void Graphics::DrawTexture(Texture* aTexture, Vector2 aPosition, Rotation aAngle, float aAlpha)
     {
         //Initialize the local variables used in this method
-        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_TEXTURE_SHADER_KEY);
+        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_TEXTURE_SHADER_ID);
         Color color = Color::WhiteColor(aAlpha);
         Matrix transformation = Matrix::Make(aPosition, aAngle.GetRadians());
 
@@ -220,7 +240,7 @@ namespace GameDev2D
     void Graphics::DrawRectangle(Vector2 aPosition, Vector2 aSize, Rotation aAngle, Vector2 aAnchor, Color aColor, bool aIsFilled)
     {
         //Initialize the local variables used in this method
-        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY);
+        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_ID);
         Matrix transformation = Matrix::Make(aPosition, aAngle.GetRadians());
 
         //If the textured VertexData object hasn't been created yet, then, well... Create it!
@@ -282,7 +302,7 @@ namespace GameDev2D
     void Graphics::DrawCircle(Vector2 aPosition, float aRadius, Vector2 aAnchor, Color aColor, bool aIsFilled)
     {
         //Initialize the local variables used in this method
-        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY);
+        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_ID);
         Matrix transformation = Matrix::MakeTranslation(aPosition);
 
         //If the textured VertexData object hasn't been created yet, then, well... Create it!
@@ -348,7 +368,7 @@ namespace GameDev2D
     void Graphics::DrawLine(Vector2 aStartPoint, Vector2 aEndPoint, Color aColor)
     {
         //Initialize the local variables used in this method
-        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY);
+        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_ID);
 
         //If the textured VertexData object hasn't been created yet, then, well... Create it!
         if (m_PolygonVertexData == nullptr)
@@ -417,16 +437,71 @@ namespace GameDev2D
         glDrawElements(renderMode, aCount, type, aIndices);
     }
 
-    Matrix Graphics::GetProjectionMatrix()
+    const Matrix& Graphics::GetProjectionMatrix()
     {
         return GetActiveCamera()->GetProjectionMatrix();
     }
 
-    Matrix Graphics::GetViewMatrix()
+    const Matrix& Graphics::GetViewMatrix()
     {
         return GetActiveCamera()->GetViewMatrix();
     }
 
+    const Matrix& Graphics::GetViewProjectionMatrix()
+    {
+        return GetActiveCamera()->GetViewProjectionMatrix();
+    }
+
+    unsigned int Graphics::GetViewMatrixUpdateCount()
+    {
+        return m_ViewMatrixUpdateCount;
+    }
+
+    void Graphics::SetCullingEnabled(bool aIsCullingEnabled)
+    {
+        m_IsCullingEnabled = aIsCullingEnabled;
+    }
+
+    bool Graphics::IsCullingEnabled()
+    {
+        return m_IsCullingEnabled;
+    }
+
+    bool Graphics::IsVisible(float aLeft, float aRight, float aBottom, float aTop)
+    {
+        const Rect& visibleRect = GetActiveCamera()->GetVisibleRect();
+        return aLeft < visibleRect.origin.x + visibleRect.size.x && aRight > visibleRect.origin.x &&
+               aBottom < visibleRect.origin.y + visibleRect.size.y && aTop > visibleRect.origin.y;
+    }
+
+    bool Graphics::Cull(Drawable* aDrawable)
+    {
+        if (m_IsCullingEnabled == true && IsVisible(aDrawable->GetLeftEdge(), aDrawable->GetRightEdge(), aDrawable->GetBottomEdge(), aDrawable->GetTopEdge()) == false)
+        {
+            m_FrameCulledCount++;
+            return true;
+        }
+
+        m_FrameDrawnCount++;
+        return false;
+    }
+
+    void Graphics::AddCullingStats(unsigned int aCulled, unsigned int aDrawn)
+    {
+        m_FrameCulledCount += aCulled;
+        m_FrameDrawnCount += aDrawn;
+    }
+
+    unsigned int Graphics::GetCulledCount()
+    {
+        return m_CulledCount;
+    }
+
+    unsigned int Graphics::GetDrawnCount()
+    {
+        return m_DrawnCount;
+    }
+
     Camera* Graphics::GetActiveCamera()
     {
         return &m_CameraStack.back();
@@ -14,6 +14,7 @@ namespace GameDev2D
 {
     //Forward declarations
     class Camera;
+    class Drawable;
     class SpriteFont;
     class SpriteBatch;
 
@@ -30,6 +31,9 @@ namespace GameDev2D
         //Returns the GLSL version
         unsigned int GetShadingLanguageVersion();
 
+        //Called by the Application at the start of every frame, the per-frame stats of the previous frame are recorded
+        void BeginFrame();
+
         //Clears the currently bound RenderTarget's back buffer
         void Clear();
 
@@ -54,9 +58,33 @@ namespace GameDev2D
         //Call the OpenGL DrawElements function
         void DrawElements(RenderMode aRenderMode, int aCount, GraphicType aType, const void* aIndices);
 
-        //Returns the active camera's projection and view matrices
-        Matrix GetProjectionMatrix();
-        Matrix GetViewMatrix();
+        //Returns the active camera's projection, view and view-projection matrices. The matrices are cached by the
+        //Camera, the references are valid until the camera stack is pushed OR popped
+        const Matrix& GetProjectionMatrix();
+        const Matrix& GetViewMatrix();
+        const Matrix& GetViewProjectionMatrix();
+
+        //Returns the number of view matrices that were recalculated during the last frame
+        unsigned int GetViewMatrixUpdateCount();
+
+        //Enables and disables culling, when culling is enabled the Drawables outside the active Camera's view are skipped
+        //by their Draw() methods, before any uniforms are set OR vertices are batched
+        void SetCullingEnabled(bool isCullingEnabled);
+        bool IsCullingEnabled();
+
+        //Returns wether a region, given by its edges in world space, overlaps the active Camera's view
+        bool IsVisible(float left, float right, float bottom, float top);
+
+        //Returns true if culling is enabled and the Drawable's edges are outside the active Camera's view, in which case
+        //the Drawable shouldn't be drawn. The Drawable is counted as culled OR drawn in the frame's stats
+        bool Cull(Drawable* drawable);
+
+        //Adds to the number of objects that were culled and drawn this frame, used by the draw paths that cull their own objects
+        void AddCullingStats(unsigned int culled, unsigned int drawn);
+
+        //Returns the number of objects that were culled and drawn during the last frame
+        unsigned int GetCulledCount();
+        unsigned int GetDrawnCount();
 
         //Returns the active  Camera
         Camera* GetActiveCamera();
@@ -268,6 +296,13 @@ namespace GameDev2D
         unsigned int m_BoundDataBuffer;
         std::vector<Rect> m_ScissorStack; 
         Stats m_Stats;
+        unsigned int m_ViewMatrixUpdateCount;
+        unsigned int m_ViewMatrixUpdateStart;
+        bool m_IsCullingEnabled;
+        unsigned int m_CulledCount;
+        unsigned int m_DrawnCount;
+        unsigned int m_FrameCulledCount;
+        unsigned int m_FrameDrawnCount;
     };
 }
 
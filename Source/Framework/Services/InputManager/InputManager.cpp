@@ -7,7 +7,11 @@
 
 namespace GameDev2D
 {
+    //The number of input events the queue is reserved for, so that a busy frame doesn't have to grow it
+    const unsigned int INPUT_MANAGER_QUEUE_RESERVE = 256;
+
     InputManager::InputManager() : EventHandler(),
+        m_InputQueue(INPUT_MANAGER_QUEUE_RESERVE),
         m_Keyboard(nullptr),
         m_Mouse(nullptr)
     {
@@ -71,6 +75,9 @@ namespace GameDev2D
 
     void InputManager::Update(double aDelta)
     {
+        //Deliver the input that was queued since the last update
+        DeliverQueuedInput();
+
         //Update the Keyboard
         if (m_Keyboard != nullptr)
         {
@@ -114,6 +121,16 @@ namespace GameDev2D
         return m_GamePads[aPort];
     }
     
+    unsigned int InputManager::GetRawInputEventCount()
+    {
+        return m_InputQueue.GetRawEventCount();
+    }
+
+    unsigned int InputManager::GetDeliveredInputEventCount()
+    {
+        return m_InputQueue.GetDeliveredEventCount();
+    }
+
     void InputManager::HandleKeyDown(unsigned int aKey)
     {
         //Ensure the application hasn't been suspended
@@ -122,11 +139,8 @@ namespace GameDev2D
             return;
         }
 
-        //Have the Keyboard handle the key up
-        if (m_Keyboard != nullptr)
-        {
-            m_Keyboard->HandleKeyDown(static_cast<Keyboard::Key>(aKey));
-        }
+        //Queue the key down
+        m_InputQueue.Queue(InputQueue::KeyDownInput, aKey, 0.0f, 0.0f, 0.0f, 0.0f);
     }
 
     void InputManager::HandleKeyUp(unsigned int aKey)
@@ -137,83 +151,80 @@ namespace GameDev2D
             return;
         }
 
-        //Have the Keyboard handle the key up
-        if (m_Keyboard != nullptr)
-        {
-            m_Keyboard->HandleKeyUp(static_cast<Keyboard::Key>(aKey));
-        }
+        //Queue the key up
+        m_InputQueue.Queue(InputQueue::KeyUpInput, aKey, 0.0f, 0.0f, 0.0f, 0.0f);
     }
     
     void InputManager::HandleLeftMouseDown(float aX, float aY)
     {
         //Ensure the application hasn't been suspended
-        if(Services::GetApplication()->IsSuspended() == true)
+        if (Services::GetApplication()->IsSuspended() == true)
         {
             return;
         }
-    
-        //Set that the left mouse button is pressed
-        m_Mouse->HandleButtonDown(Mouse::Left);
+
+        //Queue that the left mouse button is pressed
+        m_InputQueue.Queue(InputQueue::MouseDownInput, Mouse::Left, aX, aY, 0.0f, 0.0f);
     }
     
     void InputManager::HandleLeftMouseUp(float aX, float aY)
     {
         //Ensure the application hasn't been suspended
-        if(Services::GetApplication()->IsSuspended() == true)
+        if (Services::GetApplication()->IsSuspended() == true)
         {
             return;
         }
 
-        //Set that the left mouse button is pressed
-        m_Mouse->HandleButtonUp(Mouse::Left);
+        //Queue that the left mouse button is released
+        m_InputQueue.Queue(InputQueue::MouseUpInput, Mouse::Left, aX, aY, 0.0f, 0.0f);
     }
     
     void InputManager::HandleCenterMouseDown(float aX, float aY)
     {
         //Ensure the application hasn't been suspended
-        if(Services::GetApplication()->IsSuspended() == true)
+        if (Services::GetApplication()->IsSuspended() == true)
         {
             return;
         }
-    
-        //Set that the left mouse button is pressed
-        m_Mouse->HandleButtonDown(Mouse::Center);
+
+        //Queue that the center mouse button is pressed
+        m_InputQueue.Queue(InputQueue::MouseDownInput, Mouse::Center, aX, aY, 0.0f, 0.0f);
     }
     
     void InputManager::HandleCenterMouseUp(float aX, float aY)
     {
         //Ensure the application hasn't been suspended
-        if(Services::GetApplication()->IsSuspended() == true)
+        if (Services::GetApplication()->IsSuspended() == true)
         {
             return;
         }
-    
-        //Set that the left mouse button is pressed
-        m_Mouse->HandleButtonUp(Mouse::Center);
+
+        //Queue that the center mouse button is released
+        m_InputQueue.Queue(InputQueue::MouseUpInput, Mouse::Center, aX, aY, 0.0f, 0.0f);
     }
     
     void InputManager::HandleRightMouseDown(float aX, float aY)
     {
         //Ensure the application hasn't been suspended
-        if(Services::GetApplication()->IsSuspended() == true)
+        if (Services::GetApplication()->IsSuspended() == true)
         {
             return;
         }
-    
-        //Set that the left mouse button is pressed
-        m_Mouse->HandleButtonDown(Mouse::Right);
+
+        //Queue that the right mouse button is pressed
+        m_InputQueue.Queue(InputQueue::MouseDownInput, Mouse::Right, aX, aY, 0.0f, 0.0f);
     }
     
     void InputManager::HandleRightMouseUp(float aX, float aY)
     {
         //Ensure the application hasn't been suspended
-        if(Services::GetApplication()->IsSuspended() == true)
+        if (Services::GetApplication()->IsSuspended() == true)
         {
             return;
         }
-    
-        //Set that the left mouse button is pressed
-        m_Mouse->HandleButtonUp(Mouse::Right);
+
+        //Queue that the right mouse button is released
+        m_InputQueue.Queue(InputQueue::MouseUpInput, Mouse::Right, aX, aY, 0.0f, 0.0f);
     }
     
     void InputManager::HandleMouseMoved(float aX, float aY, float aDeltaX, float aDeltaY)
@@ -224,19 +235,72 @@ namespace GameDev2D
             return;
         }
 
-        //Set the mouse data's position
-        m_Mouse->HandleMouseMoved(Vector2(aX, aY), Vector2(aDeltaX, aDeltaY));
+        //Queue the mouse's new position
+        m_InputQueue.Queue(InputQueue::MouseMovedInput, 0, aX, aY, aDeltaX, aDeltaY);
     }
     
     void InputManager::HandleScrollWheel(float aDelta)
     {
         //Ensure the application hasn't been suspended
-        if(Services::GetApplication()->IsSuspended() == true)
+        if (Services::GetApplication()->IsSuspended() == true)
         {
             return;
         }
 
-        //Pass the scroll information onto the Mouse
-        m_Mouse->HandleScroll(aDelta);
+        //Queue the scroll information
+        m_InputQueue.Queue(InputQueue::ScrollWheelInput, 0, 0.0f, 0.0f, aDelta, 0.0f);
+    }
+
+    void InputManager::DeliverQueuedInput()
+    {
+        //Input that is queued while the queue is delivered is delivered as well, the queue is cleared once it's all delivered
+        InputQueue::InputRecord record;
+        while (m_InputQueue.DeliverNext(record) == true)
+        {
+            switch (record.type)
+            {
+                case InputQueue::KeyDownInput:
+                    if (m_Keyboard != nullptr)
+                    {
+                        m_Keyboard->HandleKeyDown(static_cast<Keyboard::Key>(record.code));
+                    }
+                    break;
+
+                case InputQueue::KeyUpInput:
+                    if (m_Keyboard != nullptr)
+                    {
+                        m_Keyboard->HandleKeyUp(static_cast<Keyboard::Key>(record.code));
+                    }
+                    break;
+
+                case InputQueue::MouseDownInput:
+                    if (m_Mouse != nullptr)
+                    {
+                        m_Mouse->HandleButtonDown(static_cast<Mouse::Button>(record.code));
+                    }
+                    break;
+
+                case InputQueue::MouseUpInput:
+                    if (m_Mouse != nullptr)
+                    {
+                        m_Mouse->HandleButtonUp(static_cast<Mouse::Button>(record.code));
+                    }
+                    break;
+
+                case InputQueue::MouseMovedInput:
+                    if (m_Mouse != nullptr)
+                    {
+                        m_Mouse->HandleMouseMoved(Vector2(record.x, record.y), Vector2(record.deltaX, record.deltaY));
+                    }
+                    break;
+
+                case InputQueue::ScrollWheelInput:
+                    if (m_Mouse != nullptr)
+                    {
+                        m_Mouse->HandleScroll(record.deltaX);
+                    }
+                    break;
+            }
+        }
     }
 }
\ No newline at end of file
@@ -5,8 +5,10 @@
 #include "../../Input/Keyboard.h"
 #include "../../Input/Mouse.h"
 #include "../../Input/GamePad.h"
+#include "../../Input/InputQueue.h"
 #include "../../Math/Vector2.h"
 #include <map>
+#include <vector>
 
 
 namespace GameDev2D
@@ -36,6 +38,10 @@ namespace GameDev2D
         //Returns the GamePad for a port, the GamePad the thumb stick, trigger and button states
         GamePad* GetGamePad(GamePad::Port port);
 
+        //The Handle methods below don't deliver the input straight away, they add it to a queue that is delivered in one
+        //batch at the start of the next Update. Consecutive mouse movements and scroll wheel changes are coalesced into one
+        //event and their deltas are accumulated. Key and button transitions are never coalesced and are delivered in order
+
         //Methods to handle Keyboard input
         void HandleKeyDown(unsigned int key);
         void HandleKeyUp(unsigned int key);
@@ -49,8 +55,18 @@ namespace GameDev2D
         void HandleRightMouseUp(float x, float y);
         void HandleMouseMoved(float x, float y, float deltaX, float deltaY);
         void HandleScrollWheel(float delta);
+
+        //Returns the number of input events that have been handled, and the number that were delivered after coalescing
+        unsigned int GetRawInputEventCount();
+        unsigned int GetDeliveredInputEventCount();
     
     private:
+        //Delivers the queued input events to the Keyboard and Mouse
+        void DeliverQueuedInput();
+
+        //The input that is queued until the next update
+        InputQueue m_InputQueue;
+
         //Keyboard data
         Keyboard* m_Keyboard;
         Mouse* m_Mouse;
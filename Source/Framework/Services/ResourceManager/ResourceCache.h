@@ -0,0 +1,334 @@
+#pragma once
+
+#include "ResourceHandle.h"
+#include "ResourceMap.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Templated class that owns the loaded resources of one type and reference counts them. Resources are handed
+    //out as generational ResourceHandles, when the last reference to a resource is released the resource isn't
+    //deleted, instead it's added to a least recently released list where it stays resident (and can be acquired
+    //again without any I/O) until the ResourceManager evicts it to stay within its memory budget.
+    template<typename T> class ResourceCache
+    {
+    public:
+        ResourceCache() :
+            m_Entries(1),
+            m_FreeIndex(0),
+            m_ReleasedHead(0),
+            m_ReleasedTail(0),
+            m_ResidentBytes(0),
+            m_ReleasedBytes(0),
+            m_ReleasedCount(0)
+        {
+        }
+
+        //Adds a loaded resource to the cache, it has no references yet. The size (in bytes) is used to enforce the memory budget.
+        //Returns false if the key's ResourceId collides with a resident resource's key, the resource isn't added
+        bool Add(const std::string& key, T* resource, unsigned long long size, unsigned long long tick)
+        {
+            unsigned int index = m_FreeIndex != 0 ? m_FreeIndex : (unsigned int)m_Entries.size();
+            if (m_Indices.Create(key, index) == false)
+            {
+                return false;
+            }
+
+            if (index == m_FreeIndex)
+            {
+                m_FreeIndex = m_Entries[index].next;
+            }
+            else
+            {
+                m_Entries.push_back(Entry());
+            }
+
+            Entry& entry = m_Entries[index];
+            entry.resource = resource;
+            entry.id = MakeResourceId(key);
+            entry.size = size;
+            entry.refCount = 0;
+            entry.isPinned = false;
+            if (resource != nullptr)
+            {
+                m_PointerIndices[resource] = index;
+            }
+            m_ResidentBytes += size;
+
+            //A resource without references is a released resource
+            LinkReleased(index, tick);
+            return true;
+        }
+
+        //Returns a handle to a resident resource and adds a reference to it, reviving it if it was released.
+        //If the resource isn't resident an invalid handle is returned
+        ResourceHandle<T> Acquire(ResourceId id)
+        {
+            unsigned int index = m_Indices.Get(id);
+            if (index == 0)
+            {
+                return ResourceHandle<T>();
+            }
+
+            AddReference(index);
+            return ResourceHandle<T>(index, m_Entries[index].generation);
+        }
+
+        //Returns a handle to a resident resource and adds a reference to it, for when a resource pointer is all that's
+        //available. If the resource isn't owned by the cache an invalid handle is returned
+        ResourceHandle<T> Acquire(const T* resource)
+        {
+            typename std::unordered_map<const T*, unsigned int>::const_iterator iterator = m_PointerIndices.find(resource);
+            if (iterator == m_PointerIndices.end())
+            {
+                return ResourceHandle<T>();
+            }
+
+            unsigned int index = iterator->second;
+            AddReference(index);
+            return ResourceHandle<T>(index, m_Entries[index].generation);
+        }
+
+        //Releases a reference to a resource and invalidates the handle, stale handles are ignored
+        void Release(ResourceHandle<T>& handle, unsigned long long tick)
+        {
+            if (IsCurrent(handle) == true)
+            {
+                RemoveReference(handle.index, tick);
+            }
+            handle = ResourceHandle<T>();
+        }
+
+        //Pins a resident resource, a pinned resource holds one reference until it is unpinned. Returns false if the resource isn't resident
+        bool Pin(ResourceId id)
+        {
+            unsigned int index = m_Indices.Get(id);
+            if (index == 0)
+            {
+                return false;
+            }
+
+            if (m_Entries[index].isPinned == false)
+            {
+                m_Entries[index].isPinned = true;
+                AddReference(index);
+            }
+            return true;
+        }
+
+        //Unpins a resident resource, releasing the reference its pin held
+        void Unpin(ResourceId id, unsigned long long tick)
+        {
+            unsigned int index = m_Indices.Get(id);
+            if (index != 0 && m_Entries[index].isPinned == true)
+            {
+                m_Entries[index].isPinned = false;
+                RemoveReference(index, tick);
+            }
+        }
+
+        //Returns the resource for the handle, or nullptr if the handle is invalid or stale
+        T* Get(const ResourceHandle<T>& handle) const
+        {
+            return IsCurrent(handle) == true ? m_Entries[handle.index].resource : nullptr;
+        }
+
+        //Returns the resident resource for the id, or nullptr if it isn't resident. No reference is added
+        T* Find(ResourceId id) const
+        {
+            return m_Entries[m_Indices.Get(id)].resource;
+        }
+
+        //Returns wether the resource is resident, released resources are resident until they are evicted
+        bool Contains(ResourceId id) const
+        {
+            return m_Indices.Contains(id);
+        }
+
+        //Returns the release tick of the least recently released resource, or ~0 if there are no released resources
+        unsigned long long GetOldestReleaseTick() const
+        {
+            return m_ReleasedHead != 0 ? m_Entries[m_ReleasedHead].releaseTick : ~0ULL;
+        }
+
+        //Removes the least recently released resource from the cache and returns it, the caller is responsible for
+        //deleting it. Any handle that still refers to it becomes stale. Returns nullptr if there are no released resources
+        T* EvictOldest()
+        {
+            unsigned int index = m_ReleasedHead;
+            if (index == 0)
+            {
+                return nullptr;
+            }
+
+            UnlinkReleased(index);
+
+            Entry& entry = m_Entries[index];
+            T* resource = entry.resource;
+            m_ResidentBytes -= entry.size;
+            m_Indices.Remove(entry.id);
+            m_PointerIndices.erase(resource);
+
+            //Bump the generation so that stale handles no longer resolve, 0 is reserved for the invalid handle
+            unsigned int generation = entry.generation + 1;
+            entry = Entry();
+            entry.generation = generation != 0 ? generation : 1;
+            entry.next = m_FreeIndex;
+            m_FreeIndex = index;
+
+            return resource;
+        }
+
+        //Returns the number of resident resources, including released resources
+        unsigned int Count() const
+        {
+            return m_Indices.Count();
+        }
+
+        //Returns the number of resident resources that are still referenced
+        unsigned int GetReferencedCount() const
+        {
+            return m_Indices.Count() - m_ReleasedCount;
+        }
+
+        //Returns the size, in bytes, of all the resident resources
+        unsigned long long GetResidentBytes() const
+        {
+            return m_ResidentBytes;
+        }
+
+        //Returns the size, in bytes, of the released resources
+        unsigned long long GetReleasedBytes() const
+        {
+            return m_ReleasedBytes;
+        }
+
+        //Deletes every resident resource, referenced or not
+        void Cleanup()
+        {
+            for (unsigned int i = 1; i < m_Entries.size(); i++)
+            {
+                if (m_Entries[i].resource != nullptr)
+                {
+                    delete m_Entries[i].resource;
+                    m_Entries[i].resource = nullptr;
+                }
+            }
+
+            m_Entries.clear();
+            m_Entries.resize(1);
+            m_Indices.Clear();
+            m_PointerIndices.clear();
+            m_FreeIndex = 0;
+            m_ReleasedHead = 0;
+            m_ReleasedTail = 0;
+            m_ResidentBytes = 0;
+            m_ReleasedBytes = 0;
+            m_ReleasedCount = 0;
+        }
+
+    private:
+        //An entry in the cache, released entries form a doubly linked list (through previous and next) ordered by
+        //release time, free entries form a singly linked list through next. Entry 0 is never used
+        struct Entry
+        {
+            Entry() : resource(nullptr), id(0), size(0), releaseTick(0), generation(1), refCount(0), previous(0), next(0), isPinned(false) {}
+
+            T* resource;
+            ResourceId id;
+            unsigned long long size;
+            unsigned long long releaseTick;
+            unsigned int generation;
+            unsigned int refCount;
+            unsigned int previous;
+            unsigned int next;
+            bool isPinned;
+        };
+
+        bool IsCurrent(const ResourceHandle<T>& handle) const
+        {
+            return handle.index != 0 && handle.index < m_Entries.size() && m_Entries[handle.index].generation == handle.generation && m_Entries[handle.index].resource != nullptr;
+        }
+
+        void AddReference(unsigned int index)
+        {
+            if (m_Entries[index].refCount == 0)
+            {
+                UnlinkReleased(index);
+            }
+            m_Entries[index].refCount++;
+        }
+
+        void RemoveReference(unsigned int index, unsigned long long tick)
+        {
+            if (m_Entries[index].refCount > 0 && --m_Entries[index].refCount == 0)
+            {
+                LinkReleased(index, tick);
+            }
+        }
+
+        //Adds the entry to the back of the released list
+        void LinkReleased(unsigned int index, unsigned long long tick)
+        {
+            Entry& entry = m_Entries[index];
+            entry.releaseTick = tick;
+            entry.previous = m_ReleasedTail;
+            entry.next = 0;
+
+            if (m_ReleasedTail != 0)
+            {
+                m_Entries[m_ReleasedTail].next = index;
+            }
+            else
+            {
+                m_ReleasedHead = index;
+            }
+            m_ReleasedTail = index;
+
+            m_ReleasedBytes += entry.size;
+            m_ReleasedCount++;
+        }
+
+        //Removes the entry from the released list
+        void UnlinkReleased(unsigned int index)
+        {
+            Entry& entry = m_Entries[index];
+            if (entry.previous != 0)
+            {
+                m_Entries[entry.previous].next = entry.next;
+            }
+            else
+            {
+                m_ReleasedHead = entry.next;
+            }
+
+            if (entry.next != 0)
+            {
+                m_Entries[entry.next].previous = entry.previous;
+            }
+            else
+            {
+                m_ReleasedTail = entry.previous;
+            }
+
+            entry.previous = 0;
+            entry.next = 0;
+            m_ReleasedBytes -= entry.size;
+            m_ReleasedCount--;
+        }
+
+        //Member variables
+        std::vector<Entry> m_Entries;
+        ResourceMap<unsigned int> m_Indices;
+        std::unordered_map<const T*, unsigned int> m_PointerIndices;
+        unsigned int m_FreeIndex;
+        unsigned int m_ReleasedHead;
+        unsigned int m_ReleasedTail;
+        unsigned long long m_ResidentBytes;
+        unsigned long long m_ReleasedBytes;
+        unsigned int m_ReleasedCount;
+    };
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+
+namespace GameDev2D
+{
+    //Forward declarations
+    class Texture;
+    class AtlasMap;
+    class AnimationClip;
+    struct FontData;
+    struct WaveData;
+
+    //A ResourceHandle refers to a resource that is owned by the ResourceManager, while a handle is held the resource
+    //is guaranteed to stay loaded. Every handle that is acquired from the ResourceManager MUST be released back to it.
+    //Handles are generational, once a resource is purged its slot's generation changes, so a stale handle resolves
+    //to the default resource instead of a dangling pointer
+    template<typename T> struct ResourceHandle
+    {
+        ResourceHandle() :
+            index(0),
+            generation(0)
+        {
+        }
+
+        ResourceHandle(unsigned int index, unsigned int generation) :
+            index(index),
+            generation(generation)
+        {
+        }
+
+        //Returns wether the handle refers to a resource, it doesn't check if the resource is still loaded
+        bool IsValid() const
+        {
+            return index != 0;
+        }
+
+        unsigned int index;
+        unsigned int generation;
+    };
+
+    //Handle types for each kind of resource
+    typedef ResourceHandle<Texture> TextureHandle;
+    typedef ResourceHandle<FontData> FontHandle;
+    typedef ResourceHandle<AtlasMap> AtlasHandle;
+    typedef ResourceHandle<WaveData> WaveHandle;
+    typedef ResourceHandle<AnimationClip> AnimationClipHandle;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+
+
+namespace GameDev2D
+{
+    //A ResourceId is the 64-bit FNV-1a hash of a resource's key (its filename or shader key), the ResourceManager
+    //looks resources up by their id, so that finding a resource never requires comparing strings
+    typedef unsigned long long ResourceId;
+
+    //FNV-1a hashing constants
+    constexpr ResourceId RESOURCE_ID_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr ResourceId RESOURCE_ID_PRIME = 1099511628211ULL;
+
+    //Returns the ResourceId for a null terminated key, when the key is a string literal (or a constexpr
+    //pointer to one) the id can be computed at compile time
+    constexpr ResourceId MakeResourceId(const char* aKey)
+    {
+        ResourceId hash = RESOURCE_ID_OFFSET_BASIS;
+        while (*aKey != '\0')
+        {
+            hash ^= (unsigned char)*aKey++;
+            hash *= RESOURCE_ID_PRIME;
+        }
+        return hash;
+    }
+
+    //Returns the ResourceId for a key
+    inline ResourceId MakeResourceId(const std::string& aKey)
+    {
+        ResourceId hash = RESOURCE_ID_OFFSET_BASIS;
+        for (size_t i = 0; i < aKey.length(); i++)
+        {
+            hash ^= (unsigned char)aKey[i];
+            hash *= RESOURCE_ID_PRIME;
+        }
+        return hash;
+    }
+}
@@ -1,5 +1,8 @@
 #include "ResourceManager.h"
+#include "../../GameDev2D_Settings.h"
+#include "../../Animation/AnimationClip.h"
 #include "../../Audio/Audio.h"
+#include "../../Audio/AudioStream.h"
 #include "../../Audio/AudioTypes.h"
 #include "../../Debug/Log.h"
 #include "../../Events/TextureResourceEvent.h"
@@ -7,6 +10,7 @@
 #include "../../Graphics/SpriteAtlas.h"
 #include "../../Graphics/SpriteFont.h"
 #include "../../IO/File.h"
+#include "../../Utils/MetadataCache/MetadataCache.h"
 #include "../../Utils/Png/Png.h"
 #include "../../Utils/Wave/Wave.h"
 #include "../../Windows/Application.h"
@@ -19,7 +23,9 @@ namespace GameDev2D
     ResourceManager::ResourceManager() : EventDispatcher(),
         m_DefaultTexture(nullptr),
         m_DefaultFont(nullptr),
-        m_DefaultAudio(nullptr)
+        m_DefaultAudio(nullptr),
+        m_MemoryBudget(RESOURCE_MEMORY_BUDGET),
+        m_ReleaseTick(0)
     {
         //Initialize the attributes for the polygon shader
         vector<string> attributes;
@@ -106,42 +112,45 @@ namespace GameDev2D
         UnloadShader(PASSTHROUGH_TEXTURE_SHADER_KEY);
         UnloadShader(PASSTHROUGH_SPRITEBATCH_SHADER_KEY);
 
-        //Check how many Textures remain loaded
-        unsigned int texturesLeft = m_TextureMap.Count();
+        //Check how many Textures remain loaded, released Textures that haven't been purged yet aren't counted
+        unsigned int texturesLeft = m_TextureMap.GetReferencedCount();
         if (texturesLeft > 0)
         {
             //Log that there are textures left
             Log::Error(false, Log::Verbosity_Resources, "[ResourceManager] %u Textures remain unloaded", texturesLeft);
-
-            //Then cleanup the left over textures
-            m_TextureMap.Cleanup();
         }
 
+        //Then cleanup the left over textures
+        m_TextureMap.Cleanup();
+
         //Check how many Fonts remain loaded
-        unsigned int fontsLeft = m_FontMap.Count();
+        unsigned int fontsLeft = m_FontMap.GetReferencedCount();
         if (fontsLeft > 0)
         {
             //Log that there are fonts left
             Log::Error(false, Log::Verbosity_Resources, "[ResourceManager] %u Fonts remain unloaded", fontsLeft);
-
-            //Then cleanup the left over fonts
-            m_FontMap.Cleanup();
         }
 
+        //Then cleanup the left over fonts
+        m_FontMap.Cleanup();
+
         //Check how many Sounds remain loaded
-        unsigned int soundsLeft = m_AudioMap.Count();
+        unsigned int soundsLeft = m_AudioMap.GetReferencedCount();
         if (soundsLeft > 0)
         {
             //Log that there are sounds left
             Log::Error(false, Log::Verbosity_Resources, "[ResourceManager] %u Audio files remain unloaded", soundsLeft);
-
-            //Then cleanup the left over sounds
-            m_AudioMap.Cleanup();
         }
 
+        //Then cleanup the left over sounds
+        m_AudioMap.Cleanup();
+
 		//Cleanup the atlas map
 		m_AtlasMap.Cleanup();
 
+        //Cleanup the animation clip map
+        m_AnimationClipMap.Cleanup();
+
         //Remove the event listener callback for the Update event
         Services::GetApplication()->RemoveEventListener(this, UPDATE_EVENT);
     }
@@ -152,191 +161,159 @@ namespace GameDev2D
         {
             if (aEvent->GetEventCode() == UPDATE_EVENT)
             {
-
+                //Purge the least recently released resources that don't fit in the memory budget
+                Purge(m_MemoryBudget);
             }
         }
     }
 
     void ResourceManager::LoadWaveFile(const std::string& aFilename)
     {
-        if (IsWaveFileLoaded(aFilename) == false)
+        //Load the wave data if it isn't resident, then pin it so that it stays loaded until it's unloaded
+        if (CacheWaveData(aFilename) == true)
         {
-            //Safety check the filename
-            if (aFilename.length() == 0)
-            {
-                Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load wave file, the filename had a length of 0");
-                return;
-            }
-
-			//Append the filename to the directory
-			string filename = string(aFilename);
-
-			//Was .wav appended to the filename? If it was, remove it
-			size_t found = filename.find(".wav");
-			if (found != std::string::npos)
-			{
-				filename.erase(found, 4);
-			}
-
-            //Get the path for the audio file
-            string path = Services::GetApplication()->GetPathForResourceInDirectory(filename.c_str(), "wav", "Audio");
-
-            //Does the file exist, if it doesn't the assert below will be hit
-            bool doesExist = Services::GetApplication()->DoesFileExistAtPath(path);
-            assert(doesExist == true);
-
-            //If the file doesn't exist, log an error
-            if (doesExist == false)
-            {
-                Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load wave file with filename: %s.wav, it doesn't exist", filename.c_str());
-                return;
-            }
-
-			WaveData* waveData = nullptr;
-			if (Wave::LoadFromPath(path, &waveData) == true)
-			{
-				//Create the audio data and add it to the resource map
-				m_AudioMap.Create(filename, waveData);
-			}
-			else
-			{
-				Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load wave file with filename: %s.wav", filename.c_str());
-			}
+            m_AudioMap.Pin(MakeResourceId(GetWaveKey(aFilename)));
         }
     }
 
     void ResourceManager::UnloadWaveFile(const std::string& aFilename)
     {
-        //Is the wave data loaded?
-        if (IsWaveFileLoaded(aFilename) == true)
-        {
-            //Get the audio resource
-            WaveData* resource = m_AudioMap.Get(aFilename);
-
-            //Delete the resource
-            if (resource != nullptr)
-            {
-                delete resource;
-                resource = nullptr;
-            }
-
-            //Remove the resource from the wave data map
-            m_AudioMap.Remove(aFilename);
-        }
+        //The wave data isn't deleted until it's purged, if it is still referenced it won't be purged
+        m_AudioMap.Unpin(MakeResourceId(GetWaveKey(aFilename)), ++m_ReleaseTick);
     }
 
     bool ResourceManager::IsWaveFileLoaded(const std::string& aFilename)
     {
-        return m_AudioMap.Contains(aFilename);
+        return m_AudioMap.Contains(MakeResourceId(GetWaveKey(aFilename)));
     }
 
     WaveData* ResourceManager::GetWaveData(const std::string& aFilename)
+    {
+        return GetWaveData(MakeResourceId(GetWaveKey(aFilename)));
+    }
+
+    WaveData* ResourceManager::GetWaveData(ResourceId aId)
     {
         //Is the audio data loaded?
-        if (IsWaveFileLoaded(aFilename) == true)
+        WaveData* audioData = m_AudioMap.Find(aId);
+        if (audioData != nullptr)
         {
-            WaveData* audioData = m_AudioMap.Get(aFilename);
             return audioData;
         }
 		return GetDefaultWaveData();
     }
-    
-    void ResourceManager::LoadFont(const std::string& aFilename)
+
+    WaveData* ResourceManager::GetWaveData(const WaveHandle& aHandle)
     {
-        //Check if the font loaded
-        if (IsFontLoaded(aFilename) == false)
+        //Is the handle still valid?
+        WaveData* audioData = m_AudioMap.Get(aHandle);
+        if (audioData != nullptr)
         {
-            //Safety check the filename
-            if (aFilename.length() == 0)
-            {
-                Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load font, the filename had a length of 0");
-                return;
-            }
-
-			//Get the path for the JSON file
-			std::string path = Services::GetApplication()->GetPathForResourceInDirectory(aFilename.c_str(), "json", "Fonts");
-
-			//Unpack the SpriteFont Data
-			FontData* fontData = nullptr;
-			bool success = SpriteFont::Unpack(path, &fontData);
-			
-			if (success == true && fontData != nullptr)
-			{
-				//Get the path for the texture
-				std::string path = Services::GetApplication()->GetPathForResourceInDirectory(aFilename.c_str(), "png", "Fonts");
+            return audioData;
+        }
+		return GetDefaultWaveData();
+    }
 
-				//Does the image exist at the path
-				if (Services::GetApplication()->DoesFileExistAtPath(path) == true)
-				{
-					//Attempt to load the png image and store its texture data in the TextureData struct
-					ImageData* imageData = nullptr;
-					bool success = Png::LoadFromPath(path, &imageData);
-
-					//Did the image load successfully
-					if (success == true && imageData != nullptr)
-					{
-						//Create a new texture object
-						fontData->texture = new Texture(*imageData);
-
-						//Set the fontData in the font map
-						m_FontMap.Create(aFilename, fontData);
-					}
-					else
-					{
-						//Log an error message
-						Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load font : %s", aFilename.c_str());
-					}
-
-					//Delete the imageData, we don't need it anymore
-					if (imageData != nullptr)
-					{
-						delete imageData;
-						imageData = nullptr;
-					}
-				}
-			}
-			else
-			{
-				//Log an error message
-				Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load font : %s", aFilename.c_str());
-			}
+    WaveHandle ResourceManager::AcquireWaveData(const std::string& aFilename)
+    {
+        if (CacheWaveData(aFilename) == false)
+        {
+            return WaveHandle();
         }
+        return m_AudioMap.Acquire(MakeResourceId(GetWaveKey(aFilename)));
     }
 
-    void ResourceManager::UnloadFont(const std::string& aFilename)
+    void ResourceManager::ReleaseWaveData(WaveHandle& aHandle)
     {
-        //Is the Font loaded?
-        if (IsFontLoaded(aFilename) == true)
+        m_AudioMap.Release(aHandle, ++m_ReleaseTick);
+    }
+
+    AudioStream* ResourceManager::OpenWaveStream(const std::string& aFilename)
+    {
+        //Wave data that is already resident is played from memory
+        string filename = GetWaveKey(aFilename);
+        if (filename.length() == 0 || m_AudioMap.Contains(MakeResourceId(filename)) == true)
         {
-            //Delete the resource
-            FontData* resource = m_FontMap.Get(aFilename);
-            if (resource != nullptr)
-            {
-                delete resource;
-                resource = nullptr;
-            }
+            return nullptr;
+        }
 
-            //Remove the resource from the Font map
-            m_FontMap.Remove(aFilename);
+        //Only long files are streamed, the stream's buffers would take up as much memory as a short file. The stream checks
+        //the size of the data as soon as it has read the header, short files are rejected without allocating any buffers
+        string path = Services::GetApplication()->GetPathForResourceInDirectory(filename.c_str(), "wav", "Audio");
+        AudioStream* stream = new AudioStream();
+        if (stream->Open(path, AUDIO_STREAMING_THRESHOLD) == false)
+        {
+            delete stream;
+            return nullptr;
         }
+
+        Log::Message(Log::Verbosity_Resources, "[Resource Manager] Streaming %s.wav, %u bytes resident instead of %u", filename.c_str(), stream->GetResidentBytes(), stream->GetDataSize());
+        return stream;
+    }
+    
+    void ResourceManager::LoadFont(const std::string& aFilename)
+    {
+        //Load the font if it isn't resident, then pin it so that it stays loaded until it's unloaded
+        if (CacheFont(aFilename) == true)
+        {
+            m_FontMap.Pin(MakeResourceId(aFilename));
+        }
+    }
+
+    void ResourceManager::UnloadFont(const std::string& aFilename)
+    {
+        //The font isn't deleted until it's purged, if it is still referenced it won't be purged
+        m_FontMap.Unpin(MakeResourceId(aFilename), ++m_ReleaseTick);
     }
 
     bool ResourceManager::IsFontLoaded(const std::string& aFilename)
     {
-        return m_FontMap.Contains(aFilename);
+        return m_FontMap.Contains(MakeResourceId(aFilename));
     }
 
     FontData* ResourceManager::GetFontData(const std::string& aFilename)
+    {
+        return GetFontData(MakeResourceId(aFilename));
+    }
+
+    FontData* ResourceManager::GetFontData(ResourceId aId)
     {
         //Check to see if the font is even loaded
-        if (IsFontLoaded(aFilename) == true)
+        FontData* fontData = m_FontMap.Find(aId);
+        if (fontData != nullptr)
         {
-            return m_FontMap.Get(aFilename);
+            return fontData;
         }
 
 		return GetDefaultFont();
     }
 
+    FontData* ResourceManager::GetFontData(const FontHandle& aHandle)
+    {
+        //Is the handle still valid?
+        FontData* fontData = m_FontMap.Get(aHandle);
+        if (fontData != nullptr)
+        {
+            return fontData;
+        }
+
+		return GetDefaultFont();
+    }
+
+    FontHandle ResourceManager::AcquireFont(const std::string& aFilename)
+    {
+        if (CacheFont(aFilename) == false)
+        {
+            return FontHandle();
+        }
+        return m_FontMap.Acquire(MakeResourceId(aFilename));
+    }
+
+    void ResourceManager::ReleaseFont(FontHandle& aHandle)
+    {
+        m_FontMap.Release(aHandle, ++m_ReleaseTick);
+    }
+
     void ResourceManager::LoadShader(ShaderInfo* aShaderInfo, const string& aKey)
     {
         //Is the Shader loaded?
@@ -443,8 +420,12 @@ namespace GameDev2D
             //Set the shader key
             shader->SetKey(aKey);
 
-            //Set the shader map pair for the filename key
-            m_ShaderMap.Create(aKey, shader);
+            //Set the shader map pair for the filename key, if the key collides with another shader's the shader is deleted
+            if (m_ShaderMap.Create(aKey, shader) == false)
+            {
+                delete shader;
+                return;
+            }
 
             //Cycle through the attributes and add them to the shader
             for (unsigned int i = 0; i < aShaderInfo->attributes.size(); i++)
@@ -487,167 +468,596 @@ namespace GameDev2D
 
     Shader* ResourceManager::GetShader(const string& aKey)
     {
-        if (m_ShaderMap.Contains(aKey) == true)
+        return GetShader(MakeResourceId(aKey));
+    }
+
+    Shader* ResourceManager::GetShader(ResourceId aId)
+    {
+        Shader* shader = m_ShaderMap.Get(aId);
+        if (shader != nullptr)
         {
-            return m_ShaderMap.Get(aKey);
+            return shader;
         }
 
-        return m_ShaderMap.Get(PASSTHROUGH_TEXTURE_SHADER_KEY);
+        return m_ShaderMap.Get(PASSTHROUGH_TEXTURE_SHADER_ID);
     }
 
 #include "../../Debug/Profile.h"
 
     void ResourceManager::LoadTexture(const string& aFilename)
     {
-        //Is the Texture loaded?
-        if (IsTextureLoaded(aFilename) == false)
+        //Load the texture if it isn't resident, then pin it so that it stays loaded until it's unloaded
+        if (CacheTexture(aFilename) == true)
         {
-            //Safety check the filename
-            if (aFilename.length() == 0)
-            {
-                Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load texture, the filename had a length of 0");
-                return;
-            }
+            m_TextureMap.Pin(MakeResourceId(aFilename));
+        }
+    }
 
-            //Append the filename to the directory
-            string filename = string(aFilename);
+    void ResourceManager::UnloadTexture(const string& aFilename)
+    {
+        //The texture isn't deleted until it's purged, if it is still referenced (by a Sprite) it won't be purged
+        m_TextureMap.Unpin(MakeResourceId(aFilename), ++m_ReleaseTick);
+    }
 
-            //Was .png appended to the filename? If it was, remove it
-            size_t found = filename.find(".png");
-            if (found != std::string::npos)
-            {
-                filename.erase(found, 4);
-            }
+    bool ResourceManager::IsTextureLoaded(const string& aFilename)
+    {
+        return m_TextureMap.Contains(MakeResourceId(aFilename));
+    }
 
-            //Get the path for the texture
-            std::string path = Services::GetApplication()->GetPathForResourceInDirectory(filename.c_str(), "png", "Images");
+    Texture* ResourceManager::GetTexture(const string& aFilename)
+    {
+        return GetTexture(MakeResourceId(aFilename));
+    }
 
-			//Does the image exist at the path
-            if (Services::GetApplication()->DoesFileExistAtPath(path) == true)
-            {
-                //Attempt to load the png image and store its texture data in the TextureData struct
-                ImageData* imageData = nullptr;
-                bool success = Png::LoadFromPath(path, &imageData);
+    Texture* ResourceManager::GetTexture(ResourceId aId)
+    {
+        //Set the texture data
+        Texture* texture = m_TextureMap.Find(aId);
+        if (texture != nullptr)
+        {
+            return texture;
+        }
 
-                //Did the image load successfully
-                if (success == true && imageData != nullptr)
-                {
-                    //Create a new texture object
-                    Texture* texture = new Texture(*imageData);
+        //If the texture still isn't loaded, it doesn't exist, set 
+        //the default texture data instead
+        return GetDefaultTexture();
+    }
 
-					//Dispatch an event before the resource is deleted
-					DispatchEvent(TextureResourceEvent(texture, TEXTURE_RESOURCE_LOADED));
+    Texture* ResourceManager::GetTexture(const TextureHandle& aHandle)
+    {
+        //Is the handle still valid?
+        Texture* texture = m_TextureMap.Get(aHandle);
+        if (texture != nullptr)
+        {
+            return texture;
+        }
 
-                    //Create the entry for the textureData
-                    m_TextureMap.Create(aFilename, texture);
-                }
-                else
-                {
-                    //Log an error message
-                    Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load texture : %s", aFilename.c_str());
-                }
+        return GetDefaultTexture();
+    }
 
-                //Delete the imageData, we don't need it anymore
-                if (imageData != nullptr)
-                {
-                    delete imageData;
-                    imageData = nullptr;
-                }
-            }
+    TextureHandle ResourceManager::AcquireTexture(const string& aFilename)
+    {
+        if (CacheTexture(aFilename) == false)
+        {
+            return TextureHandle();
         }
+        return m_TextureMap.Acquire(MakeResourceId(aFilename));
     }
 
-    void ResourceManager::UnloadTexture(const string& aFilename)
+    TextureHandle ResourceManager::AcquireTexture(Texture* aTexture)
+    {
+        return m_TextureMap.Acquire(aTexture);
+    }
+
+    void ResourceManager::ReleaseTexture(TextureHandle& aHandle)
     {
-        //Is the Texture loaded
-        if (IsTextureLoaded(aFilename) == true)
+        m_TextureMap.Release(aHandle, ++m_ReleaseTick);
+    }
+
+    void ResourceManager::LoadAtlas(const string& aFilename)
+    {
+        //Load the atlas frames if they aren't resident, then pin them so that they stay loaded until they're unloaded
+        if (CacheAtlas(aFilename) == true)
         {
-			//Get the resource
-			Texture* resource = m_TextureMap.Get(aFilename);
+            m_AtlasMap.Pin(MakeResourceId(aFilename));
+        }
+    }
 
-			//Dispatch an event before the resource is deleted
-			DispatchEvent(TextureResourceEvent(resource, TEXTURE_RESOURCE_UNLOADED));
+    void ResourceManager::UnloadAtlas(const string& aFilename)
+    {
+        //The atlas frames aren't deleted until they're purged, if they're still referenced they won't be purged
+        m_AtlasMap.Unpin(MakeResourceId(aFilename), ++m_ReleaseTick);
+    }
 
-            //Delete the resource
-            if (resource != nullptr)
-            {
-                delete resource;
-                resource = nullptr;
-            }
+    bool ResourceManager::IsAtlasLoaded(const string& aFilename)
+    {
+        return m_AtlasMap.Contains(MakeResourceId(aFilename));
+    }
 
-            //Remove the resource from the Texture map
-            m_TextureMap.Remove(aFilename);
+    Rect ResourceManager::GetAtlasFrame(const string& aFilename, const string& aAtlasKey)
+    {
+        //Get the specific TextureFrame from the atlas ResourceMap
+        AtlasMap* atlasMap = m_AtlasMap.Find(MakeResourceId(aFilename));
+        if (atlasMap != nullptr)
+        {
+            return atlasMap->Get(aAtlasKey);
         }
+
+        return Rect();
     }
 
-    bool ResourceManager::IsTextureLoaded(const string& aFilename)
+    AtlasMap* ResourceManager::GetAtlas(const AtlasHandle& aHandle)
     {
-        return m_TextureMap.Contains(aFilename);
+        return m_AtlasMap.Get(aHandle);
     }
 
-    Texture* ResourceManager::GetTexture(const string& aFilename)
+    AtlasHandle ResourceManager::AcquireAtlas(const string& aFilename)
     {
-        //Set the texture data
-        if (IsTextureLoaded(aFilename) == true)
+        if (CacheAtlas(aFilename) == false)
+        {
+            return AtlasHandle();
+        }
+        return m_AtlasMap.Acquire(MakeResourceId(aFilename));
+    }
+
+    void ResourceManager::ReleaseAtlas(AtlasHandle& aHandle)
+    {
+        m_AtlasMap.Release(aHandle, ++m_ReleaseTick);
+    }
+
+    void ResourceManager::LoadAnimationClip(const string& aFilename)
+    {
+        //Load the animation clip if it isn't resident, then pin it so that it stays loaded until it's unloaded
+        if (CacheAnimationClip(aFilename) == true)
         {
-            return m_TextureMap.Get(aFilename);
+            m_AnimationClipMap.Pin(MakeResourceId(aFilename));
         }
+    }
 
-        //If the texture still isn't loaded, it doesn't exist, set 
-        //the default texture data instead
-        return GetDefaultTexture();
+    void ResourceManager::UnloadAnimationClip(const string& aFilename)
+    {
+        //The animation clip isn't deleted until it's purged, if it's still referenced it won't be purged
+        m_AnimationClipMap.Unpin(MakeResourceId(aFilename), ++m_ReleaseTick);
     }
 
-    void ResourceManager::LoadAtlas(const string& aFilename)
+    bool ResourceManager::IsAnimationClipLoaded(const string& aFilename)
+    {
+        return m_AnimationClipMap.Contains(MakeResourceId(aFilename));
+    }
+
+    const AnimationClip* ResourceManager::GetAnimationClip(const AnimationClipHandle& aHandle)
+    {
+        return m_AnimationClipMap.Get(aHandle);
+    }
+
+    AnimationClipHandle ResourceManager::AcquireAnimationClip(const string& aFilename)
+    {
+        if (CacheAnimationClip(aFilename) == false)
+        {
+            return AnimationClipHandle();
+        }
+        return m_AnimationClipMap.Acquire(MakeResourceId(aFilename));
+    }
+
+    void ResourceManager::ReleaseAnimationClip(AnimationClipHandle& aHandle)
+    {
+        m_AnimationClipMap.Release(aHandle, ++m_ReleaseTick);
+    }
+
+    void ResourceManager::SetMemoryBudget(unsigned long long aMemoryBudget)
+    {
+        m_MemoryBudget = aMemoryBudget;
+    }
+
+    unsigned long long ResourceManager::GetMemoryBudget()
+    {
+        return m_MemoryBudget;
+    }
+
+    unsigned long long ResourceManager::GetResidentBytes()
+    {
+        return m_AudioMap.GetResidentBytes() + m_FontMap.GetResidentBytes() + m_TextureMap.GetResidentBytes() + m_AtlasMap.GetResidentBytes() + m_AnimationClipMap.GetResidentBytes();
+    }
+
+    unsigned long long ResourceManager::GetReleasedBytes()
+    {
+        return m_AudioMap.GetReleasedBytes() + m_FontMap.GetReleasedBytes() + m_TextureMap.GetReleasedBytes() + m_AtlasMap.GetReleasedBytes() + m_AnimationClipMap.GetReleasedBytes();
+    }
+
+    void ResourceManager::Purge(unsigned long long aMemoryBudget)
+    {
+        unsigned int purged = 0;
+        while (GetReleasedBytes() > aMemoryBudget)
+        {
+            //Find the cache that holds the least recently released resource
+            unsigned long long audioTick = m_AudioMap.GetOldestReleaseTick();
+            unsigned long long fontTick = m_FontMap.GetOldestReleaseTick();
+            unsigned long long textureTick = m_TextureMap.GetOldestReleaseTick();
+            unsigned long long atlasTick = m_AtlasMap.GetOldestReleaseTick();
+            unsigned long long clipTick = m_AnimationClipMap.GetOldestReleaseTick();
+
+            if (textureTick <= audioTick && textureTick <= fontTick && textureTick <= atlasTick && textureTick <= clipTick)
+            {
+                //Dispatch an event before the resource is deleted
+                Texture* texture = m_TextureMap.EvictOldest();
+                DispatchEvent(TextureResourceEvent(texture, TEXTURE_RESOURCE_UNLOADED));
+                delete texture;
+            }
+            else if (fontTick <= audioTick && fontTick <= atlasTick && fontTick <= clipTick)
+            {
+                delete m_FontMap.EvictOldest();
+            }
+            else if (audioTick <= atlasTick && audioTick <= clipTick)
+            {
+                delete m_AudioMap.EvictOldest();
+            }
+            else if (atlasTick <= clipTick)
+            {
+                delete m_AtlasMap.EvictOldest();
+            }
+            else
+            {
+                delete m_AnimationClipMap.EvictOldest();
+            }
+
+            purged++;
+        }
+
+        if (purged > 0)
+        {
+            Log::Message(Log::Verbosity_Resources, "[Resource Manager] Purged %u resources, %llu bytes remain resident", purged, GetResidentBytes());
+        }
+    }
+
+    bool ResourceManager::CacheWaveData(const std::string& aFilename)
+    {
+        //Is the wave data already resident?
+        string filename = GetWaveKey(aFilename);
+        if (m_AudioMap.Contains(MakeResourceId(filename)) == true)
+        {
+            return true;
+        }
+
+        //Safety check the filename
+        if (filename.length() == 0)
+        {
+            Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load wave file, the filename had a length of 0");
+            return false;
+        }
+
+        //Get the path for the audio file
+        string path = Services::GetApplication()->GetPathForResourceInDirectory(filename.c_str(), "wav", "Audio");
+
+        //Does the file exist, if it doesn't the assert below will be hit
+        bool doesExist = Services::GetApplication()->DoesFileExistAtPath(path);
+        assert(doesExist == true);
+
+        //If the file doesn't exist, log an error
+        if (doesExist == false)
+        {
+            Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load wave file with filename: %s.wav, it doesn't exist", filename.c_str());
+            return false;
+        }
+
+		WaveData* waveData = nullptr;
+		if (Wave::LoadFromPath(path, &waveData) == false)
+		{
+			Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load wave file with filename: %s.wav", filename.c_str());
+			return false;
+		}
+
+		//Add the audio data to the resource cache
+		if (m_AudioMap.Add(filename, waveData, waveData->buffer.AudioBytes, ++m_ReleaseTick) == false)
+		{
+			delete waveData;
+			return false;
+		}
+        return true;
+    }
+
+    bool ResourceManager::CacheFont(const std::string& aFilename)
     {
-        if (IsAtlasLoaded(aFilename) == false)
+        //Is the font already resident?
+        if (m_FontMap.Contains(MakeResourceId(aFilename)) == true)
         {
-            //Get the json path
-            string jsonPath = Services::GetApplication()->GetPathForResourceInDirectory(aFilename.c_str(), "json", "Images");
+            return true;
+        }
+
+        //Safety check the filename
+        if (aFilename.length() == 0)
+        {
+            Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load font, the filename had a length of 0");
+            return false;
+        }
 
-			//Check to see if the file exists
-			if (Services::GetApplication()->DoesFileExistAtPath(jsonPath) == true)
+		//Get the path for the JSON file
+		std::string path = Services::GetApplication()->GetPathForResourceInDirectory(aFilename.c_str(), "json", "Fonts");
+
+		//Unpack the SpriteFont Data
+		FontData* fontData = nullptr;
+		bool success = UnpackFont(path, &fontData);
+
+		if (success == true && fontData != nullptr)
+		{
+			//Get the path for the texture
+			std::string path = Services::GetApplication()->GetPathForResourceInDirectory(aFilename.c_str(), "png", "Fonts");
+
+			//Does the image exist at the path
+			if (Services::GetApplication()->DoesFileExistAtPath(path) == true)
 			{
-				//Unpack the sprite atlas
-				AtlasMap* atlasMap = nullptr;
-				SpriteAtlas::Unpack(jsonPath, &atlasMap);
+				//Attempt to load the png image and store its texture data in the TextureData struct
+				ImageData* imageData = nullptr;
+				success = Png::LoadFromPath(path, &imageData);
+
+				//Did the image load successfully
+				if (success == true && imageData != nullptr)
+				{
+					//Create a new texture object
+					fontData->texture = new Texture(*imageData);
+
+					//Add the fontData to the resource cache, its size includes the font's texture
+					unsigned long long size = GetTextureSize(fontData->texture) + fontData->glyphData.size() * sizeof(GlyphData);
+					success = m_FontMap.Add(aFilename, fontData, size, ++m_ReleaseTick);
+				}
+
+				//Delete the imageData, we don't need it anymore
+				if (imageData != nullptr)
+				{
+					delete imageData;
+					imageData = nullptr;
+				}
 
-				//Add the unpacked sprite atlas data to the ResourceMap
-				if (atlasMap != nullptr)
+				if (success == true)
 				{
-					m_AtlasMap.Create(aFilename, atlasMap);
+					return true;
 				}
 			}
+
+			//The font's texture couldn't be loaded OR the font couldn't be added, delete the font data
+			delete fontData;
+			fontData = nullptr;
+		}
+
+		//Log an error message
+		Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load font : %s", aFilename.c_str());
+        return false;
+    }
+
+    bool ResourceManager::CacheTexture(const string& aFilename)
+    {
+        //Is the Texture already resident?
+        if (m_TextureMap.Contains(MakeResourceId(aFilename)) == true)
+        {
+            return true;
+        }
+
+        //Safety check the filename
+        if (aFilename.length() == 0)
+        {
+            Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load texture, the filename had a length of 0");
+            return false;
+        }
+
+        //Append the filename to the directory
+        string filename = string(aFilename);
+
+        //Was .png appended to the filename? If it was, remove it
+        size_t found = filename.find(".png");
+        if (found != std::string::npos)
+        {
+            filename.erase(found, 4);
+        }
+
+        //Get the path for the texture
+        std::string path = Services::GetApplication()->GetPathForResourceInDirectory(filename.c_str(), "png", "Images");
+
+		//Does the image exist at the path
+        if (Services::GetApplication()->DoesFileExistAtPath(path) == false)
+        {
+            return false;
+        }
+
+        //Attempt to load the png image and store its texture data in the TextureData struct
+        ImageData* imageData = nullptr;
+        bool success = Png::LoadFromPath(path, &imageData);
+
+        //Did the image load successfully
+        if (success == true && imageData != nullptr)
+        {
+            //Create a new texture object
+            Texture* texture = new Texture(*imageData);
+
+            //Add the texture to the resource cache, if it can't be added it's deleted
+            success = m_TextureMap.Add(aFilename, texture, GetTextureSize(texture), ++m_ReleaseTick);
+            if (success == true)
+            {
+                //Dispatch an event before the resource is deleted
+                DispatchEvent(TextureResourceEvent(texture, TEXTURE_RESOURCE_LOADED));
+            }
+            else
+            {
+                delete texture;
+            }
         }
+        else
+        {
+            //Log an error message
+            Log::Error(false, Log::Verbosity_Resources, "[Resource Manager] Failed to load texture : %s", aFilename.c_str());
+        }
+
+        //Delete the imageData, we don't need it anymore
+        if (imageData != nullptr)
+        {
+            delete imageData;
+            imageData = nullptr;
+        }
+
+        return success;
     }
 
-    void ResourceManager::UnloadAtlas(const string& aFilename)
+    bool ResourceManager::CacheAtlas(const string& aFilename)
     {
-        if (IsAtlasLoaded(aFilename) == true)
+        //Are the atlas frames already resident?
+        if (m_AtlasMap.Contains(MakeResourceId(aFilename)) == true)
         {
-            m_AtlasMap.Remove(aFilename);
+            return true;
         }
+
+        //Get the json path
+        string jsonPath = Services::GetApplication()->GetPathForResourceInDirectory(aFilename.c_str(), "json", "Images");
+
+		//Check to see if the file exists
+		if (Services::GetApplication()->DoesFileExistAtPath(jsonPath) == false)
+		{
+			return false;
+		}
+
+		//Unpack the sprite atlas
+		AtlasMap* atlasMap = nullptr;
+		UnpackAtlas(jsonPath, &atlasMap);
+
+		//Add the unpacked sprite atlas data to the resource cache
+		if (atlasMap == nullptr)
+		{
+			return false;
+		}
+
+		if (m_AtlasMap.Add(aFilename, atlasMap, atlasMap->GetSize(), ++m_ReleaseTick) == false)
+		{
+			delete atlasMap;
+			return false;
+		}
+        return true;
     }
 
-    bool ResourceManager::IsAtlasLoaded(const string& aFilename)
+    bool ResourceManager::CacheAnimationClip(const string& aFilename)
     {
-        return m_AtlasMap.Contains(aFilename);
+        //Is the animation clip already resident?
+        if (m_AnimationClipMap.Contains(MakeResourceId(aFilename)) == true)
+        {
+            return true;
+        }
+
+        //Get the json path, then check to see if the file exists
+        string jsonPath = Services::GetApplication()->GetPathForResourceInDirectory(aFilename.c_str(), "json", "Animations");
+        if (Services::GetApplication()->DoesFileExistAtPath(jsonPath) == false)
+        {
+            Log::Error(false, Log::Verbosity_Resources, "[ResourceManager] Unable to find the animation clip: %s", aFilename.c_str());
+            return false;
+        }
+
+        //Unpack the animation clip and add it to the resource cache
+        AnimationClip* animationClip = nullptr;
+        if (UnpackAnimationClip(jsonPath, &animationClip) == false || animationClip == nullptr)
+        {
+            return false;
+        }
+
+        if (m_AnimationClipMap.Add(aFilename, animationClip, animationClip->GetSize(), ++m_ReleaseTick) == false)
+        {
+            delete animationClip;
+            return false;
+        }
+        return true;
     }
 
-    Rect ResourceManager::GetAtlasFrame(const string& aFilename, const string& aAtlasKey)
+    std::string ResourceManager::GetWaveKey(const std::string& aFilename)
     {
-        //Ensure this time that the atlas data has been loaded
-        if (IsAtlasLoaded(aFilename) == true)
+		//Was .wav appended to the filename? If it was, remove it
+		string filename = string(aFilename);
+		size_t found = filename.find(".wav");
+		if (found != std::string::npos)
+		{
+			filename.erase(found, 4);
+		}
+        return filename;
+    }
+
+    unsigned long long ResourceManager::GetTextureSize(Texture* aTexture)
+    {
+        unsigned long long bytesPerPixel = aTexture->GetPixelFormat().layout == PixelFormat::RGBA ? 4 : 3;
+        return (unsigned long long)aTexture->GetWidth() * aTexture->GetHeight() * bytesPerPixel;
+    }
+
+    bool ResourceManager::UnpackFont(const string& aPath, FontData** aFontData)
+    {
+        //Is there a valid binary cache of the font's metadata? If there is, the json file doesn't need to be parsed
+        if (MetadataCache::LoadFontData(aPath, aFontData) == true)
         {
-            //Get the specific TextureFrame from the atlas ResourceMap
-			AtlasMap* atlasMap = m_AtlasMap.Get(aFilename);
-			if (atlasMap != nullptr)
-			{
-				return atlasMap->Get(aAtlasKey);
-			}
+            return true;
         }
 
-        return Rect();
+        //Read the json file once, the cache records the size, modification time and hash of the contents that are unpacked
+        std::vector<char> buffer;
+        MetadataSource source;
+        bool isRead = MetadataCache::ReadSource(aPath, buffer, &source);
+        assert(isRead == true);
+
+        //Unpack the json data and cache the result for next time
+        if (isRead == true && SpriteFont::Unpack(aPath, &buffer[0], (unsigned int)source.size, aFontData) == true && *aFontData != nullptr)
+        {
+            if (MetadataCache::SaveFontData(aPath, source, *aFontData) == false)
+            {
+                Log::Message(Log::Verbosity_Resources, "[Resource Manager] Unable to write the metadata cache for font: %s", aPath.c_str());
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ResourceManager::UnpackAtlas(const string& aPath, AtlasMap** aAtlasMap)
+    {
+        //Is there a valid binary cache of the atlas frames? If there is, the json file doesn't need to be parsed
+        if (MetadataCache::LoadAtlasMap(aPath, aAtlasMap) == true)
+        {
+            return true;
+        }
+
+        //Read the json file once, the cache records the size, modification time and hash of the contents that are unpacked
+        std::vector<char> buffer;
+        MetadataSource source;
+        bool isRead = MetadataCache::ReadSource(aPath, buffer, &source);
+        assert(isRead == true);
+
+        //Unpack the json data and cache the result for next time
+        if (isRead == true && SpriteAtlas::Unpack(aPath, &buffer[0], (unsigned int)source.size, aAtlasMap) == true && *aAtlasMap != nullptr)
+        {
+            if (MetadataCache::SaveAtlasMap(aPath, source, *aAtlasMap) == false)
+            {
+                Log::Message(Log::Verbosity_Resources, "[Resource Manager] Unable to write the metadata cache for atlas: %s", aPath.c_str());
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ResourceManager::UnpackAnimationClip(const string& aPath, AnimationClip** aAnimationClip)
+    {
+        //Is there a valid binary cache of the clip's keyframes? If there is, the json file doesn't need to be parsed
+        if (MetadataCache::LoadAnimationClip(aPath, aAnimationClip) == true)
+        {
+            return true;
+        }
+
+        //Read the json file once, the cache records the size, modification time and hash of the contents that are unpacked
+        std::vector<char> buffer;
+        MetadataSource source;
+        bool isRead = MetadataCache::ReadSource(aPath, buffer, &source);
+        assert(isRead == true);
+
+        //Unpack the json data and cache the result for next time
+        if (isRead == true && AnimationClip::Unpack(aPath, &buffer[0], (unsigned int)source.size, aAnimationClip) == true && *aAnimationClip != nullptr)
+        {
+            if (MetadataCache::SaveAnimationClip(aPath, source, *aAnimationClip) == false)
+            {
+                Log::Message(Log::Verbosity_Resources, "[Resource Manager] Unable to write the metadata cache for animation clip: %s", aPath.c_str());
+            }
+            return true;
+        }
+
+        return false;
     }
 
     Texture* ResourceManager::GetDefaultTexture()
@@ -715,7 +1125,7 @@ namespace GameDev2D
             std::string path = Services::GetApplication()->GetPathForResourceInDirectory("OpenSans-CondBold_32", "json", "Fonts");
 
             //Unpack the SpriteFont Data
-            bool success = SpriteFont::Unpack(path, &m_DefaultFont);
+            bool success = UnpackFont(path, &m_DefaultFont);
             if (success == true && m_DefaultFont != nullptr)
             {
                 //Get the path for the texture
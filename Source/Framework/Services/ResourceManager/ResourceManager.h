@@ -6,74 +6,37 @@
 #include "../../Graphics/Sprite.h"
 #include "../../Graphics/Texture.h"
 #include "../../Graphics/GraphicTypes.h"
+#include "ResourceCache.h"
+#include "ResourceHandle.h"
+#include "ResourceId.h"
+#include "ResourceMap.h"
 #include <map>
 #include <unordered_map>
 #include <string>
 
 
-//Shader constants
-const std::string PASSTHROUGH_POLYGON_SHADER_KEY = "PolygonPassthrough";
-const std::string PASSTHROUGH_TEXTURE_SHADER_KEY = "TexturePassthrough";
-const std::string PASSTHROUGH_SPRITEBATCH_SHADER_KEY = "SpriteBatchPassthrough";
+//Shader constants, the shader ids are hashed from their keys at compile time
+constexpr const char* PASSTHROUGH_POLYGON_SHADER_KEY = "PolygonPassthrough";
+constexpr const char* PASSTHROUGH_TEXTURE_SHADER_KEY = "TexturePassthrough";
+constexpr const char* PASSTHROUGH_SPRITEBATCH_SHADER_KEY = "SpriteBatchPassthrough";
+constexpr GameDev2D::ResourceId PASSTHROUGH_POLYGON_SHADER_ID = GameDev2D::MakeResourceId(PASSTHROUGH_POLYGON_SHADER_KEY);
+constexpr GameDev2D::ResourceId PASSTHROUGH_TEXTURE_SHADER_ID = GameDev2D::MakeResourceId(PASSTHROUGH_TEXTURE_SHADER_KEY);
+constexpr GameDev2D::ResourceId PASSTHROUGH_SPRITEBATCH_SHADER_ID = GameDev2D::MakeResourceId(PASSTHROUGH_SPRITEBATCH_SHADER_KEY);
 
 namespace GameDev2D
 {
-    //Templated class to make managing Resources cleaner
-    template<typename T> class ResourceMap
-    {
-    public:
-        void Create(const std::string& key, T type)
-        {
-            m_Map[key] = type;
-        }
-
-        void Remove(const std::string& key)
-        {
-            m_Map.erase(key);
-        }
-
-        T Get(const std::string& key)
-        {
-            return m_Map[key];
-        }
-
-        bool Contains(const std::string& key)
-        {
-            return m_Map.find(key) != m_Map.end();
-        }
-
-        unsigned int Count()
-        {
-            return m_Map.size();
-        }
-
-        void Cleanup()
-        {
-            for (std::map<string, T>::iterator iterator = m_Map.begin(); iterator != m_Map.end(); iterator++)
-            {
-                T resource = iterator->second;
-                if (resource != nullptr)
-                {
-                    delete resource;
-                    resource = nullptr;
-                }
-            }
-
-            m_Map.clear();
-        }
-
-    private:
-        std::map<string, T> m_Map;
-    };
-
-
     //Forward declarations
     class Audio;
+    class AudioStream;
     class Shader;
     struct ShaderInfo;
 
 
-    //The ResourceManager is responsible for loading, unloading and making accessible Audio, Font, Texture and Shader files
+    //The ResourceManager is responsible for loading, unloading and making accessible Audio, Font, Texture and Shader files.
+    //Audio, Font, Texture, Atlas and AnimationClip resources are reference counted, acquiring a handle keeps the resource loaded until
+    //the handle is released. Unloading is deferred, resources that are no longer referenced stay resident (and can be
+    //acquired again without any I/O) until they are purged, least recently released first, once a frame when the
+    //released resources exceed the memory budget
     class ResourceManager : public EventDispatcher
     {
     public:
@@ -86,20 +49,32 @@ namespace GameDev2D
         //Loads an Audio object for the appropriate file, only load an Audio file once
         void LoadWaveFile(const std::string& filename);
 
-        //Unloads an already loaded Audio object
+        //Unloads an already loaded Audio object, the wave data is deleted once it is purged
         void UnloadWaveFile(const std::string& filename);
 
         //Returns wether an Audio object for the appropriate file is loaded or not
         bool IsWaveFileLoaded(const std::string& filename);
 
         //Returns an Audio objectfor the appropriate file, if the file doesn't exist 
-        //OR isn't loaded yet then nullptr will be returned
+        //OR isn't loaded yet then the default wave data will be returned
 		WaveData* GetWaveData(const std::string& filename);
+		WaveData* GetWaveData(ResourceId id);
+		WaveData* GetWaveData(const WaveHandle& handle);
+
+        //Returns a handle to the wave data for the appropriate file, loading it if it isn't loaded, the handle MUST be released
+        WaveHandle AcquireWaveData(const std::string& filename);
+
+        //Releases a handle to wave data and invalidates it
+        void ReleaseWaveData(WaveHandle& handle);
+
+        //Opens a stream for a wave file that is larger than AUDIO_STREAMING_THRESHOLD and isn't resident. Returns nullptr
+        //if the file should be loaded instead, the caller owns the stream and MUST delete it
+        AudioStream* OpenWaveStream(const std::string& filename);
 
         //Loads a Font for the appropriate file and font size, only load a Font once
         void LoadFont(const std::string& filename);
 
-        //Unloads an already loaded Font
+        //Unloads an already loaded Font, the font is deleted once it is purged
         void UnloadFont(const std::string& filename);
 
         //Returns wether a Shader for the appropriate file is loaded or not
@@ -108,6 +83,14 @@ namespace GameDev2D
         //Returns a Font for the appropriate file and font size, if the file doesn't exist 
         //OR isn't loaded yet the default Font (OpenSans-CondBold.ttf) will be returned instead        
         FontData* GetFontData(const std::string& filename);
+        FontData* GetFontData(ResourceId id);
+        FontData* GetFontData(const FontHandle& handle);
+
+        //Returns a handle to the Font for the appropriate file, loading it if it isn't loaded, the handle MUST be released
+        FontHandle AcquireFont(const std::string& filename);
+
+        //Releases a handle to a Font and invalidates it
+        void ReleaseFont(FontHandle& handle);
 
         //Loads a Shader for the appropriate file, only load a Shader once, the default Shaders are loaded automatically
         void LoadShader(ShaderInfo* shaderInfo, const std::string& key);
@@ -119,13 +102,14 @@ namespace GameDev2D
         bool IsShaderLoaded(const std::string& key);
 
         //Returns a Shader for the appropriate key, if the Shader doesn't exist 
-        //OR isn't loaded yet, then nullptr will be returned
+        //OR isn't loaded yet, then the texture passthrough Shader will be returned
         Shader* GetShader(const std::string& key);
+        Shader* GetShader(ResourceId id);
 
         //Loads a Texture for the appropriate file, only load a Texture once
         void LoadTexture(const std::string& filename);
 
-        //Unloads an already loaded Texture
+        //Unloads an already loaded Texture, the Texture is deleted once it is purged
         void UnloadTexture(const std::string& filename);
 
         //Returns wether a Texture for the appropriate file is loaded or not
@@ -134,6 +118,18 @@ namespace GameDev2D
         //Returns a Texture for the appropriate file, if the file doesn't exist 
         //OR isn't loaded yet a checkerboard Texture will be returned instead
         Texture* GetTexture(const std::string& filename);
+        Texture* GetTexture(ResourceId id);
+        Texture* GetTexture(const TextureHandle& handle);
+
+        //Returns a handle to the Texture for the appropriate file, loading it if it isn't loaded, the handle MUST be released
+        TextureHandle AcquireTexture(const std::string& filename);
+
+        //Returns a handle to an already loaded Texture, if the Texture isn't owned by the ResourceManager 
+        //(the default Texture OR a Font's Texture) then an invalid handle is returned
+        TextureHandle AcquireTexture(Texture* texture);
+
+        //Releases a handle to a Texture and invalidates it
+        void ReleaseTexture(TextureHandle& handle);
 
         //Load the SpriteAtlas frames for the appropriate file is loaded or not
         void LoadAtlas(const std::string& filename);
@@ -148,6 +144,33 @@ namespace GameDev2D
         //OR isn't loaded yet an empty Rect value will be returned instead
         Rect GetAtlasFrame(const std::string& filename, const std::string& atlasKey);
 
+        //Returns the SpriteAtlas frames for the handle, if the handle is invalid nullptr will be returned
+        AtlasMap* GetAtlas(const AtlasHandle& handle);
+
+        //Returns a handle to the SpriteAtlas frames for the appropriate file, loading them if they aren't loaded, the handle MUST be released
+        AtlasHandle AcquireAtlas(const std::string& filename);
+
+        //Releases a handle to SpriteAtlas frames and invalidates it
+        void ReleaseAtlas(AtlasHandle& handle);
+
+        //Loads an AnimationClip for the appropriate file (in the Animations directory), only load an AnimationClip once
+        void LoadAnimationClip(const std::string& filename);
+
+        //Unloads an already loaded AnimationClip, the clip is deleted once it is purged
+        void UnloadAnimationClip(const std::string& filename);
+
+        //Returns wether an AnimationClip for the appropriate file is loaded or not
+        bool IsAnimationClipLoaded(const std::string& filename);
+
+        //Returns the AnimationClip for the handle, if the handle is invalid nullptr will be returned. Clips are shared, they can't be modified
+        const AnimationClip* GetAnimationClip(const AnimationClipHandle& handle);
+
+        //Returns a handle to the AnimationClip for the appropriate file, loading it if it isn't loaded, the handle MUST be released
+        AnimationClipHandle AcquireAnimationClip(const std::string& filename);
+
+        //Releases a handle to an AnimationClip and invalidates it
+        void ReleaseAnimationClip(AnimationClipHandle& handle);
+
         //Returns the placeholder checkerboard texture
         Texture* GetDefaultTexture();
 
@@ -157,17 +180,59 @@ namespace GameDev2D
         //Returns a default Audio sound (1 second tone at frequency 650)
 		WaveData* GetDefaultWaveData();
 
+        //Sets the memory budget (in bytes) for resources that are no longer referenced, once a frame
+        //the least recently released resources are purged until the budget is met
+        void SetMemoryBudget(unsigned long long memoryBudget);
+
+        //Returns the memory budget (in bytes) for resources that are no longer referenced
+        unsigned long long GetMemoryBudget();
+
+        //Returns the size (in bytes) of all the resident Audio, Font, Texture, Atlas and AnimationClip resources
+        unsigned long long GetResidentBytes();
+
+        //Returns the size (in bytes) of the resident resources that are no longer referenced
+        unsigned long long GetReleasedBytes();
+
+        //Purges the least recently released resources until the released resources fit in the memory budget,
+        //this is called once a frame, a budget of zero purges every released resource
+        void Purge(unsigned long long memoryBudget);
+
     private:
+        //Loads the resource for the appropriate file into its cache if it isn't resident, returns false if it couldn't be loaded
+        bool CacheWaveData(const std::string& filename);
+        bool CacheFont(const std::string& filename);
+        bool CacheTexture(const std::string& filename);
+        bool CacheAtlas(const std::string& filename);
+        bool CacheAnimationClip(const std::string& filename);
+
+        //Returns the key wave data is stored under, the .wav extension is removed
+        std::string GetWaveKey(const std::string& filename);
+
+        //Returns the size (in bytes) of a Texture's pixels
+        unsigned long long GetTextureSize(Texture* texture);
+
+        //Unpacks the font metadata from its binary cache, or from the json file if the cache is missing or stale
+        bool UnpackFont(const std::string& path, FontData** fontData);
+
+        //Unpacks the atlas frames from their binary cache, or from the json file if the cache is missing or stale
+        bool UnpackAtlas(const std::string& path, AtlasMap** atlasMap);
+
+        //Unpacks the animation clip's keyframes from their binary cache, or from the json file if the cache is missing or stale
+        bool UnpackAnimationClip(const std::string& path, AnimationClip** animationClip);
+
         //Member variables
-        ResourceMap<WaveData*> m_AudioMap;
-        ResourceMap<FontData*> m_FontMap;
+        ResourceCache<WaveData> m_AudioMap;
+        ResourceCache<FontData> m_FontMap;
         ResourceMap<Shader*> m_ShaderMap;
-        ResourceMap<Texture*> m_TextureMap;
-        ResourceMap<AtlasMap*> m_AtlasMap;
+        ResourceCache<Texture> m_TextureMap;
+        ResourceCache<AtlasMap> m_AtlasMap;
+        ResourceCache<AnimationClip> m_AnimationClipMap;
         Texture* m_DefaultTexture;
 		FontData* m_DefaultFont;
 		WaveData* m_DefaultAudio;
+        unsigned long long m_MemoryBudget;
+        unsigned long long m_ReleaseTick;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "ResourceId.h"
+#include "../../Debug/Log.h"
+#include <string>
+#include <vector>
+#include <assert.h>
+
+
+namespace GameDev2D
+{
+    //Templated class to make managing Resources cleaner, the resources are stored in an open addressing hash table
+    //(linear probing) keyed by ResourceId. Looking up a resource only compares ids, and a lookup that misses never
+    //modifies the table. The key string is kept alongside each resource to detect ResourceId collisions: creating a resource
+    //whose key collides with another resource's key is an error, it fails like a resource that can't be loaded, and looking
+    //up a key only finds the resource that was created with that exact key.
+    template<typename T> class ResourceMap
+    {
+    public:
+        ResourceMap() :
+            m_Count(0)
+        {
+        }
+
+        //Creates OR replaces the resource for the key, returns false if the key's ResourceId collides with another key's,
+        //the other key's resource is kept and the caller still owns the resource
+        bool Create(const std::string& key, T type)
+        {
+            ResourceId id = MakeResourceId(key);
+
+            //Is there an existing slot for the id? If there is replace its resource
+            int index = Find(id);
+            if (index != -1)
+            {
+                //Two different keys hashing to the same id is a collision, there's no way to tell the resources apart by id
+                if (m_Slots[index].key != key)
+                {
+                    Log::Error(false, Log::Verbosity_Resources, "[ResourceMap] Failed to create %s, it has the same ResourceId as %s, one of them must be renamed", key.c_str(), m_Slots[index].key.c_str());
+                    assert(false);
+                    return false;
+                }
+
+                m_Slots[index].resource = type;
+                return true;
+            }
+
+            //Grow the table once it is half full, this keeps the probe sequences short
+            if ((m_Count + 1) * 2 > m_Slots.size())
+            {
+                Grow();
+            }
+
+            Insert(id, key, type);
+            m_Count++;
+            return true;
+        }
+
+        void Remove(ResourceId id)
+        {
+            int index = Find(id);
+            if (index == -1)
+            {
+                return;
+            }
+
+            //Shift the slots that follow back into the hole, so that no probe sequence is broken and no tombstones are needed
+            size_t mask = m_Slots.size() - 1;
+            size_t hole = (size_t)index;
+            size_t next = (hole + 1) & mask;
+            while (m_Slots[next].isUsed == true)
+            {
+                //A slot can only move back into the hole if its home index isn't cyclically between the hole and itself
+                size_t home = HomeIndex(m_Slots[next].id);
+                if (((next - home) & mask) >= ((next - hole) & mask))
+                {
+                    m_Slots[hole] = m_Slots[next];
+                    hole = next;
+                }
+                next = (next + 1) & mask;
+            }
+
+            m_Slots[hole] = Slot();
+            m_Count--;
+        }
+
+        void Remove(const std::string& key)
+        {
+            if (Find(key) != -1)
+            {
+                Remove(MakeResourceId(key));
+            }
+        }
+
+        T Get(ResourceId id) const
+        {
+            int index = Find(id);
+            return index != -1 ? m_Slots[index].resource : T();
+        }
+
+        T Get(const std::string& key) const
+        {
+            int index = Find(key);
+            return index != -1 ? m_Slots[index].resource : T();
+        }
+
+        bool Contains(ResourceId id) const
+        {
+            return Find(id) != -1;
+        }
+
+        bool Contains(const std::string& key) const
+        {
+            return Find(key) != -1;
+        }
+
+        unsigned int Count() const
+        {
+            return m_Count;
+        }
+
+        void Cleanup()
+        {
+            for (size_t i = 0; i < m_Slots.size(); i++)
+            {
+                T resource = m_Slots[i].resource;
+                if (m_Slots[i].isUsed == true && resource != nullptr)
+                {
+                    delete resource;
+                    resource = nullptr;
+                }
+            }
+
+            Clear();
+        }
+
+        //Removes every resource from the map, without deleting them
+        void Clear()
+        {
+            m_Slots.clear();
+            m_Count = 0;
+        }
+
+    private:
+        //A slot in the hash table
+        struct Slot
+        {
+            Slot() : id(0), resource(T()), isUsed(false) {}
+
+            ResourceId id;
+            T resource;
+            std::string key;
+            bool isUsed;
+        };
+
+        //Returns the slot the id would ideally be stored in, the table's size is always a power of two
+        size_t HomeIndex(ResourceId id) const
+        {
+            return (size_t)(id ^ (id >> 32)) & (m_Slots.size() - 1);
+        }
+
+        //Returns the index of the slot holding the id, or -1 if the id isn't in the table
+        int Find(ResourceId id) const
+        {
+            if (m_Slots.empty() == true)
+            {
+                return -1;
+            }
+
+            size_t mask = m_Slots.size() - 1;
+            for (size_t index = HomeIndex(id); m_Slots[index].isUsed == true; index = (index + 1) & mask)
+            {
+                if (m_Slots[index].id == id)
+                {
+                    return (int)index;
+                }
+            }
+            return -1;
+        }
+
+        //Returns the index of the slot holding the key, or -1 if the key isn't in the table. A key whose id collides with
+        //another key's id isn't found, instead of finding the other key's resource
+        int Find(const std::string& key) const
+        {
+            int index = Find(MakeResourceId(key));
+            return index != -1 && m_Slots[index].key == key ? index : -1;
+        }
+
+        //Stores the resource in the first free slot of the id's probe sequence
+        void Insert(ResourceId id, const std::string& key, T type)
+        {
+            size_t mask = m_Slots.size() - 1;
+            size_t index = HomeIndex(id);
+            while (m_Slots[index].isUsed == true)
+            {
+                index = (index + 1) & mask;
+            }
+
+            m_Slots[index].id = id;
+            m_Slots[index].resource = type;
+            m_Slots[index].key = key;
+            m_Slots[index].isUsed = true;
+        }
+
+        //Doubles the size of the table and re-inserts the existing resources
+        void Grow()
+        {
+            std::vector<Slot> slots(m_Slots.empty() == true ? RESOURCE_MAP_INITIAL_CAPACITY : m_Slots.size() * 2);
+            slots.swap(m_Slots);
+
+            for (size_t i = 0; i < slots.size(); i++)
+            {
+                if (slots[i].isUsed == true)
+                {
+                    Insert(slots[i].id, slots[i].key, slots[i].resource);
+                }
+            }
+        }
+
+        //Constants
+        static const unsigned int RESOURCE_MAP_INITIAL_CAPACITY = 16;
+
+        //Member variables
+        std::vector<Slot> m_Slots;
+        unsigned int m_Count;
+    };
+}
@@ -9,6 +9,8 @@ namespace GameDev2D
     Graphics* Services::s_Graphics = nullptr;
     ResourceManager* Services::s_ResourceManager = nullptr;
     InputManager* Services::s_InputManager = nullptr;
+    TweenManager* Services::s_TweenManager = nullptr;
+    SpatialIndex* Services::s_SpatialIndex = nullptr;
     DebugUI* Services::s_DebugUI = nullptr;
     
     void Services::Init(Application* aApplication)
@@ -18,6 +20,8 @@ namespace GameDev2D
         s_Graphics = new Graphics();
         s_ResourceManager = new ResourceManager();
         s_InputManager = new InputManager();
+        s_TweenManager = new TweenManager();
+        s_SpatialIndex = new SpatialIndex();
         s_DebugUI = new DebugUI();
     }
     
@@ -29,12 +33,32 @@ namespace GameDev2D
             s_DebugUI = nullptr;
         }
 
+        //Deleting the spatial index detaches the Drawables that are still in it
+        if (s_SpatialIndex != nullptr)
+        {
+            delete s_SpatialIndex;
+            s_SpatialIndex = nullptr;
+        }
+
+        if (s_TweenManager != nullptr)
+        {
+            delete s_TweenManager;
+            s_TweenManager = nullptr;
+        }
+
         if (s_InputManager != nullptr)
         {
             delete s_InputManager;
             s_InputManager = nullptr;
         }
 
+        //The audio engine is deleted before the resource manager, the mixer plays wave data that the resource manager owns
+		if (s_AudioEngine != nullptr)
+		{
+			delete s_AudioEngine;
+			s_AudioEngine = nullptr;
+		}
+
         if (s_ResourceManager != nullptr)
         {
             delete s_ResourceManager;
@@ -47,11 +71,6 @@ namespace GameDev2D
             s_Graphics = nullptr;
         }
 
-		if (s_AudioEngine != nullptr)
-		{
-			delete s_AudioEngine;
-			s_AudioEngine = nullptr;
-		}
     }
 
     Application* Services::GetApplication()
@@ -77,6 +96,18 @@ namespace GameDev2D
         return s_InputManager;
     }
 
+    TweenManager* Services::GetTweenManager()
+    {
+        assert(s_TweenManager != nullptr);
+        return s_TweenManager;
+    }
+
+    SpatialIndex* Services::GetSpatialIndex()
+    {
+        assert(s_SpatialIndex != nullptr);
+        return s_SpatialIndex;
+    }
+
     DebugUI* Services::GetDebugUI()
     {
         assert(s_DebugUI != nullptr);
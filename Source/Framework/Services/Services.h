@@ -6,6 +6,8 @@
 #include "InputManager/InputManager.h"
 #include "DebugUI/DebugUI.h"
 #include "ResourceManager/ResourceManager.h"
+#include "SpatialIndex/SpatialIndex.h"
+#include "TweenManager/TweenManager.h"
 
 
 namespace GameDev2D
@@ -13,7 +15,7 @@ namespace GameDev2D
     //Forward declarations
     class Application;
 
-    //The Services class allows conveniant access to the Game's services (Graphics, InputManager, ResourceManager, DebugUI)
+    //The Services class allows conveniant access to the Game's services (Graphics, InputManager, ResourceManager, TweenManager, SpatialIndex, DebugUI)
     class Services
     {
     public:
@@ -29,6 +31,8 @@ namespace GameDev2D
         static Graphics* GetGraphics();
         static ResourceManager* GetResourceManager();
         static InputManager* GetInputManager();
+        static TweenManager* GetTweenManager();
+        static SpatialIndex* GetSpatialIndex();
         static DebugUI* GetDebugUI();
 
     private:
@@ -38,6 +42,8 @@ namespace GameDev2D
         static Graphics* s_Graphics;
         static ResourceManager* s_ResourceManager;
         static InputManager* s_InputManager;
+        static TweenManager* s_TweenManager;
+        static SpatialIndex* s_SpatialIndex;
         static DebugUI* s_DebugUI;
     };
 }
@@ -0,0 +1,459 @@
+#include "SpatialIndex.h"
+#include "../../Core/Drawable.h"
+#include <math.h>
+
+
+namespace GameDev2D
+{
+    //A Drawable that would be in more cells than this is kept in the oversized list instead
+    const long long SPATIAL_INDEX_MAX_CELLS_PER_PROXY = 64;
+
+    //Cell coordinates are clamped to this range, so that very distant positions don't overflow
+    const float SPATIAL_INDEX_MAX_CELL_COORDINATE = 1073741824.0f;
+
+    //The number of proxies the arrays are reserved for
+    const unsigned int SPATIAL_INDEX_PROXY_RESERVE = 1024;
+
+    //Returns wether two sets of edges overlap, edges that touch overlap
+    static inline bool Overlaps(float aLeft, float aRight, float aBottom, float aTop, float aOtherLeft, float aOtherRight, float aOtherBottom, float aOtherTop)
+    {
+        return aLeft <= aOtherRight && aOtherLeft <= aRight && aBottom <= aOtherTop && aOtherBottom <= aTop;
+    }
+
+    SpatialIndex::SpatialIndex(float aCellSize) :
+        m_CellSize(aCellSize),
+        m_InverseCellSize(1.0f / aCellSize),
+        m_QueryStamp(0),
+        m_Count(0)
+    {
+        m_Proxies.reserve(SPATIAL_INDEX_PROXY_RESERVE);
+        m_DirtyProxies.reserve(SPATIAL_INDEX_PROXY_RESERVE);
+    }
+
+    SpatialIndex::~SpatialIndex()
+    {
+        //The Drawables are detached from the index, so that they don't refer to it after it's deleted
+        Clear();
+    }
+
+    void SpatialIndex::Add(Drawable* aDrawable)
+    {
+        if (aDrawable == nullptr || aDrawable->m_SpatialIndex == this)
+        {
+            return;
+        }
+
+        //A Drawable can only be in one index
+        if (aDrawable->m_SpatialIndex != nullptr)
+        {
+            aDrawable->m_SpatialIndex->Remove(aDrawable);
+        }
+
+        //Reuse a free proxy if there is one
+        unsigned int proxy;
+        if (m_FreeProxies.empty() == false)
+        {
+            proxy = m_FreeProxies.back();
+            m_FreeProxies.pop_back();
+        }
+        else
+        {
+            proxy = static_cast<unsigned int>(m_Proxies.size());
+            m_Proxies.push_back(Proxy());
+        }
+
+        m_Proxies[proxy].drawable = aDrawable;
+        m_Proxies[proxy].queryStamp = 0;
+        m_Proxies[proxy].isDirty = false;
+        aDrawable->m_SpatialIndex = this;
+        aDrawable->m_SpatialIndexProxy = proxy;
+
+        Insert(proxy);
+        m_Count++;
+    }
+
+    void SpatialIndex::Remove(Drawable* aDrawable)
+    {
+        if (aDrawable == nullptr || aDrawable->m_SpatialIndex != this)
+        {
+            return;
+        }
+
+        //The proxy may still be in the dirty list, it's skipped there because it no longer has a Drawable
+        unsigned int proxy = aDrawable->m_SpatialIndexProxy;
+        Erase(proxy);
+        m_Proxies[proxy].drawable = nullptr;
+        m_Proxies[proxy].isDirty = false;
+        m_FreeProxies.push_back(proxy);
+
+        aDrawable->m_SpatialIndex = nullptr;
+        aDrawable->m_SpatialIndexProxy = SPATIAL_INDEX_INVALID_PROXY;
+        m_Count--;
+    }
+
+    bool SpatialIndex::Contains(Drawable* aDrawable)
+    {
+        return aDrawable != nullptr && aDrawable->m_SpatialIndex == this;
+    }
+
+    void SpatialIndex::Clear()
+    {
+        for (unsigned int i = 0; i < m_Proxies.size(); i++)
+        {
+            if (m_Proxies[i].drawable != nullptr)
+            {
+                m_Proxies[i].drawable->m_SpatialIndex = nullptr;
+                m_Proxies[i].drawable->m_SpatialIndexProxy = SPATIAL_INDEX_INVALID_PROXY;
+            }
+        }
+
+        m_Proxies.clear();
+        m_FreeProxies.clear();
+        m_DirtyProxies.clear();
+        m_OversizedProxies.clear();
+        m_Cells.clear();
+        m_FreeCells.clear();
+        m_CellMap.clear();
+        m_Count = 0;
+    }
+
+    void SpatialIndex::Update()
+    {
+        for (unsigned int i = 0; i < m_DirtyProxies.size(); i++)
+        {
+            unsigned int proxy = m_DirtyProxies[i];
+            Proxy& dirtyProxy = m_Proxies[proxy];
+            if (dirtyProxy.drawable == nullptr || dirtyProxy.isDirty == false)
+            {
+                continue;
+            }
+            dirtyProxy.isDirty = false;
+
+            //If the Drawable is still in the same cells, only its edges need to be updated
+            Drawable* drawable = dirtyProxy.drawable;
+            float left = drawable->GetLeftEdge();
+            float right = drawable->GetRightEdge();
+            float bottom = drawable->GetBottomEdge();
+            float top = drawable->GetTopEdge();
+            if (dirtyProxy.isOversized == false &&
+                GetCellCoordinate(left) == dirtyProxy.cellLeft && GetCellCoordinate(right) == dirtyProxy.cellRight &&
+                GetCellCoordinate(bottom) == dirtyProxy.cellBottom && GetCellCoordinate(top) == dirtyProxy.cellTop)
+            {
+                dirtyProxy.left = left;
+                dirtyProxy.right = right;
+                dirtyProxy.bottom = bottom;
+                dirtyProxy.top = top;
+                continue;
+            }
+
+            Erase(proxy);
+            Insert(proxy);
+        }
+
+        m_DirtyProxies.clear();
+    }
+
+    unsigned int SpatialIndex::QueryRegion(const Rect& aRegion, std::vector<Drawable*>& aResults)
+    {
+        Update();
+
+        //Each query has a new stamp, a Drawable that is in several cells is only added by the first cell
+        m_QueryStamp++;
+        if (m_QueryStamp == 0)
+        {
+            for (unsigned int i = 0; i < m_Proxies.size(); i++)
+            {
+                m_Proxies[i].queryStamp = 0;
+            }
+            m_QueryStamp = 1;
+        }
+
+        size_t count = aResults.size();
+        float left = aRegion.origin.x;
+        float right = aRegion.origin.x + aRegion.size.x;
+        float bottom = aRegion.origin.y;
+        float top = aRegion.origin.y + aRegion.size.y;
+        int cellLeft = GetCellCoordinate(left);
+        int cellRight = GetCellCoordinate(right);
+        int cellBottom = GetCellCoordinate(bottom);
+        int cellTop = GetCellCoordinate(top);
+
+        //A region that covers more cells than are allocated checks the allocated cells instead
+        long long cells = ((long long)cellRight - cellLeft + 1) * ((long long)cellTop - cellBottom + 1);
+        if (cells > (long long)m_CellMap.size())
+        {
+            for (std::unordered_map<unsigned long long, unsigned int>::iterator it = m_CellMap.begin(); it != m_CellMap.end(); ++it)
+            {
+                int x = (int)(unsigned int)(it->first >> 32);
+                int y = (int)(unsigned int)(it->first & 0xffffffff);
+                if (x >= cellLeft && x <= cellRight && y >= cellBottom && y <= cellTop)
+                {
+                    QueryCell(m_Cells[it->second], left, right, bottom, top, aResults);
+                }
+            }
+        }
+        else
+        {
+            for (int y = cellBottom; y <= cellTop; y++)
+            {
+                for (int x = cellLeft; x <= cellRight; x++)
+                {
+                    std::unordered_map<unsigned long long, unsigned int>::iterator it = m_CellMap.find(GetCellKey(x, y));
+                    if (it != m_CellMap.end())
+                    {
+                        QueryCell(m_Cells[it->second], left, right, bottom, top, aResults);
+                    }
+                }
+            }
+        }
+
+        //The oversized Drawables aren't in any cell
+        for (unsigned int i = 0; i < m_OversizedProxies.size(); i++)
+        {
+            const Proxy& proxy = m_Proxies[m_OversizedProxies[i]];
+            if (Overlaps(proxy.left, proxy.right, proxy.bottom, proxy.top, left, right, bottom, top) == true)
+            {
+                aResults.push_back(proxy.drawable);
+            }
+        }
+
+        return static_cast<unsigned int>(aResults.size() - count);
+    }
+
+    unsigned int SpatialIndex::QueryPoint(const Vector2& aPoint, std::vector<Drawable*>& aResults)
+    {
+        return QueryRegion(Rect(aPoint, Vector2(0.0f, 0.0f)), aResults);
+    }
+
+    unsigned int SpatialIndex::QueryPairs(std::vector<std::pair<Drawable*, Drawable*>>& aPairs)
+    {
+        Update();
+
+        size_t count = aPairs.size();
+
+        //The Drawables in each cell are tested against each other
+        for (std::unordered_map<unsigned long long, unsigned int>::iterator it = m_CellMap.begin(); it != m_CellMap.end(); ++it)
+        {
+            int x = (int)(unsigned int)(it->first >> 32);
+            int y = (int)(unsigned int)(it->first & 0xffffffff);
+            const std::vector<unsigned int>& cell = m_Cells[it->second];
+
+            for (unsigned int i = 0; i < cell.size(); i++)
+            {
+                const Proxy& a = m_Proxies[cell[i]];
+                for (unsigned int j = i + 1; j < cell.size(); j++)
+                {
+                    const Proxy& b = m_Proxies[cell[j]];
+                    if (Overlaps(a.left, a.right, a.bottom, a.top, b.left, b.right, b.bottom, b.top) == true)
+                    {
+                        //Two Drawables can share several cells, the pair is only added by the cell that holds the bottom left corner of their overlap
+                        if (GetCellCoordinate(fmaxf(a.left, b.left)) == x && GetCellCoordinate(fmaxf(a.bottom, b.bottom)) == y)
+                        {
+                            aPairs.push_back(std::make_pair(a.drawable, b.drawable));
+                        }
+                    }
+                }
+            }
+        }
+
+        //The oversized Drawables are tested against every other Drawable, a pair of oversized Drawables is tested once
+        for (unsigned int i = 0; i < m_OversizedProxies.size(); i++)
+        {
+            unsigned int oversized = m_OversizedProxies[i];
+            const Proxy& a = m_Proxies[oversized];
+            for (unsigned int j = 0; j < m_Proxies.size(); j++)
+            {
+                const Proxy& b = m_Proxies[j];
+                if (b.drawable == nullptr || j == oversized || (b.isOversized == true && j < oversized))
+                {
+                    continue;
+                }
+
+                if (Overlaps(a.left, a.right, a.bottom, a.top, b.left, b.right, b.bottom, b.top) == true)
+                {
+                    aPairs.push_back(std::make_pair(a.drawable, b.drawable));
+                }
+            }
+        }
+
+        return static_cast<unsigned int>(aPairs.size() - count);
+    }
+
+    void SpatialIndex::SetCellSize(float aCellSize)
+    {
+        if (aCellSize <= 0.0f || aCellSize == m_CellSize)
+        {
+            return;
+        }
+
+        //Empty the cells, then re-insert every Drawable with the new cell size
+        m_OversizedProxies.clear();
+        m_Cells.clear();
+        m_FreeCells.clear();
+        m_CellMap.clear();
+
+        m_CellSize = aCellSize;
+        m_InverseCellSize = 1.0f / aCellSize;
+
+        for (unsigned int i = 0; i < m_Proxies.size(); i++)
+        {
+            if (m_Proxies[i].drawable != nullptr)
+            {
+                m_Proxies[i].isDirty = false;
+                Insert(i);
+            }
+        }
+        m_DirtyProxies.clear();
+    }
+
+    float SpatialIndex::GetCellSize()
+    {
+        return m_CellSize;
+    }
+
+    unsigned int SpatialIndex::GetCount()
+    {
+        return m_Count;
+    }
+
+    unsigned int SpatialIndex::GetCellCount()
+    {
+        return static_cast<unsigned int>(m_CellMap.size());
+    }
+
+    void SpatialIndex::Invalidate(unsigned int aProxy)
+    {
+        if (m_Proxies[aProxy].isDirty == false)
+        {
+            m_Proxies[aProxy].isDirty = true;
+            m_DirtyProxies.push_back(aProxy);
+        }
+    }
+
+    void SpatialIndex::Insert(unsigned int aProxy)
+    {
+        Proxy& proxy = m_Proxies[aProxy];
+        proxy.left = proxy.drawable->GetLeftEdge();
+        proxy.right = proxy.drawable->GetRightEdge();
+        proxy.bottom = proxy.drawable->GetBottomEdge();
+        proxy.top = proxy.drawable->GetTopEdge();
+        proxy.cellLeft = GetCellCoordinate(proxy.left);
+        proxy.cellRight = GetCellCoordinate(proxy.right);
+        proxy.cellBottom = GetCellCoordinate(proxy.bottom);
+        proxy.cellTop = GetCellCoordinate(proxy.top);
+
+        //A Drawable that is much larger than the cells goes in the oversized list
+        long long cells = ((long long)proxy.cellRight - proxy.cellLeft + 1) * ((long long)proxy.cellTop - proxy.cellBottom + 1);
+        proxy.isOversized = cells > SPATIAL_INDEX_MAX_CELLS_PER_PROXY;
+        if (proxy.isOversized == true)
+        {
+            m_OversizedProxies.push_back(aProxy);
+            return;
+        }
+
+        for (int y = proxy.cellBottom; y <= proxy.cellTop; y++)
+        {
+            for (int x = proxy.cellLeft; x <= proxy.cellRight; x++)
+            {
+                //Allocate the cell if it doesn't exist, reusing a free cell's storage if there is one
+                unsigned long long key = GetCellKey(x, y);
+                std::unordered_map<unsigned long long, unsigned int>::iterator it = m_CellMap.find(key);
+                if (it == m_CellMap.end())
+                {
+                    unsigned int cell;
+                    if (m_FreeCells.empty() == false)
+                    {
+                        cell = m_FreeCells.back();
+                        m_FreeCells.pop_back();
+                    }
+                    else
+                    {
+                        cell = static_cast<unsigned int>(m_Cells.size());
+                        m_Cells.push_back(std::vector<unsigned int>());
+                    }
+                    it = m_CellMap.insert(std::make_pair(key, cell)).first;
+                }
+
+                m_Cells[it->second].push_back(aProxy);
+            }
+        }
+    }
+
+    void SpatialIndex::Erase(unsigned int aProxy)
+    {
+        const Proxy& proxy = m_Proxies[aProxy];
+        if (proxy.isOversized == true)
+        {
+            for (unsigned int i = 0; i < m_OversizedProxies.size(); i++)
+            {
+                if (m_OversizedProxies[i] == aProxy)
+                {
+                    m_OversizedProxies[i] = m_OversizedProxies.back();
+                    m_OversizedProxies.pop_back();
+                    break;
+                }
+            }
+            return;
+        }
+
+        for (int y = proxy.cellBottom; y <= proxy.cellTop; y++)
+        {
+            for (int x = proxy.cellLeft; x <= proxy.cellRight; x++)
+            {
+                std::unordered_map<unsigned long long, unsigned int>::iterator it = m_CellMap.find(GetCellKey(x, y));
+                if (it == m_CellMap.end())
+                {
+                    continue;
+                }
+
+                //The order of the proxies in a cell doesn't matter, the proxy is swapped with the last one
+                std::vector<unsigned int>& cell = m_Cells[it->second];
+                for (unsigned int i = 0; i < cell.size(); i++)
+                {
+                    if (cell[i] == aProxy)
+                    {
+                        cell[i] = cell.back();
+                        cell.pop_back();
+                        break;
+                    }
+                }
+
+                //An empty cell is freed, its storage is kept for the next cell that is allocated
+                if (cell.empty() == true)
+                {
+                    m_FreeCells.push_back(it->second);
+                    m_CellMap.erase(it);
+                }
+            }
+        }
+    }
+
+    int SpatialIndex::GetCellCoordinate(float aPosition)
+    {
+        float coordinate = floorf(aPosition * m_InverseCellSize);
+        coordinate = coordinate < -SPATIAL_INDEX_MAX_CELL_COORDINATE ? -SPATIAL_INDEX_MAX_CELL_COORDINATE : coordinate;
+        coordinate = coordinate > SPATIAL_INDEX_MAX_CELL_COORDINATE ? SPATIAL_INDEX_MAX_CELL_COORDINATE : coordinate;
+        return (int)coordinate;
+    }
+
+    unsigned long long SpatialIndex::GetCellKey(int aX, int aY)
+    {
+        return ((unsigned long long)(unsigned int)aX << 32) | (unsigned int)aY;
+    }
+
+    void SpatialIndex::QueryCell(const std::vector<unsigned int>& aCell, float aLeft, float aRight, float aBottom, float aTop, std::vector<Drawable*>& aResults)
+    {
+        for (unsigned int i = 0; i < aCell.size(); i++)
+        {
+            Proxy& proxy = m_Proxies[aCell[i]];
+            if (proxy.queryStamp != m_QueryStamp)
+            {
+                proxy.queryStamp = m_QueryStamp;
+                if (Overlaps(proxy.left, proxy.right, proxy.bottom, proxy.top, aLeft, aRight, aBottom, aTop) == true)
+                {
+                    aResults.push_back(proxy.drawable);
+                }
+            }
+        }
+    }
+}
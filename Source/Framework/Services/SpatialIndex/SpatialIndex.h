@@ -0,0 +1,117 @@
+#pragma once
+
+#include "../../Graphics/GraphicTypes.h"
+#include "../../Math/Vector2.h"
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Forward declarations
+    class Drawable;
+
+    //Local constants
+    const float SPATIAL_INDEX_DEFAULT_CELL_SIZE = 128.0f;
+    const unsigned int SPATIAL_INDEX_INVALID_PROXY = 0xffffffff;
+
+    //The SpatialIndex game service is a broad-phase for picking, collision and range queries over Drawables. Drawables are
+    //stored by their edges in a uniform grid of square cells, only the cells that hold a Drawable are allocated (a spatial
+    //hash), so the world doesn't need bounds. A query only looks at the cells it overlaps, its cost depends on the number of
+    //Drawables it finds rather than the number of Drawables in the index. The cell size should be about the size of a
+    //typical Drawable, Drawables that would span too many cells are kept in a separate list that every query checks.
+    //
+    //A Drawable notifies the index when its transform, anchor or size changes, the index then updates the Drawable's cells
+    //before the next query. A Drawable removes itself from the index when it is deleted
+    class SpatialIndex
+    {
+    public:
+        SpatialIndex(float cellSize = SPATIAL_INDEX_DEFAULT_CELL_SIZE);
+        ~SpatialIndex();
+
+        //Adds a Drawable to the index, a Drawable can only be in one SpatialIndex at a time
+        void Add(Drawable* drawable);
+
+        //Removes a Drawable from the index
+        void Remove(Drawable* drawable);
+
+        //Returns wether the Drawable is in the index
+        bool Contains(Drawable* drawable);
+
+        //Removes every Drawable from the index
+        void Clear();
+
+        //Updates the cells of the Drawables that changed since the last update, the queries call it before they run
+        void Update();
+
+        //Adds the Drawables whose edges overlap the region to the results, returns the number of Drawables that were added
+        unsigned int QueryRegion(const Rect& region, std::vector<Drawable*>& results);
+
+        //Adds the Drawables whose edges contain the point to the results, returns the number of Drawables that were added
+        unsigned int QueryPoint(const Vector2& point, std::vector<Drawable*>& results);
+
+        //Adds every pair of Drawables whose edges overlap to the pairs, each pair is added once. Returns the number of pairs that were added
+        unsigned int QueryPairs(std::vector<std::pair<Drawable*, Drawable*>>& pairs);
+
+        //Sets the size of the cells, every Drawable is re-inserted
+        void SetCellSize(float cellSize);
+        float GetCellSize();
+
+        //Returns the number of Drawables in the index and the number of cells that hold at least one Drawable
+        unsigned int GetCount();
+        unsigned int GetCellCount();
+
+    private:
+        //The Drawable calls Invalidate() when its edges change
+        friend class Drawable;
+
+        //A Drawable's entry in the index, the Drawable's edges and the range of cells it's in
+        struct Proxy
+        {
+            Drawable* drawable;
+            float left;
+            float right;
+            float bottom;
+            float top;
+            int cellLeft;
+            int cellRight;
+            int cellBottom;
+            int cellTop;
+            unsigned int queryStamp;
+            bool isDirty;
+            bool isOversized;
+        };
+
+        //Marks a proxy as changed, it is updated before the next query
+        void Invalidate(unsigned int proxy);
+
+        //Reads a Drawable's edges into its proxy, then adds the proxy to the cells it overlaps
+        void Insert(unsigned int proxy);
+
+        //Removes a proxy from the cells it's in
+        void Erase(unsigned int proxy);
+
+        //Returns the cell coordinate of a position along one axis
+        int GetCellCoordinate(float position);
+
+        //Returns the key of a cell, for the cell map
+        unsigned long long GetCellKey(int x, int y);
+
+        //Adds the proxies in a cell that overlap the edges to the results
+        void QueryCell(const std::vector<unsigned int>& cell, float left, float right, float bottom, float top, std::vector<Drawable*>& results);
+
+        //Member variables
+        std::vector<Proxy> m_Proxies;
+        std::vector<unsigned int> m_FreeProxies;
+        std::vector<unsigned int> m_DirtyProxies;
+        std::vector<unsigned int> m_OversizedProxies;
+        std::vector<std::vector<unsigned int>> m_Cells;
+        std::vector<unsigned int> m_FreeCells;
+        std::unordered_map<unsigned long long, unsigned int> m_CellMap;
+        float m_CellSize;
+        float m_InverseCellSize;
+        unsigned int m_QueryStamp;
+        unsigned int m_Count;
+    };
+}
@@ -0,0 +1,35 @@
+#include "TweenManager.h"
+#include "../Services.h"
+#include "../../Events/UpdateEvent.h"
+#include "../../Windows/Application.h"
+
+
+namespace GameDev2D
+{
+    TweenManager::TweenManager() : EventHandler(), TweenSet()
+    {
+        //Add an event listener callback for the Update event
+        Services::GetApplication()->AddEventListener(this, UPDATE_EVENT);
+    }
+
+    TweenManager::~TweenManager()
+    {
+        //Remove the event listener callback for the Update event
+        Services::GetApplication()->RemoveEventListener(this, UPDATE_EVENT);
+    }
+
+    void TweenManager::HandleEvent(Event* aEvent)
+    {
+        if (aEvent != nullptr)
+        {
+            if (aEvent->GetEventCode() == UPDATE_EVENT)
+            {
+                //Get the UpdateEvent
+                UpdateEvent* updateEvent = (UpdateEvent*)aEvent;
+
+                //Update the tweens
+                Update(updateEvent->GetDelta());
+            }
+        }
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../../Animation/TweenSet.h"
+#include "../../Events/EventHandler.h"
+
+
+namespace GameDev2D
+{
+    //The TweenManager game service is a TweenSet that listens for the Update event, every frame it updates all the tweens
+    //in one loop. See TweenSet for the tweens themselves
+    class TweenManager : public EventHandler, public TweenSet
+    {
+    public:
+        TweenManager();
+        ~TweenManager();
+
+        //The HandleEvent is used to notify the TweenManager class of various GameDev2D events
+        void HandleEvent(Event* event);
+    };
+}
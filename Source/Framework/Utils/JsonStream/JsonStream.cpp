@@ -0,0 +1,634 @@
+#include "JsonStream.h"
+#include <fstream>
+#include <locale>
+#include <sstream>
+#include <string.h>
+
+
+namespace GameDev2D
+{
+    //The maximum object/array nesting that will be streamed before the json data is considered malformed
+    const unsigned int JSON_STREAM_MAX_DEPTH = 256;
+
+    //The number of significant digits that are gathered into a number's mantissa, 19 digits always fit in 64 bits
+    const unsigned int JSON_STREAM_MAX_MANTISSA_DIGITS = 19;
+
+    //Numbers whose mantissa is at most 2^53 and whose power of ten is at most 10^22 are exact doubles, they are
+    //converted with a single multiply or divide. The other numbers are converted by ParseLongNumber()
+    const unsigned long long JSON_STREAM_MAX_EXACT_INTEGER = 9007199254740992ULL;
+    const int JSON_STREAM_MAX_EXACT_POWER = 22;
+
+    //A number's exponent stops being read at this value, it is far outside the range of a double
+    const int JSON_STREAM_MAX_EXPONENT = 100000;
+
+    //Internal cursor over the json buffer, used by JsonStream::Parse()
+    class JsonStreamParser
+    {
+    public:
+        JsonStreamParser(const char* aBuffer, unsigned int aLength, JsonStreamHandler* aHandler) :
+            m_Current(aBuffer),
+            m_End(aBuffer + aLength),
+            m_Handler(aHandler),
+            m_Depth(0)
+        {
+        }
+
+        bool ParseDocument()
+        {
+            if (ParseValue() == false)
+            {
+                return false;
+            }
+
+            //Only whitespace is allowed after the root value
+            SkipWhitespace();
+            return m_Current == m_End;
+        }
+
+    private:
+        void SkipWhitespace()
+        {
+            while (m_Current < m_End && (*m_Current == ' ' || *m_Current == '\t' || *m_Current == '\n' || *m_Current == '\r'))
+            {
+                m_Current++;
+            }
+        }
+
+        bool Match(const char* aLiteral, unsigned int aLength)
+        {
+            if ((unsigned int)(m_End - m_Current) >= aLength && memcmp(m_Current, aLiteral, aLength) == 0)
+            {
+                m_Current += aLength;
+                return true;
+            }
+            return false;
+        }
+
+        bool ParseValue()
+        {
+            SkipWhitespace();
+            if (m_Current >= m_End)
+            {
+                return false;
+            }
+
+            switch (*m_Current)
+            {
+            case '{':
+                return ParseObject();
+
+            case '[':
+                return ParseArray();
+
+            case '"':
+            {
+                const char* value = nullptr;
+                unsigned int length = 0;
+                if (ParseString(&value, &length) == false)
+                {
+                    return false;
+                }
+                m_Handler->OnString(value, length);
+                return true;
+            }
+
+            case 't':
+                if (Match("true", 4) == false)
+                {
+                    return false;
+                }
+                m_Handler->OnBool(true);
+                return true;
+
+            case 'f':
+                if (Match("false", 5) == false)
+                {
+                    return false;
+                }
+                m_Handler->OnBool(false);
+                return true;
+
+            case 'n':
+                if (Match("null", 4) == false)
+                {
+                    return false;
+                }
+                m_Handler->OnNull();
+                return true;
+
+            default:
+                return ParseNumber();
+            }
+        }
+
+        bool ParseObject()
+        {
+            //Skip the '{'
+            m_Current++;
+
+            if (++m_Depth > JSON_STREAM_MAX_DEPTH)
+            {
+                return false;
+            }
+
+            m_Handler->OnObjectBegin();
+
+            SkipWhitespace();
+            if (m_Current < m_End && *m_Current == '}')
+            {
+                m_Current++;
+            }
+            else
+            {
+                while (true)
+                {
+                    //Parse the member's key
+                    SkipWhitespace();
+                    if (m_Current >= m_End || *m_Current != '"')
+                    {
+                        return false;
+                    }
+
+                    const char* key = nullptr;
+                    unsigned int length = 0;
+                    if (ParseString(&key, &length) == false)
+                    {
+                        return false;
+                    }
+                    m_Handler->OnKey(key, length);
+
+                    //Parse the member's value
+                    SkipWhitespace();
+                    if (m_Current >= m_End || *m_Current != ':')
+                    {
+                        return false;
+                    }
+                    m_Current++;
+
+                    if (ParseValue() == false)
+                    {
+                        return false;
+                    }
+
+                    //Is there another member, or is the object done?
+                    SkipWhitespace();
+                    if (m_Current >= m_End)
+                    {
+                        return false;
+                    }
+
+                    if (*m_Current == ',')
+                    {
+                        m_Current++;
+                    }
+                    else if (*m_Current == '}')
+                    {
+                        m_Current++;
+                        break;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            m_Depth--;
+            m_Handler->OnObjectEnd();
+            return true;
+        }
+
+        bool ParseArray()
+        {
+            //Skip the '['
+            m_Current++;
+
+            if (++m_Depth > JSON_STREAM_MAX_DEPTH)
+            {
+                return false;
+            }
+
+            m_Handler->OnArrayBegin();
+
+            SkipWhitespace();
+            if (m_Current < m_End && *m_Current == ']')
+            {
+                m_Current++;
+            }
+            else
+            {
+                while (true)
+                {
+                    if (ParseValue() == false)
+                    {
+                        return false;
+                    }
+
+                    //Is there another element, or is the array done?
+                    SkipWhitespace();
+                    if (m_Current >= m_End)
+                    {
+                        return false;
+                    }
+
+                    if (*m_Current == ',')
+                    {
+                        m_Current++;
+                    }
+                    else if (*m_Current == ']')
+                    {
+                        m_Current++;
+                        break;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            m_Depth--;
+            m_Handler->OnArrayEnd();
+            return true;
+        }
+
+        bool ParseNumber()
+        {
+            //The number is parsed by the json grammar, -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?, rather than by strtod.
+            //strtod depends on the C locale's decimal separator and accepts inf, nan and hex floats, which aren't json
+            const char* start = m_Current;
+            bool isNegative = false;
+            if (m_Current < m_End && *m_Current == '-')
+            {
+                isNegative = true;
+                m_Current++;
+            }
+
+            //The first 19 significant digits are gathered into the mantissa, the exponent is adjusted for the digits past them
+            unsigned long long mantissa = 0;
+            unsigned int digits = 0;
+            int exponent = 0;
+            bool isTruncated = false;
+
+            //The integer part, a leading zero can't be followed by more digits
+            if (m_Current >= m_End || IsDigit(*m_Current) == false)
+            {
+                return false;
+            }
+
+            if (*m_Current == '0')
+            {
+                m_Current++;
+            }
+            else
+            {
+                while (m_Current < m_End && IsDigit(*m_Current) == true)
+                {
+                    if (AddDigit(*m_Current++, &mantissa, &digits) == false)
+                    {
+                        isTruncated = true;
+                        exponent++;
+                    }
+                }
+            }
+
+            //The fraction part
+            if (m_Current < m_End && *m_Current == '.')
+            {
+                m_Current++;
+                if (m_Current >= m_End || IsDigit(*m_Current) == false)
+                {
+                    return false;
+                }
+
+                while (m_Current < m_End && IsDigit(*m_Current) == true)
+                {
+                    if (AddDigit(*m_Current++, &mantissa, &digits) == true)
+                    {
+                        exponent--;
+                    }
+                    else
+                    {
+                        isTruncated = true;
+                    }
+                }
+            }
+
+            //The exponent part, it's clamped well past the range of a double so that it can't overflow
+            if (m_Current < m_End && (*m_Current == 'e' || *m_Current == 'E'))
+            {
+                m_Current++;
+                bool isExponentNegative = false;
+                if (m_Current < m_End && (*m_Current == '+' || *m_Current == '-'))
+                {
+                    isExponentNegative = *m_Current == '-';
+                    m_Current++;
+                }
+
+                if (m_Current >= m_End || IsDigit(*m_Current) == false)
+                {
+                    return false;
+                }
+
+                int value = 0;
+                while (m_Current < m_End && IsDigit(*m_Current) == true)
+                {
+                    if (value < JSON_STREAM_MAX_EXPONENT)
+                    {
+                        value = value * 10 + (*m_Current - '0');
+                    }
+                    m_Current++;
+                }
+
+                exponent += isExponentNegative == true ? -value : value;
+            }
+
+            double value = 0.0;
+            if (mantissa == 0)
+            {
+                value = 0.0;
+            }
+            else if (isTruncated == false && mantissa <= JSON_STREAM_MAX_EXACT_INTEGER && exponent >= -JSON_STREAM_MAX_EXACT_POWER && exponent <= JSON_STREAM_MAX_EXACT_POWER)
+            {
+                //The mantissa and the power of ten are both exact doubles, so a single multiply or divide is correctly rounded
+                value = exponent < 0 ? (double)mantissa / s_PowersOfTen[-exponent] : (double)mantissa * s_PowersOfTen[exponent];
+            }
+            else if (ParseLongNumber(start, &value) == false)
+            {
+                //A number too small for a double underflows to zero, a number too large for a double is malformed
+                if (exponent > 0)
+                {
+                    return false;
+                }
+                value = 0.0;
+            }
+
+            m_Handler->OnNumber(isNegative == true ? -value : value);
+            return true;
+        }
+
+        static bool IsDigit(char aCharacter)
+        {
+            return aCharacter >= '0' && aCharacter <= '9';
+        }
+
+        //Adds a digit to the mantissa, leading zeros aren't counted. Returns false if the mantissa is full
+        //and the digit was dropped
+        static bool AddDigit(char aDigit, unsigned long long* aMantissa, unsigned int* aDigits)
+        {
+            if (*aDigits >= JSON_STREAM_MAX_MANTISSA_DIGITS)
+            {
+                return false;
+            }
+
+            *aMantissa = *aMantissa * 10 + (unsigned long long)(aDigit - '0');
+            if (*aMantissa != 0)
+            {
+                (*aDigits)++;
+            }
+            return true;
+        }
+
+        //Converts a number that has too many digits OR too large an exponent to be converted exactly, through a
+        //stream with the classic locale, so that it doesn't depend on the C locale either. The number has been
+        //validated, it ends at m_Current. Returns false if the number is out of the range of a double
+        bool ParseLongNumber(const char* aStart, double* aValue)
+        {
+            //The sign is applied by ParseNumber()
+            if (*aStart == '-')
+            {
+                aStart++;
+            }
+
+            std::istringstream stream(std::string(aStart, m_Current));
+            stream.imbue(std::locale::classic());
+            stream >> *aValue;
+            return stream.fail() == false;
+        }
+
+        bool ParseString(const char** aValue, unsigned int* aLength)
+        {
+            //Skip the opening quote
+            m_Current++;
+            const char* start = m_Current;
+
+            //Fast path, strings without escape sequences are passed straight out of the buffer
+            while (m_Current < m_End && *m_Current != '"' && *m_Current != '\\')
+            {
+                m_Current++;
+            }
+
+            if (m_Current >= m_End)
+            {
+                return false;
+            }
+
+            if (*m_Current == '"')
+            {
+                *aValue = start;
+                *aLength = (unsigned int)(m_Current - start);
+                m_Current++;
+                return true;
+            }
+
+            //Slow path, the string contains escape sequences, decode it into the scratch buffer
+            m_Scratch.assign(start, m_Current);
+            while (m_Current < m_End && *m_Current != '"')
+            {
+                char c = *m_Current++;
+                if (c != '\\')
+                {
+                    m_Scratch.push_back(c);
+                    continue;
+                }
+
+                if (m_Current >= m_End)
+                {
+                    return false;
+                }
+
+                char escape = *m_Current++;
+                switch (escape)
+                {
+                case '"':  m_Scratch.push_back('"');  break;
+                case '\\': m_Scratch.push_back('\\'); break;
+                case '/':  m_Scratch.push_back('/');  break;
+                case 'b':  m_Scratch.push_back('\b'); break;
+                case 'f':  m_Scratch.push_back('\f'); break;
+                case 'n':  m_Scratch.push_back('\n'); break;
+                case 'r':  m_Scratch.push_back('\r'); break;
+                case 't':  m_Scratch.push_back('\t'); break;
+                case 'u':
+                {
+                    unsigned int codePoint = 0;
+                    if (ParseUnicode(&codePoint) == false)
+                    {
+                        return false;
+                    }
+                    AppendUtf8(codePoint);
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+
+            if (m_Current >= m_End)
+            {
+                return false;
+            }
+
+            //Skip the closing quote
+            m_Current++;
+
+            *aValue = m_Scratch.data();
+            *aLength = (unsigned int)m_Scratch.size();
+            return true;
+        }
+
+        bool ParseHex4(unsigned int* aValue)
+        {
+            if (m_End - m_Current < 4)
+            {
+                return false;
+            }
+
+            unsigned int value = 0;
+            for (unsigned int i = 0; i < 4; i++)
+            {
+                char c = *m_Current++;
+                value <<= 4;
+                if (c >= '0' && c <= '9')
+                {
+                    value += c - '0';
+                }
+                else if (c >= 'a' && c <= 'f')
+                {
+                    value += c - 'a' + 10;
+                }
+                else if (c >= 'A' && c <= 'F')
+                {
+                    value += c - 'A' + 10;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            *aValue = value;
+            return true;
+        }
+
+        bool ParseUnicode(unsigned int* aCodePoint)
+        {
+            unsigned int codePoint = 0;
+            if (ParseHex4(&codePoint) == false)
+            {
+                return false;
+            }
+
+            //Is it the high half of a surrogate pair?
+            if (codePoint >= 0xd800 && codePoint <= 0xdbff)
+            {
+                unsigned int low = 0;
+                if (Match("\\u", 2) == false || ParseHex4(&low) == false || low < 0xdc00 || low > 0xdfff)
+                {
+                    return false;
+                }
+                codePoint = 0x10000 + ((codePoint & 0x3ff) << 10) + (low & 0x3ff);
+            }
+
+            *aCodePoint = codePoint;
+            return true;
+        }
+
+        void AppendUtf8(unsigned int aCodePoint)
+        {
+            if (aCodePoint < 0x80)
+            {
+                m_Scratch.push_back((char)aCodePoint);
+            }
+            else if (aCodePoint < 0x800)
+            {
+                m_Scratch.push_back((char)(0xc0 | (aCodePoint >> 6)));
+                m_Scratch.push_back((char)(0x80 | (aCodePoint & 0x3f)));
+            }
+            else if (aCodePoint < 0x10000)
+            {
+                m_Scratch.push_back((char)(0xe0 | (aCodePoint >> 12)));
+                m_Scratch.push_back((char)(0x80 | ((aCodePoint >> 6) & 0x3f)));
+                m_Scratch.push_back((char)(0x80 | (aCodePoint & 0x3f)));
+            }
+            else
+            {
+                m_Scratch.push_back((char)(0xf0 | (aCodePoint >> 18)));
+                m_Scratch.push_back((char)(0x80 | ((aCodePoint >> 12) & 0x3f)));
+                m_Scratch.push_back((char)(0x80 | ((aCodePoint >> 6) & 0x3f)));
+                m_Scratch.push_back((char)(0x80 | (aCodePoint & 0x3f)));
+            }
+        }
+
+        //Member variables
+        static const double s_PowersOfTen[];
+        const char* m_Current;
+        const char* m_End;
+        JsonStreamHandler* m_Handler;
+        std::string m_Scratch;
+        unsigned int m_Depth;
+    };
+
+    const double JsonStreamParser::s_PowersOfTen[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    bool JsonStream::ParseFile(const std::string& aPath, JsonStreamHandler* aHandler)
+    {
+        //Open the input stream at the end, so that we know the file size
+        std::ifstream inputStream(aPath.c_str(), std::ios::binary | std::ios::in | std::ios::ate);
+        if (inputStream.is_open() == false)
+        {
+            return false;
+        }
+
+        //Read the entire file in one go, the buffer is null terminated for the parser
+        std::streamoff size = inputStream.tellg();
+        if (size <= 0)
+        {
+            return false;
+        }
+
+        std::vector<char> buffer((size_t)size + 1);
+        inputStream.seekg(0, std::ios::beg);
+        inputStream.read(&buffer[0], size);
+        inputStream.close();
+        buffer[(size_t)size] = '\0';
+
+        return Parse(&buffer[0], (unsigned int)size, aHandler);
+    }
+
+    bool JsonStream::Parse(const char* aBuffer, unsigned int aLength, JsonStreamHandler* aHandler)
+    {
+        //Safety check the buffer and handler
+        if (aBuffer == nullptr || aHandler == nullptr)
+        {
+            return false;
+        }
+
+        //Skip the UTF-8 byte order mark, if there is one
+        if (aLength >= 3 && (unsigned char)aBuffer[0] == 0xef && (unsigned char)aBuffer[1] == 0xbb && (unsigned char)aBuffer[2] == 0xbf)
+        {
+            aBuffer += 3;
+            aLength -= 3;
+        }
+
+        JsonStreamParser parser(aBuffer, aLength, aHandler);
+        return parser.ParseDocument();
+    }
+
+    bool JsonStream::KeyEquals(const char* aKey, unsigned int aLength, const char* aLiteral)
+    {
+        return strlen(aLiteral) == aLength && memcmp(aKey, aLiteral, aLength) == 0;
+    }
+}
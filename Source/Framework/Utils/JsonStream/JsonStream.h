@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //The JsonStreamHandler is an interface to receive the events that are generated while a json document
+    //is being streamed by the JsonStream class. Inherit from it and override the methods for the events you
+    //are interested in. The key and string pointers passed in are only valid for the duration of the call.
+    class JsonStreamHandler
+    {
+    public:
+        virtual ~JsonStreamHandler() {}
+
+        virtual void OnObjectBegin() {}
+        virtual void OnObjectEnd() {}
+        virtual void OnArrayBegin() {}
+        virtual void OnArrayEnd() {}
+        virtual void OnKey(const char* key, unsigned int length) {}
+        virtual void OnString(const char* value, unsigned int length) {}
+        virtual void OnNumber(double value) {}
+        virtual void OnBool(bool value) {}
+        virtual void OnNull() {}
+    };
+
+    //A class that provides conveniance methods to parse json data in a single forward pass (SAX-style),
+    //without building a Json::Value tree. The parsed values are reported to a JsonStreamHandler as they are read.
+    class JsonStream
+    {
+    public:
+        //Reads the entire file at the path and streams it to the handler, returns false if the file
+        //couldn't be read OR if the json data is malformed
+        static bool ParseFile(const std::string& path, JsonStreamHandler* handler);
+
+        //Streams the json data to the handler, the buffer MUST be null terminated at buffer[length]
+        static bool Parse(const char* buffer, unsigned int length, JsonStreamHandler* handler);
+
+        //Returns true if the key (as passed into JsonStreamHandler::OnKey) matches the string literal
+        static bool KeyEquals(const char* key, unsigned int length, const char* literal);
+    };
+}
@@ -0,0 +1,536 @@
+#include "MetadataCache.h"
+#include "../../Graphics/GraphicTypes.h"
+#include "../../Graphics/SpriteAtlas.h"
+#include "../../Animation/AnimationClip.h"
+#include <fstream>
+#include <stddef.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+
+namespace GameDev2D
+{
+    //Cache constants, bump the version whenever the payload layout changes
+    const unsigned int METADATA_CACHE_MAGIC = 0x43444d47; //'GMDC'
+    const unsigned int METADATA_CACHE_VERSION = 2;
+    const unsigned int METADATA_CACHE_TYPE_FONT = 1;
+    const unsigned int METADATA_CACHE_TYPE_ATLAS = 2;
+    const unsigned int METADATA_CACHE_TYPE_ANIMATION_CLIP = 3;
+
+    //A source file modified this recently (in seconds) when its cache is written could still be modified again within
+    //the same modification time, its modification time isn't recorded so that the next load checks the hash instead
+    const long long METADATA_CACHE_RACY_SECONDS = 2;
+
+    //The header at the start of every cache file
+    struct MetadataCacheHeader
+    {
+        unsigned int magic;
+        unsigned int version;
+        unsigned int type;
+        unsigned int payloadSize;
+        unsigned long long sourceSize;
+        unsigned long long sourceModifiedTime;
+        unsigned long long sourceHash;
+    };
+
+    //Conveniance class to append values to a cache payload
+    class MetadataCacheWriter
+    {
+    public:
+        MetadataCacheWriter(std::vector<char>& aBuffer) :
+            m_Buffer(aBuffer)
+        {
+        }
+
+        template<typename T> void Write(const T& aValue)
+        {
+            const char* bytes = reinterpret_cast<const char*>(&aValue);
+            m_Buffer.insert(m_Buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void WriteString(const std::string& aValue)
+        {
+            Write((unsigned int)aValue.length());
+            m_Buffer.insert(m_Buffer.end(), aValue.begin(), aValue.end());
+        }
+
+        void WriteRect(const Rect& aRect)
+        {
+            Write(aRect.origin.x);
+            Write(aRect.origin.y);
+            Write(aRect.size.x);
+            Write(aRect.size.y);
+        }
+
+    private:
+        std::vector<char>& m_Buffer;
+    };
+
+    //Conveniance class to read values out of a cache payload, every read is bounds checked
+    class MetadataCacheReader
+    {
+    public:
+        MetadataCacheReader(const char* aBuffer, unsigned int aLength) :
+            m_Current(aBuffer),
+            m_End(aBuffer + aLength),
+            m_Failed(false)
+        {
+        }
+
+        template<typename T> T Read()
+        {
+            T value = T();
+            if (m_Failed == false && (unsigned int)(m_End - m_Current) >= sizeof(T))
+            {
+                memcpy(&value, m_Current, sizeof(T));
+                m_Current += sizeof(T);
+            }
+            else
+            {
+                m_Failed = true;
+            }
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            unsigned int length = Read<unsigned int>();
+            if (m_Failed == false && (unsigned int)(m_End - m_Current) >= length)
+            {
+                std::string value(m_Current, length);
+                m_Current += length;
+                return value;
+            }
+
+            m_Failed = true;
+            return std::string();
+        }
+
+        Rect ReadRect()
+        {
+            float x = Read<float>();
+            float y = Read<float>();
+            float width = Read<float>();
+            float height = Read<float>();
+            return Rect(Vector2(x, y), Vector2(width, height));
+        }
+
+        bool HasFailed()
+        {
+            return m_Failed;
+        }
+
+        //Returns true if every read succeeded AND the entire payload was consumed
+        bool IsValid()
+        {
+            return m_Failed == false && m_Current == m_End;
+        }
+
+    private:
+        const char* m_Current;
+        const char* m_End;
+        bool m_Failed;
+    };
+
+    bool MetadataCache::LoadFontData(const std::string& aSourcePath, FontData** aFontData)
+    {
+        //Read the cache file and make sure it is still valid for the source file
+        std::vector<char> cache;
+        if (ReadFile(GetCachePath(aSourcePath), cache) == false)
+        {
+            return false;
+        }
+
+        unsigned int offset = Validate(aSourcePath, cache, METADATA_CACHE_TYPE_FONT);
+        if (offset == 0)
+        {
+            return false;
+        }
+
+        //Read the font metrics
+        MetadataCacheReader reader(&cache[offset], (unsigned int)cache.size() - offset);
+        FontData* fontData = new FontData();
+        fontData->name = reader.ReadString();
+        fontData->characterSet = reader.ReadString();
+        fontData->lineHeight = reader.Read<unsigned int>();
+        fontData->baseline = reader.Read<unsigned int>();
+        fontData->size = reader.Read<unsigned int>();
+
+        //Read the glyphs
+        unsigned int glyphCount = reader.Read<unsigned int>();
+        for (unsigned int i = 0; i < glyphCount && reader.HasFailed() == false; i++)
+        {
+            char character = reader.Read<char>();
+            GlyphData& glyphData = fontData->glyphData[character];
+            glyphData.width = reader.Read<unsigned char>();
+            glyphData.height = reader.Read<unsigned char>();
+            glyphData.advanceX = reader.Read<unsigned char>();
+            glyphData.bearingX = reader.Read<char>();
+            glyphData.bearingY = reader.Read<char>();
+            glyphData.frame = reader.ReadRect();
+        }
+
+        //Was the entire payload read successfully?
+        if (reader.IsValid() == false)
+        {
+            delete fontData;
+            return false;
+        }
+
+        *aFontData = fontData;
+        return true;
+    }
+
+    bool MetadataCache::SaveFontData(const std::string& aSourcePath, const MetadataSource& aSource, FontData* aFontData)
+    {
+        //Safety check the font data
+        if (aFontData == nullptr)
+        {
+            return false;
+        }
+
+        //Write the font metrics
+        std::vector<char> payload;
+        MetadataCacheWriter writer(payload);
+        writer.WriteString(aFontData->name);
+        writer.WriteString(aFontData->characterSet);
+        writer.Write(aFontData->lineHeight);
+        writer.Write(aFontData->baseline);
+        writer.Write(aFontData->size);
+
+        //Write the glyphs
+        writer.Write((unsigned int)aFontData->glyphData.size());
+        for (std::map<char, GlyphData>::const_iterator iterator = aFontData->glyphData.begin(); iterator != aFontData->glyphData.end(); iterator++)
+        {
+            const GlyphData& glyphData = iterator->second;
+            writer.Write(iterator->first);
+            writer.Write(glyphData.width);
+            writer.Write(glyphData.height);
+            writer.Write(glyphData.advanceX);
+            writer.Write(glyphData.bearingX);
+            writer.Write(glyphData.bearingY);
+            writer.WriteRect(glyphData.frame);
+        }
+
+        return Write(aSourcePath, aSource, METADATA_CACHE_TYPE_FONT, payload);
+    }
+
+    bool MetadataCache::LoadAtlasMap(const std::string& aSourcePath, AtlasMap** aAtlasMap)
+    {
+        //Read the cache file and make sure it is still valid for the source file
+        std::vector<char> cache;
+        if (ReadFile(GetCachePath(aSourcePath), cache) == false)
+        {
+            return false;
+        }
+
+        unsigned int offset = Validate(aSourcePath, cache, METADATA_CACHE_TYPE_ATLAS);
+        if (offset == 0)
+        {
+            return false;
+        }
+
+        //Read the atlas frames
+        MetadataCacheReader reader(&cache[offset], (unsigned int)cache.size() - offset);
+        AtlasMap* atlasMap = new AtlasMap();
+        unsigned int frameCount = reader.Read<unsigned int>();
+        for (unsigned int i = 0; i < frameCount && reader.HasFailed() == false; i++)
+        {
+            std::string key = reader.ReadString();
+            Rect frame = reader.ReadRect();
+            atlasMap->Create(key, frame);
+        }
+
+        //Was the entire payload read successfully?
+        if (reader.IsValid() == false)
+        {
+            delete atlasMap;
+            return false;
+        }
+
+        *aAtlasMap = atlasMap;
+        return true;
+    }
+
+    bool MetadataCache::SaveAtlasMap(const std::string& aSourcePath, const MetadataSource& aSource, AtlasMap* aAtlasMap)
+    {
+        //Safety check the atlas map
+        if (aAtlasMap == nullptr)
+        {
+            return false;
+        }
+
+        //Write the atlas frames
+        std::vector<char> payload;
+        MetadataCacheWriter writer(payload);
+        writer.Write(aAtlasMap->Count());
+
+        //The frames are written in index order, so that the indices are the same once they're loaded
+        for (unsigned int i = 0; i < aAtlasMap->Count(); i++)
+        {
+            writer.WriteString(aAtlasMap->GetKey(i));
+            writer.WriteRect(aAtlasMap->GetFrame(i));
+        }
+
+        return Write(aSourcePath, aSource, METADATA_CACHE_TYPE_ATLAS, payload);
+    }
+
+    bool MetadataCache::LoadAnimationClip(const std::string& aSourcePath, AnimationClip** aAnimationClip)
+    {
+        //Read the cache file and make sure it is still valid for the source file
+        std::vector<char> cache;
+        if (ReadFile(GetCachePath(aSourcePath), cache) == false)
+        {
+            return false;
+        }
+
+        unsigned int offset = Validate(aSourcePath, cache, METADATA_CACHE_TYPE_ANIMATION_CLIP);
+        if (offset == 0)
+        {
+            return false;
+        }
+
+        //Read the tracks, then each track's keyframes
+        MetadataCacheReader reader(&cache[offset], (unsigned int)cache.size() - offset);
+        AnimationClip* animationClip = new AnimationClip();
+        unsigned int trackCount = reader.Read<unsigned int>();
+        bool isValid = true;
+        for (unsigned int i = 0; i < trackCount && isValid == true && reader.HasFailed() == false; i++)
+        {
+            std::string name = reader.ReadString();
+            unsigned int components = reader.Read<unsigned int>();
+            unsigned int keyframeCount = reader.Read<unsigned int>();
+            if (components != 1 && components != 2 && components != 4)
+            {
+                isValid = false;
+                break;
+            }
+
+            animationClip->AddTrack(name, components);
+            for (unsigned int j = 0; j < keyframeCount && reader.HasFailed() == false; j++)
+            {
+                float values[4];
+                float time = reader.Read<float>();
+                unsigned char easing = reader.Read<unsigned char>();
+                for (unsigned int k = 0; k < components; k++)
+                {
+                    values[k] = reader.Read<float>();
+                }
+
+                if (reader.HasFailed() == true || animationClip->AddKeyframe(time, values, static_cast<EasingType>(easing)) == false)
+                {
+                    isValid = false;
+                    break;
+                }
+            }
+        }
+
+        //Was the entire payload read successfully?
+        if (isValid == false || reader.IsValid() == false)
+        {
+            delete animationClip;
+            return false;
+        }
+
+        *aAnimationClip = animationClip;
+        return true;
+    }
+
+    bool MetadataCache::SaveAnimationClip(const std::string& aSourcePath, const MetadataSource& aSource, AnimationClip* aAnimationClip)
+    {
+        //Safety check the animation clip
+        if (aAnimationClip == nullptr)
+        {
+            return false;
+        }
+
+        //Write the tracks, each track is followed by its keyframes
+        std::vector<char> payload;
+        MetadataCacheWriter writer(payload);
+        writer.Write(aAnimationClip->GetTrackCount());
+
+        for (unsigned int i = 0; i < aAnimationClip->GetTrackCount(); i++)
+        {
+            unsigned int components = aAnimationClip->GetTrackComponents(i);
+            writer.WriteString(aAnimationClip->GetTrackName(i));
+            writer.Write(components);
+            writer.Write(aAnimationClip->GetKeyframeCount(i));
+
+            for (unsigned int j = 0; j < aAnimationClip->GetKeyframeCount(i); j++)
+            {
+                const float* values = aAnimationClip->GetKeyframeValues(i, j);
+                writer.Write(aAnimationClip->GetKeyframeTime(i, j));
+                writer.Write(static_cast<unsigned char>(aAnimationClip->GetKeyframeEasing(i, j)));
+                for (unsigned int k = 0; k < components; k++)
+                {
+                    writer.Write(values[k]);
+                }
+            }
+        }
+
+        return Write(aSourcePath, aSource, METADATA_CACHE_TYPE_ANIMATION_CLIP, payload);
+    }
+
+    bool MetadataCache::ReadSource(const std::string& aSourcePath, std::vector<char>& aBuffer, MetadataSource* aSource)
+    {
+        //Get the size and modification time before the file is read, if the file is modified while it's read its
+        //modification time will be later than the one that's recorded
+        unsigned long long size = 0;
+        unsigned long long modifiedTime = 0;
+        if (GetFileInfo(aSourcePath, &size, &modifiedTime) == false || ReadFile(aSourcePath, aBuffer) == false)
+        {
+            return false;
+        }
+
+        //Hash the contents that were read, then null terminate them for the json parser
+        aSource->size = aBuffer.size();
+        aSource->hash = Hash(&aBuffer[0], (unsigned int)aBuffer.size());
+        aSource->modifiedTime = size == aBuffer.size() && IsModifiedTimeRacy(modifiedTime) == false ? modifiedTime : 0;
+        aBuffer.push_back('\0');
+        return true;
+    }
+
+    std::string MetadataCache::GetCachePath(const std::string& aSourcePath)
+    {
+        return aSourcePath + ".cache";
+    }
+
+    unsigned long long MetadataCache::Hash(const char* aData, unsigned int aLength)
+    {
+        unsigned long long hash = 14695981039346656037ULL;
+        for (unsigned int i = 0; i < aLength; i++)
+        {
+            hash ^= (unsigned char)aData[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    bool MetadataCache::ReadFile(const std::string& aPath, std::vector<char>& aBuffer)
+    {
+        //Open the input stream at the end, so that we know the file size
+        std::ifstream inputStream(aPath.c_str(), std::ios::binary | std::ios::in | std::ios::ate);
+        if (inputStream.is_open() == false)
+        {
+            return false;
+        }
+
+        std::streamoff size = inputStream.tellg();
+        if (size <= 0)
+        {
+            return false;
+        }
+
+        //Read the entire file in one go
+        aBuffer.resize((size_t)size);
+        inputStream.seekg(0, std::ios::beg);
+        inputStream.read(&aBuffer[0], size);
+        return inputStream.good();
+    }
+
+    unsigned int MetadataCache::Validate(const std::string& aSourcePath, const std::vector<char>& aCache, unsigned int aType)
+    {
+        //Is the cache big enough to have a header
+        if (aCache.size() < sizeof(MetadataCacheHeader))
+        {
+            return 0;
+        }
+
+        MetadataCacheHeader header;
+        memcpy(&header, &aCache[0], sizeof(MetadataCacheHeader));
+
+        //Check the header's identity and that the payload wasn't truncated
+        if (header.magic != METADATA_CACHE_MAGIC || header.version != METADATA_CACHE_VERSION || header.type != aType ||
+            header.payloadSize == 0 || header.payloadSize != aCache.size() - sizeof(MetadataCacheHeader))
+        {
+            return 0;
+        }
+
+        //Check the size and modification time of the source file first, they don't require reading the file's contents
+        unsigned long long sourceSize = 0;
+        unsigned long long sourceModifiedTime = 0;
+        if (GetFileInfo(aSourcePath, &sourceSize, &sourceModifiedTime) == false || sourceSize != header.sourceSize)
+        {
+            return 0;
+        }
+
+        if (header.sourceModifiedTime != 0 && header.sourceModifiedTime == sourceModifiedTime)
+        {
+            return sizeof(MetadataCacheHeader);
+        }
+
+        //The source file was modified (OR its modification time wasn't recorded), check the hash of its contents
+        std::vector<char> source;
+        if (ReadFile(aSourcePath, source) == false || Hash(&source[0], (unsigned int)source.size()) != header.sourceHash)
+        {
+            return 0;
+        }
+
+        //The contents didn't change, record the new modification time so that the next load doesn't hash the file again
+        if (IsModifiedTimeRacy(sourceModifiedTime) == false)
+        {
+            std::fstream cacheStream(GetCachePath(aSourcePath).c_str(), std::ios::binary | std::ios::in | std::ios::out);
+            if (cacheStream.is_open() == true)
+            {
+                cacheStream.seekp(offsetof(MetadataCacheHeader, sourceModifiedTime), std::ios::beg);
+                cacheStream.write(reinterpret_cast<const char*>(&sourceModifiedTime), sizeof(sourceModifiedTime));
+            }
+        }
+
+        return sizeof(MetadataCacheHeader);
+    }
+
+    bool MetadataCache::GetFileInfo(const std::string& aPath, unsigned long long* aSize, unsigned long long* aModifiedTime)
+    {
+#if defined(_WIN32)
+        struct __stat64 info;
+        if (_stat64(aPath.c_str(), &info) != 0)
+        {
+            return false;
+        }
+#else
+        struct stat info;
+        if (stat(aPath.c_str(), &info) != 0)
+        {
+            return false;
+        }
+#endif
+
+        *aSize = (unsigned long long)info.st_size;
+        *aModifiedTime = (unsigned long long)info.st_mtime;
+        return true;
+    }
+
+    bool MetadataCache::IsModifiedTimeRacy(unsigned long long aModifiedTime)
+    {
+        return (long long)aModifiedTime >= (long long)time(nullptr) - METADATA_CACHE_RACY_SECONDS;
+    }
+
+    bool MetadataCache::Write(const std::string& aSourcePath, const MetadataSource& aSource, unsigned int aType, const std::vector<char>& aPayload)
+    {
+        //Fill in the header, the source file isn't read again, the source is what the payload was unpacked from
+        MetadataCacheHeader header;
+        header.magic = METADATA_CACHE_MAGIC;
+        header.version = METADATA_CACHE_VERSION;
+        header.type = aType;
+        header.payloadSize = (unsigned int)aPayload.size();
+        header.sourceSize = aSource.size;
+        header.sourceModifiedTime = aSource.modifiedTime;
+        header.sourceHash = aSource.hash;
+
+        //Write the header and payload to the cache file
+        std::ofstream outputStream(GetCachePath(aSourcePath).c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+        if (outputStream.is_open() == false)
+        {
+            return false;
+        }
+
+        outputStream.write(reinterpret_cast<const char*>(&header), sizeof(MetadataCacheHeader));
+        if (aPayload.size() > 0)
+        {
+            outputStream.write(&aPayload[0], aPayload.size());
+        }
+        return outputStream.good();
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Forward declarations
+    struct FontData;
+    class AtlasMap;
+    class AnimationClip;
+
+    //The size, modification time and hash of a source file's contents, as they were when the file was read
+    struct MetadataSource
+    {
+        MetadataSource() : size(0), modifiedTime(0), hash(0) {}
+
+        unsigned long long size;
+        unsigned long long modifiedTime;    //0 if the file could have changed without its modification time changing
+        unsigned long long hash;
+    };
+
+    //A class that provides conveniance methods to save and load a compact binary copy of the metadata that is
+    //unpacked from a font, atlas or animation clip .json file. The cache file is stored next to the source file (with a .cache
+    //extension) and records the size, modification time and a hash of the source file's contents, if the source file changes
+    //the cache is considered stale and the Load methods will fail, so that the .json file is unpacked again. A cache is
+    //validated by the source file's size and modification time, the source file is only read and hashed when its
+    //modification time changed, in case its contents didn't. The source file is read with ReadSource() and the same
+    //contents are unpacked and passed to the Save methods, so that the cache always records the contents it was made from.
+    class MetadataCache
+    {
+    public:
+        //Reads the entire source file into the buffer, null terminated at buffer[size], and gets its size, modification
+        //time and the hash of the contents that were read. Returns false if the file couldn't be read
+        static bool ReadSource(const std::string& sourcePath, std::vector<char>& buffer, MetadataSource* source);
+
+        //Loads the FontData for the source .json file from its cache, returns false if there is no cache OR if it is stale
+        static bool LoadFontData(const std::string& sourcePath, FontData** fontData);
+
+        //Saves the FontData (excluding the Texture) to the cache for the source .json file, the source is the
+        //MetadataSource of the contents the FontData was unpacked from
+        static bool SaveFontData(const std::string& sourcePath, const MetadataSource& source, FontData* fontData);
+
+        //Loads the AtlasMap for the source .json file from its cache, returns false if there is no cache OR if it is stale
+        static bool LoadAtlasMap(const std::string& sourcePath, AtlasMap** atlasMap);
+
+        //Saves the AtlasMap to the cache for the source .json file, the source is the MetadataSource of the contents
+        //the AtlasMap was unpacked from
+        static bool SaveAtlasMap(const std::string& sourcePath, const MetadataSource& source, AtlasMap* atlasMap);
+
+        //Loads the AnimationClip for the source .json file from its cache, returns false if there is no cache OR if it is stale
+        static bool LoadAnimationClip(const std::string& sourcePath, AnimationClip** animationClip);
+
+        //Saves the AnimationClip's tracks and keyframes to the cache for the source .json file, the source is the
+        //MetadataSource of the contents the AnimationClip was unpacked from
+        static bool SaveAnimationClip(const std::string& sourcePath, const MetadataSource& source, AnimationClip* animationClip);
+
+        //Returns the path of the cache file for the source file
+        static std::string GetCachePath(const std::string& sourcePath);
+
+        //Returns a 64-bit FNV-1a hash of the data
+        static unsigned long long Hash(const char* data, unsigned int length);
+
+    private:
+        //Reads the entire file at the path into the buffer, in a single read
+        static bool ReadFile(const std::string& path, std::vector<char>& buffer);
+
+        //Gets the size and the modification time (in seconds) of a file, returns false if the file doesn't exist
+        static bool GetFileInfo(const std::string& path, unsigned long long* size, unsigned long long* modifiedTime);
+
+        //Returns true if a modification time is too recent to tell a later modification apart from it
+        static bool IsModifiedTimeRacy(unsigned long long modifiedTime);
+
+        //Checks the cache header against the source file, returns the offset of the payload or 0 if the cache is stale
+        static unsigned int Validate(const std::string& sourcePath, const std::vector<char>& cache, unsigned int type);
+
+        //Writes the cache header and payload for the source file
+        static bool Write(const std::string& sourcePath, const MetadataSource& source, unsigned int type, const std::vector<char>& payload);
+    };
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //A fixed capacity, lock-free queue that passes values from one thread (the producer) to another thread (the consumer),
+    //values are popped in the order they were pushed. The storage is allocated up front, Push() and Pop() never block or
+    //allocate. Exactly one thread may push and exactly one thread may pop
+    template<typename T> class SpscQueue
+    {
+    public:
+        //The capacity is rounded up to a power of two
+        SpscQueue(unsigned int capacity) :
+            m_Mask(0),
+            m_Head(0),
+            m_Tail(0)
+        {
+            unsigned int size = 1;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+
+            m_Items.resize(size);
+            m_Mask = size - 1;
+        }
+
+        //Adds a value to the back of the queue, if the queue is full the value is dropped and false is returned. Called by the producer
+        bool Push(const T& value)
+        {
+            unsigned int tail = m_Tail.load(std::memory_order_relaxed);
+            if (tail - m_Head.load(std::memory_order_acquire) > m_Mask)
+            {
+                return false;
+            }
+
+            m_Items[tail & m_Mask] = value;
+            m_Tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        //Removes the value at the front of the queue, returns false if the queue is empty. Called by the consumer
+        bool Pop(T& value)
+        {
+            unsigned int head = m_Head.load(std::memory_order_relaxed);
+            if (head == m_Tail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            value = m_Items[head & m_Mask];
+            m_Head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        //Returns the number of values the queue can hold
+        unsigned int GetCapacity() const
+        {
+            return m_Mask + 1;
+        }
+
+    private:
+        //Member variables, the head and tail are kept on separate cache lines so that the two threads don't contend for one
+        std::vector<T> m_Items;
+        unsigned int m_Mask;
+        std::atomic<unsigned int> m_Head;
+        unsigned char m_Padding[64];
+        std::atomic<unsigned int> m_Tail;
+    };
+}
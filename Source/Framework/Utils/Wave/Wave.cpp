@@ -1,118 +1,167 @@
 #include "Wave.h"
+#include "../../Audio/AdpcmDecoder.h"
 #include "../../Audio/AudioTypes.h"
-#include <fstream>
+#include "../../IO/MappedFile.h"
+#include <string.h>
 
 
 namespace GameDev2D
 {
+	//The extensible wave format tag, and the size of its 'fmt ' chunk (a WAVEFORMATEXTENSIBLE) and the offset of its SubFormat
+	const unsigned short WAVE_FORMAT_TAG_EXTENSIBLE = 0xfffe;
+	const unsigned int WAVE_EXTENSIBLE_FORMAT_SIZE = 40;
+	const unsigned int WAVE_EXTENSIBLE_SUBFORMAT_OFFSET = 24;
+
+	//The SubFormat GUIDs that can be played, KSDATAFORMAT_SUBTYPE_PCM and KSDATAFORMAT_SUBTYPE_IEEE_FLOAT. They only differ in their
+	//first two bytes, which are the format tag they stand for
+	const unsigned char WAVE_SUBFORMAT_PCM[16] = { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+	const unsigned char WAVE_SUBFORMAT_IEEE_FLOAT[16] = { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+
 	bool Wave::LoadFromPath(const std::string& aPath, WaveData** aWaveData)
 	{
-		//Open the input file
-		std::ifstream inFile(aPath.c_str(), std::ios::binary | std::ios::in);
-		if (inFile.bad())
+		//Map the file, its contents are paged in as they are read
+		MappedFile* mappedFile = new MappedFile();
+		if (mappedFile->Open(aPath) == false)
 		{
+			delete mappedFile;
 			return false;
 		}
 
-		unsigned long dwChunkId = 0;
-		unsigned long dwFileSize = 0; 
-		unsigned long dwChunkSize = 0; 
-		unsigned long dwExtra = 0;
+		const unsigned char* file = mappedFile->GetData();
+		const unsigned long long fileSize = mappedFile->GetSize();
 
-		//look for 'RIFF' chunk identifier
-		inFile.seekg(0, std::ios::beg);
-		inFile.read(reinterpret_cast<char*>(&dwChunkId), sizeof(dwChunkId));
-		if (dwChunkId != 'FFIR')
+		//Check the 'RIFF' and 'WAVE' identifiers
+		if (fileSize < 12 || memcmp(file, "RIFF", 4) != 0 || memcmp(file + 8, "WAVE", 4) != 0)
 		{
-			inFile.close();
+			delete mappedFile;
 			return false;
 		}
-		inFile.seekg(4, std::ios::beg); //get file size
-		inFile.read(reinterpret_cast<char*>(&dwFileSize), sizeof(dwFileSize));
-		if (dwFileSize <= 16)
+
+		//Walk forward through the chunks once, until both the 'fmt ' and 'data' chunks are found
+		const unsigned char* format = nullptr;
+		unsigned int formatSize = 0;
+		const unsigned char* data = nullptr;
+		unsigned int dataSize = 0;
+
+		for (unsigned long long offset = 12; offset + 8 <= fileSize && (format == nullptr || data == nullptr); )
 		{
-			inFile.close();
-			return false;
+			unsigned int chunkSize = 0;
+			memcpy(&chunkSize, file + offset + 4, sizeof(chunkSize));
+
+			//A chunk that runs past the end of the file is cut short
+			unsigned long long available = fileSize - (offset + 8);
+			unsigned int size = chunkSize < available ? chunkSize : (unsigned int)available;
+
+			if (memcmp(file + offset, "fmt ", 4) == 0)
+			{
+				format = file + offset + 8;
+				formatSize = size;
+			}
+			else if (memcmp(file + offset, "data", 4) == 0)
+			{
+				data = file + offset + 8;
+				dataSize = size;
+			}
+
+			//Chunks are WORD aligned
+			offset += 8 + ((unsigned long long)chunkSize + 1) / 2 * 2;
 		}
-		inFile.seekg(8, std::ios::beg); //get file format
-		inFile.read(reinterpret_cast<char*>(&dwExtra), sizeof(dwExtra));
-		if (dwExtra != 'EVAW')
+
+		//The format chunk has to hold at least a PCMWAVEFORMAT
+		if (format == nullptr || formatSize < 16 || data == nullptr)
 		{
-			inFile.close();
+			delete mappedFile;
 			return false;
 		}
 
-		//Create the WaveData object
-		WaveData* waveData = new WaveData();
-
-		//look for 'fmt ' chunk id
-		bool bFilledFormat = false;
-		for (unsigned int i = 12; i < dwFileSize; )
+		//ADPCM compressed sounds are decoded once, up front, to 16-bit PCM
+		unsigned short formatTag = GetFormatTag(format, formatSize);
+		if (AdpcmDecoder::IsAdpcm(formatTag) == true)
 		{
-			inFile.seekg(i, std::ios::beg);
-			inFile.read(reinterpret_cast<char*>(&dwChunkId), sizeof(dwChunkId));
-			inFile.seekg(i + 4, std::ios::beg);
-			inFile.read(reinterpret_cast<char*>(&dwChunkSize), sizeof(dwChunkSize));
-			if (dwChunkId == ' tmf')
-			{
-				inFile.seekg(i + 8, std::ios::beg);
-				inFile.read(reinterpret_cast<char*>(&waveData->waveFormat), sizeof(waveData->waveFormat));
-				bFilledFormat = true;
-				break;
-			}
-			dwChunkSize += 8; //add offsets of the chunk id, and chunk size data entries
-			dwChunkSize += 1;
-			dwChunkSize &= 0xfffffffe; //guarantees WORD padding alignment
-			i += dwChunkSize;
+			bool success = Decode(format, formatSize, data, dataSize, aWaveData);
+			delete mappedFile;
+			return success;
 		}
 
-		if (bFilledFormat == false)
+		//The samples are played straight out of the mapping by the audio thread, page the whole file in now so that the
+		//audio thread doesn't wait on page faults when the sound is first played
+		mappedFile->Prefault();
+
+		//Create the WaveData object, the wave format is copied but the samples aren't, they're played straight out of the mapping
+		WaveData* waveData = new WaveData();
+		memcpy(&waveData->waveFormat, format, formatSize < sizeof(WAVEFORMATEX) ? formatSize : sizeof(WAVEFORMATEX));
+
+		//Only the WAVEFORMATEX is kept, an extensible format is stored as the plain format its SubFormat stands for
+		waveData->waveFormat.wFormatTag = formatTag;
+		waveData->waveFormat.cbSize = 0;
+		waveData->mappedFile = mappedFile;
+		waveData->data = const_cast<unsigned char*>(data);
+		waveData->buffer.AudioBytes = dataSize;
+		waveData->buffer.pAudioData = data;
+		waveData->buffer.PlayBegin = 0;
+		waveData->buffer.PlayLength = 0;
+
+		//Set the WaveData pointer
+		*aWaveData = waveData;
+		return true;
+	}
+
+	unsigned short Wave::GetFormatTag(const unsigned char* aFormat, unsigned int aFormatSize)
+	{
+		unsigned short formatTag = 0;
+		memcpy(&formatTag, aFormat, sizeof(formatTag));
+		if (formatTag != WAVE_FORMAT_TAG_EXTENSIBLE)
 		{
-			delete waveData;
-			inFile.close();
-			return false;
+			return formatTag;
 		}
 
-		//look for 'data' chunk id
-		bool bFilledData = false;
-		for (unsigned int i = 12; i < dwFileSize; )
+		//An extensible format's SubFormat says how the samples are stored, a 32-bit sample could be a float OR an integer
+		if (aFormatSize >= WAVE_EXTENSIBLE_FORMAT_SIZE)
 		{
-			inFile.seekg(i, std::ios::beg);
-			inFile.read(reinterpret_cast<char*>(&dwChunkId), sizeof(dwChunkId));
-			inFile.seekg(i + 4, std::ios::beg);
-			inFile.read(reinterpret_cast<char*>(&dwChunkSize), sizeof(dwChunkSize));
-			if (dwChunkId == 'atad')
+			const unsigned char* subFormat = aFormat + WAVE_EXTENSIBLE_SUBFORMAT_OFFSET;
+			if (memcmp(subFormat, WAVE_SUBFORMAT_PCM, sizeof(WAVE_SUBFORMAT_PCM)) == 0 || memcmp(subFormat, WAVE_SUBFORMAT_IEEE_FLOAT, sizeof(WAVE_SUBFORMAT_IEEE_FLOAT)) == 0)
 			{
-				waveData->data = new unsigned char[dwChunkSize];
-				inFile.seekg(i + 8, std::ios::beg);
-				inFile.read(reinterpret_cast<char*>(waveData->data), dwChunkSize);
-				waveData->buffer.AudioBytes = dwChunkSize;
-				waveData->buffer.pAudioData = (BYTE*)waveData->data;
-				waveData->buffer.PlayBegin = 0;
-				waveData->buffer.PlayLength = 0;
-				bFilledData = true;
-				break;
+				return subFormat[0];
 			}
-			dwChunkSize += 8; //add offsets of the chunk id, and chunk size data entries
-			dwChunkSize += 1;
-			dwChunkSize &= 0xfffffffe; //guarantees WORD padding alignment
-			i += dwChunkSize;
 		}
-		if (!bFilledData)
+		return 0;
+	}
+
+	bool Wave::Decode(const unsigned char* aFormat, unsigned int aFormatSize, const unsigned char* aData, unsigned int aDataSize, WaveData** aWaveData)
+	{
+		AdpcmDecoder decoder;
+		if (decoder.Init(aFormat, aFormatSize) == false)
 		{
-			delete waveData;
-			inFile.close();
 			return false;
 		}
 
+		//Decode the blocks one after the other, the last block can be partial
+		unsigned int channels = decoder.GetChannels();
+		unsigned int frameCount = decoder.GetFrameCount(aDataSize);
+		short* samples = new short[frameCount * channels];
+		unsigned int frame = 0;
+		for (unsigned int offset = 0; offset < aDataSize; offset += decoder.GetBlockAlign())
+		{
+			unsigned int blockSize = aDataSize - offset < decoder.GetBlockAlign() ? aDataSize - offset : decoder.GetBlockAlign();
+			frame += decoder.DecodeBlock(aData + offset, blockSize, samples + frame * channels);
+		}
+
+		//Create the WaveData object, it owns the decoded samples
+		WaveData* waveData = new WaveData();
+		waveData->waveFormat.wFormatTag = WAVE_FORMAT_PCM;
+		waveData->waveFormat.nChannels = (WORD)channels;
+		waveData->waveFormat.nSamplesPerSec = decoder.GetSampleRate();
+		waveData->waveFormat.wBitsPerSample = 16;
+		waveData->waveFormat.nBlockAlign = (WORD)(channels * sizeof(short));
+		waveData->waveFormat.nAvgBytesPerSec = waveData->waveFormat.nSamplesPerSec * waveData->waveFormat.nBlockAlign;
+		waveData->data = samples;
+		waveData->buffer.AudioBytes = frame * channels * sizeof(short);
+		waveData->buffer.pAudioData = reinterpret_cast<const BYTE*>(samples);
+		waveData->buffer.PlayBegin = 0;
+		waveData->buffer.PlayLength = 0;
 
 		//Set the WaveData pointer
 		*aWaveData = waveData;
-
-		//Close the input file
-		inFile.close();
-
-		//Return true
 		return true;
 	}
-}
\ No newline at end of file
+}
@@ -13,5 +13,13 @@ namespace GameDev2D
 	{
 	public:
 		static bool LoadFromPath(const std::string& path, WaveData** waveData);
+
+		//Returns the format tag of a 'fmt ' chunk. An extensible format (WAVE_FORMAT_EXTENSIBLE) is resolved to the format tag its
+		//SubFormat stands for, PCM (1) or IEEE float (3), for any other SubFormat 0 is returned, which is a format that can't be played
+		static unsigned short GetFormatTag(const unsigned char* format, unsigned int formatSize);
+
+	private:
+		//Decodes ADPCM compressed wave data to 16-bit PCM
+		static bool Decode(const unsigned char* format, unsigned int formatSize, const unsigned char* data, unsigned int dataSize, WaveData** waveData);
 	};
 }
\ No newline at end of file
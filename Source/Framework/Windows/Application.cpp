@@ -120,6 +120,9 @@ namespace GameDev2D
 
     void Application::Draw()
     {
+        //Start the frame's graphics stats
+        Services::GetGraphics()->BeginFrame();
+
         //If the application isn't suspended, clear the OpenGL view
         if(m_IsSuspended == false)
         {
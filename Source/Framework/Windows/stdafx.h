@@ -38,6 +38,8 @@
 #include "Application.h"
 #include "GameLoop.h"
 #include "GameWindow.h"
+#include "../Animation/AnimationClip.h"
+#include "../Animation/AnimationPlayhead.h"
 #include "../Animation/Animator.h"
 #include "../Animation/Easing.h"
 #include "../Audio/Audio.h"
@@ -85,6 +87,9 @@
 #include "../Input/Mouse.h"
 #include "../IO/File.h"
 #include "../Math/Math.h"
+#include "../Math/AffineTransform.h"
+#include "../Math/TransformKernels.h"
+#include "../Math/Vector2Kernels.h"
 #include "../Math/Matrix.h"
 #include "../Math/Rotation.h"
 #include "../Math/Vector2.h"
@@ -93,6 +98,8 @@
 #include "../Services/Graphics/Graphics.h"
 #include "../Services/InputManager/InputManager.h"
 #include "../Services/ResourceManager/ResourceManager.h"
+#include "../Services/TweenManager/TweenManager.h"
+#include "../Services/SpatialIndex/SpatialIndex.h"
 #include "../Utils/Png/Png.h"
 #include "../Utils/Text/Text.h"
 
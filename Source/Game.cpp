@@ -272,12 +272,13 @@ void Game::DrawPreviousBets()
                 m_pPreviousBets->SetText("LOST: " + to_string(bet));
             }
             m_pPreviousBets->SetPosition(Vector2(170.0f, WINDOW_HEIGHT - 400.0f - (i * 30.0f)));
-            m_pPreviousBets->Draw();
             if (m_pPreviousBets->GetPosition().y <= 10.0f)
             {
                 RemovePreviousBet();
                 break;
             }
+
+            m_pPreviousBets->Draw();
         }
     }
 }
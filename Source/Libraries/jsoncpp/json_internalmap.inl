@@ -25,7 +25,7 @@ ValueInternalLink::~ValueInternalLink()
       if ( !items_[index].isItemAvailable() )
       {
          if ( !items_[index].isMemberNameStatic() )
-            free( keys_[index] );
+            valueAllocator()->releaseMemberName( keys_[index] );
       }
       else
          break;
@@ -147,6 +147,28 @@ Reader::parse( std::istream& sin,
    return parse( doc, root, collectComments );
 }
 
+bool
+Reader::parse( const std::string &document, 
+               Value &root,
+               ValueArena &arena,
+               bool collectComments )
+{
+   ValueArena::Scope scope( arena );
+   return parse( document, root, collectComments );
+}
+
+
+bool
+Reader::parse( const char *beginDoc, const char *endDoc, 
+               Value &root,
+               ValueArena &arena,
+               bool collectComments )
+{
+   ValueArena::Scope scope( arena );
+   return parse( beginDoc, endDoc, root, collectComments );
+}
+
+
 bool 
 Reader::parse( const char *beginDoc, const char *endDoc, 
                Value &root,
@@ -82,7 +82,7 @@ public:
 
       if ( length == unknown )
          length = (unsigned int)strlen(value);
-      char *newString = static_cast<char *>( malloc( length + 1 ) );
+      char *newString = static_cast<char *>( ValueArena::allocate( length + 1 ) );
       memcpy( newString, value, length );
       newString[length] = 0;
       return newString;
@@ -91,7 +91,7 @@ public:
    virtual void releaseStringValue( char *value )
    {
       if ( value )
-         free( value );
+         ValueArena::release( value );
    }
 };
 
@@ -111,6 +111,154 @@ static struct DummyValueAllocatorInitializer {
 
 
 
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class ValueArena
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+// Every block handed out by ValueArena::allocate() is preceded by a header
+// that records whether it came from an arena chunk or from malloc(), so that
+// release() can tell them apart no matter which arena is active.
+// The header keeps the block aligned for double and pointer members.
+union ValueArenaBlockHeader
+{
+   unsigned int fromArena_;
+   double alignDouble_;
+   void *alignPointer_;
+};
+
+// The active arena is per thread, so that a parse on one thread never hands
+// its arena's memory to Values that another thread creates.
+static ValueArena *&activeValueArena()
+{
+   static thread_local ValueArena *arena = 0;
+   return arena;
+}
+
+ValueArena::Scope::Scope( ValueArena &arena )
+   : previous_( activeValueArena() )
+{
+   activeValueArena() = &arena;
+}
+
+
+ValueArena::Scope::~Scope()
+{
+   activeValueArena() = previous_;
+}
+
+
+ValueArena::ValueArena( unsigned int chunkSize )
+   : chunks_( 0 )
+   , chunkSize_( chunkSize )
+   , bytesAllocated_( 0 )
+   , allocationCount_( 0 )
+   , chunkCount_( 0 )
+{
+}
+
+
+ValueArena::~ValueArena()
+{
+   // An arena can't be destroyed while a scope still has it active.
+   JSON_ASSERT( activeValueArena() != this );
+
+   for ( Chunk *chunk = chunks_; chunk; )
+   {
+      Chunk *next = chunk->next_;
+      free( chunk );
+      chunk = next;
+   }
+}
+
+
+unsigned int 
+ValueArena::bytesAllocated() const
+{
+   return bytesAllocated_;
+}
+
+
+unsigned int 
+ValueArena::allocationCount() const
+{
+   return allocationCount_;
+}
+
+
+unsigned int 
+ValueArena::chunkCount() const
+{
+   return chunkCount_;
+}
+
+
+ValueArena *
+ValueArena::active()
+{
+   return activeValueArena();
+}
+
+
+void *
+ValueArena::allocate( size_t size )
+{
+   const size_t blockSize = sizeof(ValueArenaBlockHeader) + size;
+   ValueArena *arena = activeValueArena();
+   ValueArenaBlockHeader *header = static_cast<ValueArenaBlockHeader *>( arena ? arena->allocateFromChunk( blockSize )
+                                                                               : malloc( blockSize ) );
+   if ( !header )
+      throw std::bad_alloc();
+   header->fromArena_ = arena ? 1 : 0;
+   return header + 1;
+}
+
+
+void 
+ValueArena::release( void *block )
+{
+   if ( !block )
+      return;
+   ValueArenaBlockHeader *header = static_cast<ValueArenaBlockHeader *>( block ) - 1;
+   if ( !header->fromArena_ )
+      free( header );
+}
+
+
+void *
+ValueArena::allocateFromChunk( size_t size )
+{
+   // Keep every block aligned like the header
+   const size_t alignment = sizeof(ValueArenaBlockHeader);
+   size = ( size + alignment - 1 ) & ~( alignment - 1 );
+
+   if ( !chunks_  ||  chunks_->size_ - chunks_->used_ < size )
+   {
+      // Oversized blocks get a chunk of their own
+      const size_t capacity = size > chunkSize_ ? size : chunkSize_;
+      const size_t headerSize = ( sizeof(Chunk) + alignment - 1 ) & ~( alignment - 1 );
+      Chunk *chunk = static_cast<Chunk *>( malloc( headerSize + capacity ) );
+      if ( !chunk )
+         return 0;
+      chunk->next_ = chunks_;
+      chunk->size_ = headerSize + capacity;
+      chunk->used_ = headerSize;
+      chunks_ = chunk;
+      ++chunkCount_;
+   }
+
+   void *block = reinterpret_cast<char *>( chunks_ ) + chunks_->used_;
+   chunks_->used_ += size;
+   bytesAllocated_ += (unsigned int)size;
+   ++allocationCount_;
+   return block;
+}
+
+
+
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
@@ -290,7 +438,7 @@ Value::Value( ValueType type )
 #ifndef JSON_VALUE_USE_INTERNAL_MAP
    case arrayValue:
    case objectValue:
-      value_.map_ = new ObjectValues();
+      value_.map_ = new ( ValueArena::allocate( sizeof(ObjectValues) ) ) ObjectValues();
       break;
 #else
    case arrayValue:
@@ -443,7 +591,7 @@ Value::Value( const Value &other )
 #ifndef JSON_VALUE_USE_INTERNAL_MAP
    case arrayValue:
    case objectValue:
-      value_.map_ = new ObjectValues( *other.value_.map_ );
+      value_.map_ = new ( ValueArena::allocate( sizeof(ObjectValues) ) ) ObjectValues( *other.value_.map_ );
       break;
 #else
    case arrayValue:
@@ -486,7 +634,8 @@ Value::~Value()
 #ifndef JSON_VALUE_USE_INTERNAL_MAP
    case arrayValue:
    case objectValue:
-      delete value_.map_;
+      value_.map_->~ObjectValues();
+      ValueArena::release( value_.map_ );
       break;
 #else
    case arrayValue:
@@ -63,6 +63,28 @@ namespace Json {
                   Value &root,
                   bool collectComments = true );
 
+      /** \brief Read a Value from a <a HREF="http://www.json.org">JSON</a> document, the
+       * memory of the values that are read is allocated from the arena.
+       * \param arena Arena that is active while the document is parsed, it must outlive root
+       *              (and every value that was read into it), see ValueArena.
+       * \return \c true if the document was successfully parsed, \c false if an error occurred.
+       */
+      bool parse( const std::string &document, 
+                  Value &root,
+                  ValueArena &arena,
+                  bool collectComments = true );
+
+      /** \brief Read a Value from a <a HREF="http://www.json.org">JSON</a> document, the
+       * memory of the values that are read is allocated from the arena.
+       * \param arena Arena that is active while the document is parsed, it must outlive root
+       *              (and every value that was read into it), see ValueArena.
+       * \return \c true if the document was successfully parsed, \c false if an error occurred.
+       */
+      bool parse( const char *beginDoc, const char *endDoc, 
+                  Value &root,
+                  ValueArena &arena,
+                  bool collectComments = true );
+
       /** \brief Returns a user friendly string that list errors in the parsed document.
        * \return Formatted error message with the list of errors with their location in 
        *         the parsed document. An empty string is returned if no error occurred
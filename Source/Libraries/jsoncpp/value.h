@@ -4,6 +4,8 @@
 # include "forwards.h"
 # include <string>
 # include <vector>
+# include <cstddef>
+# include <new>
 
 # ifndef JSON_USE_CPPTL_SMALLMAP
 #  include <map>
@@ -81,6 +83,166 @@ namespace Json {
       const char *str_;
    };
 
+   /** \brief Parse-scoped monotonic arena for the memory used by Value.
+    *
+    * An arena only hands out memory while it is the active arena of the calling thread, which
+    * is for the duration of a Reader::parse() that is given the arena (or of a ValueArena::Scope).
+    * Every member name, string value and object/array node the parse allocates is carved out of
+    * large chunks owned by the arena, and releasing them is a no-op. All the chunks are freed in
+    * one shot when the arena is destroyed.
+    *
+    * The active arena is per thread, other threads keep allocating from malloc() (or from their
+    * own arena). Values created or modified outside of the parse also allocate from malloc(),
+    * Values from both sources can be mixed freely.
+    *
+    * \warning The Values filled in by the parse must not be used after the arena is destroyed.
+    * Declare the arena before the root Value so that the root is destroyed first, and copy any
+    * Value that has to outlive the arena (a copy made outside of the parse doesn't use the arena):
+    * \code
+    * Json::ValueArena arena;
+    * Json::Value root;
+    * Json::Reader reader;
+    * reader.parse( document, root, arena );
+    * \endcode
+    */
+   class JSON_API ValueArena
+   {
+   public:
+      /** \brief Makes an arena the active arena of the calling thread for the lifetime of the scope.
+       *
+       * The previously active arena (if any) becomes active again when the scope ends.
+       */
+      class JSON_API Scope
+      {
+      public:
+         Scope( ValueArena &arena );
+         ~Scope();
+
+      private:
+         Scope( const Scope &other );
+         Scope &operator =( const Scope &other );
+
+         ValueArena *previous_;
+      };
+
+      ValueArena( unsigned int chunkSize = 64 * 1024 );
+      ~ValueArena();
+
+      /// Returns the number of bytes handed out by the arena.
+      unsigned int bytesAllocated() const;
+
+      /// Returns the number of blocks handed out by the arena.
+      unsigned int allocationCount() const;
+
+      /// Returns the number of chunks the arena had to request from the system.
+      unsigned int chunkCount() const;
+
+      /// Returns the active arena of the calling thread, or 0 if there is none.
+      static ValueArena *active();
+
+      /// Allocates a block from the calling thread's active arena, or from malloc() if there is none.
+      static void *allocate( size_t size );
+
+      /// Releases a block returned by allocate(), blocks owned by an arena are left alone.
+      static void release( void *block );
+
+   private:
+      ValueArena( const ValueArena &other );
+      ValueArena &operator =( const ValueArena &other );
+
+      void *allocateFromChunk( size_t size );
+
+      struct Chunk
+      {
+         Chunk *next_;
+         size_t size_;
+         size_t used_;
+      };
+
+      Chunk *chunks_;
+      size_t chunkSize_;
+      unsigned int bytesAllocated_;
+      unsigned int allocationCount_;
+      unsigned int chunkCount_;
+   };
+
+   /** \brief STL allocator that draws the Value object/array nodes from the active ValueArena.
+    */
+   template<typename T>
+   class ValueArenaAllocator
+   {
+   public:
+      typedef T value_type;
+      typedef T *pointer;
+      typedef const T *const_pointer;
+      typedef T &reference;
+      typedef const T &const_reference;
+      typedef size_t size_type;
+      typedef ptrdiff_t difference_type;
+
+      template<typename U>
+      struct rebind
+      {
+         typedef ValueArenaAllocator<U> other;
+      };
+
+      ValueArenaAllocator()
+      {
+      }
+
+      template<typename U>
+      ValueArenaAllocator( const ValueArenaAllocator<U> & )
+      {
+      }
+
+      pointer address( reference value ) const
+      {
+         return &value;
+      }
+
+      const_pointer address( const_reference value ) const
+      {
+         return &value;
+      }
+
+      pointer allocate( size_type count, const void * = 0 )
+      {
+         return static_cast<pointer>( ValueArena::allocate( count * sizeof(T) ) );
+      }
+
+      void deallocate( pointer block, size_type )
+      {
+         ValueArena::release( block );
+      }
+
+      size_type max_size() const
+      {
+         return size_type(-1) / sizeof(T);
+      }
+
+      void construct( pointer block, const T &value )
+      {
+         new ( block ) T( value );
+      }
+
+      void destroy( pointer block )
+      {
+         block->~T();
+      }
+
+      template<typename U>
+      bool operator ==( const ValueArenaAllocator<U> & ) const
+      {
+         return true;
+      }
+
+      template<typename U>
+      bool operator !=( const ValueArenaAllocator<U> & ) const
+      {
+         return false;
+      }
+   };
+
    /** \brief Represents a <a HREF="http://www.json.org">JSON</a> value.
     *
     * This class is a discriminated union wrapper that can represents a:
@@ -158,7 +320,7 @@ namespace Json {
 
    public:
 #  ifndef JSON_USE_CPPTL_SMALLMAP
-      typedef std::map<CZString, Value> ObjectValues;
+      typedef std::map<CZString, Value, std::less<CZString>, ValueArenaAllocator<std::pair<const CZString, Value> > > ObjectValues;
 #  else
       typedef CppTL::SmallMap<CZString, Value> ObjectValues;
 #  endif // ifndef JSON_USE_CPPTL_SMALLMAP
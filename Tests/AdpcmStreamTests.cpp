@@ -0,0 +1,480 @@
+//Tests the AdpcmDecoder and compressed AudioStreams. Wave files are generated with the test's own Microsoft ADPCM and
+//IMA ADPCM encoders, mono and stereo, ending in a partial block. An encoder tracks the state a decoder has after each
+//nibble, so the samples it reconstructs are the reference the decoder has to match exactly:
+//- every block decoded by the AdpcmDecoder matches the reference
+//- the files streamed through an AudioStream mix bit for bit the same as the reference played from memory, both are
+//  pulled by a NullAudioSink (the sink the AUDIO_HEADLESS setting selects), unpitched, pitched and looping, and with a
+//  seek that isn't on a block
+//The resident memory and the decode time of each stream are reported, along with the decoder's throughput.
+//
+//Wave::LoadFromPath (which decodes short effects once, at load) needs xaudio2.h, so it isn't covered here.
+//
+//Sources: Source/Framework/Audio/AdpcmDecoder.cpp Source/Framework/Audio/AudioStream.cpp Source/Framework/Audio/AudioMixer.cpp
+//         Source/Framework/Audio/AudioKernels.cpp Source/Framework/Audio/AudioSink.cpp Tests/Support/Log.cpp
+//
+//Build with -pthread. Run from a writable directory, the generated wave files are written to the working directory and
+//deleted once the tests are done.
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Audio/AdpcmDecoder.h"
+#include "../Source/Framework/Audio/AudioMixer.h"
+#include "../Source/Framework/Audio/AudioSink.h"
+#include "../Source/Framework/Audio/AudioStream.h"
+#include "../Source/Framework/Utils/Wave/Wave.h"
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+using namespace GameDev2D;
+
+
+//The delta time of a game frame, the sink mixes this much audio per update
+const double TEST_FRAME_DELTA = 1.0 / 60.0;
+
+//The sample rate of the generated files
+const unsigned int TEST_SAMPLE_RATE = 44100;
+
+//The tables both formats adapt their step size with, the same as the decoder's
+static const int MS_ADPCM_ADAPTATION[16] = { 230, 230, 230, 230, 307, 409, 512, 614, 768, 614, 512, 409, 307, 230, 230, 230 };
+static const int MS_ADPCM_COEFFICIENTS[7][2] = { { 256, 0 }, { 512, -256 }, { 0, 0 }, { 192, 64 }, { 240, 0 }, { 460, -208 }, { 392, -232 } };
+static const int IMA_ADPCM_STEPS[89] =
+{
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+    157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552,
+    1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+static const int IMA_ADPCM_INDICES[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static int ClampSample(int aSample)
+{
+    return aSample < -32768 ? -32768 : (aSample > 32767 ? 32767 : aSample);
+}
+
+static void WriteU16(std::vector<unsigned char>& aData, unsigned short aValue)
+{
+    aData.push_back((unsigned char)(aValue & 0xff));
+    aData.push_back((unsigned char)(aValue >> 8));
+}
+
+static void WriteU32(std::vector<unsigned char>& aData, unsigned int aValue)
+{
+    WriteU16(aData, (unsigned short)(aValue & 0xffff));
+    WriteU16(aData, (unsigned short)(aValue >> 16));
+}
+
+//An ADPCM encoded wave file, and the samples a decoder has to decode it to
+struct TestWave
+{
+    std::string name;
+    std::string path;
+    std::vector<unsigned char> format;
+    std::vector<unsigned char> data;
+    std::vector<short> reference;
+    unsigned int frameCount;
+    unsigned int framesPerBlock;
+    unsigned short formatTag;
+    unsigned short channels;
+    unsigned short blockAlign;
+};
+
+//Encodes a Microsoft ADPCM block, each channel uses the predictor that reconstructs its samples best
+static void EncodeMsAdpcmBlock(const short* aInput, unsigned int aFrames, unsigned int aChannels, std::vector<unsigned char>& aBlock, short* aReference)
+{
+    unsigned char header[7 * 2] = {};
+    std::vector<unsigned char> nibbles((aFrames - 2) * aChannels, 0);
+
+    for (unsigned int c = 0; c < aChannels; c++)
+    {
+        unsigned long long bestError = ULLONG_MAX;
+        for (unsigned int predictor = 0; predictor < 7; predictor++)
+        {
+            const int coefficient1 = MS_ADPCM_COEFFICIENTS[predictor][0];
+            const int coefficient2 = MS_ADPCM_COEFFICIENTS[predictor][1];
+            int sample2 = aInput[c];
+            int sample1 = aInput[aChannels + c];
+
+            //Start the step size at a quarter of the average of the first prediction errors
+            int delta = 0;
+            for (unsigned int frame = 2; frame < aFrames && frame < 6; frame++)
+            {
+                int predicted = (aInput[(frame - 1) * aChannels + c] * coefficient1 + aInput[(frame - 2) * aChannels + c] * coefficient2) >> 8;
+                delta += abs(aInput[frame * aChannels + c] - predicted);
+            }
+            delta = std::max(delta / 16, 16);
+            const int firstDelta = delta;
+
+            unsigned long long error = 0;
+            std::vector<unsigned char> channelNibbles;
+            std::vector<short> channelSamples;
+            for (unsigned int frame = 2; frame < aFrames; frame++)
+            {
+                int predicted = (sample1 * coefficient1 + sample2 * coefficient2) >> 8;
+                int difference = aInput[frame * aChannels + c] - predicted;
+                int signedNibble = (int)floor((double)difference / delta + 0.5);
+                signedNibble = std::max(-8, std::min(7, signedNibble));
+                int nibble = signedNibble & 0x0f;
+
+                int sample = ClampSample(predicted + signedNibble * delta);
+                sample2 = sample1;
+                sample1 = sample;
+                delta = std::max((MS_ADPCM_ADAPTATION[nibble] * delta) >> 8, 16);
+
+                int sampleError = aInput[frame * aChannels + c] - sample;
+                error += (unsigned long long)((long long)sampleError * sampleError);
+                channelNibbles.push_back((unsigned char)nibble);
+                channelSamples.push_back((short)sample);
+            }
+
+            if (error < bestError)
+            {
+                bestError = error;
+                header[c] = (unsigned char)predictor;
+                header[aChannels + c * 2] = (unsigned char)(firstDelta & 0xff);
+                header[aChannels + c * 2 + 1] = (unsigned char)(firstDelta >> 8);
+                for (unsigned int i = 0; i < channelNibbles.size(); i++)
+                {
+                    nibbles[i * aChannels + c] = channelNibbles[i];
+                    aReference[(i + 2) * aChannels + c] = channelSamples[i];
+                }
+            }
+        }
+
+        //The two first samples are stored as they are, the most recent one first
+        short sample1 = aInput[aChannels + c];
+        short sample2 = aInput[c];
+        memcpy(&header[aChannels * 3 + c * 2], &sample1, sizeof(sample1));
+        memcpy(&header[aChannels * 5 + c * 2], &sample2, sizeof(sample2));
+        aReference[c] = sample2;
+        aReference[aChannels + c] = sample1;
+    }
+
+    aBlock.insert(aBlock.end(), header, header + aChannels * 7);
+    for (unsigned int i = 0; i < nibbles.size(); i += 2)
+    {
+        aBlock.push_back((unsigned char)((nibbles[i] << 4) | (i + 1 < nibbles.size() ? nibbles[i + 1] : 0)));
+    }
+}
+
+//Encodes an IMA ADPCM block, each channel's step index carries over from the block before it
+static void EncodeImaAdpcmBlock(const short* aInput, unsigned int aFrames, unsigned int aChannels, int* aIndices, std::vector<unsigned char>& aBlock, short* aReference)
+{
+    size_t start = aBlock.size();
+    unsigned int groups = (aFrames - 1) / 8;
+    aBlock.resize(start + aChannels * 4 * (1 + groups), 0);
+    unsigned char* block = &aBlock[start];
+
+    for (unsigned int c = 0; c < aChannels; c++)
+    {
+        int sample = aInput[c];
+        int index = aIndices[c];
+        block[c * 4] = (unsigned char)(sample & 0xff);
+        block[c * 4 + 1] = (unsigned char)((sample >> 8) & 0xff);
+        block[c * 4 + 2] = (unsigned char)index;
+        aReference[c] = (short)sample;
+
+        for (unsigned int frame = 1; frame < aFrames; frame++)
+        {
+            //Quantize the difference to the step, the way the reference encoder does
+            int step = IMA_ADPCM_STEPS[index];
+            int difference = aInput[frame * aChannels + c] - sample;
+            int nibble = 0;
+            if (difference < 0)
+            {
+                nibble = 8;
+                difference = -difference;
+            }
+            if (difference >= step) { nibble |= 4; difference -= step; }
+            if (difference >= step >> 1) { nibble |= 2; difference -= step >> 1; }
+            if (difference >= step >> 2) { nibble |= 1; }
+
+            //Then reconstruct the sample the way a decoder does
+            int decoded = step >> 3;
+            if ((nibble & 1) != 0) decoded += step >> 2;
+            if ((nibble & 2) != 0) decoded += step >> 1;
+            if ((nibble & 4) != 0) decoded += step;
+            if ((nibble & 8) != 0) decoded = -decoded;
+            sample = ClampSample(sample + decoded);
+            index = std::max(0, std::min(88, index + IMA_ADPCM_INDICES[nibble]));
+            aReference[frame * aChannels + c] = (short)sample;
+
+            unsigned int i = frame - 1;
+            unsigned char& byte = block[aChannels * 4 + (i / 8) * aChannels * 4 + c * 4 + (i % 8) / 2];
+            byte |= (i & 1) == 0 ? nibble : nibble << 4;
+        }
+        aIndices[c] = index;
+    }
+}
+
+//Generates music-like samples (a few detuned tones, a slow tremolo and some noise), encodes them and writes the wave file.
+//The frame count MUST leave a last block that is valid for the format
+static TestWave WriteWave(const std::string& aName, unsigned short aFormatTag, unsigned short aChannels, unsigned int aFrameCount)
+{
+    TestWave wave;
+    wave.name = aName;
+    wave.path = "AdpcmStreamTests_" + aName + ".wav";
+    wave.formatTag = aFormatTag;
+    wave.channels = aChannels;
+    wave.frameCount = aFrameCount;
+    wave.blockAlign = (unsigned short)(256 * aChannels);
+    wave.framesPerBlock = aFormatTag == AdpcmDecoder::FORMAT_MS_ADPCM ? 2 + (wave.blockAlign - 7 * aChannels) * 2 / aChannels : 1 + (wave.blockAlign - 4 * aChannels) / (4 * aChannels) * 8;
+
+    std::mt19937 random(aFrameCount + aFormatTag);
+    std::uniform_real_distribution<float> noise(-0.02f, 0.02f);
+    std::vector<short> input(aFrameCount * aChannels);
+    for (unsigned int frame = 0; frame < aFrameCount; frame++)
+    {
+        float t = (float)frame / TEST_SAMPLE_RATE;
+        for (unsigned int c = 0; c < aChannels; c++)
+        {
+            float tone = sinf(2.0f * 3.14159265f * (220.0f + c * 1.5f) * t) * 0.4f + sinf(2.0f * 3.14159265f * 554.0f * t) * 0.2f +
+                sinf(2.0f * 3.14159265f * 1318.0f * t) * 0.1f;
+            float tremolo = 0.75f + 0.25f * sinf(2.0f * 3.14159265f * 0.5f * t);
+            input[frame * aChannels + c] = (short)((tone * tremolo + noise(random)) * 32767.0f);
+        }
+    }
+
+    wave.reference.resize(input.size());
+    int indices[2] = { 0, 0 };
+    for (unsigned int frame = 0; frame < aFrameCount; frame += wave.framesPerBlock)
+    {
+        unsigned int frames = std::min(wave.framesPerBlock, aFrameCount - frame);
+        if (aFormatTag == AdpcmDecoder::FORMAT_MS_ADPCM)
+        {
+            EncodeMsAdpcmBlock(&input[frame * aChannels], frames, aChannels, wave.data, &wave.reference[frame * aChannels]);
+        }
+        else
+        {
+            EncodeImaAdpcmBlock(&input[frame * aChannels], frames, aChannels, indices, wave.data, &wave.reference[frame * aChannels]);
+        }
+    }
+
+    //The format is a WAVEFORMATEX followed by the samples per block, Microsoft ADPCM adds its coefficients
+    WriteU16(wave.format, aFormatTag);
+    WriteU16(wave.format, aChannels);
+    WriteU32(wave.format, TEST_SAMPLE_RATE);
+    WriteU32(wave.format, TEST_SAMPLE_RATE * wave.blockAlign / wave.framesPerBlock);
+    WriteU16(wave.format, wave.blockAlign);
+    WriteU16(wave.format, 4);
+    WriteU16(wave.format, aFormatTag == AdpcmDecoder::FORMAT_MS_ADPCM ? 32 : 2);
+    WriteU16(wave.format, (unsigned short)wave.framesPerBlock);
+    if (aFormatTag == AdpcmDecoder::FORMAT_MS_ADPCM)
+    {
+        WriteU16(wave.format, 7);
+        for (unsigned int i = 0; i < 7; i++)
+        {
+            WriteU16(wave.format, (unsigned short)MS_ADPCM_COEFFICIENTS[i][0]);
+            WriteU16(wave.format, (unsigned short)MS_ADPCM_COEFFICIENTS[i][1]);
+        }
+    }
+
+    std::vector<unsigned char> file;
+    file.insert(file.end(), { 'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ' });
+    WriteU32(file, (unsigned int)wave.format.size());
+    file.insert(file.end(), wave.format.begin(), wave.format.end());
+    file.insert(file.end(), { 'f', 'a', 'c', 't' });
+    WriteU32(file, 4);
+    WriteU32(file, aFrameCount);
+    file.insert(file.end(), { 'd', 'a', 't', 'a' });
+    WriteU32(file, (unsigned int)wave.data.size());
+    file.insert(file.end(), wave.data.begin(), wave.data.end());
+    if ((wave.data.size() & 1) != 0)
+    {
+        file.push_back(0);
+    }
+    unsigned int riffSize = (unsigned int)file.size() - 8;
+    memcpy(&file[4], &riffSize, sizeof(riffSize));
+
+    std::ofstream stream(wave.path.c_str(), std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(file.data()), file.size());
+    return wave;
+}
+
+static void TestDecoder(const TestWave& aWave)
+{
+    AdpcmDecoder decoder;
+    TEST_CHECK(decoder.Init(aWave.format.data(), (unsigned int)aWave.format.size()) == true);
+    TEST_CHECK(decoder.GetFramesPerBlock() == aWave.framesPerBlock);
+    TEST_CHECK(decoder.GetFrameCount((unsigned int)aWave.data.size()) == aWave.frameCount);
+
+    //Decode the whole file block by block, like Wave::LoadFromPath does
+    std::vector<short> decoded(aWave.frameCount * aWave.channels);
+    const unsigned int iterations = 20;
+    Tests::Timer timer;
+    for (unsigned int iteration = 0; iteration < iterations; iteration++)
+    {
+        unsigned int frames = 0;
+        for (unsigned int offset = 0; offset < aWave.data.size(); offset += aWave.blockAlign)
+        {
+            unsigned int size = std::min((unsigned int)aWave.data.size() - offset, (unsigned int)aWave.blockAlign);
+            frames += decoder.DecodeBlock(&aWave.data[offset], size, &decoded[frames * aWave.channels]);
+        }
+        TEST_CHECK(frames == aWave.frameCount);
+    }
+    double ms = timer.GetMilliseconds() / iterations;
+    Tests::KeepAlive(decoded[0]);
+
+    unsigned int mismatches = 0;
+    for (size_t i = 0; i < decoded.size(); i++)
+    {
+        mismatches += decoded[i] != aWave.reference[i] ? 1 : 0;
+    }
+    TEST_CHECK(mismatches == 0);
+
+    double seconds = (double)aWave.frameCount / TEST_SAMPLE_RATE;
+    printf("%-10s | %5.1f s, %8u bytes -> %8u bytes, %u mismatched samples, decodes in %6.2f ms (%.0fx real time)\n", aWave.name.c_str(),
+        seconds, (unsigned int)aWave.data.size(), (unsigned int)decoded.size() * 2, mismatches, ms, seconds * 1000.0 / ms);
+}
+
+//A NullAudioSink that keeps everything it mixed
+class RecordingAudioSink : public NullAudioSink
+{
+public:
+    std::vector<float> samples;
+
+protected:
+    void OnMixed(const float* aSamples, unsigned int aFrameCount)
+    {
+        samples.insert(samples.end(), aSamples, aSamples + aFrameCount * m_Mixer->GetChannels());
+    }
+};
+
+struct TestCase
+{
+    const char* name;
+    AudioResampler resampler;
+    float frequencyRatio;
+    bool isLooping;
+    unsigned int seekFrame;     //The frame the voices seek to halfway through, 0 doesn't seek
+    double duration;            //In multiples of the file's duration
+};
+
+static void TestStream(const TestWave& aWave, const TestCase& aCase)
+{
+    AudioStream stream;
+    TEST_CHECK(stream.Open(aWave.path) == true);
+    TEST_CHECK(stream.IsCompressed() == true);
+    TEST_CHECK(stream.GetFrameCount() == aWave.frameCount);
+    TEST_CHECK(stream.GetBitsPerSample() == 16);
+
+    AudioSource memorySource;
+    memorySource.data = aWave.reference.data();
+    memorySource.frameCount = aWave.frameCount;
+    memorySource.sampleRate = TEST_SAMPLE_RATE;
+    memorySource.channels = aWave.channels;
+    memorySource.bitsPerSample = 16;
+
+    AudioSource streamSource;
+    stream.GetAudioSource(streamSource);
+
+    //Each voice is played by its own mixer, through its own sink
+    AudioMixer memoryMixer(TEST_SAMPLE_RATE, 1);
+    AudioMixer streamMixer(TEST_SAMPLE_RATE, 1);
+    AudioMixer* mixers[2] = { &memoryMixer, &streamMixer };
+    RecordingAudioSink sinks[2];
+    AudioVoice voices[2] = { memoryMixer.CreateVoice(memorySource, nullptr), streamMixer.CreateVoice(streamSource, nullptr) };
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        sinks[i].Open(mixers[i]);
+        mixers[i]->SetResampler(aCase.resampler);
+        mixers[i]->SetFrequencyRatio(voices[i], aCase.frequencyRatio);
+        mixers[i]->SetLooping(voices[i], aCase.isLooping);
+    }
+    stream.SetLooping(aCase.isLooping);
+    stream.Seek(0);
+    mixers[0]->Start(voices[0]);
+    mixers[1]->Start(voices[1]);
+
+    //The sleep gives the background thread the time it would have had to decode a buffer while a device played the frames
+    unsigned int updates = (unsigned int)(aCase.duration * aWave.frameCount / TEST_SAMPLE_RATE / TEST_FRAME_DELTA);
+    for (unsigned int update = 0; update < updates; update++)
+    {
+        if (aCase.seekFrame != 0 && update == updates / 2)
+        {
+            mixers[0]->Stop(voices[0]);
+            mixers[1]->Stop(voices[1]);
+            stream.Seek(aCase.seekFrame);
+            mixers[0]->SetPosition(voices[0], aCase.seekFrame);
+            mixers[1]->SetPosition(voices[1], aCase.seekFrame);
+            mixers[0]->Start(voices[0]);
+            mixers[1]->Start(voices[1]);
+        }
+
+        sinks[0].Update(TEST_FRAME_DELTA);
+        sinks[1].Update(TEST_FRAME_DELTA);
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+
+    bool isIdentical = sinks[0].samples.size() == sinks[1].samples.size() &&
+        memcmp(sinks[0].samples.data(), sinks[1].samples.data(), sinks[0].samples.size() * sizeof(float)) == 0;
+    TEST_CHECK(isIdentical == true);
+    TEST_CHECK(stream.GetUnderrunCount() == 0);
+
+    //The resident memory is the decoded buffers and the encoded blocks they're decoded from, not the length of the file
+    unsigned int residentBytes = stream.GetResidentBytes();
+    TEST_CHECK(residentBytes < stream.GetDataSize() / 2);
+
+    double playedSeconds = (double)sinks[1].GetFramesMixed() / TEST_SAMPLE_RATE;
+    double decodeMs = stream.GetDecodeTime() * 1000.0;
+    printf("%-10s | %-34s | %s, %u underruns, %4u KB resident of %5u KB decoded, decode %6.2f ms for %5.1f s played (%.3f%% of a core)\n",
+        aWave.name.c_str(), aCase.name, isIdentical == true ? "bit identical" : "DIFFERS", stream.GetUnderrunCount(), residentBytes / 1024,
+        stream.GetDataSize() / 1024, decodeMs, playedSeconds, decodeMs / (playedSeconds * 10.0));
+
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        mixers[i]->DestroyVoice(voices[i]);
+        sinks[i].Close();
+    }
+}
+
+int main()
+{
+    //The streamed files are 10 seconds long, each ends in a partial block (2 + 2n frames for Microsoft ADPCM, 1 + 8n for IMA)
+    std::vector<TestWave> waves;
+    waves.push_back(WriteWave("MS mono", AdpcmDecoder::FORMAT_MS_ADPCM, 1, 500 * 882 + 202));
+    waves.push_back(WriteWave("MS stereo", AdpcmDecoder::FORMAT_MS_ADPCM, 2, 500 * 882 + 202));
+    waves.push_back(WriteWave("IMA mono", AdpcmDecoder::FORMAT_IMA_ADPCM, 1, 505 * 873 + 201));
+    waves.push_back(WriteWave("IMA stereo", AdpcmDecoder::FORMAT_IMA_ADPCM, 2, 505 * 873 + 201));
+
+    printf("AdpcmDecoder, decoded against the encoders' reconstruction\n");
+    for (unsigned int i = 0; i < waves.size(); i++)
+    {
+        TestDecoder(waves[i]);
+    }
+
+    const TestCase cases[] =
+    {
+        { "linear 1.0, to the end", AudioResampler_Linear, 1.0f, false, 0, 1.1 },
+        { "sinc 1.37, looping", AudioResampler_Sinc, 1.37f, true, 0, 1.6 },
+        { "linear 0.8, looping, seek to 70001", AudioResampler_Linear, 0.8f, true, 70001, 1.2 },
+    };
+
+    printf("\nAudioStream, mixed against the reference played from memory\n");
+    for (unsigned int i = 0; i < waves.size(); i++)
+    {
+        for (unsigned int j = 0; j < sizeof(cases) / sizeof(cases[0]); j++)
+        {
+            TestStream(waves[i], cases[j]);
+        }
+    }
+
+    for (unsigned int i = 0; i < waves.size(); i++)
+    {
+        remove(waves[i].path.c_str());
+    }
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All ADPCM tests passed" : "ADPCM tests FAILED");
+    return Tests::Failures();
+}
+
+//Wave.cpp loads files through xaudio2.h, the stream only needs the format tag of a plain format chunk
+namespace GameDev2D
+{
+    unsigned short Wave::GetFormatTag(const unsigned char* aFormat, unsigned int aFormatSize)
+    {
+        unsigned short formatTag = 0;
+        memcpy(&formatTag, aFormat, sizeof(formatTag));
+        return formatTag;
+    }
+}
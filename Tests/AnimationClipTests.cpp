@@ -0,0 +1,400 @@
+//Tests AnimationClip::Sample() against a linear search over the keyframes. A clip with float, Vector2 and Color tracks
+//(random times, easings and values, with keyframes that share a time) is sampled at random times, at the keyframes'
+//times and outside the clip, with the binary search and with a stale cursor. Then it's played back through a cursor:
+//forward by small and large steps, looping (the time wraps back to the start) and seeking backwards. Every sample has to
+//match the linear search bit for bit. Then the clip is written to a .json file, unpacked, saved to its MetadataCache
+//(type 3) and loaded back, the loaded clip has to be bit identical to the unpacked one. The cursor and the binary search
+//are benchmarked as well.
+//
+//Sources: Source/Framework/Animation/AnimationClip.cpp Source/Framework/Animation/Easing.cpp
+//         Source/Framework/Utils/JsonStream/JsonStream.cpp Source/Framework/Utils/MetadataCache/MetadataCache.cpp
+//         Source/Framework/Graphics/GraphicTypes.cpp Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Animation/AnimationClip.h"
+#include "../Source/Framework/Utils/MetadataCache/MetadataCache.h"
+#include "../Source/Framework/Graphics/Texture.h"
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <string.h>
+
+using namespace GameDev2D;
+
+
+//The .json file the clip is written to, it and its cache are removed afterwards
+const char* const TEST_CLIP_PATH = "AnimationClipTests_Clip.json";
+
+//A track's keyframes, the way the test made them
+struct TrackData
+{
+    std::string name;
+    unsigned int components;
+    std::vector<float> times;
+    std::vector<float> values;
+    std::vector<EasingType> easings;
+};
+
+//Makes a track with random keyframes, some of them share a time (the value steps there)
+static TrackData MakeTrack(std::mt19937& aRandom, const std::string& aName, unsigned int aComponents, unsigned int aKeyframes)
+{
+    std::uniform_real_distribution<float> step(0.001f, 0.2f);
+    std::uniform_real_distribution<float> value(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> colorValue(-0.2f, 1.2f);
+
+    TrackData track;
+    track.name = aName;
+    track.components = aComponents;
+    float time = step(aRandom);
+    for (unsigned int i = 0; i < aKeyframes; i++)
+    {
+        time += i > 0 && aRandom() % 10 == 0 ? 0.0f : step(aRandom);
+        track.times.push_back(time);
+        track.easings.push_back(static_cast<EasingType>(aRandom() % EasingType_Count));
+        for (unsigned int j = 0; j < aComponents; j++)
+        {
+            track.values.push_back(aComponents == 4 ? colorValue(aRandom) : value(aRandom));
+        }
+    }
+    return track;
+}
+
+static std::vector<TrackData> MakeTracks()
+{
+    std::mt19937 random(43);
+    std::vector<TrackData> tracks;
+    tracks.push_back(MakeTrack(random, "alpha", 1, 1000));
+    tracks.push_back(MakeTrack(random, "position", 2, 400));
+    tracks.push_back(MakeTrack(random, "tint", 4, 250));
+    tracks.push_back(MakeTrack(random, "scale", 2, 2));
+    tracks.push_back(MakeTrack(random, "still", 1, 1));
+    return tracks;
+}
+
+static AnimationClip* MakeClip(const std::vector<TrackData>& aTracks)
+{
+    AnimationClip* clip = new AnimationClip();
+    for (unsigned int i = 0; i < aTracks.size(); i++)
+    {
+        clip->AddTrack(aTracks[i].name, aTracks[i].components);
+        for (unsigned int j = 0; j < aTracks[i].times.size(); j++)
+        {
+            clip->AddKeyframe(aTracks[i].times[j], &aTracks[i].values[j * aTracks[i].components], aTracks[i].easings[j]);
+        }
+    }
+    return clip;
+}
+
+//Samples a track with a linear search: the last keyframe at OR before the time, eased into the next one with the next
+//one's easing. The first and last keyframes' values are held outside the track, Color values are kept in range
+static void ReferenceSample(const TrackData& aTrack, float aTime, float* aValues)
+{
+    const unsigned int last = static_cast<unsigned int>(aTrack.times.size()) - 1;
+    if (aTime <= aTrack.times[0] || aTime >= aTrack.times[last])
+    {
+        unsigned int keyframe = aTime <= aTrack.times[0] ? 0 : last;
+        memcpy(aValues, &aTrack.values[keyframe * aTrack.components], aTrack.components * sizeof(float));
+        return;
+    }
+
+    unsigned int keyframe = 0;
+    while (aTrack.times[keyframe + 1] <= aTime)
+    {
+        keyframe++;
+    }
+
+    float percentage = (aTime - aTrack.times[keyframe]) / (aTrack.times[keyframe + 1] - aTrack.times[keyframe]);
+    float eased = GetEasingFunction(aTrack.easings[keyframe + 1])(percentage);
+    const float* start = &aTrack.values[keyframe * aTrack.components];
+    const float* end = start + aTrack.components;
+    for (unsigned int i = 0; i < aTrack.components; i++)
+    {
+        aValues[i] = start[i] + (end[i] - start[i]) * eased;
+        if (aTrack.components == 4)
+        {
+            aValues[i] = aValues[i] < 0.0f ? 0.0f : (aValues[i] > 1.0f ? 1.0f : aValues[i]);
+        }
+    }
+}
+
+//Returns true if the clip's sample and the reference are the same, bit for bit
+static bool IsSampleCorrect(const AnimationClip& aClip, const TrackData& aTrack, unsigned int aTrackIndex, float aTime, unsigned int* aCursor)
+{
+    float values[4];
+    float expected[4];
+    if (aCursor == nullptr)
+    {
+        aClip.Sample(aTrackIndex, aTime, values);
+    }
+    else
+    {
+        aClip.Sample(aTrackIndex, aTime, *aCursor, values);
+    }
+    ReferenceSample(aTrack, aTime, expected);
+    return memcmp(values, expected, aTrack.components * sizeof(float)) == 0;
+}
+
+static void TestRandomTimes(const AnimationClip& aClip, const std::vector<TrackData>& aTracks)
+{
+    std::mt19937 random(430);
+    std::uniform_real_distribution<float> time(-1.0f, aClip.GetDuration() + 1.0f);
+    bool isSearchCorrect = true;
+    bool isCursorCorrect = true;
+    bool isKeyframeCorrect = true;
+
+    for (unsigned int track = 0; track < aTracks.size(); track++)
+    {
+        unsigned int keyframes = static_cast<unsigned int>(aTracks[track].times.size());
+        for (unsigned int i = 0; i < 20000; i++)
+        {
+            //A stale cursor, anywhere in the track OR past its end
+            float t = time(random);
+            unsigned int cursor = random() % (keyframes + 3);
+            isSearchCorrect = isSearchCorrect && IsSampleCorrect(aClip, aTracks[track], track, t, nullptr);
+            isCursorCorrect = isCursorCorrect && IsSampleCorrect(aClip, aTracks[track], track, t, &cursor);
+        }
+
+        //Exactly on each keyframe, and on the floats either side of it
+        for (unsigned int i = 0; i < keyframes; i++)
+        {
+            const float keyframeTimes[] = { aTracks[track].times[i], nextafterf(aTracks[track].times[i], -1.0f), nextafterf(aTracks[track].times[i], 1000.0f) };
+            for (unsigned int j = 0; j < 3; j++)
+            {
+                unsigned int cursor = i > 0 ? i - 1 : 0;
+                isKeyframeCorrect = isKeyframeCorrect && IsSampleCorrect(aClip, aTracks[track], track, keyframeTimes[j], nullptr);
+                isKeyframeCorrect = isKeyframeCorrect && IsSampleCorrect(aClip, aTracks[track], track, keyframeTimes[j], &cursor);
+            }
+        }
+    }
+
+    TEST_CHECK(isSearchCorrect == true);
+    TEST_CHECK(isCursorCorrect == true);
+    TEST_CHECK(isKeyframeCorrect == true);
+}
+
+//Plays every track back through a cursor, the time moves forward by the step, and is wrapped OR sought as it goes
+static bool PlayBack(const AnimationClip& aClip, const std::vector<TrackData>& aTracks, float aStep, bool aLoops, bool aSeeks)
+{
+    bool isCorrect = true;
+    for (unsigned int track = 0; track < aTracks.size(); track++)
+    {
+        unsigned int cursor = 0;
+        float time = -0.25f;
+        float duration = aClip.GetDuration();
+        for (unsigned int i = 0; i < 3 * (unsigned int)(duration / aStep) + 10; i++)
+        {
+            isCorrect = isCorrect && IsSampleCorrect(aClip, aTracks[track], track, time, &cursor);
+            time += aStep;
+
+            if (aLoops == true && time > duration)
+            {
+                time = fmodf(time, duration);
+            }
+            if (aSeeks == true && i % 97 == 96)
+            {
+                time = time > duration * 0.5f ? time - duration * 0.4f : time + duration * 0.3f;
+            }
+        }
+    }
+    return isCorrect;
+}
+
+static void TestPlayback(const AnimationClip& aClip, const std::vector<TrackData>& aTracks)
+{
+    //A frame's step at 240, 60 and 10 fps, and steps that skip past many keyframes
+    const float steps[] = { 1.0f / 240.0f, 1.0f / 60.0f, 0.1f, 0.75f, 7.0f };
+    for (unsigned int i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+    {
+        TEST_CHECK(PlayBack(aClip, aTracks, steps[i], false, false) == true);
+        TEST_CHECK(PlayBack(aClip, aTracks, steps[i], true, false) == true);
+        TEST_CHECK(PlayBack(aClip, aTracks, steps[i], true, true) == true);
+    }
+}
+
+//Returns true if two clips have the same tracks and keyframes, bit for bit
+static bool AreIdentical(const AnimationClip& aClip, const AnimationClip& aOther)
+{
+    if (aClip.GetTrackCount() != aOther.GetTrackCount())
+    {
+        return false;
+    }
+
+    float duration = aClip.GetDuration();
+    float otherDuration = aOther.GetDuration();
+    bool isIdentical = memcmp(&duration, &otherDuration, sizeof(float)) == 0 && aClip.GetSize() == aOther.GetSize();
+    for (unsigned int track = 0; track < aClip.GetTrackCount() && isIdentical == true; track++)
+    {
+        unsigned int components = aClip.GetTrackComponents(track);
+        isIdentical = aClip.GetTrackName(track) == aOther.GetTrackName(track) && components == aOther.GetTrackComponents(track) &&
+            aClip.GetKeyframeCount(track) == aOther.GetKeyframeCount(track) && aOther.GetTrackIndex(aClip.GetTrackName(track)) == (int)track;
+
+        for (unsigned int keyframe = 0; keyframe < aClip.GetKeyframeCount(track) && isIdentical == true; keyframe++)
+        {
+            float time = aClip.GetKeyframeTime(track, keyframe);
+            float otherTime = aOther.GetKeyframeTime(track, keyframe);
+            isIdentical = memcmp(&time, &otherTime, sizeof(float)) == 0 &&
+                memcmp(aClip.GetKeyframeValues(track, keyframe), aOther.GetKeyframeValues(track, keyframe), components * sizeof(float)) == 0 &&
+                aClip.GetKeyframeEasing(track, keyframe) == aOther.GetKeyframeEasing(track, keyframe);
+        }
+    }
+    return isIdentical;
+}
+
+//Returns true if two clips sample the same values, bit for bit, through the binary search and through a cursor
+static bool SampleIdentically(const AnimationClip& aClip, const AnimationClip& aOther)
+{
+    bool isIdentical = true;
+    for (unsigned int track = 0; track < aClip.GetTrackCount(); track++)
+    {
+        unsigned int cursor = 0;
+        unsigned int otherCursor = 0;
+        for (float time = -0.5f; time < aClip.GetDuration() + 0.5f; time += 1.0f / 120.0f)
+        {
+            float values[4];
+            float otherValues[4];
+            aClip.Sample(track, time, values);
+            aOther.Sample(track, time, otherValues);
+            isIdentical = isIdentical && memcmp(values, otherValues, aClip.GetTrackComponents(track) * sizeof(float)) == 0;
+
+            aClip.Sample(track, time, cursor, values);
+            aOther.Sample(track, time, otherCursor, otherValues);
+            isIdentical = isIdentical && memcmp(values, otherValues, aClip.GetTrackComponents(track) * sizeof(float)) == 0;
+        }
+    }
+    return isIdentical;
+}
+
+//Writes the tracks to a clip .json file, every float is written with enough digits to read back the same float
+static void WriteClipFile(const std::vector<TrackData>& aTracks)
+{
+    static const char* easingNames[EasingType_Count] =
+    {
+        "Linear",
+        "QuadraticIn", "QuadraticOut", "QuadraticInOut",
+        "CubicIn", "CubicOut", "CubicInOut",
+        "QuarticIn", "QuarticOut", "QuarticInOut",
+        "QuinticIn", "QuinticOut", "QuinticInOut",
+        "SinusoidalIn", "SinusoidalOut", "SinusoidalInOut",
+        "ExponentialIn", "ExponentialOut", "ExponentialInOut",
+        "CircularIn", "CircularOut", "CircularInOut",
+        "ElasticIn", "ElasticOut", "ElasticInOut",
+        "BackIn", "BackOut", "BackInOut",
+        "BounceIn", "BounceOut", "BounceInOut"
+    };
+
+    std::ofstream file(TEST_CLIP_PATH, std::ios::binary | std::ios::trunc);
+    file << std::setprecision(9) << "{ \"tracks\": [\n";
+    for (unsigned int i = 0; i < aTracks.size(); i++)
+    {
+        const TrackData& track = aTracks[i];
+        file << "  { \"name\": \"" << track.name << "\", \"type\": \"" << (track.components == 1 ? "float" : (track.components == 2 ? "Vector2" : "Color")) << "\", \"keyframes\": [\n";
+        for (unsigned int j = 0; j < track.times.size(); j++)
+        {
+            file << "    { \"time\": " << track.times[j] << ", \"value\": " << (track.components > 1 ? "[" : "");
+            for (unsigned int k = 0; k < track.components; k++)
+            {
+                file << (k > 0 ? ", " : "") << track.values[j * track.components + k];
+            }
+            file << (track.components > 1 ? "]" : "") << ", \"easing\": \"" << easingNames[track.easings[j]] << "\" }" << (j + 1 < track.times.size() ? ",\n" : "\n");
+        }
+        file << "  ] }" << (i + 1 < aTracks.size() ? ",\n" : "\n");
+    }
+    file << "] }\n";
+}
+
+static void TestCacheRoundTrip(const AnimationClip& aClip, const std::vector<TrackData>& aTracks)
+{
+    WriteClipFile(aTracks);
+
+    //Unpack the clip the way the ResourceManager does, from the contents the cache records
+    std::vector<char> buffer;
+    MetadataSource source;
+    AnimationClip* unpacked = nullptr;
+    TEST_CHECK(MetadataCache::ReadSource(TEST_CLIP_PATH, buffer, &source) == true);
+    TEST_CHECK(AnimationClip::Unpack(TEST_CLIP_PATH, &buffer[0], (unsigned int)source.size, &unpacked) == true);
+    if (unpacked == nullptr)
+    {
+        return;
+    }
+
+    //The .json file holds the same floats the clip was made with
+    TEST_CHECK(AreIdentical(aClip, *unpacked) == true);
+
+    AnimationClip* fromFile = nullptr;
+    TEST_CHECK(AnimationClip::Unpack(TEST_CLIP_PATH, &fromFile) == true && fromFile != nullptr && AreIdentical(*unpacked, *fromFile) == true);
+    delete fromFile;
+
+    //Save it to the cache and load it back
+    AnimationClip* loaded = nullptr;
+    TEST_CHECK(MetadataCache::SaveAnimationClip(TEST_CLIP_PATH, source, unpacked) == true);
+    TEST_CHECK(MetadataCache::LoadAnimationClip(TEST_CLIP_PATH, &loaded) == true);
+    if (loaded != nullptr)
+    {
+        TEST_CHECK(AreIdentical(*unpacked, *loaded) == true);
+        TEST_CHECK(SampleIdentically(*unpacked, *loaded) == true);
+        printf("%u tracks, %u bytes of keyframes, cached in %u bytes, reloaded bit identical\n", loaded->GetTrackCount(), loaded->GetSize(),
+            (unsigned int)std::ifstream(MetadataCache::GetCachePath(TEST_CLIP_PATH).c_str(), std::ios::binary | std::ios::ate).tellg());
+    }
+
+    delete loaded;
+    delete unpacked;
+    remove(MetadataCache::GetCachePath(TEST_CLIP_PATH).c_str());
+    remove(TEST_CLIP_PATH);
+}
+
+//Returns the ns a sample takes, playing the track back at 60 fps through a cursor OR through the binary search
+static double TimeSamples(const AnimationClip& aClip, unsigned int aTrack, bool aUsesCursor)
+{
+    const unsigned int passes = 200;
+    float sum = 0.0f;
+    unsigned int samples = 0;
+    Tests::Timer timer;
+    for (unsigned int pass = 0; pass < passes; pass++)
+    {
+        unsigned int cursor = 0;
+        for (float time = 0.0f; time < aClip.GetDuration(); time += 1.0f / 60.0f)
+        {
+            float values[4];
+            if (aUsesCursor == true)
+            {
+                aClip.Sample(aTrack, time, cursor, values);
+            }
+            else
+            {
+                aClip.Sample(aTrack, time, values);
+            }
+            sum += values[0];
+            samples++;
+        }
+    }
+    Tests::KeepAlive(sum);
+    return timer.GetMilliseconds() * 1000000.0 / samples;
+}
+
+int main()
+{
+    std::vector<TrackData> tracks = MakeTracks();
+    AnimationClip* clip = MakeClip(tracks);
+    printf("%u tracks over %.2f s\n", clip->GetTrackCount(), clip->GetDuration());
+
+    TestRandomTimes(*clip, tracks);
+    TestPlayback(*clip, tracks);
+    TestCacheRoundTrip(*clip, tracks);
+
+    printf("\nns per sample at 60 fps | %8s %8s\n", "cursor", "search");
+    for (unsigned int track = 0; track < 3; track++)
+    {
+        printf("%-8s %5u keyframes | %8.2f %8.2f\n", clip->GetTrackName(track).c_str(), clip->GetKeyframeCount(track),
+            TimeSamples(*clip, track, true), TimeSamples(*clip, track, false));
+    }
+    delete clip;
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All AnimationClip tests passed" : "AnimationClip tests FAILED");
+    return Tests::Failures();
+}
+
+//Texture.cpp depends on OpenGL, MetadataCache.cpp references it but the tests don't load fonts, so it's stubbed out
+namespace GameDev2D
+{
+    Texture::~Texture() {}
+}
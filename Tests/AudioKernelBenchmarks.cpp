@@ -0,0 +1,351 @@
+//Tests the AudioKernels against their scalar references: the conversions and the accumulation have to be bit exact, the
+//resamplers have to be within rounding of them. The resamplers' quality is checked as well, by resampling a 1 kHz sine
+//pitched by 1.3 and comparing it to the analytic sine. Then benchmarks each kernel against its scalar reference, and the
+//AudioMixer's throughput with 256 looping 16-bit voices, unpitched and pitched through each resampler.
+//
+//Sources: Source/Framework/Audio/AudioKernels.cpp Source/Framework/Audio/AudioMixer.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Audio/AudioKernels.h"
+#include "../Source/Framework/Audio/AudioMixer.h"
+#include "../Source/Framework/Audio/AudioStream.h"
+#include "../Source/Framework/Math/Simd.h"
+#include <math.h>
+#include <random>
+#include <string.h>
+
+using namespace GameDev2D;
+
+
+//The worst difference allowed between a resampler and its scalar reference, the SSE2 versions sum the taps in another order
+const float TEST_RESAMPLE_TOLERANCE = 2.4e-7f;
+
+//The frames the sinc resampler reads before and after the frames it's resampling
+const unsigned int TEST_PADDING = AudioKernels::SINC_TAPS;
+
+//The frame counts that are checked, the SSE2 kernels handle 4 OR 8 floats at a time, the rest are the tails
+const unsigned int TEST_FRAME_COUNTS[] = { 1, 2, 3, 4, 5, 7, 8, 15, 16, 17, 255, 256, 257 };
+
+//Returns the largest difference between two arrays of floats
+static float GetMaxDifference(const std::vector<float>& aA, const std::vector<float>& aB)
+{
+    float difference = 0.0f;
+    for (size_t i = 0; i < aA.size(); i++)
+    {
+        difference = std::max(difference, fabsf(aA[i] - aB[i]));
+    }
+    return difference;
+}
+
+static bool AreBitExact(const std::vector<float>& aA, const std::vector<float>& aB)
+{
+    return aA.size() == aB.size() && memcmp(aA.data(), aB.data(), aA.size() * sizeof(float)) == 0;
+}
+
+//Returns random frames in the range -1.0f to 1.0f, with the padding the resamplers read before and after them
+static std::vector<float> MakeFrames(std::mt19937& aRandom, unsigned int aFrames, unsigned int aChannels)
+{
+    std::uniform_real_distribution<float> sample(-1.0f, 1.0f);
+    std::vector<float> frames((aFrames + TEST_PADDING * 2) * aChannels);
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        frames[i] = sample(aRandom);
+    }
+    return frames;
+}
+
+static void TestConversions()
+{
+    std::mt19937 random(32);
+    bool isU8Exact = true;
+    bool isS16Exact = true;
+    for (unsigned int i = 0; i < sizeof(TEST_FRAME_COUNTS) / sizeof(TEST_FRAME_COUNTS[0]); i++)
+    {
+        //Every 8 and 16-bit value is converted, plus random ones for the tails
+        unsigned int count = TEST_FRAME_COUNTS[i] + 65536;
+        std::vector<unsigned char> u8(count);
+        std::vector<short> s16(count);
+        for (unsigned int j = 0; j < count; j++)
+        {
+            u8[j] = (unsigned char)(j < 65536 ? j : random());
+            s16[j] = (short)(j < 65536 ? j : random());
+        }
+
+        std::vector<float> output(count);
+        std::vector<float> expected(count);
+        AudioKernels::ConvertU8ToFloat(u8.data(), output.data(), count);
+        AudioKernels::ConvertU8ToFloatScalar(u8.data(), expected.data(), count);
+        isU8Exact = isU8Exact && AreBitExact(output, expected);
+
+        AudioKernels::ConvertS16ToFloat(s16.data(), output.data(), count);
+        AudioKernels::ConvertS16ToFloatScalar(s16.data(), expected.data(), count);
+        isS16Exact = isS16Exact && AreBitExact(output, expected);
+    }
+
+    TEST_CHECK(isU8Exact == true);
+    TEST_CHECK(isS16Exact == true);
+    printf("ConvertU8ToFloat: %s, ConvertS16ToFloat: %s\n", isU8Exact == true ? "bit exact" : "DIFFERS", isS16Exact == true ? "bit exact" : "DIFFERS");
+}
+
+static void TestAccumulation()
+{
+    std::mt19937 random(33);
+    std::uniform_real_distribution<float> gain(0.0f, 1.0f);
+    bool isMonoExact = true;
+    bool isStereoExact = true;
+    for (unsigned int i = 0; i < sizeof(TEST_FRAME_COUNTS) / sizeof(TEST_FRAME_COUNTS[0]); i++)
+    {
+        unsigned int frames = TEST_FRAME_COUNTS[i];
+        std::vector<float> mono = MakeFrames(random, frames, 1);
+        std::vector<float> stereo = MakeFrames(random, frames, 2);
+        std::vector<float> bus = MakeFrames(random, frames, 2);
+        float leftGain = gain(random);
+        float rightGain = gain(random);
+
+        std::vector<float> output = bus;
+        std::vector<float> expected = bus;
+        AudioKernels::AccumulateMono(mono.data(), output.data(), frames, leftGain, rightGain);
+        AudioKernels::AccumulateMonoScalar(mono.data(), expected.data(), frames, leftGain, rightGain);
+        isMonoExact = isMonoExact && AreBitExact(output, expected);
+
+        output = bus;
+        expected = bus;
+        AudioKernels::AccumulateStereo(stereo.data(), output.data(), frames, leftGain, rightGain);
+        AudioKernels::AccumulateStereoScalar(stereo.data(), expected.data(), frames, leftGain, rightGain);
+        isStereoExact = isStereoExact && AreBitExact(output, expected);
+    }
+
+    TEST_CHECK(isMonoExact == true);
+    TEST_CHECK(isStereoExact == true);
+    printf("AccumulateMono: %s, AccumulateStereo: %s\n", isMonoExact == true ? "bit exact" : "DIFFERS", isStereoExact == true ? "bit exact" : "DIFFERS");
+}
+
+static void TestResamplers()
+{
+    std::mt19937 random(34);
+    float linearDifference[2] = { 0.0f, 0.0f };
+    float sincDifference[2] = { 0.0f, 0.0f };
+
+    //The steps go from 1/8x to the mixer's 8x cap, the positions start on and between frames
+    const double steps[] = { 0.125, 0.5, 0.999, 1.0, 1.3, 2.0, 3.7, 8.0 };
+    for (unsigned int channels = 1; channels <= 2; channels++)
+    {
+        for (unsigned int i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+        {
+            for (unsigned int j = 0; j < sizeof(TEST_FRAME_COUNTS) / sizeof(TEST_FRAME_COUNTS[0]); j++)
+            {
+                unsigned int frameCount = TEST_FRAME_COUNTS[j];
+                unsigned long long step = (unsigned long long)(steps[i] * 4294967296.0);
+                unsigned long long position = random() % 2 == 0 ? 0 : (unsigned long long)random();
+                unsigned int inputFrames = (unsigned int)((position + step * frameCount) >> 32) + 1;
+
+                std::vector<float> input = MakeFrames(random, inputFrames, channels);
+                const float* frames = input.data() + TEST_PADDING * channels;
+                std::vector<float> output(frameCount * channels);
+                std::vector<float> expected(frameCount * channels);
+
+                AudioKernels::ResampleLinear(frames, channels, position, step, output.data(), frameCount);
+                AudioKernels::ResampleLinearScalar(frames, channels, position, step, expected.data(), frameCount);
+                linearDifference[channels - 1] = std::max(linearDifference[channels - 1], GetMaxDifference(output, expected));
+
+                AudioKernels::ResampleSinc(frames, channels, position, step, output.data(), frameCount);
+                AudioKernels::ResampleSincScalar(frames, channels, position, step, expected.data(), frameCount);
+                sincDifference[channels - 1] = std::max(sincDifference[channels - 1], GetMaxDifference(output, expected));
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        TEST_CHECK(linearDifference[i] <= TEST_RESAMPLE_TOLERANCE);
+        TEST_CHECK(sincDifference[i] <= TEST_RESAMPLE_TOLERANCE);
+    }
+    printf("ResampleLinear max difference: mono %.2g, stereo %.2g\n", linearDifference[0], linearDifference[1]);
+    printf("ResampleSinc max difference:   mono %.2g, stereo %.2g\n", sincDifference[0], sincDifference[1]);
+}
+
+//Returns the worst error (in dB, relative to full scale) of a 1 kHz sine at 44.1 kHz, resampled with a 1.3 step,
+//against the analytic 1.3 kHz sine
+typedef void (*Resampler)(const float*, unsigned int, unsigned long long, unsigned long long, float*, unsigned int);
+static double GetSineError(Resampler aResampler)
+{
+    const double pi = 3.14159265358979323846;
+    const unsigned int frameCount = 4096;
+    const double step = 1.3;
+
+    std::vector<float> input(frameCount * 2 + TEST_PADDING * 2);
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        double frame = (double)i - (double)TEST_PADDING;
+        input[i] = (float)sin(2.0 * pi * 1000.0 * frame / 44100.0);
+    }
+
+    std::vector<float> output(frameCount);
+    aResampler(input.data() + TEST_PADDING, 1, 0, (unsigned long long)(step * 4294967296.0), output.data(), frameCount);
+
+    double worst = 0.0;
+    for (unsigned int i = 0; i < frameCount; i++)
+    {
+        double expected = sin(2.0 * pi * 1000.0 * (double)i * step / 44100.0);
+        worst = std::max(worst, fabs((double)output[i] - expected));
+    }
+    return 20.0 * log10(worst);
+}
+
+static void TestResamplerQuality()
+{
+    double linearError = GetSineError(AudioKernels::ResampleLinear);
+    double sincError = GetSineError(AudioKernels::ResampleSinc);
+
+    //Linear interpolation of a 1 kHz sine is around -52 dB, the sinc filter has to be much cleaner
+    TEST_CHECK(linearError < -50.0);
+    TEST_CHECK(sincError < -65.0);
+    printf("1 kHz sine pitched by 1.3, worst error: linear %.1f dB, sinc %.1f dB\n", linearError, sincError);
+}
+
+//Returns the ns it takes to run the kernel on 256 frames, the best of several runs
+template<typename Kernel> static double Time(Kernel aKernel)
+{
+    const unsigned int iterations = 20000;
+    double best = 1e30;
+    for (unsigned int run = 0; run < 5; run++)
+    {
+        Tests::Timer timer;
+        for (unsigned int i = 0; i < iterations; i++)
+        {
+            aKernel();
+        }
+        best = std::min(best, timer.GetMilliseconds() * 1000000.0 / iterations);
+    }
+    return best;
+}
+
+static void BenchmarkKernels()
+{
+    const unsigned int frames = 256;
+    const unsigned long long step = (unsigned long long)(1.3 * 4294967296.0);
+    std::mt19937 random(35);
+    std::vector<float> mono = MakeFrames(random, frames * 2, 1);
+    std::vector<float> stereo = MakeFrames(random, frames * 2, 2);
+    std::vector<short> s16(frames * 2);
+    std::vector<float> output(frames * 2);
+    for (size_t i = 0; i < s16.size(); i++)
+    {
+        s16[i] = (short)random();
+    }
+    const float* monoFrames = mono.data() + TEST_PADDING;
+    const float* stereoFrames = stereo.data() + TEST_PADDING * 2;
+    float* out = output.data();
+
+    printf("\nns per 256 frames, the resamplers' step is 1.3 (%s)\n", SIMD_SSE2 == 1 ? "SSE2" : "no SSE2, both are the scalar reference");
+    printf("%-22s | %9s %9s\n", "kernel", "SSE2", "scalar");
+
+    printf("%-22s | %9.0f %9.0f\n", "ConvertS16 stereo",
+        Time([&]() { AudioKernels::ConvertS16ToFloat(s16.data(), out, frames * 2); Tests::KeepAlive(out[0]); }),
+        Time([&]() { AudioKernels::ConvertS16ToFloatScalar(s16.data(), out, frames * 2); Tests::KeepAlive(out[0]); }));
+    printf("%-22s | %9.0f %9.0f\n", "ResampleLinear mono",
+        Time([&]() { AudioKernels::ResampleLinear(monoFrames, 1, 0, step, out, frames); Tests::KeepAlive(out[0]); }),
+        Time([&]() { AudioKernels::ResampleLinearScalar(monoFrames, 1, 0, step, out, frames); Tests::KeepAlive(out[0]); }));
+    printf("%-22s | %9.0f %9.0f\n", "ResampleLinear stereo",
+        Time([&]() { AudioKernels::ResampleLinear(stereoFrames, 2, 0, step, out, frames); Tests::KeepAlive(out[0]); }),
+        Time([&]() { AudioKernels::ResampleLinearScalar(stereoFrames, 2, 0, step, out, frames); Tests::KeepAlive(out[0]); }));
+    printf("%-22s | %9.0f %9.0f\n", "ResampleSinc mono",
+        Time([&]() { AudioKernels::ResampleSinc(monoFrames, 1, 0, step, out, frames); Tests::KeepAlive(out[0]); }),
+        Time([&]() { AudioKernels::ResampleSincScalar(monoFrames, 1, 0, step, out, frames); Tests::KeepAlive(out[0]); }));
+    printf("%-22s | %9.0f %9.0f\n", "ResampleSinc stereo",
+        Time([&]() { AudioKernels::ResampleSinc(stereoFrames, 2, 0, step, out, frames); Tests::KeepAlive(out[0]); }),
+        Time([&]() { AudioKernels::ResampleSincScalar(stereoFrames, 2, 0, step, out, frames); Tests::KeepAlive(out[0]); }));
+    printf("%-22s | %9.0f %9.0f\n", "AccumulateMono",
+        Time([&]() { AudioKernels::AccumulateMono(monoFrames, out, frames, 0.5f, 0.25f); Tests::KeepAlive(out[0]); }),
+        Time([&]() { AudioKernels::AccumulateMonoScalar(monoFrames, out, frames, 0.5f, 0.25f); Tests::KeepAlive(out[0]); }));
+    printf("%-22s | %9.0f %9.0f\n", "AccumulateStereo",
+        Time([&]() { AudioKernels::AccumulateStereo(stereoFrames, out, frames, 0.5f, 0.25f); Tests::KeepAlive(out[0]); }),
+        Time([&]() { AudioKernels::AccumulateStereoScalar(stereoFrames, out, frames, 0.5f, 0.25f); Tests::KeepAlive(out[0]); }));
+}
+
+//Returns the number of voices the mixer mixes per ms, in blocks of 512 frames
+static double BenchmarkMixer(unsigned int aVoiceCount, float aFrequencyRatio, AudioResampler aResampler)
+{
+    const unsigned int frames = 512;
+    const unsigned int mixes = 200;
+    AudioMixer mixer(44100, aVoiceCount);
+    mixer.SetResampler(aResampler);
+
+    std::vector<short> samples(44100 * 2);
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        samples[i] = (short)(sinf((float)i * 0.05f) * 8000.0f);
+    }
+
+    AudioSource source;
+    source.data = samples.data();
+    source.frameCount = (unsigned int)samples.size() / 2;
+    source.sampleRate = 44100;
+    source.channels = 2;
+    source.bitsPerSample = 16;
+
+    std::vector<AudioVoice> voices(aVoiceCount);
+    for (unsigned int i = 0; i < aVoiceCount; i++)
+    {
+        voices[i] = mixer.CreateVoice(source, nullptr);
+        mixer.SetLooping(voices[i], true);
+        mixer.SetFrequencyRatio(voices[i], aFrequencyRatio);
+        mixer.SetVolume(voices[i], 1.0f / aVoiceCount);
+        mixer.SetPosition(voices[i], i * 97);
+        mixer.Start(voices[i]);
+    }
+
+    //The first mix applies the commands
+    std::vector<float> output(frames * mixer.GetChannels());
+    mixer.Mix(output.data(), frames);
+    TEST_CHECK(mixer.GetPlayingVoiceCount() == aVoiceCount);
+
+    Tests::Timer timer;
+    for (unsigned int i = 0; i < mixes; i++)
+    {
+        mixer.Mix(output.data(), frames);
+    }
+    double ms = timer.GetMilliseconds();
+    Tests::KeepAlive(output[0]);
+
+    for (unsigned int i = 0; i < aVoiceCount; i++)
+    {
+        mixer.DestroyVoice(voices[i]);
+    }
+    return (double)aVoiceCount * mixes / ms;
+}
+
+static void BenchmarkMixes()
+{
+    const unsigned int voiceCount = 256;
+    printf("\nAudioMixer, %u looping 16-bit stereo voices, voices mixed per ms in blocks of 512 frames\n", voiceCount);
+    printf("%-22s | %9s %18s\n", "", "voices/ms", "ns per voice-frame");
+
+    const char* names[] = { "unpitched", "pitched 1.3x, linear", "pitched 1.3x, sinc" };
+    const float ratios[] = { 1.0f, 1.3f, 1.3f };
+    const AudioResampler resamplers[] = { AudioResampler_Linear, AudioResampler_Linear, AudioResampler_Sinc };
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        double voicesPerMs = BenchmarkMixer(voiceCount, ratios[i], resamplers[i]);
+        printf("%-22s | %9.0f %18.2f\n", names[i], voicesPerMs, 1000000.0 / (voicesPerMs * 512.0));
+    }
+}
+
+int main()
+{
+    TestConversions();
+    TestAccumulation();
+    TestResamplers();
+    TestResamplerQuality();
+    BenchmarkKernels();
+    BenchmarkMixes();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All AudioKernels tests passed" : "AudioKernels tests FAILED");
+    return Tests::Failures();
+}
+
+//AudioStream.cpp reads files through Windows.h, none of the voices are streamed so ReadFrames() is stubbed out
+namespace GameDev2D
+{
+    void AudioStream::ReadFrames(unsigned int, unsigned int, float*) {}
+}
@@ -0,0 +1,296 @@
+//Tests that the AudioMixer discards the notifications of a voice's earlier plays, and that a voice's source is no longer read
+//once Stop() OR DestroyVoice() returns, while another thread mixes. Then benchmarks how long Mix() takes while the controlling
+//thread changes the voices as fast as it can, Mix() doesn't lock so it shouldn't be slowed down by it.
+//
+//Sources: Source/Framework/Audio/AudioMixer.cpp Source/Framework/Audio/AudioKernels.cpp
+//
+//Build with -pthread, the tests are most useful built with -fsanitize=thread as well.
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Audio/AudioMixer.h"
+#include "../Source/Framework/Audio/AudioStream.h"
+#include <random>
+#include <thread>
+
+using namespace GameDev2D;
+
+
+//Counts the notifications a voice receives
+class CountingCallback : public AudioVoiceCallback
+{
+public:
+    CountingCallback() :
+        started(0),
+        ended(0),
+        looped(0)
+    {
+    }
+
+    void OnVoiceStarted() { started++; }
+    void OnVoiceEnded() { ended++; }
+    void OnVoiceLooped() { looped++; }
+
+    unsigned int started;
+    unsigned int ended;
+    unsigned int looped;
+};
+
+static AudioSource MakeSource(const std::vector<short>& aSamples)
+{
+    AudioSource source;
+    source.data = aSamples.data();
+    source.frameCount = (unsigned int)aSamples.size();
+    source.sampleRate = 44100;
+    source.channels = 1;
+    source.bitsPerSample = 16;
+    return source;
+}
+
+static void TestStaleNotifications()
+{
+    AudioMixer mixer(44100, 4);
+    std::vector<short> samples(100, 1000);
+    std::vector<float> output(512 * mixer.GetChannels());
+    CountingCallback callback;
+
+    //The voice plays to its end in one mix, which queues its started and ended notifications
+    AudioVoice voice = mixer.CreateVoice(MakeSource(samples), &callback);
+    mixer.Start(voice);
+    mixer.Mix(output.data(), 512);
+    TEST_CHECK(mixer.IsPlaying(voice) == false);
+
+    //It's played again before the notifications are dispatched, the first play's notifications are discarded
+    mixer.Start(voice);
+    TEST_CHECK(mixer.IsPlaying(voice) == true);
+    mixer.DispatchNotifications();
+    TEST_CHECK(callback.started == 0 && callback.ended == 0);
+    TEST_CHECK(mixer.IsPlaying(voice) == true);
+
+    //The second play's notifications are dispatched
+    mixer.Mix(output.data(), 512);
+    mixer.DispatchNotifications();
+    TEST_CHECK(callback.started == 1 && callback.ended == 1);
+
+    //A voice that is destroyed, then created again on the same slot, doesn't receive the first voice's notifications
+    mixer.Start(voice);
+    mixer.Mix(output.data(), 512);
+    mixer.DestroyVoice(voice);
+    CountingCallback other;
+    AudioVoice otherVoice = mixer.CreateVoice(MakeSource(samples), &other);
+    mixer.DispatchNotifications();
+    TEST_CHECK(other.started == 0 && other.ended == 0 && callback.ended == 1);
+
+    //Stopping a voice keeps its position, starting it again plays the rest of the source
+    std::vector<short> longSamples(2000, 1000);
+    AudioVoice longVoice = mixer.CreateVoice(MakeSource(longSamples), &callback);
+    mixer.Start(longVoice);
+    mixer.Mix(output.data(), 512);
+    mixer.Stop(longVoice);
+    TEST_CHECK(mixer.IsPlaying(longVoice) == false && mixer.GetFramesPlayed(longVoice) == 512);
+    mixer.Mix(output.data(), 512);
+    TEST_CHECK(output[0] == 0.0f && mixer.GetPlayingVoiceCount() == 0);
+    mixer.Start(longVoice);
+    mixer.Mix(output.data(), 512);
+    TEST_CHECK(output[0] != 0.0f && mixer.GetFramesPlayed(longVoice) == 1024);
+
+    //A one-shot voice is freed by the dispatch that follows its end
+    AudioVoice oneShot = mixer.PlayOneShot(MakeSource(samples), 1.0f, 1.0f);
+    TEST_CHECK(mixer.IsValid(oneShot) == true);
+    mixer.Mix(output.data(), 512);
+    TEST_CHECK(mixer.IsValid(oneShot) == true);
+    mixer.DispatchNotifications();
+    TEST_CHECK(mixer.IsValid(oneShot) == false);
+
+    mixer.DestroyVoice(otherVoice);
+    mixer.DestroyVoice(longVoice);
+}
+
+static void TestCommandsHeldBack()
+{
+    //Nothing mixes while more commands are queued than the queue holds, they're passed on in order as the mixer drains the queue
+    AudioMixer mixer(44100, 2);
+    std::vector<short> samples(100000);
+    for (unsigned int i = 0; i < samples.size(); i++)
+    {
+        samples[i] = (short)(i % 1000);
+    }
+
+    std::vector<float> output(512 * mixer.GetChannels());
+    AudioVoice voice = mixer.CreateVoice(MakeSource(samples), nullptr);
+    for (unsigned int i = 0; i < 100; i++)
+    {
+        mixer.SetPosition(voice, i);
+    }
+    mixer.Start(voice);
+
+    unsigned int mixes = 0;
+    while (mixer.GetFramesPlayed(voice) == 0 && mixes < 100)
+    {
+        mixer.Mix(output.data(), 512);
+        mixer.DispatchNotifications();
+        mixes++;
+    }
+
+    //The voice started from the last position it was given
+    TEST_CHECK(mixer.IsPlaying(voice) == true && mixer.GetFramesPlayed(voice) == 512);
+    TEST_CHECK(output[0] == 99.0f / 32768.0f && output[2] == 100.0f / 32768.0f);
+    mixer.DestroyVoice(voice);
+}
+
+static void TestThreads()
+{
+    const unsigned int voiceCount = 16;
+    AudioMixer mixer(44100, voiceCount + 8);
+
+    //Each voice has its own samples, they're overwritten as soon as the voice is stopped or destroyed. If the mixer still read
+    //them the thread sanitizer reports a race, and the mixed output would have the overwritten value in it
+    std::vector<std::vector<short> > samples(voiceCount, std::vector<short>(4096, 1000));
+    std::vector<AudioVoice> voices(voiceCount);
+    std::vector<CountingCallback> callbacks(voiceCount);
+
+    std::atomic<bool> isMixing(true);
+    std::atomic<unsigned int> badFrames(0);
+    std::thread mixing([&]()
+    {
+        std::vector<float> output(256 * mixer.GetChannels());
+        while (isMixing == true)
+        {
+            mixer.Mix(output.data(), 256);
+            for (unsigned int i = 0; i < output.size(); i++)
+            {
+                if (output[i] < 0.0f)
+                {
+                    badFrames++;
+                }
+            }
+        }
+    });
+
+    std::mt19937 random(11);
+    std::vector<short> oneShotSamples(300, 1000);
+    for (unsigned int i = 0; i < 200000; i++)
+    {
+        unsigned int index = random() % voiceCount;
+        AudioVoice& voice = voices[index];
+        switch (random() % 8)
+        {
+        case 0:
+            if (mixer.IsValid(voice) == true)
+            {
+                mixer.DestroyVoice(voice);
+                std::fill(samples[index].begin(), samples[index].end(), (short)-30000);
+            }
+            else
+            {
+                std::fill(samples[index].begin(), samples[index].end(), (short)1000);
+                voice = mixer.CreateVoice(MakeSource(samples[index]), &callbacks[index]);
+            }
+            break;
+
+        case 1:
+            mixer.Stop(voice);
+            if (mixer.IsValid(voice) == true)
+            {
+                std::fill(samples[index].begin(), samples[index].end(), (short)-30000);
+            }
+            break;
+
+        case 2:
+            if (mixer.IsValid(voice) == true && mixer.IsPlaying(voice) == false)
+            {
+                std::fill(samples[index].begin(), samples[index].end(), (short)1000);
+                mixer.SetPosition(voice, random() % 4096);
+                mixer.Start(voice);
+            }
+            break;
+
+        case 3: mixer.SetVolume(voice, (float)(random() % 100) / 100.0f); break;
+        case 4: mixer.SetPan(voice, (float)(random() % 100) / 50.0f - 1.0f); break;
+        case 5: mixer.SetFrequencyRatio(voice, 0.5f + (float)(random() % 100) / 50.0f); break;
+        case 6: mixer.SetLooping(voice, (random() & 1) != 0); break;
+        default: mixer.PlayOneShot(MakeSource(oneShotSamples), 0.5f, 1.0f); mixer.DispatchNotifications(); break;
+        }
+    }
+
+    isMixing = false;
+    mixing.join();
+
+    for (unsigned int i = 0; i < voiceCount; i++)
+    {
+        mixer.DestroyVoice(voices[i]);
+    }
+    TEST_CHECK(badFrames == 0);
+}
+
+static void BenchmarkMix()
+{
+    const unsigned int voiceCount = 64;
+    const unsigned int mixes = 4000;
+    AudioMixer mixer(44100, voiceCount);
+    std::vector<short> samples(44100, 1000);
+    std::vector<AudioVoice> voices(voiceCount);
+    for (unsigned int i = 0; i < voiceCount; i++)
+    {
+        voices[i] = mixer.CreateVoice(MakeSource(samples), nullptr);
+        mixer.SetLooping(voices[i], true);
+        mixer.SetFrequencyRatio(voices[i], 1.0f + (float)i / 100.0f);
+        mixer.Start(voices[i]);
+    }
+
+    printf("\n%-28s | %12s %12s\n", "64 voices, 512 frames", "mean us", "worst us");
+
+    for (unsigned int pass = 0; pass < 2; pass++)
+    {
+        //The second pass changes every voice's volume and pan on another thread, the way the game does every frame
+        std::atomic<bool> isMixing(true);
+        std::thread controlling([&]()
+        {
+            unsigned int i = 0;
+            while (pass == 1 && isMixing == true)
+            {
+                mixer.SetVolume(voices[i % voiceCount], (float)(i % 100) / 100.0f);
+                mixer.SetPan(voices[i % voiceCount], (float)(i % 100) / 50.0f - 1.0f);
+                i++;
+            }
+        });
+
+        std::vector<float> output(512 * mixer.GetChannels());
+        double totalMs = 0.0;
+        double worstMs = 0.0;
+        for (unsigned int i = 0; i < mixes; i++)
+        {
+            Tests::Timer timer;
+            mixer.Mix(output.data(), 512);
+            double ms = timer.GetMilliseconds();
+            totalMs += ms;
+            worstMs = std::max(worstMs, ms);
+        }
+        Tests::KeepAlive(output[0]);
+
+        isMixing = false;
+        controlling.join();
+        printf("%-28s | %12.2f %12.2f\n", pass == 0 ? "idle controlling thread" : "busy controlling thread", totalMs * 1000.0 / mixes, worstMs * 1000.0);
+    }
+
+    for (unsigned int i = 0; i < voiceCount; i++)
+    {
+        mixer.DestroyVoice(voices[i]);
+    }
+}
+
+int main()
+{
+    TestStaleNotifications();
+    TestCommandsHeldBack();
+    TestThreads();
+    BenchmarkMix();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All AudioMixer tests passed" : "AudioMixer tests FAILED");
+    return Tests::Failures();
+}
+
+//AudioStream.cpp reads files through Windows.h, none of the tests' voices are streamed so ReadFrames() is stubbed out
+namespace GameDev2D
+{
+    void AudioStream::ReadFrames(unsigned int, unsigned int, float*) {}
+}
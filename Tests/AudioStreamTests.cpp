@@ -0,0 +1,299 @@
+//Tests that a wave file streamed from disk through an AudioStream mixes bit for bit the same as the whole file loaded into
+//memory. Both are played by their own AudioMixer, pulled by a NullAudioSink (the sink the AUDIO_HEADLESS setting selects)
+//that records what was mixed. The files are several times longer than the stream's three buffers, so the buffers are
+//refilled by the background thread over and over. The cases play through the end of the file, loop across it, start at a
+//frame, and seek while playing the way Audio::SetSample() does (Stop, Seek, SetPosition, Start). The frames each voice has
+//played, which Audio::GetElapsed() is computed from, have to match as well, and the stream can't underrun.
+//
+//Sources: Source/Framework/Audio/AudioStream.cpp Source/Framework/Audio/AudioMixer.cpp Source/Framework/Audio/AudioKernels.cpp
+//         Source/Framework/Audio/AudioSink.cpp Source/Framework/Audio/AdpcmDecoder.cpp Tests/Support/Log.cpp
+//
+//Build with -pthread, the tests are most useful built with -fsanitize=thread as well. Run from a writable directory, the
+//generated wave files are written to the working directory and deleted once the tests are done.
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Audio/AudioMixer.h"
+#include "../Source/Framework/Audio/AudioSink.h"
+#include "../Source/Framework/Audio/AudioStream.h"
+#include "../Source/Framework/Utils/Wave/Wave.h"
+#include "../Source/Framework/GameDev2D_Settings.h"
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+using namespace GameDev2D;
+
+
+//The delta time of a game frame, the sink mixes this much audio per update
+const double TEST_FRAME_DELTA = 1.0 / 60.0;
+
+//A NullAudioSink that keeps everything it mixed
+class RecordingAudioSink : public NullAudioSink
+{
+public:
+    std::vector<float> samples;
+
+protected:
+    void OnMixed(const float* aSamples, unsigned int aFrameCount)
+    {
+        samples.insert(samples.end(), aSamples, aSamples + aFrameCount * m_Mixer->GetChannels());
+    }
+};
+
+//A generated wave file, its samples are kept to be played from memory
+struct TestWave
+{
+    std::string path;
+    std::vector<unsigned char> data;
+    unsigned int frameCount;
+    unsigned short channels;
+    unsigned short bitsPerSample;
+};
+
+//Writes a PCM wave file of noise over a sine, every frame differs from its neighbours so that a frame read from the wrong
+//place in the file is heard. A 'LIST' chunk is written before the data chunk, the stream has to skip it
+static TestWave WriteWave(const std::string& aPath, unsigned int aFrameCount, unsigned short aChannels, unsigned short aBitsPerSample)
+{
+    TestWave wave;
+    wave.path = aPath;
+    wave.frameCount = aFrameCount;
+    wave.channels = aChannels;
+    wave.bitsPerSample = aBitsPerSample;
+
+    std::mt19937 random(aFrameCount);
+    std::uniform_real_distribution<float> noise(-0.25f, 0.25f);
+    unsigned int samples = aFrameCount * aChannels;
+    wave.data.resize(samples * aBitsPerSample / 8);
+    for (unsigned int i = 0; i < samples; i++)
+    {
+        float sample = sinf((float)(i / aChannels) * 0.031f) * 0.7f + noise(random);
+        if (aBitsPerSample == 8)
+        {
+            wave.data[i] = (unsigned char)(128.0f + sample * 127.0f);
+        }
+        else
+        {
+            short value = (short)(sample * 32767.0f);
+            memcpy(&wave.data[i * 2], &value, sizeof(value));
+        }
+    }
+
+    const unsigned int formatSize = 16;
+    const unsigned short formatTag = 1; //PCM
+    const unsigned int sampleRate = 44100;
+    const unsigned short blockAlign = aChannels * aBitsPerSample / 8;
+    const unsigned int bytesPerSecond = sampleRate * blockAlign;
+    const unsigned int listSize = 5; //Odd, the chunk is padded to a WORD
+    const unsigned int dataSize = (unsigned int)wave.data.size();
+    const unsigned int riffSize = 4 + 8 + formatSize + 8 + listSize + 1 + 8 + dataSize;
+
+    std::ofstream stream(aPath.c_str(), std::ios::binary | std::ios::trunc);
+    stream.write("RIFF", 4);
+    stream.write(reinterpret_cast<const char*>(&riffSize), sizeof(riffSize));
+    stream.write("WAVEfmt ", 8);
+    stream.write(reinterpret_cast<const char*>(&formatSize), sizeof(formatSize));
+    stream.write(reinterpret_cast<const char*>(&formatTag), sizeof(formatTag));
+    stream.write(reinterpret_cast<const char*>(&aChannels), sizeof(aChannels));
+    stream.write(reinterpret_cast<const char*>(&sampleRate), sizeof(sampleRate));
+    stream.write(reinterpret_cast<const char*>(&bytesPerSecond), sizeof(bytesPerSecond));
+    stream.write(reinterpret_cast<const char*>(&blockAlign), sizeof(blockAlign));
+    stream.write(reinterpret_cast<const char*>(&aBitsPerSample), sizeof(aBitsPerSample));
+    stream.write("LIST", 4);
+    stream.write(reinterpret_cast<const char*>(&listSize), sizeof(listSize));
+    stream.write("test\0\0", 6);
+    stream.write("data", 4);
+    stream.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+    stream.write(reinterpret_cast<const char*>(wave.data.data()), dataSize);
+    return wave;
+}
+
+struct TestCase
+{
+    const char* name;
+    AudioResampler resampler;
+    float frequencyRatio;
+    bool isLooping;
+    unsigned int startFrame;
+    unsigned int seekFrame;     //The frame the voices seek to halfway through, 0 doesn't seek
+    double duration;            //In multiples of the file's duration
+};
+
+//A voice and the source it plays, as the Audio class keeps them
+struct TestVoice
+{
+    AudioMixer* mixer;
+    AudioStream* stream;
+    AudioVoice voice;
+    unsigned long long sampleOffset;
+};
+
+//Starts the voice at a frame the way Audio::Play() does, the stream is seeked before the voice is started
+static void Play(TestVoice& aVoice, unsigned int aFrame)
+{
+    if (aVoice.stream != nullptr)
+    {
+        aVoice.stream->Seek(aFrame);
+    }
+    aVoice.mixer->SetPosition(aVoice.voice, aFrame);
+    aVoice.mixer->Start(aVoice.voice);
+    aVoice.sampleOffset = aVoice.mixer->GetFramesPlayed(aVoice.voice);
+}
+
+//Returns what Audio::GetElapsedSamples() returns for the voice
+static unsigned long long GetElapsedSamples(TestVoice& aVoice)
+{
+    return aVoice.mixer->GetFramesPlayed(aVoice.voice) - aVoice.sampleOffset;
+}
+
+static void TestStreaming(const TestWave& aWave, const TestCase& aCase)
+{
+    AudioStream stream;
+    TEST_CHECK(stream.Open(aWave.path) == true);
+    TEST_CHECK(stream.GetFrameCount() == aWave.frameCount);
+    TEST_CHECK(stream.GetResidentBytes() == 3 * AUDIO_STREAM_BUFFER_BYTES / stream.GetBlockAlign() * stream.GetBlockAlign());
+
+    AudioSource memorySource;
+    memorySource.data = aWave.data.data();
+    memorySource.frameCount = aWave.frameCount;
+    memorySource.sampleRate = 44100;
+    memorySource.channels = aWave.channels;
+    memorySource.bitsPerSample = aWave.bitsPerSample;
+
+    AudioSource streamSource;
+    stream.GetAudioSource(streamSource);
+
+    //Each voice is played by its own mixer, through its own sink
+    AudioMixer memoryMixer(44100, 1);
+    AudioMixer streamMixer(44100, 1);
+    RecordingAudioSink memorySink;
+    RecordingAudioSink streamSink;
+    memorySink.Open(&memoryMixer);
+    streamSink.Open(&streamMixer);
+
+    TestVoice voices[2] = { { &memoryMixer, nullptr, memoryMixer.CreateVoice(memorySource, nullptr), 0 },
+                            { &streamMixer, &stream, streamMixer.CreateVoice(streamSource, nullptr), 0 } };
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        voices[i].mixer->SetResampler(aCase.resampler);
+        voices[i].mixer->SetFrequencyRatio(voices[i].voice, aCase.frequencyRatio);
+        voices[i].mixer->SetLooping(voices[i].voice, aCase.isLooping);
+        voices[i].mixer->SetPan(voices[i].voice, 0.3f);
+        Play(voices[i], aCase.startFrame);
+    }
+    stream.SetLooping(aCase.isLooping);
+
+    //Mix a game frame's worth of audio at a time. The test runs much faster than real time, the sleep gives the background
+    //thread the time it would have had to refill a buffer while a device played the frames
+    unsigned int updates = (unsigned int)(aCase.duration * aWave.frameCount / 44100.0 / TEST_FRAME_DELTA);
+    for (unsigned int update = 0; update < updates; update++)
+    {
+        if (aCase.seekFrame != 0 && update == updates / 2)
+        {
+            for (unsigned int i = 0; i < 2; i++)
+            {
+                voices[i].mixer->Stop(voices[i].voice);
+                Play(voices[i], aCase.seekFrame);
+            }
+        }
+
+        memorySink.Update(TEST_FRAME_DELTA);
+        streamSink.Update(TEST_FRAME_DELTA);
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+
+    bool isIdentical = memorySink.samples.size() == streamSink.samples.size() &&
+        memcmp(memorySink.samples.data(), streamSink.samples.data(), memorySink.samples.size() * sizeof(float)) == 0;
+    unsigned long long memoryElapsed = GetElapsedSamples(voices[0]);
+    unsigned long long streamElapsed = GetElapsedSamples(voices[1]);
+    unsigned int underruns = stream.GetUnderrunCount();
+
+    TEST_CHECK(isIdentical == true);
+    TEST_CHECK(memoryElapsed == streamElapsed);
+    TEST_CHECK(underruns == 0);
+
+    //Unpitched and without a seek, the elapsed samples are the frames mixed, up to the end of the file if it doesn't loop
+    if (aCase.frequencyRatio == 1.0f && aCase.seekFrame == 0)
+    {
+        unsigned long long expected = streamSink.GetFramesMixed();
+        if (aCase.isLooping == false)
+        {
+            expected = std::min(expected, (unsigned long long)(aWave.frameCount - aCase.startFrame));
+        }
+        TEST_CHECK(streamElapsed == expected);
+    }
+
+    printf("%-40s | %9llu frames mixed, %9llu elapsed, %u underruns, %s\n", aCase.name, streamSink.GetFramesMixed(), streamElapsed,
+        underruns, isIdentical == true ? "bit identical" : "DIFFERS");
+
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        voices[i].mixer->DestroyVoice(voices[i].voice);
+    }
+    memorySink.Close();
+    streamSink.Close();
+}
+
+static void TestRejectsShortFiles()
+{
+    //A file that isn't twice the size of the stream's buffers is rejected, it's cheaper to load into memory
+    TestWave wave = WriteWave("AudioStreamTests_Short.wav", 3 * AUDIO_STREAM_BUFFER_BYTES / 4, 2, 16);
+    AudioStream stream;
+    TEST_CHECK(stream.Open(wave.path) == false);
+
+    //As is a file that is smaller than the minimum size
+    TestWave longWave = WriteWave("AudioStreamTests_Minimum.wav", 3 * AUDIO_STREAM_BUFFER_BYTES / 2, 2, 16);
+    AudioStream minimumStream;
+    TEST_CHECK(minimumStream.Open(longWave.path, (unsigned int)longWave.data.size() + 1) == false);
+
+    remove(wave.path.c_str());
+    remove(longWave.path.c_str());
+}
+
+int main()
+{
+    //Both files are several times the size of the stream's three buffers
+    TestWave stereo = WriteWave("AudioStreamTests_Stereo16.wav", 200000, 2, 16);
+    TestWave mono = WriteWave("AudioStreamTests_Mono8.wav", 450000, 1, 8);
+
+    const TestCase cases[] =
+    {
+        { "linear 1.0, to the end", AudioResampler_Linear, 1.0f, false, 0, 0, 1.1 },
+        { "linear 1.0, from frame 1000, looping", AudioResampler_Linear, 1.0f, true, 1000, 0, 2.2 },
+        { "linear 1.37, looping", AudioResampler_Linear, 1.37f, true, 0, 0, 1.6 },
+        { "sinc 1.37, looping", AudioResampler_Sinc, 1.37f, true, 0, 0, 1.6 },
+        { "sinc 0.8, looping, seek to frame 70001", AudioResampler_Sinc, 0.8f, true, 5000, 70001, 1.5 },
+        { "linear 1.0, seek to frame 150000", AudioResampler_Linear, 1.0f, false, 0, 150000, 0.8 },
+    };
+
+    printf("16-bit stereo, %u frames\n", stereo.frameCount);
+    for (unsigned int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        TestStreaming(stereo, cases[i]);
+    }
+
+    printf("\n8-bit mono, %u frames\n", mono.frameCount);
+    for (unsigned int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        TestStreaming(mono, cases[i]);
+    }
+
+    TestRejectsShortFiles();
+
+    remove(stereo.path.c_str());
+    remove(mono.path.c_str());
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All AudioStream tests passed" : "AudioStream tests FAILED");
+    return Tests::Failures();
+}
+
+//Wave.cpp loads files through xaudio2.h, the stream only needs the format tag of a PCM file
+namespace GameDev2D
+{
+    unsigned short Wave::GetFormatTag(const unsigned char* aFormat, unsigned int aFormatSize)
+    {
+        unsigned short formatTag = 0;
+        memcpy(&formatTag, aFormat, sizeof(formatTag));
+        return formatTag;
+    }
+}
@@ -0,0 +1,241 @@
+//Tests the Camera's cached view and view-projection matrices against the matrices they're cached from: the view matrix
+//has to match GetTransformMatrix().GetInverse() (with the shake offset added to its translation) and the view-projection
+//matrix has to be the projection matrix times the view matrix. They're checked after the Camera is moved, rotated and
+//scaled, every frame while it shakes (and is moved during the shake), after its viewport is set, resized and its depth
+//clip is changed, and for a copy of the Camera pushed onto the Graphics' camera stack. A matrix is only recalculated when
+//something it depends on changed, asking for it again has to return the cached matrix.
+//
+//Windows only, the Camera adds itself as a listener to the Application, which needs Windows.h and OpenGL. The real
+//Application is created, its GameLoop isn't run, the update and resize events are dispatched by the test. It's built the
+//same way as CullingScene.cpp.
+//
+//Sources: every .cpp file under Source/Framework and Source/Libraries (the game's sources, less Source/WinMain.cpp and
+//         Source/Game.cpp)
+//
+//    cl /nologo /EHsc /O2 /std:c++14 /DNDEBUG /I Source\Framework\Windows /FI stdafx.h Tests\CameraTests.cpp <sources>
+//       opengl32.lib user32.lib gdi32.lib /Fe:CameraTests.exe /link /SUBSYSTEM:CONSOLE
+
+#include "Support/TestHarness.h"
+#include <random>
+#include <string.h>
+
+using namespace GameDev2D;
+
+
+//The view matrix is inverted analytically, the reference with the 4x4 cofactor inverse, they're compared relative to the
+//largest element. A translation near zero is the difference of large products, its error is relative to them, not to it
+const float TEST_MATRIX_TOLERANCE = 2.0e-5f;
+
+//Returns true if two matrices are equal, within the tolerance
+static bool AreEqual(const Matrix& aMatrix, const Matrix& aOther)
+{
+    float scale = 1.0f;
+    for (unsigned int i = 0; i < MATRIX_NUM_COLUMNS; i++)
+    {
+        for (unsigned int j = 0; j < MATRIX_NUM_ROWS; j++)
+        {
+            scale = fmaxf(scale, fmaxf(fabsf(aMatrix.m[i][j]), fabsf(aOther.m[i][j])));
+        }
+    }
+
+    for (unsigned int i = 0; i < MATRIX_NUM_COLUMNS; i++)
+    {
+        for (unsigned int j = 0; j < MATRIX_NUM_ROWS; j++)
+        {
+            if (fabsf(aMatrix.m[i][j] - aOther.m[i][j]) > TEST_MATRIX_TOLERANCE * scale)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//Returns true if two matrices are the same, bit for bit
+static bool AreIdentical(const Matrix& aMatrix, const Matrix& aOther)
+{
+    return memcmp(aMatrix.m, aOther.m, sizeof(aMatrix.m)) == 0;
+}
+
+//Returns the view matrix the Camera should have: the inverse of its transform, moved by the shake offset
+static Matrix GetReferenceViewMatrix(Camera& aCamera, Vector2 aShakeOffset)
+{
+    Matrix view = aCamera.GetTransformMatrix().GetInverse();
+    view.SetTranslation(view.GetTranslation() + aShakeOffset);
+    return view;
+}
+
+//Returns the projection matrix the Camera should have for its viewport and depth clip
+static Matrix GetReferenceProjectionMatrix(Camera& aCamera)
+{
+    float width = (float)aCamera.GetViewport().width;
+    float height = (float)aCamera.GetViewport().height;
+    return Matrix::Orthographic(-width / 2.0f, width / 2.0f, -height / 2.0f, height / 2.0f, aCamera.GetNearClip(), aCamera.GetFarClip());
+}
+
+//Returns true if the Camera's matrices match the references, AND asking for them again doesn't recalculate them
+static bool AreMatricesCorrect(Camera& aCamera, Vector2 aShakeOffset)
+{
+    Matrix view = aCamera.GetViewMatrix();
+    Matrix viewProjection = aCamera.GetViewProjectionMatrix();
+    Matrix projection = aCamera.GetProjectionMatrix();
+
+    unsigned int updates = Camera::GetViewMatrixUpdateCount();
+    bool isCached = AreIdentical(aCamera.GetViewMatrix(), view) == true && AreIdentical(aCamera.GetViewProjectionMatrix(), viewProjection) == true;
+    isCached = isCached && Camera::GetViewMatrixUpdateCount() == updates;
+
+    Matrix referenceView = GetReferenceViewMatrix(aCamera, aShakeOffset);
+    Matrix referenceProjection = GetReferenceProjectionMatrix(aCamera);
+    return isCached == true && AreEqual(view, referenceView) == true && AreIdentical(projection, referenceProjection) == true &&
+        AreIdentical(viewProjection, projection * view) == true && AreEqual(viewProjection, referenceProjection * referenceView) == true;
+}
+
+//Moves, rotates and scales the Camera, checking its matrices after every change
+static void TestMove(Camera& aCamera)
+{
+    std::mt19937 random(46);
+    std::uniform_real_distribution<float> position(-5000.0f, 5000.0f);
+    std::uniform_real_distribution<float> angle(-6.3f, 6.3f);
+    std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+
+    bool isCorrect = AreMatricesCorrect(aCamera, Vector2(0.0f, 0.0f));
+    bool isRecalculatedOnce = true;
+    for (unsigned int i = 0; i < 1000; i++)
+    {
+        switch (i % 6)
+        {
+        case 0: aCamera.SetPosition(position(random), position(random)); break;
+        case 1: aCamera.Translate(Vector2(position(random), position(random)) * 0.01f); break;
+        case 2: aCamera.SetRadians(angle(random)); break;
+        case 3: aCamera.SetScale(scale(random), scale(random)); break;
+        case 4: aCamera.SetDirection(Vector2(position(random), position(random))); break;
+        default: aCamera.SetPositionX(position(random)); aCamera.SetScaleY(scale(random)); break;
+        }
+
+        //A change recalculates the view matrix once, however many times it's asked for. The matrices are checked even
+        //after a failure, so that the recalculations are counted
+        unsigned int updates = Camera::GetViewMatrixUpdateCount();
+        isCorrect = AreMatricesCorrect(aCamera, Vector2(0.0f, 0.0f)) == true && isCorrect == true;
+        isRecalculatedOnce = isRecalculatedOnce && Camera::GetViewMatrixUpdateCount() == updates + 1;
+    }
+
+    TEST_CHECK(isCorrect == true);
+    TEST_CHECK(isRecalculatedOnce == true);
+}
+
+//Shakes the Camera for its duration, checking its matrices every frame, the Camera is moved every other frame
+static void TestShake(Application& aApplication, Camera& aCamera)
+{
+    const float magnitude = 24.0f;
+    const double duration = 0.5;
+    const double delta = 1.0 / 60.0;
+
+    aCamera.SetRadians(0.75f);
+    aCamera.SetScale(1.5f, 0.5f);
+    aCamera.Shake(magnitude, duration);
+    TEST_CHECK(AreMatricesCorrect(aCamera, Vector2(0.0f, 0.0f)) == true);
+
+    bool isCorrect = true;
+    bool isOffsetInRange = true;
+    bool isOffsetNew = true;
+    Vector2 previousOffset(0.0f, 0.0f);
+    double elapsed = 0.0;
+    while (elapsed + delta < duration)
+    {
+        UpdateEvent updateEvent(delta);
+        aApplication.DispatchEvent(updateEvent);
+        elapsed += delta;
+
+        //The shake offset is random, it's the difference between the cached view matrix's translation and the reference's
+        Matrix view = aCamera.GetViewMatrix();
+        Vector2 offset = view.GetTranslation() - aCamera.GetTransformMatrix().GetInverse().GetTranslation();
+        float progress = (float)(elapsed / duration);
+        float limit = magnitude * (1.0f - progress * progress) + 0.01f;
+        isOffsetInRange = isOffsetInRange && fabsf(offset.x) <= limit && fabsf(offset.y) <= limit;
+        isOffsetNew = isOffsetNew && (offset.x != previousOffset.x || offset.y != previousOffset.y);
+        isCorrect = AreMatricesCorrect(aCamera, offset) == true && isCorrect == true;
+
+        //Moving the Camera during the shake keeps the frame's offset
+        if ((unsigned int)(elapsed / delta + 0.5) % 2 == 0)
+        {
+            aCamera.Translate(Vector2(3.0f, -2.0f));
+            isCorrect = AreMatricesCorrect(aCamera, offset) == true && isCorrect == true;
+        }
+        previousOffset = offset;
+    }
+
+    TEST_CHECK(isCorrect == true);
+    TEST_CHECK(isOffsetInRange == true);
+    TEST_CHECK(isOffsetNew == true);
+
+    //Once the shake ends, the offset is gone
+    UpdateEvent lastUpdateEvent(duration);
+    aApplication.DispatchEvent(lastUpdateEvent);
+    TEST_CHECK(AreMatricesCorrect(aCamera, Vector2(0.0f, 0.0f)) == true);
+
+    //Without a shake, an update doesn't recalculate the view matrix
+    unsigned int updates = Camera::GetViewMatrixUpdateCount();
+    UpdateEvent updateEvent(delta);
+    aApplication.DispatchEvent(updateEvent);
+    TEST_CHECK(AreMatricesCorrect(aCamera, Vector2(0.0f, 0.0f)) == true && Camera::GetViewMatrixUpdateCount() == updates);
+}
+
+//Sets the Camera's viewport, resizes the window and changes the depth clip, checking the matrices after each
+static void TestViewport(Application& aApplication, Camera& aCamera, Camera& aFixedCamera)
+{
+    aCamera.SetRadians(0.3f);
+    aCamera.SetViewport(Viewport(100, 50, 640, 480));
+    TEST_CHECK(aCamera.GetPosition() == Vector2(420.0f, 290.0f));
+    TEST_CHECK(AreMatricesCorrect(aCamera, Vector2(0.0f, 0.0f)) == true);
+
+    //A resizeable Camera follows the window's size, the fixed Camera keeps its viewport and matrices
+    Matrix fixedView = aFixedCamera.GetViewMatrix();
+    Matrix fixedViewProjection = aFixedCamera.GetViewProjectionMatrix();
+    ResizeEvent resizeEvent(Vector2(1024.0f, 768.0f));
+    aApplication.DispatchEvent(resizeEvent);
+    TEST_CHECK(aCamera.GetViewport().width == 1024 && aCamera.GetViewport().height == 768);
+    TEST_CHECK(AreMatricesCorrect(aCamera, Vector2(0.0f, 0.0f)) == true);
+    TEST_CHECK(aFixedCamera.GetViewport().width == 320 && aFixedCamera.GetViewport().height == 200);
+    TEST_CHECK(AreMatricesCorrect(aFixedCamera, Vector2(0.0f, 0.0f)) == true);
+    TEST_CHECK(AreIdentical(aFixedCamera.GetViewMatrix(), fixedView) == true && AreIdentical(aFixedCamera.GetViewProjectionMatrix(), fixedViewProjection) == true);
+
+    //The depth clip only changes the projection, the view matrix isn't recalculated
+    unsigned int updates = Camera::GetViewMatrixUpdateCount();
+    aCamera.SetDepthClip(-10.0f, 10.0f);
+    TEST_CHECK(AreMatricesCorrect(aCamera, Vector2(0.0f, 0.0f)) == true && Camera::GetViewMatrixUpdateCount() == updates);
+}
+
+//The Graphics' camera stack holds copies, a copy starts with the original's matrices and is cached on its own
+static void TestCameraStack(Graphics* aGraphics, Camera& aCamera)
+{
+    aCamera.SetPosition(123.0f, -45.0f);
+    Matrix view = aCamera.GetViewMatrix();
+
+    aGraphics->PushCamera(aCamera);
+    Camera* copy = aGraphics->GetActiveCamera();
+    TEST_CHECK(AreIdentical(copy->GetViewMatrix(), view) == true && AreMatricesCorrect(*copy, Vector2(0.0f, 0.0f)) == true);
+    TEST_CHECK(AreIdentical(aGraphics->GetViewProjectionMatrix(), copy->GetViewProjectionMatrix()) == true);
+
+    copy->SetRadians(-1.25f);
+    TEST_CHECK(AreMatricesCorrect(*copy, Vector2(0.0f, 0.0f)) == true);
+    TEST_CHECK(AreIdentical(aGraphics->GetViewMatrix(), copy->GetViewMatrix()) == true);
+    TEST_CHECK(AreIdentical(aCamera.GetViewMatrix(), view) == true && AreMatricesCorrect(aCamera, Vector2(0.0f, 0.0f)) == true);
+    aGraphics->PopCamera();
+}
+
+int main()
+{
+    Application application(WINDOW_TITLE, TARGET_FPS, WINDOW_WIDTH, WINDOW_HEIGHT, false);
+    application.Init([]() {}, []() {}, [](double) {}, []() {});
+
+    Camera camera(Viewport(WINDOW_WIDTH, WINDOW_HEIGHT));
+    Camera fixedCamera(Viewport(320, 200), false);
+
+    TestMove(camera);
+    TestShake(application, camera);
+    TestViewport(application, camera, fixedCamera);
+    TestCameraStack(Services::GetGraphics(), camera);
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All Camera tests passed" : "Camera tests FAILED");
+    return Tests::Failures();
+}
@@ -0,0 +1,282 @@
+//A headless scene of 10000 Polygons, about 10% of them in the Camera's view: rectangles, circles, and polygons whose
+//vertices are left of and below their origin. The frame's Draw() calls are timed with culling enabled and disabled,
+//and the number of Polygons culled and drawn is printed. The culling is checked as well: under random Cameras, a
+//Polygon with a vertex drawn inside the Camera's view can't be culled, and every drawn vertex has to be inside the
+//Polygon's edges. A Polygon whose vertices are left of its origin, drawn on screen while its origin is off screen, is
+//checked on its own, its edges used to start at its origin so it was culled.
+//
+//Windows only, the Application, Graphics and Polygon need Windows.h and OpenGL. The real Application is created, for
+//its window, OpenGL context and services, but its GameLoop isn't run and nothing is presented. It's built with the game's
+//stdafx.h instead of Support/Prelude.h, and it has to be run from the repository root, the shaders are under Assets/.
+//
+//Sources: every .cpp file under Source/Framework and Source/Libraries (the game's sources, less Source/WinMain.cpp and
+//         Source/Game.cpp)
+//
+//    cl /nologo /EHsc /O2 /std:c++14 /DNDEBUG /I Source\Framework\Windows /FI stdafx.h Tests\CullingScene.cpp <sources>
+//       opengl32.lib user32.lib gdi32.lib /Fe:CullingScene.exe /link /SUBSYSTEM:CONSOLE
+
+#include "Support/TestHarness.h"
+#include <random>
+
+using namespace GameDev2D;
+
+
+//A Polygon and a copy of its vertices, the Polygon doesn't return them
+struct ScenePolygon
+{
+    Polygon* polygon;
+    std::vector<Vector2> vertices;
+};
+
+static void AddVertex(ScenePolygon& aScenePolygon, Vector2 aVertex)
+{
+    aScenePolygon.polygon->AddVertex(aVertex);
+    aScenePolygon.vertices.push_back(aVertex);
+}
+
+//Returns where the Polygon's vertex is drawn, in world space, it's the same math as the passThrough vertex shader's
+static Vector2 GetDrawnVertex(ScenePolygon& aScenePolygon, unsigned int aIndex)
+{
+    Polygon* polygon = aScenePolygon.polygon;
+    Vector2 anchor = polygon->GetAnchor();
+    Vector2 offset(polygon->GetWidth() * anchor.x, polygon->GetHeight() * anchor.y);
+    return polygon->GetTransformMatrix() * (aScenePolygon.vertices.at(aIndex) - offset);
+}
+
+static std::vector<ScenePolygon> CreateScene(unsigned int aCount)
+{
+    std::mt19937 random(aCount);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> world(-20000.0f, 20000.0f);
+    std::uniform_real_distribution<float> angle(-6.3f, 6.3f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    std::uniform_real_distribution<float> size(8.0f, 64.0f);
+    std::uniform_real_distribution<float> vertex(-64.0f, 16.0f);
+
+    std::vector<ScenePolygon> scene(aCount);
+    for (unsigned int i = 0; i < aCount; i++)
+    {
+        ScenePolygon& scenePolygon = scene.at(i);
+        scenePolygon.polygon = new Polygon();
+
+        //A third are rectangles, a third are circles and a third have vertices left of and below their origin
+        if (i % 3 == 0)
+        {
+            float width = size(random);
+            float height = size(random);
+            scenePolygon.polygon->SetRenderMode(RenderMode_TriangleFan);
+            AddVertex(scenePolygon, Vector2(0.0f, 0.0f));
+            AddVertex(scenePolygon, Vector2(width, 0.0f));
+            AddVertex(scenePolygon, Vector2(width, height));
+            AddVertex(scenePolygon, Vector2(0.0f, height));
+        }
+        else if (i % 3 == 1)
+        {
+            float radius = size(random) * 0.5f;
+            scenePolygon.polygon->SetRenderMode(RenderMode_LineLoop);
+            for (unsigned int j = 0; j < 36; j++)
+            {
+                float radians = (float)M_PI * 2.0f * (float)j / 36.0f;
+                AddVertex(scenePolygon, Vector2(radius - cosf(radians) * radius, radius - sinf(radians) * radius));
+            }
+        }
+        else
+        {
+            scenePolygon.polygon->SetRenderMode(RenderMode_LineLoop);
+            for (unsigned int j = 0; j < 3 + i % 6; j++)
+            {
+                AddVertex(scenePolygon, Vector2(vertex(random), vertex(random)));
+            }
+        }
+
+        //One in ten is in the window, the rest are spread over the world
+        if (i % 10 == 0)
+        {
+            scenePolygon.polygon->SetPosition(unit(random) * WINDOW_WIDTH, unit(random) * WINDOW_HEIGHT);
+        }
+        else
+        {
+            scenePolygon.polygon->SetPosition(world(random), world(random));
+        }
+
+        scenePolygon.polygon->SetRadians(angle(random));
+        scenePolygon.polygon->SetScale(scale(random), scale(random));
+        scenePolygon.polygon->SetAnchor(unit(random), unit(random));
+    }
+
+    return scene;
+}
+
+static void DeleteScene(std::vector<ScenePolygon>& aScene)
+{
+    for (unsigned int i = 0; i < aScene.size(); i++)
+    {
+        delete aScene.at(i).polygon;
+    }
+    aScene.clear();
+}
+
+static void ResetCamera(Camera* aCamera)
+{
+    aCamera->SetViewport(Viewport(WINDOW_WIDTH, WINDOW_HEIGHT));
+    aCamera->SetRadians(0.0f);
+    aCamera->SetScale(1.0f, 1.0f);
+}
+
+//Every vertex has to be drawn inside the Polygon's edges, less some rounding
+static void CheckEdges(std::vector<ScenePolygon>& aScene)
+{
+    unsigned int outside = 0;
+    for (unsigned int i = 0; i < aScene.size(); i++)
+    {
+        ScenePolygon& scenePolygon = aScene.at(i);
+        Polygon* polygon = scenePolygon.polygon;
+        for (unsigned int j = 0; j < scenePolygon.vertices.size(); j++)
+        {
+            Vector2 drawn = GetDrawnVertex(scenePolygon, j);
+            float tolerance = 0.01f + 1e-5f * fmaxf(fabsf(drawn.x), fabsf(drawn.y));
+            if (drawn.x < polygon->GetLeftEdge() - tolerance || drawn.x > polygon->GetRightEdge() + tolerance ||
+                drawn.y < polygon->GetBottomEdge() - tolerance || drawn.y > polygon->GetTopEdge() + tolerance)
+            {
+                outside++;
+            }
+        }
+    }
+
+    TEST_CHECK(outside == 0);
+    printf("Vertices drawn outside their Polygon's edges: %u\n", outside);
+}
+
+//Under random Cameras, a Polygon with a vertex drawn inside the Camera's view can't be culled
+static void CheckCulling(std::vector<ScenePolygon>& aScene, Graphics* aGraphics)
+{
+    std::mt19937 random(20);
+    std::uniform_real_distribution<float> position(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> angle(-6.3f, 6.3f);
+    std::uniform_real_distribution<float> zoom(0.25f, 4.0f);
+
+    Camera* camera = aGraphics->GetActiveCamera();
+    unsigned int wronglyCulled = 0;
+    unsigned int visible = 0;
+    for (unsigned int i = 0; i < 20; i++)
+    {
+        camera->SetPosition(position(random), position(random));
+        camera->SetRadians(angle(random));
+        float scale = zoom(random);
+        camera->SetScale(scale, scale);
+
+        const Rect& visibleRect = camera->GetVisibleRect();
+        for (unsigned int j = 0; j < aScene.size(); j++)
+        {
+            ScenePolygon& scenePolygon = aScene.at(j);
+            bool isVertexVisible = false;
+            for (unsigned int k = 0; k < scenePolygon.vertices.size() && isVertexVisible == false; k++)
+            {
+                Vector2 drawn = GetDrawnVertex(scenePolygon, k);
+                isVertexVisible = drawn.x > visibleRect.origin.x && drawn.x < visibleRect.origin.x + visibleRect.size.x &&
+                                  drawn.y > visibleRect.origin.y && drawn.y < visibleRect.origin.y + visibleRect.size.y;
+            }
+
+            if (isVertexVisible == true)
+            {
+                visible++;
+                if (aGraphics->Cull(scenePolygon.polygon) == true)
+                {
+                    wronglyCulled++;
+                }
+            }
+        }
+    }
+
+    ResetCamera(camera);
+
+    TEST_CHECK(visible > 0);
+    TEST_CHECK(wronglyCulled == 0);
+    printf("Polygons with a vertex in view, under 20 random Cameras: %u, culled: %u\n", visible, wronglyCulled);
+}
+
+//The Polygon's vertices are left of its origin, its origin is off screen but it's drawn from x 1100 to 1150
+static void CheckVerticesLeftOfOrigin(Graphics* aGraphics)
+{
+    ResetCamera(aGraphics->GetActiveCamera());
+
+    ScenePolygon scenePolygon;
+    scenePolygon.polygon = new Polygon();
+    scenePolygon.polygon->SetRenderMode(RenderMode_TriangleFan);
+    AddVertex(scenePolygon, Vector2(-300.0f, 0.0f));
+    AddVertex(scenePolygon, Vector2(-250.0f, 0.0f));
+    AddVertex(scenePolygon, Vector2(-250.0f, 50.0f));
+    AddVertex(scenePolygon, Vector2(-300.0f, 50.0f));
+    scenePolygon.polygon->SetPosition(1400.0f, 400.0f);
+
+    TEST_CHECK(scenePolygon.polygon->GetLeftEdge() <= GetDrawnVertex(scenePolygon, 0).x + 0.01f);
+    TEST_CHECK(scenePolygon.polygon->GetRightEdge() >= GetDrawnVertex(scenePolygon, 1).x - 0.01f);
+    TEST_CHECK(aGraphics->Cull(scenePolygon.polygon) == false);
+
+    delete scenePolygon.polygon;
+}
+
+//Returns the average milliseconds it takes to draw the scene, the GPU's work is included
+static double DrawScene(std::vector<ScenePolygon>& aScene, Graphics* aGraphics, bool aIsCullingEnabled, unsigned int aFrames)
+{
+    aGraphics->SetCullingEnabled(aIsCullingEnabled);
+
+    Tests::Timer timer;
+    for (unsigned int i = 0; i < aFrames; i++)
+    {
+        aGraphics->BeginFrame();
+        aGraphics->Clear();
+        for (unsigned int j = 0; j < aScene.size(); j++)
+        {
+            aScene.at(j).polygon->Draw();
+        }
+        glFinish();
+    }
+    double milliseconds = timer.GetMilliseconds() / (double)aFrames;
+
+    //The culling stats are the previous frame's
+    aGraphics->BeginFrame();
+    return milliseconds;
+}
+
+int main()
+{
+    Application application(WINDOW_TITLE, TARGET_FPS, WINDOW_WIDTH, WINDOW_HEIGHT, false);
+    application.Init([]() {}, []() {}, [](double) {}, []() {});
+
+    Graphics* graphics = Services::GetGraphics();
+    bool isCullingEnabled = graphics->IsCullingEnabled();
+    ResetCamera(graphics->GetActiveCamera());
+
+    std::vector<ScenePolygon> scene = CreateScene(10000);
+
+    graphics->SetCullingEnabled(true);
+    CheckEdges(scene);
+    CheckCulling(scene, graphics);
+    CheckVerticesLeftOfOrigin(graphics);
+
+    //Draw a few frames first, so that the buffers and shaders are ready
+    const unsigned int frames = 100;
+    DrawScene(scene, graphics, true, 10);
+
+    printf("\nms per frame, %u Polygons\n", (unsigned int)scene.size());
+    printf("%8s | %9s | %9s | %9s\n", "culling", "ms", "culled", "drawn");
+    double culled = DrawScene(scene, graphics, true, frames);
+    printf("%8s | %9.3f | %9u | %9u\n", "on", culled, graphics->GetCulledCount(), graphics->GetDrawnCount());
+
+    //About 10% of the scene is in the window, the rest should be culled
+    TEST_CHECK(graphics->GetDrawnCount() >= scene.size() / 20 && graphics->GetDrawnCount() < scene.size() / 5);
+
+    double unculled = DrawScene(scene, graphics, false, frames);
+    printf("%8s | %9.3f | %9u | %9u\n", "off", unculled, graphics->GetCulledCount(), graphics->GetDrawnCount());
+    printf("Culling speedup: %.2fx\n", unculled / culled);
+
+    //Without culling, every Polygon is drawn
+    TEST_CHECK(graphics->GetCulledCount() == 0 && graphics->GetDrawnCount() == scene.size());
+
+    graphics->SetCullingEnabled(isCullingEnabled);
+    DeleteScene(scene);
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All CullingScene tests passed" : "CullingScene tests FAILED");
+    return Tests::Failures();
+}
@@ -0,0 +1,277 @@
+//Tests the batch Ease() against the easing functions: without approximation every curve has to match its easing function
+//bit for bit, through the SSE2 versions 4 values at a time and the scalar tails, in place OR not. The approximation tables
+//have to stay within their bounds of the exact curves: the Sinusoidal curves within 2.4e-7, the Elastic curves within
+//2.2e-5 and the Exponential curves within 2.9e-6, except in the tables' first and last intervals, where the Exponential
+//curves jump to 0 OR 1 and are within 9.8e-4. The values are every 256th float from 0.0 to 1.0, along with every float
+//around the ends, the middle and the Bounce curves' breakpoints. Then benchmarks each curve's easing function called
+//through a pointer for each value (the way the TweenManager used to) against Ease(), and the approximation tables.
+//
+//Build with -U__SSE2__ to test the scalar paths instead of the SSE2 versions.
+//
+//Sources: Source/Framework/Animation/Easing.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Animation/Easing.h"
+#include "../Source/Framework/Math/Simd.h"
+#include <math.h>
+#include <random>
+#include <string.h>
+
+using namespace GameDev2D;
+
+
+//The number of intervals in an approximation table, the Exponential curves' error is larger in the first and last ones
+const float TEST_TABLE_INTERVAL = 1.0f / 2048.0f;
+
+//The bounds on the approximation tables' errors
+const float TEST_SINUSOIDAL_BOUND = 2.4e-7f;
+const float TEST_ELASTIC_BOUND = 2.2e-5f;
+const float TEST_EXPONENTIAL_BOUND = 2.9e-6f;
+const float TEST_EXPONENTIAL_END_BOUND = 9.8e-4f;
+
+//The number of values each benchmark eases, and how many times
+const unsigned int TEST_BENCHMARK_VALUES = 4096;
+const unsigned int TEST_BENCHMARK_PASSES = 500;
+
+const char* const TEST_EASING_NAMES[EasingType_Count] =
+{
+    "Linear",
+    "Quadratic In", "Quadratic Out", "Quadratic InOut",
+    "Cubic In", "Cubic Out", "Cubic InOut",
+    "Quartic In", "Quartic Out", "Quartic InOut",
+    "Quintic In", "Quintic Out", "Quintic InOut",
+    "Sinusoidal In", "Sinusoidal Out", "Sinusoidal InOut",
+    "Exponential In", "Exponential Out", "Exponential InOut",
+    "Circular In", "Circular Out", "Circular InOut",
+    "Elastic In", "Elastic Out", "Elastic InOut",
+    "Back In", "Back Out", "Back InOut",
+    "Bounce In", "Bounce Out", "Bounce InOut"
+};
+
+static float FromBits(uint32_t aBits)
+{
+    float value;
+    memcpy(&value, &aBits, sizeof(value));
+    return value;
+}
+
+static uint32_t ToBits(float aValue)
+{
+    uint32_t bits;
+    memcpy(&bits, &aValue, sizeof(bits));
+    return bits;
+}
+
+//Adds every float within 256 floats of a value, that is between 0.0 and 1.0
+static void AddNeighbours(std::vector<float>& aValues, float aValue)
+{
+    uint32_t bits = ToBits(aValue);
+    for (uint32_t i = bits > 256 ? bits - 256 : 0; i <= bits + 256; i++)
+    {
+        if (FromBits(i) <= 1.0f)
+        {
+            aValues.push_back(FromBits(i));
+        }
+    }
+}
+
+//Returns the values the curves are checked at
+static std::vector<float> GetValues()
+{
+    std::vector<float> values;
+    for (uint32_t bits = 0; bits <= ToBits(1.0f); bits += 256)
+    {
+        values.push_back(FromBits(bits));
+    }
+
+    const float breakpoints[] = { 0.0f, 0.5f, 1.0f, 1.0f / 2.75f, 2.0f / 2.75f, 2.5f / 2.75f, 0.5f / 2.75f, 0.5f - 1.0f / 2.75f * 0.5f };
+    for (unsigned int i = 0; i < sizeof(breakpoints) / sizeof(breakpoints[0]); i++)
+    {
+        AddNeighbours(values, breakpoints[i]);
+    }
+    return values;
+}
+
+//Returns true if the easing function and Ease() give the same bits for every value
+static bool IsBitIdentical(EasingType aType, const std::vector<float>& aValues)
+{
+    EasingFunction easingFunction = GetEasingFunction(aType);
+    std::vector<float> expected(aValues.size());
+    for (size_t i = 0; i < aValues.size(); i++)
+    {
+        expected[i] = easingFunction(aValues[i]);
+    }
+
+    std::vector<float> results(aValues.size());
+    Ease(aType, aValues.data(), results.data(), static_cast<unsigned int>(aValues.size()));
+    bool isIdentical = memcmp(results.data(), expected.data(), results.size() * sizeof(float)) == 0;
+
+    //Ease() in place
+    std::vector<float> inPlace(aValues);
+    Ease(aType, inPlace.data(), inPlace.data(), static_cast<unsigned int>(inPlace.size()));
+    isIdentical = isIdentical && memcmp(inPlace.data(), expected.data(), inPlace.size() * sizeof(float)) == 0;
+
+    //Short, unaligned runs, so that every tail length is eased by the scalar function after 0, 1 OR 2 SSE2 batches
+    for (unsigned int offset = 0; offset < 4; offset++)
+    {
+        for (unsigned int count = 0; count <= 11; count++)
+        {
+            float run[11];
+            Ease(aType, aValues.data() + 1000 + offset, run, count);
+            isIdentical = isIdentical && (count == 0 || memcmp(run, expected.data() + 1000 + offset, count * sizeof(float)) == 0);
+        }
+    }
+    return isIdentical;
+}
+
+static void TestExact()
+{
+    std::vector<float> values = GetValues();
+    printf("%u values from 0.0 to 1.0, %s\n", (unsigned int)values.size(), SIMD_SSE2 ? "SSE2" : "scalar");
+
+    for (unsigned int type = 0; type < EasingType_Count; type++)
+    {
+        if (IsBitIdentical(static_cast<EasingType>(type), values) == false)
+        {
+            printf("%s isn't bit identical\n", TEST_EASING_NAMES[type]);
+            TEST_CHECK(false);
+        }
+    }
+}
+
+//Checks an approximation table's error against its bounds, the end bound is for the table's first and last intervals
+static void CheckApproximation(EasingType aType, const std::vector<float>& aValues, float aBound, float aEndBound)
+{
+    EasingFunction easingFunction = GetEasingFunction(aType);
+    std::vector<float> results(aValues.size());
+    Ease(aType, aValues.data(), results.data(), static_cast<unsigned int>(aValues.size()), true);
+
+    float error = 0.0f;
+    float endError = 0.0f;
+    for (size_t i = 0; i < aValues.size(); i++)
+    {
+        float difference = fabsf(results[i] - easingFunction(aValues[i]));
+        bool isEnd = aValues[i] < TEST_TABLE_INTERVAL || aValues[i] > 1.0f - TEST_TABLE_INTERVAL;
+        if (isEnd == true)
+        {
+            endError = std::max(endError, difference);
+        }
+        else
+        {
+            error = std::max(error, difference);
+        }
+    }
+
+    printf("%-18s | %10.3g %10.3g | %10.3g %10.3g\n", TEST_EASING_NAMES[aType], error, endError, aBound, aEndBound);
+    TEST_CHECK(error <= aBound);
+    TEST_CHECK(endError <= aEndBound);
+
+    //The table's samples are the exact curve, and values outside 0.0 - 1.0 are clamped
+    const float samples[] = { 0.0f, TEST_TABLE_INTERVAL, 0.25f, 0.5f, 1.0f - TEST_TABLE_INTERVAL, 1.0f };
+    const unsigned int count = sizeof(samples) / sizeof(samples[0]);
+    float sampled[count];
+    Ease(aType, samples, sampled, count, true);
+    bool isExact = true;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        isExact = isExact && sampled[i] == easingFunction(samples[i]);
+    }
+    TEST_CHECK(isExact == true);
+
+    const float outside[] = { -0.5f, -1.0e-6f, 1.0f + 1.0e-6f, 2.0f };
+    float clamped[4];
+    Ease(aType, outside, clamped, 4, true);
+    TEST_CHECK(clamped[0] == easingFunction(0.0f) && clamped[1] == easingFunction(0.0f));
+    TEST_CHECK(clamped[2] == easingFunction(1.0f) && clamped[3] == easingFunction(1.0f));
+}
+
+static void TestApproximate()
+{
+    std::vector<float> values = GetValues();
+
+    printf("\n%-18s | %10s %10s | %10s %10s\n", "approximation", "max error", "at ends", "bound", "at ends");
+    for (unsigned int type = EasingType_SinusoidalIn; type <= EasingType_SinusoidalInOut; type++)
+    {
+        CheckApproximation(static_cast<EasingType>(type), values, TEST_SINUSOIDAL_BOUND, TEST_SINUSOIDAL_BOUND);
+    }
+    for (unsigned int type = EasingType_ExponentialIn; type <= EasingType_ExponentialInOut; type++)
+    {
+        CheckApproximation(static_cast<EasingType>(type), values, TEST_EXPONENTIAL_BOUND, TEST_EXPONENTIAL_END_BOUND);
+    }
+    for (unsigned int type = EasingType_ElasticIn; type <= EasingType_ElasticInOut; type++)
+    {
+        CheckApproximation(static_cast<EasingType>(type), values, TEST_ELASTIC_BOUND, TEST_ELASTIC_BOUND);
+    }
+
+    //The curves without a table are eased exactly, even when they're asked to be approximated
+    bool isExact = true;
+    for (unsigned int type = 0; type < EasingType_Count; type++)
+    {
+        std::vector<float> exact(values.size());
+        std::vector<float> approximate(values.size());
+        Ease(static_cast<EasingType>(type), values.data(), exact.data(), static_cast<unsigned int>(values.size()));
+        Ease(static_cast<EasingType>(type), values.data(), approximate.data(), static_cast<unsigned int>(values.size()), true);
+        bool hasTable = (type >= EasingType_SinusoidalIn && type <= EasingType_ExponentialInOut) || (type >= EasingType_ElasticIn && type <= EasingType_ElasticInOut);
+        isExact = isExact && (hasTable == true || memcmp(exact.data(), approximate.data(), exact.size() * sizeof(float)) == 0);
+    }
+    TEST_CHECK(isExact == true);
+}
+
+//Returns the ns it takes to ease a value, through the easing function pointer, Ease() OR Ease() approximated
+static double TimeScalar(EasingType aType, const std::vector<float>& aValues, std::vector<float>& aResults)
+{
+    EasingFunction easingFunction = GetEasingFunction(aType);
+    Tests::Timer timer;
+    for (unsigned int pass = 0; pass < TEST_BENCHMARK_PASSES; pass++)
+    {
+        for (size_t i = 0; i < aValues.size(); i++)
+        {
+            aResults[i] = easingFunction(aValues[i]);
+        }
+        Tests::KeepAlive(aResults[pass % aResults.size()]);
+    }
+    return timer.GetMilliseconds() * 1000000.0 / (TEST_BENCHMARK_PASSES * aValues.size());
+}
+
+static double TimeBatch(EasingType aType, const std::vector<float>& aValues, std::vector<float>& aResults, bool aApproximate)
+{
+    Tests::Timer timer;
+    for (unsigned int pass = 0; pass < TEST_BENCHMARK_PASSES; pass++)
+    {
+        Ease(aType, aValues.data(), aResults.data(), static_cast<unsigned int>(aValues.size()), aApproximate);
+        Tests::KeepAlive(aResults[pass % aResults.size()]);
+    }
+    return timer.GetMilliseconds() * 1000000.0 / (TEST_BENCHMARK_PASSES * aValues.size());
+}
+
+static void Benchmark()
+{
+    std::vector<float> values(TEST_BENCHMARK_VALUES);
+    std::vector<float> results(TEST_BENCHMARK_VALUES);
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for (unsigned int i = 0; i < values.size(); i++)
+    {
+        values[i] = distribution(random);
+    }
+
+    printf("\n%u values, ns per value | %8s %8s %12s\n", TEST_BENCHMARK_VALUES, "scalar", "Ease()", "approximate");
+    for (unsigned int type = 0; type < EasingType_Count; type++)
+    {
+        EasingType easingType = static_cast<EasingType>(type);
+        double scalar = TimeScalar(easingType, values, results);
+        double batch = TimeBatch(easingType, values, results, false);
+        double approximate = TimeBatch(easingType, values, results, true);
+        printf("%-26s | %8.2f %8.2f %12.2f\n", TEST_EASING_NAMES[type], scalar, batch, approximate);
+    }
+}
+
+int main()
+{
+    TestExact();
+    TestApproximate();
+    Benchmark();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All easing tests passed" : "Easing tests FAILED");
+    return Tests::Failures();
+}
@@ -0,0 +1,227 @@
+//Replays a recorded input stream through an EventDispatcher and checks that dispatching an event never allocates. The
+//recording is 10 seconds of a 1 kHz mouse: a movement every ms, a click every second, a wheel tick every 250 ms, along
+//with the UPDATE_EVENT of a 60 fps game. Every event code has 8 listeners, which read the event they're given. The events
+//are stack temporaries passed straight to DispatchEvent(), like the InputManager and the Mouse dispatch them.
+//
+//An event's log message is only built when Log::IsEnabled() for its verbosity, the message is a std::string so an event
+//whose verbosity is enabled can allocate. In a release build no verbosity is enabled and every event has to dispatch
+//without a single allocation, in a debug build (-DDEBUG=1) only the events that LOG_VERBOSITY_MASK lets through can.
+//
+//Sources: Source/Framework/Events/EventDispatcher.cpp Source/Framework/Events/Event.cpp
+//         Source/Framework/Events/EventHandler.cpp Source/Framework/Events/UpdateEvent.cpp
+//         Source/Framework/Events/MouseMovementEvent.cpp Source/Framework/Events/MouseButtonDownEvent.cpp
+//         Source/Framework/Events/MouseButtonUpEvent.cpp Source/Framework/Events/MouseScrollWheelEvent.cpp
+//         Tests/Support/AllocationCounter.cpp Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "Support/AllocationCounter.h"
+#include "../Source/Framework/Events/EventDispatcher.h"
+#include "../Source/Framework/Events/MouseButtonDownEvent.h"
+#include "../Source/Framework/Events/MouseButtonUpEvent.h"
+#include "../Source/Framework/Events/MouseMovementEvent.h"
+#include "../Source/Framework/Events/MouseScrollWheelEvent.h"
+#include "../Source/Framework/Events/UpdateEvent.h"
+#include <random>
+
+using namespace GameDev2D;
+
+
+//The number of listeners for each event code
+const unsigned int TEST_LISTENERS_PER_EVENT_CODE = 8;
+
+//A recorded input event, in the order it was received
+struct InputRecord
+{
+    unsigned int eventCode;
+    Vector2 position;
+    Vector2 delta;
+    float value;        //The wheel's delta, the button's duration OR the update's delta
+};
+
+//Reads the event it's given, the way a game's handler would
+class ReplayListener : public EventHandler
+{
+public:
+    ReplayListener() : sum(0.0f) {}
+
+    void HandleEvent(Event* aEvent)
+    {
+        switch (aEvent->GetEventCode())
+        {
+        case MOUSE_MOVEMENT_EVENT:
+            sum += static_cast<MouseMovementEvent*>(aEvent)->GetDeltaMovement().x;
+            break;
+        case MOUSE_BUTTON_DOWN_EVENT:
+            sum += static_cast<MouseButtonDownEvent*>(aEvent)->GetPosition().y;
+            break;
+        case MOUSE_BUTTON_UP_EVENT:
+            sum += (float)static_cast<MouseButtonUpEvent*>(aEvent)->GetDuration();
+            break;
+        case MOUSE_WHEEL_EVENT:
+            sum += static_cast<MouseScrollWheelEvent*>(aEvent)->GetDetla();
+            break;
+        case UPDATE_EVENT:
+            sum += (float)static_cast<UpdateEvent*>(aEvent)->GetDelta();
+            break;
+        }
+    }
+
+    float sum;
+};
+
+//Records 10 seconds of input, one ms at a time
+static std::vector<InputRecord> Record()
+{
+    std::vector<InputRecord> records;
+    std::mt19937 random(39);
+    std::uniform_real_distribution<float> jitter(-3.0f, 3.0f);
+    Vector2 position(640.0f, 360.0f);
+
+    for (unsigned int ms = 0; ms < 10000; ms++)
+    {
+        InputRecord movement = { MOUSE_MOVEMENT_EVENT, position, Vector2(jitter(random), jitter(random)), 0.0f };
+        position += movement.delta;
+        movement.position = position;
+        records.push_back(movement);
+
+        if (ms % 1000 == 500)
+        {
+            InputRecord down = { MOUSE_BUTTON_DOWN_EVENT, position, Vector2(0.0f, 0.0f), 0.0f };
+            records.push_back(down);
+        }
+        else if (ms % 1000 == 620)
+        {
+            InputRecord up = { MOUSE_BUTTON_UP_EVENT, position, Vector2(0.0f, 0.0f), 0.12f };
+            records.push_back(up);
+        }
+
+        if (ms % 250 == 125)
+        {
+            InputRecord wheel = { MOUSE_WHEEL_EVENT, position, Vector2(0.0f, 0.0f), ms % 500 == 125 ? 1.0f : -1.0f };
+            records.push_back(wheel);
+        }
+
+        if (ms * 60 / 1000 != (ms + 1) * 60 / 1000)
+        {
+            InputRecord update = { UPDATE_EVENT, position, Vector2(0.0f, 0.0f), 1.0f / 60.0f };
+            records.push_back(update);
+        }
+    }
+    return records;
+}
+
+//Dispatches a recorded event, the event is a temporary on the stack
+static void Dispatch(EventDispatcher& aDispatcher, const InputRecord& aRecord)
+{
+    switch (aRecord.eventCode)
+    {
+    case MOUSE_MOVEMENT_EVENT:
+    {
+        MouseMovementEvent event(aRecord.position, aRecord.position - aRecord.delta, aRecord.delta);
+        aDispatcher.DispatchEvent(event);
+        break;
+    }
+    case MOUSE_BUTTON_DOWN_EVENT:
+    {
+        MouseButtonDownEvent event(Mouse::Left, aRecord.position);
+        aDispatcher.DispatchEvent(event);
+        break;
+    }
+    case MOUSE_BUTTON_UP_EVENT:
+    {
+        MouseButtonUpEvent event(Mouse::Left, aRecord.value, aRecord.position);
+        aDispatcher.DispatchEvent(event);
+        break;
+    }
+    case MOUSE_WHEEL_EVENT:
+    {
+        MouseScrollWheelEvent event(aRecord.value);
+        aDispatcher.DispatchEvent(event);
+        break;
+    }
+    case UPDATE_EVENT:
+    {
+        UpdateEvent event(aRecord.value);
+        aDispatcher.DispatchEvent(event);
+        break;
+    }
+    }
+}
+
+static void TestReplay()
+{
+    std::vector<InputRecord> records = Record();
+    const unsigned int eventCodes[] = { MOUSE_MOVEMENT_EVENT, MOUSE_BUTTON_DOWN_EVENT, MOUSE_BUTTON_UP_EVENT, MOUSE_WHEEL_EVENT, UPDATE_EVENT };
+    const char* names[] = { "MouseMovementEvent", "MouseButtonDownEvent", "MouseButtonUpEvent", "MouseScrollWheelEvent", "UpdateEvent" };
+    const bool isLogged[] = { Log::IsEnabled(Log::Verbosity_Input_Mouse), Log::IsEnabled(Log::Verbosity_Input_Mouse), Log::IsEnabled(Log::Verbosity_Input_Mouse),
+                              Log::IsEnabled(Log::Verbosity_Input_Mouse), false };
+    const unsigned int eventCodeCount = sizeof(eventCodes) / sizeof(eventCodes[0]);
+
+    EventDispatcher dispatcher;
+    std::vector<ReplayListener> listeners(TEST_LISTENERS_PER_EVENT_CODE * eventCodeCount);
+    for (unsigned int i = 0; i < listeners.size(); i++)
+    {
+        dispatcher.AddEventListener(&listeners[i], eventCodes[i % eventCodeCount]);
+    }
+
+    //The replay starts with the dispatcher's first dispatch, it has to be free of allocations too
+    size_t dispatched[eventCodeCount] = {};
+    size_t allocations[eventCodeCount] = {};
+    Tests::Timer timer;
+    for (unsigned int i = 0; i < records.size(); i++)
+    {
+        unsigned int type = 0;
+        while (eventCodes[type] != records[i].eventCode)
+        {
+            type++;
+        }
+
+        Tests::AllocationCounter::ResetPeak();
+        Dispatch(dispatcher, records[i]);
+        allocations[type] += Tests::AllocationCounter::GetHeapAllocationCount();
+        dispatched[type]++;
+    }
+    double ms = timer.GetMilliseconds();
+
+    printf("%u recorded events, %u listeners per event code, %s build, malloc() %s\n", (unsigned int)records.size(), TEST_LISTENERS_PER_EVENT_CODE,
+        Log::IsEnabled(Log::Verbosity_All) == true ? "debug" : "release", Tests::AllocationCounter::IsMallocCounted() == true ? "counted" : "not counted");
+    printf("%-22s | %8s %12s %22s\n", "", "events", "allocations", "allocations per event");
+
+    size_t total = 0;
+    for (unsigned int i = 0; i < eventCodeCount; i++)
+    {
+        if (isLogged[i] == false)
+        {
+            TEST_CHECK(allocations[i] == 0);
+        }
+        total += allocations[i];
+        printf("%-22s | %8u %12u %22.3f%s\n", names[i], (unsigned int)dispatched[i], (unsigned int)allocations[i],
+            (double)allocations[i] / dispatched[i], isLogged[i] == true ? " (logged)" : "");
+    }
+
+    float sum = 0.0f;
+    for (unsigned int i = 0; i < listeners.size(); i++)
+    {
+        sum += listeners[i].sum;
+    }
+    Tests::KeepAlive(sum);
+    printf("%-22s | %8u %12u, replayed in %.2f ms (%.0f ns per event)\n", "total", (unsigned int)records.size(), (unsigned int)total, ms, ms * 1000000.0 / records.size());
+}
+
+int main()
+{
+    TestReplay();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All event allocation tests passed" : "Event allocation tests FAILED");
+    return Tests::Failures();
+}
+
+//Mouse.cpp dispatches its events as temporaries bound to an Event&, which only MSVC accepts. ButtonToString() is only
+//called by the mouse button events' log messages
+namespace GameDev2D
+{
+    std::string Mouse::ButtonToString(Mouse::Button aButton)
+    {
+        return aButton == Mouse::Left ? "Left" : (aButton == Mouse::Center ? "Center" : "Right");
+    }
+}
@@ -0,0 +1,247 @@
+//Benchmarks the EventDispatcher's buckets against the linear scan it replaced, with 10k listeners: 2% listen for UPDATE_EVENT,
+//1% for DRAW_EVENT and the rest are spread over the other event codes, one event code per listener. It measures a frame's
+//dispatches (UPDATE, DRAW and a MOUSE_MOVEMENT), adding the listeners, removing half of them, removing listeners with
+//RemoveAllHandlersForListener(), and removing 10k listeners of a single event code. Before each dispatch benchmark both
+//dispatchers are checked to call the same listeners, in the same order.
+//
+//Sources: Source/Framework/Events/EventDispatcher.cpp Source/Framework/Events/Event.cpp
+//         Source/Framework/Events/EventHandler.cpp Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Events/EventDispatcher.h"
+#include "../Source/Framework/Events/Event.h"
+#include <random>
+
+using namespace GameDev2D;
+
+
+//The number of listeners, and the event codes they're spread over
+const unsigned int TEST_LISTENERS = 10000;
+const unsigned int TEST_EVENT_CODES = GAMEPAD_RIGHT_THUMBSTICK_EVENT + 1;
+
+//The EventDispatcher before handlers were bucketed by event code: every (handler, event code) pair is in one vector, a
+//dispatch scans all of them and removing a handler erases it from the middle of the vector
+class LinearEventDispatcher
+{
+public:
+    void DispatchEvent(Event& aEvent)
+    {
+        for (unsigned int i = 0; i < m_HandlerEntries.size(); i++)
+        {
+            if (m_HandlerEntries.at(i).second == aEvent.GetEventCode())
+            {
+                m_HandlerEntries.at(i).first->HandleEvent(&aEvent);
+            }
+        }
+    }
+
+    void AddEventListener(EventHandler* aHandler, unsigned int aEventCode)
+    {
+        m_HandlerEntries.push_back(std::make_pair(aHandler, aEventCode));
+    }
+
+    void RemoveEventListener(EventHandler* aHandler, unsigned int aEventCode)
+    {
+        for (unsigned int i = 0; i < m_HandlerEntries.size(); i++)
+        {
+            if (m_HandlerEntries.at(i).second == aEventCode && m_HandlerEntries.at(i).first == aHandler)
+            {
+                m_HandlerEntries.erase(m_HandlerEntries.begin() + i);
+            }
+        }
+    }
+
+    void RemoveAllHandlersForListener(EventHandler* aHandler)
+    {
+        std::vector<std::pair<EventHandler*, unsigned int>>::iterator iter = m_HandlerEntries.begin();
+        while (iter != m_HandlerEntries.end())
+        {
+            if ((*iter).first == aHandler)
+            {
+                iter = m_HandlerEntries.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+private:
+    std::vector<std::pair<EventHandler*, unsigned int>> m_HandlerEntries;
+};
+
+//Records the listeners that were called, in the order they were called
+static std::vector<unsigned int>* s_Calls = nullptr;
+static unsigned int s_CallCount = 0;
+
+class BenchmarkListener : public EventHandler
+{
+public:
+    BenchmarkListener() : id(0), eventCode(0) {}
+
+    void HandleEvent(Event* aEvent)
+    {
+        s_CallCount++;
+        if (s_Calls != nullptr)
+        {
+            s_Calls->push_back(id);
+        }
+    }
+
+    unsigned int id;
+    unsigned int eventCode;
+};
+
+//Gives each listener its event code: 2% UPDATE, 1% DRAW, the rest spread over the other event codes
+static void AssignEventCodes(std::vector<BenchmarkListener>& aListeners)
+{
+    std::mt19937 random(37);
+    for (unsigned int i = 0; i < aListeners.size(); i++)
+    {
+        unsigned int roll = random() % 100;
+        unsigned int eventCode = roll < 2 ? UPDATE_EVENT : (roll < 3 ? DRAW_EVENT : random() % (TEST_EVENT_CODES - 2));
+        eventCode = roll >= 3 && eventCode >= UPDATE_EVENT ? eventCode + 2 : eventCode;
+        aListeners[i].id = i;
+        aListeners[i].eventCode = eventCode;
+    }
+}
+
+//Returns the listeners each dispatcher calls for the event code
+template<typename Dispatcher> static std::vector<unsigned int> GetCalls(Dispatcher& aDispatcher, unsigned int aEventCode)
+{
+    std::vector<unsigned int> calls;
+    s_Calls = &calls;
+    Event event(aEventCode);
+    aDispatcher.DispatchEvent(event);
+    s_Calls = nullptr;
+    return calls;
+}
+
+static void CheckSameCalls(EventDispatcher& aBucketed, LinearEventDispatcher& aLinear)
+{
+    bool isSame = true;
+    for (unsigned int eventCode = 0; eventCode < TEST_EVENT_CODES; eventCode++)
+    {
+        isSame = isSame && GetCalls(aBucketed, eventCode) == GetCalls(aLinear, eventCode);
+    }
+    TEST_CHECK(isSame == true);
+}
+
+//Returns the average us it takes to dispatch a frame's UPDATE, DRAW and MOUSE_MOVEMENT events
+template<typename Dispatcher> static double TimeFrames(Dispatcher& aDispatcher)
+{
+    const unsigned int frames = 2000;
+    Event update(UPDATE_EVENT);
+    Event draw(DRAW_EVENT);
+    Event mouse(MOUSE_MOVEMENT_EVENT);
+
+    Tests::Timer timer;
+    for (unsigned int i = 0; i < frames; i++)
+    {
+        aDispatcher.DispatchEvent(update);
+        aDispatcher.DispatchEvent(draw);
+        aDispatcher.DispatchEvent(mouse);
+    }
+    return timer.GetMilliseconds() * 1000.0 / frames;
+}
+
+//Runs the same benchmark on both dispatchers, each one gets its own listeners
+template<typename Dispatcher> struct Benchmark
+{
+    Benchmark() : listeners(TEST_LISTENERS) { AssignEventCodes(listeners); }
+
+    double Add()
+    {
+        Tests::Timer timer;
+        for (unsigned int i = 0; i < listeners.size(); i++)
+        {
+            dispatcher.AddEventListener(&listeners[i], listeners[i].eventCode);
+        }
+        return timer.GetMilliseconds();
+    }
+
+    //Removes every other listener, in a random order
+    double RemoveHalf()
+    {
+        std::vector<unsigned int> order;
+        for (unsigned int i = 0; i < listeners.size(); i += 2)
+        {
+            order.push_back(i);
+        }
+        std::shuffle(order.begin(), order.end(), std::mt19937(38));
+
+        Tests::Timer timer;
+        for (unsigned int i = 0; i < order.size(); i++)
+        {
+            dispatcher.RemoveEventListener(&listeners[order[i]], listeners[order[i]].eventCode);
+        }
+        return timer.GetMilliseconds();
+    }
+
+    //Removes a thousand of the listeners that are left, by listener instead of by event code
+    double RemoveListeners()
+    {
+        Tests::Timer timer;
+        for (unsigned int i = 1; i < 2000; i += 2)
+        {
+            dispatcher.RemoveAllHandlersForListener(&listeners[i]);
+        }
+        return timer.GetMilliseconds();
+    }
+
+    std::vector<BenchmarkListener> listeners;
+    Dispatcher dispatcher;
+};
+
+//Returns the ms it takes to add 10k listeners to one event code, then remove them in the order they were added
+template<typename Dispatcher> static double TimeSingleEventCode()
+{
+    std::vector<BenchmarkListener> listeners(TEST_LISTENERS);
+    Dispatcher dispatcher;
+    for (unsigned int i = 0; i < listeners.size(); i++)
+    {
+        dispatcher.AddEventListener(&listeners[i], UPDATE_EVENT);
+    }
+
+    Tests::Timer timer;
+    for (unsigned int i = 0; i < listeners.size(); i++)
+    {
+        dispatcher.RemoveEventListener(&listeners[i], UPDATE_EVENT);
+    }
+    return timer.GetMilliseconds();
+}
+
+int main()
+{
+    Benchmark<EventDispatcher> bucketed;
+    Benchmark<LinearEventDispatcher> linear;
+
+    printf("%u listeners, 2%% on UPDATE, 1%% on DRAW, the rest over %u other event codes\n\n", TEST_LISTENERS, TEST_EVENT_CODES - 2);
+    printf("%-36s | %10s %10s\n", "", "bucketed", "linear");
+
+    double bucketedAdd = bucketed.Add();
+    double linearAdd = linear.Add();
+    printf("%-36s | %7.2f ms %7.2f ms\n", "add 10k", bucketedAdd, linearAdd);
+
+    CheckSameCalls(bucketed.dispatcher, linear.dispatcher);
+    printf("%-36s | %7.2f us %7.2f us\n", "UPDATE + DRAW + MOUSE per frame", TimeFrames(bucketed.dispatcher), TimeFrames(linear.dispatcher));
+
+    double bucketedRemove = bucketed.RemoveHalf();
+    double linearRemove = linear.RemoveHalf();
+    printf("%-36s | %7.2f ms %7.2f ms\n", "remove 5k, random order", bucketedRemove, linearRemove);
+
+    CheckSameCalls(bucketed.dispatcher, linear.dispatcher);
+    printf("%-36s | %7.2f us %7.2f us\n", "UPDATE + DRAW + MOUSE per frame, 5k", TimeFrames(bucketed.dispatcher), TimeFrames(linear.dispatcher));
+
+    double bucketedRemoveAll = bucketed.RemoveListeners();
+    double linearRemoveAll = linear.RemoveListeners();
+    printf("%-36s | %7.2f ms %7.2f ms\n", "RemoveAllHandlersForListener x1000", bucketedRemoveAll, linearRemoveAll);
+    CheckSameCalls(bucketed.dispatcher, linear.dispatcher);
+
+    printf("%-36s | %7.2f ms %7.2f ms\n", "remove 10k of one event code", TimeSingleEventCode<EventDispatcher>(), TimeSingleEventCode<LinearEventDispatcher>());
+    Tests::KeepAlive(s_CallCount);
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All EventDispatcher benchmarks passed" : "EventDispatcher benchmarks FAILED");
+    return Tests::Failures();
+}
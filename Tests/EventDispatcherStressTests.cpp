@@ -0,0 +1,243 @@
+//Stress tests the EventDispatcher: listeners add, remove and re-add listeners (themselves included), remove every listener,
+//and dispatch events of their own while events are being dispatched. The calls are checked against a model of the rules in
+//EventDispatcher.h: a removed listener is never called again, a listener added while dispatching isn't called until the
+//outermost dispatch is done, every other listener is called exactly once per dispatch, in the order it was added.
+//
+//Sources: Source/Framework/Events/EventDispatcher.cpp Source/Framework/Events/Event.cpp
+//         Source/Framework/Events/EventHandler.cpp Tests/Support/Log.cpp
+//
+//Build without -DNDEBUG, the test calls ValidateHandlers() after every outermost dispatch and its asserts need to be enabled.
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Events/EventDispatcher.h"
+#include "../Source/Framework/Events/Event.h"
+#include <random>
+
+using namespace GameDev2D;
+
+
+//The number of listeners, event codes, and the deepest that dispatches are nested
+const unsigned int TEST_LISTENERS = 64;
+const unsigned int TEST_EVENT_CODES = 6;
+const unsigned int TEST_MAX_DEPTH = 3;
+
+class StressListener;
+
+//The model of which listeners are registered for which event codes, and the dispatches in progress
+struct Model
+{
+    struct Registration
+    {
+        Registration() : isRegistered(false), isDeferred(false), isRemoved(false), order(0), calls(0) {}
+
+        bool isRegistered;
+        bool isDeferred;        //Added while dispatching, not called until the outermost dispatch is done
+        bool isRemoved;         //Removed during the current outermost dispatch
+        unsigned int order;     //Handlers are called in the order they were added
+        unsigned int calls;     //The number of calls in the current outermost dispatch
+    };
+
+    Model() : order(0), depth(0), random(1729), calls(0) {}
+
+    Registration& Get(unsigned int aListener, unsigned int aEventCode) { return registrations[aListener][aEventCode]; }
+
+    void Add(unsigned int aListener, unsigned int aEventCode)
+    {
+        Registration& registration = Get(aListener, aEventCode);
+        if (registration.isRegistered == false)
+        {
+            registration.isRegistered = true;
+            registration.isDeferred = depth > 0;
+            registration.order = ++order;
+        }
+    }
+
+    void Remove(unsigned int aListener, unsigned int aEventCode)
+    {
+        Registration& registration = Get(aListener, aEventCode);
+        registration.isRemoved = registration.isRemoved == true || registration.isRegistered == true;
+        registration.isRegistered = false;
+    }
+
+    Registration registrations[TEST_LISTENERS][TEST_EVENT_CODES];
+    unsigned int order;
+    unsigned int depth;
+    std::vector<unsigned int> lastOrder;        //The order of the last listener called by each dispatch in progress
+    std::vector<unsigned int> eventCodes;       //The event code of each dispatch in progress
+    std::mt19937 random;
+    unsigned long long calls;
+};
+
+static EventDispatcher* s_Dispatcher = nullptr;
+static Model* s_Model = nullptr;
+static StressListener* s_Listeners[TEST_LISTENERS];
+
+static void Dispatch(unsigned int aEventCode);
+
+class StressListener : public EventHandler
+{
+public:
+    StressListener(unsigned int aIndex) : m_Index(aIndex) {}
+
+    void HandleEvent(Event* aEvent)
+    {
+        Model& model = *s_Model;
+        unsigned int eventCode = aEvent->GetEventCode();
+        Model::Registration& registration = model.Get(m_Index, eventCode);
+        model.calls++;
+
+        //Only a registered listener that wasn't added by this dispatch can be called, once, in the order it was added
+        TEST_CHECK(registration.isRegistered == true && registration.isDeferred == false);
+        TEST_CHECK(eventCode == model.eventCodes.back());
+        TEST_CHECK(registration.order > model.lastOrder.back());
+        model.lastOrder.back() = registration.order;
+        registration.calls++;
+
+        //Change the listeners
+        unsigned int changes = model.random() % 4;
+        for (unsigned int i = 0; i < changes; i++)
+        {
+            unsigned int listener = model.random() % TEST_LISTENERS;
+            unsigned int code = model.random() % TEST_EVENT_CODES;
+            unsigned int action = model.random() % 100;
+            if (action < 35)
+            {
+                if (model.Get(listener, code).isRegistered == false)
+                {
+                    s_Dispatcher->AddEventListener(s_Listeners[listener], code);
+                    model.Add(listener, code);
+                }
+            }
+            else if (action < 70)
+            {
+                s_Dispatcher->RemoveEventListener(s_Listeners[listener], code);
+                model.Remove(listener, code);
+            }
+            else if (action < 80)
+            {
+                //Remove and re-add itself, it moves to the end and isn't called again by this dispatch
+                s_Dispatcher->RemoveEventListener(this, eventCode);
+                model.Remove(m_Index, eventCode);
+                s_Dispatcher->AddEventListener(this, eventCode);
+                model.Add(m_Index, eventCode);
+            }
+            else if (action < 85)
+            {
+                s_Dispatcher->RemoveAllHandlersForListener(s_Listeners[listener]);
+                for (unsigned int j = 0; j < TEST_EVENT_CODES; j++)
+                {
+                    model.Remove(listener, j);
+                }
+            }
+            else if (action < 86)
+            {
+                s_Dispatcher->RemoveAllHandlers();
+                for (unsigned int j = 0; j < TEST_LISTENERS; j++)
+                {
+                    for (unsigned int k = 0; k < TEST_EVENT_CODES; k++)
+                    {
+                        model.Remove(j, k);
+                    }
+                }
+            }
+            else if (model.depth < TEST_MAX_DEPTH && std::find(model.eventCodes.begin(), model.eventCodes.end(), code) == model.eventCodes.end())
+            {
+                //Dispatch an event of another event code, one that isn't being dispatched already
+                Dispatch(code);
+            }
+        }
+    }
+
+private:
+    unsigned int m_Index;
+};
+
+static void Dispatch(unsigned int aEventCode)
+{
+    Model& model = *s_Model;
+
+    //The listeners that are registered when the outermost dispatch starts, and aren't removed, are called exactly once
+    bool wasRegistered[TEST_LISTENERS];
+    if (model.depth == 0)
+    {
+        for (unsigned int i = 0; i < TEST_LISTENERS; i++)
+        {
+            Model::Registration& registration = model.Get(i, aEventCode);
+            wasRegistered[i] = registration.isRegistered;
+            registration.calls = 0;
+            registration.isRemoved = false;
+        }
+    }
+
+    model.depth++;
+    model.eventCodes.push_back(aEventCode);
+    model.lastOrder.push_back(0);
+
+    Event event(aEventCode);
+    s_Dispatcher->DispatchEvent(event);
+
+    model.lastOrder.pop_back();
+    model.eventCodes.pop_back();
+    model.depth--;
+
+    if (model.depth == 0)
+    {
+        for (unsigned int i = 0; i < TEST_LISTENERS; i++)
+        {
+            for (unsigned int j = 0; j < TEST_EVENT_CODES; j++)
+            {
+                Model::Registration& registration = model.Get(i, j);
+                registration.isDeferred = false;
+                if (j == aEventCode && wasRegistered[i] == true && registration.isRemoved == false)
+                {
+                    TEST_CHECK(registration.calls == 1);
+                }
+            }
+        }
+        s_Dispatcher->ValidateHandlers();
+    }
+}
+
+static void TestStress()
+{
+    EventDispatcher dispatcher;
+    Model* model = new Model();
+    s_Dispatcher = &dispatcher;
+    s_Model = model;
+    for (unsigned int i = 0; i < TEST_LISTENERS; i++)
+    {
+        s_Listeners[i] = new StressListener(i);
+    }
+
+    for (unsigned int i = 0; i < 200000; i++)
+    {
+        //Keep the dispatcher populated, then dispatch a random event code
+        for (unsigned int j = 0; j < 4; j++)
+        {
+            unsigned int listener = model->random() % TEST_LISTENERS;
+            unsigned int code = model->random() % TEST_EVENT_CODES;
+            if (model->Get(listener, code).isRegistered == false)
+            {
+                dispatcher.AddEventListener(s_Listeners[listener], code);
+                model->Add(listener, code);
+            }
+        }
+        Dispatch(model->random() % TEST_EVENT_CODES);
+    }
+
+    printf("%llu listener calls checked\n", model->calls);
+
+    for (unsigned int i = 0; i < TEST_LISTENERS; i++)
+    {
+        delete s_Listeners[i];
+    }
+    delete model;
+}
+
+int main()
+{
+    TestStress();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All EventDispatcher stress tests passed" : "EventDispatcher stress tests FAILED");
+    return Tests::Failures();
+}
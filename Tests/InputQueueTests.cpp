@@ -0,0 +1,251 @@
+//Tests the InputQueue that the InputManager queues its input in between updates:
+//- only consecutive mouse movements (OR scroll wheel changes) are coalesced, the latest position is kept and the deltas
+//  are summed. Any other input in between starts a new event
+//- key and button transitions are never coalesced and are delivered in the order they were queued
+//- input queued while the queue is being delivered is delivered in the same batch, and never coalesced into an event that
+//  was already delivered
+//- the raw and delivered event counters
+//- a frame's worth of input doesn't allocate once the queue is reserved
+//Then replays 10 seconds of a 1 kHz mouse with keys, clicks and scrolls at 60 updates a second, and reports the number of
+//raw and delivered events.
+//
+//Sources: Source/Framework/Input/InputQueue.cpp Tests/Support/AllocationCounter.cpp Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "Support/AllocationCounter.h"
+#include "../Source/Framework/Input/InputQueue.h"
+#include <random>
+
+using namespace GameDev2D;
+
+
+//Delivers every queued event, in order
+static std::vector<InputQueue::InputRecord> Deliver(InputQueue& aQueue)
+{
+    std::vector<InputQueue::InputRecord> records;
+    InputQueue::InputRecord record;
+    while (aQueue.DeliverNext(record) == true)
+    {
+        records.push_back(record);
+    }
+    return records;
+}
+
+static void TestCoalescing()
+{
+    InputQueue queue(16);
+
+    //Consecutive movements are coalesced, the last position is kept and the deltas are summed
+    queue.Queue(InputQueue::MouseMovedInput, 0, 10.0f, 20.0f, 1.0f, 2.0f);
+    queue.Queue(InputQueue::MouseMovedInput, 0, 13.0f, 24.0f, 3.0f, 4.0f);
+    queue.Queue(InputQueue::MouseMovedInput, 0, 8.0f, 25.0f, -5.0f, 1.0f);
+    std::vector<InputQueue::InputRecord> records = Deliver(queue);
+    TEST_CHECK(records.size() == 1);
+    TEST_CHECK(records[0].type == InputQueue::MouseMovedInput && records[0].x == 8.0f && records[0].y == 25.0f);
+    TEST_CHECK(records[0].deltaX == -1.0f && records[0].deltaY == 7.0f);
+
+    //A key in between starts a new movement, so the key is delivered with the mouse where it was when the key was pressed
+    queue.Queue(InputQueue::MouseMovedInput, 0, 1.0f, 1.0f, 1.0f, 1.0f);
+    queue.Queue(InputQueue::KeyDownInput, 65, 0.0f, 0.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::MouseMovedInput, 0, 2.0f, 2.0f, 1.0f, 1.0f);
+    queue.Queue(InputQueue::MouseMovedInput, 0, 3.0f, 3.0f, 1.0f, 1.0f);
+    records = Deliver(queue);
+    TEST_CHECK(records.size() == 3);
+    TEST_CHECK(records[0].type == InputQueue::MouseMovedInput && records[0].x == 1.0f && records[0].deltaX == 1.0f);
+    TEST_CHECK(records[1].type == InputQueue::KeyDownInput && records[1].code == 65);
+    TEST_CHECK(records[2].type == InputQueue::MouseMovedInput && records[2].x == 3.0f && records[2].deltaX == 2.0f);
+
+    //Scrolls are coalesced the same way, but never into a movement, and a movement never into a scroll
+    queue.Queue(InputQueue::ScrollWheelInput, 0, 0.0f, 0.0f, 1.0f, 0.0f);
+    queue.Queue(InputQueue::ScrollWheelInput, 0, 0.0f, 0.0f, 2.0f, 0.0f);
+    queue.Queue(InputQueue::MouseMovedInput, 0, 5.0f, 5.0f, 1.0f, 0.0f);
+    queue.Queue(InputQueue::ScrollWheelInput, 0, 0.0f, 0.0f, -1.0f, 0.0f);
+    records = Deliver(queue);
+    TEST_CHECK(records.size() == 3);
+    TEST_CHECK(records[0].type == InputQueue::ScrollWheelInput && records[0].deltaX == 3.0f);
+    TEST_CHECK(records[1].type == InputQueue::MouseMovedInput && records[1].deltaX == 1.0f);
+    TEST_CHECK(records[2].type == InputQueue::ScrollWheelInput && records[2].deltaX == -1.0f);
+}
+
+static void TestOrdering()
+{
+    InputQueue queue(16);
+
+    //Repeated key and button transitions are all delivered, in order, with the position each button was pressed at
+    queue.Queue(InputQueue::KeyDownInput, 65, 0.0f, 0.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::KeyDownInput, 66, 0.0f, 0.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::MouseDownInput, 0, 10.0f, 10.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::MouseMovedInput, 0, 20.0f, 10.0f, 10.0f, 0.0f);
+    queue.Queue(InputQueue::MouseUpInput, 0, 20.0f, 10.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::MouseDownInput, 0, 20.0f, 10.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::MouseUpInput, 0, 20.0f, 10.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::KeyUpInput, 65, 0.0f, 0.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::KeyUpInput, 65, 0.0f, 0.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::KeyUpInput, 66, 0.0f, 0.0f, 0.0f, 0.0f);
+
+    const InputQueue::InputType types[] = { InputQueue::KeyDownInput, InputQueue::KeyDownInput, InputQueue::MouseDownInput, InputQueue::MouseMovedInput,
+                                            InputQueue::MouseUpInput, InputQueue::MouseDownInput, InputQueue::MouseUpInput, InputQueue::KeyUpInput,
+                                            InputQueue::KeyUpInput, InputQueue::KeyUpInput };
+    const unsigned int codes[] = { 65, 66, 0, 0, 0, 0, 0, 65, 65, 66 };
+    std::vector<InputQueue::InputRecord> records = Deliver(queue);
+    TEST_CHECK(records.size() == sizeof(types) / sizeof(types[0]));
+
+    bool isInOrder = records.size() == sizeof(types) / sizeof(types[0]);
+    for (unsigned int i = 0; i < records.size() && isInOrder == true; i++)
+    {
+        isInOrder = records[i].type == types[i] && records[i].code == codes[i];
+    }
+    TEST_CHECK(isInOrder == true);
+    TEST_CHECK(records[2].x == 10.0f && records[4].x == 20.0f);
+}
+
+static void TestQueuedWhileDelivering()
+{
+    InputQueue queue(4);
+    queue.Queue(InputQueue::MouseMovedInput, 0, 1.0f, 1.0f, 1.0f, 1.0f);
+    queue.Queue(InputQueue::KeyDownInput, 65, 0.0f, 0.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::MouseMovedInput, 0, 2.0f, 2.0f, 1.0f, 1.0f);
+
+    //Delivering the last movement queues another one (the way a handler can warp the mouse), and the key queues more
+    //than the queue was reserved for, so the queue grows while it's delivered
+    std::vector<InputQueue::InputRecord> records;
+    InputQueue::InputRecord record;
+    while (queue.DeliverNext(record) == true)
+    {
+        records.push_back(record);
+        if (records.size() == 2)
+        {
+            for (unsigned int i = 0; i < 8; i++)
+            {
+                queue.Queue(InputQueue::KeyUpInput, 100 + i, 0.0f, 0.0f, 0.0f, 0.0f);
+            }
+        }
+        else if (records.size() == 3)
+        {
+            //The movement that was just delivered can't take it, it's a new event
+            queue.Queue(InputQueue::MouseMovedInput, 0, 9.0f, 9.0f, 7.0f, 7.0f);
+            queue.Queue(InputQueue::MouseMovedInput, 0, 10.0f, 10.0f, 1.0f, 1.0f);
+        }
+    }
+
+    //The order is the order they were queued in: the original 3, the 8 keys and the coalesced movement
+    TEST_CHECK(records.size() == 3 + 8 + 1);
+    TEST_CHECK(records.size() == 12 && records[2].x == 2.0f && records[2].deltaX == 1.0f);
+    TEST_CHECK(records.size() == 12 && records[3].type == InputQueue::KeyUpInput && records[3].code == 100);
+    TEST_CHECK(records.size() == 12 && records[10].code == 107);
+    TEST_CHECK(records.size() == 12 && records[11].type == InputQueue::MouseMovedInput && records[11].x == 10.0f && records[11].deltaX == 8.0f);
+
+    //The queue is empty once it's delivered, the next movement isn't coalesced into anything
+    TEST_CHECK(Deliver(queue).size() == 0);
+    queue.Queue(InputQueue::MouseMovedInput, 0, 11.0f, 11.0f, 1.0f, 1.0f);
+    records = Deliver(queue);
+    TEST_CHECK(records.size() == 1 && records[0].deltaX == 1.0f);
+}
+
+static void TestCounters()
+{
+    InputQueue queue(16);
+    TEST_CHECK(queue.GetRawEventCount() == 0 && queue.GetDeliveredEventCount() == 0);
+
+    for (unsigned int i = 0; i < 10; i++)
+    {
+        queue.Queue(InputQueue::MouseMovedInput, 0, (float)i, 0.0f, 1.0f, 0.0f);
+    }
+    queue.Queue(InputQueue::KeyDownInput, 65, 0.0f, 0.0f, 0.0f, 0.0f);
+    queue.Queue(InputQueue::ScrollWheelInput, 0, 0.0f, 0.0f, 1.0f, 0.0f);
+    queue.Queue(InputQueue::ScrollWheelInput, 0, 0.0f, 0.0f, 1.0f, 0.0f);
+
+    //Every queued event is raw, the coalesced ones are delivered once they all have been
+    TEST_CHECK(queue.GetRawEventCount() == 13);
+    TEST_CHECK(queue.GetDeliveredEventCount() == 0);
+    TEST_CHECK(Deliver(queue).size() == 3);
+    TEST_CHECK(queue.GetRawEventCount() == 13);
+    TEST_CHECK(queue.GetDeliveredEventCount() == 3);
+
+    //The counters accumulate across frames, an empty frame doesn't change them
+    TEST_CHECK(Deliver(queue).size() == 0);
+    queue.Queue(InputQueue::KeyUpInput, 65, 0.0f, 0.0f, 0.0f, 0.0f);
+    Deliver(queue);
+    TEST_CHECK(queue.GetRawEventCount() == 14);
+    TEST_CHECK(queue.GetDeliveredEventCount() == 4);
+}
+
+static void TestAllocations()
+{
+    InputQueue queue(256);
+    InputQueue::InputRecord record;
+
+    //A frame of 200 separate events fits in the reserved queue, and the queue keeps its capacity once it's delivered
+    Tests::AllocationCounter::ResetPeak();
+    for (unsigned int frame = 0; frame < 10; frame++)
+    {
+        for (unsigned int i = 0; i < 100; i++)
+        {
+            queue.Queue(InputQueue::MouseMovedInput, 0, (float)i, 0.0f, 1.0f, 0.0f);
+            queue.Queue(InputQueue::KeyDownInput, i, 0.0f, 0.0f, 0.0f, 0.0f);
+        }
+        while (queue.DeliverNext(record) == true)
+        {
+            Tests::KeepAlive(record.x);
+        }
+    }
+    TEST_CHECK(Tests::AllocationCounter::GetHeapAllocationCount() == 0);
+}
+
+//Replays 10 seconds of input at 60 updates a second: a 1 kHz mouse, a key press every 200 ms, a click every second and a
+//scroll wheel tick every 100 ms
+static void BenchmarkReplay()
+{
+    InputQueue queue(256);
+    InputQueue::InputRecord record;
+    std::mt19937 random(40);
+    std::uniform_real_distribution<float> jitter(-2.0f, 2.0f);
+    float x = 640.0f;
+    float y = 360.0f;
+    unsigned int frames = 0;
+    unsigned int mouseMoves = 0;
+
+    Tests::Timer timer;
+    for (unsigned int ms = 0; ms < 10000; ms++)
+    {
+        float deltaX = jitter(random);
+        float deltaY = jitter(random);
+        x += deltaX;
+        y += deltaY;
+        queue.Queue(InputQueue::MouseMovedInput, 0, x, y, deltaX, deltaY);
+
+        if (ms % 200 == 50) queue.Queue(InputQueue::KeyDownInput, 65, 0.0f, 0.0f, 0.0f, 0.0f);
+        if (ms % 200 == 130) queue.Queue(InputQueue::KeyUpInput, 65, 0.0f, 0.0f, 0.0f, 0.0f);
+        if (ms % 1000 == 500) queue.Queue(InputQueue::MouseDownInput, 0, x, y, 0.0f, 0.0f);
+        if (ms % 1000 == 580) queue.Queue(InputQueue::MouseUpInput, 0, x, y, 0.0f, 0.0f);
+        if (ms % 100 == 70) queue.Queue(InputQueue::ScrollWheelInput, 0, 0.0f, 0.0f, 1.0f, 0.0f);
+
+        //An update delivers the queue
+        if (ms * 60 / 1000 != (ms + 1) * 60 / 1000)
+        {
+            while (queue.DeliverNext(record) == true)
+            {
+                mouseMoves += record.type == InputQueue::MouseMovedInput ? 1 : 0;
+            }
+            frames++;
+        }
+    }
+    double ms = timer.GetMilliseconds();
+
+    printf("10 s of a 1 kHz mouse, keys, clicks and scrolls, %u updates: %u raw events, %u delivered (%u movements), %.3f ms\n", frames,
+        queue.GetRawEventCount(), queue.GetDeliveredEventCount(), mouseMoves, ms);
+    TEST_CHECK(queue.GetDeliveredEventCount() < queue.GetRawEventCount() / 4);
+}
+
+int main()
+{
+    TestCoalescing();
+    TestOrdering();
+    TestQueuedWhileDelivering();
+    TestCounters();
+    TestAllocations();
+    BenchmarkReplay();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All InputQueue tests passed" : "InputQueue tests FAILED");
+    return Tests::Failures();
+}
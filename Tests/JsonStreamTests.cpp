@@ -0,0 +1,263 @@
+//Tests the JsonStream number parsing against the json grammar, then benchmarks streaming large atlases
+//against building a jsoncpp DOM, measuring the parse time and the peak heap memory.
+//
+//Sources: Source/Framework/Utils/JsonStream/JsonStream.cpp Source/Libraries/jsoncpp/json_reader.cpp
+//         Source/Libraries/jsoncpp/json_value.cpp Source/Libraries/jsoncpp/json_writer.cpp
+//         Tests/Support/AllocationCounter.cpp Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "Support/AllocationCounter.h"
+#include "../Source/Framework/Utils/JsonStream/JsonStream.h"
+#include "../Source/Libraries/jsoncpp/json.h"
+#include <clocale>
+#include <random>
+#include <string.h>
+
+using namespace GameDev2D;
+
+
+//Records the numbers and the number of values in a json document
+class NumberHandler : public JsonStreamHandler
+{
+public:
+    void OnNumber(double aValue)
+    {
+        numbers.push_back(aValue);
+    }
+
+    std::vector<double> numbers;
+};
+
+//Parses a json number on its own, returns false if the number was rejected
+static bool ParseNumber(const std::string& aNumber, double* aValue)
+{
+    NumberHandler handler;
+    if (JsonStream::Parse(aNumber.c_str(), (unsigned int)aNumber.length(), &handler) == false || handler.numbers.size() != 1)
+    {
+        return false;
+    }
+
+    *aValue = handler.numbers[0];
+    return true;
+}
+
+//Returns true if two doubles have the exact same bits
+static bool IsSameDouble(double aA, double aB)
+{
+    return memcmp(&aA, &aB, sizeof(double)) == 0;
+}
+
+static void TestNumbers()
+{
+    //Numbers whose conversion is known
+    const char* valid[] = { "0", "-0", "1", "-1", "42", "0.5", "-0.25", "123.456", "1e3", "1E3", "1e+3", "2.5e-3", "0.000001", "1234567890123",
+                            "9007199254740993", "12345678901234567890123", "1.7976931348623157e308", "4.9e-324", "1e-400", "0.1", "100e-2" };
+    const double expected[] = { 0.0, -0.0, 1.0, -1.0, 42.0, 0.5, -0.25, 123.456, 1000.0, 1000.0, 1000.0, 0.0025, 0.000001, 1234567890123.0,
+                                9007199254740992.0, 12345678901234567890123.0, 1.7976931348623157e308, 4.9e-324, 0.0, 0.1, 1.0 };
+    for (unsigned int i = 0; i < sizeof(valid) / sizeof(valid[0]); i++)
+    {
+        double value = 0.0;
+        TEST_CHECK(ParseNumber(valid[i], &value) == true && IsSameDouble(value, expected[i]) == true);
+    }
+
+    //Text that strtod accepts, but that isn't a json number
+    const char* invalid[] = { "inf", "-inf", "nan", "NaN", "infinity", "0x10", "0x1p3", "01", "-01", "1.", ".5", "+1", "1e", "1e+", "-", "1,5", "1.5.5", "1e400", "--1" };
+    for (unsigned int i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    {
+        double value = 0.0;
+        TEST_CHECK(ParseNumber(invalid[i], &value) == false);
+    }
+
+    //Random doubles, printed with enough digits to round trip, must parse to the same bits
+    std::mt19937_64 random(1729);
+    unsigned int mismatches = 0;
+    char buffer[64];
+    for (unsigned int i = 0; i < 200000; i++)
+    {
+        double original = 0.0;
+        switch (i % 4)
+        {
+        case 0: { unsigned long long bits = random(); memcpy(&original, &bits, sizeof(double)); if (isfinite(original) == 0) { original = 1.0; } break; }
+        case 1: original = (double)(long long)(random() % 100000000) - 50000000.0; break;
+        case 2: original = (double)(random() % 1000000) / 1000.0; break;
+        default: original = ldexp((double)(random() % 1000000), (int)(random() % 200) - 100); break;
+        }
+
+        snprintf(buffer, sizeof(buffer), "%.17g", original);
+        double value = 0.0;
+        if (ParseNumber(buffer, &value) == false || value != original)
+        {
+            mismatches++;
+        }
+    }
+    TEST_CHECK(mismatches == 0);
+
+    //The decimal separator of the C locale doesn't change the parsing
+    const char* locales[] = { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "German", "French" };
+    bool isLocaleSet = false;
+    for (unsigned int i = 0; i < sizeof(locales) / sizeof(locales[0]) && isLocaleSet == false; i++)
+    {
+        isLocaleSet = setlocale(LC_NUMERIC, locales[i]) != nullptr;
+    }
+
+    if (isLocaleSet == true)
+    {
+        double value = 0.0;
+        TEST_CHECK(ParseNumber("1.5", &value) == true && value == 1.5);
+        TEST_CHECK(ParseNumber("12345678901234567890.5", &value) == true && value == 12345678901234567890.5);
+        TEST_CHECK(ParseNumber("1,5", &value) == false);
+        setlocale(LC_NUMERIC, "C");
+    }
+    else
+    {
+        printf("No locale with a ',' decimal separator is installed, the locale test was skipped\n");
+    }
+}
+
+//Collects the frames of an atlas, the same way the SpriteAtlas's stream handler does
+class AtlasHandler : public JsonStreamHandler
+{
+public:
+    AtlasHandler() :
+        m_Depth(0),
+        m_InFrames(false),
+        m_Key(0)
+    {
+    }
+
+    void OnObjectBegin() { m_Depth++; }
+    void OnObjectEnd() { if (m_InFrames == true && m_Depth == 3) { frames.push_back(m_Frame); } m_Depth--; }
+    void OnArrayBegin() { m_Depth++; m_InFrames = m_Depth == 2; }
+    void OnArrayEnd() { m_InFrames = false; m_Depth--; }
+
+    void OnKey(const char* aKey, unsigned int aLength)
+    {
+        m_Key = (m_InFrames == true && m_Depth == 4 && aLength == 1) ? aKey[0] : 0;
+        if (m_InFrames == true && m_Depth == 3 && JsonStream::KeyEquals(aKey, aLength, "filename") == true)
+        {
+            m_Key = 'f';
+        }
+    }
+
+    void OnString(const char* aValue, unsigned int aLength)
+    {
+        if (m_Key == 'f')
+        {
+            m_Frame.filename.assign(aValue, aLength);
+        }
+    }
+
+    void OnNumber(double aValue)
+    {
+        switch (m_Key)
+        {
+        case 'x': m_Frame.x = (int)aValue; break;
+        case 'y': m_Frame.y = (int)aValue; break;
+        case 'w': m_Frame.width = (int)aValue; break;
+        case 'h': m_Frame.height = (int)aValue; break;
+        default: break;
+        }
+    }
+
+    struct Frame
+    {
+        std::string filename;
+        int x, y, width, height;
+    };
+
+    std::vector<Frame> frames;
+
+private:
+    unsigned int m_Depth;
+    bool m_InFrames;
+    char m_Key;
+    Frame m_Frame;
+};
+
+//Generates an atlas in TexturePacker's json array format
+static std::string MakeAtlas(unsigned int aFrames)
+{
+    std::ostringstream json;
+    json << "{\"frames\": [\n";
+    for (unsigned int i = 0; i < aFrames; i++)
+    {
+        int x = (int)(i % 64) * 32;
+        int y = (int)(i / 64) * 32;
+        json << "{\n\t\"filename\": \"Sprites/Frame_" << i << ".png\",\n";
+        json << "\t\"frame\": {\"x\":" << x << ",\"y\":" << y << ",\"w\":32,\"h\":32},\n";
+        json << "\t\"rotated\": false,\n\t\"trimmed\": false,\n";
+        json << "\t\"spriteSourceSize\": {\"x\":0,\"y\":0,\"w\":32,\"h\":32},\n";
+        json << "\t\"sourceSize\": {\"w\":32,\"h\":32},\n";
+        json << "\t\"pivot\": {\"x\":0.5,\"y\":0.5}\n}" << (i + 1 < aFrames ? "," : "") << "\n";
+    }
+    json << "],\n\"meta\": {\"app\": \"https://www.codeandweb.com/texturepacker\", \"image\": \"Atlas.png\", \"size\": {\"w\":2048,\"h\":2048}, \"scale\": \"1\"}\n}\n";
+    return json.str();
+}
+
+static void BenchmarkAtlases()
+{
+    printf("\n%8s %12s | %12s %12s | %12s %12s\n", "frames", "json bytes", "stream ms", "stream peak", "jsoncpp ms", "jsoncpp peak");
+
+    const unsigned int frameCounts[] = { 10000, 50000 };
+    for (unsigned int i = 0; i < sizeof(frameCounts) / sizeof(frameCounts[0]); i++)
+    {
+        std::string json = MakeAtlas(frameCounts[i]);
+        const unsigned int iterations = 5;
+
+        //Stream the frames straight into the handler, the peak excludes the json text itself
+        double streamMs = 1e30;
+        size_t streamPeak = 0;
+        for (unsigned int j = 0; j < iterations; j++)
+        {
+            Tests::AllocationCounter::ResetPeak();
+            size_t baseline = Tests::AllocationCounter::GetCurrentBytes();
+            Tests::Timer timer;
+            AtlasHandler handler;
+            bool isParsed = JsonStream::Parse(json.c_str(), (unsigned int)json.length(), &handler);
+            streamMs = std::min(streamMs, timer.GetMilliseconds());
+            streamPeak = Tests::AllocationCounter::GetPeakBytes() - baseline;
+            TEST_CHECK(isParsed == true && handler.frames.size() == frameCounts[i] && handler.frames.back().width == 32);
+        }
+
+        //Build the DOM, then copy the frames out of it
+        double domMs = 1e30;
+        size_t domPeak = 0;
+        for (unsigned int j = 0; j < iterations; j++)
+        {
+            Tests::AllocationCounter::ResetPeak();
+            size_t baseline = Tests::AllocationCounter::GetCurrentBytes();
+            Tests::Timer timer;
+            std::vector<AtlasHandler::Frame> frames;
+            {
+                Json::Value root;
+                Json::Reader reader;
+                bool isParsed = reader.parse(json, root, false);
+                const Json::Value& array = root["frames"];
+                for (unsigned int k = 0; k < array.size(); k++)
+                {
+                    AtlasHandler::Frame frame;
+                    frame.filename = array[k]["filename"].asString();
+                    frame.x = array[k]["frame"]["x"].asInt();
+                    frame.y = array[k]["frame"]["y"].asInt();
+                    frame.width = array[k]["frame"]["w"].asInt();
+                    frame.height = array[k]["frame"]["h"].asInt();
+                    frames.push_back(frame);
+                }
+                TEST_CHECK(isParsed == true && frames.size() == frameCounts[i]);
+            }
+            domMs = std::min(domMs, timer.GetMilliseconds());
+            domPeak = Tests::AllocationCounter::GetPeakBytes() - baseline;
+        }
+
+        printf("%8u %12zu | %12.2f %11.2fM | %12.2f %11.2fM\n", frameCounts[i], json.length(), streamMs, streamPeak / 1048576.0, domMs, domPeak / 1048576.0);
+    }
+}
+
+int main()
+{
+    TestNumbers();
+    BenchmarkAtlases();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All JsonStream tests passed" : "JsonStream tests FAILED");
+    return Tests::Failures();
+}
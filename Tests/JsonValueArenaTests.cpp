@@ -0,0 +1,245 @@
+//Tests that a jsoncpp ValueArena only serves the parse it is given to, on the thread that runs the parse, and that a
+//copy of a parsed Value outlives the arena. Then benchmarks parsing the font .json files in Assets/Fonts into a
+//Json::Value with and without an arena, measuring the heap allocations per parse and the parse throughput.
+//
+//Sources: Source/Libraries/jsoncpp/json_reader.cpp Source/Libraries/jsoncpp/json_value.cpp
+//         Source/Libraries/jsoncpp/json_writer.cpp Tests/Support/AllocationCounter.cpp
+
+#include "Support/TestHarness.h"
+#include "Support/AllocationCounter.h"
+#include "../Source/Libraries/jsoncpp/json.h"
+#include <atomic>
+#include <thread>
+
+
+//Generates a document with objects, arrays, strings and numbers
+static std::string MakeDocument(unsigned int aItems)
+{
+    std::ostringstream json;
+    json << "{\"name\": \"Document\", \"items\": [";
+    for (unsigned int i = 0; i < aItems; i++)
+    {
+        json << "{\"key\": \"Item_" << i << "\", \"value\": " << i << ", \"tags\": [\"a\", \"b\"]}" << (i + 1 < aItems ? "," : "");
+    }
+    json << "]}";
+    return json.str();
+}
+
+//Returns true if the root holds the document made by MakeDocument
+static bool IsDocument(const Json::Value& aRoot, unsigned int aItems)
+{
+    if (aRoot["name"].asString() != "Document" || aRoot["items"].size() != aItems)
+    {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < aItems; i++)
+    {
+        std::ostringstream key;
+        key << "Item_" << i;
+        const Json::Value& item = aRoot["items"][i];
+        if (item["key"].asString() != key.str() || item["value"].asUInt() != i || item["tags"][1u].asString() != "b")
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void TestScopedParse()
+{
+    const std::string document = MakeDocument(100);
+
+    Json::Value copy;
+    {
+        Json::ValueArena arena;
+        Json::Value root;
+        Json::Reader reader;
+
+        //The arena isn't active until the parse
+        TEST_CHECK(Json::ValueArena::active() == nullptr);
+        Json::Value before("Created before the parse");
+        TEST_CHECK(arena.allocationCount() == 0);
+
+        //The parse allocates from the arena, and deactivates it when it's done
+        TEST_CHECK(reader.parse(document, root, arena) == true);
+        TEST_CHECK(Json::ValueArena::active() == nullptr);
+        TEST_CHECK(arena.allocationCount() > 0 && arena.chunkCount() > 0);
+        TEST_CHECK(IsDocument(root, 100) == true);
+
+        //Values created OR modified after the parse don't allocate from the arena
+        unsigned int allocationCount = arena.allocationCount();
+        Json::Value after("Created after the parse");
+        root["added"] = "Added after the parse";
+        root["items"][0u]["key"] = "Item_0";
+        copy = root;
+        TEST_CHECK(arena.allocationCount() == allocationCount);
+
+        //A parse without the arena doesn't allocate from it either
+        Json::Value other;
+        TEST_CHECK(reader.parse(document, other) == true && arena.allocationCount() == allocationCount);
+
+        //Nested scopes restore the previously active arena
+        Json::ValueArena inner;
+        {
+            Json::ValueArena::Scope outerScope(arena);
+            {
+                Json::ValueArena::Scope innerScope(inner);
+                TEST_CHECK(Json::ValueArena::active() == &inner);
+            }
+            TEST_CHECK(Json::ValueArena::active() == &arena);
+        }
+        TEST_CHECK(Json::ValueArena::active() == nullptr);
+    }
+
+    //The copy was made outside of the parse, it doesn't refer to the arena's memory
+    TEST_CHECK(IsDocument(copy, 100) == true);
+    TEST_CHECK(copy["added"].asString() == "Added after the parse");
+}
+
+static void TestThreads()
+{
+    const unsigned int threadCount = 4;
+    const unsigned int iterations = 50;
+    const std::string document = MakeDocument(200);
+
+    //The number of allocations a single parse makes from its arena
+    unsigned int expectedAllocations = 0;
+    {
+        Json::ValueArena arena;
+        Json::Value root;
+        Json::Reader reader;
+        reader.parse(document, root, arena);
+        expectedAllocations = arena.allocationCount();
+    }
+
+    //Parse with an arena on some threads, while another thread creates Values without one. If the active arena
+    //was shared between the threads, the Values of one thread would be allocated from the other threads' arenas
+    std::atomic<unsigned int> mismatches(0);
+    std::atomic<bool> isParsing(true);
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+        threads.push_back(std::thread([&]()
+        {
+            for (unsigned int j = 0; j < iterations; j++)
+            {
+                Json::ValueArena arena;
+                Json::Value root;
+                Json::Reader reader;
+                if (reader.parse(document, root, arena) == false || arena.allocationCount() != expectedAllocations || IsDocument(root, 200) == false)
+                {
+                    mismatches++;
+                }
+            }
+        }));
+    }
+
+    std::thread creator([&]()
+    {
+        while (isParsing == true)
+        {
+            Json::Value value(Json::objectValue);
+            value["string"] = "A string that is allocated";
+            if (Json::ValueArena::active() != nullptr)
+            {
+                mismatches++;
+            }
+        }
+    });
+
+    for (unsigned int i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+    isParsing = false;
+    creator.join();
+
+    TEST_CHECK(mismatches == 0);
+}
+
+//Parses the json, with the arena if there is one, returns the number of heap allocations the parse made
+static size_t Parse(const std::string& aJson, Json::ValueArena* aArena, bool& aIsParsed)
+{
+    Tests::AllocationCounter::ResetPeak();
+    {
+        Json::Value root;
+        Json::Reader reader;
+        aIsParsed = aArena != nullptr ? reader.parse(aJson, root, *aArena) : reader.parse(aJson, root);
+        aIsParsed = aIsParsed == true && root.isObject() == true && root.size() > 0;
+    }
+    return Tests::AllocationCounter::GetHeapAllocationCount();
+}
+
+static void BenchmarkFonts()
+{
+    const char* fonts[] = { "OpenSans-CondBold_22", "OpenSans-CondBold_32", "heavy_data_150", "slkscr_32", "slkscr_42" };
+
+    printf("\nheap allocations per parse (%s), MB/s over the best of the iterations\n",
+        Tests::AllocationCounter::IsMallocCounted() == true ? "operator new and malloc" : "operator new only, malloc isn't counted");
+    printf("%22s %8s | %12s %10s | %12s %10s %7s\n", "font", "bytes", "allocations", "MB/s", "allocations", "MB/s", "chunks");
+    printf("%22s %8s | %23s | %31s\n", "", "", "without an arena", "with an arena");
+
+    for (unsigned int i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++)
+    {
+        std::ifstream stream((std::string("Assets/Fonts/") + fonts[i] + ".json").c_str(), std::ios::binary);
+        std::ostringstream json;
+        json << stream.rdbuf();
+        TEST_CHECK(json.str().empty() == false);
+        if (json.str().empty() == true)
+        {
+            continue;
+        }
+
+        const unsigned int iterations = 50;
+        double megabytes = (double)json.str().length() / 1048576.0;
+
+        //Without an arena, every member name, string and map node is allocated on its own
+        size_t mallocAllocations = 0;
+        double mallocMs = 1e30;
+        for (unsigned int j = 0; j < iterations; j++)
+        {
+            bool isParsed = false;
+            Tests::Timer timer;
+            mallocAllocations = Parse(json.str(), nullptr, isParsed);
+            mallocMs = std::min(mallocMs, timer.GetMilliseconds());
+            TEST_CHECK(isParsed == true);
+        }
+
+        //With an arena, the Values are allocated from its chunks, the arena's lifetime is part of the parse
+        size_t arenaAllocations = 0;
+        double arenaMs = 1e30;
+        unsigned int chunks = 0;
+        for (unsigned int j = 0; j < iterations; j++)
+        {
+            bool isParsed = false;
+            Tests::Timer timer;
+            {
+                Json::ValueArena arena;
+                arenaAllocations = Parse(json.str(), &arena, isParsed);
+                chunks = arena.chunkCount();
+            }
+            arenaMs = std::min(arenaMs, timer.GetMilliseconds());
+            TEST_CHECK(isParsed == true);
+        }
+
+        //The arena has to save allocations, where they can be counted
+        if (Tests::AllocationCounter::IsMallocCounted() == true)
+        {
+            TEST_CHECK(arenaAllocations < mallocAllocations);
+        }
+
+        printf("%22s %8zu | %12zu %10.1f | %12zu %10.1f %7u\n", fonts[i], json.str().length(),
+            mallocAllocations, megabytes / (mallocMs / 1000.0), arenaAllocations, megabytes / (arenaMs / 1000.0), chunks);
+    }
+}
+
+int main()
+{
+    TestScopedParse();
+    TestThreads();
+    BenchmarkFonts();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All ValueArena tests passed" : "ValueArena tests FAILED");
+    return Tests::Failures();
+}
@@ -0,0 +1,439 @@
+//Benchmarks composing transforms and transforming vertices with the Matrix and the AffineTransform, against a copy of the
+//Matrix as it was before it was vectorized (BaselineMatrix below, a scalar 4x4 Matrix composed as translation * rotation * scale).
+//The results are checked against the baseline as well: composing and multiplying are bit for bit the same, transforming a
+//vertex and inverting are within a few float ulps.
+//
+//Sources: Source/Framework/Math/Matrix.cpp Source/Framework/Math/AffineTransform.cpp Source/Framework/Math/Rotation.cpp
+//         Source/Framework/Math/Vector2.cpp Source/Framework/Math/Math.cpp Source/Framework/Math/Random.cpp
+//         Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Math/AffineTransform.h"
+#include "../Source/Framework/Math/Matrix.h"
+#include <random>
+#include <string.h>
+
+using namespace GameDev2D;
+
+
+//The baseline's operations were in Matrix.cpp, keep the compiler from inlining them here so they're called the same way
+#if defined(_MSC_VER)
+#define BASELINE_NOINLINE __declspec(noinline)
+#else
+#define BASELINE_NOINLINE __attribute__((noinline))
+#endif
+
+//The scalar Matrix operations, as they were before the Matrix was vectorized
+struct BaselineMatrix
+{
+    static BaselineMatrix Identity()
+    {
+        BaselineMatrix matrix;
+        matrix.m[0][0] = 1.0f; matrix.m[1][1] = 1.0f; matrix.m[2][2] = 1.0f; matrix.m[3][3] = 1.0f;
+        return matrix;
+    }
+
+    BASELINE_NOINLINE static BaselineMatrix Make(Vector2 aTranslation, float aRadians, Vector2 aScale)
+    {
+        BaselineMatrix translation = Identity();
+        translation.m[3][0] = aTranslation.x;
+        translation.m[3][1] = aTranslation.y;
+
+        BaselineMatrix rotation = Identity();
+        Vector2 direction = Rotation::Radians(aRadians).GetDirection();
+        rotation.m[0][0] = direction.x;  rotation.m[1][0] = -direction.y;
+        rotation.m[0][1] = direction.y;  rotation.m[1][1] = direction.x;
+        rotation = rotation * Identity();
+
+        BaselineMatrix scale = Identity();
+        scale.m[0][0] *= aScale.x;  scale.m[1][0] *= aScale.x;  scale.m[3][0] *= aScale.x;
+        scale.m[0][1] *= aScale.y;  scale.m[1][1] *= aScale.y;  scale.m[3][1] *= aScale.y;
+
+        return translation * rotation * scale;
+    }
+
+    BaselineMatrix()
+    {
+        memset(m, 0, sizeof(m));
+    }
+
+    explicit BaselineMatrix(const Matrix& aMatrix)
+    {
+        memcpy(m, aMatrix.m, sizeof(m));
+    }
+
+    BASELINE_NOINLINE BaselineMatrix GetInverse() const
+    {
+        BaselineMatrix inverse;
+        inverse.m[0][0] = m[1][1] * m[2][2] * m[3][3] - m[1][1] * m[2][3] * m[3][2] - m[2][1] * m[1][2] * m[3][3] + m[2][1] * m[1][3] * m[3][2] + m[3][1] * m[1][2] * m[2][3] - m[3][1] * m[1][3] * m[2][2];
+        inverse.m[1][0] = -m[1][0] * m[2][2] * m[3][3] + m[1][0] * m[2][3] * m[3][2] + m[2][0] * m[1][2] * m[3][3] - m[2][0] * m[1][3] * m[3][2] - m[3][0] * m[1][2] * m[2][3] + m[3][0] * m[1][3] * m[2][2];
+        inverse.m[2][0] = m[1][0] * m[2][1] * m[3][3] - m[1][0] * m[2][3] * m[3][1] - m[2][0] * m[1][1] * m[3][3] + m[2][0] * m[1][3] * m[3][1] + m[3][0] * m[1][1] * m[2][3] - m[3][0] * m[1][3] * m[2][1];
+        inverse.m[3][0] = -m[1][0] * m[2][1] * m[3][2] + m[1][0] * m[2][2] * m[3][1] + m[2][0] * m[1][1] * m[3][2] - m[2][0] * m[1][2] * m[3][1] - m[3][0] * m[1][1] * m[2][2] + m[3][0] * m[1][2] * m[2][1];
+        inverse.m[0][1] = -m[0][1] * m[2][2] * m[3][3] + m[0][1] * m[2][3] * m[3][2] + m[2][1] * m[0][2] * m[3][3] - m[2][1] * m[0][3] * m[3][2] - m[3][1] * m[0][2] * m[2][3] + m[3][1] * m[0][3] * m[2][2];
+        inverse.m[1][1] = m[0][0] * m[2][2] * m[3][3] - m[0][0] * m[2][3] * m[3][2] - m[2][0] * m[0][2] * m[3][3] + m[2][0] * m[0][3] * m[3][2] + m[3][0] * m[0][2] * m[2][3] - m[3][0] * m[0][3] * m[2][2];
+        inverse.m[2][1] = -m[0][0] * m[2][1] * m[3][3] + m[0][0] * m[2][3] * m[3][1] + m[2][0] * m[0][1] * m[3][3] - m[2][0] * m[0][3] * m[3][1] - m[3][0] * m[0][1] * m[2][3] + m[3][0] * m[0][3] * m[2][1];
+        inverse.m[3][1] = m[0][0] * m[2][1] * m[3][2] - m[0][0] * m[2][2] * m[3][1] - m[2][0] * m[0][1] * m[3][2] + m[2][0] * m[0][2] * m[3][1] + m[3][0] * m[0][1] * m[2][2] - m[3][0] * m[0][2] * m[2][1];
+        inverse.m[0][2] = m[0][1] * m[1][2] * m[3][3] - m[0][1] * m[1][3] * m[3][2] - m[1][1] * m[0][2] * m[3][3] + m[1][1] * m[0][3] * m[3][2] + m[3][1] * m[0][2] * m[1][3] - m[3][1] * m[0][3] * m[1][2];
+        inverse.m[1][2] = -m[0][0] * m[1][2] * m[3][3] + m[0][0] * m[1][3] * m[3][2] + m[1][0] * m[0][2] * m[3][3] - m[1][0] * m[0][3] * m[3][2] - m[3][0] * m[0][2] * m[1][3] + m[3][0] * m[0][3] * m[1][2];
+        inverse.m[2][2] = m[0][0] * m[1][1] * m[3][3] - m[0][0] * m[1][3] * m[3][1] - m[1][0] * m[0][1] * m[3][3] + m[1][0] * m[0][3] * m[3][1] + m[3][0] * m[0][1] * m[1][3] - m[3][0] * m[0][3] * m[1][1];
+        inverse.m[3][2] = -m[0][0] * m[1][1] * m[3][2] + m[0][0] * m[1][2] * m[3][1] + m[1][0] * m[0][1] * m[3][2] - m[1][0] * m[0][2] * m[3][1] - m[3][0] * m[0][1] * m[1][2] + m[3][0] * m[0][2] * m[1][1];
+        inverse.m[0][3] = -m[0][1] * m[1][2] * m[2][3] + m[0][1] * m[1][3] * m[2][2] + m[1][1] * m[0][2] * m[2][3] - m[1][1] * m[0][3] * m[2][2] - m[2][1] * m[0][2] * m[1][3] + m[2][1] * m[0][3] * m[1][2];
+        inverse.m[1][3] = m[0][0] * m[1][2] * m[2][3] - m[0][0] * m[1][3] * m[2][2] - m[1][0] * m[0][2] * m[2][3] + m[1][0] * m[0][3] * m[2][2] + m[2][0] * m[0][2] * m[1][3] - m[2][0] * m[0][3] * m[1][2];
+        inverse.m[2][3] = -m[0][0] * m[1][1] * m[2][3] + m[0][0] * m[1][3] * m[2][1] + m[1][0] * m[0][1] * m[2][3] - m[1][0] * m[0][3] * m[2][1] - m[2][0] * m[0][1] * m[1][3] + m[2][0] * m[0][3] * m[1][1];
+        inverse.m[3][3] = m[0][0] * m[1][1] * m[2][2] - m[0][0] * m[1][2] * m[2][1] - m[1][0] * m[0][1] * m[2][2] + m[1][0] * m[0][2] * m[2][1] + m[2][0] * m[0][1] * m[1][2] - m[2][0] * m[0][2] * m[1][1];
+
+        float determinant = m[0][0] * inverse.m[0][0] + m[0][1] * inverse.m[1][0] + m[0][2] * inverse.m[2][0] + m[0][3] * inverse.m[3][0];
+        if (determinant == 0)
+        {
+            return BaselineMatrix();
+        }
+
+        determinant = 1.0f / determinant;
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                inverse.m[i][j] *= determinant;
+            }
+        }
+        return inverse;
+    }
+
+    BASELINE_NOINLINE Vector2 operator *(const Vector2 aVector2) const
+    {
+        float x = m[0][0] * aVector2.x + m[1][0] * aVector2.y + 0.0f + m[3][0] * 1.0f;
+        float y = m[0][1] * aVector2.x + m[1][1] * aVector2.y + 0.0f + m[3][1] * 1.0f;
+        float w = m[0][3] * aVector2.x + m[1][3] * aVector2.y + 0.0f + m[3][3] * 1.0f;
+        if (w == 0.0f)
+        {
+            return Vector2(x, y);
+        }
+        return Vector2(x / w, y / w);
+    }
+
+    BASELINE_NOINLINE BaselineMatrix operator *(const BaselineMatrix aMatrix) const
+    {
+        BaselineMatrix matrix;
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                matrix.m[i][j] = m[0][j] * aMatrix.m[i][0] + m[1][j] * aMatrix.m[i][1] + m[2][j] * aMatrix.m[i][2] + m[3][j] * aMatrix.m[i][3];
+            }
+        }
+        return matrix;
+    }
+
+    float m[4][4];
+};
+
+//The inputs of the benchmarks, random transforms like the game's sprites have
+struct TransformInput
+{
+    Vector2 translation;
+    float radians;
+    Vector2 scale;
+};
+
+static std::vector<TransformInput> MakeInputs(unsigned int aCount)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> angle(-6.3f, 6.3f);
+    std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+
+    std::vector<TransformInput> inputs(aCount);
+    for (unsigned int i = 0; i < aCount; i++)
+    {
+        inputs[i].translation = Vector2(position(random), position(random));
+        inputs[i].radians = angle(random);
+        inputs[i].scale = Vector2(scale(random), scale(random));
+    }
+    return inputs;
+}
+
+//Returns the distance between two floats in ulps
+static unsigned int UlpDistance(float aA, float aB)
+{
+    int a;
+    int b;
+    memcpy(&a, &aA, sizeof(a));
+    memcpy(&b, &aB, sizeof(b));
+    a = a < 0 ? (int)(0x80000000u - (unsigned int)a) : a;
+    b = b < 0 ? (int)(0x80000000u - (unsigned int)b) : b;
+    return a > b ? (unsigned int)(a - b) : (unsigned int)(b - a);
+}
+
+static void TestResults()
+{
+    std::vector<TransformInput> inputs = MakeInputs(100000);
+
+    unsigned int makeMismatches = 0;
+    unsigned int affineMismatches = 0;
+    unsigned int multiplyMismatches = 0;
+    unsigned int worstPointUlps = 0;
+    double baselineInverseError = 0.0;
+    double inverseError = 0.0;
+    double affineInverseError = 0.0;
+
+    for (unsigned int i = 0; i + 1 < inputs.size(); i++)
+    {
+        const TransformInput& a = inputs[i];
+        const TransformInput& b = inputs[i + 1];
+
+        //Composing is bit for bit the same as translation * rotation * scale, for the Matrix and the AffineTransform
+        BaselineMatrix baseline = BaselineMatrix::Make(a.translation, a.radians, a.scale);
+        Matrix matrix = Matrix::Make(a.translation, a.radians, a.scale);
+        makeMismatches += memcmp(baseline.m, matrix.m, sizeof(matrix.m)) != 0 ? 1 : 0;
+
+        Matrix affine = Matrix(AffineTransform::Make(a.translation, a.radians, a.scale));
+        affineMismatches += memcmp(baseline.m, affine.m, sizeof(affine.m)) != 0 ? 1 : 0;
+
+        //Multiplying is bit for bit the same, including a projection's z and w rows
+        Matrix other = Matrix::Orthographic(-b.translation.x, b.translation.x + 1.0f, -b.translation.y, b.translation.y + 1.0f, -1.0f, 1.0f) * Matrix::Make(b.translation, b.radians, b.scale);
+        BaselineMatrix baselineProduct = BaselineMatrix(matrix) * BaselineMatrix(other);
+        Matrix product = matrix * other;
+        multiplyMismatches += memcmp(baselineProduct.m, product.m, sizeof(product.m)) != 0 ? 1 : 0;
+
+        //Transforming a vertex
+        Vector2 vertex(b.translation.y, b.translation.x);
+        Vector2 baselineVertex = baseline * vertex;
+        Vector2 matrixVertex = matrix * vertex;
+        Vector2 affineVertex = AffineTransform::Make(a.translation, a.radians, a.scale) * vertex;
+        worstPointUlps = std::max(worstPointUlps, std::max(UlpDistance(baselineVertex.x, matrixVertex.x), UlpDistance(baselineVertex.y, matrixVertex.y)));
+        worstPointUlps = std::max(worstPointUlps, std::max(UlpDistance(baselineVertex.x, affineVertex.x), UlpDistance(baselineVertex.y, affineVertex.y)));
+
+        //Inverting, the error is how far a vertex is from itself after a round trip through the transform and its inverse
+        Vector2 baselineRoundTrip = baseline.GetInverse() * baselineVertex;
+        Vector2 roundTrip = matrix.GetInverse() * matrixVertex;
+        Vector2 affineRoundTrip = AffineTransform::Make(a.translation, a.radians, a.scale).GetInverse() * affineVertex;
+        baselineInverseError = std::max(baselineInverseError, (double)(baselineRoundTrip - vertex).Length());
+        inverseError = std::max(inverseError, (double)(roundTrip - vertex).Length());
+        affineInverseError = std::max(affineInverseError, (double)(affineRoundTrip - vertex).Length());
+    }
+
+    printf("%u transforms: worst vertex difference %u ulps, worst round trip error %.6f baseline, %.6f Matrix, %.6f AffineTransform\n",
+        (unsigned int)inputs.size(), worstPointUlps, baselineInverseError, inverseError, affineInverseError);
+
+    TEST_CHECK(makeMismatches == 0);
+    TEST_CHECK(affineMismatches == 0);
+    TEST_CHECK(multiplyMismatches == 0);
+    TEST_CHECK(worstPointUlps <= 4);
+    TEST_CHECK(inverseError <= baselineInverseError * 1.5 + 1e-3);
+    TEST_CHECK(affineInverseError <= baselineInverseError * 1.5 + 1e-3);
+}
+
+//Runs a benchmark several times, returns the fastest time per operation in nanoseconds
+template<typename Function> static double Measure(unsigned int aOperations, Function aFunction)
+{
+    double best = 1e30;
+    for (unsigned int run = 0; run < 7; run++)
+    {
+        Tests::Timer timer;
+        aFunction();
+        best = std::min(best, timer.GetMilliseconds());
+    }
+    return best * 1e6 / aOperations;
+}
+
+static void Benchmark()
+{
+    const unsigned int count = 4096;
+    const unsigned int repeats = 64;
+    const unsigned int operations = count * repeats;
+    std::vector<TransformInput> inputs = MakeInputs(count);
+
+    //Composing a transform from a position, rotation and scale
+    double composeBaseline = Measure(operations, [&]()
+    {
+        float sum = 0.0f;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            for (unsigned int i = 0; i < count; i++)
+            {
+                sum += BaselineMatrix::Make(inputs[i].translation, inputs[i].radians, inputs[i].scale).m[3][0];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    double composeMatrix = Measure(operations, [&]()
+    {
+        float sum = 0.0f;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            for (unsigned int i = 0; i < count; i++)
+            {
+                sum += Matrix::Make(inputs[i].translation, inputs[i].radians, inputs[i].scale).m[3][0];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    double composeAffine = Measure(operations, [&]()
+    {
+        float sum = 0.0f;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            for (unsigned int i = 0; i < count; i++)
+            {
+                sum += AffineTransform::Make(inputs[i].translation, inputs[i].radians, inputs[i].scale).m[2][0];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    //Composing a child's transform with its parent's
+    std::vector<BaselineMatrix> baselineMatrices(count);
+    std::vector<Matrix> matrices(count);
+    std::vector<AffineTransform> affineTransforms(count);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        baselineMatrices[i] = BaselineMatrix::Make(inputs[i].translation, inputs[i].radians, inputs[i].scale);
+        matrices[i] = Matrix::Make(inputs[i].translation, inputs[i].radians, inputs[i].scale);
+        affineTransforms[i] = AffineTransform::Make(inputs[i].translation, inputs[i].radians, inputs[i].scale);
+    }
+
+    double multiplyBaseline = Measure(operations, [&]()
+    {
+        float sum = 0.0f;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            for (unsigned int i = 0; i + 1 < count; i++)
+            {
+                sum += (baselineMatrices[i] * baselineMatrices[i + 1]).m[3][0];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    double multiplyMatrix = Measure(operations, [&]()
+    {
+        float sum = 0.0f;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            for (unsigned int i = 0; i + 1 < count; i++)
+            {
+                sum += (matrices[i] * matrices[i + 1]).m[3][0];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    double multiplyAffine = Measure(operations, [&]()
+    {
+        float sum = 0.0f;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            for (unsigned int i = 0; i + 1 < count; i++)
+            {
+                sum += (affineTransforms[i] * affineTransforms[i + 1]).m[2][0];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    //Transforming a sprite's vertices
+    std::vector<Vector2> vertices(count);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        vertices[i] = Vector2(inputs[i].translation.y * 0.1f, inputs[i].translation.x * 0.1f);
+    }
+
+    double vertexBaseline = Measure(operations, [&]()
+    {
+        Vector2 sum;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            const BaselineMatrix& matrix = baselineMatrices[r];
+            for (unsigned int i = 0; i < count; i++)
+            {
+                sum += matrix * vertices[i];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    double vertexMatrix = Measure(operations, [&]()
+    {
+        Vector2 sum;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            const Matrix& matrix = matrices[r];
+            for (unsigned int i = 0; i < count; i++)
+            {
+                sum += matrix * vertices[i];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    double vertexAffine = Measure(operations, [&]()
+    {
+        Vector2 sum;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            const AffineTransform& transform = affineTransforms[r];
+            for (unsigned int i = 0; i < count; i++)
+            {
+                sum += transform * vertices[i];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    //Inverting, the way the Camera does to map the mouse to the world
+    double inverseBaseline = Measure(operations, [&]()
+    {
+        float sum = 0.0f;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            for (unsigned int i = 0; i < count; i++)
+            {
+                sum += baselineMatrices[i].GetInverse().m[3][0];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    double inverseMatrix = Measure(operations, [&]()
+    {
+        float sum = 0.0f;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            for (unsigned int i = 0; i < count; i++)
+            {
+                sum += matrices[i].GetInverse().m[3][0];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    double inverseAffine = Measure(operations, [&]()
+    {
+        float sum = 0.0f;
+        for (unsigned int r = 0; r < repeats; r++)
+        {
+            for (unsigned int i = 0; i < count; i++)
+            {
+                sum += affineTransforms[i].GetInverse().m[2][0];
+            }
+        }
+        Tests::KeepAlive(sum);
+    });
+
+    printf("\n%-24s | %14s %14s %16s\n", "ns per operation", "baseline", "Matrix", "AffineTransform");
+    printf("%-24s | %14.2f %14.2f %16.2f\n", "compose T * R * S", composeBaseline, composeMatrix, composeAffine);
+    printf("%-24s | %14.2f %14.2f %16.2f\n", "compose with a parent", multiplyBaseline, multiplyMatrix, multiplyAffine);
+    printf("%-24s | %14.2f %14.2f %16.2f\n", "transform a vertex", vertexBaseline, vertexMatrix, vertexAffine);
+    printf("%-24s | %14.2f %14.2f %16.2f\n", "inverse", inverseBaseline, inverseMatrix, inverseAffine);
+}
+
+int main()
+{
+    TestResults();
+    Benchmark();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All Matrix tests passed" : "Matrix tests FAILED");
+    return Tests::Failures();
+}
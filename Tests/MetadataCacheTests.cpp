@@ -0,0 +1,288 @@
+//Tests that a metadata cache is invalidated when its source file changes (and only then), also when it changes between
+//being read and the cache being written. Tests that an AtlasMap's frame indices survive a cache reload, AnimatedSprites
+//keep the indices their keys resolved to, so every key has to have the same index (and frame) after a reload. Then
+//benchmarks a warm load, validated by the source file's size and modification time, against a load that has to hash the
+//source file.
+//
+//Sources: Source/Framework/Utils/MetadataCache/MetadataCache.cpp Source/Framework/Graphics/GraphicTypes.cpp
+//         Source/Framework/Animation/AnimationClip.cpp Source/Framework/Animation/Easing.cpp
+//         Source/Framework/Utils/JsonStream/JsonStream.cpp Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Utils/MetadataCache/MetadataCache.h"
+#include "../Source/Framework/Graphics/SpriteAtlas.h"
+#include "../Source/Framework/Animation/AnimationClip.h"
+#include <fstream>
+#include <random>
+#include <string.h>
+#include <time.h>
+#if defined(_WIN32)
+#include <sys/utime.h>
+#define utime _utime
+#define utimbuf _utimbuf
+#else
+#include <utime.h>
+#endif
+
+using namespace GameDev2D;
+
+
+//The offset of the source file's modification time in the cache header
+const unsigned int TEST_CACHE_MODIFIED_TIME_OFFSET = 24;
+
+static void WriteTextFile(const std::string& aPath, const std::string& aText)
+{
+    std::ofstream stream(aPath.c_str(), std::ios::binary | std::ios::trunc);
+    stream << aText;
+}
+
+static std::string ReadTextFile(const std::string& aPath)
+{
+    std::ifstream stream(aPath.c_str(), std::ios::binary);
+    std::ostringstream text;
+    text << stream.rdbuf();
+    return text.str();
+}
+
+//Sets a file's modification time, an old modification time makes the cache record it (a recent one is racy)
+static void SetModifiedTime(const std::string& aPath, time_t aTime)
+{
+    utimbuf times;
+    times.actime = aTime;
+    times.modtime = aTime;
+    utime(aPath.c_str(), &times);
+}
+
+//Returns the source file's modification time that is recorded in the cache
+static unsigned long long GetCachedModifiedTime(const std::string& aSourcePath)
+{
+    std::string cache = ReadTextFile(MetadataCache::GetCachePath(aSourcePath));
+    unsigned long long modifiedTime = 0xffffffffffffffffull;
+    if (cache.length() >= TEST_CACHE_MODIFIED_TIME_OFFSET + sizeof(modifiedTime))
+    {
+        memcpy(&modifiedTime, &cache[TEST_CACHE_MODIFIED_TIME_OFFSET], sizeof(modifiedTime));
+    }
+    return modifiedTime;
+}
+
+static AtlasMap* MakeAtlasMap(unsigned int aFrames)
+{
+    AtlasMap* atlasMap = new AtlasMap();
+    for (unsigned int i = 0; i < aFrames; i++)
+    {
+        std::ostringstream key;
+        key << "Sprites/Frame_" << i << ".png";
+        atlasMap->Create(key.str(), Rect(Vector2((float)(i % 64) * 32.0f, (float)(i / 64) * 32.0f), Vector2(32.0f, 32.0f)));
+    }
+    return atlasMap;
+}
+
+//Reads the source file and saves the AtlasMap to its cache, the way the ResourceManager does after unpacking it
+static bool SaveAtlas(const std::string& aSourcePath, AtlasMap* aAtlasMap)
+{
+    std::vector<char> buffer;
+    MetadataSource source;
+    return MetadataCache::ReadSource(aSourcePath, buffer, &source) == true && MetadataCache::SaveAtlasMap(aSourcePath, source, aAtlasMap) == true;
+}
+
+//Returns true if the cache for the source file loads, and has the expected number of frames
+static bool LoadsAtlas(const std::string& aSourcePath, unsigned int aFrames)
+{
+    AtlasMap* atlasMap = nullptr;
+    bool isLoaded = MetadataCache::LoadAtlasMap(aSourcePath, &atlasMap) == true && atlasMap->Count() == aFrames;
+    delete atlasMap;
+    return isLoaded;
+}
+
+static void TestInvalidation()
+{
+    const std::string sourcePath = "MetadataCacheTests_Atlas.json";
+    const time_t past = time(nullptr) - 1000;
+    AtlasMap* atlasMap = MakeAtlasMap(16);
+
+    //A fresh cache loads, and records the source file's modification time
+    WriteTextFile(sourcePath, "{ \"frames\": \"aaaa\" }");
+    SetModifiedTime(sourcePath, past);
+    TEST_CHECK(SaveAtlas(sourcePath, atlasMap) == true);
+    TEST_CHECK(GetCachedModifiedTime(sourcePath) == (unsigned long long)past);
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == true);
+
+    //There's no cache for a source file that doesn't have one
+    TEST_CHECK(LoadsAtlas("MetadataCacheTests_Missing.json", 16) == false);
+
+    //The contents changed but the size didn't, the modification time changed so the hash catches it
+    WriteTextFile(sourcePath, "{ \"frames\": \"bbbb\" }");
+    SetModifiedTime(sourcePath, past + 10);
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == false);
+
+    //The size changed, that is stale regardless of the modification time
+    WriteTextFile(sourcePath, "{ \"frames\": \"aaaaa\" }");
+    SetModifiedTime(sourcePath, past);
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == false);
+
+    //The file was touched without changing, the hash still matches so the cache is valid, and its modification time
+    //is refreshed so that the next load doesn't hash the file again
+    WriteTextFile(sourcePath, "{ \"frames\": \"aaaa\" }");
+    SetModifiedTime(sourcePath, past + 20);
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == true);
+    TEST_CHECK(GetCachedModifiedTime(sourcePath) == (unsigned long long)(past + 20));
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == true);
+
+    //A source file that was just written has a racy modification time, it isn't recorded and every load hashes the file
+    WriteTextFile(sourcePath, "{ \"frames\": \"cccc\" }");
+    TEST_CHECK(SaveAtlas(sourcePath, atlasMap) == true);
+    TEST_CHECK(GetCachedModifiedTime(sourcePath) == 0);
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == true);
+    WriteTextFile(sourcePath, "{ \"frames\": \"dddd\" }");
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == false);
+
+    //The source file changed after it was read, the cache records the contents that were read (and unpacked), not the
+    //changed ones, so it's stale for the changed file
+    WriteTextFile(sourcePath, "{ \"frames\": \"eeee\" }");
+    SetModifiedTime(sourcePath, past);
+    std::vector<char> buffer;
+    MetadataSource source;
+    TEST_CHECK(MetadataCache::ReadSource(sourcePath, buffer, &source) == true);
+    TEST_CHECK(source.size == 20 && buffer.size() == 21 && buffer[20] == '\0');
+    WriteTextFile(sourcePath, "{ \"frames\": \"ffff\" }");
+    SetModifiedTime(sourcePath, past + 30);
+    TEST_CHECK(MetadataCache::SaveAtlasMap(sourcePath, source, atlasMap) == true);
+    TEST_CHECK(GetCachedModifiedTime(sourcePath) == (unsigned long long)past);
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == false);
+
+    //A truncated cache OR one from another cache version is stale
+    SetModifiedTime(sourcePath, past);
+    TEST_CHECK(SaveAtlas(sourcePath, atlasMap) == true);
+    std::string cache = ReadTextFile(MetadataCache::GetCachePath(sourcePath));
+    WriteTextFile(MetadataCache::GetCachePath(sourcePath), cache.substr(0, cache.length() - 8));
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == false);
+    WriteTextFile(MetadataCache::GetCachePath(sourcePath), cache.substr(0, 20));
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == false);
+
+    std::string otherVersion = cache;
+    otherVersion[4] = 1;
+    WriteTextFile(MetadataCache::GetCachePath(sourcePath), otherVersion);
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == false);
+
+    WriteTextFile(MetadataCache::GetCachePath(sourcePath), cache);
+    TEST_CHECK(LoadsAtlas(sourcePath, 16) == true);
+
+    delete atlasMap;
+    remove(MetadataCache::GetCachePath(sourcePath).c_str());
+    remove(sourcePath.c_str());
+}
+
+//Saves an AtlasMap whose keys were added out of order (the key map is sorted, the frames aren't) and reloads it, every
+//index has to have the same key and the same frame, bit for bit, and every key has to resolve to the same index
+static void TestAtlasIndices()
+{
+    const std::string sourcePath = "MetadataCacheTests_Indices.json";
+    WriteTextFile(sourcePath, "{ \"frames\": {} }");
+
+    std::mt19937 random(44);
+    std::vector<unsigned int> order(300);
+    for (unsigned int i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), random);
+
+    std::uniform_real_distribution<float> coordinate(0.0f, 2048.0f);
+    AtlasMap* atlasMap = new AtlasMap();
+    for (unsigned int i = 0; i < order.size(); i++)
+    {
+        std::ostringstream key;
+        key << "Sprites/Frame_" << order[i] << ".png";
+        atlasMap->Create(key.str(), Rect(Vector2(coordinate(random), coordinate(random)), Vector2(coordinate(random) / 7.0f, coordinate(random) / 3.0f)));
+    }
+
+    //Replacing a key's frame keeps its index
+    unsigned int replacedIndex = atlasMap->GetIndex("Sprites/Frame_7.png");
+    atlasMap->Create("Sprites/Frame_7.png", Rect(Vector2(0.1f, 0.2f), Vector2(0.3f, 0.4f)));
+    TEST_CHECK(atlasMap->GetIndex("Sprites/Frame_7.png") == replacedIndex && atlasMap->Count() == order.size());
+
+    AtlasMap* loaded = nullptr;
+    TEST_CHECK(SaveAtlas(sourcePath, atlasMap) == true);
+    TEST_CHECK(MetadataCache::LoadAtlasMap(sourcePath, &loaded) == true);
+    if (loaded != nullptr)
+    {
+        bool isIdentical = loaded->Count() == atlasMap->Count();
+        for (unsigned int i = 0; i < atlasMap->Count() && isIdentical == true; i++)
+        {
+            isIdentical = loaded->GetKey(i) == atlasMap->GetKey(i) && loaded->GetIndex(atlasMap->GetKey(i)) == i &&
+                memcmp(&loaded->GetFrame(i), &atlasMap->GetFrame(i), sizeof(Rect)) == 0;
+        }
+        TEST_CHECK(isIdentical == true);
+        TEST_CHECK(loaded->GetIndex("Sprites/Frame_7.png") == replacedIndex && loaded->GetFrame(replacedIndex).origin == Vector2(0.1f, 0.2f));
+        TEST_CHECK(loaded->GetIndex("Sprites/Missing.png") == ATLAS_MAP_INVALID_INDEX);
+
+        //The indices are the order the frames were added in, not the keys' order
+        TEST_CHECK(loaded->GetKey(0) == "Sprites/Frame_" + std::to_string(order[0]) + ".png");
+    }
+
+    delete loaded;
+    delete atlasMap;
+    remove(MetadataCache::GetCachePath(sourcePath).c_str());
+    remove(sourcePath.c_str());
+}
+
+static void BenchmarkLoads()
+{
+    printf("\n%8s %12s | %14s %14s\n", "frames", "json bytes", "warm load ms", "hashed load ms");
+
+    const unsigned int frameCounts[] = { 1000, 10000, 50000 };
+    for (unsigned int i = 0; i < sizeof(frameCounts) / sizeof(frameCounts[0]); i++)
+    {
+        //The source file's contents don't matter to the cache, only its size does, make it as big as a real atlas would be
+        const std::string sourcePath = "MetadataCacheTests_Benchmark.json";
+        WriteTextFile(sourcePath, std::string(frameCounts[i] * 300, ' '));
+        const time_t past = time(nullptr) - 1000;
+        SetModifiedTime(sourcePath, past);
+
+        AtlasMap* atlasMap = MakeAtlasMap(frameCounts[i]);
+        TEST_CHECK(SaveAtlas(sourcePath, atlasMap) == true);
+        delete atlasMap;
+
+        const unsigned int iterations = 10;
+
+        //The modification time matches, the source file is only stat'd
+        double warmMs = 1e30;
+        for (unsigned int j = 0; j < iterations; j++)
+        {
+            Tests::Timer timer;
+            TEST_CHECK(LoadsAtlas(sourcePath, frameCounts[i]) == true);
+            warmMs = std::min(warmMs, timer.GetMilliseconds());
+        }
+
+        //The source file was touched before every load, it is read and hashed (and the cache's header is refreshed)
+        double hashedMs = 1e30;
+        for (unsigned int j = 0; j < iterations; j++)
+        {
+            SetModifiedTime(sourcePath, past + 1 + j);
+            Tests::Timer timer;
+            TEST_CHECK(LoadsAtlas(sourcePath, frameCounts[i]) == true);
+            hashedMs = std::min(hashedMs, timer.GetMilliseconds());
+        }
+
+        printf("%8u %12u | %14.3f %14.3f\n", frameCounts[i], frameCounts[i] * 300, warmMs, hashedMs);
+
+        remove(MetadataCache::GetCachePath(sourcePath).c_str());
+        remove(sourcePath.c_str());
+    }
+}
+
+int main()
+{
+    TestInvalidation();
+    TestAtlasIndices();
+    BenchmarkLoads();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All MetadataCache tests passed" : "MetadataCache tests FAILED");
+    return Tests::Failures();
+}
+
+//Texture.cpp depends on OpenGL, MetadataCache.cpp references it but the tests don't load fonts, so it's stubbed out
+namespace GameDev2D
+{
+    Texture::~Texture() {}
+}
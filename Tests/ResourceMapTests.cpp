@@ -0,0 +1,122 @@
+//Tests the ResourceMap against a std::map while resources are created and removed at random, then benchmarks looking
+//resources up by ResourceId and by key against the std::map keyed by filename that the ResourceManager used before.
+//
+//Sources: Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Services/ResourceManager/ResourceMap.h"
+#include <random>
+
+using namespace GameDev2D;
+
+
+//Returns a filename like the ones the ResourceManager's resources are keyed by
+static std::string MakeKey(unsigned int aIndex)
+{
+    std::ostringstream key;
+    key << "Assets/Images/Sprites/Sprite_" << aIndex << ".png";
+    return key.str();
+}
+
+static void TestChurn()
+{
+    std::mt19937 random(42);
+    ResourceMap<unsigned int> resourceMap;
+    std::map<std::string, unsigned int> expected;
+
+    //Create, replace and remove keys from a small pool, so that the probe sequences are constantly shifted around
+    unsigned int mismatches = 0;
+    for (unsigned int i = 0; i < 200000; i++)
+    {
+        std::string key = MakeKey(random() % 2000);
+        switch (random() % 3)
+        {
+        case 0: mismatches += resourceMap.Create(key, i) == false ? 1 : 0; expected[key] = i; break;
+        case 1: resourceMap.Remove(key); expected.erase(key); break;
+        default: resourceMap.Remove(MakeResourceId(key)); expected.erase(key); break;
+        }
+
+        std::string lookup = MakeKey(random() % 2000);
+        std::map<std::string, unsigned int>::const_iterator iterator = expected.find(lookup);
+        unsigned int value = iterator != expected.end() ? iterator->second : 0;
+        if (resourceMap.Contains(lookup) != (iterator != expected.end()) || resourceMap.Get(lookup) != value || resourceMap.Get(MakeResourceId(lookup)) != value)
+        {
+            mismatches++;
+        }
+    }
+
+    TEST_CHECK(mismatches == 0);
+    TEST_CHECK(resourceMap.Count() == expected.size());
+
+    //Every remaining key is still found, by key and by id
+    for (std::map<std::string, unsigned int>::const_iterator iterator = expected.begin(); iterator != expected.end(); iterator++)
+    {
+        TEST_CHECK(resourceMap.Get(iterator->first) == iterator->second && resourceMap.Contains(MakeResourceId(iterator->first)) == true);
+    }
+
+    resourceMap.Clear();
+    TEST_CHECK(resourceMap.Count() == 0 && resourceMap.Contains(MakeKey(0)) == false);
+}
+
+static void BenchmarkLookups()
+{
+    printf("\n%10s | %14s %14s %14s\n", "resources", "by id ns", "by key ns", "std::map ns");
+
+    const unsigned int resourceCounts[] = { 16, 256, 4096 };
+    for (unsigned int i = 0; i < sizeof(resourceCounts) / sizeof(resourceCounts[0]); i++)
+    {
+        ResourceMap<unsigned int> resourceMap;
+        std::map<std::string, unsigned int> stdMap;
+        std::vector<std::string> keys;
+        std::vector<ResourceId> ids;
+        for (unsigned int j = 0; j < resourceCounts[i]; j++)
+        {
+            keys.push_back(MakeKey(j));
+            ids.push_back(MakeResourceId(keys.back()));
+            resourceMap.Create(keys.back(), j);
+            stdMap[keys.back()] = j;
+        }
+
+        //Look the resources up in a shuffled order, the way a frame's draw calls would
+        std::vector<unsigned int> order;
+        std::mt19937 random(7);
+        for (unsigned int j = 0; j < 1000000; j++)
+        {
+            order.push_back(random() % resourceCounts[i]);
+        }
+
+        unsigned int sum = 0;
+        Tests::Timer timer;
+        for (unsigned int j = 0; j < order.size(); j++)
+        {
+            sum += resourceMap.Get(ids[order[j]]);
+        }
+        double idNs = timer.GetMilliseconds() * 1e6 / order.size();
+
+        timer.Restart();
+        for (unsigned int j = 0; j < order.size(); j++)
+        {
+            sum += resourceMap.Get(keys[order[j]]);
+        }
+        double keyNs = timer.GetMilliseconds() * 1e6 / order.size();
+
+        timer.Restart();
+        for (unsigned int j = 0; j < order.size(); j++)
+        {
+            sum += stdMap[keys[order[j]]];
+        }
+        double stdMapNs = timer.GetMilliseconds() * 1e6 / order.size();
+
+        Tests::KeepAlive(sum);
+        printf("%10u | %14.2f %14.2f %14.2f\n", resourceCounts[i], idNs, keyNs, stdMapNs);
+    }
+}
+
+int main()
+{
+    TestChurn();
+    BenchmarkLookups();
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All ResourceMap tests passed" : "ResourceMap tests FAILED");
+    return Tests::Failures();
+}
@@ -0,0 +1,431 @@
+//Tests the SpatialIndex against brute force and benchmarks it. The Drawables are boxes of 8 - 96 units, rotated and
+//scaled, spread over a 10k x 10k world either uniformly OR in 20 clusters, and 1% of them are large enough to be kept in
+//the oversized list. QueryRegion() (from a point sized region to the whole world), QueryPoint() (including points on a
+//Drawable's edge) and QueryPairs() have to find exactly the Drawables and pairs a brute force search over every Drawable
+//finds, each one once. They're checked after the Drawables are added, after a third of them move (within their cells
+//and across the world), after a quarter are removed (by Remove() OR by being deleted), and after the cell size changes.
+//Then each query is timed against brute force with 10k Drawables, along with adding them and the Update() after 10% move.
+//
+//Sources: Source/Framework/Services/SpatialIndex/SpatialIndex.cpp Source/Framework/Core/Drawable.cpp
+//         Source/Framework/Core/Transformable.cpp Source/Framework/Math/TransformKernels.cpp
+//         Source/Framework/Math/AffineTransform.cpp Source/Framework/Math/Matrix.cpp Source/Framework/Math/Rotation.cpp
+//         Source/Framework/Math/Vector2.cpp Source/Framework/Math/Math.cpp Source/Framework/Math/Random.cpp
+//         Source/Framework/Graphics/Color.cpp Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Services/SpatialIndex/SpatialIndex.h"
+#include "../Source/Framework/Core/Drawable.h"
+#include <algorithm>
+#include <random>
+
+using namespace GameDev2D;
+
+
+//The size of the world the Drawables are spread over
+const float TEST_WORLD_SIZE = 10000.0f;
+
+//The number of Drawables that are checked against brute force, and that are benchmarked
+const unsigned int TEST_CHECKED_DRAWABLES = 3000;
+const unsigned int TEST_BENCHMARK_DRAWABLES = 10000;
+
+//The number of queries each check and each benchmark runs
+const unsigned int TEST_QUERIES = 500;
+
+//A Drawable with a size, it doesn't draw anything
+class Box : public Drawable
+{
+public:
+    Box(float aWidth, float aHeight) :
+        m_Width(aWidth),
+        m_Height(aHeight)
+    {
+    }
+
+    void Draw() {}
+    float GetWidth() { return m_Width; }
+    float GetHeight() { return m_Height; }
+
+    void SetSize(float aWidth, float aHeight)
+    {
+        m_Width = aWidth;
+        m_Height = aHeight;
+        EdgesAreDirty();
+    }
+
+private:
+    float m_Width;
+    float m_Height;
+};
+
+enum Distribution
+{
+    UniformDistribution = 0,
+    ClusteredDistribution
+};
+
+//Creates the boxes and keeps track of the ones that are in the index
+class World
+{
+public:
+    World(Distribution aDistribution, unsigned int aCount, unsigned int aSeed) :
+        m_Distribution(aDistribution),
+        m_Random(aSeed)
+    {
+        std::uniform_real_distribution<float> uniform(0.0f, TEST_WORLD_SIZE);
+        for (unsigned int i = 0; i < 20; i++)
+        {
+            m_Clusters.push_back(Vector2(uniform(m_Random), uniform(m_Random)));
+        }
+
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            std::uniform_real_distribution<float> size(8.0f, 96.0f);
+            bool isLarge = i % 100 == 99;
+            Box* box = new Box(isLarge == true ? 2500.0f : size(m_Random), isLarge == true ? 1500.0f : size(m_Random));
+            Place(box, RandomPosition());
+            boxes.push_back(box);
+        }
+    }
+
+    ~World()
+    {
+        for (unsigned int i = 0; i < boxes.size(); i++)
+        {
+            delete boxes[i];
+        }
+    }
+
+    //Returns a position in the world, uniformly OR in one of the clusters
+    Vector2 RandomPosition()
+    {
+        if (m_Distribution == UniformDistribution)
+        {
+            std::uniform_real_distribution<float> uniform(0.0f, TEST_WORLD_SIZE);
+            return Vector2(uniform(m_Random), uniform(m_Random));
+        }
+
+        std::normal_distribution<float> spread(0.0f, 150.0f);
+        const Vector2& cluster = m_Clusters[m_Random() % m_Clusters.size()];
+        return Vector2(cluster.x + spread(m_Random), cluster.y + spread(m_Random));
+    }
+
+    //Moves a box, and rotates, scales and anchors it randomly
+    void Place(Box* aBox, Vector2 aPosition)
+    {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        aBox->SetPosition(aPosition);
+        aBox->SetRadians(unit(m_Random) * 6.2831853f);
+        aBox->SetScale(0.5f + unit(m_Random), 0.5f + unit(m_Random));
+        aBox->SetAnchor(unit(m_Random), unit(m_Random));
+    }
+
+    //Changes one in every fraction of the boxes: nudges it, moves it anywhere, rotates it OR resizes it
+    void Move(unsigned int aFraction)
+    {
+        std::normal_distribution<float> nudge(0.0f, 4.0f);
+        std::uniform_real_distribution<float> size(8.0f, 96.0f);
+        for (unsigned int i = 0; i < boxes.size(); i++)
+        {
+            if (boxes[i] == nullptr || m_Random() % aFraction != 0)
+            {
+                continue;
+            }
+
+            unsigned int kind = m_Random() % 4;
+            if (kind == 0)
+            {
+                boxes[i]->SetPosition(boxes[i]->GetPosition() + Vector2(nudge(m_Random), nudge(m_Random)));
+            }
+            else if (kind == 1)
+            {
+                Place(boxes[i], RandomPosition());
+            }
+            else if (kind == 2)
+            {
+                boxes[i]->SetRadians(boxes[i]->GetRadians() + 0.1f);
+            }
+            else
+            {
+                boxes[i]->SetSize(size(m_Random), size(m_Random));
+            }
+        }
+    }
+
+    //Deletes a quarter of the boxes, half of them are removed from the index first (twice, the second one does nothing)
+    void Remove(SpatialIndex& aIndex)
+    {
+        for (unsigned int i = 0; i < boxes.size(); i++)
+        {
+            if (boxes[i] != nullptr && m_Random() % 4 == 0)
+            {
+                if (m_Random() % 2 == 0)
+                {
+                    aIndex.Remove(boxes[i]);
+                    aIndex.Remove(boxes[i]);
+                }
+                delete boxes[i];
+                boxes[i] = nullptr;
+            }
+        }
+    }
+
+    //Returns a random region, from a point to the whole world, OR a point on a box's edge
+    Rect RandomRegion(unsigned int aQuery)
+    {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        Vector2 origin = RandomPosition();
+        switch (aQuery % 5)
+        {
+        case 0: return Rect(origin, Vector2(0.0f, 0.0f));
+        case 1: return Rect(origin, Vector2(unit(m_Random) * 300.0f, unit(m_Random) * 300.0f));
+        case 2: return Rect(origin, Vector2(1280.0f, 720.0f));
+        case 3: return Rect(Vector2(-100.0f, -100.0f), Vector2(TEST_WORLD_SIZE + 200.0f, TEST_WORLD_SIZE + 200.0f));
+        default:
+        {
+            Box* box = boxes[m_Random() % boxes.size()];
+            return box != nullptr ? Rect(Vector2(box->GetLeftEdge(), box->GetBottomEdge()), Vector2(0.0f, 0.0f)) : Rect(origin, Vector2(0.0f, 0.0f));
+        }
+        }
+    }
+
+    std::vector<Box*> boxes;
+
+private:
+    Distribution m_Distribution;
+    std::vector<Vector2> m_Clusters;
+    std::mt19937 m_Random;
+};
+
+//The edges of the boxes in the world, the way the brute force searches read them
+struct Edges
+{
+    Drawable* drawable;
+    float left;
+    float right;
+    float bottom;
+    float top;
+};
+
+static std::vector<Edges> GetEdges(World& aWorld)
+{
+    std::vector<Edges> edges;
+    for (unsigned int i = 0; i < aWorld.boxes.size(); i++)
+    {
+        Box* box = aWorld.boxes[i];
+        if (box != nullptr)
+        {
+            Edges boxEdges = { box, box->GetLeftEdge(), box->GetRightEdge(), box->GetBottomEdge(), box->GetTopEdge() };
+            edges.push_back(boxEdges);
+        }
+    }
+    return edges;
+}
+
+//Edges that touch overlap, like they do in the index
+static inline bool Overlaps(const Edges& aEdges, float aLeft, float aRight, float aBottom, float aTop)
+{
+    return aEdges.left <= aRight && aLeft <= aEdges.right && aEdges.bottom <= aTop && aBottom <= aEdges.top;
+}
+
+static void BruteForceRegion(const std::vector<Edges>& aEdges, const Rect& aRegion, std::vector<Drawable*>& aResults)
+{
+    float right = aRegion.origin.x + aRegion.size.x;
+    float top = aRegion.origin.y + aRegion.size.y;
+    for (unsigned int i = 0; i < aEdges.size(); i++)
+    {
+        if (Overlaps(aEdges[i], aRegion.origin.x, right, aRegion.origin.y, top) == true)
+        {
+            aResults.push_back(aEdges[i].drawable);
+        }
+    }
+}
+
+static void BruteForcePairs(const std::vector<Edges>& aEdges, std::vector<std::pair<Drawable*, Drawable*>>& aPairs)
+{
+    for (unsigned int i = 0; i < aEdges.size(); i++)
+    {
+        for (unsigned int j = i + 1; j < aEdges.size(); j++)
+        {
+            if (Overlaps(aEdges[i], aEdges[j].left, aEdges[j].right, aEdges[j].bottom, aEdges[j].top) == true)
+            {
+                aPairs.push_back(std::make_pair(aEdges[i].drawable, aEdges[j].drawable));
+            }
+        }
+    }
+}
+
+//Sorts the pairs, each pair is in the same order, so that they can be compared
+static void SortPairs(std::vector<std::pair<Drawable*, Drawable*>>& aPairs)
+{
+    for (unsigned int i = 0; i < aPairs.size(); i++)
+    {
+        if (aPairs[i].second < aPairs[i].first)
+        {
+            std::swap(aPairs[i].first, aPairs[i].second);
+        }
+    }
+    std::sort(aPairs.begin(), aPairs.end());
+}
+
+//Checks every query against brute force, returns the number of Drawables and pairs that were found
+static unsigned int CheckQueries(const char* aStep, World& aWorld, SpatialIndex& aIndex)
+{
+    std::vector<Edges> edges = GetEdges(aWorld);
+    TEST_CHECK(aIndex.GetCount() == edges.size());
+
+    bool isRegionCorrect = true;
+    bool isPointCorrect = true;
+    unsigned int found = 0;
+    std::vector<Drawable*> results;
+    std::vector<Drawable*> expected;
+    for (unsigned int i = 0; i < TEST_QUERIES; i++)
+    {
+        Rect region = aWorld.RandomRegion(i);
+        results.clear();
+        expected.clear();
+        bool isPoint = region.size.x == 0.0f && region.size.y == 0.0f;
+        unsigned int count = isPoint == true ? aIndex.QueryPoint(region.origin, results) : aIndex.QueryRegion(region, results);
+        BruteForceRegion(edges, region, expected);
+
+        std::sort(results.begin(), results.end());
+        std::sort(expected.begin(), expected.end());
+        bool isCorrect = count == results.size() && results == expected;
+        isRegionCorrect = isRegionCorrect && (isPoint == true || isCorrect == true);
+        isPointCorrect = isPointCorrect && (isPoint == false || isCorrect == true);
+        found += count;
+    }
+
+    std::vector<std::pair<Drawable*, Drawable*>> pairs;
+    std::vector<std::pair<Drawable*, Drawable*>> expectedPairs;
+    unsigned int pairCount = aIndex.QueryPairs(pairs);
+    BruteForcePairs(edges, expectedPairs);
+    SortPairs(pairs);
+    SortPairs(expectedPairs);
+    bool isPairsCorrect = pairCount == pairs.size() && pairs == expectedPairs;
+
+    printf("%-22s | %6u %6u %10u %8u | %s %s %s\n", aStep, (unsigned int)edges.size(), aIndex.GetCellCount(), found, pairCount,
+        isRegionCorrect == true ? "ok" : "WRONG", isPointCorrect == true ? "ok" : "WRONG", isPairsCorrect == true ? "ok" : "WRONG");
+    TEST_CHECK(isRegionCorrect == true);
+    TEST_CHECK(isPointCorrect == true);
+    TEST_CHECK(isPairsCorrect == true);
+    return found + pairCount;
+}
+
+static void TestQueries(Distribution aDistribution)
+{
+    printf("%s, %u Drawables\n", aDistribution == UniformDistribution ? "uniform" : "clustered", TEST_CHECKED_DRAWABLES);
+    printf("%-22s | %6s %6s %10s %8s | region point pairs\n", "", "count", "cells", "found", "pairs");
+
+    World world(aDistribution, TEST_CHECKED_DRAWABLES, 49);
+    SpatialIndex index;
+    for (unsigned int i = 0; i < world.boxes.size(); i++)
+    {
+        index.Add(world.boxes[i]);
+    }
+    CheckQueries("added", world, index);
+
+    world.Move(3);
+    CheckQueries("a third moved", world, index);
+
+    //Moving them again before the index is queried, the index only updates them once
+    world.Move(3);
+    world.Move(3);
+    CheckQueries("moved twice", world, index);
+
+    world.Remove(index);
+    CheckQueries("a quarter removed", world, index);
+
+    //The removed boxes' proxies are reused
+    for (unsigned int i = 0; i < world.boxes.size(); i++)
+    {
+        if (world.boxes[i] == nullptr)
+        {
+            world.boxes[i] = new Box(32.0f, 32.0f);
+            world.Place(world.boxes[i], world.RandomPosition());
+            index.Add(world.boxes[i]);
+        }
+    }
+    CheckQueries("re-added", world, index);
+
+    index.SetCellSize(48.0f);
+    CheckQueries("48 unit cells", world, index);
+    world.Move(2);
+    CheckQueries("half moved", world, index);
+    printf("\n");
+}
+
+//Returns the us each brute force search OR query takes, the best of 3 runs
+template<typename Function> static double Time(unsigned int aRepeats, Function aFunction)
+{
+    double best = 1.0e30;
+    for (unsigned int run = 0; run < 3; run++)
+    {
+        Tests::Timer timer;
+        aFunction();
+        best = std::min(best, timer.GetMilliseconds() * 1000.0 / aRepeats);
+    }
+    return best;
+}
+
+static void Benchmark(Distribution aDistribution)
+{
+    World world(aDistribution, TEST_BENCHMARK_DRAWABLES, 50);
+    std::vector<Rect> screens;
+    std::vector<Vector2> points;
+    for (unsigned int i = 0; i < TEST_QUERIES; i++)
+    {
+        screens.push_back(Rect(world.RandomPosition(), Vector2(1280.0f, 720.0f)));
+        points.push_back(world.RandomPosition());
+    }
+
+    SpatialIndex index;
+    double add = Time(1, [&]()
+    {
+        index.Clear();
+        for (unsigned int i = 0; i < world.boxes.size(); i++)
+        {
+            index.Add(world.boxes[i]);
+        }
+        index.Update();
+    });
+
+    //A frame where 10% of the Drawables moved
+    double update = 1.0e30;
+    for (unsigned int run = 0; run < 3; run++)
+    {
+        world.Move(10);
+        Tests::Timer timer;
+        index.Update();
+        update = std::min(update, timer.GetMilliseconds() * 1000.0);
+    }
+
+    std::vector<Edges> edges = GetEdges(world);
+    std::vector<Drawable*> results;
+    std::vector<std::pair<Drawable*, Drawable*>> pairs;
+    unsigned int found = 0;
+
+    double regionIndex = Time(TEST_QUERIES, [&]() { for (unsigned int i = 0; i < screens.size(); i++) { results.clear(); found += index.QueryRegion(screens[i], results); } });
+    double regionBrute = Time(TEST_QUERIES, [&]() { for (unsigned int i = 0; i < screens.size(); i++) { results.clear(); BruteForceRegion(edges, screens[i], results); found += (unsigned int)results.size(); } });
+    double pointIndex = Time(TEST_QUERIES, [&]() { for (unsigned int i = 0; i < points.size(); i++) { results.clear(); found += index.QueryPoint(points[i], results); } });
+    double pointBrute = Time(TEST_QUERIES, [&]() { for (unsigned int i = 0; i < points.size(); i++) { results.clear(); BruteForceRegion(edges, Rect(points[i], Vector2(0.0f, 0.0f)), results); found += (unsigned int)results.size(); } });
+    double pairsIndex = Time(1, [&]() { pairs.clear(); found += index.QueryPairs(pairs); });
+    double pairsBrute = Time(1, [&]() { pairs.clear(); BruteForcePairs(edges, pairs); found += (unsigned int)pairs.size(); });
+    Tests::KeepAlive(found);
+
+    printf("%-10s | %8.0f %8.1f | %8.2f %8.1f | %8.2f %8.1f | %9.0f %9.0f\n", aDistribution == UniformDistribution ? "uniform" : "clustered",
+        add, update, regionIndex, regionBrute, pointIndex, pointBrute, pairsIndex, pairsBrute);
+}
+
+int main()
+{
+    TestQueries(UniformDistribution);
+    TestQueries(ClusteredDistribution);
+
+    printf("us per call, %uk Drawables, 1%% oversized. update = Update() after 10%% moved, region = a 1280 x 720 screen\n", TEST_BENCHMARK_DRAWABLES / 1000);
+    printf("%-10s | %8s %8s | %8s %8s | %8s %8s | %9s %9s\n", "", "add 10k", "update", "region", "brute", "point", "brute", "pairs", "brute");
+    Benchmark(UniformDistribution);
+    Benchmark(ClusteredDistribution);
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All SpatialIndex tests passed" : "SpatialIndex tests FAILED");
+    return Tests::Failures();
+}
@@ -0,0 +1,143 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+//glibc lets a program replace malloc(), the replacements count the calls and forward them to glibc's own
+#if defined(__GLIBC__)
+#define ALLOCATION_COUNTER_COUNTS_MALLOC 1
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* pointer, size_t size);
+#else
+#define ALLOCATION_COUNTER_COUNTS_MALLOC 0
+#endif
+
+
+namespace Tests
+{
+    //Each allocation is prefixed with its size, padded so that the memory returned keeps malloc's alignment
+    const size_t ALLOCATION_COUNTER_HEADER_SIZE = 16;
+
+    //The counters are atomic, some of the programs allocate from several threads
+    static std::atomic<size_t> s_CurrentBytes(0);
+    static std::atomic<size_t> s_PeakBytes(0);
+    static std::atomic<size_t> s_AllocationCount(0);
+    static std::atomic<size_t> s_MallocCount(0);
+
+    size_t AllocationCounter::GetCurrentBytes()
+    {
+        return s_CurrentBytes;
+    }
+
+    size_t AllocationCounter::GetPeakBytes()
+    {
+        return s_PeakBytes;
+    }
+
+    size_t AllocationCounter::GetAllocationCount()
+    {
+        return s_AllocationCount;
+    }
+
+    size_t AllocationCounter::GetHeapAllocationCount()
+    {
+        return ALLOCATION_COUNTER_COUNTS_MALLOC == 1 ? s_MallocCount.load() : s_AllocationCount.load();
+    }
+
+    bool AllocationCounter::IsMallocCounted()
+    {
+        return ALLOCATION_COUNTER_COUNTS_MALLOC == 1;
+    }
+
+    void AllocationCounter::ResetPeak()
+    {
+        s_PeakBytes = s_CurrentBytes.load();
+        s_AllocationCount = 0;
+        s_MallocCount = 0;
+    }
+
+    static void CountMalloc()
+    {
+        s_MallocCount++;
+    }
+
+    static void* Allocate(size_t aSize)
+    {
+        unsigned char* memory = static_cast<unsigned char*>(malloc(aSize + ALLOCATION_COUNTER_HEADER_SIZE));
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        *reinterpret_cast<size_t*>(memory) = aSize;
+        size_t currentBytes = s_CurrentBytes += aSize;
+        s_AllocationCount++;
+        size_t peakBytes = s_PeakBytes.load();
+        while (currentBytes > peakBytes && s_PeakBytes.compare_exchange_weak(peakBytes, currentBytes) == false)
+        {
+        }
+
+        return memory + ALLOCATION_COUNTER_HEADER_SIZE;
+    }
+
+    static void Deallocate(void* aPointer)
+    {
+        if (aPointer != nullptr)
+        {
+            unsigned char* memory = static_cast<unsigned char*>(aPointer) - ALLOCATION_COUNTER_HEADER_SIZE;
+            s_CurrentBytes -= *reinterpret_cast<size_t*>(memory);
+            free(memory);
+        }
+    }
+}
+
+void* operator new(size_t aSize)
+{
+    return Tests::Allocate(aSize);
+}
+
+void* operator new[](size_t aSize)
+{
+    return Tests::Allocate(aSize);
+}
+
+void operator delete(void* aPointer) noexcept
+{
+    Tests::Deallocate(aPointer);
+}
+
+void operator delete[](void* aPointer) noexcept
+{
+    Tests::Deallocate(aPointer);
+}
+
+void operator delete(void* aPointer, size_t) noexcept
+{
+    Tests::Deallocate(aPointer);
+}
+
+void operator delete[](void* aPointer, size_t) noexcept
+{
+    Tests::Deallocate(aPointer);
+}
+
+#if ALLOCATION_COUNTER_COUNTS_MALLOC == 1
+extern "C" void* malloc(size_t aSize)
+{
+    Tests::CountMalloc();
+    return __libc_malloc(aSize);
+}
+
+extern "C" void* calloc(size_t aCount, size_t aSize)
+{
+    Tests::CountMalloc();
+    return __libc_calloc(aCount, aSize);
+}
+
+extern "C" void* realloc(void* aPointer, size_t aSize)
+{
+    Tests::CountMalloc();
+    return __libc_realloc(aPointer, aSize);
+}
+#endif
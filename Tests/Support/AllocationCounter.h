@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+
+
+namespace Tests
+{
+    //AllocationCounter.cpp replaces the global operator new and delete to count the heap memory in use. Link it
+    //into the benchmarks that report peak memory OR allocation counts. With glibc, malloc(), calloc() and realloc()
+    //are counted as well (code like jsoncpp's Values calls malloc() directly), their memory isn't
+    struct AllocationCounter
+    {
+        //Returns the number of bytes currently allocated
+        static size_t GetCurrentBytes();
+
+        //Returns the highest number of bytes allocated since the last ResetPeak()
+        static size_t GetPeakBytes();
+
+        //Returns the number of allocations since the last ResetPeak()
+        static size_t GetAllocationCount();
+
+        //Returns the number of heap allocations since the last ResetPeak(): the operator new allocations, and the
+        //malloc() calls if IsMallocCounted() (operator new calls malloc(), it's counted once)
+        static size_t GetHeapAllocationCount();
+
+        //Returns true if the malloc() calls are counted by GetHeapAllocationCount()
+        static bool IsMallocCounted();
+
+        //Resets the peak to the number of bytes currently allocated
+        static void ResetPeak();
+    };
+}
@@ -0,0 +1,42 @@
+#include "../../Source/Framework/Debug/Log.h"
+#include <stdexcept>
+#include <stdio.h>
+
+
+//The test programs don't have an output window OR a working directory, log messages are discarded and errors are printed
+namespace GameDev2D
+{
+    bool Log::s_IsInitialized = false;
+
+    void Log::Init()
+    {
+        s_IsInitialized = true;
+    }
+
+    void Log::Message(std::string aMessage, ...)
+    {
+    }
+
+    void Log::Message(Verbosity aVerbosity, std::string aMessage, ...)
+    {
+    }
+
+    void Log::Error(bool aThrowException, Verbosity aVerbosity, std::string aMessage, ...)
+    {
+        va_list arguments;
+        va_start(arguments, aMessage);
+        char outputBuffer[4096];
+        vsnprintf(outputBuffer, sizeof(outputBuffer), aMessage.c_str(), arguments);
+        va_end(arguments);
+
+        fprintf(stderr, "[Error] %s\n", outputBuffer);
+        if (aThrowException == true)
+        {
+            throw std::runtime_error(outputBuffer);
+        }
+    }
+
+    void Log::Output(bool aError, Verbosity aVerbosity, const char* aOutput, va_list aArgumentsList)
+    {
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+//Forced include for the test programs, in place of Windows/stdafx.h. The programs only compile the framework
+//sources they exercise, so only the standard headers and the framework headers every source expects are included
+#ifndef _USE_MATH_DEFINES
+#define _USE_MATH_DEFINES
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "../../Source/Framework/Debug/Log.h"
+#include "../../Source/Framework/Events/EventHandler.h"
+#include "../../Source/Framework/Math/Math.h"
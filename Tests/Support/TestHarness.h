@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <stdio.h>
+
+
+namespace Tests
+{
+    //Returns the number of checks that failed, main() returns it so that a failing program exits with an error
+    inline int& Failures()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    //Reports a failed check, with the file and line of the check
+    inline void Fail(const char* aCondition, const char* aFile, int aLine)
+    {
+        printf("FAILED: %s (%s:%d)\n", aCondition, aFile, aLine);
+        Failures()++;
+    }
+
+    //Measures the time elapsed since the Timer was created OR last restarted
+    class Timer
+    {
+    public:
+        Timer() :
+            m_Start(std::chrono::high_resolution_clock::now())
+        {
+        }
+
+        void Restart()
+        {
+            m_Start = std::chrono::high_resolution_clock::now();
+        }
+
+        double GetMilliseconds() const
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_Start).count();
+        }
+
+    private:
+        std::chrono::high_resolution_clock::time_point m_Start;
+    };
+
+    //Stores a benchmark's result where the optimizer can't see it, so that the work isn't optimized away
+    template<typename T> void KeepAlive(const T& aValue)
+    {
+        static volatile unsigned char sink;
+        const volatile unsigned char* bytes = reinterpret_cast<const volatile unsigned char*>(&aValue);
+        for (unsigned int i = 0; i < sizeof(T); i++)
+        {
+            sink ^= bytes[i];
+        }
+    }
+}
+
+//Checks a condition, a failed check is reported but doesn't stop the program
+#define TEST_CHECK(condition) do { if (!(condition)) { Tests::Fail(#condition, __FILE__, __LINE__); } } while (0)
@@ -0,0 +1,336 @@
+//Benchmarks the TransformKernels at 1k, 10k and 100k objects: the world transforms, the bounds and the quads' corners,
+//against the per-object code they replaced (AffineTransform::Make() into a Matrix, Drawable::CalculateEdges()' math with
+//sinf() and cosf(), and the SpriteBatch's Matrix * corner offsets). Then Transformables' matrices rebuilt one at a time by
+//GetTransformMatrix(), against UpdateTransformMatrices().
+//The results are checked as well: the SSE2 sine and cosine against the double precision ones, the SSE2 kernels against
+//the scalar ones, and a matrix has to be the same, bit for bit, whether GetTransformMatrix() or UpdateTransformMatrices()
+//rebuilt it.
+//
+//Sources: Source/Framework/Math/TransformKernels.cpp Source/Framework/Core/Transformable.cpp
+//         Source/Framework/Math/AffineTransform.cpp Source/Framework/Math/Matrix.cpp Source/Framework/Math/Rotation.cpp
+//         Source/Framework/Math/Vector2.cpp Source/Framework/Math/Math.cpp Source/Framework/Math/Random.cpp
+//         Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Math/TransformKernels.h"
+#include "../Source/Framework/Core/Transformable.h"
+#include <math.h>
+#include <random>
+#include <string.h>
+
+using namespace GameDev2D;
+
+
+//The transforms of N objects, random like a large sprite population's
+struct Objects
+{
+    Objects(unsigned int aCount) :
+        positionX(aCount),
+        positionY(aCount),
+        radians(aCount),
+        scaleX(aCount),
+        scaleY(aCount),
+        anchorX(aCount),
+        anchorY(aCount),
+        width(aCount),
+        height(aCount)
+    {
+        std::mt19937 random(aCount);
+        std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+        std::uniform_real_distribution<float> angle(-6.3f, 6.3f);
+        std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> size(8.0f, 256.0f);
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            positionX[i] = position(random);
+            positionY[i] = position(random);
+            radians[i] = angle(random);
+            scaleX[i] = scale(random);
+            scaleY[i] = scale(random);
+            anchorX[i] = unit(random);
+            anchorY[i] = unit(random);
+            width[i] = size(random);
+            height[i] = size(random);
+        }
+
+        arrays.positionX = positionX.data();
+        arrays.positionY = positionY.data();
+        arrays.radians = radians.data();
+        arrays.scaleX = scaleX.data();
+        arrays.scaleY = scaleY.data();
+        arrays.anchorX = anchorX.data();
+        arrays.anchorY = anchorY.data();
+        arrays.width = width.data();
+        arrays.height = height.data();
+    }
+
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> radians;
+    std::vector<float> scaleX;
+    std::vector<float> scaleY;
+    std::vector<float> anchorX;
+    std::vector<float> anchorY;
+    std::vector<float> width;
+    std::vector<float> height;
+    TransformArrays arrays;
+};
+
+static std::vector<Transformable> MakeTransformables(const Objects& aObjects)
+{
+    std::vector<Transformable> transformables(aObjects.positionX.size());
+    for (unsigned int i = 0; i < transformables.size(); i++)
+    {
+        transformables[i].SetPosition(aObjects.positionX[i], aObjects.positionY[i]);
+        transformables[i].SetRadians(aObjects.radians[i]);
+        transformables[i].SetScale(aObjects.scaleX[i], aObjects.scaleY[i]);
+    }
+    return transformables;
+}
+
+static void TestResults()
+{
+    //The sine and cosine, over the range they're accurate for
+    const unsigned int angleCount = 1000000;
+    std::vector<float> angles(angleCount);
+    for (unsigned int i = 0; i < angleCount; i++)
+    {
+        angles[i] = -8192.0f + 16384.0f * (float)i / (float)angleCount;
+    }
+
+    std::vector<float> sines(angleCount);
+    std::vector<float> cosines(angleCount);
+    TransformKernels::SinCos(angles.data(), sines.data(), cosines.data(), angleCount);
+
+    double worstSinCos = 0.0;
+    for (unsigned int i = 0; i < angleCount; i++)
+    {
+        worstSinCos = std::max(worstSinCos, fabs(sines[i] - sin((double)angles[i])));
+        worstSinCos = std::max(worstSinCos, fabs(cosines[i] - cos((double)angles[i])));
+    }
+    TEST_CHECK(worstSinCos <= 2e-7);
+
+    //The kernels against the scalar reference versions, an odd count so that the last 4 objects are partial
+    const unsigned int count = 10003;
+    Objects objects(count);
+    std::vector<AffineTransform> transforms(count);
+    std::vector<AffineTransform> scalarTransforms(count);
+    std::vector<float> edges(count * 4);
+    std::vector<float> scalarEdges(count * 4);
+    std::vector<Vector2> corners(count * 4);
+    std::vector<Vector2> scalarCorners(count * 4);
+    TransformKernels::CalculateTransforms(objects.arrays, transforms.data(), count);
+    TransformKernels::CalculateTransformsScalar(objects.arrays, scalarTransforms.data(), count);
+    TransformKernels::CalculateBounds(objects.arrays, edges.data(), count);
+    TransformKernels::CalculateBoundsScalar(objects.arrays, scalarEdges.data(), count);
+    TransformKernels::CalculateQuads(objects.arrays, corners.data(), count);
+    TransformKernels::CalculateQuadsScalar(objects.arrays, scalarCorners.data(), count);
+
+    double worstTransform = 0.0;
+    double worstEdge = 0.0;
+    double worstCorner = 0.0;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        const float* transform = &transforms[i].m[0][0];
+        const float* scalarTransform = &scalarTransforms[i].m[0][0];
+        for (unsigned int j = 0; j < 6; j++)
+        {
+            worstTransform = std::max(worstTransform, (double)fabsf(transform[j] - scalarTransform[j]));
+        }
+        for (unsigned int j = 0; j < 4; j++)
+        {
+            worstEdge = std::max(worstEdge, (double)fabsf(edges[i * 4 + j] - scalarEdges[i * 4 + j]));
+            worstCorner = std::max(worstCorner, (double)(corners[i * 4 + j] - scalarCorners[i * 4 + j]).Length());
+        }
+    }
+    TEST_CHECK(worstTransform <= 1e-5);
+    TEST_CHECK(worstEdge <= 1e-3);
+    TEST_CHECK(worstCorner <= 1e-3);
+
+    //A Transformable's matrix is the same whether it was rebuilt on its own or with the others
+    std::vector<Transformable> single = MakeTransformables(objects);
+    std::vector<Transformable> bulk = MakeTransformables(objects);
+    std::vector<Transformable*> pointers(count);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        pointers[i] = &bulk[i];
+    }
+    Transformable::UpdateTransformMatrices(pointers.data(), count);
+
+    unsigned int mismatches = 0;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        Matrix a = single[i].GetTransformMatrix();
+        Matrix b = bulk[i].GetTransformMatrix();
+        mismatches += memcmp(a.m, b.m, sizeof(a.m)) != 0 ? 1 : 0;
+    }
+    TEST_CHECK(mismatches == 0);
+
+    printf("sincos error %.2g, SSE2 vs scalar: transforms %.2g, edges %.2g, corners %.2g, %u of %u matrices differ\n",
+        worstSinCos, worstTransform, worstEdge, worstCorner, mismatches, count);
+}
+
+//Runs a benchmark several times, returns the fastest time in microseconds
+template<typename Function> static double Measure(Function aFunction)
+{
+    double best = 1e30;
+    for (unsigned int run = 0; run < 7; run++)
+    {
+        Tests::Timer timer;
+        aFunction();
+        best = std::min(best, timer.GetMilliseconds());
+    }
+    return best * 1000.0;
+}
+
+static void Benchmark(unsigned int aCount)
+{
+    Objects objects(aCount);
+    const TransformArrays& arrays = objects.arrays;
+
+    //World transforms
+    std::vector<Matrix> matrices(aCount);
+    std::vector<AffineTransform> transforms(aCount);
+    double transformsBefore = Measure([&]()
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            matrices[i] = Matrix(AffineTransform::Make(Vector2(arrays.positionX[i], arrays.positionY[i]), arrays.radians[i], Vector2(arrays.scaleX[i], arrays.scaleY[i])));
+        }
+        Tests::KeepAlive(matrices[aCount - 1].m[3][0]);
+    });
+    double transformsScalar = Measure([&]()
+    {
+        TransformKernels::CalculateTransformsScalar(arrays, transforms.data(), aCount);
+        Tests::KeepAlive(transforms[aCount - 1].m[2][0]);
+    });
+    double transformsKernel = Measure([&]()
+    {
+        TransformKernels::CalculateTransforms(arrays, transforms.data(), aCount);
+        Tests::KeepAlive(transforms[aCount - 1].m[2][0]);
+    });
+
+    //Bounds, the math Drawable::CalculateEdges() did before the kernels
+    std::vector<float> edges(aCount * 4);
+    double boundsBefore = Measure([&]()
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            float radians = arrays.radians[i];
+            float w = arrays.width[i] * arrays.scaleX[i];
+            float h = arrays.height[i] * arrays.scaleY[i];
+            float c = cosf(radians);
+            float s = sinf(radians);
+            float cw = c * w;
+            float ch = c * h;
+            float sw = s * w;
+            float sh = s * h;
+            float ex = (fabsf(sh) + fabsf(cw)) * 0.5f;
+            float ey = (fabsf(sw) + fabsf(ch)) * 0.5f;
+            float ax = arrays.anchorX[i];
+            float ay = arrays.anchorY[i];
+
+            edges[i * 4 + 0] = arrays.positionX[i] + sh * (ay - 0.5f) - cw * (ax - 0.5f) - ex;
+            edges[i * 4 + 1] = arrays.positionX[i] + sh * (ay - 0.5f) - cw * (ax - 0.5f) + ex;
+            edges[i * 4 + 2] = arrays.positionY[i] - sw * (ax - 0.5f) - ch * (ay - 0.5f) + ey;
+            edges[i * 4 + 3] = arrays.positionY[i] - sw * (ax - 0.5f) - ch * (ay - 0.5f) - ey;
+        }
+        Tests::KeepAlive(edges[aCount * 4 - 1]);
+    });
+    double boundsScalar = Measure([&]()
+    {
+        TransformKernels::CalculateBoundsScalar(arrays, edges.data(), aCount);
+        Tests::KeepAlive(edges[aCount * 4 - 1]);
+    });
+    double boundsKernel = Measure([&]()
+    {
+        TransformKernels::CalculateBounds(arrays, edges.data(), aCount);
+        Tests::KeepAlive(edges[aCount * 4 - 1]);
+    });
+
+    //Quads, the way SpriteBatch::Draw() transforms a sprite's corner offsets by its matrix
+    std::vector<Vector2> corners(aCount * 4);
+    double quadsBefore = Measure([&]()
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            Matrix matrix = Matrix(AffineTransform::Make(Vector2(arrays.positionX[i], arrays.positionY[i]), arrays.radians[i], Vector2(arrays.scaleX[i], arrays.scaleY[i])));
+            Vector2 anchor = Vector2(arrays.anchorX[i] * arrays.width[i], arrays.anchorY[i] * arrays.height[i]);
+            corners[i * 4 + 0] = matrix * (Vector2(0.0f, arrays.height[i]) - anchor);
+            corners[i * 4 + 1] = matrix * (Vector2(arrays.width[i], arrays.height[i]) - anchor);
+            corners[i * 4 + 2] = matrix * (Vector2(arrays.width[i], 0.0f) - anchor);
+            corners[i * 4 + 3] = matrix * (Vector2(0.0f, 0.0f) - anchor);
+        }
+        Tests::KeepAlive(corners[aCount * 4 - 1].x);
+    });
+    double quadsScalar = Measure([&]()
+    {
+        TransformKernels::CalculateQuadsScalar(arrays, corners.data(), aCount);
+        Tests::KeepAlive(corners[aCount * 4 - 1].x);
+    });
+    double quadsKernel = Measure([&]()
+    {
+        TransformKernels::CalculateQuads(arrays, corners.data(), aCount);
+        Tests::KeepAlive(corners[aCount * 4 - 1].x);
+    });
+
+    //Transformables, their matrices are made dirty again before every run, outside of the timing
+    std::vector<Transformable> transformables = MakeTransformables(objects);
+    std::vector<Transformable*> pointers(aCount);
+    for (unsigned int i = 0; i < aCount; i++)
+    {
+        pointers[i] = &transformables[i];
+    }
+
+    double transformablesSingle = 1e30;
+    double transformablesBulk = 1e30;
+    for (unsigned int run = 0; run < 7; run++)
+    {
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            transformables[i].SetPositionX(objects.positionX[i]);
+        }
+
+        float sum = 0.0f;
+        Tests::Timer timer;
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            sum += transformables[i].GetTransformMatrix().m[3][0];
+        }
+        transformablesSingle = std::min(transformablesSingle, timer.GetMilliseconds() * 1000.0);
+        Tests::KeepAlive(sum);
+
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            transformables[i].SetPositionX(objects.positionX[i]);
+        }
+
+        timer.Restart();
+        Transformable::UpdateTransformMatrices(pointers.data(), aCount);
+        transformablesBulk = std::min(transformablesBulk, timer.GetMilliseconds() * 1000.0);
+    }
+
+    printf("%8u | %9.1f %9.1f %9.1f | %9.1f %9.1f %9.1f | %9.1f %9.1f %9.1f | %9.1f %9.1f\n", aCount,
+        transformsBefore, transformsScalar, transformsKernel, boundsBefore, boundsScalar, boundsKernel,
+        quadsBefore, quadsScalar, quadsKernel, transformablesSingle, transformablesBulk);
+}
+
+int main()
+{
+    TestResults();
+
+    printf("\nus per call, before = the per-object code, scalar = the reference kernel, kernel = the SSE2 kernel where it's supported\n");
+    printf("%8s | %29s | %29s | %29s | %19s\n", "", "transforms", "bounds", "quads", "Transformables");
+    printf("%8s | %9s %9s %9s | %9s %9s %9s | %9s %9s %9s | %9s %9s\n", "objects",
+        "before", "scalar", "kernel", "before", "scalar", "kernel", "before", "scalar", "kernel", "single", "bulk");
+
+    const unsigned int counts[] = { 1000, 10000, 100000 };
+    for (unsigned int i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        Benchmark(counts[i]);
+    }
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All TransformKernels tests passed" : "TransformKernels tests FAILED");
+    return Tests::Failures();
+}
@@ -0,0 +1,396 @@
+//Tests the TweenSet that the TweenManager updates every frame:
+//- a thousand float, Vector2 and Color tweens with random durations, delays and easings are checked against the expected
+//  value every frame, while RemoveFinishedTweens() compacts the finished ones out from between the running ones
+//- a handle is stale once its tween finishes OR is stopped, even after its slot is reused, and Stop() on a stale handle
+//  doesn't stop the tween that reused the slot
+//- a delayed tween doesn't write its value until its delay has passed
+//- Color tweens are clamped to 0.0 - 1.0, float tweens aren't
+//Then benchmarks 100k tweens against 100k Animators, each Animator listening for the UPDATE_EVENT on an EventDispatcher,
+//and reports the time per frame. AnimatorFloat listens on the Application, so the benchmark uses a copy of its update.
+//
+//Sources: Source/Framework/Animation/TweenSet.cpp Source/Framework/Animation/Easing.cpp
+//         Source/Framework/Events/EventDispatcher.cpp Source/Framework/Events/Event.cpp
+//         Source/Framework/Events/EventHandler.cpp Source/Framework/Events/UpdateEvent.cpp
+//         Source/Framework/Graphics/Color.cpp Source/Framework/Math/Vector2.cpp Source/Framework/Math/Rotation.cpp
+//         Source/Framework/Math/Math.cpp Source/Framework/Math/Random.cpp Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Animation/TweenSet.h"
+#include "../Source/Framework/Events/EventDispatcher.h"
+#include "../Source/Framework/Events/UpdateEvent.h"
+#include <list>
+#include <random>
+
+using namespace GameDev2D;
+
+
+//The frame rate the tweens are updated at
+const double TEST_DELTA = 1.0 / 60.0;
+
+//The number of tweens and Animators in the benchmark, and the number of frames it runs for
+const unsigned int TEST_BENCHMARK_TWEENS = 100000;
+const unsigned int TEST_BENCHMARK_FRAMES = 120;
+
+//A tween and the values it's expected to have, the expected values are calculated the way TweenSet::Update() does
+struct ExpectedTween
+{
+    Tween tween;
+    unsigned int channels;
+    float start[4];
+    float end[4];
+    float time;
+    float duration;
+    EasingType easing;
+    bool isColor;
+    float* value;
+};
+
+//Returns the value a tween's channel should have, a tween that hasn't started yet isn't written to
+static float GetExpectedValue(const ExpectedTween& aTween, unsigned int aChannel)
+{
+    float percentage = aTween.time / aTween.duration;
+    percentage = percentage < 0.0f ? 0.0f : (percentage > 1.0f ? 1.0f : percentage);
+    float value = aTween.start[aChannel] + (aTween.end[aChannel] - aTween.start[aChannel]) * GetEasingFunction(aTween.easing)(percentage);
+    return aTween.isColor == true ? (value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value)) : value;
+}
+
+static void TestCompaction()
+{
+    const unsigned int tweenCount = 1000;
+    const float unwritten = -12345.0f;
+    std::mt19937 random(41);
+    std::uniform_real_distribution<float> range(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> colorRange(0.0f, 1.0f);
+
+    //Every tween writes to its own values, they're never reallocated
+    std::vector<float> floats(tweenCount, unwritten);
+    std::vector<Vector2> vectors(tweenCount, Vector2(unwritten, unwritten));
+    std::vector<Color> colors(tweenCount, Color(unwritten, unwritten, unwritten, unwritten));
+
+    TweenSet tweens;
+    std::vector<ExpectedTween> expected(tweenCount);
+    for (unsigned int i = 0; i < tweenCount; i++)
+    {
+        ExpectedTween& tween = expected[i];
+        unsigned int kind = random() % 3;
+        tween.channels = kind == 0 ? 1 : (kind == 1 ? 2 : 4);
+        tween.isColor = tween.channels == 4;
+        for (unsigned int channel = 0; channel < 4; channel++)
+        {
+            tween.start[channel] = tween.isColor == true ? colorRange(random) : range(random);
+            tween.end[channel] = tween.isColor == true ? colorRange(random) : range(random);
+        }
+
+        //Some of the tweens finish on their first update
+        double duration = random() % 20 == 0 ? 0.0 : 0.05 + (random() % 1000) / 500.0;
+        double delay = random() % 3 == 0 ? (random() % 100) / 100.0 : 0.0;
+        tween.easing = static_cast<EasingType>(random() % EasingType_Count);
+        tween.time = -static_cast<float>(delay);
+        tween.duration = static_cast<float>(duration) > 1.0e-6f ? static_cast<float>(duration) : 1.0e-6f;
+
+        if (tween.channels == 1)
+        {
+            tween.value = &floats[i];
+            tween.tween = tweens.Animate(&floats[i], tween.start[0], tween.end[0], duration, tween.easing, delay);
+        }
+        else if (tween.channels == 2)
+        {
+            tween.value = &vectors[i].x;
+            tween.tween = tweens.Animate(&vectors[i], Vector2(tween.start[0], tween.start[1]), Vector2(tween.end[0], tween.end[1]), duration, tween.easing, delay);
+        }
+        else
+        {
+            tween.value = &colors[i].r;
+            tween.tween = tweens.Animate(&colors[i], Color(tween.start[0], tween.start[1], tween.start[2], tween.start[3]),
+                Color(tween.end[0], tween.end[1], tween.end[2], tween.end[3]), duration, tween.easing, delay);
+        }
+    }
+    TEST_CHECK(tweens.GetTweenCount() == tweenCount);
+
+    //Update until every tween has finished, every value and every handle is checked each frame
+    bool isCorrect = true;
+    bool isAnimatingCorrect = true;
+    bool isCountCorrect = true;
+    unsigned int frames = 0;
+    while (tweens.GetTweenCount() > 0 && frames < 1000)
+    {
+        tweens.Update(TEST_DELTA);
+        frames++;
+
+        unsigned int animating = 0;
+        unsigned int channels = 0;
+        for (unsigned int i = 0; i < tweenCount; i++)
+        {
+            ExpectedTween& tween = expected[i];
+            tween.time += static_cast<float>(TEST_DELTA);
+            for (unsigned int channel = 0; channel < tween.channels; channel++)
+            {
+                float value = tween.time >= 0.0f ? GetExpectedValue(tween, channel) : unwritten;
+                isCorrect = isCorrect && tween.value[channel] == value;
+            }
+
+            bool isAnimating = tween.time < tween.duration;
+            isAnimatingCorrect = isAnimatingCorrect && tweens.IsAnimating(tween.tween) == isAnimating;
+            animating += isAnimating == true ? 1 : 0;
+            channels += isAnimating == true ? tween.channels : 0;
+        }
+        isCountCorrect = isCountCorrect && tweens.GetTweenCount() == animating && tweens.GetChannelCount() == channels;
+    }
+
+    printf("%u float, Vector2 and Color tweens finished after %u frames\n", tweenCount, frames);
+    TEST_CHECK(isCorrect == true);
+    TEST_CHECK(isAnimatingCorrect == true);
+    TEST_CHECK(isCountCorrect == true);
+    TEST_CHECK(tweens.GetTweenCount() == 0 && tweens.GetChannelCount() == 0);
+}
+
+static void TestStaleHandles()
+{
+    TweenSet tweens;
+    float a = 0.0f;
+    float b = 0.0f;
+    float c = 0.0f;
+    TEST_CHECK(tweens.IsAnimating(Tween()) == false);
+
+    Tween tweenA = tweens.Animate(&a, 0.0f, 10.0f, 1.0);
+    Tween tweenB = tweens.Animate(&b, 0.0f, 10.0f, 1.0);
+    tweens.Update(0.25);
+    TEST_CHECK(a == 2.5f && b == 2.5f);
+
+    //Stopping a tween resets the handle, a copy of it is stale and the value keeps its last value
+    Tween copyOfA = tweenA;
+    tweens.Stop(tweenA);
+    TEST_CHECK(tweenA.index == 0 && tweens.IsAnimating(tweenA) == false);
+    TEST_CHECK(tweens.IsAnimating(copyOfA) == false);
+    TEST_CHECK(tweens.GetTweenCount() == 1);
+    tweens.Update(0.25);
+    TEST_CHECK(a == 2.5f && b == 5.0f);
+    TEST_CHECK(tweens.GetChannelCount() == 1);
+
+    //The stopped tween's slot is reused, the stale copy still doesn't refer to the new tween, and can't stop it
+    Tween tweenC = tweens.Animate(&c, 0.0f, 10.0f, 1.0);
+    TEST_CHECK(tweenC.index == copyOfA.index);
+    TEST_CHECK(tweens.IsAnimating(copyOfA) == false && tweens.IsAnimating(tweenC) == true);
+    tweens.Stop(copyOfA);
+    TEST_CHECK(tweens.IsAnimating(tweenC) == true);
+    tweens.Update(0.5);
+    TEST_CHECK(b == 10.0f && c == 5.0f);
+
+    //A finished tween's handle is stale, and stays stale once its slot is reused
+    TEST_CHECK(tweens.IsAnimating(tweenB) == false);
+    float d = 0.0f;
+    Tween tweenD = tweens.Animate(&d, 0.0f, 1.0f, 1.0);
+    TEST_CHECK(tweenD.index == tweenB.index && tweens.IsAnimating(tweenB) == false);
+    tweens.Stop(tweenB);
+    TEST_CHECK(tweens.IsAnimating(tweenD) == true);
+
+    //Stopping a tween after the tweens in front of it were compacted stops that tween only
+    tweens.Stop(tweenC);
+    tweens.Update(0.5);
+    TEST_CHECK(c == 5.0f && d == 0.5f);
+    TEST_CHECK(tweens.GetTweenCount() == 1 && tweens.IsAnimating(tweenD) == true);
+}
+
+static void TestDelay()
+{
+    TweenSet tweens;
+    float value = -1.0f;
+    Tween tween = tweens.Animate(&value, 0.0f, 8.0f, 1.0, EasingType_QuadraticIn, 0.5);
+
+    //The value isn't written to until the delay has passed, but the tween is animating
+    tweens.Update(0.25);
+    TEST_CHECK(value == -1.0f && tweens.IsAnimating(tween) == true);
+    tweens.Update(0.25);
+    TEST_CHECK(value == 0.0f);
+    tweens.Update(0.5);
+    TEST_CHECK(value == 2.0f);
+    tweens.Update(0.5);
+    TEST_CHECK(value == 8.0f && tweens.IsAnimating(tween) == false);
+
+    //A tween stopped during its delay never writes its value
+    float stopped = -1.0f;
+    Tween stoppedTween = tweens.Animate(&stopped, 0.0f, 8.0f, 1.0, EasingType_Linear, 0.5);
+    tweens.Update(0.25);
+    tweens.Stop(stoppedTween);
+    tweens.Update(1.0);
+    TEST_CHECK(stopped == -1.0f && tweens.GetTweenCount() == 0);
+
+    //AnimateTo() starts from the value it has when it's called, not when its delay has passed
+    float to = 4.0f;
+    tweens.AnimateTo(&to, 0.0f, 1.0, EasingType_Linear, 1.0);
+    to = 100.0f;
+    tweens.Update(1.5);
+    TEST_CHECK(to == 2.0f);
+}
+
+static void TestColorClamping()
+{
+    TweenSet tweens;
+
+    //The Back curves overshoot, a Color's channels are clamped, a float isn't
+    Color overshoot = Color(0.0f, 0.5f, 1.0f, 0.0f);
+    Color undershoot = Color(1.0f, 0.5f, 0.0f, 1.0f);
+    float value = 0.0f;
+    tweens.Animate(&overshoot, Color(0.0f, 0.5f, 1.0f, 0.0f), Color(1.0f, 1.0f, 1.0f, 1.0f), 1.0, EasingType_BackOut);
+    tweens.Animate(&undershoot, Color(1.0f, 0.5f, 0.0f, 1.0f), Color(0.0f, 0.0f, 0.0f, 0.0f), 1.0, EasingType_BackIn);
+    tweens.Animate(&value, 0.0f, 1.0f, 1.0, EasingType_BackOut);
+
+    bool isClamped = true;
+    float largestFloat = 0.0f;
+    float largestColor = 0.0f;
+    float smallestColor = 1.0f;
+    for (unsigned int i = 0; i < 60; i++)
+    {
+        tweens.Update(1.0 / 60.0);
+        const float channels[] = { overshoot.r, overshoot.g, overshoot.b, overshoot.a, undershoot.r, undershoot.g, undershoot.b, undershoot.a };
+        for (unsigned int channel = 0; channel < 8; channel++)
+        {
+            isClamped = isClamped && channels[channel] >= 0.0f && channels[channel] <= 1.0f;
+            largestColor = std::max(largestColor, channels[channel]);
+            smallestColor = std::min(smallestColor, channels[channel]);
+        }
+        largestFloat = std::max(largestFloat, value);
+    }
+
+    TEST_CHECK(isClamped == true);
+    TEST_CHECK(largestColor == 1.0f && smallestColor == 0.0f);
+    TEST_CHECK(largestFloat > 1.05f);
+
+    //60 updates of 1/60 add up to just under a second in floats, the last update finishes the tweens
+    tweens.Update(1.0 / 60.0);
+    TEST_CHECK(tweens.GetTweenCount() == 0);
+    TEST_CHECK(overshoot.r == 1.0f && overshoot.a == 1.0f && undershoot.r == 0.0f && undershoot.a == 0.0f);
+}
+
+//A copy of AnimatorFloat's update, with one keyframe, that listens for the UPDATE_EVENT on an EventDispatcher
+class BenchmarkAnimator : public EventHandler
+{
+public:
+    BenchmarkAnimator(float* aReference, float aValue, double aDuration, EasingFunction aEasingFunction) :
+        m_Reference(aReference),
+        m_Start(*aReference),
+        m_End(aValue),
+        m_Time(0.0),
+        m_IsAnimating(true)
+    {
+        m_Keyframes.push_back(Keyframe(aValue, aDuration, aEasingFunction));
+    }
+
+    void HandleEvent(Event* aEvent)
+    {
+        if (aEvent != nullptr && aEvent->GetEventCode() == UPDATE_EVENT)
+        {
+            Update(static_cast<UpdateEvent*>(aEvent)->GetDelta());
+        }
+    }
+
+private:
+    void Update(double aDelta)
+    {
+        if (m_IsAnimating == true)
+        {
+            const Keyframe& keyframe = m_Keyframes.front();
+            m_Time += aDelta;
+            if (m_Time >= keyframe.duration)
+            {
+                m_Time = keyframe.duration;
+            }
+
+            float percentage = static_cast<float>(m_Time / keyframe.duration);
+            *m_Reference = m_Start + (m_End - m_Start) * keyframe.easingFunction(percentage);
+
+            if (m_Time == keyframe.duration)
+            {
+                m_Keyframes.pop_front();
+                m_IsAnimating = false;
+            }
+        }
+    }
+
+    struct Keyframe
+    {
+        Keyframe(float aValue, double aDuration, EasingFunction aEasingFunction) : easingFunction(aEasingFunction), duration(aDuration), value(aValue) {}
+
+        EasingFunction easingFunction;
+        double duration;
+        float value;
+    };
+
+    std::list<Keyframe> m_Keyframes;
+    float* m_Reference;
+    float m_Start;
+    float m_End;
+    double m_Time;
+    bool m_IsAnimating;
+};
+
+//Runs 100k Animators and 100k tweens with the same durations, returns the largest difference between their values
+static float Benchmark(EasingType aEasing, bool aApproximate)
+{
+    std::mt19937 random(41);
+    std::vector<double> durations(TEST_BENCHMARK_TWEENS);
+    for (unsigned int i = 0; i < TEST_BENCHMARK_TWEENS; i++)
+    {
+        durations[i] = 1.0 + (random() % 3000) / 1000.0;
+    }
+
+    std::vector<float> animatorValues(TEST_BENCHMARK_TWEENS, 0.0f);
+    std::vector<float> tweenValues(TEST_BENCHMARK_TWEENS, 0.0f);
+    EventDispatcher dispatcher;
+    std::vector<BenchmarkAnimator*> animators(TEST_BENCHMARK_TWEENS);
+    TweenSet tweens;
+    tweens.SetUsesApproximateEasing(aApproximate);
+    for (unsigned int i = 0; i < TEST_BENCHMARK_TWEENS; i++)
+    {
+        animators[i] = new BenchmarkAnimator(&animatorValues[i], 100.0f, durations[i], GetEasingFunction(aEasing));
+        dispatcher.AddEventListener(animators[i], UPDATE_EVENT);
+        tweens.Animate(&tweenValues[i], 0.0f, 100.0f, durations[i], aEasing);
+    }
+
+    //The Animators are updated the way the Application updates them, by dispatching an UpdateEvent
+    Tests::Timer timer;
+    for (unsigned int frame = 0; frame < TEST_BENCHMARK_FRAMES; frame++)
+    {
+        UpdateEvent update(TEST_DELTA);
+        dispatcher.DispatchEvent(update);
+    }
+    double animatorMs = timer.GetMilliseconds() / TEST_BENCHMARK_FRAMES;
+
+    timer.Restart();
+    for (unsigned int frame = 0; frame < TEST_BENCHMARK_FRAMES; frame++)
+    {
+        tweens.Update(TEST_DELTA);
+    }
+    double tweenMs = timer.GetMilliseconds() / TEST_BENCHMARK_FRAMES;
+
+    //The Animators keep time in doubles, the tweens in floats
+    float difference = 0.0f;
+    for (unsigned int i = 0; i < TEST_BENCHMARK_TWEENS; i++)
+    {
+        difference = std::max(difference, fabsf(animatorValues[i] - tweenValues[i]));
+        dispatcher.RemoveEventListener(animators[i], UPDATE_EVENT);
+        delete animators[i];
+    }
+
+    printf("%-18s %-12s | %8.2f ms %8.2f ms %10.3g\n", aEasing == EasingType_Linear ? "Linear" : (aEasing == EasingType_QuadraticInOut ? "QuadraticInOut" : "ElasticOut"),
+        aApproximate == true ? "approximate" : "", animatorMs, tweenMs, difference);
+    return difference;
+}
+
+int main()
+{
+    TestCompaction();
+    TestStaleHandles();
+    TestDelay();
+    TestColorClamping();
+
+    printf("\n%uk values 0 - 100 over 1 - 4 s, %u frames\n", TEST_BENCHMARK_TWEENS / 1000, TEST_BENCHMARK_FRAMES);
+    printf("%-31s | %11s %11s %10s\n", "per frame", "Animators", "tweens", "difference");
+    TEST_CHECK(Benchmark(EasingType_Linear, false) < 1.0e-4f);
+    TEST_CHECK(Benchmark(EasingType_QuadraticInOut, false) < 1.0e-4f);
+    TEST_CHECK(Benchmark(EasingType_ElasticOut, false) < 1.0e-4f);
+    TEST_CHECK(Benchmark(EasingType_ElasticOut, true) < 1.0e-4f);
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All TweenSet tests passed" : "TweenSet tests FAILED");
+    return Tests::Failures();
+}
@@ -0,0 +1,314 @@
+//Tests that every Vector2 method returns the same result, bit for bit, as the Vector2 did before its methods were moved
+//inline into Vector2.h. BaselineVector2 below is a copy of that Vector2, its methods are kept out of line the way they
+//were in Vector2.cpp. The inputs are random vectors and every combination of the special values (zeros of both signs,
+//denormals, huge values, infinities and NaNs). Then each method is benchmarked against the baseline's.
+//
+//Sources: Source/Framework/Math/Vector2.cpp Source/Framework/Math/Rotation.cpp Source/Framework/Math/Math.cpp
+//         Source/Framework/Math/Random.cpp Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Math/Vector2.h"
+#include "../Source/Framework/Math/Rotation.h"
+#include <limits>
+#include <random>
+#include <string.h>
+
+using namespace GameDev2D;
+
+
+//The baseline's methods were in Vector2.cpp, keep the compiler from inlining them here so they're called the same way
+#if defined(_MSC_VER)
+#define BASELINE_NOINLINE __declspec(noinline)
+#else
+#define BASELINE_NOINLINE __attribute__((noinline))
+#endif
+
+//The Vector2 as it was before its methods were inline
+struct BaselineVector2
+{
+    BASELINE_NOINLINE BaselineVector2(float aX, float aY) : x(aX), y(aY) {}
+    BASELINE_NOINLINE BaselineVector2(const BaselineVector2& aVector2) : x(aVector2.x), y(aVector2.y) {}
+    BASELINE_NOINLINE BaselineVector2() : x(0.0f), y(0.0f) {}
+
+    static const BaselineVector2 Zero;
+    static const BaselineVector2 Unit;
+    static const BaselineVector2 Left;
+    static const BaselineVector2 Right;
+    static const BaselineVector2 Up;
+    static const BaselineVector2 Down;
+
+    BASELINE_NOINLINE Rotation Angle()
+    {
+        float radians = fmodf((atan2f(y, x) + static_cast<float>(M_PI) * 4.0f), static_cast<float>(M_PI) * 2.0f);
+        return Rotation::Radians(radians);
+    }
+
+    BASELINE_NOINLINE float Length()
+    {
+        return sqrtf(LengthSquared());
+    }
+
+    BASELINE_NOINLINE float LengthSquared()
+    {
+        return x * x + y * y;
+    }
+
+    BASELINE_NOINLINE void Normalize()
+    {
+        float length = LengthSquared();
+        if (length != 0)
+        {
+            length = sqrtf(length);
+            x /= length;
+            y /= length;
+        }
+    }
+
+    BASELINE_NOINLINE BaselineVector2 Normalized()
+    {
+        BaselineVector2 vector2 = BaselineVector2(x, y);
+        vector2.Normalize();
+        return vector2;
+    }
+
+    BASELINE_NOINLINE float Distance(const BaselineVector2& aVector)
+    {
+        return sqrtf(DistanceSquared(aVector));
+    }
+
+    BASELINE_NOINLINE float DistanceSquared(const BaselineVector2& aVector)
+    {
+        return (x - aVector.x) * (x - aVector.x) + (y - aVector.y) * (y - aVector.y);
+    }
+
+    BASELINE_NOINLINE float DotProduct(const BaselineVector2& aVector2)
+    {
+        return x * aVector2.x + y * aVector2.y;
+    }
+
+    BASELINE_NOINLINE BaselineVector2 PerpendicularClockwise()
+    {
+        return BaselineVector2(y, -x);
+    }
+
+    BASELINE_NOINLINE BaselineVector2 PerpendicularCounterClockwise()
+    {
+        return BaselineVector2(-y, x);
+    }
+
+    BASELINE_NOINLINE BaselineVector2 operator+(const BaselineVector2& aVector2) const { return BaselineVector2(x + aVector2.x, y + aVector2.y); }
+    BASELINE_NOINLINE void operator+=(const BaselineVector2& aVector2) { x += aVector2.x; y += aVector2.y; }
+    BASELINE_NOINLINE BaselineVector2 operator-(const BaselineVector2& aVector2) const { return BaselineVector2(x - aVector2.x, y - aVector2.y); }
+    BASELINE_NOINLINE void operator-=(const BaselineVector2& aVector2) { x -= aVector2.x; y -= aVector2.y; }
+    BASELINE_NOINLINE BaselineVector2 operator*(const BaselineVector2& aVector2) const { return BaselineVector2(x * aVector2.x, y * aVector2.y); }
+    BASELINE_NOINLINE BaselineVector2 operator*(const float& aScale) const { return BaselineVector2(x * aScale, y * aScale); }
+    BASELINE_NOINLINE void operator*=(const BaselineVector2& aVector2) { x *= aVector2.x; y *= aVector2.y; }
+    BASELINE_NOINLINE void operator*=(const float& aScale) { x *= aScale; y *= aScale; }
+    BASELINE_NOINLINE BaselineVector2 operator/(const BaselineVector2& aVector2) const { return BaselineVector2(x / aVector2.x, y / aVector2.y); }
+    BASELINE_NOINLINE BaselineVector2 operator/(const float& aScale) const { return BaselineVector2(x / aScale, y / aScale); }
+    BASELINE_NOINLINE void operator/=(const BaselineVector2& aVector2) { x /= aVector2.x; y /= aVector2.y; }
+    BASELINE_NOINLINE void operator/=(const float& aScale) { x /= aScale; y /= aScale; }
+    BASELINE_NOINLINE BaselineVector2 operator-() const { return BaselineVector2(-x, -y); }
+    BASELINE_NOINLINE bool operator==(const BaselineVector2& aVector2) const { return x == aVector2.x && y == aVector2.y; }
+    BASELINE_NOINLINE bool operator!=(const BaselineVector2& aVector2) const { return x != aVector2.x || y != aVector2.y; }
+    BASELINE_NOINLINE bool operator<(const BaselineVector2& aVector2) const { return (x == aVector2.x) ? (y < aVector2.y) : (x < aVector2.x); }
+    BASELINE_NOINLINE bool operator<=(const BaselineVector2& aVector2) const { return (x == aVector2.x) ? (y <= aVector2.y) : (x <= aVector2.x); }
+    BASELINE_NOINLINE bool operator>(const BaselineVector2& aVector2) const { return (x == aVector2.x) ? (y > aVector2.y) : (x > aVector2.x); }
+    BASELINE_NOINLINE bool operator>=(const BaselineVector2& aVector2) const { return (x == aVector2.x) ? (y >= aVector2.y) : (x >= aVector2.x); }
+
+    float x;
+    float y;
+};
+
+const BaselineVector2 BaselineVector2::Zero = BaselineVector2(0.0f, 0.0f);
+const BaselineVector2 BaselineVector2::Unit = BaselineVector2(1.0f, 1.0f);
+const BaselineVector2 BaselineVector2::Left = BaselineVector2(-1.0f, 0.0f);
+const BaselineVector2 BaselineVector2::Right = BaselineVector2(1.0f, 0.0f);
+const BaselineVector2 BaselineVector2::Up = BaselineVector2(0.0f, 1.0f);
+const BaselineVector2 BaselineVector2::Down = BaselineVector2(0.0f, -1.0f);
+
+BASELINE_NOINLINE BaselineVector2 operator* (float scale, const BaselineVector2& vector2)
+{
+    return BaselineVector2(vector2.x * scale, vector2.y * scale);
+}
+
+//The methods that are constexpr are evaluated at compile time
+static_assert(Vector2(3.0f, 4.0f).LengthSquared() == 25.0f, "LengthSquared() isn't constexpr");
+static_assert(Vector2(1.0f, 2.0f).DotProduct(Vector2(3.0f, 4.0f)) == 11.0f, "DotProduct() isn't constexpr");
+static_assert((Vector2(1.0f, 2.0f) + Vector2(3.0f, 4.0f)) * 2.0f == Vector2(8.0f, 12.0f), "The operators aren't constexpr");
+static_assert(Vector2(1.0f, 2.0f).PerpendicularClockwise() == -Vector2(1.0f, 2.0f).PerpendicularCounterClockwise(), "The perpendiculars aren't constexpr");
+
+//A method's result, vectors, floats and bools are compared bit for bit
+struct Result
+{
+    Result() : x(0.0f), y(0.0f) {}
+    Result(const Vector2& aVector2) : x(aVector2.x), y(aVector2.y) {}
+    Result(const BaselineVector2& aVector2) : x(aVector2.x), y(aVector2.y) {}
+    Result(float aValue) : x(aValue), y(0.0f) {}
+    Result(bool aValue) : x(aValue == true ? 1.0f : 0.0f), y(0.0f) {}
+    Result(Rotation aRotation) : x(aRotation.GetRadians()), y(0.0f) {}
+
+    bool IsIdentical(const Result& aResult) const
+    {
+        return memcmp(&x, &aResult.x, sizeof(x)) == 0 && memcmp(&y, &aResult.y, sizeof(y)) == 0;
+    }
+
+    float x;
+    float y;
+};
+
+//The inputs every method is called with, the same values as a Vector2 and a BaselineVector2
+struct Inputs
+{
+    Inputs()
+    {
+        //Every combination of the special values
+        const float specials[] =
+        {
+            0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 3.0f,
+            std::numeric_limits<float>::denorm_min(), -std::numeric_limits<float>::min(),
+            std::numeric_limits<float>::max(), -1e30f,
+            std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::quiet_NaN()
+        };
+        const unsigned int specialCount = sizeof(specials) / sizeof(specials[0]);
+        for (unsigned int i = 0; i < specialCount * specialCount * specialCount * specialCount; i++)
+        {
+            Add(specials[i % specialCount], specials[i / specialCount % specialCount], specials[i / specialCount / specialCount % specialCount], specials[i / specialCount / specialCount / specialCount], specials[i % 7]);
+        }
+
+        //Random vectors, of the magnitudes a game uses
+        std::mt19937 random(48);
+        std::uniform_real_distribution<float> value(-2000.0f, 2000.0f);
+        std::uniform_real_distribution<float> scale(-4.0f, 4.0f);
+        while (a.size() < 1000000)
+        {
+            Add(value(random), value(random), value(random), value(random), scale(random));
+        }
+    }
+
+    void Add(float aX, float aY, float aOtherX, float aOtherY, float aScale)
+    {
+        a.push_back(Vector2(aX, aY));
+        b.push_back(Vector2(aOtherX, aOtherY));
+        baselineA.push_back(BaselineVector2(aX, aY));
+        baselineB.push_back(BaselineVector2(aOtherX, aOtherY));
+        scales.push_back(aScale);
+    }
+
+    std::vector<Vector2> a;
+    std::vector<Vector2> b;
+    std::vector<BaselineVector2> baselineA;
+    std::vector<BaselineVector2> baselineB;
+    std::vector<float> scales;
+};
+
+static Inputs* s_Inputs = nullptr;
+
+//Calls a method of the Vector2 and the BaselineVector2 with every input, checks that the results are identical, then
+//benchmarks them. The Vector2 and the BaselineVector2 are passed by value, the methods that modify them modify a copy
+template<typename BaselineMethod, typename Method> static void TestMethod(const char* aName, BaselineMethod aBaselineMethod, Method aMethod)
+{
+    const Inputs& inputs = *s_Inputs;
+    const unsigned int count = (unsigned int)inputs.a.size();
+    std::vector<Result> baselineResults(count);
+    std::vector<Result> results(count);
+
+    double baselineMs = 1e30;
+    double ms = 1e30;
+    for (unsigned int run = 0; run < 5; run++)
+    {
+        Tests::Timer timer;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            baselineResults[i] = aBaselineMethod(inputs.baselineA[i], inputs.baselineB[i], inputs.scales[i]);
+        }
+        baselineMs = std::min(baselineMs, timer.GetMilliseconds());
+        Tests::KeepAlive(baselineResults[count - 1]);
+
+        timer.Restart();
+        for (unsigned int i = 0; i < count; i++)
+        {
+            results[i] = aMethod(inputs.a[i], inputs.b[i], inputs.scales[i]);
+        }
+        ms = std::min(ms, timer.GetMilliseconds());
+        Tests::KeepAlive(results[count - 1]);
+    }
+
+    unsigned int mismatches = 0;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        mismatches += baselineResults[i].IsIdentical(results[i]) == false ? 1 : 0;
+    }
+
+    printf("%-32s | %12.2f %12.2f %12u\n", aName, baselineMs * 1e6 / count, ms * 1e6 / count, mismatches);
+    if (mismatches != 0)
+    {
+        Tests::Fail(aName, __FILE__, __LINE__);
+    }
+}
+
+static void TestConstants()
+{
+    TEST_CHECK(Result(Vector2::Zero).IsIdentical(Result(BaselineVector2::Zero)));
+    TEST_CHECK(Result(Vector2::Unit).IsIdentical(Result(BaselineVector2::Unit)));
+    TEST_CHECK(Result(Vector2::Left).IsIdentical(Result(BaselineVector2::Left)));
+    TEST_CHECK(Result(Vector2::Right).IsIdentical(Result(BaselineVector2::Right)));
+    TEST_CHECK(Result(Vector2::Up).IsIdentical(Result(BaselineVector2::Up)));
+    TEST_CHECK(Result(Vector2::Down).IsIdentical(Result(BaselineVector2::Down)));
+}
+
+static void TestMethods()
+{
+    typedef BaselineVector2 B;
+    typedef Vector2 V;
+
+    printf("\n%-32s | %12s %12s %12s\n", "ns per call", "baseline", "inline", "mismatches");
+
+    TestMethod("Vector2(x, y)", [](B a, B, float) { return Result(B(a.x, a.y)); }, [](V a, V, float) { return Result(V(a.x, a.y)); });
+    TestMethod("Vector2(const Vector2&)", [](B a, B, float) { return Result(B(a)); }, [](V a, V, float) { return Result(V(a)); });
+    TestMethod("Vector2()", [](B, B, float) { return Result(B()); }, [](V, V, float) { return Result(V()); });
+    TestMethod("Angle", [](B a, B, float) { return Result(a.Angle()); }, [](V a, V, float) { return Result(a.Angle()); });
+    TestMethod("Length", [](B a, B, float) { return Result(a.Length()); }, [](V a, V, float) { return Result(a.Length()); });
+    TestMethod("LengthSquared", [](B a, B, float) { return Result(a.LengthSquared()); }, [](V a, V, float) { return Result(a.LengthSquared()); });
+    TestMethod("Normalize", [](B a, B, float) { a.Normalize(); return Result(a); }, [](V a, V, float) { a.Normalize(); return Result(a); });
+    TestMethod("Normalized", [](B a, B, float) { return Result(a.Normalized()); }, [](V a, V, float) { return Result(a.Normalized()); });
+    TestMethod("Distance", [](B a, B b, float) { return Result(a.Distance(b)); }, [](V a, V b, float) { return Result(a.Distance(b)); });
+    TestMethod("DistanceSquared", [](B a, B b, float) { return Result(a.DistanceSquared(b)); }, [](V a, V b, float) { return Result(a.DistanceSquared(b)); });
+    TestMethod("DotProduct", [](B a, B b, float) { return Result(a.DotProduct(b)); }, [](V a, V b, float) { return Result(a.DotProduct(b)); });
+    TestMethod("PerpendicularClockwise", [](B a, B, float) { return Result(a.PerpendicularClockwise()); }, [](V a, V, float) { return Result(a.PerpendicularClockwise()); });
+    TestMethod("PerpendicularCounterClockwise", [](B a, B, float) { return Result(a.PerpendicularCounterClockwise()); }, [](V a, V, float) { return Result(a.PerpendicularCounterClockwise()); });
+    TestMethod("operator+", [](B a, B b, float) { return Result(a + b); }, [](V a, V b, float) { return Result(a + b); });
+    TestMethod("operator+=", [](B a, B b, float) { a += b; return Result(a); }, [](V a, V b, float) { a += b; return Result(a); });
+    TestMethod("operator-", [](B a, B b, float) { return Result(a - b); }, [](V a, V b, float) { return Result(a - b); });
+    TestMethod("operator-=", [](B a, B b, float) { a -= b; return Result(a); }, [](V a, V b, float) { a -= b; return Result(a); });
+    TestMethod("operator*(Vector2)", [](B a, B b, float) { return Result(a * b); }, [](V a, V b, float) { return Result(a * b); });
+    TestMethod("operator*(float)", [](B a, B, float s) { return Result(a * s); }, [](V a, V, float s) { return Result(a * s); });
+    TestMethod("operator*=(Vector2)", [](B a, B b, float) { a *= b; return Result(a); }, [](V a, V b, float) { a *= b; return Result(a); });
+    TestMethod("operator*=(float)", [](B a, B, float s) { a *= s; return Result(a); }, [](V a, V, float s) { a *= s; return Result(a); });
+    TestMethod("operator/(Vector2)", [](B a, B b, float) { return Result(a / b); }, [](V a, V b, float) { return Result(a / b); });
+    TestMethod("operator/(float)", [](B a, B, float s) { return Result(a / s); }, [](V a, V, float s) { return Result(a / s); });
+    TestMethod("operator/=(Vector2)", [](B a, B b, float) { a /= b; return Result(a); }, [](V a, V b, float) { a /= b; return Result(a); });
+    TestMethod("operator/=(float)", [](B a, B, float s) { a /= s; return Result(a); }, [](V a, V, float s) { a /= s; return Result(a); });
+    TestMethod("operator-()", [](B a, B, float) { return Result(-a); }, [](V a, V, float) { return Result(-a); });
+    TestMethod("operator==", [](B a, B b, float) { return Result(a == b); }, [](V a, V b, float) { return Result(a == b); });
+    TestMethod("operator!=", [](B a, B b, float) { return Result(a != b); }, [](V a, V b, float) { return Result(a != b); });
+    TestMethod("operator<", [](B a, B b, float) { return Result(a < b); }, [](V a, V b, float) { return Result(a < b); });
+    TestMethod("operator<=", [](B a, B b, float) { return Result(a <= b); }, [](V a, V b, float) { return Result(a <= b); });
+    TestMethod("operator>", [](B a, B b, float) { return Result(a > b); }, [](V a, V b, float) { return Result(a > b); });
+    TestMethod("operator>=", [](B a, B b, float) { return Result(a >= b); }, [](V a, V b, float) { return Result(a >= b); });
+    TestMethod("operator*(float, Vector2)", [](B a, B, float s) { return Result(s * a); }, [](V a, V, float s) { return Result(s * a); });
+}
+
+int main()
+{
+    s_Inputs = new Inputs();
+    printf("%u inputs\n", (unsigned int)s_Inputs->a.size());
+
+    TestConstants();
+    TestMethods();
+    delete s_Inputs;
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All Vector2 tests passed" : "Vector2 tests FAILED");
+    return Tests::Failures();
+}
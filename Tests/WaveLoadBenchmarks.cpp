@@ -0,0 +1,201 @@
+//Benchmarks loading wave files through Wave::LoadFromPath (a memory mapping that is prefaulted) against reading the whole
+//file into memory, over the files in Assets/Audio and a corpus of generated wave files. The time it takes to read every
+//sample once after the load (what the mixer does the first time a sound is played) is measured separately, it should be
+//the same for both, since neither should page fault, and it is compared to reading a mapping that wasn't prefaulted.
+//The samples and formats that are loaded are checked as well.
+//
+//Windows only, Wave.cpp and MappedFile.cpp use xaudio2.h and Windows.h.
+//
+//Sources: Source/Framework/Utils/Wave/Wave.cpp Source/Framework/IO/MappedFile.cpp Source/Framework/Audio/AdpcmDecoder.cpp
+//         Tests/Support/Log.cpp
+
+#include "Support/TestHarness.h"
+#include "../Source/Framework/Utils/Wave/Wave.h"
+#include "../Source/Framework/Audio/AudioTypes.h"
+#include "../Source/Framework/IO/MappedFile.h"
+#include <fstream>
+#include <string.h>
+
+using namespace GameDev2D;
+
+
+//The KSDATAFORMAT_SUBTYPE_PCM GUID, the first two bytes are changed to make the other SubFormats
+const unsigned char TEST_SUBFORMAT_PCM[16] = { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+
+struct GeneratedWave
+{
+    const char* filename;
+    unsigned short formatTag;       //The format tag that is written, 0xfffe is extensible
+    unsigned short subFormatTag;    //The format tag in the SubFormat of an extensible format
+    unsigned short channels;
+    unsigned short bitsPerSample;
+    unsigned int frames;
+    unsigned int listChunks;        //The number of 'LIST' chunks written before the 'fmt ' chunk
+    unsigned short expectedFormatTag;
+};
+
+template<typename T> static void Append(std::string& aFile, const T& aValue)
+{
+    aFile.append(reinterpret_cast<const char*>(&aValue), sizeof(T));
+}
+
+//Writes a wave file, the samples are a ramp so that they can be checked. Returns the contents of the 'data' chunk
+static std::string WriteWave(const GeneratedWave& aWave)
+{
+    unsigned short blockAlign = aWave.channels * aWave.bitsPerSample / 8;
+    std::string data(aWave.frames * blockAlign, '\0');
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = (char)(i * 7);
+    }
+
+    std::string file("RIFF\0\0\0\0WAVE", 12);
+    for (unsigned int i = 0; i < aWave.listChunks; i++)
+    {
+        file.append("LIST", 4);
+        Append(file, (unsigned int)33);
+        file.append(34, 'x');
+    }
+
+    bool isExtensible = aWave.formatTag == 0xfffe;
+    file.append("fmt ", 4);
+    Append(file, (unsigned int)(isExtensible == true ? 40 : 16));
+    Append(file, aWave.formatTag);
+    Append(file, aWave.channels);
+    Append(file, (unsigned int)44100);
+    Append(file, (unsigned int)(44100 * blockAlign));
+    Append(file, blockAlign);
+    Append(file, aWave.bitsPerSample);
+    if (isExtensible == true)
+    {
+        Append(file, (unsigned short)22);
+        Append(file, aWave.bitsPerSample);
+        Append(file, (unsigned int)(aWave.channels == 2 ? 3 : 4));
+        std::string subFormat(reinterpret_cast<const char*>(TEST_SUBFORMAT_PCM), sizeof(TEST_SUBFORMAT_PCM));
+        memcpy(&subFormat[0], &aWave.subFormatTag, sizeof(aWave.subFormatTag));
+        file += subFormat;
+    }
+
+    file.append("data", 4);
+    Append(file, (unsigned int)data.size());
+    file += data;
+
+    unsigned int riffSize = (unsigned int)file.size() - 8;
+    memcpy(&file[4], &riffSize, sizeof(riffSize));
+
+    std::ofstream stream(aWave.filename, std::ios::binary | std::ios::trunc);
+    stream.write(file.c_str(), file.size());
+    return data;
+}
+
+//Reads the whole file into memory, the way wave files were loaded before they were mapped
+static std::vector<unsigned char> ReadWholeFile(const std::string& aPath)
+{
+    std::ifstream stream(aPath.c_str(), std::ios::binary | std::ios::ate);
+    std::vector<unsigned char> file((size_t)stream.tellg());
+    stream.seekg(0, std::ios::beg);
+    stream.read(reinterpret_cast<char*>(file.data()), file.size());
+    return file;
+}
+
+//Reads every sample once, the way the mixer does
+static unsigned int ReadSamples(const unsigned char* aData, unsigned int aSize)
+{
+    unsigned int sum = 0;
+    for (unsigned int i = 0; i < aSize; i += 64)
+    {
+        sum += aData[i];
+    }
+    return sum;
+}
+
+static void BenchmarkFile(const std::string& aPath, const std::string& aExpectedData, unsigned short aExpectedFormatTag)
+{
+    const unsigned int iterations = 20;
+    double mapMs = 1e30;
+    double mapReadMs = 1e30;
+    double copyMs = 1e30;
+    double copyReadMs = 1e30;
+    double faultReadMs = 1e30;
+    unsigned int size = 0;
+
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        //Load through the mapping
+        Tests::Timer timer;
+        WaveData* waveData = nullptr;
+        bool isLoaded = Wave::LoadFromPath(aPath, &waveData);
+        mapMs = std::min(mapMs, timer.GetMilliseconds());
+        TEST_CHECK(isLoaded == true);
+        if (isLoaded == false)
+        {
+            return;
+        }
+
+        timer.Restart();
+        Tests::KeepAlive(ReadSamples(waveData->buffer.pAudioData, waveData->buffer.AudioBytes));
+        mapReadMs = std::min(mapReadMs, timer.GetMilliseconds());
+
+        size = waveData->buffer.AudioBytes;
+        TEST_CHECK(waveData->waveFormat.wFormatTag == aExpectedFormatTag);
+        if (aExpectedData.empty() == false)
+        {
+            TEST_CHECK(size == aExpectedData.size() && memcmp(waveData->buffer.pAudioData, aExpectedData.c_str(), size) == 0);
+        }
+        delete waveData;
+
+        //Read the whole file into memory
+        timer.Restart();
+        std::vector<unsigned char> file = ReadWholeFile(aPath);
+        copyMs = std::min(copyMs, timer.GetMilliseconds());
+
+        timer.Restart();
+        Tests::KeepAlive(ReadSamples(file.data(), (unsigned int)file.size()));
+        copyReadMs = std::min(copyReadMs, timer.GetMilliseconds());
+
+        //Map the file without prefaulting it, the first read of every page faults
+        MappedFile mappedFile;
+        mappedFile.Open(aPath);
+        timer.Restart();
+        Tests::KeepAlive(ReadSamples(mappedFile.GetData(), (unsigned int)mappedFile.GetSize()));
+        faultReadMs = std::min(faultReadMs, timer.GetMilliseconds());
+    }
+
+    printf("%-44s %10u | %10.1f %10.1f | %10.1f %10.1f | %10.1f\n", aPath.c_str(), size, mapMs * 1000.0, mapReadMs * 1000.0, copyMs * 1000.0, copyReadMs * 1000.0, faultReadMs * 1000.0);
+}
+
+int main()
+{
+    printf("%-44s %10s | %10s %10s | %10s %10s | %10s\n", "file", "data bytes", "map us", "read us", "copy us", "read us", "fault us");
+
+    //The game's audio assets
+    const char* assets[] = { "Assets/Audio/Fanfare.wav", "Assets/Audio/Secret.wav" };
+    for (unsigned int i = 0; i < sizeof(assets) / sizeof(assets[0]); i++)
+    {
+        BenchmarkFile(assets[i], std::string(), WAVE_FORMAT_PCM);
+    }
+
+    //Generated files, short effects up to long music, with the formats and chunk layouts wave files come in
+    const GeneratedWave corpus[] =
+    {
+        { "WaveLoadBenchmarks_Mono_0.1s.wav", 1, 0, 1, 16, 4410, 0, 1 },
+        { "WaveLoadBenchmarks_Stereo_1s.wav", 1, 0, 2, 16, 44100, 0, 1 },
+        { "WaveLoadBenchmarks_List_0.5s.wav", 1, 0, 2, 16, 22050, 40, 1 },
+        { "WaveLoadBenchmarks_Float_1s.wav", 3, 0, 2, 32, 44100, 0, 3 },
+        { "WaveLoadBenchmarks_ExtensiblePCM_1s.wav", 0xfffe, 1, 2, 16, 44100, 0, 1 },
+        { "WaveLoadBenchmarks_ExtensibleFloat_1s.wav", 0xfffe, 3, 2, 32, 44100, 0, 3 },
+        { "WaveLoadBenchmarks_ExtensibleOther_1s.wav", 0xfffe, 2, 2, 32, 44100, 0, 0 },
+        { "WaveLoadBenchmarks_Stereo_10s.wav", 1, 0, 2, 16, 441000, 0, 1 },
+        { "WaveLoadBenchmarks_Stereo_60s.wav", 1, 0, 2, 16, 2646000, 0, 1 },
+    };
+
+    for (unsigned int i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++)
+    {
+        std::string data = WriteWave(corpus[i]);
+        BenchmarkFile(corpus[i].filename, data, corpus[i].expectedFormatTag);
+        remove(corpus[i].filename);
+    }
+
+    printf("\n%s\n", Tests::Failures() == 0 ? "All wave loading tests passed" : "Wave loading tests FAILED");
+    return Tests::Failures();
+}